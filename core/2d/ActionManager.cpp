@@ -33,6 +33,7 @@ THE SOFTWARE.
 #include "base/Scheduler.h"
 #include "base/Macros.h"
 #include "base/CArray.h"
+#include "base/FrameProfiler.h"
 #include "uthash/uthash.h"
 
 NS_AX_BEGIN
@@ -428,6 +429,8 @@ ssize_t ActionManager::getNumberOfRunningActions() const
 // main loop
 void ActionManager::update(float dt)
 {
+    AX_PROFILER_ZONE("ActionManager::update");
+
     for (tHashElement* elt = _targets; elt != nullptr;)
     {
         _currentTarget         = elt;
@@ -0,0 +1,547 @@
+/****************************************************************************
+ Copyright (c) 2022 Bytedance Inc.
+
+ https://axmolengine.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "2d/BinarySpriteSheetLoader.h"
+
+#include "2d/SpriteFrameCache.h"
+#include "base/AsyncTaskPool.h"
+#include "base/Director.h"
+#include "base/NinePatchImageParser.h"
+#include "base/NS.h"
+#include "base/Utils.h"
+#include "platform/FileUtils.h"
+#include "renderer/TextureCache.h"
+
+#include <array>
+#include <string.h>
+
+NS_AX_BEGIN
+
+/*
+ * Binary sprite sheet layout, little endian, strings are a uint16 length followed by the characters:
+ *
+ *   char[4]  magic "AXSS"
+ *   uint32   version
+ *   float[2] texture size
+ *   string   texture file name, relative to the sprite sheet, may be empty
+ *   string   pixel format name, may be empty
+ *   uint32   frame count
+ *   frames:
+ *     string   name
+ *     uint16   alias count, followed by the alias strings
+ *     float[4] rect in the texture
+ *     float[2] offset
+ *     float[2] source size
+ *     uint8    flags, FRAME_ROTATED | FRAME_ANCHOR | FRAME_POLYGON
+ *     float[2] anchor, if FRAME_ANCHOR
+ *     polygon, if FRAME_POLYGON: vertices, uvs and triangle indices, each an uint32 count followed by int32 values
+ */
+namespace
+{
+constexpr std::array<char, 4> SHEET_MAGIC = {'A', 'X', 'S', 'S'};
+constexpr uint32_t SHEET_VERSION            = 1;
+
+enum : uint8_t
+{
+    FRAME_ROTATED = 1,
+    FRAME_ANCHOR  = 1 << 1,
+    FRAME_POLYGON = 1 << 2,
+};
+
+class SheetWriter
+{
+public:
+    template <typename T>
+    void write(T value)
+    {
+        auto bytes = reinterpret_cast<const uint8_t*>(&value);
+        _buffer.insert(_buffer.end(), bytes, bytes + sizeof(T));
+    }
+
+    void writeString(std::string_view str)
+    {
+        write(static_cast<uint16_t>(str.size()));
+        _buffer.insert(_buffer.end(), str.begin(), str.end());
+    }
+
+    void writeInts(const std::vector<int>& values)
+    {
+        write(static_cast<uint32_t>(values.size()));
+        for (auto value : values)
+            write(static_cast<int32_t>(value));
+    }
+
+    const std::vector<uint8_t>& getBuffer() const { return _buffer; }
+
+private:
+    std::vector<uint8_t> _buffer;
+};
+
+class SheetReader
+{
+public:
+    SheetReader(const uint8_t* data, size_t size) : _ptr(data), _end(data + size) {}
+
+    template <typename T>
+    T read()
+    {
+        T value{};
+        if (static_cast<size_t>(_end - _ptr) < sizeof(T))
+        {
+            _ok = false;
+            return value;
+        }
+        memcpy(&value, _ptr, sizeof(T));
+        _ptr += sizeof(T);
+        return value;
+    }
+
+    std::string_view readString()
+    {
+        auto size = read<uint16_t>();
+        if (static_cast<size_t>(_end - _ptr) < size)
+        {
+            _ok = false;
+            return std::string_view{};
+        }
+        std::string_view str(reinterpret_cast<const char*>(_ptr), size);
+        _ptr += size;
+        return str;
+    }
+
+    void readInts(std::vector<int>& values)
+    {
+        auto count = read<uint32_t>();
+        if (static_cast<size_t>(_end - _ptr) / sizeof(int32_t) < count)
+        {
+            _ok = false;
+            return;
+        }
+        values.resize(count);
+        for (auto& value : values)
+            value = read<int32_t>();
+    }
+
+    bool isOk() const { return _ok; }
+
+private:
+    const uint8_t* _ptr;
+    const uint8_t* _end;
+    bool _ok = true;
+};
+}  // namespace
+
+bool BinarySpriteSheetLoader::convertFromPlist(std::string_view plistPath, std::string_view outputPath)
+{
+    ValueDocument doc;
+    if (!doc.initWithPlistFile(FileUtils::getInstance()->fullPathForFilename(plistPath)))
+        return false;
+
+    auto dict       = doc.getRoot();
+    auto framesDict = dict["frames"sv];
+    if (!framesDict.isDict())
+        return false;
+
+    auto metadataDict = dict["metadata"sv];
+    int format        = metadataDict["format"sv].asInt();
+    if (format < 0 || format > 3)
+    {
+        AXLOG("axmol: BinarySpriteSheetLoader: plist format %d is not supported", format);
+        return false;
+    }
+
+    Vec2 textureSize;
+    if (metadataDict.hasKey("size"sv))
+        textureSize = SizeFromString(metadataDict["size"sv].asString());
+
+    SheetWriter writer;
+    writer.write(SHEET_MAGIC);
+    writer.write(SHEET_VERSION);
+    writer.write(textureSize.x);
+    writer.write(textureSize.y);
+    writer.writeString(metadataDict["textureFileName"sv].asString());
+    writer.writeString(metadataDict["pixelFormat"sv].asString());
+    writer.write(static_cast<uint32_t>(framesDict.size()));
+
+    for (size_t i = 0, count = framesDict.size(); i < count; ++i)
+    {
+        auto frameDict = framesDict.at(i);
+        Rect rect;
+        Vec2 offset, sourceSize;
+        bool rotated = false;
+        uint8_t flags = 0;
+        std::vector<std::string_view> aliases;
+
+        if (format == 0)
+        {
+            rect = Rect(frameDict["x"sv].asFloat(), frameDict["y"sv].asFloat(), frameDict["width"sv].asFloat(),
+                        frameDict["height"sv].asFloat());
+            offset     = Vec2(frameDict["offsetX"sv].asFloat(), frameDict["offsetY"sv].asFloat());
+            sourceSize = Vec2(static_cast<float>(std::abs(frameDict["originalWidth"sv].asInt())),
+                              static_cast<float>(std::abs(frameDict["originalHeight"sv].asInt())));
+        }
+        else if (format == 1 || format == 2)
+        {
+            rect       = RectFromString(frameDict["frame"sv].asString());
+            rotated    = format == 2 && frameDict["rotated"sv].asBool();
+            offset     = PointFromString(frameDict["offset"sv].asString());
+            sourceSize = SizeFromString(frameDict["sourceSize"sv].asString());
+        }
+        else
+        {
+            auto spriteSize  = SizeFromString(frameDict["spriteSize"sv].asString());
+            auto textureRect = RectFromString(frameDict["textureRect"sv].asString());
+            rect       = Rect(textureRect.origin.x, textureRect.origin.y, spriteSize.width, spriteSize.height);
+            rotated    = frameDict["textureRotated"sv].asBool();
+            offset     = PointFromString(frameDict["spriteOffset"sv].asString());
+            sourceSize = SizeFromString(frameDict["spriteSourceSize"sv].asString());
+
+            auto aliasesArray = frameDict["aliases"sv];
+            for (size_t aliasIndex = 0; aliasIndex < aliasesArray.size(); ++aliasIndex)
+                aliases.emplace_back(aliasesArray.at(aliasIndex).asString());
+
+            if (frameDict.hasKey("anchor"sv))
+                flags |= FRAME_ANCHOR;
+            if (frameDict.hasKey("vertices"sv))
+                flags |= FRAME_POLYGON;
+        }
+        if (rotated)
+            flags |= FRAME_ROTATED;
+
+        writer.writeString(framesDict.keyAt(i));
+        writer.write(static_cast<uint16_t>(aliases.size()));
+        for (auto alias : aliases)
+            writer.writeString(alias);
+        writer.write(rect.origin.x);
+        writer.write(rect.origin.y);
+        writer.write(rect.size.width);
+        writer.write(rect.size.height);
+        writer.write(offset.x);
+        writer.write(offset.y);
+        writer.write(sourceSize.x);
+        writer.write(sourceSize.y);
+        writer.write(flags);
+
+        if (flags & FRAME_ANCHOR)
+        {
+            auto anchor = PointFromString(frameDict["anchor"sv].asString());
+            writer.write(anchor.x);
+            writer.write(anchor.y);
+        }
+        if (flags & FRAME_POLYGON)
+        {
+            writer.writeInts(utils::parseIntegerList(frameDict["vertices"sv].asString()));
+            writer.writeInts(utils::parseIntegerList(frameDict["verticesUV"sv].asString()));
+            writer.writeInts(utils::parseIntegerList(frameDict["triangles"sv].asString()));
+        }
+    }
+
+    auto& buffer = writer.getBuffer();
+    Data data;
+    data.copy(buffer.data(), static_cast<ssize_t>(buffer.size()));
+    return FileUtils::getInstance()->writeDataToFile(data, outputPath);
+}
+
+bool BinarySpriteSheetLoader::decode(const Data& data, SheetDesc& sheet, bool headerOnly)
+{
+    SheetReader reader(data.getBytes(), static_cast<size_t>(data.getSize()));
+    auto magic = reader.read<std::array<char, 4>>();
+    if (!reader.isOk() || magic != SHEET_MAGIC)
+        return false;
+    if (reader.read<uint32_t>() != SHEET_VERSION)
+    {
+        AXLOG("axmol: BinarySpriteSheetLoader: unsupported version");
+        return false;
+    }
+
+    sheet.textureSize.x   = reader.read<float>();
+    sheet.textureSize.y   = reader.read<float>();
+    sheet.textureFileName = reader.readString();
+    sheet.pixelFormat     = reader.readString();
+    auto frameCount       = reader.read<uint32_t>();
+    if (!reader.isOk() || headerOnly)
+        return reader.isOk();
+
+    // reserved up front, PolygonInfo has no move constructor
+    sheet.frames.clear();
+    sheet.frames.reserve(frameCount);
+    std::vector<int> vertices, verticesUV, indices;
+    for (uint32_t i = 0; i < frameCount && reader.isOk(); ++i)
+    {
+        auto& frame = sheet.frames.emplace_back();
+        frame.name  = reader.readString();
+
+        auto aliasCount = reader.read<uint16_t>();
+        frame.aliases.reserve(aliasCount);
+        for (uint16_t aliasIndex = 0; aliasIndex < aliasCount; ++aliasIndex)
+            frame.aliases.emplace_back(reader.readString());
+
+        frame.rect.origin.x    = reader.read<float>();
+        frame.rect.origin.y    = reader.read<float>();
+        frame.rect.size.width  = reader.read<float>();
+        frame.rect.size.height = reader.read<float>();
+        frame.offset.x         = reader.read<float>();
+        frame.offset.y         = reader.read<float>();
+        frame.sourceSize.x     = reader.read<float>();
+        frame.sourceSize.y     = reader.read<float>();
+
+        auto flags    = reader.read<uint8_t>();
+        frame.rotated = (flags & FRAME_ROTATED) != 0;
+        if (flags & FRAME_ANCHOR)
+        {
+            frame.hasAnchor = true;
+            frame.anchor.x  = reader.read<float>();
+            frame.anchor.y  = reader.read<float>();
+        }
+        if (flags & FRAME_POLYGON)
+        {
+            reader.readInts(vertices);
+            reader.readInts(verticesUV);
+            reader.readInts(indices);
+            if (reader.isOk())
+            {
+                frame.hasPolygon = true;
+                initializePolygonInfo(sheet.textureSize, frame.sourceSize, vertices, verticesUV, indices,
+                                      frame.polygon);
+            }
+        }
+    }
+
+    if (!reader.isOk())
+    {
+        AXLOG("axmol: BinarySpriteSheetLoader: the sprite sheet data is truncated");
+        sheet.frames.clear();
+        return false;
+    }
+    return true;
+}
+
+void BinarySpriteSheetLoader::addSpriteFrames(const SheetDesc& sheet,
+                                              Texture2D* texture,
+                                              std::string_view path,
+                                              SpriteFrameCache& cache,
+                                              bool replace)
+{
+    auto spriteSheet    = std::make_shared<SpriteSheet>();
+    spriteSheet->format = getFormat();
+    spriteSheet->path   = path;
+
+    Image* image = nullptr;
+    NinePatchImageParser parser;
+    for (auto& frame : sheet.frames)
+    {
+        if (replace)
+            cache.eraseFrame(frame.name);
+        else if (cache.findFrame(frame.name))
+            continue;
+
+        auto spriteFrame =
+            SpriteFrame::createWithTexture(texture, frame.rect, frame.rotated, frame.offset, frame.sourceSize);
+        if (frame.hasPolygon)
+            spriteFrame->setPolygonInfo(frame.polygon);
+        if (frame.hasAnchor)
+            spriteFrame->setAnchorPoint(frame.anchor);
+
+        if (NinePatchImageParser::isNinePatchImage(frame.name))
+        {
+            if (image == nullptr)
+            {
+                image = new Image();
+                image->initWithImageFile(Director::getInstance()->getTextureCache()->getTextureFilePath(texture));
+            }
+            parser.setSpriteFrameInfo(image, spriteFrame->getRectInPixels(), spriteFrame->isRotated());
+            cache.addSpriteFrameCapInset(spriteFrame, parser.parseCapInset(), texture);
+        }
+
+        cache.insertFrame(spriteSheet, frame.name, spriteFrame);
+        for (auto& alias : frame.aliases)
+            cache.insertFrame(spriteSheet, alias, spriteFrame);
+    }
+
+    spriteSheet->full = true;
+
+    AX_SAFE_DELETE(image);
+}
+
+Texture2D* BinarySpriteSheetLoader::addTexture(const SheetDesc& sheet, std::string_view texturePath)
+{
+    auto textureCache = Director::getInstance()->getTextureCache();
+    backend::PixelFormat pixelFormat;
+    if (getPixelFormatByName(sheet.pixelFormat, pixelFormat))
+        return textureCache->addImage(texturePath, pixelFormat);
+    return textureCache->addImage(texturePath);
+}
+
+std::string BinarySpriteSheetLoader::getTexturePath(const SheetDesc& sheet, std::string_view filePath)
+{
+    if (!sheet.textureFileName.empty())
+        return FileUtils::getInstance()->fullPathFromRelativeFile(sheet.textureFileName, filePath);
+
+    // same as plist sheets, the texture is next to the sheet with a .png extension
+    std::string texturePath{filePath};
+    const auto startPos = texturePath.find_last_of('.');
+    if (startPos != std::string::npos)
+        texturePath.erase(startPos);
+    return texturePath.append(".png");
+}
+
+void BinarySpriteSheetLoader::load(std::string_view filePath, SpriteFrameCache& cache)
+{
+    AXASSERT(!filePath.empty(), "sprite sheet filename should not be empty");
+    SheetDesc sheet;
+    if (!decode(FileUtils::getInstance()->getDataFromFile(filePath), sheet))
+    {
+        AXLOG("axmol: SpriteFrameCache: can not load %s", filePath.data());
+        return;
+    }
+
+    auto texture = addTexture(sheet, getTexturePath(sheet, filePath));
+    if (texture)
+        addSpriteFrames(sheet, texture, filePath, cache);
+    else
+        AXLOG("axmol: SpriteFrameCache: Couldn't load texture");
+}
+
+void BinarySpriteSheetLoader::load(std::string_view filePath, Texture2D* texture, SpriteFrameCache& cache)
+{
+    SheetDesc sheet;
+    if (decode(FileUtils::getInstance()->getDataFromFile(filePath), sheet))
+        addSpriteFrames(sheet, texture, filePath, cache);
+}
+
+void BinarySpriteSheetLoader::load(std::string_view filePath,
+                                   std::string_view textureFileName,
+                                   SpriteFrameCache& cache)
+{
+    AXASSERT(!textureFileName.empty(), "texture name should not be null");
+    SheetDesc sheet;
+    if (!decode(FileUtils::getInstance()->getDataFromFile(filePath), sheet))
+        return;
+
+    auto texture = addTexture(sheet, textureFileName);
+    if (texture)
+        addSpriteFrames(sheet, texture, filePath, cache);
+    else
+        AXLOG("axmol: SpriteFrameCache: Couldn't load texture");
+}
+
+void BinarySpriteSheetLoader::load(const Data& content, Texture2D* texture, SpriteFrameCache& cache)
+{
+    SheetDesc sheet;
+    if (decode(content, sheet))
+        addSpriteFrames(sheet, texture, "by#addSpriteFramesWithFileContent()", cache);
+}
+
+void BinarySpriteSheetLoader::reload(std::string_view filePath, SpriteFrameCache& cache)
+{
+    SheetDesc sheet;
+    if (!decode(FileUtils::getInstance()->getDataFromFile(filePath), sheet))
+        return;
+
+    auto texturePath   = getTexturePath(sheet, filePath);
+    auto textureCache  = Director::getInstance()->getTextureCache();
+    Texture2D* texture = nullptr;
+    if (textureCache->reloadTexture(texturePath))
+        texture = textureCache->getTextureForKey(texturePath);
+
+    if (texture)
+        addSpriteFrames(sheet, texture, filePath, cache, true);
+    else
+        AXLOG("axmol: SpriteFrameCache: Couldn't load texture");
+}
+
+void BinarySpriteSheetLoader::loadAsync(std::string_view filePath,
+                                        SpriteFrameCache& cache,
+                                        const std::function<void(bool)>& callback)
+{
+    struct AsyncLoad
+    {
+        std::string path;
+        SheetDesc sheet;
+        bool decoded       = false;
+        Texture2D* texture = nullptr;
+        int pending        = 2;  // the decoded frames and the texture
+        std::function<void(bool)> callback;
+    };
+
+    auto state      = std::make_shared<AsyncLoad>();
+    state->path     = filePath;
+    state->callback = callback;
+
+    // runs on the main thread once both the frames and the texture are ready
+    auto cachePtr = &cache;
+    cachePtr->retain();
+    auto finish = [this, state, cachePtr]() {
+        if (--state->pending > 0)
+            return;
+
+        bool loaded = state->decoded && state->texture;
+        if (loaded)
+            addSpriteFrames(state->sheet, state->texture, state->path, *cachePtr);
+        else
+            AXLOG("axmol: SpriteFrameCache: can not load %s", state->path.c_str());
+        AX_SAFE_RELEASE_NULL(state->texture);
+        cachePtr->release();
+
+        if (state->callback)
+            state->callback(loaded);
+    };
+
+    AsyncTaskPool::getInstance()->enqueue(AsyncTaskPool::TaskType::TASK_IO, [this, state, finish]() {
+        auto scheduler = Director::getInstance()->getScheduler();
+        auto data      = FileUtils::getInstance()->getDataFromFile(state->path);
+
+        // start loading the texture as soon as its name is known, the frames are decoded meanwhile
+        SheetDesc header;
+        bool hasHeader = decode(data, header, true);
+        scheduler->runOnAxmolThread([this, state, finish, hasHeader, header = std::move(header)]() {
+            if (hasHeader)
+            {
+                auto texturePath = getTexturePath(header, state->path);
+                backend::PixelFormat pixelFormat;
+                if (!getPixelFormatByName(header.pixelFormat, pixelFormat))
+                    pixelFormat = Texture2D::getDefaultAlphaPixelFormat();
+                Director::getInstance()->getTextureCache()->addImageAsync(
+                    texturePath,
+                    [state, finish](Texture2D* texture) {
+                        // keep the texture alive until the frames are added
+                        AX_SAFE_RETAIN(texture);
+                        state->texture = texture;
+                        finish();
+                    },
+                    texturePath, pixelFormat);
+                return;
+            }
+            finish();
+        });
+
+        bool decoded = hasHeader && decode(data, state->sheet);
+        scheduler->runOnAxmolThread([state, finish, decoded]() {
+            state->decoded = decoded;
+            finish();
+        });
+    });
+}
+
+NS_AX_END
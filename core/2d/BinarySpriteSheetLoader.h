@@ -0,0 +1,111 @@
+/****************************************************************************
+ Copyright (c) 2022 Bytedance Inc.
+
+ https://axmolengine.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "2d/SpriteSheetLoader.h"
+#include "2d/AutoPolygon.h"
+#include "base/ValueDocument.h"
+
+NS_AX_BEGIN
+
+/**
+ * @addtogroup _2d
+ * @{
+ */
+
+/**
+ * Loads sprite sheets stored in the compact binary format written by convertFromPlist.
+ *
+ * The format keeps every frame in its final form, so loading does no string parsing, and polygon meshes are stored
+ * as plain integer lists. loadAsync reads and decodes the file, including the polygon meshes, on a worker thread,
+ * loads the texture asynchronously at the same time, and publishes all frames to the SpriteFrameCache in one go on
+ * the main thread.
+ */
+class AX_DLL BinarySpriteSheetLoader : public SpriteSheetLoader
+{
+public:
+    static constexpr uint32_t FORMAT = SpriteSheetFormat::BINARY;
+
+    /**
+     * Converts a plist sprite sheet (formats 0 to 3) into the binary format.
+     * The texture file name is stored as in the plist, relative to the sprite sheet.
+     * @return false if the plist can't be read or the output can't be written.
+     */
+    static bool convertFromPlist(std::string_view plistPath, std::string_view outputPath);
+
+    uint32_t getFormat() override { return FORMAT; }
+    void load(std::string_view filePath, SpriteFrameCache& cache) override;
+    void load(std::string_view filePath, Texture2D* texture, SpriteFrameCache& cache) override;
+    void load(std::string_view filePath, std::string_view textureFileName, SpriteFrameCache& cache) override;
+    void load(const Data& content, Texture2D* texture, SpriteFrameCache& cache) override;
+    void reload(std::string_view filePath, SpriteFrameCache& cache) override;
+    void loadAsync(std::string_view filePath,
+                   SpriteFrameCache& cache,
+                   const std::function<void(bool)>& callback) override;
+
+protected:
+    struct FrameDesc
+    {
+        std::string name;
+        std::vector<std::string> aliases;
+        Rect rect;
+        Vec2 offset;
+        Vec2 sourceSize;
+        Vec2 anchor;
+        bool rotated    = false;
+        bool hasAnchor  = false;
+        bool hasPolygon = false;
+        PolygonInfo polygon;
+    };
+
+    struct SheetDesc
+    {
+        std::string textureFileName;
+        std::string pixelFormat;
+        Vec2 textureSize;
+        std::vector<FrameDesc> frames;
+    };
+
+    /** Decodes the header of a binary sprite sheet, and the frames unless headerOnly is set. */
+    bool decode(const Data& data, SheetDesc& sheet, bool headerOnly = false);
+
+    /** Creates the sprite frames and adds them to the cache, replacing existing frames if replace is set. */
+    void addSpriteFrames(const SheetDesc& sheet,
+                         Texture2D* texture,
+                         std::string_view path,
+                         SpriteFrameCache& cache,
+                         bool replace = false);
+
+    Texture2D* addTexture(const SheetDesc& sheet, std::string_view texturePath);
+    std::string getTexturePath(const SheetDesc& sheet, std::string_view filePath);
+};
+
+// end of _2d group
+/// @}
+
+NS_AX_END
@@ -36,6 +36,7 @@
 #include "base/Utils.h"
 #include "renderer/Shaders.h"
 #include "renderer/backend/ProgramState.h"
+#include "renderer/backend/StreamBuffer.h"
 
 NS_AX_BEGIN
 
@@ -97,9 +98,6 @@ void DrawNode::ensureCapacity(int count)
         _bufferCapacityTriangle += MAX(_bufferCapacityTriangle, count);
         _bufferTriangle = (V2F_C4B_T2F*)realloc(_bufferTriangle, _bufferCapacityTriangle * sizeof(V2F_C4B_T2F));
 
-        _customCommandTriangle.createVertexBuffer(sizeof(V2F_C4B_T2F), _bufferCapacityTriangle,
-                                                  CustomCommand::BufferUsage::STATIC);
-        _customCommandTriangle.updateVertexBuffer(_bufferTriangle, _bufferCapacityTriangle * sizeof(V2F_C4B_T2F));
     }
 }
 
@@ -112,9 +110,6 @@ void DrawNode::ensureCapacityGLPoint(int count)
         _bufferCapacityPoint += MAX(_bufferCapacityPoint, count);
         _bufferPoint = (V2F_C4B_T2F*)realloc(_bufferPoint, _bufferCapacityPoint * sizeof(V2F_C4B_T2F));
 
-        _customCommandPoint.createVertexBuffer(sizeof(V2F_C4B_T2F), _bufferCapacityPoint,
-                                               CustomCommand::BufferUsage::STATIC);
-        _customCommandPoint.updateVertexBuffer(_bufferPoint, _bufferCapacityPoint * sizeof(V2F_C4B_T2F));
     }
 }
 
@@ -127,9 +122,6 @@ void DrawNode::ensureCapacityGLLine(int count)
         _bufferCapacityLine += MAX(_bufferCapacityLine, count);
         _bufferLine = (V2F_C4B_T2F*)realloc(_bufferLine, _bufferCapacityLine * sizeof(V2F_C4B_T2F));
 
-        _customCommandLine.createVertexBuffer(sizeof(V2F_C4B_T2F), _bufferCapacityLine,
-                                              CustomCommand::BufferUsage::STATIC);
-        _customCommandLine.updateVertexBuffer(_bufferLine, _bufferCapacityLine * sizeof(V2F_C4B_T2F));
     }
 }
 
@@ -222,8 +214,151 @@ void DrawNode::updateUniforms(const Mat4& transform, CustomCommand& cmd)
     pipelineDescriptor.programState->setUniform(alphaUniformLocation, &alpha, sizeof(alpha));
 }
 
+const Vec2* DrawNode::getCircleTable(unsigned int segments)
+{
+    if (_circleTable.size() != segments)
+    {
+        _circleTable.resize(segments);
+        const float coef = 2.0f * (float)M_PI / segments;
+        for (unsigned int i = 0; i < segments; i++)
+            _circleTable[i] = Vec2(cosf(i * coef), sinf(i * coef));
+    }
+    return _circleTable.data();
+}
+
+const DrawNode::BezierWeights* DrawNode::getBezierWeights(unsigned int segments)
+{
+    if (_bezierTable.size() != segments)
+    {
+        _bezierTable.resize(segments);
+        for (unsigned int i = 0; i < segments; i++)
+        {
+            float t               = (float)i / segments;
+            float u               = 1.0f - t;
+            _bezierTable[i].quad  = Vec3(u * u, 2.0f * u * t, t * t);
+            _bezierTable[i].cubic = Vec4(u * u * u, 3.0f * u * u * t, 3.0f * u * t * t, t * t * t);
+        }
+    }
+    return _bezierTable.data();
+}
+
+void DrawNode::tessellateCircle(Vec2* vertices,
+                                const Vec2& center,
+                                float radius,
+                                float angle,
+                                unsigned int segments,
+                                float scaleX,
+                                float scaleY)
+{
+    // rotates the unit circle table, one sin/cos pair per circle instead of one per vertex
+    auto table     = getCircleTable(segments);
+    const float c  = cosf(angle);
+    const float s  = sinf(angle);
+    const float rx = radius * scaleX;
+    const float ry = radius * scaleY;
+    for (unsigned int i = 0; i < segments; i++)
+    {
+        vertices[i].x = (table[i].x * c - table[i].y * s) * rx + center.x;
+        vertices[i].y = (table[i].y * c + table[i].x * s) * ry + center.y;
+    }
+}
+
+void DrawNode::setDynamic(bool dynamic)
+{
+    if (_dynamic == dynamic)
+        return;
+
+    _dynamic = dynamic;
+    if (!_dynamic)
+    {
+        // back to retained buffers, the commands may still hold the renderer's vertex stream
+        resetVertexBuffer(_customCommandTriangle, _bufferTriangle, _bufferCapacityTriangle, _bufferCountTriangle);
+        resetVertexBuffer(_customCommandPoint, _bufferPoint, _bufferCapacityPoint, _bufferCountPoint);
+        resetVertexBuffer(_customCommandLine, _bufferLine, _bufferCapacityLine, _bufferCountLine);
+        _dirtyRangeTriangle.reset();
+        _dirtyRangePoint.reset();
+        _dirtyRangeLine.reset();
+    }
+}
+
+void DrawNode::resetVertexBuffer(CustomCommand& cmd, V2F_C4B_T2F* buffer, int capacity, int count)
+{
+    cmd.createVertexBuffer(sizeof(V2F_C4B_T2F), capacity, CustomCommand::BufferUsage::STATIC);
+    cmd.updateVertexBuffer(buffer, capacity * sizeof(V2F_C4B_T2F));
+    cmd.setVertexDrawInfo(0, count);
+}
+
+void DrawNode::uploadVertexBuffer(CustomCommand& cmd,
+                                  V2F_C4B_T2F* buffer,
+                                  int capacity,
+                                  int count,
+                                  VertexRange& dirtyRange)
+{
+    if (!cmd.getVertexBuffer() || cmd.getVertexCapacity() < static_cast<std::size_t>(capacity))
+    {
+        // the CPU buffer grew since the last draw
+        cmd.createVertexBuffer(sizeof(V2F_C4B_T2F), capacity, CustomCommand::BufferUsage::STATIC);
+        cmd.updateVertexBuffer(buffer, count * sizeof(V2F_C4B_T2F));
+    }
+    else if (dirtyRange.start < std::min(dirtyRange.end, count))
+    {
+        // shapes may have been shrunk or removed since the range was marked
+        const int end = std::min(dirtyRange.end, count);
+        cmd.updateVertexBuffer(buffer + dirtyRange.start, dirtyRange.start * sizeof(V2F_C4B_T2F),
+                               (end - dirtyRange.start) * sizeof(V2F_C4B_T2F));
+    }
+    dirtyRange.reset();
+    cmd.setVertexDrawInfo(0, count);
+}
+
+void DrawNode::streamVertexBuffer(Renderer* renderer, CustomCommand& cmd, V2F_C4B_T2F* buffer, int capacity, int count)
+{
+    auto stream        = renderer->getVertexStream();
+    std::size_t offset = 0;
+    const auto size    = count * sizeof(V2F_C4B_T2F);
+    // aligned to the vertex size, so the block is drawn with a start vertex
+    void* vertices = stream ? stream->allocate(size, sizeof(V2F_C4B_T2F), offset) : nullptr;
+    if (vertices)
+    {
+        memcpy(vertices, buffer, size);
+        cmd.setVertexBuffer(stream->getBuffer());
+        cmd.setVertexDrawInfo(offset / sizeof(V2F_C4B_T2F), count);
+        return;
+    }
+
+    // the backend doesn't stream or the ring of this frame is full, the command may still hold the ring buffer
+    if (stream || !cmd.getVertexBuffer() || cmd.getVertexCapacity() < static_cast<std::size_t>(capacity))
+        cmd.createVertexBuffer(sizeof(V2F_C4B_T2F), capacity, CustomCommand::BufferUsage::DYNAMIC);
+    cmd.updateVertexBuffer(buffer, size);
+    cmd.setVertexDrawInfo(0, count);
+}
+
 void DrawNode::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
 {
+    if (_dynamic)
+    {
+        if (_bufferCountTriangle)
+            streamVertexBuffer(renderer, _customCommandTriangle, _bufferTriangle, _bufferCapacityTriangle,
+                               _bufferCountTriangle);
+        if (_bufferCountPoint)
+            streamVertexBuffer(renderer, _customCommandPoint, _bufferPoint, _bufferCapacityPoint, _bufferCountPoint);
+        if (_bufferCountLine)
+            streamVertexBuffer(renderer, _customCommandLine, _bufferLine, _bufferCapacityLine, _bufferCountLine);
+    }
+    else
+    {
+        // everything drawn since the last frame goes up in a single upload per command
+        if (_bufferCountTriangle)
+            uploadVertexBuffer(_customCommandTriangle, _bufferTriangle, _bufferCapacityTriangle, _bufferCountTriangle,
+                               _dirtyRangeTriangle);
+        if (_bufferCountPoint)
+            uploadVertexBuffer(_customCommandPoint, _bufferPoint, _bufferCapacityPoint, _bufferCountPoint,
+                               _dirtyRangePoint);
+        if (_bufferCountLine)
+            uploadVertexBuffer(_customCommandLine, _bufferLine, _bufferCapacityLine, _bufferCountLine,
+                               _dirtyRangeLine);
+    }
+
     if (_bufferCountTriangle)
     {
         updateBlendState(_customCommandTriangle);
@@ -256,10 +391,9 @@ void DrawNode::drawPoint(const Vec2& position, const float pointSize, const Colo
     V2F_C4B_T2F* point = _bufferPoint + _bufferCountPoint;
     *point             = {position, color, Tex2F(pointSize, 0)};
 
-    _customCommandPoint.updateVertexBuffer(point, _bufferCountPoint * sizeof(V2F_C4B_T2F), sizeof(V2F_C4B_T2F));
+    _dirtyRangePoint.add(_bufferCountPoint, 1);
     _bufferCountPoint += 1;
     _dirtyPoint = true;
-    _customCommandPoint.setVertexDrawInfo(0, _bufferCountPoint);
 }
 
 void DrawNode::drawPoints(const Vec2* position, unsigned int numberOfPoints, const Color4B& color)
@@ -280,11 +414,9 @@ void DrawNode::drawPoints(const Vec2* position,
         *(point + i) = {position[i], color, Tex2F(pointSize, 0)};
     }
 
-    _customCommandPoint.updateVertexBuffer(point, _bufferCountPoint * sizeof(V2F_C4B_T2F),
-                                           numberOfPoints * sizeof(V2F_C4B_T2F));
+    _dirtyRangePoint.add(_bufferCountPoint, numberOfPoints);
     _bufferCountPoint += numberOfPoints;
     _dirtyPoint = true;
-    _customCommandPoint.setVertexDrawInfo(0, _bufferCountPoint);
 }
 
 void DrawNode::drawLine(const Vec2& origin, const Vec2& destination, const Color4B& color)
@@ -296,10 +428,9 @@ void DrawNode::drawLine(const Vec2& origin, const Vec2& destination, const Color
     *point       = {origin, color, Tex2F(0.0, 0.0)};
     *(point + 1) = {destination, color, Tex2F(0.0, 0.0)};
 
-    _customCommandLine.updateVertexBuffer(point, _bufferCountLine * sizeof(V2F_C4B_T2F), 2 * sizeof(V2F_C4B_T2F));
+    _dirtyRangeLine.add(_bufferCountLine, 2);
     _bufferCountLine += 2;
     _dirtyLine = true;
-    _customCommandLine.setVertexDrawInfo(0, _bufferCountLine);
 }
 
 void DrawNode::drawRect(const Vec2& origin, const Vec2& destination, const Color4B& color)
@@ -324,8 +455,7 @@ void DrawNode::drawPoly(const Vec2* poli, unsigned int numberOfPoints, bool clos
         ensureCapacityGLLine(vertex_count);
     }
 
-    V2F_C4B_T2F* point  = _bufferLine + _bufferCountLine;
-    V2F_C4B_T2F* cursor = point;
+    V2F_C4B_T2F* point = _bufferLine + _bufferCountLine;
 
     unsigned int i = 0;
     for (; i < numberOfPoints - 1; i++)
@@ -340,10 +470,8 @@ void DrawNode::drawPoly(const Vec2* poli, unsigned int numberOfPoints, bool clos
         *(point + 1) = {poli[0], color, Tex2F(0.0, 0.0)};
     }
 
-    _customCommandLine.updateVertexBuffer(cursor, _bufferCountLine * sizeof(V2F_C4B_T2F),
-                                          vertex_count * sizeof(V2F_C4B_T2F));
+    _dirtyRangeLine.add(_bufferCountLine, vertex_count);
     _bufferCountLine += vertex_count;
-    _customCommandLine.setVertexDrawInfo(0, _bufferCountLine);
 }
 
 void DrawNode::drawCircle(const Vec2& center,
@@ -356,16 +484,9 @@ void DrawNode::drawCircle(const Vec2& center,
                           const Color4B& color,
                           float threshold)
 {
-    const float coef = 2.0f * (float)M_PI / segments;
-
     auto vertices = _abuf.get<Vec2>(segments + 2);
-
-    for (unsigned int i = 0; i <= segments; i++)
-    {
-        float rads    = i * coef;
-        vertices[i].x = radius * cosf(rads + angle) * scaleX + center.x;
-        vertices[i].y = radius * sinf(rads + angle) * scaleY + center.y;
-    }
+    tessellateCircle(vertices, center, radius, angle, segments, scaleX, scaleY);
+    vertices[segments] = vertices[0];
     if (_lineWidth > threshold)
     {
         drawPolygon(vertices, segments, Color4B(1.0f, 0.0f, 0.0f, 1.0f), _lineWidth/4, color);
@@ -401,12 +522,11 @@ void DrawNode::drawQuadBezier(const Vec2& origin,
 {
     Vec2* vertices = _abuf.get<Vec2>(segments + 1);
 
-    float t = 0.0f;
+    auto weights = getBezierWeights(segments);
     for (unsigned int i = 0; i < segments; i++)
     {
-        vertices[i].x = powf(1 - t, 2) * origin.x + 2.0f * (1 - t) * t * control.x + t * t * destination.x;
-        vertices[i].y = powf(1 - t, 2) * origin.y + 2.0f * (1 - t) * t * control.y + t * t * destination.y;
-        t += 1.0f / segments;
+        auto& w     = weights[i].quad;
+        vertices[i] = origin * w.x + control * w.y + destination * w.z;
     }
     vertices[segments].x = destination.x;
     vertices[segments].y = destination.y;
@@ -423,14 +543,11 @@ void DrawNode::drawCubicBezier(const Vec2& origin,
 {
     Vec2* vertices = _abuf.get<Vec2>(segments + 1);
 
-    float t = 0;
+    auto weights = getBezierWeights(segments);
     for (unsigned int i = 0; i < segments; i++)
     {
-        vertices[i].x = powf(1 - t, 3) * origin.x + 3.0f * powf(1 - t, 2) * t * control1.x +
-                        3.0f * (1 - t) * t * t * control2.x + t * t * t * destination.x;
-        vertices[i].y = powf(1 - t, 3) * origin.y + 3.0f * powf(1 - t, 2) * t * control1.y +
-                        3.0f * (1 - t) * t * t * control2.y + t * t * t * destination.y;
-        t += 1.0f / segments;
+        auto& w     = weights[i].cubic;
+        vertices[i] = origin * w.x + control1 * w.y + control2 * w.z + destination * w.w;
     }
     vertices[segments].x = destination.x;
     vertices[segments].y = destination.y;
@@ -498,11 +615,9 @@ void DrawNode::drawDot(const Vec2& pos, float radius, const Color4B& color)
     triangles[0]                    = triangle0;
     triangles[1]                    = triangle1;
 
-    _customCommandTriangle.updateVertexBuffer(triangles, _bufferCountTriangle * sizeof(V2F_C4B_T2F),
-                                              vertex_count * sizeof(V2F_C4B_T2F));
+    _dirtyRangeTriangle.add(_bufferCountTriangle, vertex_count);
     _bufferCountTriangle += vertex_count;
     _dirtyTriangle = true;
-    _customCommandTriangle.setVertexDrawInfo(0, _bufferCountTriangle);
 }
 
 void DrawNode::drawRect(const Vec2& p1, const Vec2& p2, const Vec2& p3, const Vec2& p4, const Color4B& color)
@@ -579,11 +694,9 @@ void DrawNode::drawSegment(const Vec2& from, const Vec2& to, float radius, const
     };
     triangles[5] = triangles5;
 
-    _customCommandTriangle.updateVertexBuffer(triangles, _bufferCountTriangle * sizeof(V2F_C4B_T2F),
-                                              vertex_count * sizeof(V2F_C4B_T2F));
+    _dirtyRangeTriangle.add(_bufferCountTriangle, vertex_count);
     _bufferCountTriangle += vertex_count;
     _dirtyTriangle = true;
-    _customCommandTriangle.setVertexDrawInfo(0, _bufferCountTriangle);
 }
 
 void DrawNode::drawPolygon(const Vec2* verts,
@@ -665,10 +778,8 @@ void DrawNode::drawPolygon(const Vec2* verts,
         free(extrude);
     }
 
-    _customCommandTriangle.updateVertexBuffer(triangles, _bufferCountTriangle * sizeof(V2F_C4B_T2F),
-                                              vertex_count * sizeof(V2F_C4B_T2F));
+    _dirtyRangeTriangle.add(_bufferCountTriangle, vertex_count);
     _bufferCountTriangle += vertex_count;
-    _customCommandTriangle.setVertexDrawInfo(0, _bufferCountTriangle);
     _dirtyTriangle = true;
 }
 
@@ -694,19 +805,8 @@ void DrawNode::drawSolidCircle(const Vec2& center,
                                float borderWidth,
                                const Color4B& borderColor)
 {
-    const float coef = 2.0f * (float)M_PI / segments;
-
     Vec2* vertices = _abuf.get<Vec2>(segments);
-
-    for (unsigned int i = 0; i < segments; i++)
-    {
-        float rads = i * coef;
-        float j    = radius * cosf(rads + angle) * scaleX + center.x;
-        float k    = radius * sinf(rads + angle) * scaleY + center.y;
-
-        vertices[i].x = j;
-        vertices[i].y = k;
-    }
+    tessellateCircle(vertices, center, radius, angle, segments, scaleX, scaleY);
 
     drawPolygon(vertices, segments, fillColor, borderWidth, borderColor);
 }
@@ -719,19 +819,8 @@ void DrawNode::drawSolidCircle(const Vec2& center,
                                float scaleY,
                                const Color4B& color)
 {
-    const float coef = 2.0f * (float)M_PI / segments;
-
     Vec2* vertices = _abuf.get<Vec2>(segments);
-
-    for (unsigned int i = 0; i < segments; i++)
-    {
-        float rads = i * coef;
-        float j    = radius * cosf(rads + angle) * scaleX + center.x;
-        float k    = radius * sinf(rads + angle) * scaleY + center.y;
-
-        vertices[i].x = j;
-        vertices[i].y = k;
-    }
+    tessellateCircle(vertices, center, radius, angle, segments, scaleX, scaleY);
 
     drawSolidPoly(vertices, segments, color);
 }
@@ -758,11 +847,128 @@ void DrawNode::drawTriangle(const Vec2& p1, const Vec2& p2, const Vec2& p3, cons
     V2F_C4B_T2F_Triangle triangle   = {a, b, c};
     triangles[0]                    = triangle;
 
-    _customCommandTriangle.updateVertexBuffer(triangles, _bufferCountTriangle * sizeof(V2F_C4B_T2F),
-                                              vertex_count * sizeof(V2F_C4B_T2F));
+    _dirtyRangeTriangle.add(_bufferCountTriangle, vertex_count);
     _bufferCountTriangle += vertex_count;
     _dirtyTriangle = true;
-    _customCommandTriangle.setVertexDrawInfo(0, _bufferCountTriangle);
+}
+
+DrawNode::Shape DrawNode::getShapeMark() const
+{
+    Shape mark;
+    mark.triangles.start = _bufferCountTriangle;
+    mark.points.start    = _bufferCountPoint;
+    mark.lines.start     = _bufferCountLine;
+    return mark;
+}
+
+void DrawNode::beginShape()
+{
+    AXASSERT(!_recordingShape, "endShape() must be called before a new shape begins");
+    _recordingShape = true;
+    _shapeMark      = getShapeMark();
+}
+
+unsigned int DrawNode::endShape()
+{
+    AXASSERT(_recordingShape, "beginShape() must be called first");
+    _recordingShape = false;
+
+    Shape shape           = _shapeMark;
+    shape.triangles.count = _bufferCountTriangle - shape.triangles.start;
+    shape.points.count    = _bufferCountPoint - shape.points.start;
+    shape.lines.count     = _bufferCountLine - shape.lines.start;
+
+    _shapes.emplace(++_nextShapeId, shape);
+    return _nextShapeId;
+}
+
+void DrawNode::eraseVertices(V2F_C4B_T2F* buffer,
+                             int& count,
+                             VertexRange& dirtyRange,
+                             VertexSpan Shape::*member,
+                             VertexSpan span)
+{
+    if (span.count == 0)
+        return;
+
+    const int tail = span.start + span.count;
+    memmove(buffer + span.start, buffer + tail, (count - tail) * sizeof(V2F_C4B_T2F));
+    count -= span.count;
+    dirtyRange.add(span.start, count - span.start);
+
+    for (auto& item : _shapes)
+    {
+        auto& other = item.second.*member;
+        if (other.start >= tail)
+            other.start -= span.count;
+    }
+}
+
+void DrawNode::replaceVertices(V2F_C4B_T2F* buffer,
+                               int& count,
+                               VertexRange& dirtyRange,
+                               const VertexRange& dirtyRangeBeforeDraw,
+                               VertexSpan Shape::*member,
+                               Shape& shape,
+                               VertexSpan drawn)
+{
+    // the new geometry was appended at the end of the buffer
+    auto& span = shape.*member;
+    if (span.count == drawn.count)
+    {
+        memcpy(buffer + span.start, buffer + drawn.start, drawn.count * sizeof(V2F_C4B_T2F));
+        count -= drawn.count;
+        // the appended vertices are dropped again, only the shape's own vertices need an upload
+        dirtyRange = dirtyRangeBeforeDraw;
+        dirtyRange.add(span.start, span.count);
+    }
+    else
+    {
+        eraseVertices(buffer, count, dirtyRange, member, span);
+        span = {drawn.start - span.count, drawn.count};
+    }
+}
+
+void DrawNode::updateShape(unsigned int shapeId, const std::function<void(DrawNode*)>& drawFunc)
+{
+    auto it = _shapes.find(shapeId);
+    if (it == _shapes.end())
+        return;
+
+    const auto dirtyTriangle = _dirtyRangeTriangle;
+    const auto dirtyPoint    = _dirtyRangePoint;
+    const auto dirtyLine     = _dirtyRangeLine;
+
+    Shape drawn = getShapeMark();
+    drawFunc(this);
+    drawn.triangles.count = _bufferCountTriangle - drawn.triangles.start;
+    drawn.points.count    = _bufferCountPoint - drawn.points.start;
+    drawn.lines.count     = _bufferCountLine - drawn.lines.start;
+
+    auto& shape = it->second;
+    replaceVertices(_bufferTriangle, _bufferCountTriangle, _dirtyRangeTriangle, dirtyTriangle, &Shape::triangles,
+                    shape, drawn.triangles);
+    replaceVertices(_bufferPoint, _bufferCountPoint, _dirtyRangePoint, dirtyPoint, &Shape::points, shape,
+                    drawn.points);
+    replaceVertices(_bufferLine, _bufferCountLine, _dirtyRangeLine, dirtyLine, &Shape::lines, shape, drawn.lines);
+}
+
+void DrawNode::removeShape(unsigned int shapeId)
+{
+    auto it = _shapes.find(shapeId);
+    if (it == _shapes.end())
+        return;
+
+    Shape shape = it->second;
+    _shapes.erase(it);
+    eraseVertices(_bufferTriangle, _bufferCountTriangle, _dirtyRangeTriangle, &Shape::triangles, shape.triangles);
+    eraseVertices(_bufferPoint, _bufferCountPoint, _dirtyRangePoint, &Shape::points, shape.points);
+    eraseVertices(_bufferLine, _bufferCountLine, _dirtyRangeLine, &Shape::lines, shape.lines);
+}
+
+bool DrawNode::hasShape(unsigned int shapeId) const
+{
+    return _shapes.find(shapeId) != _shapes.end();
 }
 
 void DrawNode::clear()
@@ -774,6 +980,12 @@ void DrawNode::clear()
     _bufferCountPoint    = 0;
     _dirtyPoint          = true;
     _lineWidth           = _defaultLineWidth;
+
+    _dirtyRangeTriangle.reset();
+    _dirtyRangePoint.reset();
+    _dirtyRangeLine.reset();
+    _shapes.clear();
+    _shapeMark = Shape{};
 }
 
 const BlendFunc& DrawNode::getBlendFunc() const
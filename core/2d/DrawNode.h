@@ -39,6 +39,10 @@
 #include "math/Math.h"
 #include "base/any_buffer.h"
 
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
 NS_AX_BEGIN
 
 static const int DEFAULT_LINE_WIDTH = 2;
@@ -333,6 +337,35 @@ public:
 
     void drawTriangle(const Vec2& p1, const Vec2& p2, const Vec2& p3, const Color4B& color);
 
+    /** Starts a retained shape, everything drawn until endShape() belongs to it.
+     * A shape can later be redrawn or removed on its own, without clearing the node.
+     */
+    void beginShape();
+
+    /** Ends the shape started by beginShape().
+     *
+     * @return The id of the shape.
+     */
+    unsigned int endShape();
+
+    /** Redraws a shape with the geometry drawn by drawFunc. When the vertex counts are unchanged the shape is
+     * overwritten in place, so only its own vertices are uploaded again.
+     * drawFunc must only use the draw methods, not clear() nor the shape methods.
+     *
+     * @param shapeId The id returned by endShape().
+     * @param drawFunc Draws the new geometry of the shape.
+     */
+    void updateShape(unsigned int shapeId, const std::function<void(DrawNode*)>& drawFunc);
+
+    /** Removes a shape, the geometry drawn after it is moved down.
+     *
+     * @param shapeId The id returned by endShape().
+     */
+    void removeShape(unsigned int shapeId);
+
+    /** Whether the shape exists, clear() removes all the shapes. */
+    bool hasShape(unsigned int shapeId) const;
+
     /** Clear the geometry in the node's buffer. */
     void clear();
     /** Get the color mixed mode.
@@ -366,11 +399,63 @@ public:
 
     bool isIsolated() const { return _isolated; }
 
+    /**
+     * When dynamic is set, the geometry is uploaded once per frame into the renderer's vertex stream instead of
+     * being kept in buffers of its own, best for nodes cleared and redrawn every frame.
+     */
+    void setDynamic(bool dynamic);
+
+    bool isDynamic() const { return _dynamic; }
+
     DrawNode(float lineWidth = DEFAULT_LINE_WIDTH);
     virtual ~DrawNode();
     virtual bool init() override;
 
 protected:
+    /** Vertices changed since the last upload, [start, end). */
+    struct VertexRange
+    {
+        int start = 0;
+        int end   = 0;
+
+        void add(int first, int count)
+        {
+            if (count <= 0)
+                return;
+            if (start >= end)
+            {
+                start = first;
+                end   = first + count;
+            }
+            else
+            {
+                start = std::min(start, first);
+                end   = std::max(end, first + count);
+            }
+        }
+        void reset() { start = end = 0; }
+    };
+
+    struct VertexSpan
+    {
+        int start = 0;
+        int count = 0;
+    };
+
+    /** Vertices owned by a retained shape in each buffer. */
+    struct Shape
+    {
+        VertexSpan triangles;
+        VertexSpan points;
+        VertexSpan lines;
+    };
+
+    struct BezierWeights
+    {
+        Vec3 quad;
+        Vec4 cubic;
+    };
+
     void ensureCapacity(int count);
     void ensureCapacityGLPoint(int count);
     void ensureCapacityGLLine(int count);
@@ -387,6 +472,34 @@ protected:
     void updateBlendState(CustomCommand& cmd);
     void updateUniforms(const Mat4& transform, CustomCommand& cmd);
 
+    void resetVertexBuffer(CustomCommand& cmd, V2F_C4B_T2F* buffer, int capacity, int count);
+    void uploadVertexBuffer(CustomCommand& cmd, V2F_C4B_T2F* buffer, int capacity, int count, VertexRange& dirtyRange);
+    void streamVertexBuffer(Renderer* renderer, CustomCommand& cmd, V2F_C4B_T2F* buffer, int capacity, int count);
+
+    Shape getShapeMark() const;
+    void eraseVertices(V2F_C4B_T2F* buffer,
+                       int& count,
+                       VertexRange& dirtyRange,
+                       VertexSpan Shape::*member,
+                       VertexSpan span);
+    void replaceVertices(V2F_C4B_T2F* buffer,
+                         int& count,
+                         VertexRange& dirtyRange,
+                         const VertexRange& dirtyRangeBeforeDraw,
+                         VertexSpan Shape::*member,
+                         Shape& shape,
+                         VertexSpan drawn);
+
+    const Vec2* getCircleTable(unsigned int segments);
+    const BezierWeights* getBezierWeights(unsigned int segments);
+    void tessellateCircle(Vec2* vertices,
+                          const Vec2& center,
+                          float radius,
+                          float angle,
+                          unsigned int segments,
+                          float scaleX,
+                          float scaleY);
+
     int _bufferCapacityTriangle  = 0;
     int _bufferCountTriangle     = 0;
     V2F_C4B_T2F* _bufferTriangle = nullptr;
@@ -411,11 +524,25 @@ protected:
     bool _dirtyPoint        = false;
     bool _dirtyLine         = false;
     bool _isolated          = false;
+    bool _dynamic           = false;
     float _lineWidth        = 0.0f;
     float _defaultLineWidth = 0.0f;
 
     ax::any_buffer _abuf;
 
+    VertexRange _dirtyRangeTriangle;
+    VertexRange _dirtyRangePoint;
+    VertexRange _dirtyRangeLine;
+
+    std::unordered_map<unsigned int, Shape> _shapes;
+    Shape _shapeMark;
+    unsigned int _nextShapeId = 0;
+    bool _recordingShape      = false;
+
+    // unit circle and bezier basis for the last segment count used
+    std::vector<Vec2> _circleTable;
+    std::vector<BezierWeights> _bezierTable;
+
 private:
     AX_DISALLOW_COPY_AND_ASSIGN(DrawNode);
 };
@@ -48,6 +48,7 @@ THE SOFTWARE.
 #include "renderer/backend/Buffer.h"
 #include "base/Director.h"
 #include "base/UTF8.h"
+#include "base/AsyncTaskPool.h"
 #include "renderer/backend/ProgramState.h"
 
 NS_AX_BEGIN
@@ -98,8 +99,14 @@ bool FastTMXLayer::initWithTilesetInfo(TMXTilesetInfo* tilesetInfo, TMXLayerInfo
 
     // offset (after layer orientation is set);
     Vec2 offset = this->calculateLayerOffset(layerInfo->_offset);
+    // the layers of infinite maps only cover the bounds of their chunks
+    if (mapInfo->isInfinite())
+        offset += this->calculateChunkOriginOffset(layerInfo->_chunkOrigin, mapInfo->getMapSize());
     this->setPosition(AX_POINT_PIXELS_TO_POINTS(offset));
 
+    if (!_tiles && !layerInfo->_chunks.empty())
+        setupChunkStreaming(layerInfo);
+
     this->setContentSize(
         AX_SIZE_PIXELS_TO_POINTS(Vec2(_layerSize.width * _mapTileSize.width, _layerSize.height * _mapTileSize.height)));
 
@@ -117,6 +124,7 @@ FastTMXLayer::~FastTMXLayer()
 {
     AX_SAFE_RELEASE(_tileSet);
     AX_SAFE_RELEASE(_texture);
+    AX_SAFE_RELEASE(_layerInfo);
     AX_SAFE_FREE(_tiles);
     AX_SAFE_RELEASE(_vertexBuffer);
     AX_SAFE_RELEASE(_indexBuffer);
@@ -237,12 +245,30 @@ void FastTMXLayer::updateTiles(const Rect& culledRect)
     int xEnd =
         static_cast<int>(std::min(_layerSize.width, visibleTiles.origin.x + visibleTiles.size.width + tilesOverX));
 
+    if (isChunkStreaming())
+        updateStreamedChunks(xBegin, yBegin, xEnd, yEnd);
+
     for (int y = yBegin; y < yEnd; ++y)
     {
         for (int x = xBegin; x < xEnd; ++x)
         {
-            int tileIndex = getTileIndexByPos(x, y);
-            if (_tiles[tileIndex] == 0)
+            int quadIndexOfTile;
+            if (isChunkStreaming())
+            {
+                auto& chunk = _chunkGrid[(x / _chunkWidth) + (y / _chunkHeight) * _chunkGridWidth];
+                // loaded after the quads were built, or not loaded at all
+                if (chunk.tileToQuadIndex.empty())
+                {
+                    x = (x / _chunkWidth + 1) * _chunkWidth - 1;
+                    continue;
+                }
+                quadIndexOfTile = chunk.tileToQuadIndex[(x % _chunkWidth) + (y % _chunkHeight) * _chunkWidth];
+            }
+            else
+            {
+                quadIndexOfTile = _tileToQuadIndex[getTileIndexByPos(x, y)];
+            }
+            if (quadIndexOfTile < 0)
                 continue;
 
             int vertexZ = getVertexZForPos(Vec2((float)x, (float)y));
@@ -250,7 +276,7 @@ void FastTMXLayer::updateTiles(const Rect& culledRect)
             int offset  = iter->second;
             iter->second++;
 
-            auto quadIndex = static_cast<decltype(_indices)::value_type>(_tileToQuadIndex[tileIndex]);
+            auto quadIndex           = static_cast<decltype(_indices)::value_type>(quadIndexOfTile);
             _indices[6 * offset + 0] = quadIndex * 4 + 0;
             _indices[6 * offset + 1] = quadIndex * 4 + 1;
             _indices[6 * offset + 2] = quadIndex * 4 + 2;
@@ -274,10 +300,18 @@ void FastTMXLayer::updateTiles(const Rect& culledRect)
 void FastTMXLayer::updateVertexBuffer()
 {
     unsigned int vertexBufferSize = (unsigned int)(sizeof(V3F_C4B_T2F) * _totalQuads.size() * 4);
-    if (!_vertexBuffer)
+    if (vertexBufferSize == 0)
+        return;
+    // the quads of streaming layers grow as chunks are loaded
+    if (!_vertexBuffer || _vertexBuffer->getSize() < vertexBufferSize)
     {
+        AX_SAFE_RELEASE(_vertexBuffer);
         auto device   = backend::Device::getInstance();
-        _vertexBuffer = device->newBuffer(vertexBufferSize, backend::BufferType::VERTEX, backend::BufferUsage::STATIC);
+        auto capacity = isChunkStreaming() ? vertexBufferSize + vertexBufferSize / 2 : vertexBufferSize;
+        _vertexBuffer = device->newBuffer(capacity, backend::BufferType::VERTEX,
+                                          isChunkStreaming() ? backend::BufferUsage::DYNAMIC : backend::BufferUsage::STATIC);
+        for (auto&& e : _customCommands)
+            e.second->setVertexBuffer(_vertexBuffer);
     }
     _vertexBuffer->updateData(&_totalQuads[0], vertexBufferSize);
 }
@@ -285,10 +319,16 @@ void FastTMXLayer::updateVertexBuffer()
 void FastTMXLayer::updateIndexBuffer()
 {
     auto indexBufferSize = (sizeof(decltype(_indices)::value_type) * _indices.size());
-    if (!_indexBuffer)
+    if (indexBufferSize == 0)
+        return;
+    if (!_indexBuffer || _indexBuffer->getSize() < indexBufferSize)
     {
+        AX_SAFE_RELEASE(_indexBuffer);
         auto device  = backend::Device::getInstance();
-        _indexBuffer = device->newBuffer(indexBufferSize, backend::BufferType::INDEX, backend::BufferUsage::DYNAMIC);
+        auto capacity = isChunkStreaming() ? indexBufferSize + indexBufferSize / 2 : indexBufferSize;
+        _indexBuffer = device->newBuffer(capacity, backend::BufferType::INDEX, backend::BufferUsage::DYNAMIC);
+        for (auto&& e : _customCommands)
+            e.second->setIndexBuffer(_indexBuffer, e.second->getIndexFormat());
     }
     _indexBuffer->updateData(&_indices[0], indexBufferSize);
 }
@@ -332,7 +372,8 @@ void FastTMXLayer::setupTiles()
 
     _screenTileCount = (int)(_screenGridSize.width * _screenGridSize.height);
 
-    if (!_tileSet->_animationInfo.empty())
+    // the tiles of streaming layers aren't resident, their animated tiles aren't scanned
+    if (!_tileSet->_animationInfo.empty() && _tiles)
     {
         /// FastTMXLayer: anim support
         for (int y = 0; y < _layerSize.height; y++)
@@ -431,6 +472,13 @@ void FastTMXLayer::updatePrimitives()
 {
     auto blendfunc =
         _texture->hasPremultipliedAlpha() ? BlendFunc::ALPHA_PREMULTIPLIED : BlendFunc::ALPHA_NON_PREMULTIPLIED;
+
+    // vertex z levels which went out of sight don't draw anything
+    for (auto&& e : _customCommands)
+    {
+        if (_indicesVertexZNumber.find(e.first) == _indicesVertexZNumber.end())
+            e.second->setIndexDrawInfo(0, 0);
+    }
     for (const auto& iter : _indicesVertexZNumber)
     {
         int start = _indicesVertexZOffsets.at(iter.first);
@@ -495,12 +543,20 @@ void FastTMXLayer::updateTotalQuads()
 {
     if (_quadsDirty)
     {
-        Vec2 tileSize = AX_SIZE_PIXELS_TO_POINTS(_tileSet->_tileSize);
-        Vec2 texSize  = _tileSet->_imageSize;
+        int totalTiles = int(_layerSize.width * _layerSize.height);
+        if (isChunkStreaming())
+        {
+            // only the loaded chunks get quads
+            totalTiles = 0;
+            for (auto cellIndex : _residentChunks)
+                totalTiles += static_cast<int>(_chunkGrid[cellIndex].tiles.size());
+        }
+
         _tileToQuadIndex.clear();
-        _totalQuads.resize(int(_layerSize.width * _layerSize.height));
-        _indices.resize(6 * int(_layerSize.width * _layerSize.height));
-        _tileToQuadIndex.resize(int(_layerSize.width * _layerSize.height), -1);
+        _totalQuads.resize(totalTiles);
+        _indices.resize(6 * totalTiles);
+        if (!isChunkStreaming())
+            _tileToQuadIndex.resize(totalTiles, -1);
         _indicesVertexZOffsets.clear();
 
         auto color = Color4B::WHITE;
@@ -515,115 +571,48 @@ void FastTMXLayer::updateTotalQuads()
         }
 
         int quadIndex = 0;
-        for (int y = 0; y < _layerSize.height; ++y)
+        if (isChunkStreaming())
         {
-            for (int x = 0; x < _layerSize.width; ++x)
+            for (auto cellIndex : _residentChunks)
             {
-                int tileIndex = getTileIndexByPos(x, y);
-                int tileGID   = _tiles[tileIndex];
-
-                if (tileGID == 0)
+                auto& chunk = _chunkGrid[cellIndex];
+                chunk.tileToQuadIndex.clear();
+                if (chunk.state != StreamedChunk::State::LOADED)
                     continue;
 
-                _tileToQuadIndex[tileIndex] = quadIndex;
+                chunk.tileToQuadIndex.resize(chunk.tiles.size(), -1);
 
-                auto& quad = _totalQuads[quadIndex];
-
-                Vec3 nodePos(float(x), float(y), 0);
-                _tileToNodeTransform.transformPoint(&nodePos);
-
-                float left, right, top, bottom, z;
-
-                int zPos  = getVertexZForPos(Vec2((float)x, (float)y));
-                z         = (float)zPos;
-                auto iter = _indicesVertexZOffsets.find(zPos);
-                if (iter == _indicesVertexZOffsets.end())
+                int chunkX = (cellIndex % _chunkGridWidth) * _chunkWidth;
+                int chunkY = (cellIndex / _chunkGridWidth) * _chunkHeight;
+                for (int i = 0, count = static_cast<int>(chunk.tiles.size()); i < count; ++i)
                 {
-                    _indicesVertexZOffsets[zPos] = 1;
+                    uint32_t tileGID = chunk.tiles[i];
+                    if (tileGID == 0)
+                        continue;
+
+                    chunk.tileToQuadIndex[i] = quadIndex;
+                    fillTileQuad(_totalQuads[quadIndex], chunkX + i % _chunkWidth, chunkY + i / _chunkWidth, tileGID,
+                                 color);
+                    ++quadIndex;
                 }
-                else
-                {
-                    iter->second++;
-                }
-                // vertices
-                if (tileGID & kTMXTileDiagonalFlag)
-                {
-                    left   = nodePos.x;
-                    right  = nodePos.x + tileSize.height;
-                    bottom = nodePos.y + tileSize.width;
-                    top    = nodePos.y;
-                }
-                else
+            }
+        }
+        else
+        {
+            for (int y = 0; y < _layerSize.height; ++y)
+            {
+                for (int x = 0; x < _layerSize.width; ++x)
                 {
-                    left   = nodePos.x;
-                    right  = nodePos.x + tileSize.width;
-                    bottom = nodePos.y + tileSize.height;
-                    top    = nodePos.y;
-                }
+                    int tileIndex = getTileIndexByPos(x, y);
+                    int tileGID   = _tiles[tileIndex];
 
-                if (tileGID & kTMXTileVerticalFlag)
-                    std::swap(top, bottom);
-                if (tileGID & kTMXTileHorizontalFlag)
-                    std::swap(left, right);
+                    if (tileGID == 0)
+                        continue;
 
-                if (tileGID & kTMXTileDiagonalFlag)
-                {
-                    // FIXME: not working correctly
-                    quad.bl.vertices.x = left;
-                    quad.bl.vertices.y = bottom;
-                    quad.bl.vertices.z = z;
-                    quad.br.vertices.x = left;
-                    quad.br.vertices.y = top;
-                    quad.br.vertices.z = z;
-                    quad.tl.vertices.x = right;
-                    quad.tl.vertices.y = bottom;
-                    quad.tl.vertices.z = z;
-                    quad.tr.vertices.x = right;
-                    quad.tr.vertices.y = top;
-                    quad.tr.vertices.z = z;
-                }
-                else
-                {
-                    quad.bl.vertices.x = left;
-                    quad.bl.vertices.y = bottom;
-                    quad.bl.vertices.z = z;
-                    quad.br.vertices.x = right;
-                    quad.br.vertices.y = bottom;
-                    quad.br.vertices.z = z;
-                    quad.tl.vertices.x = left;
-                    quad.tl.vertices.y = top;
-                    quad.tl.vertices.z = z;
-                    quad.tr.vertices.x = right;
-                    quad.tr.vertices.y = top;
-                    quad.tr.vertices.z = z;
+                    _tileToQuadIndex[tileIndex] = quadIndex;
+                    fillTileQuad(_totalQuads[quadIndex], x, y, tileGID, color);
+                    ++quadIndex;
                 }
-
-                // texcoords
-                Rect tileTexture = _tileSet->getRectForGID(tileGID);
-                left             = (tileTexture.origin.x / texSize.width);
-                right            = left + (tileTexture.size.width / texSize.width);
-                bottom           = (tileTexture.origin.y / texSize.height);
-                top              = bottom + (tileTexture.size.height / texSize.height);
-
-                // issue#1085 OpenGL sub-pixel horizontal-vertical lines pixel-tolerance fix.
-                float ptx = 1.0 / (_tileSet->_imageSize.x * tileSize.x);
-                float pty = 1.0 / (_tileSet->_imageSize.y * tileSize.y);
-
-                quad.bl.texCoords.u = left + ptx;
-                quad.bl.texCoords.v = bottom + pty;
-                quad.br.texCoords.u = right - ptx;
-                quad.br.texCoords.v = bottom + pty;
-                quad.tl.texCoords.u = left + ptx;
-                quad.tl.texCoords.v = top - pty;
-                quad.tr.texCoords.u = right - ptx;
-                quad.tr.texCoords.v = top - pty;
-
-                quad.bl.colors = color;
-                quad.br.colors = color;
-                quad.tl.colors = color;
-                quad.tr.colors = color;
-
-                ++quadIndex;
             }
         }
 
@@ -639,13 +628,113 @@ void FastTMXLayer::updateTotalQuads()
     }
 }
 
+void FastTMXLayer::fillTileQuad(V3F_C4B_T2F_Quad& quad, int x, int y, uint32_t tileGID, const Color4B& color)
+{
+    Vec2 tileSize = AX_SIZE_PIXELS_TO_POINTS(_tileSet->_tileSize);
+    Vec2 texSize  = _tileSet->_imageSize;
+
+    Vec3 nodePos(float(x), float(y), 0);
+    _tileToNodeTransform.transformPoint(&nodePos);
+
+    float left, right, top, bottom, z;
+
+    int zPos  = getVertexZForPos(Vec2((float)x, (float)y));
+    z         = (float)zPos;
+    auto iter = _indicesVertexZOffsets.find(zPos);
+    if (iter == _indicesVertexZOffsets.end())
+    {
+        _indicesVertexZOffsets[zPos] = 1;
+    }
+    else
+    {
+        iter->second++;
+    }
+    // vertices
+    if (tileGID & kTMXTileDiagonalFlag)
+    {
+        left   = nodePos.x;
+        right  = nodePos.x + tileSize.height;
+        bottom = nodePos.y + tileSize.width;
+        top    = nodePos.y;
+    }
+    else
+    {
+        left   = nodePos.x;
+        right  = nodePos.x + tileSize.width;
+        bottom = nodePos.y + tileSize.height;
+        top    = nodePos.y;
+    }
+
+    if (tileGID & kTMXTileVerticalFlag)
+        std::swap(top, bottom);
+    if (tileGID & kTMXTileHorizontalFlag)
+        std::swap(left, right);
+
+    if (tileGID & kTMXTileDiagonalFlag)
+    {
+        // FIXME: not working correctly
+        quad.bl.vertices.x = left;
+        quad.bl.vertices.y = bottom;
+        quad.bl.vertices.z = z;
+        quad.br.vertices.x = left;
+        quad.br.vertices.y = top;
+        quad.br.vertices.z = z;
+        quad.tl.vertices.x = right;
+        quad.tl.vertices.y = bottom;
+        quad.tl.vertices.z = z;
+        quad.tr.vertices.x = right;
+        quad.tr.vertices.y = top;
+        quad.tr.vertices.z = z;
+    }
+    else
+    {
+        quad.bl.vertices.x = left;
+        quad.bl.vertices.y = bottom;
+        quad.bl.vertices.z = z;
+        quad.br.vertices.x = right;
+        quad.br.vertices.y = bottom;
+        quad.br.vertices.z = z;
+        quad.tl.vertices.x = left;
+        quad.tl.vertices.y = top;
+        quad.tl.vertices.z = z;
+        quad.tr.vertices.x = right;
+        quad.tr.vertices.y = top;
+        quad.tr.vertices.z = z;
+    }
+
+    // texcoords
+    Rect tileTexture = _tileSet->getRectForGID(tileGID);
+    left             = (tileTexture.origin.x / texSize.width);
+    right            = left + (tileTexture.size.width / texSize.width);
+    bottom           = (tileTexture.origin.y / texSize.height);
+    top              = bottom + (tileTexture.size.height / texSize.height);
+
+    // issue#1085 OpenGL sub-pixel horizontal-vertical lines pixel-tolerance fix.
+    float ptx = 1.0 / (_tileSet->_imageSize.x * tileSize.x);
+    float pty = 1.0 / (_tileSet->_imageSize.y * tileSize.y);
+
+    quad.bl.texCoords.u = left + ptx;
+    quad.bl.texCoords.v = bottom + pty;
+    quad.br.texCoords.u = right - ptx;
+    quad.br.texCoords.v = bottom + pty;
+    quad.tl.texCoords.u = left + ptx;
+    quad.tl.texCoords.v = top - pty;
+    quad.tr.texCoords.u = right - ptx;
+    quad.tr.texCoords.v = top - pty;
+
+    quad.bl.colors = color;
+    quad.br.colors = color;
+    quad.tl.colors = color;
+    quad.tr.colors = color;
+}
+
 // removing / getting tiles
 Sprite* FastTMXLayer::getTileAt(const Vec2& tileCoordinate)
 {
     AXASSERT(tileCoordinate.x < _layerSize.width && tileCoordinate.y < _layerSize.height && tileCoordinate.x >= 0 &&
                  tileCoordinate.y >= 0,
              "TMXLayer: invalid position");
-    AXASSERT(_tiles, "TMXLayer: the tiles map has been released");
+    AXASSERT(_tiles || isChunkStreaming(), "TMXLayer: the tiles map has been released");
 
     TMXTileFlags flags;
     Sprite* tile = nullptr;
@@ -688,13 +777,15 @@ int FastTMXLayer::getTileGIDAt(const Vec2& tileCoordinate, TMXTileFlags* flags /
     AXASSERT(tileCoordinate.x < _layerSize.width && tileCoordinate.y < _layerSize.height && tileCoordinate.x >= 0 &&
                  tileCoordinate.y >= 0,
              "TMXLayer: invalid position");
-    AXASSERT(_tiles, "TMXLayer: the tiles map has been released");
+    AXASSERT(_tiles || isChunkStreaming(), "TMXLayer: the tiles map has been released");
 
     int idx = static_cast<int>(((int)tileCoordinate.x + (int)tileCoordinate.y * _layerSize.width));
 
     // Bits on the far end of the 32-bit global tile ID are used for tile flags
-    int tile = _tiles[idx];
-    auto it  = _spriteContainer.find(idx);
+    // tiles of chunks which aren't loaded are reported as empty
+    auto slot = getTileSlot((int)tileCoordinate.x, (int)tileCoordinate.y);
+    int tile  = slot ? *slot : 0;
+    auto it   = _spriteContainer.find(idx);
 
     // converted to sprite.
     if (tile == 0 && it != _spriteContainer.end())
@@ -775,11 +866,32 @@ void FastTMXLayer::removeTileAt(const Vec2& tileCoordinate)
 
 void FastTMXLayer::setFlaggedTileGIDByIndex(int index, uint32_t gid)
 {
-    if (gid == _tiles[index])
+    int x     = index % (int)_layerSize.width;
+    int y     = index / (int)_layerSize.width;
+    auto slot = getTileSlot(x, y);
+    if (!slot)
+    {
+        AXLOG("axmol: FastTMXLayer: can't set tile %d,%d, its chunk isn't loaded", x, y);
         return;
-    _tiles[index] = gid;
-    _quadsDirty   = true;
-    _dirty        = true;
+    }
+    if (gid == *slot)
+        return;
+    *slot = gid;
+    if (isChunkStreaming())
+        _chunkGrid[(x / _chunkWidth) + (y / _chunkHeight) * _chunkGridWidth].modified = true;
+    _quadsDirty = true;
+    _dirty      = true;
+}
+
+uint32_t* FastTMXLayer::getTileSlot(int x, int y)
+{
+    if (!isChunkStreaming())
+        return &_tiles[getTileIndexByPos(x, y)];
+
+    auto& chunk = _chunkGrid[(x / _chunkWidth) + (y / _chunkHeight) * _chunkGridWidth];
+    if (chunk.state != StreamedChunk::State::LOADED)
+        return nullptr;
+    return &chunk.tiles[(x % _chunkWidth) + (y % _chunkHeight) * _chunkWidth];
 }
 
 void FastTMXLayer::removeChild(Node* node, bool cleanup)
@@ -843,6 +955,166 @@ Vec2 FastTMXLayer::calculateLayerOffset(const Vec2& pos)
     return ret;
 }
 
+Vec2 FastTMXLayer::calculateChunkOriginOffset(const Vec2& chunkOrigin, const Vec2& mapSize)
+{
+    // moves the first tile of the layer to where the chunk origin is on a map sized layer
+    Vec2 ret;
+    switch (_layerOrientation)
+    {
+    case FAST_TMX_ORIENTATION_ORTHO:
+        ret.set(chunkOrigin.x * _mapTileSize.width,
+                (mapSize.height - chunkOrigin.y - _layerSize.height) * _mapTileSize.height);
+        break;
+    case FAST_TMX_ORIENTATION_ISO:
+        ret.set((_mapTileSize.width / 2) * (chunkOrigin.x - chunkOrigin.y + mapSize.width - _layerSize.width),
+                (_mapTileSize.height / 2) * (-chunkOrigin.x - chunkOrigin.y) +
+                    (mapSize.height - _layerSize.height) * _mapTileSize.height);
+        break;
+    case FAST_TMX_ORIENTATION_HEX:
+    default:
+        AXASSERT(chunkOrigin.isZero(), "chunks for this map not implemented yet");
+        break;
+    }
+    return ret;
+}
+
+// FastTMXLayer - chunk streaming
+void FastTMXLayer::setupChunkStreaming(TMXLayerInfo* layerInfo)
+{
+    _layerInfo = layerInfo;
+    _layerInfo->retain();
+
+    _chunkWidth      = std::max(1, static_cast<int>(layerInfo->_chunkSize.width));
+    _chunkHeight     = std::max(1, static_cast<int>(layerInfo->_chunkSize.height));
+    _chunkGridWidth  = (static_cast<int>(_layerSize.width) + _chunkWidth - 1) / _chunkWidth;
+    int gridHeight   = (static_cast<int>(_layerSize.height) + _chunkHeight - 1) / _chunkHeight;
+    _chunkGrid.resize(static_cast<size_t>(_chunkGridWidth) * gridHeight);
+
+    const int originX = static_cast<int>(layerInfo->_chunkOrigin.x);
+    const int originY = static_cast<int>(layerInfo->_chunkOrigin.y);
+    for (int i = 0, count = static_cast<int>(layerInfo->_chunks.size()); i < count; ++i)
+    {
+        auto& chunk = layerInfo->_chunks[i];
+        int cellX   = (chunk._x - originX) / _chunkWidth;
+        int cellY   = (chunk._y - originY) / _chunkHeight;
+        AXASSERT(chunk._width <= _chunkWidth && chunk._height <= _chunkHeight, "TMXLayer: chunks of different sizes");
+        _chunkGrid[cellX + cellY * _chunkGridWidth].chunkIndex = i;
+    }
+}
+
+void FastTMXLayer::setChunkStreamingMargins(int loadMargin, int unloadMargin)
+{
+    _chunkLoadMargin   = std::max(0, loadMargin);
+    _chunkUnloadMargin = std::max(_chunkLoadMargin, unloadMargin);
+    _dirty             = true;
+}
+
+int FastTMXLayer::getLoadedChunkCount() const
+{
+    return static_cast<int>(std::count_if(_residentChunks.begin(), _residentChunks.end(), [this](int cellIndex) {
+        return _chunkGrid[cellIndex].state == StreamedChunk::State::LOADED;
+    }));
+}
+
+void FastTMXLayer::updateStreamedChunks(int xBegin, int yBegin, int xEnd, int yEnd)
+{
+    if (xBegin >= xEnd || yBegin >= yEnd)
+        return;
+
+    const int gridHeight = static_cast<int>(_chunkGrid.size()) / _chunkGridWidth;
+    const int cellXBegin = xBegin / _chunkWidth;
+    const int cellYBegin = yBegin / _chunkHeight;
+    const int cellXEnd   = (xEnd - 1) / _chunkWidth + 1;
+    const int cellYEnd   = (yEnd - 1) / _chunkHeight + 1;
+
+    // release the chunks which are far away
+    for (size_t i = 0; i < _residentChunks.size();)
+    {
+        int cellIndex = _residentChunks[i];
+        int cellX     = cellIndex % _chunkGridWidth;
+        int cellY     = cellIndex / _chunkGridWidth;
+        if (!_chunkGrid[cellIndex].modified &&
+            (cellX < cellXBegin - _chunkUnloadMargin || cellX >= cellXEnd + _chunkUnloadMargin ||
+             cellY < cellYBegin - _chunkUnloadMargin || cellY >= cellYEnd + _chunkUnloadMargin))
+        {
+            unloadChunk(cellIndex);
+            _residentChunks[i] = _residentChunks.back();
+            _residentChunks.pop_back();
+        }
+        else
+        {
+            ++i;
+        }
+    }
+
+    // request the chunks around the visible area
+    for (int cellY = std::max(0, cellYBegin - _chunkLoadMargin); cellY < std::min(gridHeight, cellYEnd + _chunkLoadMargin);
+         ++cellY)
+    {
+        for (int cellX = std::max(0, cellXBegin - _chunkLoadMargin);
+             cellX < std::min(_chunkGridWidth, cellXEnd + _chunkLoadMargin); ++cellX)
+        {
+            int cellIndex = cellX + cellY * _chunkGridWidth;
+            auto& chunk   = _chunkGrid[cellIndex];
+            if (chunk.chunkIndex >= 0 && chunk.state == StreamedChunk::State::UNLOADED)
+            {
+                _residentChunks.emplace_back(cellIndex);
+                loadChunk(cellIndex);
+            }
+        }
+    }
+}
+
+void FastTMXLayer::loadChunk(int cellIndex)
+{
+    auto& cell      = _chunkGrid[cellIndex];
+    cell.state      = StreamedChunk::State::LOADING;
+    auto generation = ++cell.generation;
+
+    // the layer info is retained and its chunks don't change, so the worker can read them in place
+    const TMXChunkInfo* chunk = &_layerInfo->_chunks[cell.chunkIndex];
+    const int chunkWidth      = _chunkWidth;
+    const int chunkHeight     = _chunkHeight;
+    auto tiles                = std::make_shared<std::vector<uint32_t>>();
+
+    this->retain();
+    AsyncTaskPool::getInstance()->enqueue(
+        AsyncTaskPool::TaskType::TASK_IO,
+        [this, cellIndex, generation, tiles](void*) {
+            auto& cell = _chunkGrid[cellIndex];
+            if (cell.generation == generation && cell.state == StreamedChunk::State::LOADING)
+            {
+                cell.tiles  = std::move(*tiles);
+                cell.state  = StreamedChunk::State::LOADED;
+                _quadsDirty = true;
+                _dirty      = true;
+            }
+            this->release();
+        },
+        nullptr,
+        [cookedFile = _layerInfo->_cookedFile, chunk, chunkWidth, chunkHeight, tiles]() {
+            std::vector<uint32_t> decoded;
+            // empty tiles for chunks which can't be decoded, so they aren't requested again
+            tiles->resize(static_cast<size_t>(chunkWidth) * chunkHeight);
+            if (!TMXMapInfo::decodeChunk(cookedFile, *chunk, decoded))
+                return;
+            // chunks at the edges of cooked layers may be smaller than the grid cells
+            for (int y = 0; y < chunk->_height; ++y)
+                std::copy_n(decoded.begin() + y * chunk->_width, chunk->_width, tiles->begin() + y * chunkWidth);
+        });
+}
+
+void FastTMXLayer::unloadChunk(int cellIndex)
+{
+    auto& cell = _chunkGrid[cellIndex];
+    // a pending load of this chunk is discarded by the generation check
+    ++cell.generation;
+    cell.state = StreamedChunk::State::UNLOADED;
+    std::vector<uint32_t>{}.swap(cell.tiles);
+    std::vector<int>{}.swap(cell.tileToQuadIndex);
+    _quadsDirty = true;
+}
+
 // TMXLayer - adding / remove tiles
 void FastTMXLayer::setTileGID(int gid, const Vec2& tileCoordinate)
 {
@@ -854,7 +1126,7 @@ void FastTMXLayer::setTileGID(int gid, const Vec2& tileCoordinate, TMXTileFlags
     AXASSERT(tileCoordinate.x < _layerSize.width && tileCoordinate.y < _layerSize.height && tileCoordinate.x >= 0 &&
                  tileCoordinate.y >= 0,
              "TMXLayer: invalid position");
-    AXASSERT(_tiles, "TMXLayer: the tiles map has been released");
+    AXASSERT(_tiles || isChunkStreaming(), "TMXLayer: the tiles map has been released");
     AXASSERT(gid == 0 || gid >= _tileSet->_firstGid, "TMXLayer: invalid gid");
 
     TMXTileFlags currentFlags;
@@ -301,6 +301,23 @@ public:
                                                      TMXLayerInfo* layerInfo,
                                                      TMXMapInfo* mapInfo);
 
+    /** Whether the layer streams its chunks in and out around the visible area.
+     * This is the case for layers of maps loaded with chunk streaming, see FastTMXTiledMap::createWithChunkStreaming.
+     */
+    bool isChunkStreaming() const { return !_chunkGrid.empty(); }
+
+    /** Sets how far around the visible area the chunks of a streaming layer are kept loaded.
+     * Chunks within loadMargin chunks of the visible area are decoded on a worker thread, and chunks further
+     * than unloadMargin chunks away are released unless their tiles were modified.
+     *
+     * @param loadMargin Number of chunks around the visible area to load, default is 1.
+     * @param unloadMargin Number of chunks around the visible area to keep, default is 2.
+     */
+    void setChunkStreamingMargins(int loadMargin, int unloadMargin);
+
+    /** Number of chunks currently decoded in memory. */
+    int getLoadedChunkCount() const;
+
 protected:
     virtual void setOpacity(uint8_t opacity) override;
 
@@ -323,6 +340,16 @@ protected:
 
     int getTileIndexByPos(int x, int y) const { return x + y * (int)_layerSize.width; }
 
+    /* the tile storage of a tile coordinate, nullptr if it's in a chunk which isn't loaded */
+    uint32_t* getTileSlot(int x, int y);
+    void fillTileQuad(V3F_C4B_T2F_Quad& quad, int x, int y, uint32_t tileGID, const Color4B& color);
+
+    Vec2 calculateChunkOriginOffset(const Vec2& chunkOrigin, const Vec2& mapSize);
+    void setupChunkStreaming(TMXLayerInfo* layerInfo);
+    void updateStreamedChunks(int xBegin, int yBegin, int xEnd, int yEnd);
+    void loadChunk(int cellIndex);
+    void unloadChunk(int cellIndex);
+
     void updateVertexBuffer();
     void updateIndexBuffer();
     void updatePrimitives();
@@ -389,6 +416,37 @@ protected:
     backend::UniformLocation _mvpMatrixLocaiton;
     backend::UniformLocation _textureLocation;
     backend::UniformLocation _alphaValueLocation;
+
+    /** a cell of the chunk grid of a streaming layer */
+    struct StreamedChunk
+    {
+        enum class State : uint8_t
+        {
+            UNLOADED,
+            LOADING,
+            LOADED,
+        };
+        /** index into the chunks of the layer info, -1 if no chunk covers this cell */
+        int chunkIndex = -1;
+        State state    = State::UNLOADED;
+        /** tiles were modified, the chunk is kept loaded */
+        bool modified = false;
+        /** discards results of loads which were cancelled by an unload */
+        uint32_t generation = 0;
+        std::vector<uint32_t> tiles;
+        std::vector<int> tileToQuadIndex;
+    };
+
+    /** layer info providing the chunks, retained while streaming */
+    TMXLayerInfo* _layerInfo = nullptr;
+    std::vector<StreamedChunk> _chunkGrid;
+    /** cells of the chunk grid which are loading or loaded */
+    std::vector<int> _residentChunks;
+    int _chunkGridWidth   = 0;
+    int _chunkWidth       = 0;
+    int _chunkHeight      = 0;
+    int _chunkLoadMargin  = 1;
+    int _chunkUnloadMargin = 2;
 };
 
 /** @brief TMXTileAnimTask represents the frame-tick task of an animated tile.
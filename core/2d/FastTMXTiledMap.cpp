@@ -45,6 +45,18 @@ FastTMXTiledMap* FastTMXTiledMap::create(std::string_view tmxFile)
     return nullptr;
 }
 
+FastTMXTiledMap* FastTMXTiledMap::createWithChunkStreaming(std::string_view tmxFile, std::string_view cookedFile)
+{
+    FastTMXTiledMap* ret = new FastTMXTiledMap();
+    if (ret->initWithChunkStreaming(tmxFile, cookedFile))
+    {
+        ret->autorelease();
+        return ret;
+    }
+    AX_SAFE_DELETE(ret);
+    return nullptr;
+}
+
 FastTMXTiledMap* FastTMXTiledMap::createWithXML(std::string_view tmxString, std::string_view resourcePath)
 {
     FastTMXTiledMap* ret = new FastTMXTiledMap();
@@ -77,6 +89,30 @@ bool FastTMXTiledMap::initWithTMXFile(std::string_view tmxFile)
     return true;
 }
 
+bool FastTMXTiledMap::initWithChunkStreaming(std::string_view tmxFile, std::string_view cookedFile)
+{
+    AXASSERT(tmxFile.size() > 0, "FastTMXTiledMap: tmx file should not be empty");
+
+    setContentSize(Vec2::ZERO);
+
+    TMXMapInfo* mapInfo = TMXMapInfo::create(tmxFile, true);
+
+    if (!mapInfo)
+    {
+        return false;
+    }
+    if (!cookedFile.empty() && !mapInfo->loadCookedChunks(cookedFile))
+    {
+        return false;
+    }
+    AXASSERT(!mapInfo->getTilesets().empty(), "FastTMXTiledMap: Map not found. Please check the filename.");
+    buildWithMapInfo(mapInfo);
+
+    _tmxFile = tmxFile;
+
+    return true;
+}
+
 bool FastTMXTiledMap::initWithXML(std::string_view tmxString, std::string_view resourcePath)
 {
     setContentSize(Vec2::ZERO);
@@ -114,6 +150,34 @@ TMXTilesetInfo* FastTMXTiledMap::tilesetForLayer(TMXLayerInfo* layerInfo, TMXMap
     Vec2 size      = layerInfo->_layerSize;
     auto& tilesets = mapInfo->getTilesets();
 
+    if (!layerInfo->_tiles)
+    {
+        // streaming layer, decode chunks until a tile is found
+        std::vector<uint32_t> tiles;
+        for (auto&& chunk : layerInfo->_chunks)
+        {
+            if (!TMXMapInfo::decodeChunk(layerInfo->_cookedFile, chunk, tiles))
+                continue;
+
+            auto it = std::find_if(tiles.begin(), tiles.end(), [](uint32_t gid) { return gid != 0; });
+            if (it == tiles.end())
+                continue;
+
+            for (auto iter = tilesets.crbegin(), iterCrend = tilesets.crend(); iter != iterCrend; ++iter)
+            {
+                TMXTilesetInfo* tilesetInfo = *iter;
+                if (tilesetInfo && (*it & kTMXFlippedMask) >= static_cast<uint32_t>(tilesetInfo->_firstGid))
+                {
+                    return tilesetInfo;
+                }
+            }
+            break;
+        }
+
+        AXLOG("axmol: Warning: TMX Layer '%s' has no tiles", layerInfo->_name.c_str());
+        return nullptr;
+    }
+
     for (auto iter = tilesets.crbegin(), iterCrend = tilesets.crend(); iter != iterCrend; ++iter)
     {
         TMXTilesetInfo* tilesetInfo = *iter;
@@ -111,6 +111,16 @@ public:
      */
     static FastTMXTiledMap* createWithXML(std::string_view tmxString, std::string_view resourcePath);
 
+    /** Creates a TMX Tiled Map whose layers stream their chunks in around the visible area.
+     * The chunks of Tiled infinite maps, or of a cooked map file written by TMXMapInfo::writeCookedChunks,
+     * are decoded on a worker thread when they come near the camera and released when they are far away.
+     *
+     * @param tmxFile A TMX file.
+     * @param cookedFile An optional cooked map file providing the tile data of the layers.
+     * @return An autorelease object.
+     */
+    static FastTMXTiledMap* createWithChunkStreaming(std::string_view tmxFile, std::string_view cookedFile = "");
+
     /** Return the FastTMXLayer for the specific layer.
      *
      * @return Return the FastTMXLayer for the specific layer.
@@ -222,6 +232,9 @@ public:
     /** initializes a TMX Tiled Map with a TMX file */
     bool initWithTMXFile(std::string_view tmxFile);
 
+    /** initializes a TMX Tiled Map with a TMX file whose layers stream their chunks */
+    bool initWithChunkStreaming(std::string_view tmxFile, std::string_view cookedFile);
+
     /** initializes a TMX Tiled Map with a TMX formatted XML string and a path to TMX resources */
     bool initWithXML(std::string_view tmxString, std::string_view resourcePath);
 
@@ -43,6 +43,11 @@ class AX_DLL Font : public Ref
 public:
     virtual FontAtlas* newFontAtlas()                                                                   = 0;
     virtual int* getHorizontalKerningForTextUTF32(const std::u32string& text, int& outNumLetters) const = 0;
+    /**
+     * Same as getHorizontalKerningForTextUTF32, but writes into outKernings which holds text.length() values.
+     * @return false if the font has no kerning, outKernings is left untouched then.
+     */
+    virtual bool fillHorizontalKerningForTextUTF32(std::u32string_view text, int* outKernings) const { return false; }
     virtual int getFontMaxHeight() const { return 0; }
 };
 
@@ -627,15 +627,26 @@ int* FontFNT::getHorizontalKerningForTextUTF32(const std::u32string& text, int&
         return nullptr;
 
     int* sizes = new int[outNumLetters];
-    for (int c = 0; c < outNumLetters; ++c)
+    fillHorizontalKerningForTextUTF32(text, sizes);
+
+    return sizes;
+}
+
+bool FontFNT::fillHorizontalKerningForTextUTF32(std::u32string_view text, int* outKernings) const
+{
+    const auto numLetters = text.length();
+    if (!numLetters)
+        return false;
+
+    for (size_t c = 0; c < numLetters; ++c)
     {
-        if (c < (outNumLetters - 1))
-            sizes[c] = getHorizontalKerningForChars(text[c], text[c + 1]);
+        if (c < (numLetters - 1))
+            outKernings[c] = getHorizontalKerningForChars(text[c], text[c + 1]);
         else
-            sizes[c] = 0;
+            outKernings[c] = 0;
     }
 
-    return sizes;
+    return true;
 }
 
 int FontFNT::getHorizontalKerningForChars(char32_t firstChar, char32_t secondChar) const
@@ -156,6 +156,7 @@ public:
     */
     static void purgeCachedData();
     virtual int* getHorizontalKerningForTextUTF32(const std::u32string& text, int& outNumLetters) const override;
+    virtual bool fillHorizontalKerningForTextUTF32(std::u32string_view text, int* outKernings) const override;
     virtual FontAtlas* newFontAtlas() override;
 
     void setFontSize(float fontSize);
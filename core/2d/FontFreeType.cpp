@@ -332,18 +332,24 @@ int* FontFreeType::getHorizontalKerningForTextUTF32(const std::u32string& text,
         return nullptr;
 
     int* sizes = new int[outNumLetters];
-    memset(sizes, 0, outNumLetters * sizeof(int));
+    if (!fillHorizontalKerningForTextUTF32(text, sizes))
+        memset(sizes, 0, outNumLetters * sizeof(int));
 
-    bool hasKerning = FT_HAS_KERNING(_fontFace) != 0;
-    if (hasKerning)
+    return sizes;
+}
+
+bool FontFreeType::fillHorizontalKerningForTextUTF32(std::u32string_view text, int* outKernings) const
+{
+    if (!_fontFace || text.empty() || !FT_HAS_KERNING(_fontFace))
+        return false;
+
+    outKernings[0] = 0;
+    for (size_t c = 1; c < text.length(); ++c)
     {
-        for (int c = 1; c < outNumLetters; ++c)
-        {
-            sizes[c] = getHorizontalKerningForChars(text[c - 1], text[c]);
-        }
+        outKernings[c] = getHorizontalKerningForChars(text[c - 1], text[c]);
     }
 
-    return sizes;
+    return true;
 }
 
 int FontFreeType::getHorizontalKerningForChars(uint64_t firstChar, uint64_t secondChar) const
@@ -115,6 +115,7 @@ public:
                       int atlasHeight);
 
     int* getHorizontalKerningForTextUTF32(const std::u32string& text, int& outNumLetters) const override;
+    bool fillHorizontalKerningForTextUTF32(std::u32string_view text, int* outKernings) const override;
 
     unsigned char* getGlyphBitmap(char32_t charCode, int& outWidth, int& outHeight, Rect& outRect, int& xAdvance);
 
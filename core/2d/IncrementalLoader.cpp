@@ -0,0 +1,188 @@
+/****************************************************************************
+ Copyright (c) 2022 Bytedance Inc.
+
+ https://axmolengine.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "2d/IncrementalLoader.h"
+
+#include <chrono>
+
+#include "2d/Node.h"
+#include "2d/SpriteFrameCache.h"
+#include "base/Director.h"
+#include "base/FrameProfiler.h"
+#include "base/Scheduler.h"
+#include "renderer/TextureCache.h"
+
+NS_AX_BEGIN
+
+IncrementalLoader* IncrementalLoader::create()
+{
+    auto loader = new IncrementalLoader();
+    loader->autorelease();
+    return loader;
+}
+
+IncrementalLoader::IncrementalLoader() {}
+
+IncrementalLoader::~IncrementalLoader()
+{
+    AX_SAFE_RELEASE(_node);
+    AX_SAFE_RELEASE(_parent);
+}
+
+void IncrementalLoader::addTexture(std::string_view path)
+{
+    std::string texturePath{path};
+    addAsyncTask([texturePath = std::move(texturePath)](const std::function<void()>& done) {
+        Director::getInstance()->getTextureCache()->addImageAsync(texturePath, [done](Texture2D*) { done(); });
+    });
+}
+
+void IncrementalLoader::addSpriteFrames(std::string_view spriteSheetFileName, uint32_t spriteSheetFormat)
+{
+    std::string spriteSheet{spriteSheetFileName};
+    addAsyncTask([spriteSheet = std::move(spriteSheet), spriteSheetFormat](const std::function<void()>& done) {
+        SpriteFrameCache::getInstance()->addSpriteFramesWithFileAsync(
+            spriteSheet, [done](bool) { done(); }, spriteSheetFormat);
+    });
+}
+
+void IncrementalLoader::addAsyncTask(AsyncTask task)
+{
+    AXASSERT(!_running, "resources must be added before the loader starts");
+    _tasks.emplace_back(std::move(task));
+    ++_totalWork;
+}
+
+void IncrementalLoader::addStep(Step step)
+{
+    _steps.emplace_back(std::move(step));
+    ++_totalWork;
+}
+
+void IncrementalLoader::setNode(Node* node)
+{
+    AX_SAFE_RETAIN(node);
+    AX_SAFE_RELEASE(_node);
+    _node = node;
+}
+
+void IncrementalLoader::setParent(Node* parent)
+{
+    AX_SAFE_RETAIN(parent);
+    AX_SAFE_RELEASE(_parent);
+    _parent = parent;
+}
+
+void IncrementalLoader::start()
+{
+    if (_running || _done)
+        return;
+
+    _running = true;
+    retain();
+
+    Director::getInstance()->getScheduler()->schedule(AX_CALLBACK_1(IncrementalLoader::update, this), this, 0, false,
+                                                      "IncrementalLoader");
+
+    // every task keeps the loader alive, they may complete after a cancel
+    _pendingTasks = static_cast<unsigned int>(_tasks.size());
+    auto tasks    = std::move(_tasks);
+    for (auto&& task : tasks)
+    {
+        retain();
+        task([this]() {
+            --_pendingTasks;
+            ++_doneWork;
+            release();
+        });
+    }
+}
+
+void IncrementalLoader::cancel()
+{
+    if (!_running)
+        return;
+
+    Director::getInstance()->getScheduler()->unschedule("IncrementalLoader", this);
+    _steps.clear();
+    _running = false;
+    release();
+}
+
+float IncrementalLoader::getProgress() const
+{
+    return _totalWork ? static_cast<float>(_doneWork) / _totalWork : 1.0f;
+}
+
+void IncrementalLoader::update(float /*dt*/)
+{
+    AX_PROFILER_ZONE("IncrementalLoader::update");
+
+    // a step or a callback may cancel the loader
+    retain();
+
+    // the steps may need any of the resources
+    if (_pendingTasks == 0)
+    {
+        using namespace std::chrono;
+        const auto deadline =
+            steady_clock::now() + duration_cast<steady_clock::duration>(duration<float>(_frameBudget));
+        ++_frameCount;
+        while (_running && !_steps.empty())
+        {
+            auto step = std::move(_steps.front());
+            _steps.pop_front();
+            step();
+            ++_doneWork;
+
+            if (steady_clock::now() >= deadline)
+                break;
+        }
+    }
+
+    if (_running && _progressCallback)
+        _progressCallback(getProgress());
+
+    if (_running && _pendingTasks == 0 && _steps.empty())
+        finish();
+
+    release();
+}
+
+void IncrementalLoader::finish()
+{
+    Director::getInstance()->getScheduler()->unschedule("IncrementalLoader", this);
+    _running = false;
+    _done    = true;
+
+    if (_node && _parent)
+        _parent->addChild(_node);
+    if (_completionCallback)
+        _completionCallback(_node);
+
+    setParent(nullptr);
+    release();
+}
+
+NS_AX_END
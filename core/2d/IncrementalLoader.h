@@ -0,0 +1,148 @@
+/****************************************************************************
+ Copyright (c) 2022 Bytedance Inc.
+
+ https://axmolengine.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <deque>
+#include <functional>
+#include <string_view>
+#include <vector>
+
+#include "base/Ref.h"
+#include "2d/SpriteSheetLoader.h"
+
+NS_AX_BEGIN
+
+class Node;
+
+/**
+ * @addtogroup _2d
+ * @{
+ */
+
+/**
+ * @class IncrementalLoader
+ * @brief Builds a node tree over several frames instead of blocking one.
+ *
+ * Work is queued as resources and steps. Resources (textures, sprite sheets or any asynchronous task) are all
+ * started at once and loaded off the main thread; once they are ready the steps run in order on the main thread,
+ * as many per frame as fit in the frame budget. A step may queue more steps, which lets a builder walk a tree one
+ * node at a time.
+ *
+ * The result node is only added to its parent when everything is done, so a half built scene is never visible.
+ * @code
+ * auto loader = IncrementalLoader::create();
+ * loader->addSpriteFrames("ui.plist");
+ * loader->addStep([loader]() { loader->setNode(Node::create()); });
+ * loader->setProgressCallback([bar](float progress) { bar->setPercent(progress * 100); });
+ * loader->setCompletionCallback([](Node* node) { ... });
+ * loader->start();
+ * @endcode
+ */
+class AX_DLL IncrementalLoader : public Ref
+{
+public:
+    /** Default time the steps may take each frame, in seconds. */
+    static constexpr float DEFAULT_FRAME_BUDGET = 0.004f;
+
+    /** A unit of main thread work. */
+    using Step = std::function<void()>;
+
+    /** An asynchronous load, it must call done on the main thread once finished. */
+    using AsyncTask = std::function<void(const std::function<void()>& done)>;
+
+    static IncrementalLoader* create();
+
+    IncrementalLoader();
+    virtual ~IncrementalLoader();
+
+    /** Sets how long the steps may run each frame, in seconds. At least one step runs per frame. */
+    void setFrameBudget(float seconds) { _frameBudget = seconds; }
+    float getFrameBudget() const { return _frameBudget; }
+
+    /** Loads a texture with TextureCache::addImageAsync before the steps run. */
+    void addTexture(std::string_view path);
+
+    /** Loads a sprite sheet with SpriteFrameCache::addSpriteFramesWithFileAsync before the steps run. */
+    void addSpriteFrames(std::string_view spriteSheetFileName,
+                         uint32_t spriteSheetFormat = SpriteSheetFormat::PLIST);
+
+    /** Runs an asynchronous task before the steps run. */
+    void addAsyncTask(AsyncTask task);
+
+    /** Queues a step, it may be called while the loader is running. */
+    void addStep(Step step);
+
+    /** Sets the node being built, it is retained until the loader completes. */
+    void setNode(Node* node);
+    Node* getNode() const { return _node; }
+
+    /** Sets the node the result is added to on completion. */
+    void setParent(Node* parent);
+    Node* getParent() const { return _parent; }
+
+    /** Called every frame while loading with the fraction of the work done, between 0 and 1. */
+    void setProgressCallback(std::function<void(float)> callback) { _progressCallback = std::move(callback); }
+
+    /** Called once with the built node, after it was added to the parent. */
+    void setCompletionCallback(std::function<void(Node*)> callback) { _completionCallback = std::move(callback); }
+
+    /** Starts the resource loads and schedules the steps, the loader keeps itself alive until it completes. */
+    void start();
+
+    /** Stops running the steps, the resources already requested still finish loading. */
+    void cancel();
+
+    bool isRunning() const { return _running; }
+    bool isDone() const { return _done; }
+
+    /** The fraction of the resources and steps completed. */
+    float getProgress() const;
+
+    /** Number of frames the steps were spread over. */
+    unsigned int getFrameCount() const { return _frameCount; }
+
+protected:
+    void update(float dt);
+    void finish();
+
+    std::deque<Step> _steps;
+    std::vector<AsyncTask> _tasks;
+    Node* _node   = nullptr;
+    Node* _parent = nullptr;
+    std::function<void(float)> _progressCallback;
+    std::function<void(Node*)> _completionCallback;
+    float _frameBudget         = DEFAULT_FRAME_BUDGET;
+    unsigned int _totalWork    = 0;
+    unsigned int _doneWork     = 0;
+    unsigned int _pendingTasks = 0;
+    unsigned int _frameCount   = 0;
+    bool _running              = false;
+    bool _done                 = false;
+};
+
+// end of _2d group
+/// @}
+
+NS_AX_END
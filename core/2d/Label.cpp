@@ -54,6 +54,9 @@ NS_AX_BEGIN
 
 namespace
 {
+// Longest text laid out by Label::alignTextFast, its kernings live on the stack
+constexpr int FAST_UPDATE_MAX_LETTERS = 64;
+
 void updateBlend(backend::BlendDescriptor& blendDescriptor, BlendFunc blendFunc)
 {
     blendDescriptor.blendEnabled = true;
@@ -934,6 +937,13 @@ void Label::setString(std::string_view text)
         _utf8Text     = text;
         _contentDirty = true;
 
+        // ASCII text, the usual case of counters and timers, is widened in place without a temporary string
+        if (std::all_of(text.begin(), text.end(), [](char c) { return static_cast<unsigned char>(c) < 0x80; }))
+        {
+            _utf32Text.assign(text.begin(), text.end());
+            return;
+        }
+
         std::u32string utf32String;
         if (StringUtils::UTF8ToUTF32(_utf8Text, utf32String))
         {
@@ -1155,6 +1165,138 @@ bool Label::alignText()
     return ret;
 }
 
+bool Label::alignTextFast()
+{
+    const int textLen = static_cast<int>(_utf32Text.length());
+    if (!_fastUpdateEnabled || textLen == 0 || textLen > FAST_UPDATE_MAX_LETTERS || _labelWidth > 0.f ||
+        _labelHeight > 0.f || _maxLineWidth > 0.f || _overflow == Overflow::SHRINK || !_letters.empty() ||
+        !_reusedLetter || _batchNodes.empty() ||
+        _fontAtlas->getTextures().size() != static_cast<size_t>(_batchNodes.size()))
+    {
+        return false;
+    }
+
+    // Every letter must already be in the atlas, new letters may add atlas pages and need the full layout
+    for (auto character : _utf32Text)
+    {
+        if (character == StringUtils::UnicodeCharacters::NewLine ||
+            character == StringUtils::UnicodeCharacters::CarriageReturn ||
+            character == StringUtils::UnicodeCharacters::NextCharNoChangeX ||
+            character == StringUtils::UnicodeCharacters::NoBreakSpace)
+        {
+            return false;
+        }
+
+        auto it = _fontAtlas->_letterDefinitions.find(character);
+        if (it == _fontAtlas->_letterDefinitions.end() || !it->second.validDefinition ||
+            it->second.textureID >= _batchNodes.size() ||
+            _batchNodes.at(it->second.textureID)->getTextureAtlas()->getCapacity() < textLen)
+        {
+            return false;
+        }
+    }
+
+    int kernings[FAST_UPDATE_MAX_LETTERS];
+    const bool hasKernings = _fontAtlas->getFont()->fillHorizontalKerningForTextUTF32(_utf32Text, kernings);
+
+    // Same layout as multilineTextWrapByChar for a single unconstrained line
+    this->updateFontScale();
+    const auto contentScaleFactor = AX_CONTENT_SCALE_FACTOR();
+    float nextLetterX             = 0.f;
+    float letterRight             = 0.f;
+    float highestY                = 0.f;
+    float lowestY                 = 0.f;
+    Vec2 letterPosition;
+
+    _lengthOfString = textLen;
+    for (int index = 0; index < textLen; ++index)
+    {
+        const char32_t character = _utf32Text[index];
+        const auto& letterDef    = _fontAtlas->_letterDefinitions[character];
+
+        letterPosition.x = (nextLetterX + letterDef.offsetX * _fontScale) / contentScaleFactor;
+        letterPosition.y = (-letterDef.offsetY * _fontScale) / contentScaleFactor;
+        recordLetterInfo(letterPosition, character, index, 0);
+
+        float newLetterWidth = 0.f;
+        if (hasKernings && index < textLen - 1)
+            newLetterWidth = static_cast<float>(kernings[index + 1]) * _fontScale;
+        newLetterWidth += letterDef.xAdvance * _fontScale + _additionalKerning;
+
+        nextLetterX += newLetterWidth;
+        letterRight = nextLetterX / contentScaleFactor;
+
+        if (highestY < letterPosition.y)
+            highestY = letterPosition.y;
+        if (lowestY > letterPosition.y - letterDef.height * _fontScale)
+            lowestY = letterPosition.y - letterDef.height * _fontScale;
+    }
+
+    _linesWidth.clear();
+    _linesWidth.emplace_back(letterRight);
+    _numberOfLines     = 1;
+    _textDesiredHeight = (_lineHeight * _fontScale) / contentScaleFactor;
+    setContentSize(Vec2(letterRight, _textDesiredHeight));
+
+    _tailoredTopY    = _contentSize.height;
+    _tailoredBottomY = 0.f;
+    if (highestY > 0.f)
+        _tailoredTopY = _contentSize.height + highestY;
+    if (lowestY < -_textDesiredHeight)
+        _tailoredBottomY = _textDesiredHeight + lowestY;
+
+    computeAlignmentOffset();
+
+    // Rewrite the quads in place, with the label color, instead of inserting them and recoloring them afterwards
+    Color4B color4(_displayedColor.r, _displayedColor.g, _displayedColor.b, _displayedOpacity);
+    if (_isOpacityModifyRGB)
+    {
+        color4.r *= _displayedOpacity / 255.0f;
+        color4.g *= _displayedOpacity / 255.0f;
+        color4.b *= _displayedOpacity / 255.0f;
+    }
+
+    for (auto&& batchNode : _batchNodes)
+    {
+        batchNode->getTextureAtlas()->removeAllQuads();
+    }
+
+    for (int index = 0; index < textLen; ++index)
+    {
+        auto& letterInfo = _lettersInfo[index];
+        if (!letterInfo.valid)
+            continue;
+
+        const auto& letterDef = _fontAtlas->_letterDefinitions[letterInfo.utf32Char];
+        if (letterDef.width <= 0.f || letterDef.height <= 0.f)
+            continue;
+
+        _reusedRect.setRect(letterDef.U, letterDef.V, letterDef.width, letterDef.height);
+        _reusedLetter->setTextureRect(_reusedRect, letterDef.rotated, _reusedRect.size);
+        _reusedLetter->setPosition(letterInfo.positionX + _linesOffsetX[0], letterInfo.positionY + _letterOffsetY);
+        this->updateLetterSpriteScale(_reusedLetter);
+
+        auto batchNode        = _batchNodes.at(letterDef.textureID);
+        auto textureAtlas     = batchNode->getTextureAtlas();
+        auto atlasIndex       = static_cast<int>(textureAtlas->getTotalQuads());
+        letterInfo.atlasIndex = atlasIndex;
+
+        // updateTransform writes the quad at atlasIndex
+        _reusedLetter->setBatchNode(batchNode);
+        _reusedLetter->setAtlasIndex(atlasIndex);
+        _reusedLetter->setDirty(true);
+        _reusedLetter->updateTransform();
+
+        auto& quad     = textureAtlas->getQuads()[atlasIndex];
+        quad.bl.colors = color4;
+        quad.br.colors = color4;
+        quad.tl.colors = color4;
+        quad.tr.colors = color4;
+    }
+
+    return true;
+}
+
 bool Label::computeHorizontalKernings(const std::u32string& stringToRender)
 {
     if (_horizontalKernings)
@@ -1681,14 +1823,18 @@ void Label::updateContent()
 
     if (_fontAtlas)
     {
-        std::u32string utf32String;
-        if (StringUtils::UTF8ToUTF32(_utf8Text, utf32String))
+        // _utf32Text is up to date when the text changed through setString
+        if (!alignTextFast())
         {
-            _utf32Text = utf32String;
-        }
+            std::u32string utf32String;
+            if (StringUtils::UTF8ToUTF32(_utf8Text, utf32String))
+            {
+                _utf32Text = utf32String;
+            }
 
-        computeHorizontalKernings(_utf32Text);
-        updateFinished = alignText();
+            computeHorizontalKernings(_utf32Text);
+            updateFinished = alignText();
+        }
     }
     else
     {
@@ -1943,6 +2089,7 @@ void Label::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
         _insideBounds = renderer->checkVisibility(transform, _contentSize);
     }
 
+    renderer->addCullingResult(_insideBounds);
     if (_insideBounds)
 #endif
     {
@@ -601,6 +601,20 @@ public:
      * @return see `Overflow`
      */
     Overflow getOverflow() const;
+
+    /**
+     * Toggle the fast update of short single line texts.
+     * When the label has no dimensions nor max line width and all the letters are already in the font atlas,
+     * a new string rewrites the letter quads in place, without wrapping nor heap allocation.
+     * Enabled by default.
+     *
+     * @param enabled Set false to always run the full layout.
+     */
+    void setFastUpdateEnabled(bool enabled) { _fastUpdateEnabled = enabled; }
+
+    /** Query whether short single line texts are updated in place. */
+    bool isFastUpdateEnabled() const { return _fastUpdateEnabled; }
+
     /**
      * Makes the Label exactly this untransformed width.
      *
@@ -686,6 +700,12 @@ public:
 
     FontAtlas* getFontAtlas() { return _fontAtlas; }
 
+    /**
+     * Returns the batch nodes holding the glyph quads of the label, in its local space, one for each font atlas texture.
+     * The quads are up to date once the content size is queried.
+     */
+    const Vector<SpriteBatchNode*>& getBatchNodes() const { return _batchNodes; }
+
     virtual const BlendFunc& getBlendFunc() const override { return _blendFunc; }
     virtual void setBlendFunc(const BlendFunc& blendFunc) override;
 
@@ -780,6 +800,7 @@ protected:
 
     void updateLabelLetters();
     virtual bool alignText();
+    bool alignTextFast();
     void computeAlignmentOffset();
     bool computeHorizontalKernings(const std::u32string& stringToRender);
 
@@ -841,6 +862,7 @@ protected:
     bool _boldEnabled;
     bool _strikethroughEnabled;
     bool _lineBreakWithoutSpaces;
+    bool _fastUpdateEnabled = true;
     uint8_t _shadowOpacity;
 
     Color3B _shadowColor3B;
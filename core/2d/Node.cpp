@@ -119,6 +119,7 @@ Node::Node()
     , _cascadeColorEnabled(false)
     , _cascadeOpacityEnabled(false)
     , _childFollowCameraMask(false)
+    , _touchBoundsIndexed(false)
     , _cameraMask(1)
     , _onEnterCallback(nullptr)
     , _onExitCallback(nullptr)
@@ -257,6 +258,7 @@ void Node::setSkewX(float skewX)
 
     _skewX            = skewX;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    setTouchBoundsDirty();
 }
 
 float Node::getSkewY() const
@@ -271,6 +273,7 @@ void Node::setSkewY(float skewY)
 
     _skewY            = skewY;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    setTouchBoundsDirty();
 }
 
 void Node::setLocalZOrder(std::int32_t z)
@@ -323,6 +326,7 @@ void Node::setRotation(float rotation)
 
     _rotationZ_X = _rotationZ_Y = rotation;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    setTouchBoundsDirty();
 
     updateRotationQuat();
 }
@@ -338,6 +342,7 @@ void Node::setRotation3D(const Vec3& rotation)
         return;
 
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    setTouchBoundsDirty();
 
     _rotationX = rotation.x;
     _rotationY = rotation.y;
@@ -391,6 +396,7 @@ void Node::setRotationQuat(const Quaternion& quat)
     _rotationQuat = quat;
     updateRotation3D();
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    setTouchBoundsDirty();
 }
 
 Quaternion Node::getRotationQuat() const
@@ -405,6 +411,7 @@ void Node::setRotationSkewX(float rotationX)
 
     _rotationZ_X      = rotationX;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    setTouchBoundsDirty();
 
     updateRotationQuat();
 }
@@ -421,6 +428,7 @@ void Node::setRotationSkewY(float rotationY)
 
     _rotationZ_Y      = rotationY;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    setTouchBoundsDirty();
 
     updateRotationQuat();
 }
@@ -440,6 +448,7 @@ void Node::setScale(float scale)
 
     _scaleX = _scaleY = _scaleZ = scale;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    setTouchBoundsDirty();
 }
 
 /// scaleX getter
@@ -457,6 +466,7 @@ void Node::setScale(float scaleX, float scaleY)
     _scaleX           = scaleX;
     _scaleY           = scaleY;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    setTouchBoundsDirty();
 }
 
 /// scaleX setter
@@ -467,6 +477,7 @@ void Node::setScaleX(float scaleX)
 
     _scaleX           = scaleX;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    setTouchBoundsDirty();
 }
 
 /// scaleY getter
@@ -483,6 +494,7 @@ void Node::setScaleZ(float scaleZ)
 
     _scaleZ           = scaleZ;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    setTouchBoundsDirty();
 }
 
 /// scaleY getter
@@ -499,6 +511,7 @@ void Node::setScaleY(float scaleY)
 
     _scaleY           = scaleY;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    setTouchBoundsDirty();
 }
 
 /// position getter
@@ -528,6 +541,7 @@ void Node::setPosition(float x, float y)
     _position.y = y;
 
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    setTouchBoundsDirty();
     _usingNormalizedPosition                            = false;
 }
 
@@ -573,6 +587,7 @@ void Node::setPositionZ(float positionZ)
         return;
 
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    setTouchBoundsDirty();
 
     _positionZ = positionZ;
 }
@@ -593,6 +608,7 @@ void Node::setPositionNormalized(const Vec2& position)
     _usingNormalizedPosition = true;
     _normalizedPositionDirty = true;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    setTouchBoundsDirty();
 }
 
 ssize_t Node::getChildrenCount() const
@@ -614,6 +630,8 @@ void Node::setVisible(bool visible)
         _visible = visible;
         if (_visible)
             _transformUpdated = _transformDirty = _inverseDirty = true;
+        if (_touchBoundsIndexed)
+            _eventDispatcher->setBoundsDirtyForNode(this);
     }
 }
 
@@ -635,6 +653,7 @@ void Node::setAnchorPoint(const Vec2& point)
         _anchorPoint = point;
         _anchorPointInPoints.set(_contentSize.width * _anchorPoint.x, _contentSize.height * _anchorPoint.y);
         _transformUpdated = _transformDirty = _inverseDirty = true;
+        setTouchBoundsDirty();
     }
 }
 
@@ -652,6 +671,7 @@ void Node::setContentSize(const Vec2& size)
 
         _anchorPointInPoints.set(_contentSize.width * _anchorPoint.x, _contentSize.height * _anchorPoint.y);
         _transformUpdated = _transformDirty = _inverseDirty = _contentSizeDirty = true;
+        setTouchBoundsDirty();
     }
 }
 
@@ -674,6 +694,7 @@ void Node::setParent(Node* parent)
     _parent           = parent;
     _normalizedPositionDirty = true;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    setTouchBoundsDirty();
 }
 
 /// isRelativeAnchorPoint getter
@@ -689,6 +710,7 @@ void Node::setIgnoreAnchorPointForPosition(bool newValue)
     {
         _ignoreAnchorPointForPosition = newValue;
         _transformUpdated = _transformDirty = _inverseDirty = true;
+        setTouchBoundsDirty();
     }
 }
 
@@ -1228,6 +1250,12 @@ void Node::visit()
     visit(renderer, parentTransform, FLAGS_TRANSFORM_DIRTY);
 }
 
+void Node::setTouchBoundsDirty()
+{
+    if (_eventDispatcher->isTouchSpatialIndexEnabled())
+        _eventDispatcher->setTransformDirtyForNode(this);
+}
+
 uint32_t Node::processParentFlags(const Mat4& parentTransform, uint32_t parentFlags)
 {
     if (_usingNormalizedPosition)
@@ -1253,7 +1281,11 @@ uint32_t Node::processParentFlags(const Mat4& parentTransform, uint32_t parentFl
     flags |= (_contentSizeDirty ? FLAGS_CONTENT_SIZE_DIRTY : 0);
 
     if (flags & FLAGS_DIRTY_MASK)
+    {
         _modelViewTransform = this->transform(parentTransform);
+        if (_touchBoundsIndexed)
+            _eventDispatcher->setBoundsDirtyForNode(this);
+    }
 
     _transformUpdated = false;
     _contentSizeDirty = false;
@@ -1802,6 +1834,7 @@ void Node::setNodeToParentTransform(const Mat4& transform)
     _transform        = transform;
     _transformDirty   = false;
     _transformUpdated = true;
+    setTouchBoundsDirty();
 
     if (_additionalTransform)
         // _additionalTransform[1] has a copy of lastest transform
@@ -1837,6 +1870,7 @@ void Node::setAdditionalTransform(const Mat4* additionalTransform)
         _additionalTransform[0] = *additionalTransform;
     }
     _transformUpdated = _additionalTransformDirty = _inverseDirty = true;
+    setTouchBoundsDirty();
 }
 
 void Node::setAdditionalTransform(const Mat4& additionalTransform)
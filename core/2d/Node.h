@@ -1871,6 +1871,9 @@ protected:
     Mat4 transform(const Mat4& parentTransform);
     uint32_t processParentFlags(const Mat4& parentTransform, uint32_t parentFlags);
 
+    /// Tells the event dispatcher the indexed touch bounds of this node and its descendants may have moved
+    void setTouchBoundsDirty();
+
     virtual void updateCascadeOpacity();
     virtual void disableCascadeOpacity();
     virtual void updateCascadeColor();
@@ -1993,6 +1996,7 @@ protected:
     bool _normalizedPositionDirty;
     
     bool _childFollowCameraMask;
+    bool _touchBoundsIndexed;  ///< whether the event dispatcher indexes the bounds of this node for touch hit-testing
     // camera mask, it is visible only when _cameraMask & current camera' camera flag is true
     unsigned short _cameraMask;
 
@@ -2038,6 +2042,8 @@ public:
 
     static int __attachedNodeCount;
 
+    friend class EventDispatcher;
+
 private:
     AX_DISALLOW_COPY_AND_ASSIGN(Node);
 };
@@ -428,6 +428,9 @@ void ParticleBatchNode::draw(Renderer* renderer, const Mat4& transform, uint32_t
 {
     AX_PROFILER_START("CCParticleBatchNode - draw");
 
+    // children updating in parallel write their quads into the atlas
+    ParticleSystem::flushParallelUpdates();
+
     if (_textureAtlas->getTotalQuads() == 0)
         return;
 
@@ -55,6 +55,7 @@ THE SOFTWARE.
 #include "base/Profiling.h"
 #include "base/UTF8.h"
 #include "base/Utils.h"
+#include "base/JobSystem.h"
 #include "renderer/TextureCache.h"
 #include "platform/FileUtils.h"
 
@@ -190,6 +191,7 @@ void ParticleData::release()
 }
 
 Vector<ParticleSystem*> ParticleSystem::__allInstances;
+Vector<ParticleSystem*> ParticleSystem::__pendingParallelUpdates;
 float ParticleSystem::__totalParticleCountFactor = 1.0f;
 
 ParticleSystem::ParticleSystem()
@@ -252,6 +254,11 @@ ParticleSystem::ParticleSystem()
     , _fixedFPS(0)
     , _fixedFPSDelta(0)
     , _sourcePositionCompatible(true)  // In the furture this member's default value maybe false or be removed.
+    , _parallelUpdateEnabled(false)
+    , _parallelUpdatePending(false)
+    , _parallelUpdateSimulate(false)
+    , _parallelUpdateDelta(0)
+    , _seed(static_cast<uint32_t>(_rng._seed))
 {
     modeA.gravity.setZero();
     modeA.speed              = 0;
@@ -1485,22 +1492,33 @@ bool ParticleSystem::addAnimationIndex(unsigned short index, ax::Rect rect, bool
 
 void ParticleSystem::simulate(float seconds, float frameRate)
 {
-    seconds             = seconds == SIMULATION_USE_PARTICLE_LIFETIME ? getLife() + getLifeVar() : seconds;
-    frameRate           = frameRate == SIMULATION_USE_GAME_ANIMATION_INTERVAL
-                              ? 1.0F / Director::getInstance()->getAnimationInterval()
-                              : frameRate;
-    auto delta          = 1.0F / frameRate;
-    if (seconds > delta)
+    seconds   = seconds == SIMULATION_USE_PARTICLE_LIFETIME ? getLife() + getLifeVar() : seconds;
+    frameRate = frameRate == SIMULATION_USE_GAME_ANIMATION_INTERVAL
+                    ? 1.0F / Director::getInstance()->getAnimationInterval()
+                    : frameRate;
+    if (seconds <= 0.0F || frameRate <= 0.0F)
+        return;
+
+    if (_parallelUpdatePending)
+        flushParallelUpdates();
+
+    // Only the particles move in the steps, the quads are built once at the end.
+    auto delta = 1.0F / frameRate;
+    while (seconds > 0.0F)
     {
-        while (seconds > 0.0F)
-        {
-            this->update(delta);
-            seconds -= delta;
-        }
-        this->update(seconds);
+        auto pureDt = MIN(delta, seconds);
+        seconds -= pureDt;
+
+        auto dt = pureDt * _timeScale;
+        if (!updateEmitter(dt, pureDt))
+            return;
+        updateParticles(dt, 0, _particleCount);
     }
-    else
-        this->update(seconds);
+
+    updateParticleQuads();
+    _transformSystemDirty = false;
+    if (_visible && !_batchNode)
+        postStep();
 }
 
 void ParticleSystem::resimulate(float seconds, float frameRate)
@@ -1509,6 +1527,36 @@ void ParticleSystem::resimulate(float seconds, float frameRate)
     this->simulate(seconds, frameRate);
 }
 
+void ParticleSystem::seek(float seconds, float frameRate)
+{
+    if (_parallelUpdatePending)
+        flushParallelUpdates();
+
+    // restart from an empty system with the same random sequence
+    if (_batchNode)
+    {
+        for (int i = 0; i < _particleCount; ++i)
+            _batchNode->disableParticle(_atlasIndex + _particleData.atlasIndex[i]);
+    }
+    _particleCount = 0;
+    _isActive      = true;
+    _elapsed       = 0;
+    _emitCounter   = 0;
+    _fixedFPSDelta = 0;
+    _rng.seed_rng(_seed);
+
+    if (seconds > 0.0F)
+        this->simulate(seconds, frameRate);
+    else
+        updateParticleQuads();
+}
+
+void ParticleSystem::setSeed(uint32_t seed)
+{
+    _seed = seed;
+    _rng.seed_rng(seed);
+}
+
 void ParticleSystem::onEnter()
 {
     Node::onEnter();
@@ -1551,36 +1599,8 @@ bool ParticleSystem::isFull()
 }
 
 // ParticleSystem - MainLoop
-void ParticleSystem::update(float dt)
+bool ParticleSystem::updateEmitter(float dt, float pureDt)
 {
-    // don't process particles nor update gl buffer when this node is invisible.
-    if (!_visible)
-        return;
-
-    AX_PROFILER_START_CATEGORY(kProfilerCategoryParticles, "CCParticleSystem - update");
-
-    if (_componentContainer && !_componentContainer->isEmpty())
-    {
-        _componentContainer->visit(dt);
-    }
-
-    if (_fixedFPS != 0)
-    {
-        _fixedFPSDelta += dt;
-        if (_fixedFPSDelta < 1.0F / _fixedFPS)
-        {
-            updateParticleQuads();
-            _transformSystemDirty = false;
-            AX_PROFILER_STOP_CATEGORY(kProfilerCategoryParticles, "CCParticleSystem - update");
-            return;
-        }
-        dt             = _fixedFPSDelta;
-        _fixedFPSDelta = 0.0F;
-    }
-
-    float pureDt = dt;
-    dt *= _timeScale;
-
     if (_isActive && _emissionRate)
     {
         float rate         = 1.0f / _emissionRate;
@@ -1612,232 +1632,322 @@ void ParticleSystem::update(float dt)
     // And wether if every property's memory of the particle system is continuous,
     // for the purpose of improving cache hit rate, we should process only one property in one for-loop.
     // It was proved to be effective especially for low-end devices.
+    for (int i = 0; i < _particleCount; ++i)
     {
-        for (int i = 0; i < _particleCount; ++i)
-        {
-            _particleData.timeToLive[i] -= dt;
-        }
-
-        if (_isOpacityFadeInAllocated)
-        {
-            for (int i = 0; i < _particleCount; ++i)
-            {
-                _particleData.opacityFadeInDelta[i] += dt;
-                _particleData.opacityFadeInDelta[i] =
-                    MIN(_particleData.opacityFadeInDelta[i], _particleData.opacityFadeInLength[i]);
-            }
-        }
+        _particleData.timeToLive[i] -= dt;
+    }
 
-        if (_isScaleInAllocated)
+    if (_isLifeAnimated || _isEmitterAnimated || _isLoopAnimated)
+    {
+        if (_isEmitterAnimated && !_animations.empty())
         {
             for (int i = 0; i < _particleCount; ++i)
             {
-                _particleData.scaleInDelta[i] += dt;
-                _particleData.scaleInDelta[i] = MIN(_particleData.scaleInDelta[i], _particleData.scaleInLength[i]);
-            }
-        }
-
-        if (_isLifeAnimated || _isEmitterAnimated || _isLoopAnimated)
-        {
-            if (_isEmitterAnimated && !_animations.empty())
-            {
-                for (int i = 0; i < _particleCount; ++i)
-                {
-                    _particleData.animTimeDelta[i] += (_animationTimescaleInd ? pureDt : dt);
-                    if (_particleData.animTimeDelta[i] > _particleData.animTimeLength[i])
-                    {
-                        auto& anim    = _animations.at(_particleData.animIndex[i]);
-                        float percent = _rng.float01();
-                        percent       = anim.reverseIndices ? 1.0F - percent : percent;
-
-                        _particleData.animCellIndex[i] = anim.animationIndices[MIN(
-                            percent * anim.animationIndices.size(), anim.animationIndices.size() - 1)];
-                        _particleData.animTimeDelta[i] = 0;
-                    }
-                }
-            }
-            if (_isLifeAnimated && _animations.empty())
-            {
-                for (int i = 0; i < _particleCount; ++i)
-                {
-                    float percent = (_particleData.totalTimeToLive[i] - _particleData.timeToLive[i]) /
-                                    _particleData.totalTimeToLive[i];
-                    percent = _isAnimationReversed ? 1.0F - percent : percent;
-                    _particleData.animCellIndex[i] =
-                        (unsigned short)MIN(percent * _animIndexCount, _animIndexCount - 1);
-                }
-            }
-            if (_isLifeAnimated && !_animations.empty())
-            {
-                for (int i = 0; i < _particleCount; ++i)
-                {
-                    auto& anim = _animations.at(_particleData.animIndex[i]);
-
-                    float percent = (_particleData.totalTimeToLive[i] - _particleData.timeToLive[i]) /
-                                    _particleData.totalTimeToLive[i];
-                    percent = (!!_isAnimationReversed != !!anim.reverseIndices) ? 1.0F - percent : percent;
-                    percent = MAX(0.0F, percent);
-
-                    _particleData.animCellIndex[i] = anim.animationIndices[MIN(percent * anim.animationIndices.size(),
-                                                                               anim.animationIndices.size() - 1)];
-                }
-            }
-            if (_isLoopAnimated && !_animations.empty())
-            {
-                for (int i = 0; i < _particleCount; ++i)
+                _particleData.animTimeDelta[i] += (_animationTimescaleInd ? pureDt : dt);
+                if (_particleData.animTimeDelta[i] > _particleData.animTimeLength[i])
                 {
-                    auto& anim = _animations.at(_particleData.animIndex[i]);
-
-                    _particleData.animTimeDelta[i] += (_animationTimescaleInd ? pureDt : dt);
-                    if (_particleData.animTimeDelta[i] >= _particleData.animTimeLength[i])
-                        _particleData.animTimeDelta[i] = 0;
-
-                    float percent = _particleData.animTimeDelta[i] / _particleData.animTimeLength[i];
+                    auto& anim    = _animations.at(_particleData.animIndex[i]);
+                    float percent = _rng.float01();
                     percent       = anim.reverseIndices ? 1.0F - percent : percent;
-                    percent       = MAX(0.0F, percent);
 
-                    _particleData.animCellIndex[i] = anim.animationIndices[MIN(percent * anim.animationIndices.size(),
-                                                                               anim.animationIndices.size() - 1)];
+                    _particleData.animCellIndex[i] = anim.animationIndices[MIN(
+                        percent * anim.animationIndices.size(), anim.animationIndices.size() - 1)];
+                    _particleData.animTimeDelta[i] = 0;
                 }
             }
-            if (_isLoopAnimated && _animations.empty())
-                std::fill_n(_particleData.animTimeDelta, _particleCount, 0);
         }
-
-        for (int i = 0; i < _particleCount; ++i)
+        if (_isLifeAnimated && _animations.empty())
         {
-            if (_particleData.timeToLive[i] <= 0.0f)
+            for (int i = 0; i < _particleCount; ++i)
             {
-                int j = _particleCount - 1;
-                while (j > 0 && _particleData.timeToLive[j] <= 0)
-                {
-                    _particleCount--;
-                    j--;
-                }
-                _particleData.copyParticle(i, _particleCount - 1);
-                if (_batchNode)
-                {
-                    // disable the switched particle
-                    int currentIndex = _particleData.atlasIndex[i];
-                    _batchNode->disableParticle(_atlasIndex + currentIndex);
-                    // switch indexes
-                    _particleData.atlasIndex[_particleCount - 1] = currentIndex;
-                }
-                --_particleCount;
-                if (_particleCount == 0 && _isAutoRemoveOnFinish)
-                {
-                    this->unscheduleUpdate();
-                    _parent->removeChild(this, true);
-                    return;
-                }
+                float percent = (_particleData.totalTimeToLive[i] - _particleData.timeToLive[i]) /
+                                _particleData.totalTimeToLive[i];
+                percent = _isAnimationReversed ? 1.0F - percent : percent;
+                _particleData.animCellIndex[i] =
+                    (unsigned short)MIN(percent * _animIndexCount, _animIndexCount - 1);
             }
         }
-
-        if (_emitterMode == Mode::GRAVITY)
+        if (_isLifeAnimated && !_animations.empty())
         {
             for (int i = 0; i < _particleCount; ++i)
             {
-                particle_point tmp, radial = {0.0f, 0.0f}, tangential;
+                auto& anim = _animations.at(_particleData.animIndex[i]);
 
-                // radial acceleration
-                if (_particleData.posx[i] || _particleData.posy[i])
-                {
-                    normalize_point(_particleData.posx[i], _particleData.posy[i], &radial);
-                }
-                tangential = radial;
-                radial.x *= _particleData.modeA.radialAccel[i];
-                radial.y *= _particleData.modeA.radialAccel[i];
+                float percent = (_particleData.totalTimeToLive[i] - _particleData.timeToLive[i]) /
+                                _particleData.totalTimeToLive[i];
+                percent = (!!_isAnimationReversed != !!anim.reverseIndices) ? 1.0F - percent : percent;
+                percent = MAX(0.0F, percent);
 
-                // tangential acceleration
-                std::swap(tangential.x, tangential.y);
-                tangential.x *= -_particleData.modeA.tangentialAccel[i];
-                tangential.y *= _particleData.modeA.tangentialAccel[i];
-
-                // (gravity + radial + tangential) * dt
-                tmp.x = radial.x + tangential.x + modeA.gravity.x;
-                tmp.y = radial.y + tangential.y + modeA.gravity.y;
-                tmp.x *= dt;
-                tmp.y *= dt;
-
-                _particleData.modeA.dirX[i] += tmp.x;
-                _particleData.modeA.dirY[i] += tmp.y;
-
-                // this is cocos2d-x v3.0
-                // if (_configName.length()>0 && _yCoordFlipped != -1)
-
-                // this is cocos2d-x v3.0
-                tmp.x = _particleData.modeA.dirX[i] * dt * _yCoordFlipped;
-                tmp.y = _particleData.modeA.dirY[i] * dt * _yCoordFlipped;
-                _particleData.posx[i] += tmp.x;
-                _particleData.posy[i] += tmp.y;
+                _particleData.animCellIndex[i] = anim.animationIndices[MIN(percent * anim.animationIndices.size(),
+                                                                           anim.animationIndices.size() - 1)];
             }
         }
-        else
+        if (_isLoopAnimated && !_animations.empty())
         {
             for (int i = 0; i < _particleCount; ++i)
             {
-                _particleData.modeB.angle[i] += _particleData.modeB.degreesPerSecond[i] * dt;
+                auto& anim = _animations.at(_particleData.animIndex[i]);
+
+                _particleData.animTimeDelta[i] += (_animationTimescaleInd ? pureDt : dt);
+                if (_particleData.animTimeDelta[i] >= _particleData.animTimeLength[i])
+                    _particleData.animTimeDelta[i] = 0;
+
+                float percent = _particleData.animTimeDelta[i] / _particleData.animTimeLength[i];
+                percent       = anim.reverseIndices ? 1.0F - percent : percent;
+                percent       = MAX(0.0F, percent);
+
+                _particleData.animCellIndex[i] = anim.animationIndices[MIN(percent * anim.animationIndices.size(),
+                                                                           anim.animationIndices.size() - 1)];
             }
+        }
+        if (_isLoopAnimated && _animations.empty())
+            std::fill_n(_particleData.animTimeDelta, _particleCount, 0);
+    }
 
-            for (int i = 0; i < _particleCount; ++i)
+    for (int i = 0; i < _particleCount; ++i)
+    {
+        if (_particleData.timeToLive[i] <= 0.0f)
+        {
+            int j = _particleCount - 1;
+            while (j > 0 && _particleData.timeToLive[j] <= 0)
             {
-                _particleData.modeB.radius[i] += _particleData.modeB.deltaRadius[i] * dt;
+                _particleCount--;
+                j--;
             }
-
-            for (int i = 0; i < _particleCount; ++i)
+            _particleData.copyParticle(i, _particleCount - 1);
+            if (_batchNode)
             {
-                _particleData.posx[i] = -cosf(_particleData.modeB.angle[i]) * _particleData.modeB.radius[i];
+                // disable the switched particle
+                int currentIndex = _particleData.atlasIndex[i];
+                _batchNode->disableParticle(_atlasIndex + currentIndex);
+                // switch indexes
+                _particleData.atlasIndex[_particleCount - 1] = currentIndex;
             }
-            for (int i = 0; i < _particleCount; ++i)
+            --_particleCount;
+            if (_particleCount == 0 && _isAutoRemoveOnFinish)
             {
-                _particleData.posy[i] =
-                    -sinf(_particleData.modeB.angle[i]) * _particleData.modeB.radius[i] * _yCoordFlipped;
+                this->unscheduleUpdate();
+                if (_parent)
+                    _parent->removeChild(this, true);
+                return false;
             }
         }
+    }
 
-        // color r,g,b,a
-        for (int i = 0; i < _particleCount; ++i)
-        {
-            _particleData.colorR[i] += _particleData.deltaColorR[i] * dt;
-        }
+    return true;
+}
 
-        for (int i = 0; i < _particleCount; ++i)
-        {
-            _particleData.colorG[i] += _particleData.deltaColorG[i] * dt;
-        }
+void ParticleSystem::update(float dt)
+{
+    // don't process particles nor update gl buffer when this node is invisible.
+    if (!_visible)
+        return;
 
-        for (int i = 0; i < _particleCount; ++i)
+    AX_PROFILER_START_CATEGORY(kProfilerCategoryParticles, "CCParticleSystem - update");
+
+    // updated twice before being drawn, finish the previous update first
+    if (_parallelUpdatePending)
+        flushParallelUpdates();
+
+    if (_componentContainer && !_componentContainer->isEmpty())
+    {
+        _componentContainer->visit(dt);
+    }
+
+    if (_fixedFPS != 0)
+    {
+        _fixedFPSDelta += dt;
+        if (_fixedFPSDelta < 1.0F / _fixedFPS)
         {
-            _particleData.colorB[i] += _particleData.deltaColorB[i] * dt;
+            if (_parallelUpdateEnabled)
+                queueParallelUpdate(0.0F, false);
+            else
+                updateParticleQuads();
+            _transformSystemDirty = false;
+            AX_PROFILER_STOP_CATEGORY(kProfilerCategoryParticles, "CCParticleSystem - update");
+            return;
         }
+        dt             = _fixedFPSDelta;
+        _fixedFPSDelta = 0.0F;
+    }
 
-        for (int i = 0; i < _particleCount; ++i)
+    float pureDt = dt;
+    dt *= _timeScale;
+
+    if (!updateEmitter(dt, pureDt))
+        return;
+
+    // everything below only touches the particles of this system
+    if (_parallelUpdateEnabled)
+    {
+        queueParallelUpdate(dt, true);
+    }
+    else
+    {
+        updateParticles(dt, 0, _particleCount);
+        updateParticleQuads();
+    }
+    _transformSystemDirty = false;
+
+    // update and send gl buffer only when this node is visible.
+    if (_visible && !_batchNode && !_parallelUpdatePending)
+    {
+        postStep();
+    }
+
+    AX_PROFILER_STOP_CATEGORY(kProfilerCategoryParticles, "CCParticleSystem - update");
+}
+
+void ParticleSystem::updateParticles(float dt, int begin, int end)
+{
+    // Each loop reads and writes separate arrays through restrict pointers, without branches, so that the compiler
+    // can vectorize it.
+    if (_isOpacityFadeInAllocated)
+    {
+        float* __restrict fadeInDelta        = _particleData.opacityFadeInDelta;
+        const float* __restrict fadeInLength = _particleData.opacityFadeInLength;
+        for (int i = begin; i < end; ++i)
+            fadeInDelta[i] = MIN(fadeInDelta[i] + dt, fadeInLength[i]);
+    }
+
+    if (_isScaleInAllocated)
+    {
+        float* __restrict scaleInDelta        = _particleData.scaleInDelta;
+        const float* __restrict scaleInLength = _particleData.scaleInLength;
+        for (int i = begin; i < end; ++i)
+            scaleInDelta[i] = MIN(scaleInDelta[i] + dt, scaleInLength[i]);
+    }
+
+    float* __restrict posx = _particleData.posx;
+    float* __restrict posy = _particleData.posy;
+    const float flipY      = _yCoordFlipped;
+
+    if (_emitterMode == Mode::GRAVITY)
+    {
+        float* __restrict dirX                  = _particleData.modeA.dirX;
+        float* __restrict dirY                  = _particleData.modeA.dirY;
+        const float* __restrict radialAccel     = _particleData.modeA.radialAccel;
+        const float* __restrict tangentialAccel = _particleData.modeA.tangentialAccel;
+        const float gravityX                    = modeA.gravity.x;
+        const float gravityY                    = modeA.gravity.y;
+
+        for (int i = begin; i < end; ++i)
         {
-            _particleData.colorA[i] += _particleData.deltaColorA[i] * dt;
+            // radial direction, zero when the particle is at the emitter or already at unit distance, as in
+            // normalize_point()
+            const float lengthSq = posx[i] * posx[i] + posy[i] * posy[i];
+            const float length   = sqrtf(lengthSq);
+            const float invLength =
+                (lengthSq != 1.0f && length >= MATH_TOLERANCE) ? 1.0f / MAX(length, MATH_TOLERANCE) : 0.0f;
+            const float radialX = posx[i] * invLength;
+            const float radialY = posy[i] * invLength;
+
+            // (gravity + radial + tangential) * dt
+            const float accelX = (radialX * radialAccel[i] + radialY * -tangentialAccel[i] + gravityX) * dt;
+            const float accelY = (radialY * radialAccel[i] + radialX * tangentialAccel[i] + gravityY) * dt;
+
+            dirX[i] += accelX;
+            dirY[i] += accelY;
+            posx[i] += dirX[i] * dt * flipY;
+            posy[i] += dirY[i] * dt * flipY;
         }
-        // size
-        for (int i = 0; i < _particleCount; ++i)
+    }
+    else
+    {
+        float* __restrict angle                  = _particleData.modeB.angle;
+        float* __restrict radius                 = _particleData.modeB.radius;
+        const float* __restrict degreesPerSecond = _particleData.modeB.degreesPerSecond;
+        const float* __restrict deltaRadius      = _particleData.modeB.deltaRadius;
+
+        for (int i = begin; i < end; ++i)
         {
-            _particleData.size[i] += (_particleData.deltaSize[i] * dt);
-            _particleData.size[i] = MAX(0, _particleData.size[i]);
+            angle[i] += degreesPerSecond[i] * dt;
+            radius[i] += deltaRadius[i] * dt;
         }
-        // angle
-        for (int i = 0; i < _particleCount; ++i)
+        for (int i = begin; i < end; ++i)
         {
-            _particleData.rotation[i] += _particleData.deltaRotation[i] * dt;
+            posx[i] = -cosf(angle[i]) * radius[i];
+            posy[i] = -sinf(angle[i]) * radius[i] * flipY;
         }
+    }
 
-        updateParticleQuads();
-        _transformSystemDirty = false;
+    // color r,g,b,a
+    float* __restrict colorR            = _particleData.colorR;
+    float* __restrict colorG            = _particleData.colorG;
+    float* __restrict colorB            = _particleData.colorB;
+    float* __restrict colorA            = _particleData.colorA;
+    const float* __restrict deltaColorR = _particleData.deltaColorR;
+    const float* __restrict deltaColorG = _particleData.deltaColorG;
+    const float* __restrict deltaColorB = _particleData.deltaColorB;
+    const float* __restrict deltaColorA = _particleData.deltaColorA;
+    for (int i = begin; i < end; ++i)
+    {
+        colorR[i] += deltaColorR[i] * dt;
+        colorG[i] += deltaColorG[i] * dt;
+        colorB[i] += deltaColorB[i] * dt;
+        colorA[i] += deltaColorA[i] * dt;
     }
 
-    // update and send gl buffer only when this node is visible.
-    if (_visible && !_batchNode)
+    // size
+    float* __restrict size            = _particleData.size;
+    const float* __restrict deltaSize = _particleData.deltaSize;
+    for (int i = begin; i < end; ++i)
+        size[i] = MAX(0.0f, size[i] + deltaSize[i] * dt);
+
+    // angle
+    float* __restrict rotation            = _particleData.rotation;
+    const float* __restrict deltaRotation = _particleData.deltaRotation;
+    for (int i = begin; i < end; ++i)
+        rotation[i] += deltaRotation[i] * dt;
+}
+
+void ParticleSystem::setParallelUpdateEnabled(bool enabled)
+{
+    if (_parallelUpdateEnabled == enabled)
+        return;
+
+    if (_parallelUpdatePending)
+        flushParallelUpdates();
+    _parallelUpdateEnabled = enabled;
+}
+
+void ParticleSystem::queueParallelUpdate(float dt, bool simulate)
+{
+    prepareParticleQuads();
+    _parallelUpdateDelta    = dt;
+    _parallelUpdateSimulate = simulate;
+    if (!_parallelUpdatePending)
     {
-        postStep();
+        _parallelUpdatePending = true;
+        __pendingParallelUpdates.pushBack(this);
     }
+}
 
-    AX_PROFILER_STOP_CATEGORY(kProfilerCategoryParticles, "CCParticleSystem - update");
+void ParticleSystem::flushParallelUpdates()
+{
+    if (__pendingParallelUpdates.empty())
+        return;
+
+    // a system may be released by postStep() or by the release of the list, so work on a copy
+    auto systems = std::move(__pendingParallelUpdates);
+    __pendingParallelUpdates.clear();
+
+    JobSystem::getInstance()->parallelFor(static_cast<int>(systems.size()), 1, [&systems](int begin, int end) {
+        for (int i = begin; i < end; ++i)
+        {
+            auto system = systems.at(i);
+            if (system->_parallelUpdateSimulate)
+                system->updateParticles(system->_parallelUpdateDelta, 0, system->_particleCount);
+            system->updateParticleQuads();
+        }
+    });
+
+    for (auto&& system : systems)
+    {
+        system->_parallelUpdatePending = false;
+        if (system->_visible && !system->_batchNode)
+            system->postStep();
+    }
 }
 
 void ParticleSystem::updateWithNoTime()
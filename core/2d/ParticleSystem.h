@@ -1335,6 +1335,8 @@ public:
     void setPositionType(PositionType type) { _positionType = type; }
 
     /** Advance the particle system and make it seem like it ran for this many seconds.
+     * The particles are stepped at frameRate without building their quads, which are built once at the end, so
+     * large steps make it cheap to pre-warm an effect before it is shown.
      *
      * @param seconds Seconds to advance. value of -1 means (SIMULATION_USE_PARTICLE_LIFETIME)
      * @param frameRate Frame rate to run the simulation with (preferred: 30.0) The higher this value is the more
@@ -1355,6 +1357,26 @@ public:
     void resimulate(float seconds   = SIMULATION_USE_PARTICLE_LIFETIME,
                     float frameRate = SIMULATION_USE_GAME_ANIMATION_INTERVAL);
 
+    /** Restarts the particle system from its seed and advances it to the given time, like simulate().
+     * Seeking twice to the same time with the same frame rate gives the same particles, so effects can be replayed
+     * exactly.
+     *
+     * @param seconds Time since the start of the system to seek to.
+     * @param frameRate Frame rate to run the simulation with, value of -1 means
+     * (SIMULATION_USE_GAME_ANIMATION_INTERVAL)
+     */
+    void seek(float seconds, float frameRate = SIMULATION_USE_GAME_ANIMATION_INTERVAL);
+
+    /** Sets the seed of the random generator of the particle system, which is also used by seek().
+     * Systems with the same settings and seed emit the same particles when updated with the same delta times.
+     *
+     * @param seed Seed of the random generator. (default: seeded from the current time)
+     */
+    void setSeed(uint32_t seed);
+
+    /** Gets the seed of the random generator of the particle system. */
+    uint32_t getSeed() const { return _seed; }
+
     // Overrides
     virtual void onEnter() override;
     virtual void onExit() override;
@@ -1455,9 +1477,41 @@ public:
      */
     virtual void setTimeScale(float scale = 1.0F);
 
+    /** Sets whether the particles of this system are simulated on the JobSystem.
+     * When enabled, update() only emits and expires particles. The motion and the quads of every system updated
+     * this way are computed together, in parallel, right before the first of them is drawn, or when
+     * flushParallelUpdates() is called. Systems of a ParticleBatchNode write their quads straight into the atlas
+     * of the batch node.
+     @param enabled Whether to simulate the particles in parallel. (default: false)
+     */
+    void setParallelUpdateEnabled(bool enabled);
+
+    /** Whether the particles of this system are simulated on the JobSystem. */
+    bool isParallelUpdateEnabled() const { return _parallelUpdateEnabled; }
+
+    /** Runs the pending parallel updates of all particle systems and waits for them.
+     * Call it before reading the particles or quads of a system that updates in parallel.
+     */
+    static void flushParallelUpdates();
+
 protected:
     virtual void updateBlendFunc();
 
+    /** Moves the particles in [begin, end) and updates their colors, sizes and rotations. */
+    void updateParticles(float dt, int begin, int end);
+
+    /** Captures the state of the scene graph read by updateParticleQuads(), before it runs on a worker thread.
+     should be overridden by subclasses that read node transforms in updateParticleQuads().
+     */
+    virtual void prepareParticleQuads() {}
+
+    void queueParallelUpdate(float dt, bool simulate);
+
+    /** Emits new particles, ages the living ones and removes the expired ones.
+     * @return False if the system removed itself from its parent.
+     */
+    bool updateEmitter(float dt, float pureDt);
+
 private:
     friend class EngineDataManager;
     /** Internal use only, it's used by EngineDataManager class for Android platform */
@@ -1679,9 +1733,21 @@ protected:
     /** is sourcePosition compatible */
     bool _sourcePositionCompatible;
 
+    /** Whether the particles are simulated on the JobSystem */
+    bool _parallelUpdateEnabled;
+    /** Whether this system waits for flushParallelUpdates() */
+    bool _parallelUpdatePending;
+    /** Whether the pending update moves the particles, or only rebuilds the quads */
+    bool _parallelUpdateSimulate;
+    /** Delta time of the pending update */
+    float _parallelUpdateDelta;
+
     static Vector<ParticleSystem*> __allInstances;
+    static Vector<ParticleSystem*> __pendingParallelUpdates;
 
     FastRNG _rng;
+    /** Seed of _rng, restored by seek() */
+    uint32_t _seed;
 
 private:
     AX_DISALLOW_COPY_AND_ASSIGN(ParticleSystem);
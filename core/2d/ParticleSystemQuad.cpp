@@ -303,17 +303,42 @@ inline void updatePosWithParticle(V3F_C4B_T2F_Quad* quad,
     quad->tr.vertices.y = cy;
 }
 
+void ParticleSystemQuad::prepareParticleQuads()
+{
+    if (_positionType == PositionType::FREE)
+    {
+        _preparedPosition    = this->convertToWorldSpace(Vec2::ZERO);
+        _preparedWorldToNode = getWorldToNodeTransform();
+    }
+    else if (_positionType == PositionType::RELATIVE)
+    {
+        _preparedPosition = _position;
+    }
+    _quadsPrepared = true;
+}
+
 void ParticleSystemQuad::updateParticleQuads()
 {
+    // node transforms are computed lazily and must not be touched from a worker thread, so use the prepared ones
+    bool prepared  = _quadsPrepared;
+    _quadsPrepared = false;
+
     if (_particleCount <= 0)
     {
         return;
     }
 
     Vec2 currentPosition;
-    if (_positionType == PositionType::FREE)
+    Mat4 worldToNodeTM;
+    if (prepared)
+    {
+        currentPosition = _preparedPosition;
+        worldToNodeTM   = _preparedWorldToNode;
+    }
+    else if (_positionType == PositionType::FREE)
     {
         currentPosition = this->convertToWorldSpace(Vec2::ZERO);
+        worldToNodeTM   = getWorldToNodeTransform();
     }
     else if (_positionType == PositionType::RELATIVE)
     {
@@ -336,7 +361,6 @@ void ParticleSystemQuad::updateParticleQuads()
     if (_positionType == PositionType::FREE)
     {
         Vec3 p1(currentPosition.x, currentPosition.y, 0);
-        Mat4 worldToNodeTM = getWorldToNodeTransform();
         worldToNodeTM.transformPoint(&p1);
         Vec3 p2;
         Vec2 newPos;
@@ -668,6 +692,9 @@ void ParticleSystemQuad::updateParticleQuads()
 // overriding draw method
 void ParticleSystemQuad::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
 {
+    if (_parallelUpdatePending)
+        flushParallelUpdates();
+
     // quad command
     if (_particleCount > 0)
     {
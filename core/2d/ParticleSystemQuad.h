@@ -167,6 +167,8 @@ protected:
 
     bool allocMemory();
 
+    virtual void prepareParticleQuads() override;
+
     V3F_C4B_T2F_Quad* _quads = nullptr;  // quads to be rendered
     unsigned short* _indices = nullptr;  // indices
 
@@ -175,6 +177,11 @@ protected:
     backend::UniformLocation _mvpMatrixLocaiton;
     backend::UniformLocation _textureLocation;
 
+    // emitter position and world to node transform captured by prepareParticleQuads()
+    bool _quadsPrepared = false;
+    Vec2 _preparedPosition;
+    Mat4 _preparedWorldToNode;
+
 private:
     AX_DISALLOW_COPY_AND_ASSIGN(ParticleSystemQuad);
 };
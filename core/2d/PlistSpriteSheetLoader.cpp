@@ -9,6 +9,7 @@
 #include "base/UTF8.h"
 #include "base/Utils.h"
 #include "base/Director.h"
+#include "base/AsyncTaskPool.h"
 #include "renderer/Texture2D.h"
 #include "renderer/TextureCache.h"
 
@@ -30,56 +31,29 @@ void PlistSpriteSheetLoader::load(std::string_view filePath, SpriteFrameCache& c
         return;
     }
 
-    auto dict = FileUtils::getInstance()->getValueMapFromFile(fullPath);
+    ValueDocument doc;
+    doc.initWithPlistFile(fullPath);
+    auto dict = doc.getRoot();
 
-    std::string texturePath;
-
-    if (dict.find("metadata") != dict.end())
-    {
-        auto& metadataDict = dict["metadata"].asValueMap();
-        // try to read  texture file name from meta data
-        texturePath = metadataDict["textureFileName"].asString();
-    }
-
-    if (!texturePath.empty())
-    {
-        // build texture path relative to plist file
-        texturePath = FileUtils::getInstance()->fullPathFromRelativeFile(texturePath, filePath);
-    }
-    else
-    {
-        // build texture path by replacing file extension
-        texturePath = filePath;
-
-        // remove .xxx
-        const auto startPos = texturePath.find_last_of('.');
-        if (startPos != string::npos)
-        {
-            texturePath = texturePath.erase(startPos);
-        }
-
-        // append .png
-        texturePath = texturePath.append(".png");
-
-        AXLOG("axmol: SpriteFrameCache: Trying to use file %s as texture", texturePath.c_str());
-    }
-    addSpriteFramesWithDictionary(dict, texturePath, filePath, cache);
+    addSpriteFramesWithDictionary(dict, getTexturePath(dict, filePath), filePath, cache);
 }
 
 void PlistSpriteSheetLoader::load(std::string_view filePath, Texture2D* texture, SpriteFrameCache& cache)
 {
     const auto fullPath = FileUtils::getInstance()->fullPathForFilename(filePath);
-    auto dict           = FileUtils::getInstance()->getValueMapFromFile(fullPath);
+    ValueDocument doc;
+    doc.initWithPlistFile(fullPath);
 
-    addSpriteFramesWithDictionary(dict, texture, filePath, cache);
+    addSpriteFramesWithDictionary(doc.getRoot(), texture, filePath, cache);
 }
 
 void PlistSpriteSheetLoader::load(std::string_view filePath, std::string_view textureFileName, SpriteFrameCache& cache)
 {
     AXASSERT(!textureFileName.empty(), "texture name should not be null");
     const auto fullPath = FileUtils::getInstance()->fullPathForFilename(filePath);
-    auto dict           = FileUtils::getInstance()->getValueMapFromFile(fullPath);
-    addSpriteFramesWithDictionary(dict, textureFileName, filePath, cache);
+    ValueDocument doc;
+    doc.initWithPlistFile(fullPath);
+    addSpriteFramesWithDictionary(doc.getRoot(), textureFileName, filePath, cache);
 }
 
 void PlistSpriteSheetLoader::load(const Data& content, Texture2D* texture, SpriteFrameCache& cache)
@@ -92,22 +66,102 @@ void PlistSpriteSheetLoader::load(const Data& content, Texture2D* texture, Sprit
     auto* text        = (char*)content.getBytes();
     const auto length = content.getSize();
 
-    auto dict = FileUtils::getInstance()->getValueMapFromData(text, static_cast<int>(length));
-    addSpriteFramesWithDictionary(dict, texture, "by#addSpriteFramesWithFileContent()", cache);
+    ValueDocument doc;
+    doc.initWithPlistData(text, length);
+    addSpriteFramesWithDictionary(doc.getRoot(), texture, "by#addSpriteFramesWithFileContent()", cache);
 }
 
 void PlistSpriteSheetLoader::reload(std::string_view filePath, SpriteFrameCache& cache)
 {
     const auto fullPath = FileUtils::getInstance()->fullPathForFilename(filePath);
-    auto dict           = FileUtils::getInstance()->getValueMapFromFile(fullPath);
+    ValueDocument doc;
+    doc.initWithPlistFile(fullPath);
+    auto dict = doc.getRoot();
+
+    auto texturePath   = getTexturePath(dict, filePath);
+    Texture2D* texture = nullptr;
+    if (Director::getInstance()->getTextureCache()->reloadTexture(texturePath))
+    {
+        texture = Director::getInstance()->getTextureCache()->getTextureForKey(texturePath);
+    }
+
+    if (texture)
+    {
+        reloadSpriteFramesWithDictionary(dict, texture, filePath, cache);
+    }
+    else
+    {
+        AXLOG("axmol: SpriteFrameCache: Couldn't load texture");
+    }
+}
+
+void PlistSpriteSheetLoader::loadAsync(std::string_view filePath,
+                                       SpriteFrameCache& cache,
+                                       const std::function<void(bool)>& callback)
+{
+    struct AsyncLoad
+    {
+        std::string path;
+        ValueDocument doc;
+        std::function<void(bool)> callback;
+    };
+
+    auto state      = std::make_shared<AsyncLoad>();
+    state->path     = filePath;
+    state->callback = callback;
+
+    auto cachePtr = &cache;
+    cachePtr->retain();
+    auto finish = [state, cachePtr](bool loaded) {
+        if (!loaded)
+            AXLOG("axmol: SpriteFrameCache: can not load %s", state->path.c_str());
+        cachePtr->release();
+
+        if (state->callback)
+            state->callback(loaded);
+    };
+
+    AsyncTaskPool::getInstance()->enqueue(AsyncTaskPool::TaskType::TASK_IO, [this, state, cachePtr, finish]() {
+        // the document is self contained, so the plist is parsed here and only the frames are created on the main
+        // thread
+        const auto fullPath = FileUtils::getInstance()->fullPathForFilename(state->path);
+        bool parsed         = !fullPath.empty() && state->doc.initWithPlistFile(fullPath);
+
+        Director::getInstance()->getScheduler()->runOnAxmolThread([this, state, cachePtr, finish, parsed]() {
+            if (!parsed)
+            {
+                finish(false);
+                return;
+            }
 
+            auto dict        = state->doc.getRoot();
+            auto texturePath = getTexturePath(dict, state->path);
+            std::string pixelFormatName{dict["metadata"sv]["pixelFormat"sv].asString()};
+            backend::PixelFormat pixelFormat;
+            if (!getPixelFormatByName(pixelFormatName, pixelFormat))
+                pixelFormat = Texture2D::getDefaultAlphaPixelFormat();
+
+            Director::getInstance()->getTextureCache()->addImageAsync(
+                texturePath,
+                [this, state, cachePtr, finish](Texture2D* texture) {
+                    if (texture)
+                        addSpriteFramesWithDictionary(state->doc.getRoot(), texture, state->path, *cachePtr);
+                    finish(texture && cachePtr->isSpriteFramesWithFileLoaded(state->path));
+                },
+                texturePath, pixelFormat);
+        });
+    });
+}
+
+std::string PlistSpriteSheetLoader::getTexturePath(const ValueDocument::Node& dict, std::string_view filePath)
+{
     std::string texturePath;
 
-    if (dict.find("metadata") != dict.end())
+    auto metadataDict = dict["metadata"sv];
+    if (metadataDict.isDict())
     {
-        auto& metadataDict = dict["metadata"].asValueMap();
         // try to read  texture file name from meta data
-        texturePath = metadataDict["textureFileName"].asString();
+        texturePath = metadataDict["textureFileName"sv].asString();
     }
 
     if (!texturePath.empty())
@@ -129,25 +183,13 @@ void PlistSpriteSheetLoader::reload(std::string_view filePath, SpriteFrameCache&
 
         // append .png
         texturePath = texturePath.append(".png");
-    }
-
-    Texture2D* texture = nullptr;
-    if (Director::getInstance()->getTextureCache()->reloadTexture(texturePath))
-    {
-        texture = Director::getInstance()->getTextureCache()->getTextureForKey(texturePath);
-    }
 
-    if (texture)
-    {
-        reloadSpriteFramesWithDictionary(dict, texture, filePath, cache);
-    }
-    else
-    {
-        AXLOG("axmol: SpriteFrameCache: Couldn't load texture");
+        AXLOG("axmol: SpriteFrameCache: Trying to use file %s as texture", texturePath.c_str());
     }
+    return texturePath;
 }
 
-void PlistSpriteSheetLoader::addSpriteFramesWithDictionary(ValueMap& dictionary,
+void PlistSpriteSheetLoader::addSpriteFramesWithDictionary(const ValueDocument::Node& dictionary,
                                                            Texture2D* texture,
                                                            std::string_view plist,
                                                            SpriteFrameCache& cache)
@@ -163,28 +205,27 @@ void PlistSpriteSheetLoader::addSpriteFramesWithDictionary(ValueMap& dictionary,
     Version 3 with TexturePacker 4.0 polygon mesh packing
     */
 
-    if (dictionary["frames"].getType() != ax::Value::Type::MAP)
+    auto framesDict = dictionary["frames"sv];
+    if (!framesDict.isDict())
         return;
 
     auto spriteSheet    = std::make_shared<SpriteSheet>();
     spriteSheet->format = getFormat();
     spriteSheet->path   = plist;
 
-    auto& framesDict = dictionary["frames"].asValueMap();
-    int format       = 0;
+    int format = 0;
 
     Vec2 textureSize;
 
     // get the format
-    auto metaItr = dictionary.find("metadata"sv);
-    if (metaItr != dictionary.end())
+    auto metadataDict = dictionary["metadata"sv];
+    if (metadataDict.isDict())
     {
-        auto& metadataDict = metaItr->second.asValueMap();
-        format             = optValue(metadataDict, "format"sv).asInt();
+        format = metadataDict["format"sv].asInt();
 
-        if (metadataDict.find("size"sv) != metadataDict.end())
+        if (metadataDict.hasKey("size"sv))
         {
-            textureSize = SizeFromString(optValue(metadataDict, "size"sv).asString());
+            textureSize = SizeFromString(metadataDict["size"sv].asString());
         }
     }
 
@@ -196,10 +237,10 @@ void PlistSpriteSheetLoader::addSpriteFramesWithDictionary(ValueMap& dictionary,
     auto textureFileName = Director::getInstance()->getTextureCache()->getTextureFilePath(texture);
     Image* image         = nullptr;
     NinePatchImageParser parser;
-    for (auto&& iter : framesDict)
+    for (size_t i = 0, count = framesDict.size(); i < count; ++i)
     {
-        auto& frameDict      = iter.second.asValueMap();
-        auto spriteFrameName = iter.first;
+        auto frameDict       = framesDict.at(i);
+        auto spriteFrameName = framesDict.keyAt(i);
         auto* spriteFrame    = cache.findFrame(spriteFrameName);
         if (spriteFrame)
         {
@@ -208,14 +249,14 @@ void PlistSpriteSheetLoader::addSpriteFramesWithDictionary(ValueMap& dictionary,
 
         if (format == 0)
         {
-            auto x  = optValue(frameDict, "x"sv).asFloat();
-            auto y  = optValue(frameDict, "y"sv).asFloat();
-            auto w  = optValue(frameDict, "width"sv).asFloat();
-            auto h  = optValue(frameDict, "height"sv).asFloat();
-            auto ox = optValue(frameDict, "offsetX"sv).asFloat();
-            auto oy = optValue(frameDict, "offsetY"sv).asFloat();
-            auto ow = optValue(frameDict, "originalWidth"sv).asInt();
-            auto oh = optValue(frameDict, "originalHeight"sv).asInt();
+            auto x  = frameDict["x"sv].asFloat();
+            auto y  = frameDict["y"sv].asFloat();
+            auto w  = frameDict["width"sv].asFloat();
+            auto h  = frameDict["height"sv].asFloat();
+            auto ox = frameDict["offsetX"sv].asFloat();
+            auto oy = frameDict["offsetY"sv].asFloat();
+            auto ow = frameDict["originalWidth"sv].asInt();
+            auto oh = frameDict["originalHeight"sv].asInt();
             // check ow/oh
             if (!ow || !oh)
             {
@@ -232,17 +273,17 @@ void PlistSpriteSheetLoader::addSpriteFramesWithDictionary(ValueMap& dictionary,
         }
         else if (format == 1 || format == 2)
         {
-            auto frame   = RectFromString(optValue(frameDict, "frame"sv).asString());
+            auto frame   = RectFromString(frameDict["frame"sv].asString());
             auto rotated = false;
 
             // rotation
             if (format == 2)
             {
-                rotated = optValue(frameDict, "rotated"sv).asBool();
+                rotated = frameDict["rotated"sv].asBool();
             }
 
-            auto offset     = PointFromString(optValue(frameDict, "offset"sv).asString());
-            auto sourceSize = SizeFromString(optValue(frameDict, "sourceSize"sv).asString());
+            auto offset     = PointFromString(frameDict["offset"sv].asString());
+            auto sourceSize = SizeFromString(frameDict["sourceSize"sv].asString());
 
             // create frame
             spriteFrame = SpriteFrame::createWithTexture(texture, frame, rotated, offset, sourceSize);
@@ -250,25 +291,25 @@ void PlistSpriteSheetLoader::addSpriteFramesWithDictionary(ValueMap& dictionary,
         else if (format == 3)
         {
             // get values
-            auto spriteSize       = SizeFromString(optValue(frameDict, "spriteSize"sv).asString());
-            auto spriteOffset     = PointFromString(optValue(frameDict, "spriteOffset"sv).asString());
-            auto spriteSourceSize = SizeFromString(optValue(frameDict, "spriteSourceSize"sv).asString());
-            auto textureRect      = RectFromString(optValue(frameDict, "textureRect"sv).asString());
-            auto textureRotated   = optValue(frameDict, "textureRotated"sv).asBool();
+            auto spriteSize       = SizeFromString(frameDict["spriteSize"sv].asString());
+            auto spriteOffset     = PointFromString(frameDict["spriteOffset"sv].asString());
+            auto spriteSourceSize = SizeFromString(frameDict["spriteSourceSize"sv].asString());
+            auto textureRect      = RectFromString(frameDict["textureRect"sv].asString());
+            auto textureRotated   = frameDict["textureRotated"sv].asBool();
 
             // get aliases
-            auto& aliases = optValue(frameDict, "aliases"sv).asValueVector();
+            auto aliases = frameDict["aliases"sv];
 
-            for (const auto& value : aliases)
+            for (size_t aliasIndex = 0; aliasIndex < aliases.size(); ++aliasIndex)
             {
-                auto oneAlias = value.asString();
+                auto oneAlias = aliases.at(aliasIndex).asString();
                 if (std::find(frameAliases.begin(), frameAliases.end(), oneAlias) == frameAliases.end())
                 {
-                    frameAliases.emplace_back(std::move(oneAlias));
+                    frameAliases.emplace_back(oneAlias);
                 }
                 else
                 {
-                    AXLOGWARN("axmol: WARNING: an alias with name %s already exists", oneAlias.c_str());
+                    AXLOGWARN("axmol: WARNING: an alias with name %s already exists", oneAlias.data());
                 }
             }
 
@@ -277,20 +318,20 @@ void PlistSpriteSheetLoader::addSpriteFramesWithDictionary(ValueMap& dictionary,
                 texture, Rect(textureRect.origin.x, textureRect.origin.y, spriteSize.width, spriteSize.height),
                 textureRotated, spriteOffset, spriteSourceSize);
 
-            if (frameDict.find("vertices") != frameDict.end())
+            if (frameDict.hasKey("vertices"sv))
             {
                 using ax::utils::parseIntegerList;
-                auto vertices   = parseIntegerList(optValue(frameDict, "vertices"sv).asString());
-                auto verticesUV = parseIntegerList(optValue(frameDict, "verticesUV"sv).asString());
-                auto indices    = parseIntegerList(optValue(frameDict, "triangles"sv).asString());
+                auto vertices   = parseIntegerList(frameDict["vertices"sv].asString());
+                auto verticesUV = parseIntegerList(frameDict["verticesUV"sv].asString());
+                auto indices    = parseIntegerList(frameDict["triangles"sv].asString());
 
                 PolygonInfo info;
                 initializePolygonInfo(textureSize, spriteSourceSize, vertices, verticesUV, indices, info);
                 spriteFrame->setPolygonInfo(info);
             }
-            if (frameDict.find("anchor") != frameDict.end())
+            if (frameDict.hasKey("anchor"sv))
             {
-                spriteFrame->setAnchorPoint(PointFromString(optValue(frameDict, "anchor"sv).asString()));
+                spriteFrame->setAnchorPoint(PointFromString(frameDict["anchor"sv].asString()));
             }
         }
 
@@ -320,40 +361,17 @@ void PlistSpriteSheetLoader::addSpriteFramesWithDictionary(ValueMap& dictionary,
     AX_SAFE_DELETE(image);
 }
 
-void PlistSpriteSheetLoader::addSpriteFramesWithDictionary(ValueMap& dict,
+void PlistSpriteSheetLoader::addSpriteFramesWithDictionary(const ValueDocument::Node& dict,
                                                            std::string_view texturePath,
                                                            std::string_view plist,
                                                            SpriteFrameCache& cache)
 {
-    std::string pixelFormatName;
-    if (dict.find("metadata") != dict.end())
-    {
-        auto& metadataDict = dict.at("metadata").asValueMap();
-        if (metadataDict.find("pixelFormat") != metadataDict.end())
-        {
-            pixelFormatName = metadataDict.at("pixelFormat").asString();
-        }
-    }
+    std::string pixelFormatName{dict["metadata"sv]["pixelFormat"sv].asString()};
 
-    Texture2D* texture                                                        = nullptr;
-    static std::unordered_map<std::string, backend::PixelFormat> pixelFormats = {
-        {"RGBA8888", backend::PixelFormat::RGBA8},
-        {"RGBA4444", backend::PixelFormat::RGBA4},
-        {"RGB5A1", backend::PixelFormat::RGB5A1},
-        {"RGBA5551", backend::PixelFormat::RGB5A1},
-        {"RGB565", backend::PixelFormat::RGB565},
-        {"A8", backend::PixelFormat::A8},
-        {"ALPHA", backend::PixelFormat::A8},
-        {"I8", backend::PixelFormat::L8},
-        {"AI88", backend::PixelFormat::LA8},
-        {"ALPHA_INTENSITY", backend::PixelFormat::LA8},
-        //{"BGRA8888", backend::PixelFormat::BGRA8888}, no Image conversion RGBA -> BGRA
-        {"RGB888", backend::PixelFormat::RGB8}};
-
-    const auto pixelFormatIt = pixelFormats.find(pixelFormatName);
-    if (pixelFormatIt != pixelFormats.end())
+    Texture2D* texture = nullptr;
+    backend::PixelFormat pixelFormat;
+    if (getPixelFormatByName(pixelFormatName, pixelFormat))
     {
-        const backend::PixelFormat pixelFormat        = (*pixelFormatIt).second;
         texture = Director::getInstance()->getTextureCache()->addImage(texturePath, pixelFormat);
     }
     else
@@ -371,19 +389,19 @@ void PlistSpriteSheetLoader::addSpriteFramesWithDictionary(ValueMap& dict,
     }
 }
 
-void PlistSpriteSheetLoader::reloadSpriteFramesWithDictionary(ValueMap& dict,
+void PlistSpriteSheetLoader::reloadSpriteFramesWithDictionary(const ValueDocument::Node& dict,
                                                               Texture2D* texture,
                                                               std::string_view plist,
                                                               SpriteFrameCache& cache)
 {
-    auto& framesDict = dict["frames"].asValueMap();
-    int format       = 0;
+    auto framesDict = dict["frames"sv];
+    int format      = 0;
 
     // get the format
-    if (dict.find("metadata") != dict.end())
+    auto metadataDict = dict["metadata"sv];
+    if (metadataDict.isDict())
     {
-        auto& metadataDict = dict["metadata"].asValueMap();
-        format             = metadataDict["format"].asInt();
+        format = metadataDict["format"sv].asInt();
     }
 
     // check the format
@@ -394,10 +412,10 @@ void PlistSpriteSheetLoader::reloadSpriteFramesWithDictionary(ValueMap& dict,
     spriteSheet->format = getFormat();
     spriteSheet->path   = plist;
 
-    for (auto&& iter : framesDict)
+    for (size_t i = 0, count = framesDict.size(); i < count; ++i)
     {
-        const ValueMap& frameDict        = iter.second.asValueMap();
-        std::string_view spriteFrameName = iter.first;
+        auto frameDict                   = framesDict.at(i);
+        std::string_view spriteFrameName = framesDict.keyAt(i);
 
         cache.eraseFrame(spriteFrameName);
 
@@ -406,14 +424,14 @@ void PlistSpriteSheetLoader::reloadSpriteFramesWithDictionary(ValueMap& dict,
 
         if (format == 0)
         {
-            const auto x  = optValue(frameDict, "x"sv).asFloat();
-            const auto y  = optValue(frameDict, "y"sv).asFloat();
-            const auto w  = optValue(frameDict, "width"sv).asFloat();
-            const auto h  = optValue(frameDict, "height"sv).asFloat();
-            const auto ox = optValue(frameDict, "offsetX"sv).asFloat();
-            const auto oy = optValue(frameDict, "offsetY"sv).asFloat();
-            auto ow       = optValue(frameDict, "originalWidth"sv).asInt();
-            auto oh       = optValue(frameDict, "originalHeight"sv).asInt();
+            const auto x  = frameDict["x"sv].asFloat();
+            const auto y  = frameDict["y"sv].asFloat();
+            const auto w  = frameDict["width"sv].asFloat();
+            const auto h  = frameDict["height"sv].asFloat();
+            const auto ox = frameDict["offsetX"sv].asFloat();
+            const auto oy = frameDict["offsetY"sv].asFloat();
+            auto ow       = frameDict["originalWidth"sv].asInt();
+            auto oh       = frameDict["originalHeight"sv].asInt();
             // check ow/oh
             if (!ow || !oh)
             {
@@ -430,17 +448,17 @@ void PlistSpriteSheetLoader::reloadSpriteFramesWithDictionary(ValueMap& dict,
         }
         else if (format == 1 || format == 2)
         {
-            auto frame   = RectFromString(optValue(frameDict, "frame"sv).asString());
+            auto frame   = RectFromString(frameDict["frame"sv].asString());
             auto rotated = false;
 
             // rotation
             if (format == 2)
             {
-                rotated = optValue(frameDict, "rotated"sv).asBool();
+                rotated = frameDict["rotated"sv].asBool();
             }
 
-            auto offset     = PointFromString(optValue(frameDict, "offset"sv).asString());
-            auto sourceSize = SizeFromString(optValue(frameDict, "sourceSize"sv).asString());
+            auto offset     = PointFromString(frameDict["offset"sv].asString());
+            auto sourceSize = SizeFromString(frameDict["sourceSize"sv].asString());
 
             // create frame
             spriteFrame = SpriteFrame::createWithTexture(texture, frame, rotated, offset, sourceSize);
@@ -448,25 +466,25 @@ void PlistSpriteSheetLoader::reloadSpriteFramesWithDictionary(ValueMap& dict,
         else if (format == 3)
         {
             // get values
-            const auto spriteSize     = SizeFromString(optValue(frameDict, "spriteSize"sv).asString());
-            auto spriteOffset         = PointFromString(optValue(frameDict, "spriteOffset"sv).asString());
-            auto spriteSourceSize     = SizeFromString(optValue(frameDict, "spriteSourceSize"sv).asString());
-            const auto textureRect    = RectFromString(optValue(frameDict, "textureRect"sv).asString());
-            const auto textureRotated = optValue(frameDict, "textureRotated"sv).asBool();
+            const auto spriteSize     = SizeFromString(frameDict["spriteSize"sv].asString());
+            auto spriteOffset         = PointFromString(frameDict["spriteOffset"sv].asString());
+            auto spriteSourceSize     = SizeFromString(frameDict["spriteSourceSize"sv].asString());
+            const auto textureRect    = RectFromString(frameDict["textureRect"sv].asString());
+            const auto textureRotated = frameDict["textureRotated"sv].asBool();
 
             // get aliases
-            const ValueVector& aliases = optValue(frameDict, "aliases"sv).asValueVector();
+            auto aliases = frameDict["aliases"sv];
 
-            for (const auto& value : aliases)
+            for (size_t aliasIndex = 0; aliasIndex < aliases.size(); ++aliasIndex)
             {
-                auto oneAlias = value.asString();
+                auto oneAlias = aliases.at(aliasIndex).asString();
                 if (std::find(frameAliases.begin(), frameAliases.end(), oneAlias) == frameAliases.end())
                 {
-                    frameAliases.emplace_back(std::move(oneAlias));
+                    frameAliases.emplace_back(oneAlias);
                 }
                 else
                 {
-                    AXLOGWARN("axmol: WARNING: an alias with name %s already exists", oneAlias.c_str());
+                    AXLOGWARN("axmol: WARNING: an alias with name %s already exists", oneAlias.data());
                 }
             }
 
@@ -4,6 +4,7 @@
 
 #include "2d/SpriteSheetLoader.h"
 #include "base/Value.h"
+#include "base/ValueDocument.h"
 #include "base/Data.h"
 
 NS_AX_BEGIN
@@ -19,23 +20,29 @@ public:
     void load(std::string_view filePath, std::string_view textureFileName, SpriteFrameCache& cache) override;
     void load(const Data& content, Texture2D* texture, SpriteFrameCache& cache) override;
     void reload(std::string_view filePath, SpriteFrameCache& cache) override;
+    void loadAsync(std::string_view filePath,
+                   SpriteFrameCache& cache,
+                   const std::function<void(bool)>& callback) override;
 
 protected:
+    /* Returns the texture named in the metadata, or the plist path with a .png extension. */
+    std::string getTexturePath(const ValueDocument::Node& dict, std::string_view filePath);
+
     /*Adds multiple Sprite Frames with a dictionary. The texture will be associated with the created sprite frames.
      */
-    void addSpriteFramesWithDictionary(ValueMap& dictionary,
+    void addSpriteFramesWithDictionary(const ValueDocument::Node& dictionary,
                                        Texture2D* texture,
                                        std::string_view plist,
                                        SpriteFrameCache& cache);
 
     /*Adds multiple Sprite Frames with a dictionary. The texture will be associated with the created sprite frames.
      */
-    void addSpriteFramesWithDictionary(ValueMap& dict,
+    void addSpriteFramesWithDictionary(const ValueDocument::Node& dict,
                                        std::string_view texturePath,
                                        std::string_view plist,
                                        SpriteFrameCache& cache);
 
-    void reloadSpriteFramesWithDictionary(ValueMap& dict,
+    void reloadSpriteFramesWithDictionary(const ValueDocument::Node& dict,
                                           Texture2D* texture,
                                           std::string_view plist,
                                           SpriteFrameCache& cache);
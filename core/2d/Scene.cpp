@@ -33,6 +33,7 @@ THE SOFTWARE.
 #include "base/EventListenerCustom.h"
 #include "base/UTF8.h"
 #include "renderer/Renderer.h"
+#include "base/FrameProfiler.h"
 
 #if AX_USE_PHYSICS
 #    include "physics/PhysicsWorld.h"
@@ -273,6 +274,16 @@ void Scene::removeAllChildren()
 }
 
 #if AX_USE_3D_PHYSICS && AX_ENABLE_BULLET_INTEGRATION
+void Scene::setPhysics3DWorld(Physics3DWorld* world)
+{
+    if (_physics3DWorld != world)
+    {
+        AX_SAFE_RETAIN(world);
+        AX_SAFE_RELEASE(_physics3DWorld);
+        _physics3DWorld = world;
+    }
+}
+
 void Scene::setPhysics3DDebugCamera(Camera* camera)
 {
     AX_SAFE_RETAIN(camera);
@@ -342,6 +353,8 @@ bool Scene::initPhysicsWorld()
 #if (AX_USE_PHYSICS || (AX_USE_3D_PHYSICS && AX_ENABLE_BULLET_INTEGRATION) || AX_USE_NAVMESH)
 void Scene::stepPhysicsAndNavigation(float deltaTime)
 {
+    AX_PROFILER_ZONE("Scene::stepPhysicsAndNavigation");
+
 #    if AX_USE_PHYSICS
     if (_physicsWorld && _physicsWorld->isAutoStep())
         _physicsWorld->update(deltaTime);
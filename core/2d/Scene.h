@@ -170,6 +170,12 @@ public:
      */
     Physics3DWorld* getPhysics3DWorld() { return _physics3DWorld; }
 
+    /** Replaces the 3d physics world, e.g. with one created with custom Physics3DWorldDes. Set it before adding
+     * physics objects, the ones already added stay in the previous world.
+     * @js NA
+     */
+    void setPhysics3DWorld(Physics3DWorld* world);
+
     /**
      * Set Physics3D debug draw camera.
      */
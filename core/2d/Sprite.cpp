@@ -1045,6 +1045,7 @@ void Sprite::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
         // XXX: this always return true since
         _insideBounds = renderer->checkVisibility(transform, _contentSize);
 
+    renderer->addCullingResult(_insideBounds);
     if (_insideBounds)
 #endif
     {
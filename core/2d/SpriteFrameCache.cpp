@@ -35,9 +35,11 @@ THE SOFTWARE.
 #include "2d/Sprite.h"
 #include "2d/AutoPolygon.h"
 #include "2d/PlistSpriteSheetLoader.h"
+#include "2d/BinarySpriteSheetLoader.h"
 #include "platform/FileUtils.h"
 #include "base/Macros.h"
 #include "base/Director.h"
+#include "base/FrameProfiler.h"
 #include "renderer/Texture2D.h"
 #include "base/NinePatchImageParser.h"
 
@@ -69,6 +71,7 @@ bool SpriteFrameCache::init()
     clear();
 
     registerSpriteSheetLoader(std::make_shared<PlistSpriteSheetLoader>());
+    registerSpriteSheetLoader(std::make_shared<BinarySpriteSheetLoader>());
 
     return true;
 }
@@ -99,6 +102,8 @@ void SpriteFrameCache::addSpriteFramesWithFile(std::string_view spriteSheetFileN
 
 void SpriteFrameCache::addSpriteFramesWithFile(std::string_view spriteSheetFileName, uint32_t spriteSheetFormat)
 {
+    AX_PROFILER_ZONE("SpriteFrameCache::addSpriteFramesWithFile");
+
     auto* loader = getSpriteSheetLoader(spriteSheetFormat);
     if (loader)
     {
@@ -117,6 +122,21 @@ void SpriteFrameCache::addSpriteFramesWithFileContent(const Data& content,
     }
 }
 
+void SpriteFrameCache::addSpriteFramesWithFileAsync(std::string_view spriteSheetFileName,
+                                                    const std::function<void(bool)>& callback,
+                                                    uint32_t spriteSheetFormat)
+{
+    auto* loader = getSpriteSheetLoader(spriteSheetFormat);
+    if (loader)
+    {
+        loader->loadAsync(spriteSheetFileName, *this, callback);
+    }
+    else if (callback)
+    {
+        callback(false);
+    }
+}
+
 bool SpriteFrameCache::isSpriteFramesWithFileLoaded(std::string_view plist) const
 {
     return isSpriteSheetInUse(plist) && isPlistFull(plist);
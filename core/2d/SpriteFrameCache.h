@@ -153,6 +153,20 @@ public:
                                  Texture2D* texture,
                                  uint32_t spriteSheetFormat = SpriteSheetFormat::PLIST);
 
+    /** Adds multiple Sprite Frames from a file without blocking the main thread. The sprite sheet is decoded on a worker
+     * thread, the texture is loaded asynchronously and the frames are added in one batch on the main thread.
+     * Formats without async support are loaded synchronously.
+     * @js NA
+     * @lua NA
+     *
+     * @param spriteSheetFileName file name.
+     * @param callback Called on the main thread with true if the sprite frames were added.
+     * @param spriteSheetFormat
+     */
+    void addSpriteFramesWithFileAsync(std::string_view spriteSheetFileName,
+                                      const std::function<void(bool)>& callback,
+                                      uint32_t spriteSheetFormat = SpriteSheetFormat::PLIST);
+
     /** Adds multiple Sprite Frames from a plist file content. The texture will be associated with the created sprite
      * frames.
      * @js NA
@@ -1,4 +1,5 @@
 #include "2d/SpriteSheetLoader.h"
+#include "2d/SpriteFrameCache.h"
 #include "base/Director.h"
 #include <vector>
 
@@ -41,4 +42,36 @@ void SpriteSheetLoader::initializePolygonInfo(const Vec2& textureSize,
     info.setRect(Rect(0, 0, spriteSize.width, spriteSize.height));
 }
 
+bool SpriteSheetLoader::getPixelFormatByName(std::string_view name, backend::PixelFormat& format)
+{
+    static hlookup::string_map<backend::PixelFormat> pixelFormats = {
+        {"RGBA8888", backend::PixelFormat::RGBA8},
+        {"RGBA4444", backend::PixelFormat::RGBA4},
+        {"RGB5A1", backend::PixelFormat::RGB5A1},
+        {"RGBA5551", backend::PixelFormat::RGB5A1},
+        {"RGB565", backend::PixelFormat::RGB565},
+        {"A8", backend::PixelFormat::A8},
+        {"ALPHA", backend::PixelFormat::A8},
+        {"I8", backend::PixelFormat::L8},
+        {"AI88", backend::PixelFormat::LA8},
+        {"ALPHA_INTENSITY", backend::PixelFormat::LA8},
+        //{"BGRA8888", backend::PixelFormat::BGRA8888}, no Image conversion RGBA -> BGRA
+        {"RGB888", backend::PixelFormat::RGB8}};
+
+    auto it = pixelFormats.find(name);
+    if (it == pixelFormats.end())
+        return false;
+    format = it->second;
+    return true;
+}
+
+void ISpriteSheetLoader::loadAsync(std::string_view filePath,
+                                   SpriteFrameCache& cache,
+                                   const std::function<void(bool)>& callback)
+{
+    load(filePath, cache);
+    if (callback)
+        callback(cache.isSpriteFramesWithFileLoaded(filePath));
+}
+
 NS_AX_END
@@ -30,6 +30,7 @@ THE SOFTWARE.
 
 #pragma once
 
+#include <functional>
 #include <set>
 #include <unordered_map>
 #include <string>
@@ -38,6 +39,7 @@ THE SOFTWARE.
 #include "base/Value.h"
 #include "base/Map.h"
 #include "base/Data.h"
+#include "renderer/backend/Enums.h"
 
 NS_AX_BEGIN
 
@@ -56,6 +58,7 @@ struct SpriteSheetFormat
     enum : uint32_t
     {
         PLIST  = 1,
+        BINARY = 2,
         CUSTOM = 1000
     };
 };
@@ -79,6 +82,15 @@ public:
     virtual void load(std::string_view filePath, std::string_view textureFileName, SpriteFrameCache& cache) = 0;
     virtual void load(const Data& content, Texture2D* texture, SpriteFrameCache& cache)                     = 0;
     virtual void reload(std::string_view filePath, SpriteFrameCache& cache)                                 = 0;
+
+    /**
+     * Loads a sprite sheet and its texture without blocking the main thread where the format allows it.
+     * The default implementation loads synchronously.
+     * @param callback Called on the main thread, with whether the sprite sheet was loaded.
+     */
+    virtual void loadAsync(std::string_view filePath,
+                           SpriteFrameCache& cache,
+                           const std::function<void(bool)>& callback);
 };
 
 class SpriteSheetLoader : public ISpriteSheetLoader
@@ -92,6 +104,12 @@ public:
                                const std::vector<int>& triangleIndices,
                                PolygonInfo& polygonInfo);
 
+    /**
+     * Maps a pixel format name used by sprite sheet tools, such as "RGBA4444", to the backend pixel format.
+     * @return false if the name is unknown.
+     */
+    static bool getPixelFormatByName(std::string_view name, backend::PixelFormat& format);
+
     uint32_t getFormat() override                                                                            = 0;
     void load(std::string_view filePath, SpriteFrameCache& cache) override                                   = 0;
     void load(std::string_view filePath, Texture2D* texture, SpriteFrameCache& cache) override               = 0;
@@ -30,12 +30,14 @@ THE SOFTWARE.
 #include "2d/TMXXMLParser.h"
 #include <unordered_map>
 #include <sstream>
-#include <regex>
+#include <algorithm>
 //  #include "2d/TMXTiledMap.h"
 #include "base/ZipUtils.h"
 #include "base/Director.h"
 #include "base/Utils.h"
 #include "platform/FileUtils.h"
+#include "yasio/ibstream.hpp"
+#include "yasio/obstream.hpp"
 
 // using namespace std;
 
@@ -93,10 +95,10 @@ Rect TMXTilesetInfo::getRectForGID(uint32_t gid)
 
 // implementation TMXMapInfo
 
-TMXMapInfo* TMXMapInfo::create(std::string_view tmxFile)
+TMXMapInfo* TMXMapInfo::create(std::string_view tmxFile, bool chunkStreaming)
 {
     TMXMapInfo* ret = new TMXMapInfo();
-    if (ret->initWithTMXFile(tmxFile))
+    if (ret->initWithTMXFile(tmxFile, chunkStreaming))
     {
         ret->autorelease();
         return ret;
@@ -145,9 +147,10 @@ bool TMXMapInfo::initWithXML(std::string_view tmxString, std::string_view resour
     return parseXMLString(tmxString);
 }
 
-bool TMXMapInfo::initWithTMXFile(std::string_view tmxFile)
+bool TMXMapInfo::initWithTMXFile(std::string_view tmxFile, bool chunkStreaming)
 {
     internalInit(tmxFile, "");
+    _chunkStreaming = chunkStreaming;
     return parseXMLFile(_TMXFileName);
 }
 
@@ -266,6 +269,9 @@ void TMXMapInfo::startElement(void* /*ctx*/, const char* name, const char** atts
             tmxMapInfo->setStaggerIndex(TMXStaggerIndex_Even);
         }
 
+        Value& infiniteValue = attributeDict["infinite"];
+        tmxMapInfo->setInfinite(!infiniteValue.isNull() && infiniteValue.asBool());
+
         auto hexSideLength = attributeDict["hexsidelength"].asInt();
         tmxMapInfo->setHexSideLength(hexSideLength);
 
@@ -344,7 +350,15 @@ void TMXMapInfo::startElement(void* /*ctx*/, const char* name, const char** atts
     }
     else if (elementName == "tile")
     {
-        if (tmxMapInfo->getParentElement() == TMXPropertyLayer)
+        if (tmxMapInfo->getParentElement() == TMXPropertyChunk)
+        {
+            TMXChunkInfo& chunk = tmxMapInfo->getLayers().back()->_chunks.back();
+            if (_xmlTileIndex < static_cast<int>(chunk._tiles.size()))
+            {
+                chunk._tiles[_xmlTileIndex++] = static_cast<uint32_t>(attributeDict["gid"].asUnsignedInt());
+            }
+        }
+        else if (tmxMapInfo->getParentElement() == TMXPropertyLayer)
         {
             TMXLayerInfo* layer = tmxMapInfo->getLayers().back();
             Vec2 layerSize      = layer->_layerSize;
@@ -438,10 +452,17 @@ void TMXMapInfo::startElement(void* /*ctx*/, const char* name, const char** atts
         std::string encoding    = attributeDict["encoding"].asString();
         std::string compression = attributeDict["compression"].asString();
 
+        // each layer may use its own encoding
+        tmxMapInfo->setLayerAttribs(TMXLayerAttribNone);
+
         if (encoding == "")
         {
             tmxMapInfo->setLayerAttribs(tmxMapInfo->getLayerAttribs() | TMXLayerAttribNone);
 
+            // the tiles of infinite maps are stored in chunks
+            if (tmxMapInfo->isInfinite())
+                return;
+
             TMXLayerInfo* layer = tmxMapInfo->getLayers().back();
             Vec2 layerSize      = layer->_layerSize;
             int tilesAmount     = static_cast<int>(layerSize.width * layerSize.height);
@@ -478,6 +499,29 @@ void TMXMapInfo::startElement(void* /*ctx*/, const char* name, const char** atts
             tmxMapInfo->setStoringCharacters(true);
         }
     }
+    else if (elementName == "chunk")
+    {
+        TMXLayerInfo* layer = tmxMapInfo->getLayers().back();
+
+        TMXChunkInfo chunk;
+        chunk._x        = attributeDict["x"].asInt();
+        chunk._y        = attributeDict["y"].asInt();
+        chunk._width    = attributeDict["width"].asInt();
+        chunk._height   = attributeDict["height"].asInt();
+        chunk._encoding = tmxMapInfo->getLayerAttribs();
+        if (!(chunk._encoding & (TMXLayerAttribBase64 | TMXLayerAttribCSV)))
+        {
+            chunk._tiles.resize(chunk._width * chunk._height);
+            _xmlTileIndex = 0;
+        }
+        layer->_chunks.emplace_back(std::move(chunk));
+
+        // text between chunks is not part of any chunk
+        tmxMapInfo->setCurrentString("");
+
+        // The parent element is now "chunk"
+        tmxMapInfo->setParentElement(TMXPropertyChunk);
+    }
     else if (elementName == "object")
     {
         TMXObjectGroup* objectGroup = tmxMapInfo->getObjectGroups().back();
@@ -683,90 +727,20 @@ void TMXMapInfo::endElement(void* /*ctx*/, const char* name)
 
     if (elementName == "data")
     {
-        if (tmxMapInfo->getLayerAttribs() & TMXLayerAttribBase64)
+        TMXLayerInfo* layer = tmxMapInfo->getLayers().back();
+        if (!layer->_chunks.empty())
         {
             tmxMapInfo->setStoringCharacters(false);
-
-            TMXLayerInfo* layer = tmxMapInfo->getLayers().back();
-            auto currentString = tmxMapInfo->getCurrentString();
-
-            unsigned char* buffer;
-            auto len = utils::base64Decode((unsigned char*)currentString.data(), (unsigned int)currentString.length(),
-                                           &buffer);
-            if (!buffer)
-            {
-                AXLOG("axmol: TiledMap: decode data error");
-                return;
-            }
-
-            if (tmxMapInfo->getLayerAttribs() & (TMXLayerAttribGzip | TMXLayerAttribZlib))
-            {
-                unsigned char* deflated = nullptr;
-                Vec2 s                  = layer->_layerSize;
-                // int sizeHint = s.width * s.height * sizeof(uint32_t);
-                ssize_t sizeHint = s.width * s.height * sizeof(unsigned int);
-
-                ssize_t AX_UNUSED inflatedLen = ZipUtils::inflateMemoryWithHint(buffer, len, &deflated, sizeHint);
-                AXASSERT(inflatedLen == sizeHint, "inflatedLen should be equal to sizeHint!");
-
-                free(buffer);
-                buffer = nullptr;
-
-                if (!deflated)
-                {
-                    AXLOG("axmol: TiledMap: inflate data error");
-                    return;
-                }
-
-                layer->_tiles = reinterpret_cast<uint32_t*>(deflated);
-            }
-            else
-            {
-                layer->_tiles = reinterpret_cast<uint32_t*>(buffer);
-            }
-
             tmxMapInfo->setCurrentString("");
+            finishChunkedLayer(layer);
         }
-        else if (tmxMapInfo->getLayerAttribs() & TMXLayerAttribCSV)
+        else if (tmxMapInfo->getLayerAttribs() & (TMXLayerAttribBase64 | TMXLayerAttribCSV))
         {
-            unsigned char* buffer;
-
-            TMXLayerInfo* layer = tmxMapInfo->getLayers().back();
-
             tmxMapInfo->setStoringCharacters(false);
-            auto currentString = tmxMapInfo->getCurrentString();
-
-            std::vector<std::string> gidTokens;
-            std::stringstream filestr;
-            filestr << currentString;
-            std::string sRow;
-            while (std::getline(filestr, sRow, '\n'))
-            {
-                std::string sGID;
-                std::istringstream rowstr(sRow);
-                while (std::getline(rowstr, sGID, ','))
-                {
-                    gidTokens.emplace_back(sGID);
-                }
-            }
-
-            // 32-bits per gid
-            buffer = (unsigned char*)malloc(gidTokens.size() * 4);
-            if (!buffer)
-            {
-                AXLOG("axmol: TiledMap: CSV buffer not allocated.");
-                return;
-            }
-
-            uint32_t* bufferPtr = reinterpret_cast<uint32_t*>(buffer);
-            for (const auto& gidToken : gidTokens)
-            {
-                auto tileGid = (uint32_t)strtoul(gidToken.c_str(), nullptr, 10);
-                *bufferPtr   = tileGid;
-                bufferPtr++;
-            }
 
-            layer->_tiles = reinterpret_cast<uint32_t*>(buffer);
+            Vec2 s        = layer->_layerSize;
+            layer->_tiles = decodeTileData(tmxMapInfo->getCurrentString(), tmxMapInfo->getLayerAttribs(),
+                                           static_cast<ssize_t>(s.width * s.height));
 
             tmxMapInfo->setCurrentString("");
         }
@@ -775,6 +749,19 @@ void TMXMapInfo::endElement(void* /*ctx*/, const char* name)
             _xmlTileIndex = 0;
         }
     }
+    else if (elementName == "chunk")
+    {
+        TMXChunkInfo& chunk = tmxMapInfo->getLayers().back()->_chunks.back();
+        if (chunk._encoding & (TMXLayerAttribBase64 | TMXLayerAttribCSV))
+        {
+            chunk._payload = std::move(_currentString);
+            tmxMapInfo->setCurrentString("");
+        }
+        _xmlTileIndex = 0;
+
+        // back to the "layer"
+        tmxMapInfo->setParentElement(TMXPropertyLayer);
+    }
     else if (elementName == "map")
     {
         // The map element has ended
@@ -808,15 +795,367 @@ void TMXMapInfo::endElement(void* /*ctx*/, const char* name)
 void TMXMapInfo::textHandler(void* /*ctx*/, const char* ch, size_t len)
 {
     TMXMapInfo* tmxMapInfo = this;
-    std::string text(ch, 0, len);
-    text = std::regex_replace(text, std::regex("[\n\r ]"), "");
 
     if (tmxMapInfo->isStoringCharacters())
     {
-        std::string currentString{tmxMapInfo->getCurrentString()};
-        currentString += text;
-        tmxMapInfo->setCurrentString(currentString);
+        // append in place, big layers are delivered in many pieces
+        _currentString.reserve(_currentString.size() + len);
+        std::copy_if(ch, ch + len, std::back_inserter(_currentString),
+                     [](char c) { return c != '\n' && c != '\r' && c != ' '; });
+    }
+}
+
+uint32_t* TMXMapInfo::decodeTileData(std::string_view data, int layerAttribs, ssize_t tilesAmount)
+{
+    if (layerAttribs & TMXLayerAttribBase64)
+    {
+        unsigned char* buffer;
+        auto len = utils::base64Decode((unsigned char*)data.data(), (unsigned int)data.length(), &buffer);
+        if (!buffer)
+        {
+            AXLOG("axmol: TiledMap: decode data error");
+            return nullptr;
+        }
+
+        const ssize_t expectedLen = tilesAmount * sizeof(uint32_t);
+        if (layerAttribs & (TMXLayerAttribGzip | TMXLayerAttribZlib))
+        {
+            unsigned char* deflated = nullptr;
+
+            ssize_t inflatedLen = ZipUtils::inflateMemoryWithHint(buffer, len, &deflated, expectedLen);
+
+            free(buffer);
+            buffer = nullptr;
+
+            if (!deflated)
+            {
+                AXLOG("axmol: TiledMap: inflate data error");
+                return nullptr;
+            }
+
+            buffer = deflated;
+            len    = static_cast<int>(inflatedLen);
+        }
+
+        // a short buffer would be read past its end by the callers
+        if (static_cast<ssize_t>(len) != expectedLen)
+        {
+            AXLOG("axmol: TiledMap: decoded %d bytes of tile data, expected %d", static_cast<int>(len),
+                  static_cast<int>(expectedLen));
+            free(buffer);
+            return nullptr;
+        }
+
+        return reinterpret_cast<uint32_t*>(buffer);
+    }
+
+    if (layerAttribs & TMXLayerAttribCSV)
+    {
+        // 32-bits per gid
+        auto tiles = (uint32_t*)calloc(tilesAmount, sizeof(uint32_t));
+        if (!tiles)
+        {
+            AXLOG("axmol: TiledMap: CSV buffer not allocated.");
+            return nullptr;
+        }
+
+        const char* p   = data.data();
+        const char* end = p + data.length();
+        for (ssize_t i = 0; p < end && i < tilesAmount; ++i)
+        {
+            char* tokenEnd = nullptr;
+            tiles[i]       = (uint32_t)strtoul(p, &tokenEnd, 10);
+            p              = std::find(static_cast<const char*>(tokenEnd), end, ',');
+            if (p != end)
+                ++p;
+        }
+
+        return tiles;
+    }
+
+    return nullptr;
+}
+
+bool TMXMapInfo::decodeChunk(std::string_view cookedFile, const TMXChunkInfo& chunk, std::vector<uint32_t>& tiles)
+{
+    const auto tilesAmount = static_cast<ssize_t>(chunk._width) * chunk._height;
+
+    if (!chunk._tiles.empty())
+    {
+        tiles = chunk._tiles;
+        return true;
+    }
+
+    if (chunk._cookedSize > 0)
+    {
+        auto fs = FileUtils::getInstance()->openFileStream(cookedFile, IFileStream::Mode::READ);
+        if (!fs || fs->seek(chunk._cookedOffset, SEEK_SET) < 0)
+        {
+            AXLOG("axmol: TiledMap: can't read cooked chunk from %s", cookedFile.data());
+            return false;
+        }
+
+        std::vector<char> compressed(chunk._cookedSize);
+        if (fs->read(compressed.data(), chunk._cookedSize) != static_cast<int>(chunk._cookedSize))
+            return false;
+
+        auto inflated = ZipUtils::decompressGZ(compressed.data(), compressed.size(),
+                                               static_cast<int>(tilesAmount * sizeof(uint32_t)));
+        if (inflated.size() != tilesAmount * sizeof(uint32_t))
+        {
+            AXLOG("axmol: TiledMap: inflate cooked chunk error");
+            return false;
+        }
+
+        tiles.resize(tilesAmount);
+        memcpy(tiles.data(), inflated.data(), inflated.size());
+        return true;
+    }
+
+    auto decoded = decodeTileData(chunk._payload, chunk._encoding, tilesAmount);
+    if (!decoded)
+        return false;
+
+    tiles.assign(decoded, decoded + tilesAmount);
+    free(decoded);
+    return true;
+}
+
+void TMXMapInfo::finishChunkedLayer(TMXLayerInfo* layer)
+{
+    if (layer->_cookedFile.empty())
+    {
+        if (layer->_chunks.empty())
+            return;
+
+        int minX = INT_MAX, minY = INT_MAX, maxX = INT_MIN, maxY = INT_MIN;
+        for (auto&& chunk : layer->_chunks)
+        {
+            minX = std::min(minX, chunk._x);
+            minY = std::min(minY, chunk._y);
+            maxX = std::max(maxX, chunk._x + chunk._width);
+            maxY = std::max(maxY, chunk._y + chunk._height);
+        }
+
+        layer->_chunkOrigin.set(static_cast<float>(minX), static_cast<float>(minY));
+        layer->_layerSize.set(static_cast<float>(maxX - minX), static_cast<float>(maxY - minY));
+        layer->_chunkSize.set(static_cast<float>(layer->_chunks.front()._width),
+                              static_cast<float>(layer->_chunks.front()._height));
+    }
+
+    if (_chunkStreaming)
+        return;
+
+    // not streaming, decode all chunks into one tile array like a fixed size layer
+    const int layerWidth  = static_cast<int>(layer->_layerSize.width);
+    const int layerHeight = static_cast<int>(layer->_layerSize.height);
+    const int originX     = static_cast<int>(layer->_chunkOrigin.x);
+    const int originY     = static_cast<int>(layer->_chunkOrigin.y);
+
+    auto tiles = (uint32_t*)calloc(static_cast<size_t>(layerWidth) * layerHeight, sizeof(uint32_t));
+    if (!tiles)
+    {
+        AXLOG("axmol: TiledMap: can't allocate %dx%d tiles of layer %s", layerWidth, layerHeight,
+              layer->_name.c_str());
+        return;
+    }
+
+    std::vector<uint32_t> chunkTiles;
+    for (auto&& chunk : layer->_chunks)
+    {
+        if (!decodeChunk(layer->_cookedFile, chunk, chunkTiles))
+            continue;
+
+        for (int y = 0; y < chunk._height; ++y)
+        {
+            auto dst = tiles + (chunk._y - originY + y) * layerWidth + (chunk._x - originX);
+            memcpy(dst, chunkTiles.data() + y * chunk._width, chunk._width * sizeof(uint32_t));
+        }
+    }
+
+    if (layer->_ownTiles && layer->_tiles)
+        free(layer->_tiles);
+    layer->_tiles    = tiles;
+    layer->_ownTiles = true;
+    std::vector<TMXChunkInfo>{}.swap(layer->_chunks);
+    layer->_cookedFile.clear();
+}
+
+/*
+ * Cooked map file layout, integers are stored big endian by yasio::obstream:
+ *   "AXTC", uint32 version, uint32 index size
+ *   index: uint32 layer count, per layer:
+ *     name, int32 origin x/y, int32 size width/height, int32 chunk width/height, uint32 chunk count, per chunk:
+ *       int32 x, y, width, height, uint32 offset (relative to the end of the index), uint32 size
+ *   gzip compressed little endian gids of each chunk
+ */
+static const char COOKED_MAP_SIGNATURE[4] = {'A', 'X', 'T', 'C'};
+static const uint32_t COOKED_MAP_VERSION  = 1;
+static const uint32_t COOKED_MAP_HEADER_SIZE = sizeof(COOKED_MAP_SIGNATURE) + sizeof(uint32_t) * 2;
+
+bool TMXMapInfo::writeCookedChunks(std::string_view cookedFile, int chunkSize)
+{
+    AXASSERT(chunkSize > 0, "TMX: invalid chunk size");
+
+    yasio::obstream index;
+    yasio::obstream payloads;
+    std::vector<uint32_t> chunkTiles;
+
+    index.write<uint32_t>(static_cast<uint32_t>(_layers.size()));
+    for (auto&& layer : _layers)
+    {
+        std::vector<TMXChunkInfo> chunks;
+        if (!layer->_chunks.empty())
+        {
+            chunks = layer->_chunks;
+        }
+        else if (layer->_tiles)
+        {
+            // split fixed size layers into chunks, leaving out the empty ones
+            const int layerWidth  = static_cast<int>(layer->_layerSize.width);
+            const int layerHeight = static_cast<int>(layer->_layerSize.height);
+            for (int cy = 0; cy < layerHeight; cy += chunkSize)
+            {
+                for (int cx = 0; cx < layerWidth; cx += chunkSize)
+                {
+                    TMXChunkInfo chunk;
+                    chunk._x      = cx;
+                    chunk._y      = cy;
+                    chunk._width  = std::min(chunkSize, layerWidth - cx);
+                    chunk._height = std::min(chunkSize, layerHeight - cy);
+                    chunk._tiles.resize(chunk._width * chunk._height);
+
+                    bool empty = true;
+                    for (int y = 0; y < chunk._height; ++y)
+                    {
+                        auto src = layer->_tiles + (cy + y) * layerWidth + cx;
+                        std::copy(src, src + chunk._width, chunk._tiles.begin() + y * chunk._width);
+                        empty = empty && std::all_of(src, src + chunk._width, [](uint32_t gid) { return gid == 0; });
+                    }
+
+                    if (!empty)
+                        chunks.emplace_back(std::move(chunk));
+                }
+            }
+        }
+
+        const Vec2 layerChunkSize = layer->_chunks.empty() ? Vec2((float)chunkSize, (float)chunkSize) : layer->_chunkSize;
+
+        index.write_v(layer->_name);
+        index.write<int32_t>(static_cast<int32_t>(layer->_chunkOrigin.x));
+        index.write<int32_t>(static_cast<int32_t>(layer->_chunkOrigin.y));
+        index.write<int32_t>(static_cast<int32_t>(layer->_layerSize.width));
+        index.write<int32_t>(static_cast<int32_t>(layer->_layerSize.height));
+        index.write<int32_t>(static_cast<int32_t>(layerChunkSize.width));
+        index.write<int32_t>(static_cast<int32_t>(layerChunkSize.height));
+        index.write<uint32_t>(static_cast<uint32_t>(chunks.size()));
+        for (auto&& chunk : chunks)
+        {
+            if (!decodeChunk(layer->_cookedFile, chunk, chunkTiles))
+            {
+                AXLOG("axmol: TiledMap: can't cook chunk %d,%d of layer %s", chunk._x, chunk._y, layer->_name.c_str());
+                return false;
+            }
+
+            auto compressed = ZipUtils::compressGZ(chunkTiles.data(), chunkTiles.size() * sizeof(uint32_t));
+
+            index.write<int32_t>(chunk._x);
+            index.write<int32_t>(chunk._y);
+            index.write<int32_t>(chunk._width);
+            index.write<int32_t>(chunk._height);
+            index.write<uint32_t>(static_cast<uint32_t>(payloads.length()));
+            index.write<uint32_t>(static_cast<uint32_t>(compressed.size()));
+            payloads.write_bytes(compressed.data(), static_cast<int>(compressed.size()));
+        }
+    }
+
+    yasio::obstream obs;
+    obs.write_bytes(COOKED_MAP_SIGNATURE, sizeof(COOKED_MAP_SIGNATURE));
+    obs.write<uint32_t>(COOKED_MAP_VERSION);
+    obs.write<uint32_t>(static_cast<uint32_t>(index.length()));
+    obs.write_bytes(index.data(), static_cast<int>(index.length()));
+    obs.write_bytes(payloads.data(), static_cast<int>(payloads.length()));
+
+    return FileUtils::writeBinaryToFile(obs.data(), obs.length(), cookedFile);
+}
+
+bool TMXMapInfo::loadCookedChunks(std::string_view cookedFile)
+{
+    auto fullPath = FileUtils::getInstance()->fullPathForFilename(cookedFile);
+    auto fs       = FileUtils::getInstance()->openFileStream(fullPath, IFileStream::Mode::READ);
+    if (!fs)
+    {
+        AXLOG("axmol: TiledMap: can't open cooked map %s", fullPath.c_str());
+        return false;
+    }
+
+    char header[COOKED_MAP_HEADER_SIZE];
+    if (fs->read(header, COOKED_MAP_HEADER_SIZE) != static_cast<int>(COOKED_MAP_HEADER_SIZE) ||
+        memcmp(header, COOKED_MAP_SIGNATURE, sizeof(COOKED_MAP_SIGNATURE)) != 0)
+    {
+        AXLOG("axmol: TiledMap: %s is not a cooked map", fullPath.c_str());
+        return false;
+    }
+
+    yasio::ibstream_view headerStream(header + sizeof(COOKED_MAP_SIGNATURE), COOKED_MAP_HEADER_SIZE - sizeof(COOKED_MAP_SIGNATURE));
+    auto version   = headerStream.read<uint32_t>();
+    auto indexSize = headerStream.read<uint32_t>();
+    if (version != COOKED_MAP_VERSION)
+    {
+        AXLOG("axmol: TiledMap: unsupported cooked map version %u", version);
+        return false;
     }
+
+    std::string indexData(indexSize, '\0');
+    if (fs->read(&indexData.front(), indexSize) != static_cast<int>(indexSize))
+        return false;
+
+    const uint32_t payloadBase = COOKED_MAP_HEADER_SIZE + indexSize;
+
+    yasio::ibstream_view ibs(indexData.data(), indexData.size());
+    auto layerCount = ibs.read<uint32_t>();
+    for (uint32_t i = 0; i < layerCount; ++i)
+    {
+        auto name = ibs.read_v();
+        Vec2 origin, size, chunkSize;
+        origin.x         = static_cast<float>(ibs.read<int32_t>());
+        origin.y         = static_cast<float>(ibs.read<int32_t>());
+        size.width       = static_cast<float>(ibs.read<int32_t>());
+        size.height      = static_cast<float>(ibs.read<int32_t>());
+        chunkSize.width  = static_cast<float>(ibs.read<int32_t>());
+        chunkSize.height = static_cast<float>(ibs.read<int32_t>());
+
+        std::vector<TMXChunkInfo> chunks(ibs.read<uint32_t>());
+        for (auto&& chunk : chunks)
+        {
+            chunk._x            = ibs.read<int32_t>();
+            chunk._y            = ibs.read<int32_t>();
+            chunk._width        = ibs.read<int32_t>();
+            chunk._height       = ibs.read<int32_t>();
+            chunk._cookedOffset = payloadBase + ibs.read<uint32_t>();
+            chunk._cookedSize   = ibs.read<uint32_t>();
+        }
+
+        auto it = std::find_if(_layers.begin(), _layers.end(),
+                               [&name](TMXLayerInfo* layer) { return layer->_name == name; });
+        if (it == _layers.end())
+            continue;
+
+        auto layer = *it;
+        if (layer->_ownTiles && layer->_tiles)
+            free(layer->_tiles);
+        layer->_tiles       = nullptr;
+        layer->_ownTiles    = true;
+        layer->_chunks      = std::move(chunks);
+        layer->_chunkOrigin = origin;
+        layer->_layerSize   = size;
+        layer->_chunkSize   = chunkSize;
+        layer->_cookedFile  = fullPath;
+
+        finishChunkedLayer(layer);
+    }
+
+    return true;
 }
 
 TMXTileAnimFrame::TMXTileAnimFrame(uint32_t tileID, float duration) : _tileID(tileID), _duration(duration) {}
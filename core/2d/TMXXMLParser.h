@@ -39,6 +39,7 @@ THE SOFTWARE.
 #include "2d/TMXObjectGroup.h"  // needed for Vector<TMXObjectGroup*> for binding
 
 #include <string>
+#include <vector>
 
 NS_AX_BEGIN
 
@@ -75,7 +76,8 @@ enum
     TMXPropertyObjectGroup,
     TMXPropertyObject,
     TMXPropertyTile,
-    TMXPropertyAnimation
+    TMXPropertyAnimation,
+    TMXPropertyChunk
 };
 
 typedef enum TMXTileFlags_
@@ -168,6 +170,31 @@ struct AX_DLL TMXTileAnimInfo : public Ref
     std::vector<TMXTileAnimFrame> _frames;
 };
 
+/** @brief TMXChunkInfo contains the information about a chunk of a layer like:
+- Chunk origin and size in tiles
+- The still encoded tile data, or where to read it from a cooked map file
+
+Chunks come from the <chunk> elements of Tiled "infinite" maps, or from a cooked map file.
+*/
+struct AX_DLL TMXChunkInfo
+{
+    /** origin of the chunk in tiles, as stored in the TMX file (may be negative) */
+    int _x = 0;
+    int _y = 0;
+    /** size of the chunk in tiles */
+    int _width  = 0;
+    int _height = 0;
+    /** TMXLayerAttrib flags of the encoded payload */
+    int _encoding = TMXLayerAttribNone;
+    /** base64/csv encoded tile data, empty for xml encoded or cooked chunks */
+    std::string _payload;
+    /** decoded tile data of xml encoded chunks */
+    std::vector<uint32_t> _tiles;
+    /** byte range of the compressed tile data in the cooked map file */
+    uint32_t _cookedOffset = 0;
+    uint32_t _cookedSize   = 0;
+};
+
 // Bits on the far end of the 32-bit global tile ID (GID's) are used for tile flags
 
 /** @brief TMXLayerInfo contains the information about the layers like:
@@ -202,6 +229,15 @@ public:
     unsigned char _opacity;
     bool _ownTiles;
     Vec2 _offset;
+
+    /** chunks of the layer, only kept when the map is loaded with chunk streaming */
+    std::vector<TMXChunkInfo> _chunks;
+    /** tile coordinate of the top-left corner of the chunk bounds, _layerSize is the size of these bounds */
+    Vec2 _chunkOrigin;
+    /** size of the layer chunks in tiles */
+    Vec2 _chunkSize;
+    /** full path of the cooked map file the chunk data is read from, empty if kept in _chunks */
+    std::string _cookedFile;
 };
 
 /** @brief TMXTilesetInfo contains the information about the tilesets like:
@@ -260,8 +296,13 @@ This information is obtained from the TMX file.
 class AX_DLL TMXMapInfo : public Ref, public SAXDelegator
 {
 public:
-    /** creates a TMX Format with a tmx file */
-    static TMXMapInfo* create(std::string_view tmxFile);
+    /** creates a TMX Format with a tmx file
+     *
+     * @param tmxFile The tmx file.
+     * @param chunkStreaming Keep the chunks of infinite map layers encoded so they can be streamed in by
+     * FastTMXLayer, instead of decoding them into one tile array per layer.
+     */
+    static TMXMapInfo* create(std::string_view tmxFile, bool chunkStreaming = false);
     /** creates a TMX Format with an XML string and a TMX resource path */
     static TMXMapInfo* createWithXML(std::string_view tmxString, std::string_view resourcePath);
 
@@ -276,7 +317,7 @@ public:
     virtual ~TMXMapInfo();
 
     /** initializes a TMX format with a  tmx file */
-    bool initWithTMXFile(std::string_view tmxFile);
+    bool initWithTMXFile(std::string_view tmxFile, bool chunkStreaming = false);
     /** initializes a TMX format with an XML string and a TMX resource path */
     bool initWithXML(std::string_view tmxString, std::string_view resourcePath);
     /** initializes parsing of an XML file, either a tmx (Map) file or tsx (Tileset) file */
@@ -287,6 +328,38 @@ public:
     ValueMapIntKey& getTileProperties() { return _tileProperties; };
     void setTileProperties(const ValueMapIntKey& tileProperties) { _tileProperties = tileProperties; }
 
+    /** Decodes base64 (optionally gzip/zlib compressed) or csv encoded tile data.
+     * Safe to call from any thread.
+     *
+     * @return The malloc'ed tiles, to be freed by the caller, or nullptr on error or if the data does not hold
+     * exactly tilesAmount tiles.
+     */
+    static uint32_t* decodeTileData(std::string_view data, int layerAttribs, ssize_t tilesAmount);
+
+    /** Decodes the tiles of a chunk, reading them from cookedFile if the chunk was loaded from a cooked map.
+     * Safe to call from any thread.
+     */
+    static bool decodeChunk(std::string_view cookedFile, const TMXChunkInfo& chunk, std::vector<uint32_t>& tiles);
+
+    /** Writes the tile data of all layers to a cooked map file.
+     * The cooked file stores each layer as gzip compressed chunks which can be read individually,
+     * fixed size layers are split into chunks of chunkSize tiles.
+     */
+    bool writeCookedChunks(std::string_view cookedFile, int chunkSize = 32);
+
+    /** Replaces the tile data of the layers with the chunks of a cooked map file, matching layers by name.
+     * Only the chunk index is read, the chunk data is read when a chunk is decoded.
+     */
+    bool loadCookedChunks(std::string_view cookedFile);
+
+    /// whether the map is an infinite map which stores its layers as chunks
+    bool isInfinite() const { return _infinite; }
+    void setInfinite(bool infinite) { _infinite = infinite; }
+
+    /// whether the chunks of infinite layers are kept encoded for streaming
+    bool isChunkStreaming() const { return _chunkStreaming; }
+    void setChunkStreaming(bool chunkStreaming) { _chunkStreaming = chunkStreaming; }
+
     /// map orientation
     int getOrientation() const { return _orientation; }
     void setOrientation(int orientation) { _orientation = orientation; }
@@ -372,6 +445,8 @@ public:
 
 protected:
     void internalInit(std::string_view tmxFileName, std::string_view resourcePath);
+    /* computes the chunk bounds of a layer and, unless streaming, decodes its chunks into one tile array */
+    void finishChunkedLayer(TMXLayerInfo* layer);
 
     /// map orientation
     int _orientation;
@@ -415,6 +490,8 @@ protected:
     int _currentFirstGID;
     bool _recordFirstGID;
     std::string _externalTilesetFilename;
+    bool _infinite       = false;
+    bool _chunkStreaming = false;
 };
 
 // end of tilemap_parallax_nodes group
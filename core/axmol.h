@@ -49,15 +49,20 @@ THE SOFTWARE.
 #include "base/Director.h"
 #include "base/IMEDelegate.h"
 #include "base/IMEDispatcher.h"
+#include "base/JobSystem.h"
 #include "base/Map.h"
 #include "base/NS.h"
 #include "base/Profiling.h"
 #include "base/Properties.h"
 #include "base/Ref.h"
+#include "base/AllocationCounter.h"
+#include "base/RefAllocator.h"
+#include "base/FrameProfiler.h"
 #include "base/RefPtr.h"
 #include "base/Scheduler.h"
 #include "base/UserDefault.h"
 #include "base/Value.h"
+#include "base/ValueDocument.h"
 #include "base/Vector.h"
 #include "base/ZipUtils.h"
 #include "base/base64.h"
@@ -120,6 +125,7 @@ THE SOFTWARE.
 #include "2d/DrawNode.h"
 #include "2d/FontFNT.h"
 #include "2d/FontFreeType.h"
+#include "2d/IncrementalLoader.h"
 #include "2d/Label.h"
 #include "2d/LabelAtlas.h"
 #include "2d/Layer.h"
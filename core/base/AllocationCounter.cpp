@@ -0,0 +1,85 @@
+/****************************************************************************
+ Copyright (c) 2022 Bytedance Inc.
+
+ https://axmolengine.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "base/AllocationCounter.h"
+#include "base/Config.h"
+
+#if AX_ENABLE_ALLOCATION_COUNTER
+#    include <stdlib.h>
+#    include <new>
+#endif
+
+namespace
+{
+// Nesting depth of the live scopes and allocations counted on this thread
+thread_local int s_scopeDepth    = 0;
+thread_local int64_t s_allocated = 0;
+}  // namespace
+
+#if AX_ENABLE_ALLOCATION_COUNTER
+
+void* operator new(std::size_t size)
+{
+    if (s_scopeDepth > 0)
+        ++s_allocated;
+    if (void* p = ::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    ::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    ::free(p);
+}
+
+#endif
+
+NS_AX_BEGIN
+
+AllocationCounter::Scope::Scope() : _start(s_allocated)
+{
+    ++s_scopeDepth;
+}
+
+AllocationCounter::Scope::~Scope()
+{
+    --s_scopeDepth;
+}
+
+int64_t AllocationCounter::Scope::getCount() const
+{
+    return s_allocated - _start;
+}
+
+bool AllocationCounter::isAvailable()
+{
+    return AX_ENABLE_ALLOCATION_COUNTER != 0;
+}
+
+NS_AX_END
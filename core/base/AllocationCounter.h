@@ -0,0 +1,72 @@
+/****************************************************************************
+ Copyright (c) 2022 Bytedance Inc.
+
+ https://axmolengine.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "platform/PlatformMacros.h"
+
+#include <stdint.h>
+
+/**
+ * @addtogroup base
+ * @{
+ */
+NS_AX_BEGIN
+
+/**
+ * @class AllocationCounter
+ * @brief Debug hook counting the heap allocations made by the calling thread inside a scope.
+ *
+ * Only available when the engine is built with AX_ENABLE_ALLOCATION_COUNTER set to 1, in which case the engine
+ * provides the global operator new and counts every allocation made by a thread while it has a Scope alive.
+ * Threads without a live Scope only pay a thread local check.
+ * @js NA
+ */
+class AX_DLL AllocationCounter
+{
+public:
+    /** Counts the allocations of the calling thread between its construction and destruction. Scopes may nest. */
+    class AX_DLL Scope
+    {
+    public:
+        Scope();
+        ~Scope();
+
+        Scope(const Scope&)            = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        /** Allocations made by the calling thread since the scope was constructed, 0 if not available. */
+        int64_t getCount() const;
+
+    private:
+        int64_t _start;
+    };
+
+    /** Whether the engine was built with AX_ENABLE_ALLOCATION_COUNTER. */
+    static bool isAvailable();
+};
+
+NS_AX_END
+// end of base group
+/** @} */
@@ -246,6 +246,16 @@ THE SOFTWARE.
 #    define AX_ENABLE_PROFILERS 0
 #endif
 
+/** @def AX_ENABLE_FRAME_PROFILER
+ * If enabled, the AX_PROFILER_ZONE scopes placed in the engine and in user code are recorded by FrameProfiler, which
+ * keeps the last frames and exports them as a Chrome trace. When disabled FrameProfiler, the zones and the "profiler"
+ * console command compile to nothing.
+ * Disabled by default.
+ */
+#ifndef AX_ENABLE_FRAME_PROFILER
+#    define AX_ENABLE_FRAME_PROFILER 0
+#endif
+
 /** Enable Lua engine debug log. */
 #ifndef AX_LUA_ENGINE_DEBUG
 #    define AX_LUA_ENGINE_DEBUG 0
@@ -360,6 +370,24 @@ THE SOFTWARE.
 #    define AX_META_TEXTURES 2
 #endif
 
+/** @def AX_ENABLE_REF_POOL
+ * If enabled, Ref and its subclasses are allocated by RefAllocator, a size class pool with thread local caches,
+ * and the allocation tracking mode of RefAllocator becomes available.
+ * Disabled by default.
+ */
+#ifndef AX_ENABLE_REF_POOL
+#    define AX_ENABLE_REF_POOL 0
+#endif
+
+/** @def AX_ENABLE_ALLOCATION_COUNTER
+ * If enabled, the engine provides the global operator new and AllocationCounter::Scope counts the heap allocations
+ * made by a thread inside the scope. Meant for debug and benchmark builds.
+ * Disabled by default.
+ */
+#ifndef AX_ENABLE_ALLOCATION_COUNTER
+#    define AX_ENABLE_ALLOCATION_COUNTER 0
+#endif
+
 /// @name namespace ax
 /// @{
 #ifdef __cplusplus
@@ -48,9 +48,12 @@
 #include "base/Scheduler.h"
 #include "platform/PlatformConfig.h"
 #include "base/Configuration.h"
+#include "base/RefAllocator.h"
+#include "base/FrameProfiler.h"
 #include "2d/Scene.h"
 #include "platform/FileUtils.h"
 #include "renderer/TextureCache.h"
+#include "renderer/Renderer.h"
 #include "base/Utils.h"
 #include "base/UTF8.h"
 
@@ -484,7 +487,11 @@ Console::Console()
     createCommandFileUtils();
     createCommandFps();
     createCommandHelp();
+#if AX_ENABLE_FRAME_PROFILER
+    createCommandProfiler();
+#endif
     createCommandProjection();
+    createCommandRenderer();
     createCommandResolution();
     createCommandSceneGraph();
     createCommandTexture();
@@ -968,8 +975,12 @@ void Console::addClient()
 
 void Console::createCommandAllocator()
 {
-    addCommand({"allocator", "Display allocator diagnostics for all allocators. Args: [-h | help | ]",
+    addCommand({"allocator", "Display Ref allocator diagnostics. Args: [-h | help | track on/off | pool on/off | ]",
                 AX_CALLBACK_2(Console::commandAllocator, this)});
+    addSubCommand("allocator", {"track", "track on/off: report the top allocating types of each frame.",
+                                AX_CALLBACK_2(Console::commandAllocatorSubCommandTrack, this)});
+    addSubCommand("allocator", {"pool", "pool on/off: serve new Ref allocations from the pool or from malloc.",
+                                AX_CALLBACK_2(Console::commandAllocatorSubCommandPool, this)});
 }
 
 void Console::createCommandConfig()
@@ -1035,6 +1046,23 @@ void Console::createCommandHelp()
     addCommand({"help", "Print this message. Args: [ ]", AX_CALLBACK_2(Console::commandHelp, this)});
 }
 
+#if AX_ENABLE_FRAME_PROFILER
+void Console::createCommandProfiler()
+{
+    addCommand({"profiler",
+                "Record the frame profiler zones. Args: [-h | help | on | off | save [path] | dump [frames] | ]",
+                AX_CALLBACK_2(Console::commandProfiler, this)});
+    addSubCommand("profiler", {"on", "start recording the zones of every frame.",
+                               AX_CALLBACK_2(Console::commandProfilerSubCommandOnOff, this)});
+    addSubCommand("profiler",
+                  {"off", "stop recording.", AX_CALLBACK_2(Console::commandProfilerSubCommandOnOff, this)});
+    addSubCommand("profiler", {"save", "save [path]: write the recorded frames as a Chrome trace file.",
+                               AX_CALLBACK_2(Console::commandProfilerSubCommandSave, this)});
+    addSubCommand("profiler", {"dump", "dump [frames]: send the last recorded frames as a Chrome trace.",
+                               AX_CALLBACK_2(Console::commandProfilerSubCommandDump, this)});
+}
+#endif
+
 void Console::createCommandProjection()
 {
     addCommand({"projection", "Change or print the current projection. Args: [-h | help | 2d | 3d | ]",
@@ -1045,6 +1073,14 @@ void Console::createCommandProjection()
                                  AX_CALLBACK_2(Console::commandProjectionSubCommand3d, this)});
 }
 
+void Console::createCommandRenderer()
+{
+    addCommand({"renderer", "Print the render statistics of the last frames. Args: [-h | help | reset | ]",
+                AX_CALLBACK_2(Console::commandRenderer, this)});
+    addSubCommand("renderer", {"reset", "Discards the statistics of the previous frames.",
+                               AX_CALLBACK_2(Console::commandRendererSubCommandReset, this)});
+}
+
 void Console::createCommandResolution()
 {
     addCommand({"resolution",
@@ -1092,13 +1128,31 @@ void Console::createCommandVersion()
 
 void Console::commandAllocator(socket_native_type fd, std::string_view /*args*/)
 {
-#if AX_ENABLE_ALLOCATOR_DIAGNOSTICS
-    auto info = allocator::AllocatorDiagnostics::instance()->diagnostics();
-    Console::Utility::mydprintf(fd, info.c_str());
-#else
-    Console::Utility::mydprintf(
-        fd, "allocator diagnostics not available. AX_ENABLE_ALLOCATOR_DIAGNOSTICS must be set to 1 in ccConfig.h\n");
-#endif
+    Console::Utility::mydprintf(fd, "%s", RefAllocator::getDiagnostics().c_str());
+}
+
+void Console::commandAllocatorSubCommandTrack(socket_native_type fd, std::string_view args)
+{
+    if (!RefAllocator::isAvailable())
+    {
+        Console::Utility::mydprintf(fd, "%s", RefAllocator::getDiagnostics().c_str());
+        return;
+    }
+    auto pos   = args.find(' ');
+    bool state = pos == std::string_view::npos || args.substr(pos + 1) != "off";
+    RefAllocator::setTrackingEnabled(state);
+}
+
+void Console::commandAllocatorSubCommandPool(socket_native_type fd, std::string_view args)
+{
+    if (!RefAllocator::isAvailable())
+    {
+        Console::Utility::mydprintf(fd, "%s", RefAllocator::getDiagnostics().c_str());
+        return;
+    }
+    auto pos   = args.find(' ');
+    bool state = pos == std::string_view::npos || args.substr(pos + 1) != "off";
+    RefAllocator::setPoolEnabled(state);
 }
 
 void Console::commandConfig(socket_native_type fd, std::string_view /*args*/)
@@ -1188,6 +1242,56 @@ void Console::commandHelp(socket_native_type fd, std::string_view /*args*/)
     sendHelp(fd, _commands, "\nAvailable commands:\n");
 }
 
+#if AX_ENABLE_FRAME_PROFILER
+void Console::commandProfiler(socket_native_type fd, std::string_view /*args*/)
+{
+    Scheduler* sched = Director::getInstance()->getScheduler();
+    sched->runOnAxmolThread([=]() {
+        auto profiler = FrameProfiler::getInstance();
+        Console::Utility::mydprintf(fd, "Frame profiler is: %s, %d/%d frames recorded\n",
+                                    profiler->isEnabled() ? "on" : "off", profiler->getFrameCount(),
+                                    profiler->getFrameCapacity());
+        Console::Utility::sendPrompt(fd);
+    });
+}
+
+void Console::commandProfilerSubCommandOnOff(socket_native_type /*fd*/, std::string_view args)
+{
+    bool state       = (args.compare("on") == 0);
+    Scheduler* sched = Director::getInstance()->getScheduler();
+    sched->runOnAxmolThread([state]() { FrameProfiler::getInstance()->setEnabled(state); });
+}
+
+void Console::commandProfilerSubCommandSave(socket_native_type fd, std::string_view args)
+{
+    auto argv = Console::Utility::split(args, ' ');
+    std::string path =
+        argv.size() > 1 ? argv[1] : FileUtils::getInstance()->getWritablePath() + "frame_profile.json";
+
+    Scheduler* sched = Director::getInstance()->getScheduler();
+    sched->runOnAxmolThread([=]() {
+        if (FrameProfiler::getInstance()->saveChromeTrace(path))
+            Console::Utility::mydprintf(fd, "Chrome trace saved to: %s\n", path.c_str());
+        else
+            Console::Utility::mydprintf(fd, "Failed to write: %s\n", path.c_str());
+        Console::Utility::sendPrompt(fd);
+    });
+}
+
+void Console::commandProfilerSubCommandDump(socket_native_type fd, std::string_view args)
+{
+    auto argv      = Console::Utility::split(args, ' ');
+    int frameCount = argv.size() > 1 ? atoi(argv[1].c_str()) : -1;
+
+    Scheduler* sched = Director::getInstance()->getScheduler();
+    sched->runOnAxmolThread([=]() {
+        auto trace = FrameProfiler::getInstance()->toChromeTrace(frameCount);
+        Console::Utility::sendToConsole(fd, trace.c_str(), trace.length());
+        Console::Utility::sendPrompt(fd);
+    });
+}
+#endif
+
 void Console::commandProjection(socket_native_type fd, std::string_view /*args*/)
 {
     auto director = Director::getInstance();
@@ -1226,6 +1330,22 @@ void Console::commandProjectionSubCommand3d(socket_native_type /*fd*/, std::stri
     sched->runOnAxmolThread([=]() { director->setProjection(Director::Projection::_3D); });
 }
 
+void Console::commandRenderer(socket_native_type fd, std::string_view /*args*/)
+{
+    Scheduler* sched = Director::getInstance()->getScheduler();
+    sched->runOnAxmolThread([=]() {
+        auto report = Director::getInstance()->getRenderer()->getStatsReport();
+        Console::Utility::sendToConsole(fd, report.c_str(), report.length());
+        Console::Utility::sendPrompt(fd);
+    });
+}
+
+void Console::commandRendererSubCommandReset(socket_native_type /*fd*/, std::string_view /*args*/)
+{
+    Scheduler* sched = Director::getInstance()->getScheduler();
+    sched->runOnAxmolThread([]() { Director::getInstance()->getRenderer()->clearStatsHistory(); });
+}
+
 void Console::commandResolution(socket_native_type /*fd*/, std::string_view args)
 {
     int policy;
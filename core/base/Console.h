@@ -235,7 +235,11 @@ protected:
     void createCommandFileUtils();
     void createCommandFps();
     void createCommandHelp();
+#if AX_ENABLE_FRAME_PROFILER
+    void createCommandProfiler();
+#endif
     void createCommandProjection();
+    void createCommandRenderer();
     void createCommandResolution();
     void createCommandSceneGraph();
     void createCommandTexture();
@@ -245,6 +249,8 @@ protected:
 
     // Add commands here
     void commandAllocator(socket_native_type fd, std::string_view args);
+    void commandAllocatorSubCommandTrack(socket_native_type fd, std::string_view args);
+    void commandAllocatorSubCommandPool(socket_native_type fd, std::string_view args);
     void commandConfig(socket_native_type fd, std::string_view args);
     void commandDebugMsg(socket_native_type fd, std::string_view args);
     void commandDebugMsgSubCommandOnOff(socket_native_type fd, std::string_view args);
@@ -259,9 +265,17 @@ protected:
     void commandFps(socket_native_type fd, std::string_view args);
     void commandFpsSubCommandOnOff(socket_native_type fd, std::string_view args);
     void commandHelp(socket_native_type fd, std::string_view args);
+#if AX_ENABLE_FRAME_PROFILER
+    void commandProfiler(socket_native_type fd, std::string_view args);
+    void commandProfilerSubCommandOnOff(socket_native_type fd, std::string_view args);
+    void commandProfilerSubCommandSave(socket_native_type fd, std::string_view args);
+    void commandProfilerSubCommandDump(socket_native_type fd, std::string_view args);
+#endif
     void commandProjection(socket_native_type fd, std::string_view args);
     void commandProjectionSubCommand2d(socket_native_type fd, std::string_view args);
     void commandProjectionSubCommand3d(socket_native_type fd, std::string_view args);
+    void commandRenderer(socket_native_type fd, std::string_view args);
+    void commandRendererSubCommandReset(socket_native_type fd, std::string_view args);
     void commandResolution(socket_native_type fd, std::string_view args);
     void commandResolutionSubCommandEmpty(socket_native_type fd, std::string_view args);
     void commandSceneGraph(socket_native_type fd, std::string_view args);
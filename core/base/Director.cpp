@@ -58,6 +58,9 @@ THE SOFTWARE.
 #include "base/AutoreleasePool.h"
 #include "base/Configuration.h"
 #include "base/AsyncTaskPool.h"
+#include "base/JobSystem.h"
+#include "base/RefAllocator.h"
+#include "base/FrameProfiler.h"
 #include "base/ObjectFactory.h"
 #include "platform/Application.h"
 #include "audio/AudioEngine.h"
@@ -1026,6 +1029,10 @@ void Director::reset()
     SpriteFrameCache::destroyInstance();
     FileUtils::destroyInstance();
     AsyncTaskPool::destroyInstance();
+    JobSystem::destroyInstance();
+#if AX_ENABLE_FRAME_PROFILER
+    FrameProfiler::destroyInstance();
+#endif
     backend::ProgramManager::destroyInstance();
 
     // axmol specific data structures
@@ -1504,10 +1511,19 @@ void Director::mainLoop()
     }
     else if (!_invalid)
     {
-        drawScene();
+        {
+            AX_PROFILER_ZONE("Director::mainLoop");
+
+            drawScene();
 
-        // release the objects
-        PoolManager::getInstance()->getCurrentPool()->clear();
+            // release the objects
+            PoolManager::getInstance()->getCurrentPool()->clear();
+        }
+
+#if AX_ENABLE_REF_POOL
+        RefAllocator::endFrame();
+#endif
+        AX_PROFILER_FRAME();
     }
 }
 
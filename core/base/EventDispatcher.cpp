@@ -24,6 +24,7 @@
  ****************************************************************************/
 #include "base/EventDispatcher.h"
 #include <algorithm>
+#include <tuple>
 
 #include "base/EventCustom.h"
 #include "base/EventListenerTouch.h"
@@ -32,6 +33,9 @@
 #include "base/EventListenerKeyboard.h"
 #include "base/EventListenerCustom.h"
 #include "base/EventListenerFocus.h"
+#include "base/EventSpatialIndex.h"
+#include "base/EventTouch.h"
+#include "base/Touch.h"
 #if (AX_TARGET_PLATFORM == AX_PLATFORM_ANDROID || AX_TARGET_PLATFORM == AX_PLATFORM_IOS || \
      AX_TARGET_PLATFORM == AX_PLATFORM_MAC || AX_TARGET_PLATFORM == AX_PLATFORM_LINUX ||   \
      AX_TARGET_PLATFORM == AX_PLATFORM_WIN32)
@@ -40,6 +44,7 @@
 #include "2d/Scene.h"
 #include "base/Director.h"
 #include "base/EventType.h"
+#include "base/FrameProfiler.h"
 #include "2d/Camera.h"
 #include "2d/ProtectedNode.h"
 
@@ -192,7 +197,13 @@ void EventDispatcher::EventListenerVector::clear()
     clearFixedListeners();
 }
 
-EventDispatcher::EventDispatcher() : _inDispatch(0), _isEnabled(false), _nodePriorityIndex(0)
+EventDispatcher::EventDispatcher()
+    : _touchSpatialIndex(nullptr)
+    , _inDispatch(0)
+    , _isEnabled(false)
+    , _touchSpatialIndexEnabled(false)
+    , _touchListenerRanksDirty(true)
+    , _nodePriorityIndex(0)
 {
     _toAddedListeners.reserve(50);
     _toRemovedListeners.reserve(50);
@@ -210,6 +221,7 @@ EventDispatcher::~EventDispatcher()
     // so removeAllEventListeners would clean internal custom listeners.
     _internalCustomListenerIDs.clear();
     removeAllEventListeners();
+    AX_SAFE_DELETE(_touchSpatialIndex);
 }
 
 void EventDispatcher::visitTarget(Node* node, bool isRootNode)
@@ -400,6 +412,11 @@ void EventDispatcher::resumeEventListenersForTarget(Node* target, bool recursive
 
     setDirtyForNode(target);
 
+    if (target->_touchBoundsIndexed)
+    {
+        setBoundsDirtyForNode(target);
+    }
+
     if (recursive)
     {
         const auto& children = target->getChildren();
@@ -416,6 +433,8 @@ void EventDispatcher::removeEventListenersForTarget(Node* target, bool recursive
     // Don't want any dangling pointers or the possibility of dealing with deleted objects..
     _nodePriorityMap.erase(target);
     _dirtyNodes.erase(target);
+    _boundsDirtyNodes.erase(target);
+    _transformDirtyNodes.erase(target);
 
     auto listenerIter = _nodeListenersMap.find(target);
     if (listenerIter != _nodeListenersMap.end())
@@ -494,8 +513,16 @@ void EventDispatcher::dissociateNodeAndEventListener(Node* node, EventListener*
         {
             _nodeListenersMap.erase(found);
             delete listeners;
+
+            node->_touchBoundsIndexed = false;
+            _boundsDirtyNodes.erase(node);
         }
     }
+
+    if (_touchSpatialIndex)
+    {
+        _touchSpatialIndex->remove(listener);
+    }
 }
 
 void EventDispatcher::addEventListener(EventListener* listener)
@@ -549,6 +576,18 @@ void EventDispatcher::forceAddEventListener(EventListener* listener)
         {
             listener->setPaused(true);
         }
+
+        if (_touchSpatialIndexEnabled)
+        {
+            _dirtySceneGraphListeners.insert(listener);
+
+            if (listener->getType() == EventListener::Type::TOUCH_ONE_BY_ONE &&
+                static_cast<EventListenerTouchOneByOne*>(listener)->isBoundedByNode())
+            {
+                node->_touchBoundsIndexed = true;
+                setBoundsDirtyForNode(node);
+            }
+        }
     }
     else
     {
@@ -860,7 +899,9 @@ void EventDispatcher::dispatchEventToListeners(EventListenerVector* listeners,
 }
 
 void EventDispatcher::dispatchTouchEventToListeners(EventListenerVector* listeners,
-                                                    const std::function<bool(EventListener*)>& onEvent)
+                                                    const std::function<bool(EventListener*)>& onEvent,
+                                                    EventTouch* event /* = nullptr */,
+                                                    Touch* touch /* = nullptr */)
 {
     bool shouldStopPropagation       = false;
     auto fixedPriorityListeners      = listeners->getFixedPriorityListeners();
@@ -895,13 +936,25 @@ void EventDispatcher::dispatchTouchEventToListeners(EventListenerVector* listene
             // priority == 0, scene graph priority
 
             // first, get all enabled, unPaused and registered listeners
+            // one by one touch listeners are looked up per camera in the spatial index instead, see
+            // collectTouchCandidates
+            bool useSpatialIndex   = _touchSpatialIndexEnabled && touch != nullptr;
+            bool hasSceneListeners = false;
             std::vector<EventListener*> sceneListeners;
-            for (auto&& l : *sceneGraphPriorityListeners)
-            {
-                if (l->isEnabled() && !l->isPaused() && l->isRegistered())
+            std::vector<EventListener*> candidates;
+            auto collectSceneListeners = [&]() {
+                hasSceneListeners = true;
+                for (auto&& l : *sceneGraphPriorityListeners)
                 {
-                    sceneListeners.emplace_back(l);
+                    if (l->isEnabled() && !l->isPaused() && l->isRegistered())
+                    {
+                        sceneListeners.emplace_back(l);
+                    }
                 }
+            };
+            if (!useSpatialIndex)
+            {
+                collectSceneListeners();
             }
             // second, for all camera call all listeners
             // get a copy of cameras, prevent it's been modified in listener callback
@@ -917,7 +970,21 @@ void EventDispatcher::dispatchTouchEventToListeners(EventListenerVector* listene
 
                 Camera::_visitingCamera = camera;
                 auto cameraFlag         = (unsigned short)camera->getCameraFlag();
-                for (auto&& l : sceneListeners)
+
+                auto cameraListeners = &sceneListeners;
+                if (useSpatialIndex)
+                {
+                    if (collectTouchCandidates(*sceneGraphPriorityListeners, camera, event, touch, candidates))
+                    {
+                        cameraListeners = &candidates;
+                    }
+                    else if (!hasSceneListeners)
+                    {
+                        collectSceneListeners();
+                    }
+                }
+
+                for (auto&& l : *cameraListeners)
                 {
                     if (nullptr == l->getAssociatedNode() ||
                         0 == (l->getAssociatedNode()->getCameraMask() & cameraFlag))
@@ -959,8 +1026,156 @@ void EventDispatcher::dispatchTouchEventToListeners(EventListenerVector* listene
     }
 }
 
+bool EventDispatcher::collectTouchCandidates(const std::vector<EventListener*>& sceneGraphListeners,
+                                             const Camera* camera,
+                                             EventTouch* event,
+                                             Touch* touch,
+                                             std::vector<EventListener*>& candidates)
+{
+    candidates.clear();
+
+    if (event->getEventCode() != EventTouch::EventCode::BEGAN)
+    {
+        // Only the listeners which claimed a touch handle the following events
+        for (auto&& l : sceneGraphListeners)
+        {
+            if (!static_cast<EventListenerTouchOneByOne*>(l)->_claimedTouches.empty() && l->isEnabled() &&
+                !l->isPaused() && l->isRegistered())
+            {
+                candidates.emplace_back(l);
+            }
+        }
+        return true;
+    }
+
+    // Locate the touch on the z = 0 plane the indexed bounds lie on
+    const auto& location = touch->getLocation();
+    Vec3 nearPoint       = camera->unprojectGL(Vec3(location.x, location.y, -1));
+    Vec3 farPoint        = camera->unprojectGL(Vec3(location.x, location.y, 1));
+    float deltaZ         = farPoint.z - nearPoint.z;
+    if (std::abs(deltaZ) < FLT_EPSILON)
+        return false;
+
+    float t = -nearPoint.z / deltaZ;
+    Vec2 point(nearPoint.x + (farPoint.x - nearPoint.x) * t, nearPoint.y + (farPoint.y - nearPoint.y) * t);
+
+    updateTouchSpatialIndex();
+
+    _touchSpatialIndex->query(point, candidates);
+    candidates.insert(candidates.end(), _unboundedTouchListeners.begin(), _unboundedTouchListeners.end());
+
+    auto last = std::remove_if(candidates.begin(), candidates.end(), [this](EventListener* l) {
+        return !l->isEnabled() || l->isPaused() || !l->isRegistered() ||
+               _touchListenerRanks.find(l) == _touchListenerRanks.end();
+    });
+    candidates.erase(last, candidates.end());
+
+    std::sort(candidates.begin(), candidates.end(), [this](EventListener* l1, EventListener* l2) {
+        return _touchListenerRanks[l1] < _touchListenerRanks[l2];
+    });
+
+    return true;
+}
+
+void EventDispatcher::updateTouchSpatialIndex()
+{
+    // A moved node moves the bounds of its whole subtree, the subtree of a moved ancestor already covers it
+    std::vector<Node*> subtree;
+    for (auto&& node : _transformDirtyNodes)
+    {
+        bool covered = false;
+        for (auto parent = node->getParent(); parent != nullptr && !covered; parent = parent->getParent())
+            covered = _transformDirtyNodes.find(parent) != _transformDirtyNodes.end();
+        if (covered)
+            continue;
+
+        subtree.emplace_back(node);
+        while (!subtree.empty())
+        {
+            auto n = subtree.back();
+            subtree.pop_back();
+            if (n->_touchBoundsIndexed)
+                _boundsDirtyNodes.insert(n);
+            subtree.insert(subtree.end(), n->getChildren().begin(), n->getChildren().end());
+            if (auto protectedNode = dynamic_cast<ProtectedNode*>(n))
+            {
+                const auto& children = protectedNode->getProtectedChildren();
+                subtree.insert(subtree.end(), children.begin(), children.end());
+            }
+        }
+    }
+    _transformDirtyNodes.clear();
+
+    for (auto&& node : _boundsDirtyNodes)
+    {
+        indexNodeBounds(node);
+    }
+    _boundsDirtyNodes.clear();
+
+    if (_touchListenerRanksDirty)
+    {
+        _touchListenerRanksDirty = false;
+        _touchListenerRanks.clear();
+        _unboundedTouchListeners.clear();
+
+        auto listeners = getListeners(EventListenerTouchOneByOne::LISTENER_ID);
+        if (listeners && listeners->getSceneGraphPriorityListeners())
+        {
+            size_t rank = 0;
+            for (auto&& l : *listeners->getSceneGraphPriorityListeners())
+            {
+                _touchListenerRanks.emplace(l, rank++);
+                if (!static_cast<EventListenerTouchOneByOne*>(l)->isBoundedByNode())
+                {
+                    _unboundedTouchListeners.emplace_back(l);
+                }
+            }
+        }
+    }
+}
+
+void EventDispatcher::indexNodeBounds(Node* node)
+{
+    auto iter = _nodeListenersMap.find(node);
+    if (iter == _nodeListenersMap.end())
+        return;
+
+    // Bounded listeners don't claim touches while their node is hidden
+    bool visible = node->isVisible();
+    bool planar  = false;
+    Rect bounds;
+    if (visible)
+    {
+        auto transform = node->getNodeToWorldTransform();
+        // The content is only a rect of the z = 0 plane if the transform doesn't depend on z
+        planar = transform.m[2] == 0 && transform.m[6] == 0 && transform.m[14] == 0;
+        if (planar)
+        {
+            bounds = RectApplyTransform(Rect(Vec2::ZERO, node->getContentSize()), transform);
+        }
+    }
+
+    for (auto&& l : *iter->second)
+    {
+        if (l->getType() != EventListener::Type::TOUCH_ONE_BY_ONE ||
+            !static_cast<EventListenerTouchOneByOne*>(l)->isBoundedByNode())
+            continue;
+
+        if (visible)
+        {
+            _touchSpatialIndex->update(l, planar ? &bounds : nullptr);
+        }
+        else
+        {
+            _touchSpatialIndex->remove(l);
+        }
+    }
+}
+
 void EventDispatcher::dispatchEvent(Event* event)
 {
+    AX_PROFILER_ZONE("EventDispatcher::dispatchEvent");
+
     if (!_isEnabled)
         return;
 
@@ -978,11 +1193,6 @@ void EventDispatcher::dispatchEvent(Event* event)
 
     sortEventListeners(listenerID);
 
-    auto pfnDispatchEventToListeners = &EventDispatcher::dispatchEventToListeners;
-    if (event->getType() == Event::Type::MOUSE)
-    {
-        pfnDispatchEventToListeners = &EventDispatcher::dispatchTouchEventToListeners;
-    }
     auto iter = _listenerMap.find(listenerID);
     if (iter != _listenerMap.end())
     {
@@ -994,7 +1204,14 @@ void EventDispatcher::dispatchEvent(Event* event)
             return event->isStopped();
         };
 
-        (this->*pfnDispatchEventToListeners)(listeners, onEvent);
+        if (event->getType() == Event::Type::MOUSE)
+        {
+            dispatchTouchEventToListeners(listeners, onEvent);
+        }
+        else
+        {
+            dispatchEventToListeners(listeners, onEvent);
+        }
     }
 
     updateListeners(event);
@@ -1129,7 +1346,7 @@ void EventDispatcher::dispatchTouchEvent(EventTouch* event)
             };
 
             //
-            dispatchTouchEventToListeners(oneByOneListeners, onTouchEvent);
+            dispatchTouchEventToListeners(oneByOneListeners, onTouchEvent, event, touches);
             if (event->isStopped())
             {
                 return;
@@ -1328,6 +1545,10 @@ void EventDispatcher::updateDirtyFlagForSceneGraph()
                 for (auto&& l : *iter->second)
                 {
                     setDirty(l->getListenerID(), DirtyFlag::SCENE_GRAPH_PRIORITY);
+                    if (_touchSpatialIndexEnabled)
+                    {
+                        _dirtySceneGraphListeners.insert(l);
+                    }
                 }
             }
         }
@@ -1382,6 +1603,14 @@ void EventDispatcher::sortEventListenersOfSceneGraphPriority(std::string_view li
     if (sceneGraphListeners == nullptr)
         return;
 
+    if (listenerID == EventListenerTouchOneByOne::LISTENER_ID)
+    {
+        _touchListenerRanksDirty = true;
+    }
+
+    if (_touchSpatialIndexEnabled && sortEventListenersOfSceneGraphPriorityIncrementally(sceneGraphListeners, rootNode))
+        return;
+
     // Reset priority index
     _nodePriorityIndex = 0;
     _nodePriorityMap.clear();
@@ -1404,6 +1633,138 @@ void EventDispatcher::sortEventListenersOfSceneGraphPriority(std::string_view li
 #endif
 }
 
+bool EventDispatcher::sortEventListenersOfSceneGraphPriorityIncrementally(
+    std::vector<EventListener*>* sceneGraphListeners,
+    Node* rootNode)
+{
+    size_t dirtyCount = 0;
+    for (auto&& l : *sceneGraphListeners)
+    {
+        if (_dirtySceneGraphListeners.find(l) != _dirtySceneGraphListeners.end())
+            ++dirtyCount;
+    }
+
+    if (dirtyCount == 0)
+        return true;
+
+    // Visiting the scene graph once is cheaper than moving most of the listeners one by one
+    if (dirtyCount * 4 > sceneGraphListeners->size())
+    {
+        for (auto&& l : *sceneGraphListeners)
+        {
+            _dirtySceneGraphListeners.erase(l);
+        }
+        return false;
+    }
+
+    // The position of a node in the traversal of visitTarget, from the root node down to the node itself. Children are
+    // grouped as: local z < 0, protected local z < 0, the node itself, local z >= 0, protected local z >= 0.
+    struct VisitKey
+    {
+        float globalZ;
+        bool inScene;
+        std::vector<std::tuple<int, std::int32_t, std::uint32_t>> path;
+    };
+    std::unordered_map<Node*, VisitKey> visitKeys;
+
+    auto getVisitKey = [&](Node* node) -> const VisitKey& {
+        auto iter = visitKeys.find(node);
+        if (iter != visitKeys.end())
+            return iter->second;
+
+        auto& key   = visitKeys[node];
+        key.globalZ = node->getGlobalZOrder();
+        key.path.emplace_back(2, 0, 0);
+
+        auto child = node;
+        for (auto parent = node->getParent(); parent != nullptr; child = parent, parent = parent->getParent())
+        {
+            int group            = child->_localZOrder < 0 ? 0 : 3;
+            auto protectedParent = dynamic_cast<ProtectedNode*>(parent);
+            if (protectedParent && protectedParent->getProtectedChildren().contains(child))
+                ++group;
+            key.path.emplace_back(group, child->_localZOrder, child->_orderOfArrival);
+        }
+        std::reverse(key.path.begin(), key.path.end());
+        key.inScene = child == rootNode;
+        return key;
+    };
+
+    // Same order as the full sort: higher priority first, nodes out of the running scene last
+    auto hasHigherPriority = [&](EventListener* l1, EventListener* l2) {
+        auto n1 = l1->getAssociatedNode();
+        auto n2 = l2->getAssociatedNode();
+        if (n1 == nullptr)
+            return false;
+        const auto& k1 = getVisitKey(n1);
+        if (!k1.inScene)
+            return false;
+        if (n2 == nullptr)
+            return true;
+        const auto& k2 = getVisitKey(n2);
+        if (!k2.inScene)
+            return true;
+        if (k1.globalZ != k2.globalZ)
+            return k1.globalZ > k2.globalZ;
+        return k2.path < k1.path;
+    };
+
+    std::vector<EventListener*> movedListeners;
+    movedListeners.reserve(dirtyCount);
+
+    auto last = sceneGraphListeners->begin();
+    for (auto&& l : *sceneGraphListeners)
+    {
+        if (_dirtySceneGraphListeners.erase(l) != 0)
+            movedListeners.emplace_back(l);
+        else
+            *last++ = l;
+    }
+    sceneGraphListeners->erase(last, sceneGraphListeners->end());
+
+    for (auto&& l : movedListeners)
+    {
+        auto pos = std::upper_bound(sceneGraphListeners->begin(), sceneGraphListeners->end(), l, hasHigherPriority);
+        sceneGraphListeners->insert(pos, l);
+    }
+
+    // Keep the node priorities of the full sort in step: the nodes of these listeners take back their values in the
+    // new order, nodes which joined the scene get new ones and nodes which left it lose theirs
+    for (auto&& l : movedListeners)
+    {
+        auto node = l->getAssociatedNode();
+        if (node != nullptr && !getVisitKey(node).inScene)
+            _nodePriorityMap.erase(node);
+    }
+
+    std::vector<Node*> nodes;
+    std::vector<int> priorities;
+    std::unordered_set<Node*> visited;
+    for (auto&& l : *sceneGraphListeners)
+    {
+        auto node = l->getAssociatedNode();
+        if (node == nullptr || !visited.insert(node).second)
+            continue;
+
+        auto iter = _nodePriorityMap.find(node);
+        if (iter != _nodePriorityMap.end())
+            priorities.emplace_back(iter->second);
+        else if (visitKeys.find(node) != visitKeys.end() && visitKeys[node].inScene)
+            priorities.emplace_back(++_nodePriorityIndex);
+        else
+            continue;
+        nodes.emplace_back(node);
+    }
+
+    std::sort(priorities.begin(), priorities.end(), std::greater<int>());
+    for (size_t i = 0; i < nodes.size(); ++i)
+    {
+        _nodePriorityMap[nodes[i]] = priorities[i];
+    }
+
+    return true;
+}
+
 void EventDispatcher::sortEventListenersOfFixedPriority(std::string_view listenerID)
 {
     auto listeners = getListeners(listenerID);
@@ -1590,6 +1951,63 @@ bool EventDispatcher::isEnabled() const
     return _isEnabled;
 }
 
+void EventDispatcher::setTouchSpatialIndexEnabled(bool enabled)
+{
+    if (_touchSpatialIndexEnabled == enabled)
+        return;
+
+    _touchSpatialIndexEnabled = enabled;
+    _touchListenerRanksDirty  = true;
+    _dirtySceneGraphListeners.clear();
+    _boundsDirtyNodes.clear();
+    _transformDirtyNodes.clear();
+    _touchListenerRanks.clear();
+    _unboundedTouchListeners.clear();
+
+    if (enabled)
+    {
+        if (_touchSpatialIndex == nullptr)
+        {
+            _touchSpatialIndex = new EventSpatialIndex();
+        }
+
+        // Sorts requested before the dirty listeners were recorded have to visit the whole scene graph
+        for (const auto& e : _listenerMap)
+        {
+            auto dirtyIter           = _priorityDirtyFlagMap.find(e.first);
+            auto sceneGraphListeners = e.second->getSceneGraphPriorityListeners();
+            if (sceneGraphListeners && dirtyIter != _priorityDirtyFlagMap.end() &&
+                ((int)dirtyIter->second & (int)DirtyFlag::SCENE_GRAPH_PRIORITY))
+            {
+                _dirtySceneGraphListeners.insert(sceneGraphListeners->begin(), sceneGraphListeners->end());
+            }
+        }
+    }
+    else if (_touchSpatialIndex)
+    {
+        _touchSpatialIndex->clear();
+    }
+
+    for (const auto& e : _nodeListenersMap)
+    {
+        auto node                 = e.first;
+        node->_touchBoundsIndexed = false;
+        if (!enabled)
+            continue;
+
+        for (auto&& l : *e.second)
+        {
+            if (l->getType() == EventListener::Type::TOUCH_ONE_BY_ONE &&
+                static_cast<EventListenerTouchOneByOne*>(l)->isBoundedByNode())
+            {
+                node->_touchBoundsIndexed = true;
+                setBoundsDirtyForNode(node);
+                break;
+            }
+        }
+    }
+}
+
 void EventDispatcher::setDirtyForNode(Node* node)
 {
     // Mark the node dirty only when there is an eventlistener associated with it.
@@ -1686,6 +2104,11 @@ void EventDispatcher::releaseListener(EventListener* listener)
         sEngine->releaseScriptObject(this, listener);
     }
 #endif  // AX_ENABLE_GC_FOR_NATIVE_OBJECTS
+    if (_touchSpatialIndexEnabled)
+    {
+        _dirtySceneGraphListeners.erase(listener);
+        _touchListenerRanksDirty = true;
+    }
     AX_SAFE_RELEASE(listener);
 }
 
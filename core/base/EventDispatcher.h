@@ -31,6 +31,7 @@
 #include <unordered_map>
 #include <vector>
 #include <set>
+#include <unordered_set>
 
 #include "platform/PlatformMacros.h"
 #include "base/EventListener.h"
@@ -46,6 +47,9 @@ NS_AX_BEGIN
 
 class Event;
 class EventTouch;
+class EventSpatialIndex;
+class Camera;
+class Touch;
 class Node;
 class EventCustom;
 class EventListenerCustom;
@@ -162,6 +166,22 @@ public:
      */
     bool isEnabled() const;
 
+    /** Whether to index the bounds of one by one touch listeners with scene graph priority.
+     * When enabled, a began touch is only offered to the listeners whose node contains it, for the listeners
+     * declared with EventListenerTouchOneByOne::setBoundedByNode, and the scene graph priority of listeners is
+     * re-sorted only for the nodes which changed instead of walking the whole scene graph.
+     * Disabled by default.
+     *
+     * @param enabled True to enable the spatial index.
+     */
+    void setTouchSpatialIndexEnabled(bool enabled);
+
+    /** Checks whether the touch spatial index is enabled.
+     *
+     * @return True if the touch spatial index is enabled.
+     */
+    bool isTouchSpatialIndexEnabled() const { return _touchSpatialIndexEnabled; }
+
     /////////////////////////////////////////////
 
     /** Dispatches the event.
@@ -212,6 +232,14 @@ protected:
     /** Sets the dirty flag for a node. */
     void setDirtyForNode(Node* node);
 
+    /** Marks the indexed bounds of a node as outdated, they are updated when the next touch begins. */
+    void setBoundsDirtyForNode(Node* node) { _boundsDirtyNodes.insert(node); }
+
+    /** Marks the indexed bounds of a node and its descendants as outdated after the transform of the node changed,
+     * they are updated when the next touch begins. Visits update the bounds too, this covers the changes made since.
+     */
+    void setTransformDirtyForNode(Node* node) { _transformDirtyNodes.insert(node); }
+
     /**
      *  The vector to store event listeners with scene graph based priority and fixed priority.
      */
@@ -266,6 +294,11 @@ protected:
     /** Sorts the listeners of specified type by scene graph priority */
     void sortEventListenersOfSceneGraphPriority(std::string_view listenerID, Node* rootNode);
 
+    /** Moves the listeners of the dirty nodes to their new scene graph priority, returns false if too many nodes
+     * changed and the whole scene graph needs to be visited instead */
+    bool sortEventListenersOfSceneGraphPriorityIncrementally(std::vector<EventListener*>* sceneGraphListeners,
+                                                              Node* rootNode);
+
     /** Sorts the listeners of specified type by fixed priority */
     void sortEventListenersOfFixedPriority(std::string_view listenerID);
 
@@ -297,7 +330,24 @@ protected:
      *  When listener process touch event, can get current camera by Camera::getVisitingCamera().
      */
     void dispatchTouchEventToListeners(EventListenerVector* listeners,
-                                       const std::function<bool(EventListener*)>& onEvent);
+                                       const std::function<bool(EventListener*)>& onEvent,
+                                       EventTouch* event = nullptr,
+                                       Touch* touch      = nullptr);
+
+    /** Collects the one by one listeners which may claim the touch for the camera, ordered by priority.
+     *  Returns false if the touch can't be located through the spatial index.
+     */
+    bool collectTouchCandidates(const std::vector<EventListener*>& sceneGraphListeners,
+                                const Camera* camera,
+                                EventTouch* event,
+                                Touch* touch,
+                                std::vector<EventListener*>& candidates);
+
+    /** Updates the spatial index from the nodes marked by setBoundsDirtyForNode and setTransformDirtyForNode. */
+    void updateTouchSpatialIndex();
+
+    /** Indexes the bounds of the node for its one by one touch listeners. */
+    void indexNodeBounds(Node* node);
 
     void releaseListener(EventListener* listener);
 
@@ -344,12 +394,33 @@ protected:
     /** The nodes were associated with scene graph based priority listeners */
     std::set<Node*> _dirtyNodes;
 
+    /** The scene graph listeners whose node changed priority, only recorded when the touch spatial index is enabled */
+    std::unordered_set<EventListener*> _dirtySceneGraphListeners;
+
+    /** The bounds of one by one touch listeners */
+    EventSpatialIndex* _touchSpatialIndex;
+
+    /** The nodes whose indexed bounds are outdated */
+    std::unordered_set<Node*> _boundsDirtyNodes;
+
+    /** The nodes whose transform changed, the indexed bounds of their subtree are outdated */
+    std::unordered_set<Node*> _transformDirtyNodes;
+
+    /** The position of one by one touch listeners in the sorted scene graph listeners */
+    std::unordered_map<EventListener*, size_t> _touchListenerRanks;
+
+    /** The one by one touch listeners which aren't bounded by their node, in priority order */
+    std::vector<EventListener*> _unboundedTouchListeners;
+
     /** Whether the dispatcher is dispatching event */
     int _inDispatch;
 
     /** Whether to enable dispatching event */
     bool _isEnabled;
 
+    bool _touchSpatialIndexEnabled;
+    bool _touchListenerRanksDirty;
+
     int _nodePriorityIndex;
 
     std::set<std::string> _internalCustomListenerIDs;
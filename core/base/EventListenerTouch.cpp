@@ -40,6 +40,7 @@ EventListenerTouchOneByOne::EventListenerTouchOneByOne()
     , onTouchEnded(nullptr)
     , onTouchCancelled(nullptr)
     , _needSwallow(false)
+    , _boundedByNode(false)
 {}
 
 EventListenerTouchOneByOne::~EventListenerTouchOneByOne()
@@ -67,6 +68,12 @@ bool EventListenerTouchOneByOne::isSwallowTouches()
     return _needSwallow;
 }
 
+void EventListenerTouchOneByOne::setBoundedByNode(bool boundedByNode)
+{
+    AXASSERT(!_isRegistered, "Can't change the bounds contract of a registered listener.");
+    _boundedByNode = boundedByNode;
+}
+
 EventListenerTouchOneByOne* EventListenerTouchOneByOne::create()
 {
     auto ret = new EventListenerTouchOneByOne();
@@ -108,6 +115,7 @@ EventListenerTouchOneByOne* EventListenerTouchOneByOne::clone()
 
         ret->_claimedTouches = _claimedTouches;
         ret->_needSwallow    = _needSwallow;
+        ret->_boundedByNode  = _boundedByNode;
     }
     else
     {
@@ -69,6 +69,20 @@ public:
      */
     bool isSwallowTouches();
 
+    /** Declares that onTouchBegan only claims touches inside the content bounds of the associated node while the
+     * node is visible, which lets the dispatcher skip the listener through its spatial index.
+     * Must be set before the listener is added to the dispatcher.
+     * @see EventDispatcher::setTouchSpatialIndexEnabled
+     *
+     * @param boundedByNode True if the listener is bounded by its node, false by default.
+     */
+    void setBoundedByNode(bool boundedByNode);
+    /** Whether the listener is bounded by its node.
+     *
+     * @return True if the listener only claims touches inside its node.
+     */
+    bool isBoundedByNode() const { return _boundedByNode; }
+
     /// Overrides
     virtual EventListenerTouchOneByOne* clone() override;
     virtual bool checkAvailable() override;
@@ -89,6 +103,7 @@ public:
 private:
     std::vector<Touch*> _claimedTouches;
     bool _needSwallow;
+    bool _boundedByNode;
 
     friend class EventDispatcher;
 };
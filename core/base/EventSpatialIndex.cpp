@@ -0,0 +1,138 @@
+/****************************************************************************
+ Copyright (c) 2022 Bytedance Inc.
+
+ https://axmolengine.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "base/EventSpatialIndex.h"
+
+#include <algorithm>
+
+NS_AX_BEGIN
+
+EventSpatialIndex::EventSpatialIndex(float cellSize) : _invCellSize(1.0f / cellSize)
+{
+    AXASSERT(cellSize > 0, "Invalid cell size!");
+}
+
+void EventSpatialIndex::update(EventListener* listener, const Rect* bounds)
+{
+    remove(listener);
+
+    Entry entry{0, 0, 0, 0, false};
+    if (bounds)
+    {
+        entry.minX = cellCoord(bounds->getMinX());
+        entry.minY = cellCoord(bounds->getMinY());
+        entry.maxX = cellCoord(bounds->getMaxX());
+        entry.maxY = cellCoord(bounds->getMaxY());
+
+        int64_t cells = static_cast<int64_t>(entry.maxX - entry.minX + 1) * (entry.maxY - entry.minY + 1);
+        entry.bucketed = cells <= MAX_CELLS_PER_ENTRY;
+    }
+
+    if (entry.bucketed)
+    {
+        for (int x = entry.minX; x <= entry.maxX; ++x)
+        {
+            for (int y = entry.minY; y <= entry.maxY; ++y)
+            {
+                _cells[cellKey(x, y)].push_back(Item{listener, *bounds, false});
+            }
+        }
+    }
+    else
+    {
+        _oversized.push_back(Item{listener, bounds ? *bounds : Rect::ZERO, bounds == nullptr});
+    }
+
+    _entries.emplace(listener, entry);
+}
+
+void EventSpatialIndex::remove(EventListener* listener)
+{
+    auto iter = _entries.find(listener);
+    if (iter == _entries.end())
+        return;
+
+    const auto& entry = iter->second;
+    if (entry.bucketed)
+    {
+        for (int x = entry.minX; x <= entry.maxX; ++x)
+        {
+            for (int y = entry.minY; y <= entry.maxY; ++y)
+            {
+                auto cellIter = _cells.find(cellKey(x, y));
+                if (cellIter == _cells.end())
+                    continue;
+
+                eraseItem(cellIter->second, listener);
+                if (cellIter->second.empty())
+                    _cells.erase(cellIter);
+            }
+        }
+    }
+    else
+    {
+        eraseItem(_oversized, listener);
+    }
+
+    _entries.erase(iter);
+}
+
+void EventSpatialIndex::query(const Vec2& point, std::vector<EventListener*>& result) const
+{
+    auto cellIter = _cells.find(cellKey(cellCoord(point.x), cellCoord(point.y)));
+    if (cellIter != _cells.end())
+    {
+        for (const auto& item : cellIter->second)
+        {
+            if (item.bounds.containsPoint(point))
+                result.push_back(item.listener);
+        }
+    }
+
+    for (const auto& item : _oversized)
+    {
+        if (item.unbounded || item.bounds.containsPoint(point))
+            result.push_back(item.listener);
+    }
+}
+
+void EventSpatialIndex::clear()
+{
+    _entries.clear();
+    _cells.clear();
+    _oversized.clear();
+}
+
+void EventSpatialIndex::eraseItem(std::vector<Item>& items, EventListener* listener)
+{
+    auto iter =
+        std::find_if(items.begin(), items.end(), [listener](const Item& item) { return item.listener == listener; });
+    if (iter != items.end())
+    {
+        // Order doesn't matter, the dispatcher sorts the query result by priority.
+        *iter = items.back();
+        items.pop_back();
+    }
+}
+
+NS_AX_END
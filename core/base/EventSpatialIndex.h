@@ -0,0 +1,103 @@
+/****************************************************************************
+ Copyright (c) 2022 Bytedance Inc.
+
+ https://axmolengine.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include "platform/PlatformMacros.h"
+#include "math/Math.h"
+
+NS_AX_BEGIN
+
+class EventListener;
+
+/**
+ * @addtogroup base
+ * @{
+ */
+
+/** @class EventSpatialIndex
+ * @brief A uniform grid of event listener bounds in world space.
+ * Listeners are bucketed by the grid cells their bounds overlap, listeners covering too many cells and listeners
+ * without bounds are kept aside and returned by every query.
+ * @js NA
+ */
+class AX_DLL EventSpatialIndex
+{
+public:
+    /** Listeners overlapping more cells than this are not bucketed. */
+    static constexpr int MAX_CELLS_PER_ENTRY = 64;
+
+    explicit EventSpatialIndex(float cellSize = 128.0f);
+
+    /** Inserts or moves a listener.
+     *
+     * @param listener The listener to index.
+     * @param bounds The world bounds of the listener, nullptr if the listener may claim any point.
+     */
+    void update(EventListener* listener, const Rect* bounds);
+
+    /** Removes a listener, does nothing if the listener isn't indexed. */
+    void remove(EventListener* listener);
+
+    /** Appends the listeners whose bounds contain the point to result, in no particular order. */
+    void query(const Vec2& point, std::vector<EventListener*>& result) const;
+
+    bool contains(EventListener* listener) const { return _entries.find(listener) != _entries.end(); }
+
+    size_t size() const { return _entries.size(); }
+
+    void clear();
+
+protected:
+    struct Item
+    {
+        EventListener* listener;
+        Rect bounds;
+        bool unbounded;
+    };
+
+    struct Entry
+    {
+        int minX, minY, maxX, maxY;
+        bool bucketed;
+    };
+
+    static int64_t cellKey(int x, int y) { return (static_cast<int64_t>(x) << 32) | static_cast<uint32_t>(y); }
+
+    int cellCoord(float v) const { return static_cast<int>(std::floor(v * _invCellSize)); }
+
+    static void eraseItem(std::vector<Item>& items, EventListener* listener);
+
+    float _invCellSize;
+    std::unordered_map<EventListener*, Entry> _entries;
+    std::unordered_map<int64_t, std::vector<Item>> _cells;
+    std::vector<Item> _oversized;
+};
+
+// end of base group
+/// @}
+
+NS_AX_END
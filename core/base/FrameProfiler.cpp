@@ -0,0 +1,306 @@
+/****************************************************************************
+ Copyright (c) 2022 Bytedance Inc.
+
+ https://axmolengine.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include "base/FrameProfiler.h"
+#include "base/format.h"
+#include "platform/FileUtils.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iterator>
+#include <mutex>
+
+#if AX_ENABLE_FRAME_PROFILER
+
+NS_AX_BEGIN
+
+namespace
+{
+struct ThreadBuffer
+{
+    std::mutex mutex;
+    std::vector<FrameProfiler::Zone> zones;  // closed since the last frame
+    std::string name;
+    uint32_t index = 0;
+};
+
+// buffers are never freed, a thread may still close a zone after the profiler was destroyed
+struct ThreadRegistry
+{
+    std::mutex mutex;
+    std::vector<ThreadBuffer*> buffers;
+};
+
+ThreadRegistry& threadRegistry()
+{
+    static ThreadRegistry* registry = new ThreadRegistry();
+    return *registry;
+}
+
+FrameProfiler* s_sharedFrameProfiler = nullptr;
+std::atomic<bool> s_enabled{false};
+
+thread_local ThreadBuffer* t_buffer = nullptr;
+thread_local uint32_t t_depth       = 0;
+
+ThreadBuffer* threadBuffer()
+{
+    if (!t_buffer)
+    {
+        auto buffer    = new ThreadBuffer();
+        auto& registry = threadRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        buffer->index = static_cast<uint32_t>(registry.buffers.size());
+        buffer->name  = fmt::format("Thread {}", buffer->index);
+        registry.buffers.emplace_back(buffer);
+        t_buffer = buffer;
+    }
+    return t_buffer;
+}
+
+void appendJsonString(std::string& out, std::string_view value)
+{
+    out += '"';
+    for (auto c : value)
+    {
+        if (c == '"' || c == '\\')
+            out += '\\';
+        if (static_cast<unsigned char>(c) >= 0x20)
+            out += c;
+    }
+    out += '"';
+}
+}  // namespace
+
+FrameProfiler::ScopedZone::ScopedZone(const char* name)
+{
+    if (s_enabled.load(std::memory_order_relaxed))
+    {
+        _name  = name;
+        _start = now();
+        ++t_depth;
+    }
+    else
+    {
+        _name  = nullptr;
+        _start = 0;
+    }
+}
+
+FrameProfiler::ScopedZone::~ScopedZone()
+{
+    if (!_name)
+        return;
+
+    const auto end = now();
+    --t_depth;
+
+    auto buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock(buffer->mutex);
+    buffer->zones.emplace_back(Zone{_name, _start, end, buffer->index, t_depth});
+}
+
+FrameProfiler* FrameProfiler::getInstance()
+{
+    if (!s_sharedFrameProfiler)
+        s_sharedFrameProfiler = new FrameProfiler();
+    return s_sharedFrameProfiler;
+}
+
+void FrameProfiler::destroyInstance()
+{
+    s_enabled = false;
+    AX_SAFE_DELETE(s_sharedFrameProfiler);
+}
+
+int64_t FrameProfiler::now()
+{
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+FrameProfiler::FrameProfiler()
+{
+    _frames.resize(DEFAULT_FRAME_CAPACITY);
+}
+
+void FrameProfiler::setEnabled(bool enabled)
+{
+    if (enabled && !isEnabled())
+        _frameStart = now();
+    s_enabled = enabled;
+}
+
+bool FrameProfiler::isEnabled() const
+{
+    return s_enabled.load(std::memory_order_relaxed);
+}
+
+void FrameProfiler::setFrameCapacity(int capacity)
+{
+    _frames.clear();
+    _frames.resize(std::max(capacity, 1));
+    clear();
+}
+
+const FrameProfiler::Frame& FrameProfiler::getFrame(int index) const
+{
+    AXASSERT(index >= 0 && index < _frameCount, "invalid frame index");
+    const int capacity = static_cast<int>(_frames.size());
+    return _frames[(_frameHead - _frameCount + index + capacity) % capacity];
+}
+
+void FrameProfiler::clear()
+{
+    _frameHead  = 0;
+    _frameCount = 0;
+}
+
+void FrameProfiler::setThreadName(std::string_view name)
+{
+    auto buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock(threadRegistry().mutex);
+    buffer->name = name;
+}
+
+std::string FrameProfiler::getThreadName(uint32_t threadIndex)
+{
+    auto& registry = threadRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    return threadIndex < registry.buffers.size() ? registry.buffers[threadIndex]->name : std::string{};
+}
+
+void FrameProfiler::endFrame()
+{
+    auto& registry = threadRegistry();
+    if (!isEnabled())
+    {
+        // drop the zones closed while recording was being disabled
+        if (_frameStart != 0)
+        {
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            for (auto buffer : registry.buffers)
+            {
+                std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+                buffer->zones.clear();
+            }
+            _frameStart = 0;
+        }
+        return;
+    }
+
+    const auto time = now();
+    if (!_mainThreadNamed)
+    {
+        setThreadName("Main");
+        _mainThreadIndex = threadBuffer()->index;
+        _mainThreadNamed = true;
+    }
+
+    // the zone vectors of the ring buffer keep their capacity, recording a frame allocates nothing once warm
+    auto& frame = _frames[_frameHead];
+    frame.index = _nextFrame++;
+    frame.start = _frameStart;
+    frame.end   = time;
+    frame.zones.clear();
+    {
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        for (auto buffer : registry.buffers)
+        {
+            std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+            frame.zones.insert(frame.zones.end(), buffer->zones.begin(), buffer->zones.end());
+            buffer->zones.clear();
+        }
+    }
+
+    const int capacity = static_cast<int>(_frames.size());
+    _frameHead         = (_frameHead + 1) % capacity;
+    _frameCount        = std::min(_frameCount + 1, capacity);
+    _frameStart        = time;
+}
+
+std::string FrameProfiler::toChromeTrace(int maxFrames) const
+{
+    const int count = maxFrames < 0 ? _frameCount : std::min(maxFrames, _frameCount);
+    const int first = _frameCount - count;
+
+    // timestamps are exported relative to the first event
+    int64_t origin = count > 0 ? getFrame(first).start : 0;
+    for (int i = first; i < _frameCount; ++i)
+        for (auto&& zone : getFrame(i).zones)
+            origin = std::min(origin, zone.start);
+
+    std::string out;
+    out.reserve(256 + count * 4096);
+    out += "{\"traceEvents\":[";
+
+    bool separator = false;
+    auto& registry = threadRegistry();
+    {
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        for (auto buffer : registry.buffers)
+        {
+            out += separator ? ",\n" : "\n";
+            separator = true;
+            fmt::format_to(std::back_inserter(out),
+                           "{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":{},\"args\":{{\"name\":",
+                           buffer->index);
+            appendJsonString(out, buffer->name);
+            out += "}}";
+        }
+    }
+
+    for (int i = first; i < _frameCount; ++i)
+    {
+        auto& frame = getFrame(i);
+        out += separator ? ",\n" : "\n";
+        separator = true;
+        fmt::format_to(std::back_inserter(out),
+                       "{{\"name\":\"Frame {}\",\"ph\":\"i\",\"s\":\"g\",\"pid\":0,\"tid\":{},\"ts\":{:.3f}}}",
+                       frame.index, _mainThreadIndex, (frame.end - origin) / 1000.0);
+
+        for (auto&& zone : frame.zones)
+        {
+            out += ",\n{\"name\":";
+            appendJsonString(out, zone.name);
+            fmt::format_to(std::back_inserter(out),
+                           ",\"cat\":\"axmol\",\"ph\":\"X\",\"pid\":0,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}",
+                           zone.threadIndex, (zone.start - origin) / 1000.0, (zone.end - zone.start) / 1000.0);
+        }
+    }
+
+    out += "\n],\"displayTimeUnit\":\"ms\"}\n";
+    return out;
+}
+
+bool FrameProfiler::saveChromeTrace(std::string_view filePath, int maxFrames) const
+{
+    return FileUtils::getInstance()->writeStringToFile(toChromeTrace(maxFrames), filePath);
+}
+
+NS_AX_END
+
+#endif
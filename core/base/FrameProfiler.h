@@ -0,0 +1,176 @@
+/****************************************************************************
+ Copyright (c) 2022 Bytedance Inc.
+
+ https://axmolengine.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "platform/PlatformMacros.h"
+
+#include <stdint.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @addtogroup base
+ * @{
+ */
+#if AX_ENABLE_FRAME_PROFILER
+
+NS_AX_BEGIN
+
+/**
+ * @class FrameProfiler
+ * @brief Records nested timing zones of every thread and keeps the last frames in a ring buffer.
+ *
+ * Only compiled when the engine is built with AX_ENABLE_FRAME_PROFILER set to 1, otherwise the class is left out and
+ * AX_PROFILER_ZONE and AX_PROFILER_FRAME expand to nothing. Zones are opened with AX_PROFILER_ZONE and closed at the
+ * end of the enclosing scope, each thread appends the zones it closes to its own buffer. Director closes the frame once
+ * per main loop, the zones closed since the previous frame are then moved to the ring buffer.
+ *
+ * The frames can be exported as a Chrome trace (chrome://tracing, Perfetto), see saveChromeTrace and the "profiler"
+ * console command.
+ * @code
+ * void MyLayer::update(float dt)
+ * {
+ *     AX_PROFILER_ZONE("MyLayer::update");
+ *     ...
+ * }
+ * @endcode
+ * @js NA
+ */
+class AX_DLL FrameProfiler
+{
+public:
+    /** Default number of frames kept by the ring buffer. */
+    static constexpr int DEFAULT_FRAME_CAPACITY = 300;
+
+    /** A timed scope, times are in nanoseconds of a steady clock. */
+    struct Zone
+    {
+        const char* name     = nullptr;  ///< Zone name, a string literal.
+        int64_t start        = 0;        ///< Time the zone was opened.
+        int64_t end          = 0;        ///< Time the zone was closed.
+        uint32_t threadIndex = 0;        ///< Index of the thread the zone ran on, see getThreadName.
+        uint32_t depth       = 0;        ///< Number of zones of the same thread enclosing this one.
+    };
+
+    /** The zones closed during a frame, in closing order. */
+    struct Frame
+    {
+        uint64_t index = 0;  ///< Number of the frame since the profiler was enabled.
+        int64_t start  = 0;  ///< Time the previous frame was closed.
+        int64_t end    = 0;  ///< Time the frame was closed.
+        std::vector<Zone> zones;
+    };
+
+    /** Opens a zone in its constructor and closes it in its destructor, used by AX_PROFILER_ZONE. */
+    class AX_DLL ScopedZone
+    {
+    public:
+        explicit ScopedZone(const char* name);
+        ~ScopedZone();
+
+        ScopedZone(const ScopedZone&)            = delete;
+        ScopedZone& operator=(const ScopedZone&) = delete;
+
+    private:
+        const char* _name;
+        int64_t _start;
+    };
+
+    static FrameProfiler* getInstance();
+    static void destroyInstance();
+
+    /** Returns the current time of the profiler clock, in nanoseconds. */
+    static int64_t now();
+
+    /** Starts or stops recording, disabled by default. Disabling keeps the recorded frames. */
+    void setEnabled(bool enabled);
+    bool isEnabled() const;
+
+    /** Sets the number of frames kept, the recorded frames are discarded. */
+    void setFrameCapacity(int capacity);
+    int getFrameCapacity() const { return static_cast<int>(_frames.size()); }
+
+    /** Returns the number of frames in the ring buffer. */
+    int getFrameCount() const { return _frameCount; }
+
+    /**
+     * Returns a recorded frame, only valid until the next frame is closed. Should be called on the main thread.
+     * @param index 0 for the oldest frame, getFrameCount() - 1 for the last one.
+     */
+    const Frame& getFrame(int index) const;
+
+    /** Discards the recorded frames. */
+    void clear();
+
+    /** Names the calling thread in the exported traces. The thread running the main loop is named "Main". */
+    static void setThreadName(std::string_view name);
+
+    /** Returns the name of a thread from its Zone::threadIndex. */
+    static std::string getThreadName(uint32_t threadIndex);
+
+    /**
+     * Returns the recorded frames in the Chrome trace event format.
+     * @param maxFrames Number of frames exported, counted from the last one, -1 for all of them.
+     */
+    std::string toChromeTrace(int maxFrames = -1) const;
+
+    /**
+     * Writes toChromeTrace to a file.
+     * @return True if the file was written.
+     */
+    bool saveChromeTrace(std::string_view filePath, int maxFrames = -1) const;
+
+    /** Closes the current frame, called by Director once per main loop. */
+    void endFrame();
+
+protected:
+    FrameProfiler();
+
+    std::vector<Frame> _frames;
+    int _frameHead            = 0;
+    int _frameCount           = 0;
+    uint64_t _nextFrame       = 0;
+    int64_t _frameStart       = 0;  // 0 while not recording
+    bool _mainThreadNamed     = false;
+    uint32_t _mainThreadIndex = 0;  // the frame markers are exported on the track of the main loop thread
+};
+
+NS_AX_END
+
+#    define AX_PROFILER_CONCAT_(a, b) a##b
+#    define AX_PROFILER_CONCAT(a, b) AX_PROFILER_CONCAT_(a, b)
+/** Times the rest of the enclosing scope, name must be a string literal. */
+#    define AX_PROFILER_ZONE(__name__) \
+        NS_AX::FrameProfiler::ScopedZone AX_PROFILER_CONCAT(__axProfilerZone, __LINE__)(__name__)
+/** Closes the current frame of the frame profiler. */
+#    define AX_PROFILER_FRAME() NS_AX::FrameProfiler::getInstance()->endFrame()
+#else
+#    define AX_PROFILER_ZONE(__name__)
+#    define AX_PROFILER_FRAME()
+#endif
+
+// end of base group
+/** @} */
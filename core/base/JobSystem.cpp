@@ -0,0 +1,153 @@
+/****************************************************************************
+ Copyright (c) 2022 Bytedance Inc.
+
+ https://axmolengine.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "base/JobSystem.h"
+#include "base/FrameProfiler.h"
+
+#include <algorithm>
+
+NS_AX_BEGIN
+
+static JobSystem* s_sharedJobSystem = nullptr;
+static thread_local bool s_inJob    = false;
+
+JobSystem* JobSystem::getInstance()
+{
+    if (!s_sharedJobSystem)
+        s_sharedJobSystem = new JobSystem();
+    return s_sharedJobSystem;
+}
+
+void JobSystem::destroyInstance()
+{
+    delete s_sharedJobSystem;
+    s_sharedJobSystem = nullptr;
+}
+
+JobSystem::JobSystem(int numWorkers)
+{
+    if (numWorkers < 0)
+        numWorkers = std::max(static_cast<int>(std::thread::hardware_concurrency()) - 1, 0);
+
+    _workers.reserve(numWorkers);
+    for (int i = 0; i < numWorkers; ++i)
+        _workers.emplace_back(&JobSystem::workerLoop, this);
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+    _workAvailable.notify_all();
+    for (auto& worker : _workers)
+        worker.join();
+}
+
+bool JobSystem::isInJob()
+{
+    return s_inJob;
+}
+
+void JobSystem::parallelFor(int count, int grainSize, const RangeJob& job)
+{
+    if (count <= 0)
+        return;
+    grainSize = std::max(grainSize, 1);
+
+    // Not worth a wake up, or called from a job: run inline.
+    if (_workers.empty() || count <= grainSize || s_inJob)
+    {
+        for (int begin = 0; begin < count; begin += grainSize)
+            job(begin, std::min(begin + grainSize, count));
+        return;
+    }
+
+    std::lock_guard<std::mutex> submitLock(_submitMutex);
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _job       = &job;
+        _count     = count;
+        _grainSize = grainSize;
+        _nextBegin.store(0, std::memory_order_relaxed);
+        _pendingItems.store(count, std::memory_order_relaxed);
+        ++_generation;
+    }
+    _workAvailable.notify_all();
+
+    runRanges();
+
+    // Wait for the ranges taken by workers, and for the workers to leave the job before it goes out of scope.
+    std::unique_lock<std::mutex> lock(_mutex);
+    _workDone.wait(lock, [this] { return _pendingItems.load(std::memory_order_acquire) == 0 && _activeWorkers == 0; });
+    _job = nullptr;
+}
+
+void JobSystem::runRanges()
+{
+    AX_PROFILER_ZONE("JobSystem::runRanges");
+
+    s_inJob = true;
+    for (;;)
+    {
+        const int begin = _nextBegin.fetch_add(_grainSize, std::memory_order_relaxed);
+        if (begin >= _count)
+            break;
+        const int end = std::min(begin + _grainSize, _count);
+        (*_job)(begin, end);
+        _pendingItems.fetch_sub(end - begin, std::memory_order_acq_rel);
+    }
+    s_inJob = false;
+}
+
+void JobSystem::workerLoop()
+{
+#if AX_ENABLE_FRAME_PROFILER
+    FrameProfiler::setThreadName("JobSystem");
+#endif
+
+    uint64_t seenGeneration = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _workAvailable.wait(lock, [&] { return _stop || (_job && _generation != seenGeneration); });
+            if (_stop)
+                return;
+            seenGeneration = _generation;
+            ++_activeWorkers;
+        }
+
+        runRanges();
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            --_activeWorkers;
+        }
+        _workDone.notify_one();
+    }
+}
+
+NS_AX_END
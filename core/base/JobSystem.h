@@ -0,0 +1,117 @@
+/****************************************************************************
+ Copyright (c) 2022 Bytedance Inc.
+
+ https://axmolengine.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "platform/PlatformMacros.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @addtogroup base
+ * @{
+ */
+NS_AX_BEGIN
+
+/**
+ * @class JobSystem
+ * @brief A fixed pool of worker threads for splitting per-frame work into parallel ranges.
+ *
+ * Unlike AsyncTaskPool, which runs fire-and-forget tasks on one thread per task type, JobSystem is meant for
+ * short data parallel jobs that the caller waits for within the same frame.
+ * @js NA
+ */
+class AX_DLL JobSystem
+{
+public:
+    /** The range callback, called with a half open range [begin, end). */
+    typedef std::function<void(int begin, int end)> RangeJob;
+
+    /**
+     * Returns the shared job system, created with one worker less than the hardware concurrency.
+     */
+    static JobSystem* getInstance();
+
+    /**
+     * Destroys the shared job system.
+     */
+    static void destroyInstance();
+
+    /**
+     * @param numWorkers Number of worker threads, negative to use one less than the hardware concurrency.
+     */
+    explicit JobSystem(int numWorkers = -1);
+    ~JobSystem();
+
+    /** Number of worker threads, the calling thread of parallelFor is not included. */
+    int getWorkerCount() const { return static_cast<int>(_workers.size()); }
+
+    /**
+     * Runs job over [0, count) split into ranges of at most grainSize items and waits for all of them.
+     *
+     * The calling thread works on ranges as well. Ranges are handed out in ascending order but may finish in any
+     * order, so job must only write state owned by its own range. Nested calls from inside a job run serially on
+     * the calling thread.
+     *
+     * @param count Number of items.
+     * @param grainSize Maximum number of items per range, values below 1 are treated as 1.
+     * @param job Called once per range.
+     */
+    void parallelFor(int count, int grainSize, const RangeJob& job);
+
+    /** Whether the current thread is running a job of this system. */
+    static bool isInJob();
+
+protected:
+    void workerLoop();
+    void runRanges();
+
+    std::vector<std::thread> _workers;
+
+    // serializes parallelFor calls made from different threads
+    std::mutex _submitMutex;
+
+    std::mutex _mutex;
+    std::condition_variable _workAvailable;
+    std::condition_variable _workDone;
+    uint64_t _generation = 0;
+    bool _stop           = false;
+
+    const RangeJob* _job = nullptr;
+    int _count           = 0;
+    int _grainSize       = 1;
+    std::atomic<int> _nextBegin{0};
+    std::atomic<int> _pendingItems{0};
+    int _activeWorkers = 0;
+};
+
+NS_AX_END
+
+// end of base group
+/** @} */
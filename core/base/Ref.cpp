@@ -28,6 +28,7 @@ THE SOFTWARE.
 #include "base/AutoreleasePool.h"
 #include "base/Macros.h"
 #include "base/ScriptSupport.h"
+#include "base/RefAllocator.h"
 
 #if AX_REF_LEAK_DETECTION
 #    include <algorithm>  // std::find
@@ -59,6 +60,10 @@ Ref::Ref()
 #if AX_REF_LEAK_DETECTION
     trackRef(this);
 #endif
+
+#if AX_ENABLE_REF_POOL
+    RefAllocator::trackConstruction(this);
+#endif
 }
 
 Ref::~Ref()
@@ -76,6 +81,10 @@ Ref::~Ref()
     if (_referenceCount != 0)
         untrackRef(this);
 #endif
+
+#if AX_ENABLE_REF_POOL
+    RefAllocator::trackDestruction(this);
+#endif
 }
 
 void Ref::retain()
@@ -130,6 +139,10 @@ void Ref::release()
 #if AX_REF_LEAK_DETECTION
         untrackRef(this);
 #endif
+
+#if AX_ENABLE_REF_POOL
+        RefAllocator::trackRelease(this);
+#endif
         delete this;
     }
 }
@@ -145,6 +158,32 @@ unsigned int Ref::getReferenceCount() const
     return _referenceCount;
 }
 
+#if AX_ENABLE_REF_POOL
+
+void* Ref::operator new(std::size_t size)
+{
+    if (auto ptr = RefAllocator::allocate(size))
+        return ptr;
+    throw std::bad_alloc{};
+}
+
+void* Ref::operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return RefAllocator::allocate(size);
+}
+
+void Ref::operator delete(void* ptr) noexcept
+{
+    RefAllocator::deallocate(ptr);
+}
+
+void Ref::operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+    RefAllocator::deallocate(ptr);
+}
+
+#endif  // #if AX_ENABLE_REF_POOL
+
 #if AX_REF_LEAK_DETECTION
 
 static std::vector<Ref*> __refAllocationList;
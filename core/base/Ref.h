@@ -32,6 +32,10 @@ THE SOFTWARE.
 
 #define AX_REF_LEAK_DETECTION 0
 
+#if AX_ENABLE_REF_POOL
+#    include <new>
+#endif
+
 /**
  * @addtogroup base
  * @{
@@ -153,6 +157,17 @@ public:
     bool _rooted;
 #endif
 
+#if AX_ENABLE_REF_POOL
+public:
+    /** Ref objects are allocated by RefAllocator, see AX_ENABLE_REF_POOL. */
+    static void* operator new(std::size_t size);
+    static void* operator new(std::size_t size, const std::nothrow_t&) noexcept;
+    static void* operator new(std::size_t /*size*/, void* where) noexcept { return where; }
+    static void operator delete(void* ptr) noexcept;
+    static void operator delete(void* ptr, const std::nothrow_t&) noexcept;
+    static void operator delete(void* /*ptr*/, void* /*where*/) noexcept {}
+#endif
+
     // Memory leak diagnostic data (only included when AX_REF_LEAK_DETECTION is defined and its value isn't zero)
 #if AX_REF_LEAK_DETECTION
 public:
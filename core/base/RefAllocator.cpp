@@ -0,0 +1,482 @@
+/****************************************************************************
+ Copyright (c) 2022 Bytedance Inc.
+
+ https://axmolengine.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "base/RefAllocator.h"
+#include "base/Ref.h"
+#include "base/format.h"
+
+#include <stdlib.h>
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+
+NS_AX_BEGIN
+
+namespace
+{
+// every block starts with a header keeping its size class, so operator delete needs no size
+constexpr size_t HEADER_SIZE    = 16;
+constexpr size_t GRANULARITY    = 16;
+constexpr size_t MAX_BLOCK_SIZE = 2048;
+constexpr size_t NUM_CLASSES    = MAX_BLOCK_SIZE / GRANULARITY;
+constexpr size_t CHUNK_SIZE     = 64 * 1024;
+
+struct BlockHeader
+{
+    uint32_t sizeClass;  // 1 based, 0 for blocks served by malloc
+    uint32_t size;       // requested size
+};
+static_assert(sizeof(BlockHeader) <= HEADER_SIZE, "block header doesn't fit");
+
+struct FreeBlock
+{
+    FreeBlock* next;
+};
+
+inline size_t blockSize(uint32_t sizeClass)
+{
+    return sizeClass * GRANULARITY;
+}
+
+// number of blocks moved between a thread cache and the shared pool at once
+inline int batchSize(uint32_t sizeClass)
+{
+    return static_cast<int>(std::clamp<size_t>(8 * 1024 / blockSize(sizeClass), 4, 64));
+}
+
+struct SharedClass
+{
+    std::mutex mutex;
+    FreeBlock* head = nullptr;
+};
+
+struct SharedPool
+{
+    SharedClass classes[NUM_CLASSES];
+    std::atomic<uint64_t> reservedBytes{0};
+};
+
+// intentionally never destroyed, Ref objects may still be freed during static destruction
+SharedPool& sharedPool()
+{
+    static SharedPool* pool = new SharedPool();
+    return *pool;
+}
+
+struct Counters
+{
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> deallocations{0};
+    std::atomic<uint64_t> refills{0};
+    std::atomic<uint64_t> oversized{0};
+    std::atomic<uint64_t> liveBytes{0};
+};
+
+Counters s_counters;
+std::atomic<bool> s_poolEnabled{true};
+
+void pushShared(uint32_t sizeClass, FreeBlock* first, FreeBlock* last)
+{
+    auto& shared = sharedPool().classes[sizeClass - 1];
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    last->next  = shared.head;
+    shared.head = first;
+}
+
+// pops up to count blocks from the shared pool, carving a new chunk if it is empty
+FreeBlock* popShared(uint32_t sizeClass, int count, int& popped)
+{
+    auto& pool   = sharedPool();
+    auto& shared = pool.classes[sizeClass - 1];
+    std::lock_guard<std::mutex> lock(shared.mutex);
+
+    if (!shared.head)
+    {
+        auto chunk = static_cast<uint8_t*>(malloc(CHUNK_SIZE));
+        if (!chunk)
+        {
+            popped = 0;
+            return nullptr;
+        }
+        pool.reservedBytes.fetch_add(CHUNK_SIZE, std::memory_order_relaxed);
+
+        const size_t size  = blockSize(sizeClass);
+        const size_t total = CHUNK_SIZE / size;
+        FreeBlock* head    = nullptr;
+        for (size_t i = total; i > 0; --i)
+        {
+            auto block  = reinterpret_cast<FreeBlock*>(chunk + (i - 1) * size);
+            block->next = head;
+            head        = block;
+        }
+        shared.head = head;
+    }
+
+    FreeBlock* first = shared.head;
+    FreeBlock* last  = first;
+    popped           = 1;
+    while (popped < count && last->next)
+    {
+        last = last->next;
+        ++popped;
+    }
+    shared.head = last->next;
+    last->next  = nullptr;
+    return first;
+}
+
+struct ThreadCache
+{
+    FreeBlock* heads[NUM_CLASSES] = {};
+    int counts[NUM_CLASSES]       = {};
+
+    ~ThreadCache();
+};
+
+// trivially destructible, so it stays readable while the thread is torn down
+thread_local bool t_cacheDestroyed = false;
+thread_local ThreadCache t_cache;
+
+ThreadCache::~ThreadCache()
+{
+    t_cacheDestroyed = true;
+    for (uint32_t i = 0; i < NUM_CLASSES; ++i)
+    {
+        auto first = heads[i];
+        if (!first)
+            continue;
+        auto last = first;
+        while (last->next)
+            last = last->next;
+        pushShared(i + 1, first, last);
+        heads[i]  = nullptr;
+        counts[i] = 0;
+    }
+}
+
+void* popBlock(uint32_t sizeClass)
+{
+    if (t_cacheDestroyed)
+    {
+        int popped = 0;
+        return popShared(sizeClass, 1, popped);
+    }
+
+    auto& cache      = t_cache;
+    const auto index = sizeClass - 1;
+    if (!cache.heads[index])
+    {
+        s_counters.refills.fetch_add(1, std::memory_order_relaxed);
+        int popped          = 0;
+        cache.heads[index]  = popShared(sizeClass, batchSize(sizeClass), popped);
+        cache.counts[index] = popped;
+        if (!popped)
+            return nullptr;
+    }
+
+    auto block         = cache.heads[index];
+    cache.heads[index] = block->next;
+    --cache.counts[index];
+    return block;
+}
+
+void pushBlock(uint32_t sizeClass, void* ptr)
+{
+    auto block = static_cast<FreeBlock*>(ptr);
+    if (t_cacheDestroyed)
+    {
+        pushShared(sizeClass, block, block);
+        return;
+    }
+
+    auto& cache         = t_cache;
+    const auto index    = sizeClass - 1;
+    block->next         = cache.heads[index];
+    cache.heads[index]  = block;
+    const int batch     = batchSize(sizeClass);
+    if (++cache.counts[index] <= batch * 2)
+        return;
+
+    // give a batch back, so objects freed on a different thread than they were created on don't pile up
+    auto first = cache.heads[index];
+    auto last  = first;
+    for (int i = 1; i < batch; ++i)
+        last = last->next;
+    cache.heads[index] = last->next;
+    cache.counts[index] -= batch;
+    pushShared(sizeClass, first, last);
+}
+
+struct Tracker
+{
+    std::mutex mutex;
+    std::unordered_map<Ref*, uint32_t> pending;  // objects created this frame with their size
+    std::unordered_map<std::type_index, RefAllocator::TypeStats> counts;
+    std::vector<RefAllocator::TypeStats> lastFrame;
+};
+
+Tracker& tracker()
+{
+    static Tracker* instance = new Tracker();
+    return *instance;
+}
+
+std::atomic<bool> s_trackingEnabled{false};
+std::atomic<std::thread::id> s_frameThread{};
+
+// the last block handed out by this thread, lets the Ref constructor find the size of its object
+thread_local const uint8_t* t_lastAllocation = nullptr;
+thread_local uint32_t t_lastAllocationSize   = 0;
+
+void countType(Tracker& t, Ref* ref, uint32_t size)
+{
+    const auto& type = typeid(*ref);
+    auto& entry      = t.counts[std::type_index(type)];
+    entry.name       = type.name();
+    ++entry.count;
+    entry.bytes += size;
+}
+
+std::mutex s_frameMutex;
+RefAllocator::Stats s_frameStats;
+RefAllocator::Stats s_lastTotals;
+}  // namespace
+
+bool RefAllocator::isAvailable()
+{
+    return AX_ENABLE_REF_POOL != 0;
+}
+
+void* RefAllocator::allocate(size_t size)
+{
+    const size_t total = size + HEADER_SIZE;
+    uint32_t sizeClass = 0;
+    uint8_t* block     = nullptr;
+    if (total <= MAX_BLOCK_SIZE && s_poolEnabled.load(std::memory_order_relaxed))
+    {
+        sizeClass = static_cast<uint32_t>((total + GRANULARITY - 1) / GRANULARITY);
+        block     = static_cast<uint8_t*>(popBlock(sizeClass));
+    }
+    else
+    {
+        if (total > MAX_BLOCK_SIZE)
+            s_counters.oversized.fetch_add(1, std::memory_order_relaxed);
+        block = static_cast<uint8_t*>(malloc(total));
+    }
+
+    if (!block)
+        return nullptr;
+
+    auto header       = reinterpret_cast<BlockHeader*>(block);
+    header->sizeClass = sizeClass;
+    header->size      = static_cast<uint32_t>(size);
+
+    s_counters.allocations.fetch_add(1, std::memory_order_relaxed);
+    s_counters.liveBytes.fetch_add(size, std::memory_order_relaxed);
+
+    t_lastAllocation     = block + HEADER_SIZE;
+    t_lastAllocationSize = header->size;
+    return block + HEADER_SIZE;
+}
+
+void RefAllocator::deallocate(void* ptr)
+{
+    if (!ptr)
+        return;
+
+    auto block  = static_cast<uint8_t*>(ptr) - HEADER_SIZE;
+    auto header = reinterpret_cast<BlockHeader*>(block);
+
+    s_counters.deallocations.fetch_add(1, std::memory_order_relaxed);
+    s_counters.liveBytes.fetch_sub(header->size, std::memory_order_relaxed);
+
+    if (header->sizeClass == 0)
+        free(block);
+    else
+        pushBlock(header->sizeClass, block);
+}
+
+void RefAllocator::setPoolEnabled(bool enabled)
+{
+    s_poolEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool RefAllocator::isPoolEnabled()
+{
+    return s_poolEnabled.load(std::memory_order_relaxed);
+}
+
+RefAllocator::Stats RefAllocator::getTotalStats()
+{
+    Stats stats;
+    stats.allocations   = s_counters.allocations.load(std::memory_order_relaxed);
+    stats.deallocations = s_counters.deallocations.load(std::memory_order_relaxed);
+    stats.refills       = s_counters.refills.load(std::memory_order_relaxed);
+    stats.oversized     = s_counters.oversized.load(std::memory_order_relaxed);
+    stats.liveObjects   = stats.allocations > stats.deallocations ? stats.allocations - stats.deallocations : 0;
+    stats.liveBytes     = s_counters.liveBytes.load(std::memory_order_relaxed);
+    stats.reservedBytes = sharedPool().reservedBytes.load(std::memory_order_relaxed);
+    return stats;
+}
+
+RefAllocator::Stats RefAllocator::getFrameStats()
+{
+    auto totals = getTotalStats();
+    std::lock_guard<std::mutex> lock(s_frameMutex);
+    Stats stats         = s_frameStats;
+    stats.liveObjects   = totals.liveObjects;
+    stats.liveBytes     = totals.liveBytes;
+    stats.reservedBytes = totals.reservedBytes;
+    return stats;
+}
+
+void RefAllocator::setTrackingEnabled(bool enabled)
+{
+    auto& t = tracker();
+    std::lock_guard<std::mutex> lock(t.mutex);
+    // drop what was recorded so far, pending objects may have been freed while the hooks were off
+    t.pending.clear();
+    t.counts.clear();
+    t.lastFrame.clear();
+    s_trackingEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool RefAllocator::isTrackingEnabled()
+{
+    return s_trackingEnabled.load(std::memory_order_relaxed);
+}
+
+std::vector<RefAllocator::TypeStats> RefAllocator::getTopTypes(size_t maxCount)
+{
+    auto& t = tracker();
+    std::lock_guard<std::mutex> lock(t.mutex);
+    auto count = (std::min)(maxCount, t.lastFrame.size());
+    return std::vector<TypeStats>(t.lastFrame.begin(), t.lastFrame.begin() + count);
+}
+
+std::string RefAllocator::getDiagnostics(size_t maxTypes)
+{
+    if (!isAvailable())
+        return "Ref allocator not available. AX_ENABLE_REF_POOL must be set to 1 in Config.h\n";
+
+    auto frame = getFrameStats();
+    std::string info;
+    auto out = std::back_inserter(info);
+    fmt::format_to(out, "Ref allocator: pool {}, tracking {}\n", isPoolEnabled() ? "on" : "off",
+                   isTrackingEnabled() ? "on" : "off");
+    fmt::format_to(out, "last frame: {} allocations, {} deallocations, {} cache refills, {} oversized\n",
+                   frame.allocations, frame.deallocations, frame.refills, frame.oversized);
+    fmt::format_to(out, "live: {} objects, {} KB requested, {} KB reserved by the pool\n", frame.liveObjects,
+                   frame.liveBytes / 1024, frame.reservedBytes / 1024);
+
+    if (isTrackingEnabled())
+    {
+        auto types = getTopTypes(maxTypes);
+        fmt::format_to(out, "top allocating types of last frame:\n");
+        for (auto& type : types)
+            fmt::format_to(out, "{:>8} {:>10} bytes  {}\n", type.count, type.bytes, type.name ? type.name : "");
+    }
+    return info;
+}
+
+void RefAllocator::endFrame()
+{
+    s_frameThread.store(std::this_thread::get_id(), std::memory_order_relaxed);
+
+    auto totals = getTotalStats();
+    {
+        std::lock_guard<std::mutex> lock(s_frameMutex);
+        s_frameStats.allocations   = totals.allocations - s_lastTotals.allocations;
+        s_frameStats.deallocations = totals.deallocations - s_lastTotals.deallocations;
+        s_frameStats.refills       = totals.refills - s_lastTotals.refills;
+        s_frameStats.oversized     = totals.oversized - s_lastTotals.oversized;
+        s_lastTotals               = totals;
+    }
+
+    if (!isTrackingEnabled())
+        return;
+
+    auto& t = tracker();
+    std::lock_guard<std::mutex> lock(t.mutex);
+    // the survivors are fully constructed by now, so their dynamic type can be resolved
+    for (auto& [ref, size] : t.pending)
+        countType(t, ref, size);
+    t.pending.clear();
+
+    t.lastFrame.clear();
+    t.lastFrame.reserve(t.counts.size());
+    for (auto& entry : t.counts)
+        t.lastFrame.emplace_back(entry.second);
+    t.counts.clear();
+    std::sort(t.lastFrame.begin(), t.lastFrame.end(),
+              [](const TypeStats& a, const TypeStats& b) { return a.count > b.count; });
+}
+
+void RefAllocator::trackConstruction(Ref* ref)
+{
+    // objects built on other threads may still be under construction when the frame ends
+    if (!isTrackingEnabled() || std::this_thread::get_id() != s_frameThread.load(std::memory_order_relaxed))
+        return;
+
+    auto address  = reinterpret_cast<const uint8_t*>(ref);
+    uint32_t size = 0;
+    if (t_lastAllocation && address >= t_lastAllocation && address < t_lastAllocation + t_lastAllocationSize)
+        size = t_lastAllocationSize;
+
+    auto& t = tracker();
+    std::lock_guard<std::mutex> lock(t.mutex);
+    t.pending.emplace(ref, size);
+}
+
+void RefAllocator::trackRelease(Ref* ref)
+{
+    if (!isTrackingEnabled())
+        return;
+
+    auto& t = tracker();
+    std::lock_guard<std::mutex> lock(t.mutex);
+    auto it = t.pending.find(ref);
+    if (it == t.pending.end())
+        return;
+    countType(t, ref, it->second);
+    t.pending.erase(it);
+}
+
+void RefAllocator::trackDestruction(Ref* ref)
+{
+    if (!isTrackingEnabled())
+        return;
+
+    // the dynamic type is gone at this point, objects deleted without release are not counted
+    auto& t = tracker();
+    std::lock_guard<std::mutex> lock(t.mutex);
+    t.pending.erase(ref);
+}
+
+NS_AX_END
@@ -0,0 +1,130 @@
+/****************************************************************************
+ Copyright (c) 2022 Bytedance Inc.
+
+ https://axmolengine.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "platform/PlatformMacros.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/**
+ * @addtogroup base
+ * @{
+ */
+NS_AX_BEGIN
+
+class Ref;
+
+/**
+ * @class RefAllocator
+ * @brief Size class pool allocator behind the class level operator new/delete of Ref.
+ *
+ * Only used when the engine is built with AX_ENABLE_REF_POOL set to 1. Small objects are carved from 64KB chunks
+ * into 16 byte granular size classes, every thread keeps a small cache per size class and exchanges batches with
+ * the shared pool, so the common new/release path takes no lock. Objects larger than the biggest size class go to
+ * malloc. Chunk memory is kept for the lifetime of the process.
+ *
+ * The allocation tracking mode records which types are created on the thread running the main loop and reports the
+ * most allocated types of the last frame, see the "allocator" console command.
+ * @js NA
+ */
+class AX_DLL RefAllocator
+{
+public:
+    /** Allocation counters, per frame or since start up. */
+    struct Stats
+    {
+        uint64_t allocations   = 0;  ///< Number of Ref allocations.
+        uint64_t deallocations = 0;  ///< Number of Ref deallocations.
+        uint64_t refills       = 0;  ///< Allocations that had to refill a thread cache from the shared pool.
+        uint64_t oversized     = 0;  ///< Allocations too large for any size class, served by malloc.
+        uint64_t liveObjects   = 0;  ///< Ref objects alive when the stats were taken.
+        uint64_t liveBytes     = 0;  ///< Bytes requested by the live Ref objects.
+        uint64_t reservedBytes = 0;  ///< Chunk memory reserved by the pool.
+    };
+
+    /** Allocation count of one type during a frame. */
+    struct TypeStats
+    {
+        const char* name = nullptr;  ///< Type name as returned by std::type_info::name.
+        uint32_t count   = 0;        ///< Objects created.
+        uint64_t bytes   = 0;        ///< Bytes requested by those objects.
+    };
+
+    /** Whether the engine was built with AX_ENABLE_REF_POOL. */
+    static bool isAvailable();
+
+    /**
+     * Allocates size bytes, used by Ref::operator new.
+     * @return The memory, nullptr if the system is out of memory.
+     */
+    static void* allocate(size_t size);
+
+    /** Frees memory returned by allocate, used by Ref::operator delete. */
+    static void deallocate(void* ptr);
+
+    /**
+     * Whether new allocations come from the size class pools, true by default.
+     * Disabling sends new allocations to malloc, memory allocated before is still freed to where it came from.
+     */
+    static void setPoolEnabled(bool enabled);
+    static bool isPoolEnabled();
+
+    /** Returns the counters of the last finished frame, live and reserved values are current. */
+    static Stats getFrameStats();
+
+    /** Returns the counters since start up. */
+    static Stats getTotalStats();
+
+    /** Enables or disables the allocation tracking mode, disabled by default. */
+    static void setTrackingEnabled(bool enabled);
+    static bool isTrackingEnabled();
+
+    /**
+     * Returns the most allocated types of the last finished frame sorted by count, empty if tracking is disabled.
+     * @param maxCount Maximum number of types returned.
+     */
+    static std::vector<TypeStats> getTopTypes(size_t maxCount = 10);
+
+    /** Returns a human readable report of the frame stats and the top types of the last frame. */
+    static std::string getDiagnostics(size_t maxTypes = 10);
+
+    /** Closes the current frame, called by Director once per main loop. */
+    static void endFrame();
+
+    /** @cond */
+    // tracking hooks used by Ref
+    static void trackConstruction(Ref* ref);
+    static void trackRelease(Ref* ref);
+    static void trackDestruction(Ref* ref);
+    /** @endcond */
+};
+
+NS_AX_END
+
+// end of base group
+/** @} */
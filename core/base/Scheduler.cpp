@@ -32,6 +32,7 @@ THE SOFTWARE.
 #include "uthash/utlist.h"
 #include "base/CArray.h"
 #include "base/ScriptSupport.h"
+#include "base/FrameProfiler.h"
 
 NS_AX_BEGIN
 
@@ -827,6 +828,8 @@ void Scheduler::removeAllPendingActions()
 // main loop
 void Scheduler::update(float dt)
 {
+    AX_PROFILER_ZONE("Scheduler::update");
+
     _updateHashLocked = true;
 
     if (_timeScale != 1.0f)
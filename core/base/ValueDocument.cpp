@@ -0,0 +1,542 @@
+/****************************************************************************
+ Copyright (c) 2022 Bytedance Inc.
+
+ https://axmolengine.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "base/ValueDocument.h"
+#include "base/Utils.h"
+#include "platform/FileUtils.h"
+#include "platform/SAXParser.h"
+#include "rapidjson/reader.h"
+
+#include <string.h>
+#include <algorithm>
+#include <numeric>
+
+NS_AX_BEGIN
+
+namespace
+{
+constexpr size_t STRING_BLOCK_SIZE = 64 * 1024;
+// longer strings, such as polygon vertex lists, rarely repeat and are not worth hashing
+constexpr size_t MAX_INTERNED_LENGTH = 128;
+}  // namespace
+
+/**
+ * Builds a ValueDocument bottom up: the children of each open container are collected on a level of their own and
+ * moved into the node array in one piece when the container is closed.
+ */
+class ValueDocumentBuilder : public SAXDelegator
+{
+public:
+    using NodeData = ValueDocument::NodeData;
+    using Type     = ValueDocument::Type;
+
+    explicit ValueDocumentBuilder(ValueDocument& doc) : _doc(doc) {}
+
+    void beginContainer(Type type)
+    {
+        if (_depth == _levels.size())
+            _levels.emplace_back();
+        auto& level = _levels[_depth++];
+        level.type  = type;
+        level.key   = _key;
+        level.children.clear();
+        level.keys.clear();
+    }
+
+    void endContainer()
+    {
+        if (_depth == 0)
+            return;
+        auto& level = _levels[--_depth];
+
+        NodeData node;
+        node.type  = level.type;
+        node.first = static_cast<uint32_t>(_doc._nodes.size());
+
+        if (level.type == Type::DICT)
+        {
+            // sort by key for binary search, a key given twice keeps its last value
+            auto& order = _order;
+            order.resize(level.children.size());
+            std::iota(order.begin(), order.end(), 0u);
+            std::stable_sort(order.begin(), order.end(),
+                             [&level](uint32_t a, uint32_t b) { return level.keys[a] < level.keys[b]; });
+            for (size_t i = 0; i < order.size(); ++i)
+            {
+                if (i + 1 < order.size() && level.keys[order[i]] == level.keys[order[i + 1]])
+                    continue;
+                _doc._nodes.emplace_back(level.children[order[i]]);
+                _doc._keys.emplace_back(level.keys[order[i]]);
+            }
+        }
+        else
+        {
+            _doc._nodes.insert(_doc._nodes.end(), level.children.begin(), level.children.end());
+            _doc._keys.resize(_doc._nodes.size());
+        }
+        node.size = static_cast<uint32_t>(_doc._nodes.size() - node.first);
+
+        _key = level.key;
+        addNode(node);
+    }
+
+    void addNode(const NodeData& node)
+    {
+        if (_depth == 0)
+        {
+            // the first top level container is the root
+            if (_doc._root.type == Type::NONE)
+                _doc._root = node;
+            return;
+        }
+        auto& level = _levels[_depth - 1];
+        level.children.emplace_back(node);
+        level.keys.emplace_back(level.type == Type::DICT ? _key : std::string_view{});
+    }
+
+    void setKey(std::string_view key) { _key = intern(key); }
+
+    void addBool(bool value)
+    {
+        NodeData node;
+        node.type    = Type::BOOLEAN;
+        node.boolVal = value;
+        addNode(node);
+    }
+
+    void addInt(int64_t value)
+    {
+        NodeData node;
+        node.type   = Type::INTEGER;
+        node.intVal = value;
+        addNode(node);
+    }
+
+    void addDouble(double value)
+    {
+        NodeData node;
+        node.type      = Type::DOUBLE;
+        node.doubleVal = value;
+        addNode(node);
+    }
+
+    void addString(std::string_view value)
+    {
+        auto str = intern(value);
+        NodeData node;
+        node.type   = Type::STRING;
+        node.strVal = str.data();
+        node.size   = static_cast<uint32_t>(str.size());
+        addNode(node);
+    }
+
+    void addNull() { addNode(NodeData{}); }
+
+    std::string_view intern(std::string_view str)
+    {
+        if (str.size() > MAX_INTERNED_LENGTH)
+            return _doc.storeString(str);
+        auto it = _interned.find(str);
+        if (it != _interned.end())
+            return *it;
+        auto stored = _doc.storeString(str);
+        _interned.insert(stored);
+        return stored;
+    }
+
+    // plist elements, mirrors what FileUtils::getValueMapFromFile accepts
+    void startElement(void* /*ctx*/, const char* name, const char** /*atts*/) override
+    {
+        std::string_view sName(name);
+        _text.clear();
+        _inText = false;
+        if (sName == "dict"sv)
+            beginContainer(Type::DICT);
+        else if (sName == "array"sv)
+            beginContainer(Type::ARRAY);
+        else if (sName == "key"sv || sName == "string"sv || sName == "integer"sv || sName == "real"sv)
+            _inText = true;
+    }
+
+    void endElement(void* /*ctx*/, const char* name) override
+    {
+        std::string_view sName(name);
+        if (sName == "dict"sv || sName == "array"sv)
+            endContainer();
+        else if (sName == "key"sv)
+            setKey(_text);
+        else if (sName == "string"sv)
+            addString(_text);
+        else if (sName == "integer"sv)
+            addInt(atoi(_text.c_str()));
+        else if (sName == "real"sv)
+            addDouble(utils::atof(_text.c_str()));
+        else if (sName == "true"sv)
+            addBool(true);
+        else if (sName == "false"sv)
+            addBool(false);
+        _text.clear();
+        _inText = false;
+    }
+
+    void textHandler(void* /*ctx*/, const char* s, size_t len) override
+    {
+        if (_inText)
+            _text.append(s, len);
+    }
+
+    // rapidjson SAX handler
+    bool Null()
+    {
+        addNull();
+        return true;
+    }
+    bool Bool(bool b)
+    {
+        addBool(b);
+        return true;
+    }
+    bool Int(int i)
+    {
+        addInt(i);
+        return true;
+    }
+    bool Uint(unsigned u)
+    {
+        addInt(u);
+        return true;
+    }
+    bool Int64(int64_t i)
+    {
+        addInt(i);
+        return true;
+    }
+    bool Uint64(uint64_t u)
+    {
+        addInt(static_cast<int64_t>(u));
+        return true;
+    }
+    bool Double(double d)
+    {
+        addDouble(d);
+        return true;
+    }
+    bool RawNumber(const char* str, rapidjson::SizeType length, bool /*copy*/)
+    {
+        addString(std::string_view(str, length));
+        return true;
+    }
+    bool String(const char* str, rapidjson::SizeType length, bool /*copy*/)
+    {
+        addString(std::string_view(str, length));
+        return true;
+    }
+    bool StartObject()
+    {
+        beginContainer(Type::DICT);
+        return true;
+    }
+    bool Key(const char* str, rapidjson::SizeType length, bool /*copy*/)
+    {
+        setKey(std::string_view(str, length));
+        return true;
+    }
+    bool EndObject(rapidjson::SizeType /*memberCount*/)
+    {
+        endContainer();
+        return true;
+    }
+    bool StartArray()
+    {
+        beginContainer(Type::ARRAY);
+        return true;
+    }
+    bool EndArray(rapidjson::SizeType /*elementCount*/)
+    {
+        endContainer();
+        return true;
+    }
+
+private:
+    struct Level
+    {
+        Type type = Type::NONE;
+        std::string_view key;  // key of the container in its parent
+        std::vector<NodeData> children;
+        std::vector<std::string_view> keys;
+    };
+
+    ValueDocument& _doc;
+    std::vector<Level> _levels;  // kept across containers so their vectors are reused
+    size_t _depth = 0;
+    std::vector<uint32_t> _order;
+    std::string_view _key;
+    std::string _text;
+    bool _inText = false;
+    tsl::robin_set<std::string_view, hlookup::string_hash, hlookup::equal_to> _interned;
+};
+
+//
+// ValueDocument::Node
+//
+
+bool ValueDocument::Node::asBool(bool defaultValue) const
+{
+    switch (getType())
+    {
+    case Type::BOOLEAN:
+        return _data->boolVal;
+    case Type::INTEGER:
+        return _data->intVal != 0;
+    case Type::DOUBLE:
+        return _data->doubleVal != 0.0;
+    case Type::STRING:
+    {
+        std::string_view str(_data->strVal, _data->size);
+        return !(str == "0"sv || str == "false"sv);
+    }
+    default:
+        return defaultValue;
+    }
+}
+
+int ValueDocument::Node::asInt(int defaultValue) const
+{
+    switch (getType())
+    {
+    case Type::BOOLEAN:
+        return _data->boolVal ? 1 : 0;
+    case Type::INTEGER:
+        return static_cast<int>(_data->intVal);
+    case Type::DOUBLE:
+        return static_cast<int>(_data->doubleVal);
+    case Type::STRING:
+        return atoi(_data->strVal);
+    default:
+        return defaultValue;
+    }
+}
+
+float ValueDocument::Node::asFloat(float defaultValue) const
+{
+    return static_cast<float>(asDouble(defaultValue));
+}
+
+double ValueDocument::Node::asDouble(double defaultValue) const
+{
+    switch (getType())
+    {
+    case Type::BOOLEAN:
+        return _data->boolVal ? 1.0 : 0.0;
+    case Type::INTEGER:
+        return static_cast<double>(_data->intVal);
+    case Type::DOUBLE:
+        return _data->doubleVal;
+    case Type::STRING:
+        return utils::atof(_data->strVal);
+    default:
+        return defaultValue;
+    }
+}
+
+std::string_view ValueDocument::Node::asString() const
+{
+    return getType() == Type::STRING ? std::string_view(_data->strVal, _data->size) : std::string_view{};
+}
+
+size_t ValueDocument::Node::size() const
+{
+    auto type = getType();
+    return (type == Type::ARRAY || type == Type::DICT) ? _data->size : 0;
+}
+
+ValueDocument::Node ValueDocument::Node::operator[](std::string_view key) const
+{
+    if (getType() != Type::DICT)
+        return Node();
+
+    auto first = _doc->_keys.begin() + _data->first;
+    auto last  = first + _data->size;
+    auto it    = std::lower_bound(first, last, key);
+    if (it == last || *it != key)
+        return Node();
+    return Node(_doc, &_doc->_nodes[it - _doc->_keys.begin()]);
+}
+
+ValueDocument::Node ValueDocument::Node::at(size_t index) const
+{
+    if (index >= size())
+        return Node();
+    return Node(_doc, &_doc->_nodes[_data->first + index]);
+}
+
+std::string_view ValueDocument::Node::keyAt(size_t index) const
+{
+    if (getType() != Type::DICT || index >= _data->size)
+        return std::string_view{};
+    return _doc->_keys[_data->first + index];
+}
+
+Value ValueDocument::Node::toValue() const
+{
+    switch (getType())
+    {
+    case Type::BOOLEAN:
+        return Value(_data->boolVal);
+    case Type::INTEGER:
+        if (_data->intVal >= INT32_MIN && _data->intVal <= INT32_MAX)
+            return Value(static_cast<int>(_data->intVal));
+        return Value(_data->intVal);
+    case Type::DOUBLE:
+        return Value(_data->doubleVal);
+    case Type::STRING:
+        return Value(asString());
+    case Type::ARRAY:
+    {
+        ValueVector array;
+        array.reserve(_data->size);
+        for (size_t i = 0; i < _data->size; ++i)
+            array.emplace_back(at(i).toValue());
+        return Value(std::move(array));
+    }
+    case Type::DICT:
+    {
+        ValueMap dict;
+        dict.reserve(_data->size);
+        for (size_t i = 0; i < _data->size; ++i)
+            dict.emplace(keyAt(i), at(i).toValue());
+        return Value(std::move(dict));
+    }
+    default:
+        return Value::Null;
+    }
+}
+
+//
+// ValueDocument
+//
+
+ValueDocument::ValueDocument() {}
+
+ValueDocument::~ValueDocument() {}
+
+ValueDocument::ValueDocument(ValueDocument&&) noexcept = default;
+
+ValueDocument& ValueDocument::operator=(ValueDocument&&) noexcept = default;
+
+bool ValueDocument::initWithPlistFile(std::string_view filename)
+{
+    clear();
+    auto data = FileUtils::getInstance()->getDataFromFile(filename);
+    if (data.isNull())
+        return false;
+
+    ValueDocumentBuilder builder(*this);
+    SAXParser parser;
+    parser.setDelegator(&builder);
+    // parse in place, the file data is ours to modify
+    if (!parser.parseIntrusive(reinterpret_cast<char*>(data.getBytes()), data.getSize()))
+    {
+        clear();
+        return false;
+    }
+    return true;
+}
+
+bool ValueDocument::initWithPlistData(const char* data, size_t size)
+{
+    clear();
+    ValueDocumentBuilder builder(*this);
+    SAXParser parser;
+    parser.setDelegator(&builder);
+    if (!parser.parse(data, size))
+    {
+        clear();
+        return false;
+    }
+    return true;
+}
+
+bool ValueDocument::initWithJsonData(const char* data, size_t size)
+{
+    clear();
+    ValueDocumentBuilder builder(*this);
+    rapidjson::Reader reader;
+    rapidjson::MemoryStream stream(data, size);
+    if (reader.Parse(stream, builder).IsError())
+    {
+        AXLOG("axmol: ValueDocument: json parse error at offset %u", static_cast<unsigned>(reader.GetErrorOffset()));
+        clear();
+        return false;
+    }
+    return true;
+}
+
+void ValueDocument::clear()
+{
+    _root = NodeData{};
+    _nodes.clear();
+    _keys.clear();
+    _blocks.clear();
+    _blockUsed     = 0;
+    _blockCapacity = 0;
+    _stringBytes   = 0;
+}
+
+size_t ValueDocument::getMemoryUsage() const
+{
+    return _nodes.capacity() * sizeof(NodeData) + _keys.capacity() * sizeof(std::string_view) + _stringBytes;
+}
+
+std::string_view ValueDocument::storeString(std::string_view str)
+{
+    const size_t needed = str.size() + 1;
+    char* dest          = nullptr;
+    if (needed > STRING_BLOCK_SIZE / 4)
+    {
+        // big strings get a block of their own, so the current block isn't wasted
+        auto block = std::make_unique<char[]>(needed);
+        dest       = block.get();
+        _blocks.insert(_blocks.end() - (_blocks.empty() ? 0 : 1), std::move(block));
+        _stringBytes += needed;
+    }
+    else
+    {
+        if (_blockUsed + needed > _blockCapacity)
+        {
+            _blocks.emplace_back(std::make_unique<char[]>(STRING_BLOCK_SIZE));
+            _blockUsed     = 0;
+            _blockCapacity = STRING_BLOCK_SIZE;
+            _stringBytes += STRING_BLOCK_SIZE;
+        }
+        dest = _blocks.back().get() + _blockUsed;
+        _blockUsed += needed;
+    }
+
+    memcpy(dest, str.data(), str.size());
+    dest[str.size()] = '\0';
+    return std::string_view(dest, str.size());
+}
+
+NS_AX_END
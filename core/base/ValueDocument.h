@@ -0,0 +1,175 @@
+/****************************************************************************
+ Copyright (c) 2022 Bytedance Inc.
+
+ https://axmolengine.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "platform/PlatformMacros.h"
+#include "base/Value.h"
+
+#include <stdint.h>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+/**
+ * @addtogroup base
+ * @{
+ */
+NS_AX_BEGIN
+
+/**
+ * @class ValueDocument
+ * @brief An immutable, arena backed tree of plist or JSON data.
+ *
+ * Where ValueMap and ValueVector allocate every string and container node separately, a ValueDocument keeps all
+ * nodes in one flat array, stores the children of a container next to each other and interns strings into a few
+ * large blocks. Loading a big sprite sheet plist takes a handful of allocations instead of one per entry, and
+ * lookups return lightweight Node views without copying anything.
+ *
+ * Dictionary entries are sorted by key, so iteration order follows the keys, and a duplicated key keeps its last
+ * value like ValueMap does.
+ * @js NA
+ */
+class AX_DLL ValueDocument
+{
+    struct NodeData;
+
+public:
+    enum class Type : uint8_t
+    {
+        NONE = 0,
+        BOOLEAN,
+        INTEGER,
+        DOUBLE,
+        STRING,
+        ARRAY,
+        DICT,
+    };
+
+    /**
+     * A view of one node, valid as long as the document is alive and not re-initialized.
+     * Lookups on a missing key or a node of another type return a null node, so chains like
+     * doc.getRoot()["metadata"]["format"].asInt() are safe.
+     */
+    class AX_DLL Node
+    {
+    public:
+        Node() = default;
+
+        Type getType() const { return _data ? _data->type : Type::NONE; }
+        bool isNull() const { return getType() == Type::NONE; }
+        bool isDict() const { return getType() == Type::DICT; }
+        bool isArray() const { return getType() == Type::ARRAY; }
+
+        /** Conversions follow the rules of Value, strings are parsed. */
+        bool asBool(bool defaultValue = false) const;
+        int asInt(int defaultValue = 0) const;
+        float asFloat(float defaultValue = 0.0f) const;
+        double asDouble(double defaultValue = 0.0) const;
+
+        /** The string of a string node, empty for other types. The view is null terminated. */
+        std::string_view asString() const;
+
+        /** Number of children of an array or dictionary. */
+        size_t size() const;
+
+        /** Dictionary lookup. */
+        Node operator[](std::string_view key) const;
+        bool hasKey(std::string_view key) const { return !(*this)[key].isNull(); }
+
+        /** The index-th child of an array or dictionary. */
+        Node at(size_t index) const;
+
+        /** The key of the index-th entry of a dictionary. */
+        std::string_view keyAt(size_t index) const;
+
+        /** Deep copies the node into a Value, for code that still needs ValueMap or ValueVector. */
+        Value toValue() const;
+
+    private:
+        friend class ValueDocument;
+
+        Node(const ValueDocument* doc, const NodeData* data) : _doc(doc), _data(data) {}
+
+        const ValueDocument* _doc = nullptr;
+        const NodeData* _data     = nullptr;
+    };
+
+    ValueDocument();
+    ~ValueDocument();
+    ValueDocument(ValueDocument&&) noexcept;
+    ValueDocument& operator=(ValueDocument&&) noexcept;
+
+    /** Parses a plist file, the root is its top level dict or array. */
+    bool initWithPlistFile(std::string_view filename);
+
+    /** Parses plist data. */
+    bool initWithPlistData(const char* data, size_t size);
+
+    /** Parses JSON data, null values become null nodes. */
+    bool initWithJsonData(const char* data, size_t size);
+
+    /** Releases all nodes and strings. */
+    void clear();
+
+    Node getRoot() const { return Node(this, &_root); }
+
+    /** Bytes held by nodes and string blocks. */
+    size_t getMemoryUsage() const;
+
+private:
+    friend class ValueDocumentBuilder;
+
+    struct NodeData
+    {
+        union
+        {
+            bool boolVal;
+            int64_t intVal;
+            double doubleVal;
+            const char* strVal;
+            uint32_t first;  // index of the first child in _nodes
+        };
+        uint32_t size = 0;  // string length or number of children
+        Type type     = Type::NONE;
+    };
+
+    // copies str into the string blocks, null terminated
+    std::string_view storeString(std::string_view str);
+
+    NodeData _root;
+    std::vector<NodeData> _nodes;
+    std::vector<std::string_view> _keys;  // dictionary keys, parallel to _nodes
+    std::vector<std::unique_ptr<char[]>> _blocks;
+    size_t _blockUsed     = 0;
+    size_t _blockCapacity = 0;
+    size_t _stringBytes   = 0;
+
+    AX_DISALLOW_COPY_AND_ASSIGN(ValueDocument);
+};
+
+NS_AX_END
+
+// end of base group
+/** @} */
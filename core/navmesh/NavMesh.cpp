@@ -28,6 +28,8 @@
 
 #    include "platform/FileUtils.h"
 #    include "renderer/Renderer.h"
+#    include "base/AsyncTaskPool.h"
+#    include "base/JobSystem.h"
 #    include "recast/DetourCommon.h"
 #    include "recast/DetourDebugDraw.h"
 #    include <sstream>
@@ -88,12 +90,21 @@ static unsigned char* parseRow(unsigned char* buf, unsigned char* bufEnd, char*
 
 static const int TILECACHESET_MAGIC   = 'T' << 24 | 'S' << 16 | 'E' << 8 | 'T';  //'TSET';
 static const int TILECACHESET_VERSION = 1;
-static const int MAX_AGENTS           = 128;
-
-NavMesh* NavMesh::create(std::string_view navFilePath, std::string_view geomFilePath)
+static const int MAX_QUERY_NODES      = 2048;
+static const int MAX_POLYS            = 256;
+static const int MAX_SMOOTH           = 2048;
+
+static void findSmoothPath(dtNavMeshQuery* navMeshQuery,
+                           dtNavMesh* navMesh,
+                           const Vec3& start,
+                           const Vec3& end,
+                           std::vector<Vec3>& pathPoints);
+static NavMesh::RaycastResult raycastSurface(dtNavMeshQuery* navMeshQuery, const Vec3& start, const Vec3& end);
+
+NavMesh* NavMesh::create(std::string_view navFilePath, std::string_view geomFilePath, int maxAgents)
 {
     auto ref = new NavMesh();
-    if (ref->initWithFilePath(navFilePath, geomFilePath))
+    if (ref->initWithFilePath(navFilePath, geomFilePath, maxAgents))
     {
         ref->autorelease();
         return ref;
@@ -111,11 +122,24 @@ NavMesh::NavMesh()
     , _compressor(nullptr)
     , _meshProcess(nullptr)
     , _geomData(nullptr)
+    , _maxAgents(0)
     , _isDebugDrawEnabled(false)
+    , _asyncUpdateEnabled(false)
+    , _asyncUpdatePending(false)
+    , _asyncUpdateRunning(false)
+    , _asyncUpdateDelta(0.0f)
+    , _maxTileRebuilds(1)
 {}
 
 NavMesh::~NavMesh()
 {
+    {
+        std::unique_lock<std::mutex> lock(_asyncUpdateMutex);
+        _asyncUpdateDone.wait(lock, [this]() { return !_asyncUpdateRunning; });
+    }
+
+    for (auto&& query : _queryPool)
+        dtFreeNavMeshQuery(query);
     dtFreeTileCache(_tileCache);
     dtFreeCrowd(_crowed);
     dtFreeNavMesh(_navMesh);
@@ -127,6 +151,8 @@ NavMesh::~NavMesh()
 
     for (auto&& iter : _agentList)
     {
+        if (iter)
+            iter->_navMesh = nullptr;
         AX_SAFE_RELEASE(iter);
     }
     _agentList.clear();
@@ -138,10 +164,11 @@ NavMesh::~NavMesh()
     _obstacleList.clear();
 }
 
-bool NavMesh::initWithFilePath(std::string_view navFilePath, std::string_view geomFilePath)
+bool NavMesh::initWithFilePath(std::string_view navFilePath, std::string_view geomFilePath, int maxAgents)
 {
     _navFilePath  = navFilePath;
     _geomFilePath = geomFilePath;
+    _maxAgents    = maxAgents;
     if (!read())
         return false;
     return true;
@@ -226,13 +253,13 @@ bool NavMesh::loadNavMeshFile()
 
     // create crowed
     _crowed = dtAllocCrowd();
-    _crowed->init(MAX_AGENTS, header.cacheParams.walkableRadius, _navMesh);
+    _crowed->init(_maxAgents, header.cacheParams.walkableRadius, _navMesh);
 
     // create NavMeshQuery
     _navMeshQuery = dtAllocNavMeshQuery();
-    _navMeshQuery->init(_navMesh, 2048);
+    _navMeshQuery->init(_navMesh, MAX_QUERY_NODES);
 
-    _agentList.assign(MAX_AGENTS, nullptr);
+    _agentList.assign(_maxAgents, nullptr);
     _obstacleList.assign(header.cacheParams.maxObstacles, nullptr);
     // duDebugDrawNavMesh(&_debugDraw, *_navMesh, DU_DRAWNAVMESH_OFFMESHCONS);
     return true;
@@ -412,6 +439,7 @@ void ax::NavMesh::drawAgents()
 
 void NavMesh::removeNavMeshObstacle(NavMeshObstacle* obstacle)
 {
+    waitForAsyncUpdate();
     auto iter = std::find(_obstacleList.begin(), _obstacleList.end(), obstacle);
     if (iter != _obstacleList.end())
     {
@@ -423,6 +451,7 @@ void NavMesh::removeNavMeshObstacle(NavMeshObstacle* obstacle)
 
 void NavMesh::addNavMeshObstacle(NavMeshObstacle* obstacle)
 {
+    waitForAsyncUpdate();
     auto iter = std::find(_obstacleList.begin(), _obstacleList.end(), nullptr);
     if (iter != _obstacleList.end())
     {
@@ -434,11 +463,13 @@ void NavMesh::addNavMeshObstacle(NavMeshObstacle* obstacle)
 
 void NavMesh::removeNavMeshAgent(NavMeshAgent* agent)
 {
+    waitForAsyncUpdate();
     auto iter = std::find(_agentList.begin(), _agentList.end(), agent);
     if (iter != _agentList.end())
     {
         agent->removeFrom(_crowed);
         agent->setNavMeshQuery(nullptr);
+        agent->_navMesh = nullptr;
         agent->release();
         _agentList[iter - _agentList.begin()] = nullptr;
     }
@@ -446,11 +477,13 @@ void NavMesh::removeNavMeshAgent(NavMeshAgent* agent)
 
 void NavMesh::addNavMeshAgent(NavMeshAgent* agent)
 {
+    waitForAsyncUpdate();
     auto iter = std::find(_agentList.begin(), _agentList.end(), nullptr);
     if (iter != _agentList.end())
     {
         agent->addTo(_crowed);
         agent->setNavMeshQuery(_navMeshQuery);
+        agent->_navMesh = this;
         agent->retain();
         _agentList[iter - _agentList.begin()] = agent;
     }
@@ -470,6 +503,7 @@ void NavMesh::debugDraw(Renderer* renderer)
 {
     if (_isDebugDrawEnabled)
     {
+        waitForAsyncUpdate();
         _debugDraw.clear();
         dtDraw();
         _debugDraw.draw(renderer);
@@ -477,6 +511,65 @@ void NavMesh::debugDraw(Renderer* renderer)
 }
 
 void NavMesh::update(float dt)
+{
+    waitForAsyncUpdate();
+
+    _runningQueries.swap(_pendingQueries);
+    preUpdate(dt);
+    _asyncUpdateDelta   = dt;
+    _asyncUpdatePending = true;
+
+    if (!_asyncUpdateEnabled)
+    {
+        stepNavigation(dt);
+        waitForAsyncUpdate();
+        return;
+    }
+
+    // the destructor waits for the step, so the mesh outlives it
+    _asyncUpdateRunning = true;
+    AsyncTaskPool::getInstance()->enqueue(AsyncTaskPool::TaskType::TASK_OTHER, [this, dt]() {
+        stepNavigation(dt);
+
+        std::lock_guard<std::mutex> lock(_asyncUpdateMutex);
+        _asyncUpdateRunning = false;
+        _asyncUpdateDone.notify_all();
+    });
+}
+
+void NavMesh::setAsyncUpdateEnabled(bool enabled)
+{
+    if (!enabled)
+        waitForAsyncUpdate();
+    _asyncUpdateEnabled = enabled;
+}
+
+void NavMesh::waitForAsyncUpdate()
+{
+    if (!_asyncUpdatePending)
+        return;
+
+    {
+        std::unique_lock<std::mutex> lock(_asyncUpdateMutex);
+        _asyncUpdateDone.wait(lock, [this]() { return !_asyncUpdateRunning; });
+    }
+
+    // cleared first, the agents read the crowd back through this method
+    _asyncUpdatePending = false;
+    postUpdate(_asyncUpdateDelta);
+
+    auto queries = std::move(_runningQueries);
+    _runningQueries.clear();
+    for (auto&& query : queries)
+    {
+        if (query.pathCallback)
+            query.pathCallback(query.pathPoints);
+        else if (query.raycastCallback)
+            query.raycastCallback(query.raycastResult);
+    }
+}
+
+void NavMesh::preUpdate(float dt)
 {
     for (auto&& iter : _agentList)
     {
@@ -490,12 +583,21 @@ void NavMesh::update(float dt)
             iter->preUpdate(dt);
     }
 
-    if (_crowed)
-        _crowed->update(dt, nullptr);
-
-    if (_tileCache)
-        _tileCache->update(dt, _navMesh);
+    // one query object per partition, the agents keep using the shared one
+    if (!_runningQueries.empty() && _navMesh)
+    {
+        size_t poolSize = std::min(_runningQueries.size(), (size_t)JobSystem::getInstance()->getWorkerCount() + 1);
+        while (_queryPool.size() < poolSize)
+        {
+            auto query = dtAllocNavMeshQuery();
+            query->init(_navMesh, MAX_QUERY_NODES);
+            _queryPool.emplace_back(query);
+        }
+    }
+}
 
+void NavMesh::postUpdate(float dt)
+{
     for (auto&& iter : _agentList)
     {
         if (iter)
@@ -509,10 +611,120 @@ void NavMesh::update(float dt)
     }
 }
 
+void NavMesh::stepNavigation(float dt)
+{
+    // the crowd and the queries only read the mesh, so they run side by side before the tiles are rebuilt
+    int queryCount = _navMesh ? static_cast<int>(_runningQueries.size()) : 0;
+    int partitions = std::min(queryCount, static_cast<int>(_queryPool.size()));
+    int chunkSize  = partitions ? (queryCount + partitions - 1) / partitions : 0;
+    if (partitions)
+    {
+        JobSystem::getInstance()->parallelFor(partitions + 1, 1, [&](int begin, int end) {
+            for (int i = begin; i < end; ++i)
+            {
+                if (i == partitions)
+                {
+                    if (_crowed)
+                        _crowed->update(dt, nullptr);
+                }
+                else
+                    runQueries(i * chunkSize, std::min(queryCount, (i + 1) * chunkSize), _queryPool[i]);
+            }
+        });
+    }
+    else if (_crowed)
+        _crowed->update(dt, nullptr);
+
+    if (_tileCache)
+    {
+        for (int i = 0; i < _maxTileRebuilds; ++i)
+        {
+            bool upToDate = true;
+            _tileCache->update(dt, _navMesh, &upToDate);
+            if (upToDate)
+                break;
+        }
+    }
+}
+
+void NavMesh::runQueries(int begin, int end, dtNavMeshQuery* navMeshQuery)
+{
+    for (int i = begin; i < end; ++i)
+    {
+        auto& query = _runningQueries[i];
+        if (query.pathCallback)
+            findSmoothPath(navMeshQuery, _navMesh, query.start, query.end, query.pathPoints);
+        else
+            query.raycastResult = raycastSurface(navMeshQuery, query.start, query.end);
+    }
+}
+
+void NavMesh::findPathAsync(const Vec3& start, const Vec3& end, FindPathCallback callback)
+{
+    Query query;
+    query.start        = start;
+    query.end          = end;
+    query.pathCallback = std::move(callback);
+    _pendingQueries.emplace_back(std::move(query));
+}
+
+void NavMesh::raycastAsync(const Vec3& start, const Vec3& end, RaycastCallback callback)
+{
+    Query query;
+    query.start           = start;
+    query.end             = end;
+    query.raycastCallback = std::move(callback);
+    _pendingQueries.emplace_back(std::move(query));
+}
+
+NavMesh::RaycastResult NavMesh::raycast(const Vec3& start, const Vec3& end)
+{
+    waitForAsyncUpdate();
+    return raycastSurface(_navMeshQuery, start, end);
+}
+
 void ax::NavMesh::findPath(const Vec3& start, const Vec3& end, std::vector<Vec3>& pathPoints)
 {
-    static const int MAX_POLYS  = 256;
-    static const int MAX_SMOOTH = 2048;
+    waitForAsyncUpdate();
+    findSmoothPath(_navMeshQuery, _navMesh, start, end, pathPoints);
+}
+
+static NavMesh::RaycastResult raycastSurface(dtNavMeshQuery* navMeshQuery, const Vec3& start, const Vec3& end)
+{
+    float ext[3];
+    ext[0] = 2;
+    ext[1] = 4;
+    ext[2] = 2;
+    dtQueryFilter filter;
+    dtPolyRef startRef = 0;
+    float startPos[3];
+    NavMesh::RaycastResult result;
+    result.hitPoint = end;
+    navMeshQuery->findNearestPoly(&start.x, ext, &filter, &startRef, startPos);
+    if (!startRef)
+        return result;
+
+    float t = 0;
+    float hitNormal[3]{};
+    dtPolyRef polys[MAX_POLYS];
+    int npolys = 0;
+    navMeshQuery->raycast(startRef, startPos, &end.x, &filter, &t, hitNormal, polys, &npolys, MAX_POLYS);
+    if (t <= 1.0f)
+    {
+        // t is the fraction of the segment walked before hitting a wall
+        result.hit = true;
+        dtVlerp(&result.hitPoint.x, startPos, &end.x, t);
+        result.hitNormal.set(hitNormal[0], hitNormal[1], hitNormal[2]);
+    }
+    return result;
+}
+
+static void findSmoothPath(dtNavMeshQuery* navMeshQuery,
+                           dtNavMesh* navMesh,
+                           const Vec3& start,
+                           const Vec3& end,
+                           std::vector<Vec3>& pathPoints)
+{
     float ext[3];
     ext[0] = 2;
     ext[1] = 4;
@@ -521,9 +733,9 @@ void ax::NavMesh::findPath(const Vec3& start, const Vec3& end, std::vector<Vec3>
     dtPolyRef startRef, endRef;
     dtPolyRef polys[MAX_POLYS];
     int npolys = 0;
-    _navMeshQuery->findNearestPoly(&start.x, ext, &filter, &startRef, 0);
-    _navMeshQuery->findNearestPoly(&end.x, ext, &filter, &endRef, 0);
-    _navMeshQuery->findPath(startRef, endRef, &start.x, &end.x, &filter, polys, &npolys, MAX_POLYS);
+    navMeshQuery->findNearestPoly(&start.x, ext, &filter, &startRef, 0);
+    navMeshQuery->findNearestPoly(&end.x, ext, &filter, &endRef, 0);
+    navMeshQuery->findPath(startRef, endRef, &start.x, &end.x, &filter, polys, &npolys, MAX_POLYS);
 
     if (npolys)
     {
@@ -533,8 +745,8 @@ void ax::NavMesh::findPath(const Vec3& start, const Vec3& end, std::vector<Vec3>
         // int npolys = npolys;
 
         float iterPos[3], targetPos[3];
-        _navMeshQuery->closestPointOnPoly(startRef, &start.x, iterPos, 0);
-        _navMeshQuery->closestPointOnPoly(polys[npolys - 1], &end.x, targetPos, 0);
+        navMeshQuery->closestPointOnPoly(startRef, &start.x, iterPos, 0);
+        navMeshQuery->closestPointOnPoly(polys[npolys - 1], &end.x, targetPos, 0);
 
         static const float STEP_SIZE = 0.5f;
         static const float SLOP      = 0.01f;
@@ -555,7 +767,7 @@ void ax::NavMesh::findPath(const Vec3& start, const Vec3& end, std::vector<Vec3>
             unsigned char steerPosFlag;
             dtPolyRef steerPosRef;
 
-            if (!getSteerTarget(_navMeshQuery, iterPos, targetPos, SLOP, polys, npolys, steerPos, steerPosFlag,
+            if (!getSteerTarget(navMeshQuery, iterPos, targetPos, SLOP, polys, npolys, steerPos, steerPosFlag,
                                 steerPosRef))
                 break;
 
@@ -578,13 +790,13 @@ void ax::NavMesh::findPath(const Vec3& start, const Vec3& end, std::vector<Vec3>
             float result[3];
             dtPolyRef visited[16];
             int nvisited = 0;
-            _navMeshQuery->moveAlongSurface(polys[0], iterPos, moveTgt, &filter, result, visited, &nvisited, 16);
+            navMeshQuery->moveAlongSurface(polys[0], iterPos, moveTgt, &filter, result, visited, &nvisited, 16);
 
             npolys = fixupCorridor(polys, npolys, MAX_POLYS, visited, nvisited);
-            npolys = fixupShortcuts(polys, npolys, _navMeshQuery);
+            npolys = fixupShortcuts(polys, npolys, navMeshQuery);
 
             float h = 0;
-            _navMeshQuery->getPolyHeight(polys[0], result, &h);
+            navMeshQuery->getPolyHeight(polys[0], result, &h);
             result[1] = h;
             dtVcopy(iterPos, result);
 
@@ -621,7 +833,7 @@ void ax::NavMesh::findPath(const Vec3& start, const Vec3& end, std::vector<Vec3>
                 npolys -= npos;
 
                 // Handle the connection.
-                dtStatus status = _navMesh->getOffMeshConnectionPolyEndPoints(prevRef, polyRef, startPos, endPos);
+                dtStatus status = navMesh->getOffMeshConnectionPolyEndPoints(prevRef, polyRef, startPos, endPos);
                 if (dtStatusSucceed(status))
                 {
                     if (nsmoothPath < MAX_SMOOTH)
@@ -642,7 +854,7 @@ void ax::NavMesh::findPath(const Vec3& start, const Vec3& end, std::vector<Vec3>
                     // Move position at the other side of the off-mesh link.
                     dtVcopy(iterPos, endPos);
                     float eh = 0.0f;
-                    _navMeshQuery->getPolyHeight(polys[0], iterPos, &eh);
+                    navMeshQuery->getPolyHeight(polys[0], iterPos, &eh);
                     iterPos[1] = eh;
                 }
             }
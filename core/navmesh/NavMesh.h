@@ -35,6 +35,9 @@
 #    include "recast/DetourNavMeshQuery.h"
 #    include "recast/DetourCrowd.h"
 #    include "recast/DetourTileCache.h"
+#    include <condition_variable>
+#    include <functional>
+#    include <mutex>
 #    include <string>
 #    include <vector>
 
@@ -54,13 +57,25 @@ class Renderer;
 class AX_DLL NavMesh : public Ref
 {
 public:
+    /** The result of a raycast along the navmesh surface. */
+    struct RaycastResult
+    {
+        bool hit = false;  ///< Whether a wall was hit before the end position.
+        Vec3 hitPoint;     ///< The hit position, or the end position when nothing was hit.
+        Vec3 hitNormal;    ///< The normal of the wall that was hit.
+    };
+
+    typedef std::function<void(const std::vector<Vec3>& pathPoints)> FindPathCallback;
+    typedef std::function<void(const RaycastResult& result)> RaycastCallback;
+
     /**
     Create navmesh
 
     @param navFilePath The NavMesh File path.
     @param geomFilePath The geometry File Path,include offmesh information,etc.
+    @param maxAgents The maximum number of agents in the crowd.
     */
-    static NavMesh* create(std::string_view navFilePath, std::string_view geomFilePath);
+    static NavMesh* create(std::string_view navFilePath, std::string_view geomFilePath, int maxAgents = 128);
 
     /** update navmesh. */
     void update(float dt);
@@ -95,11 +110,45 @@ public:
     */
     void findPath(const Vec3& start, const Vec3& end, std::vector<Vec3>& pathPoints);
 
+    /**
+    Queue a path query, the queued queries are run in parallel during the next update.
+
+    @param callback Called on the main thread with the key points of the path, empty if there is none.
+    */
+    void findPathAsync(const Vec3& start, const Vec3& end, FindPathCallback callback);
+
+    /**
+    Cast a ray along the navmesh surface from start towards end.
+
+    @param start The start position in world coordinate system, it is snapped to the nearest polygon.
+    @param end The end position in world coordinate system.
+    */
+    RaycastResult raycast(const Vec3& start, const Vec3& end);
+
+    /** Queue a raycast, the queued queries are run in parallel during the next update. */
+    void raycastAsync(const Vec3& start, const Vec3& end, RaycastCallback callback);
+
+    /**
+    Run the tile rebuilds, the crowd and the queued queries on a worker thread.
+
+    Each update then applies the results of the previous one and starts the next step, so agents and obstacles
+    trail by one frame. Any method touching the navmesh waits for the step in flight first. Disabled by default.
+    */
+    void setAsyncUpdateEnabled(bool enabled);
+    bool isAsyncUpdateEnabled() const { return _asyncUpdateEnabled; }
+
+    /** Set how many dirty tiles may be rebuilt per update, 1 by default. */
+    void setMaxTileRebuildsPerUpdate(int count) { _maxTileRebuilds = count; }
+    int getMaxTileRebuildsPerUpdate() const { return _maxTileRebuilds; }
+
+    /** Wait for the asynchronous step in flight, if any, and apply its results. */
+    void waitForAsyncUpdate();
+
     NavMesh();
     virtual ~NavMesh();
 
 protected:
-    bool initWithFilePath(std::string_view navFilePath, std::string_view geomFilePath);
+    bool initWithFilePath(std::string_view navFilePath, std::string_view geomFilePath, int maxAgents);
     bool read();
     bool loadNavMeshFile();
     bool loadGeomFile();
@@ -107,6 +156,20 @@ protected:
     void drawAgents();
     void drawObstacles();
     void drawOffMeshConnections();
+    void preUpdate(float dt);
+    void postUpdate(float dt);
+    void stepNavigation(float dt);
+    void runQueries(int begin, int end, dtNavMeshQuery* query);
+
+    struct Query
+    {
+        Vec3 start;
+        Vec3 end;
+        FindPathCallback pathCallback;
+        RaycastCallback raycastCallback;
+        std::vector<Vec3> pathPoints;
+        RaycastResult raycastResult;
+    };
 
 protected:
     dtNavMesh* _navMesh;
@@ -123,7 +186,21 @@ protected:
     NavMeshDebugDraw _debugDraw;
     std::string _navFilePath;
     std::string _geomFilePath;
+    int _maxAgents;
     bool _isDebugDrawEnabled;
+
+    // queries waiting for the next update, and the ones being run
+    std::vector<Query> _pendingQueries;
+    std::vector<Query> _runningQueries;
+    std::vector<dtNavMeshQuery*> _queryPool;
+
+    bool _asyncUpdateEnabled;
+    bool _asyncUpdatePending;
+    bool _asyncUpdateRunning;
+    float _asyncUpdateDelta;
+    int _maxTileRebuilds;
+    std::mutex _asyncUpdateMutex;
+    std::condition_variable _asyncUpdateDone;
 };
 
 /** @} */
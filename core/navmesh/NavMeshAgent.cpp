@@ -78,6 +78,7 @@ ax::NavMeshAgent::NavMeshAgent()
     , _userData(nullptr)
     , _crowd(nullptr)
     , _navMeshQuery(nullptr)
+    , _navMesh(nullptr)
 {}
 
 ax::NavMeshAgent::~NavMeshAgent() {}
@@ -94,6 +95,12 @@ void ax::NavMeshAgent::setNavMeshQuery(dtNavMeshQuery* query)
     _navMeshQuery = query;
 }
 
+void NavMeshAgent::waitForNavMesh() const
+{
+    if (_navMesh)
+        _navMesh->waitForAsyncUpdate();
+}
+
 void ax::NavMeshAgent::removeFrom(dtCrowd* crowed)
 {
     crowed->removeAgent(_agentID);
@@ -179,6 +186,7 @@ unsigned char NavMeshAgent::getObstacleAvoidanceType() const
 
 Vec3 NavMeshAgent::getCurrentVelocity() const
 {
+    waitForNavMesh();
     if (_crowd)
     {
         auto agent = _crowd->getAgent(_agentID);
@@ -239,6 +247,7 @@ void NavMeshAgent::move(const Vec3& destination, const MoveCallback& callback)
 
 OffMeshLinkData NavMeshAgent::getCurrentOffMeshLinkData()
 {
+    waitForNavMesh();
     OffMeshLinkData data;
     if (_crowd && isOnOffMeshLink())
     {
@@ -271,6 +280,7 @@ void ax::NavMeshAgent::completeOffMeshLink()
 
 void NavMeshAgent::setAutoTraverseOffMeshLink(bool isAuto)
 {
+    waitForNavMesh();
     if (_crowd && isOnOffMeshLink())
     {
         auto agentAnim = _crowd->getEditableAgentAnim(_agentID);
@@ -348,6 +358,7 @@ void NavMeshAgent::postUpdate(float /*delta*/)
 
 void NavMeshAgent::syncToNode()
 {
+    waitForNavMesh();
     const dtCrowdAgent* agent = nullptr;
     if (_crowd)
     {
@@ -384,6 +395,7 @@ void NavMeshAgent::syncToNode()
 
 void NavMeshAgent::syncToAgent()
 {
+    waitForNavMesh();
     if (_crowd)
     {
         auto agent     = _crowd->getEditableAgent(_agentID);
@@ -410,6 +422,7 @@ void NavMeshAgent::syncToAgent()
 
 Vec3 NavMeshAgent::getVelocity() const
 {
+    waitForNavMesh();
     const dtCrowdAgent* agent = nullptr;
     if (_crowd)
     {
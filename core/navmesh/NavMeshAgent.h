@@ -37,6 +37,8 @@
 class dtNavMeshQuery;
 NS_AX_BEGIN
 
+class NavMesh;
+
 /**
  * @addtogroup 3d
  * @{
@@ -209,6 +211,8 @@ private:
     void preUpdate(float delta);
     void postUpdate(float delta);
     static void convertTodtAgentParam(const NavMeshAgentParam& inParam, dtCrowdAgentParams& outParam);
+    // waits for an asynchronous navmesh update before touching the crowd
+    void waitForNavMesh() const;
 
 private:
     MoveCallback _moveCallback;
@@ -226,6 +230,7 @@ private:
     void* _userData;
     dtCrowd* _crowd;
     dtNavMeshQuery* _navMeshQuery;
+    NavMesh* _navMesh;
 };
 
 /** @} */
@@ -904,7 +904,7 @@ Vec2 PhysicsBody::local2World(const Vec2& point)
     return PhysicsHelper::cpv2vec2(cpBodyLocalToWorld(_cpBody, PhysicsHelper::vec22cpv(point)));
 }
 
-void PhysicsBody::beforeSimulation(const Mat4& parentToWorldTransform,
+void PhysicsBody::beforeSimulation(const Mat4& worldToParentTransform,
                                    const Mat4& nodeToWorldTransform,
                                    float scaleX,
                                    float scaleY,
@@ -933,22 +933,21 @@ void PhysicsBody::beforeSimulation(const Mat4& parentToWorldTransform,
 
     if (_owner->getAnchorPoint() != Vec2::ANCHOR_MIDDLE)
     {
-        parentToWorldTransform.getInversed().transformVector(worldPosition.x, worldPosition.y, worldPosition.z, 1.f,
-                                                             &worldPosition);
+        worldToParentTransform.transformVector(worldPosition.x, worldPosition.y, worldPosition.z, 1.f, &worldPosition);
         _offset.x = worldPosition.x - _owner->getPositionX();
         _offset.y = worldPosition.y - _owner->getPositionY();
     }
 }
 
-void PhysicsBody::afterSimulation(const Mat4& parentToWorldTransform, float parentRotation)
+void PhysicsBody::afterSimulation(const Mat4& worldToParentTransform, float parentRotation)
 {
     // set Node position
     auto tmp = getPosition();
     Vec3 positionInParent(tmp.x, tmp.y, 0.f);
     if (_recordPosX != positionInParent.x || _recordPosY != positionInParent.y)
     {
-        parentToWorldTransform.getInversed().transformVector(positionInParent.x, positionInParent.y, positionInParent.z,
-                                                             1.f, &positionInParent);
+        worldToParentTransform.transformVector(positionInParent.x, positionInParent.y, positionInParent.z, 1.f,
+                                               &positionInParent);
         _owner->setPosition(positionInParent.x - _offset.x, positionInParent.y - _offset.y);
     }
 
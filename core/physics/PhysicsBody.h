@@ -558,12 +558,12 @@ protected:
     void addToPhysicsWorld();
     void removeFromPhysicsWorld();
 
-    void beforeSimulation(const Mat4& parentToWorldTransform,
+    void beforeSimulation(const Mat4& worldToParentTransform,
                           const Mat4& nodeToWorldTransform,
                           float scaleX,
                           float scaleY,
                           float rotation);
-    void afterSimulation(const Mat4& parentToWorldTransform, float parentRotation);
+    void afterSimulation(const Mat4& worldToParentTransform, float parentRotation);
 
 protected:
     std::vector<PhysicsJoint*> _joints;
@@ -924,8 +924,7 @@ void PhysicsWorld::update(float delta, bool userCall /* = false*/)
         updateBodies();
     }
 
-    auto sceneToWorldTransform = _scene->getNodeToParentTransform();
-    beforeSimulation(_scene, sceneToWorldTransform, 1.f, 1.f, 0.f);
+    beforeSimulation();
 
     if (!_delayAddJoints.empty() || !_delayRemoveJoints.empty())
     {
@@ -990,9 +989,8 @@ void PhysicsWorld::update(float delta, bool userCall /* = false*/)
         debugDraw();
     }
 
-    // Update physics position, should loop as the same sequence as node tree.
-    // PhysicsWorld::afterSimulation() will depend on the sequence.
-    afterSimulation(_scene, sceneToWorldTransform, 0.f);
+    // Update physics position, the transforms are all read before any node is moved so the order does not matter.
+    afterSimulation();
 
     if (_postUpdateCallback)
         _postUpdateCallback();  // fix #11154
@@ -1044,41 +1042,107 @@ PhysicsWorld::~PhysicsWorld()
     AX_SAFE_RELEASE_NULL(_debugDraw);
 }
 
-void PhysicsWorld::beforeSimulation(Node* node,
-                                    const Mat4& parentToWorldTransform,
-                                    float nodeParentScaleX,
-                                    float nodeParentScaleY,
-                                    float parentRotation)
+void PhysicsWorld::beforeSimulation()
 {
-    auto scaleX   = nodeParentScaleX * node->getScaleX();
-    auto scaleY   = nodeParentScaleY * node->getScaleY();
-    auto rotation = parentRotation + node->getRotation();
+    resetNodeTransforms();
+    for (auto&& body : _bodies)
+    {
+        auto owner = body->getOwner();
+        int index  = owner ? cacheNodeTransform(owner) : -1;
+        if (index < 0)
+            continue;
+
+        auto& transform = _nodeTransforms[index];
+        body->beforeSimulation(getWorldToNodeTransform(transform.parent), transform.nodeToWorld, transform.scaleX,
+                               transform.scaleY, transform.rotation);
+    }
+}
 
-    auto nodeToWorldTransform = parentToWorldTransform * node->getNodeToParentTransform();
+void PhysicsWorld::afterSimulation()
+{
+    resetNodeTransforms();
+
+    // every transform is cached before the first node moves, like the parents were seen by the old tree walk
+    const int bodyCount = static_cast<int>(_bodies.size());
+    _bodyParents.assign(bodyCount, -1);
+    for (int i = 0; i < bodyCount; ++i)
+    {
+        auto owner = _bodies.at(i)->getOwner();
+        int index  = owner ? cacheNodeTransform(owner) : -1;
+        if (index >= 0)
+        {
+            _bodyParents[i] = _nodeTransforms[index].parent;
+            getWorldToNodeTransform(_bodyParents[i]);
+        }
+    }
 
-    auto physicsBody = node->getPhysicsBody();
-    if (physicsBody)
+    for (int i = 0; i < bodyCount; ++i)
     {
-        physicsBody->beforeSimulation(parentToWorldTransform, nodeToWorldTransform, scaleX, scaleY, rotation);
+        if (_bodyParents[i] >= 0)
+        {
+            auto& parent = _nodeTransforms[_bodyParents[i]];
+            _bodies.at(i)->afterSimulation(parent.worldToNode, parent.rotation);
+        }
     }
+}
 
-    for (auto&& child : node->getChildren())
-        beforeSimulation(child, nodeToWorldTransform, scaleX, scaleY, rotation);
+void PhysicsWorld::resetNodeTransforms()
+{
+    _nodeTransforms.clear();
+    _nodeTransformIndices.clear();
+
+    // the parent of the scene, the scene transform is applied on top of itself as the old tree walk did
+    NodeTransform root;
+    root.nodeToWorld = _scene->getNodeToParentTransform();
+    root.scaleX      = 1.f;
+    root.scaleY      = 1.f;
+    root.rotation    = 0.f;
+    root.parent      = -1;
+    root.hasInverse  = false;
+    _nodeTransforms.emplace_back(root);
 }
 
-void PhysicsWorld::afterSimulation(Node* node, const Mat4& parentToWorldTransform, float parentRotation)
+int PhysicsWorld::cacheNodeTransform(Node* node)
 {
-    auto nodeToWorldTransform = parentToWorldTransform * node->getNodeToParentTransform();
-    auto nodeRotation         = parentRotation + node->getRotation();
+    auto it = _nodeTransformIndices.find(node);
+    if (it != _nodeTransformIndices.end())
+        return it->second;
+
+    int parentIndex = 0;
+    if (node != _scene)
+    {
+        auto parent = node->getParent();
+        parentIndex = parent ? cacheNodeTransform(parent) : -1;
+    }
 
-    auto physicsBody = node->getPhysicsBody();
-    if (physicsBody)
+    int index = -1;
+    if (parentIndex >= 0)
     {
-        physicsBody->afterSimulation(parentToWorldTransform, parentRotation);
+        NodeTransform transform;
+        const auto& parent    = _nodeTransforms[parentIndex];
+        transform.nodeToWorld = parent.nodeToWorld * node->getNodeToParentTransform();
+        transform.scaleX      = parent.scaleX * node->getScaleX();
+        transform.scaleY      = parent.scaleY * node->getScaleY();
+        transform.rotation    = parent.rotation + node->getRotation();
+        transform.parent      = parentIndex;
+        transform.hasInverse  = false;
+
+        index = static_cast<int>(_nodeTransforms.size());
+        _nodeTransforms.emplace_back(transform);
     }
+    _nodeTransformIndices.emplace(node, index);
+    return index;
+}
 
-    for (auto&& child : node->getChildren())
-        afterSimulation(child, nodeToWorldTransform, nodeRotation);
+const Mat4& PhysicsWorld::getWorldToNodeTransform(int index)
+{
+    auto& transform = _nodeTransforms[index];
+    if (!transform.hasInverse)
+    {
+        transform.worldToNode = transform.nodeToWorld.getInversed();
+        transform.hasInverse  = true;
+    }
+    return transform.worldToNode;
 }
 
 void PhysicsWorld::setPostUpdateCallback(const std::function<void()>& callback)
@@ -30,6 +30,7 @@
 #if AX_USE_PHYSICS
 
 #    include <list>
+#    include <unordered_map>
 #    include "base/Vector.h"
 #    include "math/Math.h"
 #    include "physics/PhysicsBody.h"
@@ -427,16 +428,34 @@ protected:
     std::function<void()> _preUpdateCallback;
     std::function<void()> _postUpdateCallback;
 
+    /** A node transform accumulated from the scene down, as the bodies see it. */
+    struct NodeTransform
+    {
+        Mat4 nodeToWorld;
+        Mat4 worldToNode;
+        float scaleX;
+        float scaleY;
+        float rotation;
+        int parent;
+        bool hasInverse;
+    };
+
+    // rebuilt each sync, only the ancestors of the bodies are visited
+    std::vector<NodeTransform> _nodeTransforms;
+    std::unordered_map<Node*, int> _nodeTransformIndices;
+    std::vector<int> _bodyParents;
+
 protected:
     PhysicsWorld();
     virtual ~PhysicsWorld();
 
-    void beforeSimulation(Node* node,
-                          const Mat4& parentToWorldTransform,
-                          float nodeParentScaleX,
-                          float nodeParentScaleY,
-                          float parentRotation);
-    void afterSimulation(Node* node, const Mat4& parentToWorldTransform, float parentRotation);
+    void beforeSimulation();
+    void afterSimulation();
+
+    void resetNodeTransforms();
+    /** Index of the node in _nodeTransforms, -1 if the node is not in the scene. */
+    int cacheNodeTransform(Node* node);
+    const Mat4& getWorldToNodeTransform(int index);
 
     friend class Node;
     friend class Sprite;
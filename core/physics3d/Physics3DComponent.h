@@ -132,6 +132,9 @@ protected:
 
     void postSimulate();
 
+    /** The owner's local transform matching the physics object, thread safe as it only reads the physics object. */
+    void computeNodeTransform(const ax::Mat4& parentInverse, ax::Vec3* translation, ax::Quaternion* rotation) const;
+
     ax::Mat4 _transformInPhysics;  // transform in physics space
     ax::Mat4 _invTransformInPhysics;
 
@@ -25,22 +25,91 @@
 
 #include "physics3d/Physics3D.h"
 #include "renderer/Renderer.h"
+#include "base/JobSystem.h"
 
 #if AX_USE_3D_PHYSICS
 
 #    if (AX_ENABLE_BULLET_INTEGRATION)
 
+#        if BT_THREADSAFE
+#            include "bullet/BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h"
+#            include "bullet/BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h"
+#            include "bullet/BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h"
+#        endif
+
 NS_AX_BEGIN
 
+// below these counts the work is done on the calling thread
+static const int TRANSFORM_SYNC_GRAIN = 256;
+static const int CONTACT_GRAIN        = 64;
+
+#        if BT_THREADSAFE
+/** Runs bullet's parallel loops on the JobSystem workers. */
+class Physics3DTaskScheduler : public btITaskScheduler
+{
+public:
+    Physics3DTaskScheduler() : btITaskScheduler("axmol") {}
+
+    int getMaxNumThreads() const override
+    {
+        return std::min(JobSystem::getInstance()->getWorkerCount() + 1, (int)BT_MAX_THREAD_COUNT);
+    }
+    int getNumThreads() const override { return getMaxNumThreads(); }
+    void setNumThreads(int /*numThreads*/) override {}
+
+    void parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body) override
+    {
+        JobSystem::getInstance()->parallelFor(iEnd - iBegin, grainSize, [&](int begin, int end) {
+            body.forLoop(iBegin + begin, iBegin + end);
+        });
+    }
+
+    btScalar parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody& body) override
+    {
+        std::mutex mutex;
+        btScalar sum = 0;
+        JobSystem::getInstance()->parallelFor(iEnd - iBegin, grainSize, [&](int begin, int end) {
+            btScalar partial = body.sumLoop(iBegin + begin, iBegin + end);
+            std::lock_guard<std::mutex> lock(mutex);
+            sum += partial;
+        });
+        return sum;
+    }
+};
+
+static btITaskScheduler* getTaskScheduler()
+{
+    static Physics3DTaskScheduler scheduler;
+    if (btGetTaskScheduler() != &scheduler)
+    {
+        // bullet numbers threads in call order, the main thread must be 0
+        btGetCurrentThreadIndex();
+        btSetTaskScheduler(&scheduler);
+    }
+    return &scheduler;
+}
+#        endif
+
+static btCollisionObject* getbtCollisionObject(Physics3DObject* physicsObj)
+{
+    if (physicsObj->getObjType() == Physics3DObject::PhysicsObjType::RIGID_BODY)
+        return static_cast<Physics3DRigidBody*>(physicsObj)->getRigidBody();
+    if (physicsObj->getObjType() == Physics3DObject::PhysicsObjType::COLLIDER)
+        return static_cast<Physics3DCollider*>(physicsObj)->getGhostObject();
+    return nullptr;
+}
+
 Physics3DWorld::Physics3DWorld()
     : _needCollisionChecking(false)
     , _collisionCheckingFlag(false)
     , _needGhostPairCallbackChecking(false)
+    , _multiThreadingEnabled(false)
     , _btPhyiscsWorld(nullptr)
     , _collisionConfiguration(nullptr)
     , _dispatcher(nullptr)
     , _broadphase(nullptr)
     , _solver(nullptr)
+    , _solverPool(nullptr)
     , _ghostCallback(nullptr)
     , _debugDrawer(nullptr)
 {}
@@ -54,6 +123,9 @@ Physics3DWorld::~Physics3DWorld()
     AX_SAFE_DELETE(_broadphase);
     AX_SAFE_DELETE(_ghostCallback);
     AX_SAFE_DELETE(_solver);
+#        if BT_THREADSAFE
+    AX_SAFE_DELETE(_solverPool);
+#        endif
     AX_SAFE_DELETE(_btPhyiscsWorld);
     AX_SAFE_DELETE(_debugDrawer);
     for (auto&& it : _physicsComponents)
@@ -81,25 +153,50 @@ Vec3 Physics3DWorld::getGravity() const
 
 bool Physics3DWorld::init(Physics3DWorldDes* info)
 {
-    /// collision configuration contains default setup for memory, collision setup
-    _collisionConfiguration = new btDefaultCollisionConfiguration();
-    //_collisionConfiguration->setConvexConvexMultipointIterations();
-
-    /// use the default collision dispatcher. For parallel processing you can use a different dispatcher (see
-    /// Extras/BulletMultiThreaded)
-    _dispatcher = new btCollisionDispatcher(_collisionConfiguration);
-
     _broadphase = new btDbvtBroadphase();
 
-    /// the default constraint solver. For parallel processing you can use a different solver (see
-    /// Extras/BulletMultiThreaded)
-    btSequentialImpulseConstraintSolver* sol = new btSequentialImpulseConstraintSolver();
-    _solver                                  = sol;
-
     btGhostPairCallback* ghostCallback = new btGhostPairCallback();
     _ghostCallback                     = ghostCallback;
 
-    _btPhyiscsWorld = new btDiscreteDynamicsWorld(_dispatcher, _broadphase, _solver, _collisionConfiguration);
+#        if BT_THREADSAFE
+    if (info->isMultiThreadingEnabled)
+    {
+        auto scheduler = getTaskScheduler();
+
+        // the pools are shared by all threads, size them for large scenes
+        btDefaultCollisionConstructionInfo cci;
+        cci.m_defaultMaxPersistentManifoldPoolSize = 80000;
+        cci.m_defaultMaxCollisionAlgorithmPoolSize = 80000;
+        _collisionConfiguration                    = new btDefaultCollisionConfiguration(cci);
+
+        _dispatcher = new btCollisionDispatcherMt(_collisionConfiguration, 40);
+
+        // small islands are solved in parallel by the pool, large ones by the parallel solver
+        _solverPool = new btConstraintSolverPoolMt(scheduler->getNumThreads());
+        _solver     = new btSequentialImpulseConstraintSolverMt();
+
+        _btPhyiscsWorld =
+            new btDiscreteDynamicsWorldMt(_dispatcher, _broadphase, _solverPool, _solver, _collisionConfiguration);
+        _multiThreadingEnabled = true;
+    }
+    else
+#        else
+    if (info->isMultiThreadingEnabled)
+        AXLOG("Physics3DWorld: bullet is built without BT_THREADSAFE, stepping on the main thread");
+#        endif
+    {
+        /// collision configuration contains default setup for memory, collision setup
+        _collisionConfiguration = new btDefaultCollisionConfiguration();
+        //_collisionConfiguration->setConvexConvexMultipointIterations();
+
+        /// use the default collision dispatcher
+        _dispatcher = new btCollisionDispatcher(_collisionConfiguration);
+
+        /// the default constraint solver
+        _solver = new btSequentialImpulseConstraintSolver();
+
+        _btPhyiscsWorld = new btDiscreteDynamicsWorld(_dispatcher, _broadphase, _solver, _collisionConfiguration);
+    }
     _btPhyiscsWorld->setGravity(convertVec3TobtVector3(info->gravity));
     if (info->isDebugDrawEnabled)
     {
@@ -131,6 +228,8 @@ void Physics3DWorld::addPhysics3DObject(Physics3DObject* physicsObj)
     {
         _objects.emplace_back(physicsObj);
         physicsObj->retain();
+        if (auto btObj = getbtCollisionObject(physicsObj))
+            _btObjects[btObj] = physicsObj;
         if (physicsObj->getObjType() == Physics3DObject::PhysicsObjType::RIGID_BODY)
         {
             _btPhyiscsWorld->addRigidBody(static_cast<Physics3DRigidBody*>(physicsObj)->getRigidBody());
@@ -157,6 +256,7 @@ void Physics3DWorld::removePhysics3DObject(Physics3DObject* physicsObj)
         {
             _btPhyiscsWorld->removeCollisionObject(static_cast<Physics3DCollider*>(physicsObj)->getGhostObject());
         }
+        _btObjects.erase(getbtCollisionObject(physicsObj));
         physicsObj->release();
         _objects.erase(it);
         _collisionCheckingFlag         = true;
@@ -179,6 +279,7 @@ void Physics3DWorld::removeAllPhysics3DObjects()
         it->release();
     }
     _objects.clear();
+    _btObjects.clear();
     _collisionCheckingFlag         = true;
     _needGhostPairCallbackChecking = true;
 }
@@ -266,15 +367,83 @@ void Physics3DWorld::stepSimulate(float dt)
         }
         _btPhyiscsWorld->stepSimulation(dt, 3);
         // sync dynamic node after simulation
-        for (auto&& it : _physicsComponents)
-        {
-            it->postSimulate();
-        }
+        syncPhysicsToNodes();
         if (needCollisionChecking())
             collisionChecking();
     }
 }
 
+void Physics3DWorld::syncPhysicsToNodes()
+{
+    _transformSyncs.clear();
+    for (auto&& it : _physicsComponents)
+    {
+        if (!((int)it->_syncFlag & (int)Physics3DComponent::PhysicsSyncFlag::PHYSICS_TO_NODE) || !it->_physics3DObj ||
+            !it->_owner)
+            continue;
+        auto type = it->_physics3DObj->getObjType();
+        if (type != Physics3DObject::PhysicsObjType::RIGID_BODY && type != Physics3DObject::PhysicsObjType::COLLIDER)
+            continue;
+
+        int depth = 0;
+        for (auto node = it->_owner->getParent(); node; node = node->getParent())
+            ++depth;
+        _transformSyncs.push_back({it, depth, 0});
+    }
+
+    // a body nested in another synced body is computed from the transform its ancestors get this step, so the nodes
+    // are handled one depth at a time, each depth after the one above it is written back
+    auto byDepth = [](const TransformSync& a, const TransformSync& b) { return a.depth < b.depth; };
+    if (!std::is_sorted(_transformSyncs.begin(), _transformSyncs.end(), byDepth))
+        std::stable_sort(_transformSyncs.begin(), _transformSyncs.end(), byDepth);
+
+    // the math only reads bullet, the nodes are written back here
+    auto computeTransforms = [this](int begin, int end) {
+        for (int i = begin; i < end; ++i)
+        {
+            auto& sync = _transformSyncs[i];
+            sync.component->computeNodeTransform(_parentInverses[sync.parentIndex], &sync.translation,
+                                                 &sync.rotation);
+        }
+    };
+
+    int count = static_cast<int>(_transformSyncs.size());
+    for (int levelBegin = 0, levelEnd = 0; levelBegin < count; levelBegin = levelEnd)
+    {
+        // parents are resolved on this thread, siblings usually come in a row so their parent is computed once
+        _parentInverses.clear();
+        Node* lastParent = nullptr;
+        int depth        = _transformSyncs[levelBegin].depth;
+        for (levelEnd = levelBegin; levelEnd < count && _transformSyncs[levelEnd].depth == depth; ++levelEnd)
+        {
+            auto& sync  = _transformSyncs[levelEnd];
+            auto parent = sync.component->_owner->getParent();
+            if (_parentInverses.empty() || parent != lastParent)
+            {
+                lastParent = parent;
+                _parentInverses.emplace_back(parent ? parent->getNodeToWorldTransform().getInversed() : Mat4::IDENTITY);
+            }
+            sync.parentIndex = static_cast<int>(_parentInverses.size()) - 1;
+        }
+
+        int levelCount = levelEnd - levelBegin;
+        if (levelCount > TRANSFORM_SYNC_GRAIN)
+            JobSystem::getInstance()->parallelFor(levelCount, TRANSFORM_SYNC_GRAIN,
+                                                  [levelBegin, &computeTransforms](int begin, int end) {
+                                                      computeTransforms(levelBegin + begin, levelBegin + end);
+                                                  });
+        else
+            computeTransforms(levelBegin, levelEnd);
+
+        for (int i = levelBegin; i < levelEnd; ++i)
+        {
+            auto owner = _transformSyncs[i].component->_owner;
+            owner->setPosition3D(_transformSyncs[i].translation);
+            owner->setRotationQuat(_transformSyncs[i].rotation);
+        }
+    }
+}
+
 void Physics3DWorld::debugDraw(Renderer* renderer)
 {
     if (_debugDrawer)
@@ -328,61 +497,81 @@ bool Physics3DWorld::sweepShape(Physics3DShape* shape,
 
 Physics3DObject* Physics3DWorld::getPhysicsObject(const btCollisionObject* btObj)
 {
-    for (auto&& it : _objects)
-    {
-        if (it->getObjType() == Physics3DObject::PhysicsObjType::RIGID_BODY)
-        {
-            if (static_cast<Physics3DRigidBody*>(it)->getRigidBody() == btObj)
-                return it;
-        }
-        else if (it->getObjType() == Physics3DObject::PhysicsObjType::COLLIDER)
-        {
-            if (static_cast<Physics3DCollider*>(it)->getGhostObject() == btObj)
-                return it;
-        }
-    }
-    return nullptr;
+    auto it = _btObjects.find(btObj);
+    return it != _btObjects.end() ? it->second : nullptr;
 }
 
 void Physics3DWorld::collisionChecking()
 {
+    // gather the colliding pairs first, the callbacks may add or remove objects
+    std::vector<const btPersistentManifold*> manifolds;
+    std::vector<Physics3DCollisionInfo> collisions;
     int numManifolds = _dispatcher->getNumManifolds();
     for (int i = 0; i < numManifolds; ++i)
     {
         btPersistentManifold* contactManifold = _dispatcher->getManifoldByIndexInternal(i);
-        int numContacts                       = contactManifold->getNumContacts();
-        if (0 < numContacts)
+        if (0 < contactManifold->getNumContacts())
         {
-            const btCollisionObject* obA = static_cast<const btCollisionObject*>(contactManifold->getBody0());
-            const btCollisionObject* obB = static_cast<const btCollisionObject*>(contactManifold->getBody1());
-            Physics3DObject* poA         = getPhysicsObject(obA);
-            Physics3DObject* poB         = getPhysicsObject(obB);
-            if (poA->needCollisionCallback() || poB->needCollisionCallback())
+            Physics3DObject* poA = getPhysicsObject(contactManifold->getBody0());
+            Physics3DObject* poB = getPhysicsObject(contactManifold->getBody1());
+            if (poA && poB && (poA->needCollisionCallback() || poB->needCollisionCallback()))
             {
-                Physics3DCollisionInfo ci;
-                ci.objA = poA;
-                ci.objB = poB;
-                for (int c = 0; c < numContacts; ++c)
-                {
-                    btManifoldPoint& pt                       = contactManifold->getContactPoint(c);
-                    Physics3DCollisionInfo::CollisionPoint cp = {
-                        convertbtVector3ToVec3(pt.m_localPointA), convertbtVector3ToVec3(pt.m_positionWorldOnA),
-                        convertbtVector3ToVec3(pt.m_localPointB), convertbtVector3ToVec3(pt.m_positionWorldOnB),
-                        convertbtVector3ToVec3(pt.m_normalWorldOnB)};
-                    ci.collisionPointList.emplace_back(cp);
-                }
-
-                if (poA->needCollisionCallback())
-                {
-                    poA->getCollisionCallback()(ci);
-                }
-                if (poB->needCollisionCallback())
-                {
-                    poB->getCollisionCallback()(ci);
-                }
+                manifolds.emplace_back(contactManifold);
+                collisions.emplace_back();
+                collisions.back().objA = poA;
+                collisions.back().objB = poB;
             }
         }
     }
+
+    auto fillContacts = [&](int begin, int end) {
+        for (int i = begin; i < end; ++i)
+        {
+            auto contactManifold = manifolds[i];
+            auto& ci             = collisions[i];
+            int numContacts      = contactManifold->getNumContacts();
+            ci.collisionPointList.reserve(numContacts);
+            for (int c = 0; c < numContacts; ++c)
+            {
+                const btManifoldPoint& pt                 = contactManifold->getContactPoint(c);
+                Physics3DCollisionInfo::CollisionPoint cp = {
+                    convertbtVector3ToVec3(pt.m_localPointA), convertbtVector3ToVec3(pt.m_positionWorldOnA),
+                    convertbtVector3ToVec3(pt.m_localPointB), convertbtVector3ToVec3(pt.m_positionWorldOnB),
+                    convertbtVector3ToVec3(pt.m_normalWorldOnB)};
+                ci.collisionPointList.emplace_back(cp);
+            }
+        }
+    };
+    int count = static_cast<int>(collisions.size());
+    if (count > CONTACT_GRAIN)
+        JobSystem::getInstance()->parallelFor(count, CONTACT_GRAIN, fillContacts);
+    else
+        fillContacts(0, count);
+
+    for (auto&& ci : collisions)
+    {
+        ci.objA->retain();
+        ci.objB->retain();
+    }
+    for (auto&& ci : collisions)
+    {
+        // skip the objects an earlier callback removed from the world
+        if (ci.objA->needCollisionCallback() && ci.objA->getPhysicsWorld() == this &&
+            getPhysicsObject(getbtCollisionObject(ci.objA)))
+        {
+            ci.objA->getCollisionCallback()(ci);
+        }
+        if (ci.objB->needCollisionCallback() && ci.objB->getPhysicsWorld() == this &&
+            getPhysicsObject(getbtCollisionObject(ci.objB)))
+        {
+            ci.objB->getCollisionCallback()(ci);
+        }
+    }
+    for (auto&& ci : collisions)
+    {
+        ci.objA->release();
+        ci.objB->release();
+    }
 }
 
 bool Physics3DWorld::needCollisionChecking()
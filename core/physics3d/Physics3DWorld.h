@@ -30,6 +30,9 @@
 #include "base/Ref.h"
 #include "base/Config.h"
 
+#include <unordered_map>
+#include <vector>
+
 #if AX_USE_3D_PHYSICS
 
 #    if (AX_ENABLE_BULLET_INTEGRATION)
@@ -39,6 +42,7 @@ class btDefaultCollisionConfiguration;
 class btCollisionDispatcher;
 struct btDbvtBroadphase;
 class btSequentialImpulseConstraintSolver;
+class btConstraintSolverPoolMt;
 class btGhostPairCallback;
 class btRigidBody;
 class btCollisionObject;
@@ -61,12 +65,14 @@ class Renderer;
  */
 struct AX_DLL Physics3DWorldDes
 {
-    bool isDebugDrawEnabled;  // using physics debug draw?, false by default
-    ax::Vec3 gravity;    // gravity, (0, -9.8, 0)
+    bool isDebugDrawEnabled;       // using physics debug draw?, false by default
+    bool isMultiThreadingEnabled;  // step with bullet's multithreaded world on the JobSystem, false by default
+    ax::Vec3 gravity;              // gravity, (0, -9.8, 0)
     Physics3DWorldDes()
     {
-        isDebugDrawEnabled = false;
-        gravity            = ax::Vec3(0.f, -9.8f, 0.f);
+        isDebugDrawEnabled      = false;
+        isMultiThreadingEnabled = false;
+        gravity                 = ax::Vec3(0.f, -9.8f, 0.f);
     }
 };
 
@@ -126,6 +132,12 @@ public:
     /** Check debug drawing is enabled. */
     bool isDebugDrawEnabled() const;
 
+    /**
+     * Check the world steps with bullet's multithreaded world. It is only enabled when requested in
+     * Physics3DWorldDes and bullet was built with BT_THREADSAFE.
+     */
+    bool isMultiThreadingEnabled() const { return _multiThreadingEnabled; }
+
     /** Internal method, the updater of debug drawing, need called each frame. */
     void debugDraw(ax::Renderer* renderer);
 
@@ -158,14 +170,30 @@ public:
     void setGhostPairCallback();
 
 protected:
+    struct TransformSync
+    {
+        Physics3DComponent* component;
+        int depth;  // number of ancestors of the owner
+        int parentIndex;
+        ax::Vec3 translation;
+        ax::Quaternion rotation;
+    };
+
     void removePhysics3DConstraintFromBullet(Physics3DConstraint* constraint);
+    void syncPhysicsToNodes();
 
     std::vector<Physics3DObject*> _objects;
+    std::unordered_map<const btCollisionObject*, Physics3DObject*> _btObjects;
     std::vector<Physics3DConstraint*> _constraints;
     std::vector<Physics3DComponent*> _physicsComponents;  // physics3d components
     bool _needCollisionChecking;
     bool _collisionCheckingFlag;
     bool _needGhostPairCallbackChecking;
+    bool _multiThreadingEnabled;
+
+    // scratch buffers reused by every step
+    std::vector<TransformSync> _transformSyncs;
+    std::vector<ax::Mat4> _parentInverses;
 
 #        if (AX_ENABLE_BULLET_INTEGRATION)
     btDynamicsWorld* _btPhyiscsWorld;
@@ -173,6 +201,7 @@ protected:
     btCollisionDispatcher* _dispatcher;
     btDbvtBroadphase* _broadphase;
     btSequentialImpulseConstraintSolver* _solver;
+    btConstraintSolverPoolMt* _solverPool;
     btGhostPairCallback* _ghostCallback;
     Physics3DDebugDrawer* _debugDrawer;
 #        endif  // AX_ENABLE_BULLET_INTEGRATION
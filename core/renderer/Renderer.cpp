@@ -27,6 +27,7 @@
 #include "renderer/Renderer.h"
 
 #include <algorithm>
+#include <chrono>
 
 #include "renderer/TrianglesCommand.h"
 #include "renderer/CustomCommand.h"
@@ -43,6 +44,8 @@
 #include "base/EventDispatcher.h"
 #include "base/EventListenerCustom.h"
 #include "base/EventType.h"
+#include "base/FrameProfiler.h"
+#include "base/format.h"
 #include "2d/Camera.h"
 #include "2d/Scene.h"
 #include "xxhash.h"
@@ -52,6 +55,35 @@
 
 NS_AX_BEGIN
 
+uint32_t RenderStats::getBatchBreakCount() const
+{
+    uint32_t count = 0;
+    for (auto breaks : batchBreaks)
+        count += breaks;
+    return count;
+}
+
+const char* RenderStats::getBatchBreakName(BatchBreak reason)
+{
+    switch (reason)
+    {
+    case BatchBreak::MATERIAL:
+        return "material";
+    case BatchBreak::SKIP_BATCHING:
+        return "skip batching";
+    case BatchBreak::BATCH_MODE:
+        return "batch mode";
+    case BatchBreak::TEXTURE_SLOTS:
+        return "texture slots";
+    case BatchBreak::BUFFER_FULL:
+        return "buffer full";
+    case BatchBreak::COMMAND:
+        return "command";
+    default:
+        return "unknown";
+    }
+}
+
 // helper
 static bool compareRenderCommand(RenderCommand* a, RenderCommand* b)
 {
@@ -191,6 +223,9 @@ Renderer::~Renderer()
 
     AX_SAFE_RELEASE(_depthStencilState);
     AX_SAFE_RELEASE(_commandBuffer);
+    AX_SAFE_RELEASE(_vertexStream);
+    AX_SAFE_RELEASE(_indexStream);
+    releaseMultiTextureStates();
     AX_SAFE_RELEASE(_renderPipeline);
     AX_SAFE_RELEASE(_defaultRT);
     AX_SAFE_RELEASE(_offscreenRT);
@@ -205,6 +240,9 @@ void Renderer::init()
 
     auto device    = backend::Device::getInstance();
     _commandBuffer = device->newCommandBuffer();
+    // a frame region holds a full batch, the backend grows it when a frame flushes more
+    _vertexStream = device->newStreamBuffer(VBO_SIZE * sizeof(_verts[0]), backend::BufferType::VERTEX);
+    _indexStream  = device->newStreamBuffer(INDEX_VBO_SIZE * sizeof(_indices[0]), backend::BufferType::INDEX);
     // @MTL: the depth stencil flags must same render target and _dsDesc
     _dsDesc.flags = DepthStencilFlags::ALL;
     _defaultRT    = device->newDefaultRenderTarget(TargetBufferFlags::COLOR | TargetBufferFlags::DEPTH_AND_STENCIL);
@@ -296,6 +334,11 @@ void Renderer::processGroupCommand(GroupCommand* command)
 void Renderer::processRenderCommand(RenderCommand* command)
 {
     auto commandType = command->getType();
+
+    // any other command draws the queued triangles first
+    if (commandType != RenderCommand::Type::TRIANGLES_COMMAND && !_queuedTriangleCommands.empty())
+        ++_frameStats.batchBreaks[(int)RenderStats::BatchBreak::COMMAND];
+
     switch (commandType)
     {
     case RenderCommand::Type::TRIANGLES_COMMAND:
@@ -313,6 +356,8 @@ void Renderer::processRenderCommand(RenderCommand* command)
                      "VBO for vertex is not big enough, please break the data down or use customized render command");
             AXASSERT(cmd->getIndexCount() >= 0 && cmd->getIndexCount() < INDEX_VBO_SIZE,
                      "VBO for index is not big enough, please break the data down or use customized render command");
+            if (!_queuedTriangleCommands.empty())
+                ++_frameStats.batchBreaks[(int)RenderStats::BatchBreak::BUFFER_FULL];
             drawBatchedTriangles();
 
             _queuedTotalIndexCount = _queuedTotalVertexCount = 0;
@@ -402,16 +447,27 @@ void Renderer::doVisitRenderQueue(const std::vector<RenderCommand*>& renderComma
 
 void Renderer::render()
 {
+    AX_PROFILER_ZONE("Renderer::render");
+
     // TODO: setup camera or MVP
     _isRendering = true;
     //    if (_glViewAssigned)
     {
         // Process render commands
         // 1. Sort render commands based on ID
+        auto sortStart = std::chrono::steady_clock::now();
         for (auto&& renderqueue : _renderGroups)
         {
+            for (int group = 0; group < RenderQueue::QUEUE_COUNT; ++group)
+                _frameStats.commands[group] +=
+                    static_cast<uint32_t>(renderqueue.getSubQueueSize(static_cast<RenderQueue::QUEUE_GROUP>(group)));
             renderqueue.sort();
         }
+        _frameStats.sortTime +=
+            std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - sortStart).count();
+        // upload the dynamic geometry streamed while visiting the scene
+        if (_vertexStream)
+            _vertexStream->commit();
         visitRenderQueue(_renderGroups[0]);
     }
     clean();
@@ -420,11 +476,39 @@ void Renderer::render()
 
 bool Renderer::beginFrame()
 {
+    _frameStats   = RenderStats{};
+    _statsProgram = nullptr;
+    std::fill(std::begin(_statsTextures), std::end(_statsTextures), nullptr);
+
+    if (_vertexStream)
+        _vertexStream->beginFrame();
+    if (_indexStream)
+        _indexStream->beginFrame();
+
     return _commandBuffer->beginFrame();
 }
 
 void Renderer::endFrame()
 {
+    _frameStats.drawCalls = static_cast<uint32_t>(_drawnBatches);
+    _frameStats.vertices  = static_cast<uint32_t>(_drawnVertices);
+    if (_vertexStream)
+        _frameStats.bufferBytes += _vertexStream->getUsedSize();
+    if (_indexStream)
+        _frameStats.bufferBytes += _indexStream->getUsedSize();
+
+    _lastFrameStats = _frameStats;
+    if (_statsHistory.empty())
+        _statsHistory.resize(STATS_HISTORY_SIZE);
+    _statsHistory[_statsHistoryHead] = _frameStats;
+    _statsHistoryHead                = (_statsHistoryHead + 1) % STATS_HISTORY_SIZE;
+    _statsHistoryCount               = std::min(_statsHistoryCount + 1, STATS_HISTORY_SIZE);
+
+    if (_vertexStream)
+        _vertexStream->endFrame();
+    if (_indexStream)
+        _indexStream->endFrame();
+
     _commandBuffer->endFrame();
 
 #ifdef AX_USE_METAL
@@ -598,30 +682,188 @@ void Renderer::setViewPort(int x, int y, unsigned int w, unsigned int h)
     _viewport.height = h;
 }
 
-void Renderer::fillVerticesAndIndices(const TrianglesCommand* cmd, unsigned int vertexBufferOffset)
+void Renderer::fillVerticesAndIndices(const TrianglesCommand* cmd,
+                                      V3F_C4B_T2F* vertices,
+                                      unsigned short* indices,
+                                      unsigned int vertexBufferOffset)
 {
-    size_t vertexCount = cmd->getVertexCount();
-    memcpy(&_verts[_filledVertex], cmd->getVertices(), sizeof(V3F_C4B_T2F) * vertexCount);
-
     // fill vertex, and convert them to world coordinates
-    const Mat4& modelView = cmd->getModelView();
+    // the destination may be write-combined mapped memory, so it's written once and never read back
+    const V3F_C4B_T2F* srcVertices = cmd->getVertices();
+    size_t vertexCount             = cmd->getVertexCount();
+    V3F_C4B_T2F* dstVertices       = vertices + _filledVertex;
+    const Mat4& modelView          = cmd->getModelView();
     for (size_t i = 0; i < vertexCount; ++i)
     {
-        modelView.transformPoint(&(_verts[i + _filledVertex].vertices));
+        V3F_C4B_T2F vertex = srcVertices[i];
+        modelView.transformPoint(&vertex.vertices);
+        dstVertices[i] = vertex;
     }
 
     // fill index
-    const unsigned short* indices = cmd->getIndices();
-    size_t indexCount             = cmd->getIndexCount();
+    const unsigned short* srcIndices = cmd->getIndices();
+    size_t indexCount                = cmd->getIndexCount();
+    unsigned short* dstIndices       = indices + _filledIndex;
     for (size_t i = 0; i < indexCount; ++i)
     {
-        _indices[_filledIndex + i] = vertexBufferOffset + _filledVertex + indices[i];
+        dstIndices[i] = vertexBufferOffset + _filledVertex + srcIndices[i];
     }
 
     _filledVertex += vertexCount;
     _filledIndex += indexCount;
 }
 
+bool Renderer::isMultiTextureBatchable(TrianglesCommand* cmd) const
+{
+    if (cmd->isSkipBatching() || !cmd->getTexture())
+        return false;
+
+    // only the default sprite program, the batch id differs from the program id once custom uniforms are hashed
+    auto programState = cmd->getPipelineDescriptor().programState;
+    auto program      = programState->getProgram();
+    return program->getProgramType() == backend::ProgramType::POSITION_TEXTURE_COLOR &&
+           programState->getBatchId() == static_cast<uint64_t>(program->getProgramId());
+}
+
+bool Renderer::isMultiTextureJoinable(TrianglesCommand* batchCmd, TrianglesCommand* cmd) const
+{
+    auto& batchBlend = batchCmd->getPipelineDescriptor().blendDescriptor;
+    auto& cmdBlend   = cmd->getPipelineDescriptor().blendDescriptor;
+    if (batchBlend.writeMask != cmdBlend.writeMask || batchBlend.blendEnabled != cmdBlend.blendEnabled)
+        return false;
+    if (batchBlend.blendEnabled &&
+        (batchBlend.rgbBlendOperation != cmdBlend.rgbBlendOperation ||
+         batchBlend.alphaBlendOperation != cmdBlend.alphaBlendOperation ||
+         batchBlend.sourceRGBBlendFactor != cmdBlend.sourceRGBBlendFactor ||
+         batchBlend.destinationRGBBlendFactor != cmdBlend.destinationRGBBlendFactor ||
+         batchBlend.sourceAlphaBlendFactor != cmdBlend.sourceAlphaBlendFactor ||
+         batchBlend.destinationAlphaBlendFactor != cmdBlend.destinationAlphaBlendFactor))
+        return false;
+
+    // the batch is drawn with the MVP of its first command
+    auto batchState    = batchCmd->getPipelineDescriptor().programState;
+    auto cmdState      = cmd->getPipelineDescriptor().programState;
+    auto batchLocation = batchState->getUniformLocation(backend::Uniform::MVP_MATRIX);
+    auto cmdLocation   = cmdState->getUniformLocation(backend::Uniform::MVP_MATRIX);
+    if (!batchLocation || !cmdLocation)
+        return !batchLocation && !cmdLocation;
+
+    std::size_t bufferSize = 0;
+    auto batchBuffer       = batchState->getVertexUniformBuffer(bufferSize);
+    auto cmdBuffer         = cmdState->getVertexUniformBuffer(bufferSize);
+    return memcmp(batchBuffer + batchLocation.location[1], cmdBuffer + cmdLocation.location[1], sizeof(Mat4)) == 0;
+}
+
+void Renderer::fillMultiTextureVertices(const TrianglesCommand* cmd,
+                                        V3F_C4B_T2F_S1F* vertices,
+                                        unsigned short* indices,
+                                        int slot)
+{
+    const V3F_C4B_T2F* srcVertices = cmd->getVertices();
+    size_t vertexCount             = cmd->getVertexCount();
+    V3F_C4B_T2F_S1F* dstVertices   = vertices + _filledMultiTextureVertex;
+    const Mat4& modelView          = cmd->getModelView();
+    for (size_t i = 0; i < vertexCount; ++i)
+    {
+        V3F_C4B_T2F_S1F vertex;
+        vertex.vertices = srcVertices[i].vertices;
+        modelView.transformPoint(&vertex.vertices);
+        vertex.colors    = srcVertices[i].colors;
+        vertex.texCoords = srcVertices[i].texCoords;
+        vertex.slot      = static_cast<float>(slot);
+        dstVertices[i]   = vertex;
+    }
+
+    const unsigned short* srcIndices = cmd->getIndices();
+    size_t indexCount                = cmd->getIndexCount();
+    unsigned short* dstIndices       = indices + _filledIndex;
+    for (size_t i = 0; i < indexCount; ++i)
+    {
+        dstIndices[i] = _filledMultiTextureVertex + srcIndices[i];
+    }
+
+    _filledMultiTextureVertex += vertexCount;
+    _filledIndex += indexCount;
+}
+
+backend::ProgramState* Renderer::nextMultiTextureState(TrianglesCommand* cmd)
+{
+    if (_multiTextureStatesUsed == _multiTextureStates.size())
+    {
+        auto program = backend::Program::getBuiltinProgram(backend::ProgramType::POSITION_TEXTURE_COLOR_MULTI);
+        auto programState = new backend::ProgramState(program);
+        if (_multiTextureStates.empty())
+        {
+            static constexpr std::string_view samplerNames[MAX_BATCH_TEXTURES] = {
+                "u_tex0"sv, "u_tex1"sv, "u_tex2"sv, "u_tex3"sv, "u_tex4"sv, "u_tex5"sv, "u_tex6"sv, "u_tex7"sv};
+            for (int i = 0; i < MAX_BATCH_TEXTURES; ++i)
+                _multiTextureLocations[i] = programState->getUniformLocation(samplerNames[i]);
+            _multiTextureMVPLocation = programState->getUniformLocation(backend::Uniform::MVP_MATRIX);
+        }
+        _multiTextureStates.emplace_back(programState);
+    }
+
+    auto programState = _multiTextureStates[_multiTextureStatesUsed++];
+
+    // the material id of the sprites doesn't hash the MVP, so the first command's one serves the whole batch
+    auto cmdProgramState = cmd->getPipelineDescriptor().programState;
+    auto mvpLocation     = cmdProgramState->getUniformLocation(backend::Uniform::MVP_MATRIX);
+    if (mvpLocation)
+    {
+        std::size_t bufferSize = 0;
+        auto buffer            = cmdProgramState->getVertexUniformBuffer(bufferSize);
+        programState->setUniform(_multiTextureMVPLocation, buffer + mvpLocation.location[1], sizeof(Mat4));
+    }
+
+    _batchTextureCount = 0;
+    return programState;
+}
+
+int Renderer::acquireBatchTextureSlot(backend::ProgramState* programState, backend::TextureBackend* texture)
+{
+    for (int slot = 0; slot < _batchTextureCount; ++slot)
+    {
+        if (_batchTextures[slot] == texture)
+            return slot;
+    }
+
+    if (_batchTextureCount == MAX_BATCH_TEXTURES)
+        return -1;
+
+    if (_batchTextureCount == 0)
+    {
+        // the samplers not used by the batch still need a valid texture
+        for (int slot = 0; slot < MAX_BATCH_TEXTURES; ++slot)
+            programState->setTexture(_multiTextureLocations[slot], slot, texture);
+    }
+    else
+        programState->setTexture(_multiTextureLocations[_batchTextureCount], _batchTextureCount, texture);
+
+    _batchTextures[_batchTextureCount] = texture;
+    return _batchTextureCount++;
+}
+
+void Renderer::releaseMultiTextureStates()
+{
+    for (auto&& programState : _multiTextureStates)
+        programState->release();
+    _multiTextureStates.clear();
+    _multiTextureStatesUsed = 0;
+}
+
+void Renderer::setMultiTextureBatching(bool enabled)
+{
+    if (_multiTextureBatching == enabled)
+        return;
+
+    // queued commands are filled with the current mode
+    flushTriangles();
+
+    _multiTextureBatching = enabled;
+    if (!enabled)
+        releaseMultiTextureStates();
+}
+
 void Renderer::drawBatchedTriangles()
 {
     if (_queuedTriangleCommands.empty())
@@ -639,45 +881,148 @@ void Renderer::drawBatchedTriangles()
     _triBatchesToDraw[0].offset        = indexBufferFillOffset;
     _triBatchesToDraw[0].indicesToDraw = 0;
     _triBatchesToDraw[0].cmd           = nullptr;
+    _triBatchesToDraw[0].programState  = nullptr;
 
     int batchesTotal        = 0;
     uint32_t prevMaterialID = 0;
     bool firstCommand       = true;
 
-    _filledVertex = 0;
-    _filledIndex  = 0;
+    _filledVertex             = 0;
+    _filledIndex              = 0;
+    _filledMultiTextureVertex = 0;
+    _multiTextureStatesUsed   = 0;
+
+    // write straight into the stream of current frame, fallback to the client arrays when it's full
+    V3F_C4B_T2F* vertices                 = _verts;
+    V3F_C4B_T2F_S1F* multiTextureVertices = nullptr;
+    unsigned short* indices               = _indices;
+    std::size_t vertexStreamOffset        = 0;
+    std::size_t multiTextureStreamOffset  = 0;
+    std::size_t indexStreamOffset         = 0;
+    bool streamed                         = false;
+    if (_vertexStream && _indexStream)
+    {
+        // the multi-texture batchable commands are filled into a region of their own, with the wider vertex format
+        std::size_t vertexCount = 0, multiTextureVertexCount = 0, indexCount = 0;
+        for (const auto& cmd : _queuedTriangleCommands)
+        {
+            if (_multiTextureBatching && isMultiTextureBatchable(cmd))
+                multiTextureVertexCount += cmd->getVertexCount();
+            else
+                vertexCount += cmd->getVertexCount();
+            indexCount += cmd->getIndexCount();
+        }
+
+        void* streamVertices             = nullptr;
+        void* streamMultiTextureVertices = nullptr;
+        bool allocated                   = true;
+        if (vertexCount)
+        {
+            streamVertices =
+                _vertexStream->allocate(vertexCount * sizeof(_verts[0]), sizeof(_verts[0]), vertexStreamOffset);
+            allocated = streamVertices != nullptr;
+        }
+        if (allocated && multiTextureVertexCount)
+        {
+            streamMultiTextureVertices =
+                _vertexStream->allocate(multiTextureVertexCount * sizeof(V3F_C4B_T2F_S1F), sizeof(V3F_C4B_T2F_S1F),
+                                        multiTextureStreamOffset);
+            allocated = streamMultiTextureVertices != nullptr;
+        }
+        auto streamIndices =
+            allocated
+                ? _indexStream->allocate(indexCount * sizeof(_indices[0]), sizeof(_indices[0]), indexStreamOffset)
+                : nullptr;
+        if (streamIndices)
+        {
+            vertices             = static_cast<V3F_C4B_T2F*>(streamVertices);
+            multiTextureVertices = static_cast<V3F_C4B_T2F_S1F*>(streamMultiTextureVertices);
+            indices              = static_cast<unsigned short*>(streamIndices);
+            streamed             = true;
+        }
+    }
 
     for (const auto& cmd : _queuedTriangleCommands)
     {
-        auto currentMaterialID = cmd->getMaterialID();
-        const bool batchable   = !cmd->isSkipBatching();
+        if (multiTextureVertices && isMultiTextureBatchable(cmd))
+        {
+            // join the current multi-texture batch when the blending and the MVP match and a texture slot is left
+            auto& batch      = _triBatchesToDraw[batchesTotal];
+            int slot         = -1;
+            auto breakReason = RenderStats::BatchBreak::BATCH_MODE;
+            if (!firstCommand && batch.programState)
+            {
+                breakReason = RenderStats::BatchBreak::MATERIAL;
+                if (isMultiTextureJoinable(batch.cmd, cmd))
+                {
+                    slot        = acquireBatchTextureSlot(batch.programState, cmd->getTexture());
+                    breakReason = RenderStats::BatchBreak::TEXTURE_SLOTS;
+                }
+            }
 
-        fillVerticesAndIndices(cmd, vertexBufferFillOffset);
+            if (slot < 0)
+            {
+                if (!firstCommand)
+                {
+                    ++_frameStats.batchBreaks[(int)breakReason];
+                    batchesTotal++;
+                    _triBatchesToDraw[batchesTotal].offset =
+                        _triBatchesToDraw[batchesTotal - 1].offset + _triBatchesToDraw[batchesTotal - 1].indicesToDraw;
+                }
+
+                _triBatchesToDraw[batchesTotal].programState  = nextMultiTextureState(cmd);
+                _triBatchesToDraw[batchesTotal].indicesToDraw = 0;
+                slot = acquireBatchTextureSlot(_triBatchesToDraw[batchesTotal].programState, cmd->getTexture());
+            }
 
-        // in the same batch ?
-        if (batchable && (prevMaterialID == currentMaterialID || firstCommand))
-        {
-            AX_ASSERT((firstCommand || _triBatchesToDraw[batchesTotal].cmd->getMaterialID() == cmd->getMaterialID()) &&
-                      "argh... error in logic");
-            _triBatchesToDraw[batchesTotal].indicesToDraw += cmd->getIndexCount();
+            fillMultiTextureVertices(cmd, multiTextureVertices, indices, slot);
             _triBatchesToDraw[batchesTotal].cmd = cmd;
+            _triBatchesToDraw[batchesTotal].indicesToDraw += cmd->getIndexCount();
         }
         else
         {
-            // is this the first one?
-            if (!firstCommand)
+            auto currentMaterialID = cmd->getMaterialID();
+            const bool batchable   = !cmd->isSkipBatching();
+
+            fillVerticesAndIndices(cmd, vertices, indices, vertexBufferFillOffset);
+
+            // in the same batch ?
+            if (batchable && !_triBatchesToDraw[batchesTotal].programState &&
+                (prevMaterialID == currentMaterialID || firstCommand))
             {
-                batchesTotal++;
-                _triBatchesToDraw[batchesTotal].offset =
-                    _triBatchesToDraw[batchesTotal - 1].offset + _triBatchesToDraw[batchesTotal - 1].indicesToDraw;
+                AX_ASSERT(
+                    (firstCommand || _triBatchesToDraw[batchesTotal].cmd->getMaterialID() == cmd->getMaterialID()) &&
+                    "argh... error in logic");
+                _triBatchesToDraw[batchesTotal].indicesToDraw += cmd->getIndexCount();
+                _triBatchesToDraw[batchesTotal].cmd = cmd;
+            }
+            else
+            {
+                // is this the first one?
+                if (!firstCommand)
+                {
+                    auto breakReason = RenderStats::BatchBreak::MATERIAL;
+                    if (_triBatchesToDraw[batchesTotal].programState)
+                        breakReason = RenderStats::BatchBreak::BATCH_MODE;
+                    else if (!batchable || prevMaterialID == MATERIAL_ID_DO_NOT_BATCH)
+                        breakReason = RenderStats::BatchBreak::SKIP_BATCHING;
+                    ++_frameStats.batchBreaks[(int)breakReason];
+
+                    batchesTotal++;
+                    _triBatchesToDraw[batchesTotal].offset =
+                        _triBatchesToDraw[batchesTotal - 1].offset + _triBatchesToDraw[batchesTotal - 1].indicesToDraw;
+                }
+
+                _triBatchesToDraw[batchesTotal].cmd           = cmd;
+                _triBatchesToDraw[batchesTotal].programState  = nullptr;
+                _triBatchesToDraw[batchesTotal].indicesToDraw = (int)cmd->getIndexCount();
+
+                // is this a single batch ? Prevent creating a batch group then
+                if (!batchable)
+                    currentMaterialID = 0;
             }
 
-            _triBatchesToDraw[batchesTotal].cmd           = cmd;
-            _triBatchesToDraw[batchesTotal].indicesToDraw = (int)cmd->getIndexCount();
-
-            // is this a single batch ? Prevent creating a batch group then
-            if (!batchable)
-                currentMaterialID = 0;
+            prevMaterialID = currentMaterialID;
         }
 
         // capacity full ?
@@ -688,33 +1033,61 @@ void Renderer::drawBatchedTriangles()
                 (TriBatchToDraw*)realloc(_triBatchesToDraw, sizeof(_triBatchesToDraw[0]) * _triBatchesToDrawCapacity);
         }
 
-        prevMaterialID = currentMaterialID;
-        firstCommand   = false;
+        firstCommand = false;
     }
     batchesTotal++;
+    backend::Buffer* vertexBuffer = _vertexBuffer;
+    backend::Buffer* indexBuffer  = _indexBuffer;
+    if (streamed)
+    {
+        _vertexStream->commit();
+        _indexStream->commit();
+        vertexBuffer = _vertexStream->getBuffer();
+        indexBuffer  = _indexStream->getBuffer();
+    }
+    else
+    {
 #ifdef AX_USE_METAL
-    _vertexBuffer->updateSubData(_verts, vertexBufferFillOffset * sizeof(_verts[0]), _filledVertex * sizeof(_verts[0]));
-    _indexBuffer->updateSubData(_indices, indexBufferFillOffset * sizeof(_indices[0]),
-                                _filledIndex * sizeof(_indices[0]));
+        _vertexBuffer->updateSubData(_verts, vertexBufferFillOffset * sizeof(_verts[0]),
+                                     _filledVertex * sizeof(_verts[0]));
+        _indexBuffer->updateSubData(_indices, indexBufferFillOffset * sizeof(_indices[0]),
+                                    _filledIndex * sizeof(_indices[0]));
 #else
-    _vertexBuffer->updateData(_verts, _filledVertex * sizeof(_verts[0]));
-    _indexBuffer->updateData(_indices, _filledIndex * sizeof(_indices[0]));
+        _vertexBuffer->updateData(_verts, _filledVertex * sizeof(_verts[0]));
+        _indexBuffer->updateData(_indices, _filledIndex * sizeof(_indices[0]));
 #endif
+        _frameStats.bufferBytes += _filledVertex * sizeof(_verts[0]) + _filledIndex * sizeof(_indices[0]);
+    }
 
     /************** 2: Draw *************/
     beginRenderPass();
 
-    _commandBuffer->setVertexBuffer(_vertexBuffer);
-    _commandBuffer->setIndexBuffer(_indexBuffer);
+    _commandBuffer->setVertexBuffer(vertexBuffer);
+    _commandBuffer->setIndexBuffer(indexBuffer);
 
     for (int i = 0; i < batchesTotal; ++i)
     {
         auto& drawInfo = _triBatchesToDraw[i];
-        _commandBuffer->updatePipelineState(_currentRT, drawInfo.cmd->getPipelineDescriptor());
-        auto& pipelineDescriptor = drawInfo.cmd->getPipelineDescriptor();
-        _commandBuffer->setProgramState(pipelineDescriptor.programState);
+        if (drawInfo.programState)
+        {
+            auto pipelineDescriptor         = drawInfo.cmd->getPipelineDescriptor();
+            pipelineDescriptor.programState = drawInfo.programState;
+            _commandBuffer->updatePipelineState(_currentRT, pipelineDescriptor);
+            _commandBuffer->setProgramState(drawInfo.programState);
+            countDrawState(drawInfo.programState);
+            _commandBuffer->setVertexBufferOffset(multiTextureStreamOffset);
+        }
+        else
+        {
+            auto& pipelineDescriptor = drawInfo.cmd->getPipelineDescriptor();
+            _commandBuffer->updatePipelineState(_currentRT, pipelineDescriptor);
+            _commandBuffer->setProgramState(pipelineDescriptor.programState);
+            _commandBuffer->setVertexBufferOffset(vertexStreamOffset);
+            countDrawState(pipelineDescriptor.programState);
+        }
         _commandBuffer->drawElements(backend::PrimitiveType::TRIANGLE, backend::IndexFormat::U_SHORT,
-                                     drawInfo.indicesToDraw, drawInfo.offset * sizeof(_indices[0]));
+                                     drawInfo.indicesToDraw,
+                                     indexStreamOffset + drawInfo.offset * sizeof(_indices[0]));
 
         _drawnBatches++;
         _drawnVertices += _triBatchesToDraw[i].indicesToDraw;
@@ -743,6 +1116,7 @@ void Renderer::drawCustomCommand(RenderCommand* command)
 
     _commandBuffer->updatePipelineState(_currentRT, cmd->getPipelineDescriptor());
     _commandBuffer->setProgramState(cmd->getPipelineDescriptor().programState);
+    countDrawState(cmd->getPipelineDescriptor().programState);
 
     auto drawType = cmd->getDrawType();
     if (CustomCommand::DrawType::ELEMENT == drawType)
@@ -849,6 +1223,7 @@ void Renderer::readPixels(backend::RenderTarget* rt,
 
 void Renderer::beginRenderPass()
 {
+    ++_frameStats.renderPasses;
     _commandBuffer->beginRenderPass(_currentRT, _renderPassDesc);
     _commandBuffer->updateDepthStencilState(_dsDesc);
     _commandBuffer->setStencilReferenceValue(_stencilRef);
@@ -888,6 +1263,7 @@ void Renderer::clear(ClearFlag flags, const Color4F& color, float depth, unsigne
         if (bitmask::any(flags, ClearFlag::STENCIL))
             descriptor.clearStencilValue = stencil;
 
+        ++_frameStats.renderPasses;
         _commandBuffer->beginRenderPass(_currentRT, descriptor);
         _commandBuffer->endRenderPass();
     };
@@ -1041,4 +1417,130 @@ void Renderer::popStateBlock()
     _stateBlockStack.pop_back();
 }
 
+void Renderer::countDrawState(backend::ProgramState* programState)
+{
+    if (!programState)
+        return;
+
+    auto program = programState->getProgram();
+    if (program != _statsProgram)
+    {
+        _statsProgram = program;
+        ++_frameStats.programSwitches;
+    }
+
+    auto countTextures = [this](const std::unordered_map<int, backend::TextureInfo>& textureInfos) {
+        for (auto&& textureInfo : textureInfos)
+        {
+            auto& textures = textureInfo.second.textures;
+            auto& slots    = textureInfo.second.slots;
+            for (size_t i = 0; i < textures.size() && i < slots.size(); ++i)
+            {
+                auto slot = slots[i];
+                if (slot >= 0 && slot < (int)AX_ARRAYSIZE(_statsTextures) && _statsTextures[slot] != textures[i])
+                {
+                    _statsTextures[slot] = textures[i];
+                    ++_frameStats.textureBinds;
+                }
+            }
+        }
+    };
+    countTextures(programState->getVertexTextureInfos());
+    countTextures(programState->getFragmentTextureInfos());
+}
+
+const RenderStats& Renderer::getStatsHistory(int index) const
+{
+    AXASSERT(index >= 0 && index < _statsHistoryCount, "invalid stats history index");
+    return _statsHistory[(_statsHistoryHead - _statsHistoryCount + index + STATS_HISTORY_SIZE) % STATS_HISTORY_SIZE];
+}
+
+void Renderer::clearStatsHistory()
+{
+    _statsHistoryHead  = 0;
+    _statsHistoryCount = 0;
+}
+
+std::string Renderer::getStatsReport() const
+{
+    auto& stats = _lastFrameStats;
+    std::string report;
+    auto out = std::back_inserter(report);
+
+    fmt::format_to(out, "Last frame:\n");
+    fmt::format_to(out, "  draw calls: {}, vertices: {}, render passes: {}\n", stats.drawCalls, stats.vertices,
+                   stats.renderPasses);
+    fmt::format_to(out, "  commands: globalZ<0 {}, opaque 3D {}, transparent 3D {}, globalZ=0 {}, globalZ>0 {}\n",
+                   stats.commands[RenderQueue::GLOBALZ_NEG], stats.commands[RenderQueue::OPAQUE_3D],
+                   stats.commands[RenderQueue::TRANSPARENT_3D], stats.commands[RenderQueue::GLOBALZ_ZERO],
+                   stats.commands[RenderQueue::GLOBALZ_POS]);
+    fmt::format_to(out, "  sort time: {:.3f} ms\n", stats.sortTime);
+    fmt::format_to(out, "  batch breaks: {} (", stats.getBatchBreakCount());
+    for (int i = 0; i < (int)RenderStats::BatchBreak::COUNT; ++i)
+        fmt::format_to(out, "{}{} {}", i ? ", " : "",
+                       RenderStats::getBatchBreakName(static_cast<RenderStats::BatchBreak>(i)), stats.batchBreaks[i]);
+    fmt::format_to(out, ")\n");
+    fmt::format_to(out, "  program switches: {}, texture binds: {}\n", stats.programSwitches, stats.textureBinds);
+    fmt::format_to(out, "  buffer uploads: {:.1f} KB\n", stats.bufferBytes / 1024.0);
+    fmt::format_to(out, "  nodes: {} submitted, {} culled\n", stats.submittedNodes, stats.culledNodes);
+
+    if (_statsHistoryCount == 0)
+        return report;
+
+    struct Counter
+    {
+        const char* name;
+        float (*value)(const RenderStats&);
+    };
+    static const Counter counters[] = {
+        {"draw calls", [](const RenderStats& s) { return (float)s.drawCalls; }},
+        {"batch breaks", [](const RenderStats& s) { return (float)s.getBatchBreakCount(); }},
+        {"program switches", [](const RenderStats& s) { return (float)s.programSwitches; }},
+        {"texture binds", [](const RenderStats& s) { return (float)s.textureBinds; }},
+        {"buffer uploads KB", [](const RenderStats& s) { return s.bufferBytes / 1024.0f; }},
+        {"sort time ms", [](const RenderStats& s) { return s.sortTime; }},
+        {"culled nodes", [](const RenderStats& s) { return (float)s.culledNodes; }},
+    };
+
+    // each histogram character is a bucket between the minimum and the maximum, darker means more frames
+    static const char shades[] = " .:-=+*#%@";
+    constexpr int BUCKET_COUNT = 16;
+
+    fmt::format_to(out, "Last {} frames: {:>12} {:>10} {:>10}  histogram\n", _statsHistoryCount, "min", "average",
+                   "max");
+    for (auto&& counter : counters)
+    {
+        float minValue = counter.value(getStatsHistory(0)), maxValue = minValue, sum = 0;
+        for (int i = 0; i < _statsHistoryCount; ++i)
+        {
+            auto value = counter.value(getStatsHistory(i));
+            minValue   = std::min(minValue, value);
+            maxValue   = std::max(maxValue, value);
+            sum += value;
+        }
+
+        int buckets[BUCKET_COUNT] = {};
+        float range               = maxValue - minValue;
+        for (int i = 0; i < _statsHistoryCount; ++i)
+        {
+            auto value = counter.value(getStatsHistory(i));
+            int bucket = range > 0 ? static_cast<int>((value - minValue) / range * (BUCKET_COUNT - 1) + 0.5f) : 0;
+            ++buckets[bucket];
+        }
+        int maxBucket = *std::max_element(std::begin(buckets), std::end(buckets));
+
+        std::string histogram(BUCKET_COUNT, ' ');
+        for (int i = 0; i < BUCKET_COUNT; ++i)
+        {
+            if (buckets[i])
+                histogram[i] = shades[1 + buckets[i] * (sizeof(shades) - 3) / maxBucket];
+        }
+
+        fmt::format_to(out, "  {:<18} {:>10.2f} {:>10.2f} {:>10.2f}  [{}]\n", counter.name, minValue,
+                       sum / _statsHistoryCount, maxValue, histogram);
+    }
+
+    return report;
+}
+
 NS_AX_END
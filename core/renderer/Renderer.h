@@ -30,6 +30,7 @@
 #include <array>
 #include <deque>
 #include <optional>
+#include <string>
 
 #include "platform/PlatformMacros.h"
 #include "renderer/RenderCommand.h"
@@ -49,6 +50,9 @@ using Winding  = backend::Winding;
 namespace backend
 {
 class Buffer;
+class StreamBuffer;
+class Program;
+class ProgramState;
 class CommandBuffer;
 class RenderPipeline;
 class RenderPass;
@@ -123,6 +127,43 @@ protected:
     bool _isDepthWrite;
 };
 
+/** Counters of one rendered frame, see `Renderer::getFrameStats`. */
+struct AX_DLL RenderStats
+{
+    /** Why a batch of triangles was closed before the next triangles command could join it. */
+    enum class BatchBreak
+    {
+        MATERIAL,       ///< The material id differs: texture, program, blending or uniforms.
+        SKIP_BATCHING,  ///< The command or the previous one skips batching.
+        BATCH_MODE,     ///< The command switches between the multi-texture and the regular batches.
+        TEXTURE_SLOTS,  ///< The multi-texture batch used all its texture slots.
+        BUFFER_FULL,    ///< The vertex or the index buffer is full.
+        COMMAND,        ///< A command of another type is drawn in between.
+        COUNT
+    };
+
+    /** Commands per queue group, summed over all the render queues. */
+    uint32_t commands[RenderQueue::QUEUE_COUNT] = {};
+    /** Closed batches per reason. */
+    uint32_t batchBreaks[(int)BatchBreak::COUNT] = {};
+
+    uint32_t drawCalls       = 0;  ///< Draw calls, same as `Renderer::getDrawnBatches`.
+    uint32_t vertices        = 0;  ///< Drawn vertices, same as `Renderer::getDrawnVertices`.
+    uint32_t renderPasses    = 0;  ///< Render passes begun, clears included.
+    uint32_t programSwitches = 0;  ///< Draws using another program than the previous draw.
+    uint32_t textureBinds    = 0;  ///< Textures changed on a slot between two draws.
+    uint32_t submittedNodes  = 0;  ///< Nodes that passed the visibility test.
+    uint32_t culledNodes     = 0;  ///< Nodes skipped by the visibility test.
+    uint64_t bufferBytes     = 0;  ///< Vertex and index bytes uploaded by the batches and the renderer streams.
+    float sortTime           = 0;  ///< Time spent sorting the render queues, in milliseconds.
+
+    /** Returns the number of batches closed for any reason. */
+    uint32_t getBatchBreakCount() const;
+
+    /** Returns a short name of a batch break reason. */
+    static const char* getBatchBreakName(BatchBreak reason);
+};
+
 class GroupCommandManager;
 
 /* Class responsible for the rendering in.
@@ -140,6 +181,10 @@ public:
     static const int BATCH_TRIAGCOMMAND_RESERVED_SIZE = 64;
     /**Reserved for material id, which means that the command could not be batched.*/
     static const int MATERIAL_ID_DO_NOT_BATCH = 0;
+    /**The max number of textures sampled by one multi-texture batch.*/
+    static const int MAX_BATCH_TEXTURES = 8;
+    /**The number of frames kept by the rolling render statistics.*/
+    static const int STATS_HISTORY_SIZE = 120;
     /**Constructor.*/
     Renderer();
     /**Destructor.*/
@@ -185,6 +230,30 @@ public:
     /* clear draw stats */
     void clearDrawStats() { _drawnBatches = _drawnVertices = 0; }
 
+    /** Nodes culling their commands report whether they passed the visibility test. */
+    void addCullingResult(bool visible) { visible ? ++_frameStats.submittedNodes : ++_frameStats.culledNodes; }
+
+    /** Returns the counters of the last rendered frame. */
+    const RenderStats& getFrameStats() const { return _lastFrameStats; }
+
+    /** Returns the number of frames in the rolling statistics, up to STATS_HISTORY_SIZE. */
+    int getStatsHistoryCount() const { return _statsHistoryCount; }
+
+    /**
+     * Returns the counters of a frame of the rolling statistics.
+     * @param index 0 for the oldest frame, getStatsHistoryCount() - 1 for the last one.
+     */
+    const RenderStats& getStatsHistory(int index) const;
+
+    /** Discards the rolling statistics. */
+    void clearStatsHistory();
+
+    /**
+     * Returns a human readable report of the last frame counters, with the minimum, average, maximum and a histogram
+     * of the main counters over the rolling statistics.
+     */
+    std::string getStatsReport() const;
+
     /**
      Set render targets. If not set, will use default render targets. It will effect all commands.
      @flags Flags to indicate which attachment to be replaced.
@@ -414,6 +483,26 @@ public:
 
     backend::CommandBuffer* getCommandBuffer() const { return _commandBuffer ; }
 
+    /**
+     * Get the ring of per-frame dynamic vertices, nullptr if the backend doesn't stream.
+     * Blocks allocated from it are valid in current frame only, see `backend::StreamBuffer`.
+     */
+    backend::StreamBuffer* getVertexStream() const { return _vertexStream; }
+
+    /** Get the ring of per-frame dynamic indices, nullptr if the backend doesn't stream. */
+    backend::StreamBuffer* getIndexStream() const { return _indexStream; }
+
+    /**
+     * Enable/disable merging the triangles commands which use different textures into one draw call.
+     * Up to MAX_BATCH_TEXTURES textures are bound at once, and each vertex carries the slot it samples from.
+     * Only the commands drawn with the default sprite program are merged, the others are batched as usual.
+     * @note It takes effect only when the backend streams vertices, see `getVertexStream`.
+     */
+    void setMultiTextureBatching(bool enabled);
+
+    /** Whether the multi-texture batching is enabled or not. */
+    bool isMultiTextureBatching() const { return _multiTextureBatching; }
+
     /** returns whether or not a rectangle is visible or not */
     bool checkVisibility(const Mat4& transform, const Vec2& size);
 
@@ -490,12 +579,29 @@ protected:
     void visitRenderQueue(RenderQueue& queue);
     void doVisitRenderQueue(const std::vector<RenderCommand*>&);
 
-    void fillVerticesAndIndices(const TrianglesCommand* cmd, unsigned int vertexBufferOffset);
+    void fillVerticesAndIndices(const TrianglesCommand* cmd,
+                                V3F_C4B_T2F* vertices,
+                                unsigned short* indices,
+                                unsigned int vertexBufferOffset);
+
+    bool isMultiTextureBatchable(TrianglesCommand* cmd) const;
+    // whether cmd draws with the blending and the MVP of the multi-texture batch ending with batchCmd
+    bool isMultiTextureJoinable(TrianglesCommand* batchCmd, TrianglesCommand* cmd) const;
+    void fillMultiTextureVertices(const TrianglesCommand* cmd,
+                                  V3F_C4B_T2F_S1F* vertices,
+                                  unsigned short* indices,
+                                  int slot);
+    backend::ProgramState* nextMultiTextureState(TrianglesCommand* cmd);
+    int acquireBatchTextureSlot(backend::ProgramState* programState, backend::TextureBackend* texture);
+    void releaseMultiTextureStates();
 
     void pushStateBlock();
 
     void popStateBlock();
 
+    // counts the program and texture changes of a draw
+    void countDrawState(backend::ProgramState* programState);
+
     backend::RenderPipeline* _renderPipeline = nullptr;
 
     Viewport _viewport;
@@ -519,6 +625,8 @@ protected:
     backend::Buffer* _vertexBuffer = nullptr;
     backend::Buffer* _indexBuffer  = nullptr;
     TriangleCommandBufferManager _triangleCommandBufferManager;
+    backend::StreamBuffer* _vertexStream = nullptr;
+    backend::StreamBuffer* _indexStream  = nullptr;
 
     backend::CommandBuffer* _commandBuffer = nullptr;
     backend::RenderPassDescriptor _renderPassDesc;
@@ -529,9 +637,10 @@ protected:
     // Internal structure that has the information for the batches
     struct TriBatchToDraw
     {
-        TrianglesCommand* cmd      = nullptr;  // needed for the Material
-        unsigned int indicesToDraw = 0;
-        unsigned int offset        = 0;
+        TrianglesCommand* cmd               = nullptr;  // needed for the Material
+        backend::ProgramState* programState = nullptr;  // the multi-texture state, nullptr uses the cmd's one
+        unsigned int indicesToDraw          = 0;
+        unsigned int offset                 = 0;
     };
     // capacity of the array of TriBatches
     int _triBatchesToDrawCapacity = 500;
@@ -545,9 +654,27 @@ protected:
     unsigned int _filledIndex            = 0;
     unsigned int _filledVertex           = 0;
 
+    // multi-texture batching, the states are reused by the batches of every flush
+    bool _multiTextureBatching = false;
+    std::vector<backend::ProgramState*> _multiTextureStates;
+    std::size_t _multiTextureStatesUsed = 0;
+    backend::UniformLocation _multiTextureLocations[MAX_BATCH_TEXTURES];
+    backend::UniformLocation _multiTextureMVPLocation;
+    backend::TextureBackend* _batchTextures[MAX_BATCH_TEXTURES];
+    int _batchTextureCount                 = 0;
+    unsigned int _filledMultiTextureVertex = 0;
+
     // stats
     size_t _drawnBatches  = 0;
     size_t _drawnVertices = 0;
+    RenderStats _frameStats;
+    RenderStats _lastFrameStats;
+    std::vector<RenderStats> _statsHistory;
+    int _statsHistoryHead  = 0;
+    int _statsHistoryCount = 0;
+    // the state of the last draw, only compared
+    const backend::Program* _statsProgram             = nullptr;
+    const backend::TextureBackend* _statsTextures[16] = {};
     // the flag for checking whether renderer is rendering
     bool _isRendering      = false;
     bool _isDepthTestFor2D = false;
@@ -38,6 +38,8 @@ AX_DLL const std::string_view positionTexture_frag                 = "positionTe
 AX_DLL const std::string_view positionTextureColor_vert            = "positionTextureColor_vs"sv;
 AX_DLL const std::string_view positionTextureColor_frag            = "positionTextureColor_fs"sv;
 AX_DLL const std::string_view positionTextureColorAlphaTest_frag   = "positionTextureColorAlphaTest_fs"sv;
+AX_DLL const std::string_view positionTextureColorMulti_vert       = "positionTextureColorMulti_vs"sv;
+AX_DLL const std::string_view positionTextureColorMulti_frag       = "positionTextureColorMulti_fs"sv;
 AX_DLL const std::string_view label_normal_frag                    = "label_normal_fs"sv;
 AX_DLL const std::string_view label_outline_frag                   = "label_outline_fs"sv;
 AX_DLL const std::string_view label_distanceNormal_frag            = "label_distanceNormal_fs"sv;
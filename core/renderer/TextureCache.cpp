@@ -38,6 +38,7 @@ THE SOFTWARE.
 #include "renderer/Texture2D.h"
 #include "base/Macros.h"
 #include "base/UTF8.h"
+#include "base/FrameProfiler.h"
 #include "base/Director.h"
 #include "base/Scheduler.h"
 #include "platform/FileUtils.h"
@@ -83,11 +84,14 @@ std::string TextureCache::getDescription() const
 struct TextureCache::AsyncStruct
 {
 public:
-    AsyncStruct(std::string_view fn, const std::function<void(Texture2D*)>& f, std::string_view key)
+    AsyncStruct(std::string_view fn,
+                const std::function<void(Texture2D*)>& f,
+                std::string_view key,
+                backend::PixelFormat format)
         : filename(fn)
         , callback(f)
         , callbackKey(key)
-        , pixelFormat(Texture2D::getDefaultAlphaPixelFormat())
+        , pixelFormat(format)
         , loadSuccess(false)
     {}
 
@@ -174,6 +178,14 @@ void TextureCache::addImageAsync(std::string_view path, const std::function<void
 void TextureCache::addImageAsync(std::string_view path,
                                  const std::function<void(Texture2D*)>& callback,
                                  std::string_view callbackKey)
+{
+    addImageAsync(path, callback, callbackKey, Texture2D::getDefaultAlphaPixelFormat());
+}
+
+void TextureCache::addImageAsync(std::string_view path,
+                                 const std::function<void(Texture2D*)>& callback,
+                                 std::string_view callbackKey,
+                                 PixelFormat format)
 {
     Texture2D* texture = nullptr;
 
@@ -215,7 +227,7 @@ void TextureCache::addImageAsync(std::string_view path,
     ++_asyncRefCount;
 
     // generate async struct
-    AsyncStruct* data = new AsyncStruct(fullpath, callback, callbackKey);
+    AsyncStruct* data = new AsyncStruct(fullpath, callback, callbackKey, format);
 
     // add async struct into queue
     _asyncStructQueue.emplace_back(data);
@@ -254,6 +266,10 @@ void TextureCache::unbindAllImageAsync()
 
 void TextureCache::loadImage()
 {
+#if AX_ENABLE_FRAME_PROFILER
+    FrameProfiler::setThreadName("TextureCache");
+#endif
+
     AsyncStruct* asyncStruct = nullptr;
     while (!_needQuit)
     {
@@ -280,6 +296,8 @@ void TextureCache::loadImage()
         }
         ul.unlock();
 
+        AX_PROFILER_ZONE("TextureCache::loadImage");
+
         // load image
         asyncStruct->loadSuccess = asyncStruct->image.initWithImageFileThreadSafe(asyncStruct->filename);
 
@@ -438,6 +456,8 @@ Texture2D* TextureCache::addImage(std::string_view path)
 
 Texture2D* TextureCache::addImage(std::string_view path, PixelFormat format)
 {
+    AX_PROFILER_ZONE("TextureCache::addImage");
+
     Texture2D* texture = nullptr;
     Image* image       = nullptr;
     // Split up directory and filename
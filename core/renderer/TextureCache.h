@@ -124,6 +124,14 @@ public:
                        const std::function<void(Texture2D*)>& callback,
                        std::string_view callbackKey);
 
+    /** Same as addImageAsync(path, callback, callbackKey), but the texture is created with the given pixel format.
+     @param format The pixel format of the texture, ignored when the image is cached already.
+     */
+    void addImageAsync(std::string_view path,
+                       const std::function<void(Texture2D*)>& callback,
+                       std::string_view callbackKey,
+                       PixelFormat format);
+
     /** Unbind a specified bound image asynchronous callback.
      * In the case an object who was bound to an image asynchronous callback was destroyed before the callback is
      * invoked, the object always need to unbind this callback manually.
@@ -101,6 +101,8 @@ public:
     const unsigned short* getIndices() const { return _triangles.indices; }
     /**Get the model view matrix.*/
     const Mat4& getModelView() const { return _mv; }
+    /**Get the backend texture used in renderring.*/
+    backend::TextureBackend* getTexture() const { return _texture; }
 
     /** update material ID */
     void updateMaterialID();
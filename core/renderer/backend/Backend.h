@@ -30,6 +30,7 @@
 #include "renderer/backend/Types.h"
 #include "renderer/backend/CommandBuffer.h"
 #include "renderer/backend/Buffer.h"
+#include "renderer/backend/StreamBuffer.h"
 #include "renderer/backend/VertexLayout.h"
 #include "renderer/backend/Texture.h"
 #include "renderer/backend/DepthStencilState.h"
@@ -133,6 +133,16 @@ public:
      */
     virtual void setVertexBuffer(Buffer* buffer) = 0;
 
+    /**
+     * Set the offset in bytes of the first vertex in the vertex buffer, reset to 0 by setVertexBuffer.
+     * Only backends creating a StreamBuffer need to support a non zero offset.
+     * @param offset The offset in bytes.
+     */
+    virtual void setVertexBufferOffset(std::size_t offset)
+    {
+        AXASSERT(offset == 0, "vertex buffer offset is not supported by this backend");
+    }
+
     /**
      * Set unifroms and textures
      * @param programState A programState object that hold the uniform and texture data.
@@ -233,11 +243,28 @@ public:
      */
     void setStencilReferenceValue(unsigned int frontRef, unsigned int backRef);
 
+    /**
+     * Uniform upload statistics of one frame.
+     */
+    struct UniformStats
+    {
+        uint32_t uploadedBytes = 0;  ///< uniform bytes sent to the driver.
+        uint32_t savedBytes    = 0;  ///< uniform bytes skipped because they are unchanged since the last upload.
+        uint32_t uploadCalls   = 0;  ///< glUniform* calls and uniform block uploads issued.
+        uint32_t savedCalls    = 0;  ///< glUniform* calls and uniform block uploads skipped.
+    };
+
+    /**
+     * Get the uniform upload statistics of the last frame, only collected by the OpenGL backend.
+     */
+    const UniformStats& getUniformStats() const { return _uniformStats; }
+
 protected:
     virtual ~CommandBuffer() = default;
 
     unsigned int _stencilReferenceValueFront = 0;  ///< front stencil reference value.
     unsigned int _stencilReferenceValueBack  = 0;  ///< back stencil reference value.
+    UniformStats _uniformStats;                    ///< uniform statistics of the last frame.
 };
 
 // end of _backend group
@@ -40,6 +40,7 @@ NS_AX_BACKEND_BEGIN
 
 class CommandBuffer;
 class Buffer;
+class StreamBuffer;
 class ShaderModule;
 class RenderPipeline;
 class RenderPass;
@@ -86,6 +87,15 @@ public:
      */
     virtual Buffer* newBuffer(size_t size, BufferType type, BufferUsage usage) = 0;
 
+    /**
+     * New a StreamBuffer object, not auto released.
+     * @param regionSize Specifies the size in bytes available to each frame.
+     * @param type Specifies the target buffer object. The symbolic constant must be BufferType::VERTEX or
+     * BufferType::INDEX.
+     * @return A StreamBuffer object, nullptr if the backend prefers its own buffer pool.
+     */
+    virtual StreamBuffer* newStreamBuffer(size_t regionSize, BufferType type) { return nullptr; }
+
     /**
      * New a TextureBackend object, not auto released.
      * @param descriptor Specifies texture description.
@@ -129,6 +139,29 @@ public:
      */
     virtual Program* newProgram(std::string_view vertexShader, std::string_view fragmentShader) = 0;
 
+    /**
+     * New a Program from a binary previously retrieved by Program::getProgramBinary, not auto released.
+     * @param vertexShader Specifes the vertex shader source the binary was built from.
+     * @param fragmentShader Specifes the fragment shader source the binary was built from.
+     * @param binaryFormat Specifies the driver specific binary format.
+     * @param binary Specifies the program binary.
+     * @param binarySize Specifies the program binary size in bytes.
+     * @return A Program instance, nullptr if the backend or the driver rejects the binary.
+     */
+    virtual Program* newProgramFromBinary(std::string_view vertexShader,
+                                          std::string_view fragmentShader,
+                                          uint32_t binaryFormat,
+                                          const void* binary,
+                                          size_t binarySize)
+    {
+        return nullptr;
+    }
+
+    /**
+     * Whether linked programs can be saved and restored as driver binaries.
+     */
+    virtual bool isProgramBinarySupported() const { return false; }
+
     /**
      * Get a DeviceInfo object.
      * @return A DeviceInfo object.
@@ -389,6 +389,8 @@ struct ProgramType
         VIDEO_TEXTURE_NV12,
         VIDEO_TEXTURE_BGR32,
 
+        POSITION_TEXTURE_COLOR_MULTI,         // positionTextureColorMulti_vert,  positionTextureColorMulti_frag
+
         BUILTIN_COUNT,
 
         VIDEO_TEXTURE_RGB32 = POSITION_TEXTURE_COLOR,
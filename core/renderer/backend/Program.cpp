@@ -69,6 +69,30 @@ struct VertexLayoutHelper
         vertexLayout->setStride(sizeof(V3F_C4B_T2F));
     }
 
+    static void setupSpriteMulti(Program* program)
+    {
+        auto vertexLayout = program->getVertexLayout();
+
+        /// a_position
+        vertexLayout->setAttrib(backend::ATTRIBUTE_NAME_POSITION,
+                                program->getAttributeLocation(backend::Attribute::POSITION),
+                                backend::VertexFormat::FLOAT3, 0, false);
+        /// a_texCoord
+        vertexLayout->setAttrib(backend::ATTRIBUTE_NAME_TEXCOORD,
+                                program->getAttributeLocation(backend::Attribute::TEXCOORD),
+                                backend::VertexFormat::FLOAT2, offsetof(V3F_C4B_T2F_S1F, texCoords), false);
+
+        /// a_color
+        vertexLayout->setAttrib(backend::ATTRIBUTE_NAME_COLOR, program->getAttributeLocation(backend::Attribute::COLOR),
+                                backend::VertexFormat::UBYTE4, offsetof(V3F_C4B_T2F_S1F, colors), true);
+
+        /// a_texSlot
+        vertexLayout->setAttrib(backend::ATTRIBUTE_NAME_TEXSLOT,
+                                program->getAttributeLocation(backend::ATTRIBUTE_NAME_TEXSLOT),
+                                backend::VertexFormat::FLOAT, offsetof(V3F_C4B_T2F_S1F, slot), false);
+        vertexLayout->setStride(sizeof(V3F_C4B_T2F_S1F));
+    }
+
     static void setupDrawNode(Program* program)
     {
         auto vertexLayout = program->getVertexLayout();
@@ -167,7 +191,7 @@ std::function<void(Program*)> Program::s_vertexLayoutSetupList[static_cast<int>(
     VertexLayoutHelper::setupDummy,    VertexLayoutHelper::setupPos,      VertexLayoutHelper::setupTexture,
     VertexLayoutHelper::setupSprite,   VertexLayoutHelper::setupDrawNode, VertexLayoutHelper::setupDrawNode3D,
     VertexLayoutHelper::setupSkyBox,   VertexLayoutHelper::setupPU3D,     VertexLayoutHelper::setupPosColor,
-    VertexLayoutHelper::setupTerrain3D};
+    VertexLayoutHelper::setupTerrain3D, VertexLayoutHelper::setupSpriteMulti};
 
 Program::Program(std::string_view vs, std::string_view fs)
     : _vertexShader(vs), _fragmentShader(fs), _vertexLayout(new VertexLayout())
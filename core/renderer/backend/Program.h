@@ -58,6 +58,7 @@ enum class VertexLayoutType
     PU3D,        // V3F_C4B_T2F // same with sprite, TODO: reuse spriete
     posColor,    // V3F_C4B
     Terrain3D,   // V3F_T2F_V3F
+    SpriteMulti, // V3F_C4B_T2F_S1F posTexColor with texture slot
     Count
 };
 
@@ -169,6 +170,14 @@ public:
 
     inline VertexLayout* getVertexLayout() const { return _vertexLayout; }
 
+    /**
+     * Retrieve the linked program binary, used by ProgramManager to persist programs across launches.
+     * @param binaryFormat Stores the driver specific binary format.
+     * @param binary Stores the program binary.
+     * @return false if the backend doesn't support program binaries.
+     */
+    virtual bool getProgramBinary(uint32_t& binaryFormat, std::vector<uint8_t>& binary) const { return false; }
+
 protected:
 
     void setProgramIds(uint32_t progType, uint64_t progId);
@@ -31,7 +31,11 @@
 #include "base/Configuration.h"
 
 #include "xxhash.h"
+#include "fmt/format.h"
+#include "yasio/ibstream.hpp"
+#include "yasio/obstream.hpp"
 #include <inttypes.h>
+#include <chrono>
 
 NS_AX_BACKEND_BEGIN
 
@@ -93,6 +97,8 @@ bool ProgramManager::init()
     fileUtils->addSearchPath("axslc"sv);
 #endif
 
+    _binaryCachePath = joinPath(fileUtils->getWritablePath(), "axslc-cache/"sv);
+
     registerProgram(ProgramType::POSITION_TEXTURE_COLOR, positionTextureColor_vert, positionTextureColor_frag,
                     VertexLayoutType::Sprite);
     registerProgram(ProgramType::DUAL_SAMPLER, positionTextureColor_vert, dualSampler_frag, VertexLayoutType::Sprite);
@@ -152,6 +158,8 @@ bool ProgramManager::init()
                     VertexLayoutType::Sprite);
     registerProgram(ProgramType::VIDEO_TEXTURE_NV12, positionTextureColor_vert, videoTextureNV12_frag,
                     VertexLayoutType::Sprite);
+    registerProgram(ProgramType::POSITION_TEXTURE_COLOR_MULTI, positionTextureColorMulti_vert,
+                    positionTextureColorMulti_frag, VertexLayoutType::SpriteMulti);
 
     // The builtin dual sampler shader registry
     ProgramStateRegistry::getInstance()->registerProgram(ProgramType::POSITION_TEXTURE_COLOR,
@@ -208,7 +216,34 @@ Program* ProgramManager::loadProgram(std::string_view vsName,
     auto fragFile   = fileUtils->fullPathForFilename(fsName);
     auto vertSource = fileUtils->getStringFromFile(vertFile);
     auto fragSource = fileUtils->getStringFromFile(fragFile);
-    auto program    = backend::Device::getInstance()->newProgram(vertSource, fragSource);
+
+    auto device = backend::Device::getInstance();
+    Program* program = nullptr;
+    uint64_t cacheKey = 0;
+    std::string cacheFile;
+    if (_binaryCacheEnabled && device->isProgramBinarySupported())
+    {
+        cacheKey  = computeBinaryCacheKey(progId, vertSource, fragSource);
+        cacheFile = fmt::format("{}{:016x}.bin", _binaryCachePath, cacheKey);
+        program   = loadProgramBinary(cacheFile, cacheKey, vertSource, fragSource);
+        if (program)
+            ++_loadStats.binaryHits;
+        else
+            ++_loadStats.binaryMisses;
+    }
+
+    if (!program)
+    {
+        auto start = std::chrono::steady_clock::now();
+        program    = device->newProgram(vertSource, fragSource);
+        auto duration =
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        ++_loadStats.compiled;
+        _loadStats.compileTime += duration;
+
+        if (program && !cacheFile.empty())
+            saveProgramBinary(program, cacheFile, cacheKey);
+    }
 
     if (program)
     {
@@ -262,6 +297,149 @@ uint64_t ProgramManager::computeProgramId(std::string_view vsName, std::string_v
     return XXH64_digest(_programIdGen);
 }
 
+/*
+ * Program binary cache file layout, integers are stored big endian by yasio::obstream:
+ *   "AXPB", uint32 version, uint64 cache key, uint32 binary format, uint32 binary size, binary
+ */
+static const char PROGRAM_BINARY_SIGNATURE[4] = {'A', 'X', 'P', 'B'};
+static const uint32_t PROGRAM_BINARY_VERSION  = 1;
+static const size_t PROGRAM_BINARY_HEADER_SIZE =
+    sizeof(PROGRAM_BINARY_SIGNATURE) + sizeof(uint32_t) + sizeof(uint64_t) + sizeof(uint32_t) * 2;
+
+uint64_t ProgramManager::computeBinaryCacheKey(uint64_t progId,
+                                               std::string_view vertSource,
+                                               std::string_view fragSource)
+{
+    auto deviceInfo = backend::Device::getInstance()->getDeviceInfo();
+
+    XXH64_reset(_programIdGen, 0);
+    XXH64_update(_programIdGen, &progId, sizeof(progId));
+    XXH64_update(_programIdGen, vertSource.data(), vertSource.length());
+    XXH64_update(_programIdGen, fragSource.data(), fragSource.length());
+    for (auto str : {deviceInfo->getVendor(), deviceInfo->getRenderer(), deviceInfo->getVersion()})
+    {
+        if (str)
+            XXH64_update(_programIdGen, str, strlen(str));
+    }
+    return XXH64_digest(_programIdGen);
+}
+
+Program* ProgramManager::loadProgramBinary(std::string_view cacheFile,
+                                           uint64_t cacheKey,
+                                           std::string_view vertSource,
+                                           std::string_view fragSource)
+{
+    auto fileUtils = FileUtils::getInstance();
+    if (!fileUtils->isFileExist(cacheFile))
+        return nullptr;
+
+    auto start = std::chrono::steady_clock::now();
+
+    yasio::byte_buffer data;
+    if (fileUtils->getContents(cacheFile, &data) != FileUtils::Status::OK || data.size() < PROGRAM_BINARY_HEADER_SIZE ||
+        memcmp(data.data(), PROGRAM_BINARY_SIGNATURE, sizeof(PROGRAM_BINARY_SIGNATURE)) != 0)
+        return nullptr;
+
+    yasio::ibstream_view ibs(data.data() + sizeof(PROGRAM_BINARY_SIGNATURE),
+                             data.size() - sizeof(PROGRAM_BINARY_SIGNATURE));
+    auto version      = ibs.read<uint32_t>();
+    auto key          = ibs.read<uint64_t>();
+    auto binaryFormat = ibs.read<uint32_t>();
+    auto binarySize   = ibs.read<uint32_t>();
+    if (version != PROGRAM_BINARY_VERSION || key != cacheKey || binarySize != data.size() - PROGRAM_BINARY_HEADER_SIZE)
+        return nullptr;
+
+    auto program = backend::Device::getInstance()->newProgramFromBinary(
+        vertSource, fragSource, binaryFormat, data.data() + PROGRAM_BINARY_HEADER_SIZE, binarySize);
+    if (!program)
+    {
+        AXLOG("axmol: ProgramManager: program binary %s rejected by driver", cacheFile.data());
+        return nullptr;
+    }
+
+    auto duration = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    _loadStats.binaryLoadTime += duration;
+    return program;
+}
+
+void ProgramManager::saveProgramBinary(Program* program, std::string_view cacheFile, uint64_t cacheKey)
+{
+    uint32_t binaryFormat = 0;
+    std::vector<uint8_t> binary;
+    if (!program->getProgramBinary(binaryFormat, binary))
+        return;
+
+    auto fileUtils = FileUtils::getInstance();
+    if (!_binaryCacheDirReady)
+    {
+        if (!fileUtils->isDirectoryExist(_binaryCachePath) && !fileUtils->createDirectory(_binaryCachePath))
+        {
+            AXLOG("axmol: ProgramManager: can't create program binary cache directory %s", _binaryCachePath.c_str());
+            return;
+        }
+        _binaryCacheDirReady = true;
+    }
+
+    yasio::obstream obs;
+    obs.write_bytes(PROGRAM_BINARY_SIGNATURE, sizeof(PROGRAM_BINARY_SIGNATURE));
+    obs.write<uint32_t>(PROGRAM_BINARY_VERSION);
+    obs.write<uint64_t>(cacheKey);
+    obs.write<uint32_t>(binaryFormat);
+    obs.write<uint32_t>(static_cast<uint32_t>(binary.size()));
+    obs.write_bytes(binary.data(), static_cast<int>(binary.size()));
+
+    if (!FileUtils::writeBinaryToFile(obs.data(), obs.length(), cacheFile))
+        AXLOG("axmol: ProgramManager: can't write program binary %s", cacheFile.data());
+}
+
+void ProgramManager::setBinaryCachePath(std::string_view path)
+{
+    _binaryCachePath = path;
+    if (!_binaryCachePath.empty() && _binaryCachePath.back() != '/')
+        _binaryCachePath.push_back('/');
+    _binaryCacheDirReady = false;
+}
+
+void ProgramManager::purgeBinaryCache()
+{
+    auto fileUtils = FileUtils::getInstance();
+    if (fileUtils->isDirectoryExist(_binaryCachePath))
+        fileUtils->removeDirectory(_binaryCachePath);
+    _binaryCacheDirReady = false;
+}
+
+size_t ProgramManager::warmUpPrograms(size_t maxCount)
+{
+    size_t pending = 0;
+    for (uint32_t type = 0; type < ProgramType::BUILTIN_COUNT; ++type)
+    {
+        if (_builtinRegistry[type].vsName.empty() || _cachedPrograms.find(type) != _cachedPrograms.end())
+            continue;
+        if (maxCount > 0)
+        {
+            getBuiltinProgram(type);
+            --maxCount;
+        }
+        else
+            ++pending;
+    }
+
+    for (auto&& [progId, info] : _customRegistry)
+    {
+        if (_cachedPrograms.find(progId) != _cachedPrograms.end())
+            continue;
+        if (maxCount > 0)
+        {
+            loadProgram(info.vsName, info.fsName, ProgramType::CUSTOM_PROGRAM, progId, info.vlt);
+            --maxCount;
+        }
+        else
+            ++pending;
+    }
+
+    return pending;
+}
+
 void ProgramManager::unloadProgram(Program* program)
 {
     if (!program)
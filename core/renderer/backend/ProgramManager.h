@@ -33,6 +33,7 @@
 #include <string>
 #include <unordered_map>
 #include <string_view>
+#include <limits>
 #include "ProgramStateRegistry.h"
 
 struct XXH64_state_s;
@@ -104,6 +105,48 @@ public:
      */
     void unloadAllPrograms();
 
+    /**
+     * Load registered builtin and custom programs which are not loaded yet, call it on a loading screen
+     * to move shader compilation out of the first frames of the next scene.
+     * @param maxCount the maximum number of programs loaded by this call, a loading screen can call it
+     *                 every frame to spread the work
+     * @return the number of registered programs still not loaded
+     */
+    size_t warmUpPrograms(size_t maxCount = (std::numeric_limits<size_t>::max)());
+
+    /**
+     * Enable or disable the persistent program binary cache, enabled by default, takes effect only
+     * when the backend supports program binaries, see Device::isProgramBinarySupported.
+     */
+    void setBinaryCacheEnabled(bool enabled) { _binaryCacheEnabled = enabled; }
+    bool isBinaryCacheEnabled() const { return _binaryCacheEnabled; }
+
+    /**
+     * Set the directory the program binaries are stored in, default: writablePath/axslc-cache/
+     */
+    void setBinaryCachePath(std::string_view path);
+    const std::string& getBinaryCachePath() const { return _binaryCachePath; }
+
+    /**
+     * Remove all program binaries from the disk cache.
+     */
+    void purgeBinaryCache();
+
+    struct LoadStats
+    {
+        uint32_t binaryHits   = 0;  ///< programs restored from the binary cache
+        uint32_t binaryMisses = 0;  ///< programs missing in the binary cache or rejected by the driver
+        uint32_t compiled     = 0;  ///< programs compiled and linked from source
+        double compileTime    = 0;  ///< total milliseconds spent compiling from source
+        double binaryLoadTime = 0;  ///< total milliseconds spent restoring binaries
+    };
+
+    /**
+     * Get the program load statistics since startup or the last resetLoadStats.
+     */
+    const LoadStats& getLoadStats() const { return _loadStats; }
+    void resetLoadStats() { _loadStats = LoadStats{}; }
+
     /**
      * Remove a program object from cache.
      * @param program Specifies the program object to move.
@@ -149,6 +192,17 @@ protected:
 
     uint64_t computeProgramId(std::string_view vsName, std::string_view fsName);
 
+    /**
+     * The binary cache key covers the program id, the shader sources and the driver, so binaries
+     * are rebuilt after shader or driver updates.
+     */
+    uint64_t computeBinaryCacheKey(uint64_t progId, std::string_view vertSource, std::string_view fragSource);
+    Program* loadProgramBinary(std::string_view cacheFile,
+                               uint64_t cacheKey,
+                               std::string_view vertSource,
+                               std::string_view fragSource);
+    void saveProgramBinary(Program* program, std::string_view cacheFile, uint64_t cacheKey);
+
     struct BuiltinRegInfo
     {  // builtin shader name is literal string, so use std::string_view ok
         std::string_view vsName;
@@ -163,6 +217,11 @@ protected:
 
     XXH64_state_s* _programIdGen;
 
+    bool _binaryCacheEnabled = true;
+    bool _binaryCacheDirReady = false;
+    std::string _binaryCachePath;
+    LoadStats _loadStats;
+
     static ProgramManager* _sharedProgramManager;  ///< A shared instance of the program cache.
 };
 
@@ -0,0 +1,101 @@
+/****************************************************************************
+ Copyright (c) 2022 Bytedance Inc.
+
+ https://axmolengine.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "Macros.h"
+#include "Types.h"
+#include "base/Ref.h"
+
+NS_AX_BACKEND_BEGIN
+
+class Buffer;
+
+/**
+ * @addtogroup _backend
+ * @{
+ */
+
+/**
+ * @brief A ring of per-frame dynamic geometry.
+ * Every frame owns a region of the ring, data is written straight into the memory returned by allocate and
+ * must not be touched after the frame ends. A region is reused only once the GPU finished the frame that filled it.
+ */
+class AX_DLL StreamBuffer : public ax::Ref
+{
+public:
+    /**
+     * Sub-allocate a block from the region of current frame.
+     * @param size Specifies the block size in bytes.
+     * @param alignment Specifies the alignment of the block offset, needn't be a power of two,
+     * pass the vertex stride to draw the block with a start vertex.
+     * @param offset Stores the offset of the block in bytes from the beginning of getBuffer().
+     * @return A writable pointer, nullptr when the region is full, the region grows at next frame.
+     */
+    virtual void* allocate(std::size_t size, std::size_t alignment, std::size_t& offset) = 0;
+
+    /**
+     * Make the blocks allocated since the last commit visible to the GPU, must be invoked before drawing them.
+     */
+    virtual void commit() = 0;
+
+    /**
+     * Switch to the region of next frame, waits until the GPU released it.
+     */
+    virtual void beginFrame() = 0;
+
+    /**
+     * Commit and fence the region of current frame.
+     */
+    virtual void endFrame() = 0;
+
+    /**
+     * Get the buffer to bind, may change when the ring grows.
+     */
+    virtual Buffer* getBuffer() const = 0;
+
+    /**
+     * Get the size in bytes of a frame region.
+     */
+    std::size_t getRegionSize() const { return _regionSize; }
+
+    /**
+     * Get the bytes allocated in current frame.
+     */
+    std::size_t getUsedSize() const { return _used; }
+
+    BufferType getType() const { return _type; }
+
+protected:
+    StreamBuffer(std::size_t regionSize, BufferType type) : _type(type), _regionSize(regionSize) {}
+    virtual ~StreamBuffer() = default;
+
+    BufferType _type        = BufferType::VERTEX;
+    std::size_t _regionSize = 0;  ///< frame region size in bytes.
+    std::size_t _used       = 0;  ///< bytes allocated in current frame.
+};
+
+// end of _backend group
+/// @}
+NS_AX_BACKEND_END
@@ -128,6 +128,7 @@ static constexpr auto ATTRIBUTE_NAME_TEXCOORD2 = "a_texCoord2"sv;
 static constexpr auto ATTRIBUTE_NAME_TEXCOORD3 = "a_texCoord3"sv;
 static constexpr auto ATTRIBUTE_NAME_NORMAL    = "a_normal"sv;
 static constexpr auto ATTRIBUTE_NAME_INSTANCE  = "a_instance"sv;
+static constexpr auto ATTRIBUTE_NAME_TEXSLOT   = "a_texSlot"sv;
 
 /**
  * @brief a structor to store blend descriptor
@@ -36,6 +36,8 @@
 #include "UtilsGL.h"
 #include "RenderTargetGL.h"
 #include "DeviceGL.h"
+#include "DeviceInfoGL.h"
+#include "UniformRingGL.h"
 #include <algorithm>
 
 NS_AX_BACKEND_BEGIN
@@ -59,15 +61,32 @@ void applyTexture(TextureBackend* texture, int slot, int index)
 }
 }  // namespace
 
-CommandBufferGL::CommandBufferGL() {}
+CommandBufferGL::CommandBufferGL()
+{
+#if AX_GLES_PROFILE != 200
+    // no uniform buffer objects on GLES2 devices
+    auto deviceInfo = static_cast<DeviceInfoGL*>(Device::getInstance()->getDeviceInfo());
+    if (!deviceInfo->isGLES2Only())
+        _uniformRing = new UniformRingGL();
+#endif
+}
 
 CommandBufferGL::~CommandBufferGL()
 {
     cleanResources();
+#if AX_GLES_PROFILE != 200
+    AX_SAFE_DELETE(_uniformRing);
+#endif
 }
 
 bool CommandBufferGL::beginFrame()
 {
+    _uniformStats      = _frameUniformStats;
+    _frameUniformStats = UniformStats{};
+#if AX_GLES_PROFILE != 200
+    if (_uniformRing)
+        _uniformRing->beginFrame();
+#endif
     return true;
 }
 
@@ -205,6 +224,7 @@ void CommandBufferGL::setInstanceBuffer(Buffer* buffer)
 void CommandBufferGL::setVertexBuffer(Buffer* buffer)
 {
     assert(buffer != nullptr);
+    _vertexBufferOffset = 0;
     if (buffer == nullptr || _vertexBuffer == buffer)
         return;
 
@@ -296,7 +316,13 @@ void CommandBufferGL::endRenderPass()
     AX_SAFE_RELEASE_NULL(_instanceTransformBuffer);
 }
 
-void CommandBufferGL::endFrame() {}
+void CommandBufferGL::endFrame()
+{
+#if AX_GLES_PROFILE != 200
+    if (_uniformRing)
+        _uniformRing->endFrame();
+#endif
+}
 
 void CommandBufferGL::prepareDrawing() const
 {
@@ -343,7 +369,7 @@ void CommandBufferGL::bindVertexBuffer(uint32_t& usedBits) const
         __gl->enableVertexAttribArray(attribute.index);
         glVertexAttribPointer(attribute.index, UtilsGL::getGLAttributeSize(attribute.format),
                               UtilsGL::toGLAttributeType(attribute.format), attribute.needToBeNormallized,
-                              vertexLayout->getStride(), (GLvoid*)attribute.offset);
+                              vertexLayout->getStride(), (GLvoid*)(_vertexBufferOffset + attribute.offset));
         // non-instance attrib not use divisor, so clear to 0
         __gl->clearVertexAttribDivisor(attribute.index);
         usedBits |= (1 << attribute.index);
@@ -387,7 +413,7 @@ void CommandBufferGL::bindUniforms(ProgramGL* program) const
 
         std::size_t bufferSize = 0;
         auto buffer            = _programState->getVertexUniformBuffer(bufferSize);
-        program->bindUniformBuffers(buffer, bufferSize);
+        program->bindUniformBuffers(buffer, bufferSize, _uniformRing, _frameUniformStats);
 
         const auto& textureInfo = _programState->getVertexTextureInfos();
         for (const auto& iter : textureInfo)
@@ -414,9 +440,21 @@ void CommandBufferGL::bindUniforms(ProgramGL* program) const
 
             auto arrayCount = slots.size();
             if (arrayCount == 1)  // Most of the time， not use sampler2DArray, should be 1
-                glUniform1i(location, slots[0]);
+            {
+                // sampler values are program state, only set them when the slot changes
+                if (program->updateSamplerSlot(location, slots[0]))
+                {
+                    glUniform1i(location, slots[0]);
+                    ++_frameUniformStats.uploadCalls;
+                }
+                else
+                    ++_frameUniformStats.savedCalls;
+            }
             else
+            {
                 glUniform1iv(location, static_cast<GLsizei>(arrayCount), static_cast<const GLint*>(slots.data()));
+                ++_frameUniformStats.uploadCalls;
+            }
         }
     }
 }
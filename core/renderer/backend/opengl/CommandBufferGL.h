@@ -40,6 +40,7 @@ class BufferGL;
 class RenderPipelineGL;
 class ProgramGL;
 class DepthStencilStateGL;
+class UniformRingGL;
 
 /**
  * @addtogroup _opengl
@@ -119,6 +120,12 @@ public:
      */
     virtual void setVertexBuffer(Buffer* buffer) override;
 
+    /**
+     * Set the offset in bytes of the first vertex in the vertex buffer, reset to 0 by setVertexBuffer.
+     * @param offset The offset in bytes.
+     */
+    virtual void setVertexBufferOffset(std::size_t offset) override { _vertexBufferOffset = offset; }
+
     /**
      * Set unifroms and textures
      * @param programState A programState object that hold the uniform and texture data.
@@ -222,6 +229,7 @@ protected:
     void cleanResources();
 
     BufferGL* _vertexBuffer                   = nullptr;
+    std::size_t _vertexBufferOffset           = 0;
     ProgramState* _programState               = nullptr;
     BufferGL* _indexBuffer                    = nullptr;
     BufferGL* _instanceTransformBuffer        = nullptr;
@@ -231,6 +239,9 @@ protected:
     Viewport _viewPort;
     GLboolean _alphaTestEnabled               = false;
 
+    UniformRingGL* _uniformRing = nullptr;  ///< per-frame ring of uniform blocks, nullptr on GLES2
+    mutable UniformStats _frameUniformStats;  ///< uniform statistics of the frame being encoded
+
 #if AX_ENABLE_CACHE_TEXTURE_DATA
     EventListenerCustom* _backToForegroundListener = nullptr;
 #endif
@@ -25,6 +25,7 @@
 #include "DeviceGL.h"
 #include "RenderPipelineGL.h"
 #include "BufferGL.h"
+#include "StreamBufferGL.h"
 #include "ShaderModuleGL.h"
 #include "CommandBufferGL.h"
 #include "TextureGL.h"
@@ -92,6 +93,17 @@ Buffer* DeviceGL::newBuffer(std::size_t size, BufferType type, BufferUsage usage
     return new BufferGL(size, type, usage);
 }
 
+StreamBuffer* DeviceGL::newStreamBuffer(std::size_t regionSize, BufferType type)
+{
+    auto mode = StreamBufferGL::Mode::ORPHAN;
+#if AX_GLES_PROFILE != 200
+    if (!static_cast<DeviceInfoGL*>(_deviceInfo)->isGLES2Only())
+        mode = StreamBufferGL::isPersistentMappingSupported() ? StreamBufferGL::Mode::PERSISTENT
+                                                              : StreamBufferGL::Mode::UNSYNCHRONIZED;
+#endif
+    return new StreamBufferGL(regionSize, type, mode);
+}
+
 TextureBackend* DeviceGL::newTexture(const TextureDescriptor& descriptor)
 {
     switch (descriptor.textureType)
@@ -147,4 +159,37 @@ Program* DeviceGL::newProgram(std::string_view vertexShader, std::string_view fr
     return new ProgramGL(vertexShader, fragmentShader);
 }
 
+Program* DeviceGL::newProgramFromBinary(std::string_view vertexShader,
+                                        std::string_view fragmentShader,
+                                        uint32_t binaryFormat,
+                                        const void* binary,
+                                        size_t binarySize)
+{
+    if (!isProgramBinarySupported())
+        return nullptr;
+
+    auto program = new ProgramGL(vertexShader, fragmentShader, binaryFormat, binary, binarySize);
+    if (program->getHandler())
+        return program;
+
+    delete program;
+    return nullptr;
+}
+
+bool DeviceGL::isProgramBinarySupported() const
+{
+#if AX_GLES_PROFILE != 200
+    if (_numProgramBinaryFormats < 0)
+    {
+        GLint numFormats = 0;
+        if (!static_cast<DeviceInfoGL*>(_deviceInfo)->isGLES2Only())
+            glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+        _numProgramBinaryFormats = numFormats;
+    }
+    return _numProgramBinaryFormats > 0;
+#else
+    return false;
+#endif
+}
+
 NS_AX_BACKEND_END
@@ -60,6 +60,16 @@ public:
      */
     virtual Buffer* newBuffer(std::size_t size, BufferType type, BufferUsage usage) override;
 
+    /**
+     * New a StreamBuffer object, not auto released.
+     * Contexts supporting immutable buffer storage write into a persistently mapped buffer, GL3/GLES3 contexts
+     * upload with unsynchronized mapping, GLES2 contexts orphan the buffer every frame.
+     * @param regionSize Specifies the size in bytes available to each frame.
+     * @param type Specifies the target buffer object.
+     * @return A StreamBuffer object.
+     */
+    virtual StreamBuffer* newStreamBuffer(std::size_t regionSize, BufferType type) override;
+
     /**
      * New a TextureBackend object, not auto released.
      * @param descriptor Specifies texture description.
@@ -95,6 +105,21 @@ public:
      */
     virtual Program* newProgram(std::string_view vertexShader, std::string_view fragmentShader) override;
 
+    /**
+     * New a Program from a binary retrieved by glGetProgramBinary, not auto released.
+     * @return A Program instance, nullptr if the driver rejects the binary.
+     */
+    virtual Program* newProgramFromBinary(std::string_view vertexShader,
+                                          std::string_view fragmentShader,
+                                          uint32_t binaryFormat,
+                                          const void* binary,
+                                          size_t binarySize) override;
+
+    /**
+     * Whether the driver exposes any program binary format.
+     */
+    virtual bool isProgramBinarySupported() const override;
+
 protected:
     /**
      * New a shaderModule, not auto released.
@@ -106,6 +131,7 @@ protected:
 
     GLint _defaultFBO = 0;  // The value gets from glGetIntegerv, so need to use GLint
     GLuint _defaultVAO = 0;
+    mutable GLint _numProgramBinaryFormats = -1;
 };
 // end of _opengl group
 /// @}
@@ -279,7 +279,18 @@ struct OpenGLState
     void bindUniformBufferBase(GLuint index, GLuint handle)
     {
         try_callxu(glBindBufferBase, GL_UNIFORM_BUFFER, _uniformBufferState, index, handle);
+        // glBindBufferBase also binds the generic GL_UNIFORM_BUFFER target
+        _bufferBindings[static_cast<int>(BufferType::UNIFORM_BUFFER)].reset();
     }
+#if AX_GLES_PROFILE != 200
+    void bindUniformBufferRange(GLuint index, GLuint handle, GLintptr offset, GLsizeiptr size)
+    {
+        // ranges are not tracked, so the next base binding is always issued
+        _uniformBufferState.reset();
+        _bufferBindings[static_cast<int>(BufferType::UNIFORM_BUFFER)].reset();
+        glBindBufferRange(GL_UNIFORM_BUFFER, index, handle, offset, size);
+    }
+#endif
 
     // useful for multi GL context before GL context switch, reset VAO state
     // VAO not share between context
@@ -34,6 +34,7 @@
 #include "yasio/byte_buffer.hpp"
 #include "renderer/backend/opengl/UtilsGL.h"
 #include "OpenGLState.h"
+#include "UniformRingGL.h"
 
 NS_AX_BACKEND_BEGIN
 
@@ -127,6 +128,23 @@ ProgramGL::ProgramGL(std::string_view vertexShader, std::string_view fragmentSha
     AX_SAFE_RETAIN(_vertexShaderModule);
     AX_SAFE_RETAIN(_fragmentShaderModule);
     compileProgram();
+    setupProgram();
+}
+
+ProgramGL::ProgramGL(std::string_view vertexShader,
+                     std::string_view fragmentShader,
+                     uint32_t binaryFormat,
+                     const void* binary,
+                     size_t binarySize)
+    : Program(vertexShader, fragmentShader)
+{
+    loadProgramBinary(binaryFormat, binary, binarySize);
+    if (_program)
+        setupProgram();
+}
+
+void ProgramGL::setupProgram()
+{
     computeUniformInfos();
 #if AX_ENABLE_CACHE_TEXTURE_DATA
     for (const auto& uniform : _activeUniformInfos)
@@ -165,6 +183,13 @@ void ProgramGL::reloadProgram()
     _activeUniformInfos.clear();
     _mapToCurrentActiveLocation.clear();
     _mapToOriginalLocation.clear();
+    if (!_vertexShaderModule)
+    {  // restored from program binary, the shader modules were never created
+        _vertexShaderModule   = static_cast<ShaderModuleGL*>(ShaderCache::newVertexShaderModule(_vertexShader));
+        _fragmentShaderModule = static_cast<ShaderModuleGL*>(ShaderCache::newFragmentShaderModule(_fragmentShader));
+        AX_SAFE_RETAIN(_vertexShaderModule);
+        AX_SAFE_RETAIN(_fragmentShaderModule);
+    }
     static_cast<ShaderModuleGL*>(_vertexShaderModule)->compileShader(backend::ShaderStage::VERTEX, _vertexShader);
     static_cast<ShaderModuleGL*>(_fragmentShaderModule)->compileShader(backend::ShaderStage::FRAGMENT, _fragmentShader);
     compileProgram();
@@ -198,6 +223,11 @@ void ProgramGL::compileProgram()
     glAttachShader(_program, vertShader);
     glAttachShader(_program, fragShader);
 
+#if AX_GLES_PROFILE != 200
+    if (Device::getInstance()->isProgramBinarySupported())
+        glProgramParameteri(_program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+#endif
+
     glLinkProgram(_program);
 
     GLint status = 0;
@@ -219,6 +249,49 @@ void ProgramGL::compileProgram()
     }
 }
 
+void ProgramGL::loadProgramBinary(uint32_t binaryFormat, const void* binary, size_t binarySize)
+{
+#if AX_GLES_PROFILE != 200
+    _program = glCreateProgram();
+    if (!_program)
+        return;
+
+    glProgramBinary(_program, static_cast<GLenum>(binaryFormat), binary, static_cast<GLsizei>(binarySize));
+
+    GLint status = 0;
+    glGetProgramiv(_program, GL_LINK_STATUS, &status);
+    if (GL_FALSE == status)
+    {
+        // driver updated or binary corrupted, consume the error raised by glProgramBinary
+        glGetError();
+        glDeleteProgram(_program);
+        _program = 0;
+    }
+#endif
+}
+
+bool ProgramGL::getProgramBinary(uint32_t& binaryFormat, std::vector<uint8_t>& binary) const
+{
+#if AX_GLES_PROFILE != 200
+    if (!_program || !Device::getInstance()->isProgramBinarySupported())
+        return false;
+
+    GLint length = 0;
+    glGetProgramiv(_program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+        return false;
+
+    GLenum format = 0;
+    binary.resize(static_cast<size_t>(length));
+    glGetProgramBinary(_program, length, &length, &format, binary.data());
+    binary.resize(static_cast<size_t>(length));
+    binaryFormat = format;
+    return length > 0;
+#else
+    return false;
+#endif
+}
+
 void ProgramGL::setBuiltinLocations()
 {
     /*--- Builtin Attribs ---*/
@@ -411,16 +484,77 @@ void ProgramGL::computeUniformInfos()
 
         _maxLocation = _maxLocation <= uniform.location ? (uniform.location + 1) : _maxLocation;
     }
+
+    _uniformShadow.assign(_totalBufferSize, 0);
+    _samplerSlots.clear();
+#if AX_GLES_PROFILE == 200
+    _uniformShadowValid = false;
+#endif
 }
 
-void ProgramGL::bindUniformBuffers(const char* buffer, size_t bufferSize)
+void ProgramGL::bindUniformBuffers(const char* buffer,
+                                   size_t bufferSize,
+                                   UniformRingGL* ring,
+                                   CommandBuffer::UniformStats& stats)
 {
+    assert(bufferSize >= _totalBufferSize);
+
 #if AX_GLES_PROFILE != 200
     for (GLuint blockIdx = 0; blockIdx < static_cast<GLuint>(_uniformBuffers.size()); ++blockIdx)
     {
-        auto& desc = _uniformBuffers[blockIdx];
-        desc._ubo->updateData(buffer + desc._location, desc._size);
-        __gl->bindUniformBufferBase(blockIdx, desc._ubo->getHandler());
+        auto& desc         = _uniformBuffers[blockIdx];
+        auto data          = buffer + desc._location;
+        auto shadow        = _uniformShadow.data() + desc._location;
+        auto blockSize     = static_cast<size_t>(desc._size);
+        auto uboHandle     = desc._ubo->getHandler();
+        bool ownBufferUsed = desc._boundHandle != 0 && desc._boundHandle == uboHandle;
+
+        if ((ownBufferUsed || (ring && ring->isResident(desc._boundHandle, desc._boundGeneration, desc._boundFrame))) &&
+            memcmp(data, shadow, blockSize) == 0)
+        {
+            // unchanged since the last upload, just rebind it
+            if (!ownBufferUsed)
+                ring->touch(desc._boundOffset);
+            stats.savedBytes += desc._size;
+            ++stats.savedCalls;
+        }
+        else
+        {
+            GLintptr offset = 0;
+            if (ring && ring->push(data, blockSize, offset))
+            {
+                desc._boundHandle     = ring->getHandler();
+                desc._boundOffset     = offset;
+                desc._boundFrame      = ring->getFrame();
+                desc._boundGeneration = ring->getGeneration();
+                stats.uploadedBytes += desc._size;
+            }
+            else if (ownBufferUsed)
+            {
+                // the program owned buffer holds the shadow data, upload the changed range only
+                auto first = std::mismatch(data, data + blockSize, shadow).first - data;
+                auto last  = static_cast<ptrdiff_t>(blockSize);
+                while (last > first && data[last - 1] == shadow[last - 1])
+                    --last;
+                desc._ubo->updateSubData(data + first, first, last - first);
+                stats.uploadedBytes += static_cast<uint32_t>(last - first);
+                stats.savedBytes += static_cast<uint32_t>(blockSize - (last - first));
+            }
+            else
+            {
+                desc._ubo->updateData(data, blockSize);
+                desc._boundHandle = uboHandle;
+                desc._boundOffset = 0;
+                stats.uploadedBytes += desc._size;
+            }
+            ++stats.uploadCalls;
+            memcpy(shadow, data, blockSize);
+        }
+
+        if (desc._boundHandle == uboHandle)
+            __gl->bindUniformBufferBase(blockIdx, uboHandle);
+        else
+            __gl->bindUniformBufferRange(blockIdx, desc._boundHandle, desc._boundOffset, desc._size);
     }
 #else
     for (auto&& iter : _activeUniformInfos)
@@ -429,15 +563,45 @@ void ProgramGL::bindUniformBuffers(const char* buffer, size_t bufferSize)
         if (uniformInfo.size <= 0)
             continue;
 
+        // uniform values are program state in GLSL100, skip the ones unchanged since the last upload
+        auto data   = buffer + uniformInfo.bufferOffset;
+        auto shadow = _uniformShadow.data() + uniformInfo.bufferOffset;
+        auto size   = static_cast<size_t>(uniformInfo.size * uniformInfo.count);
+        if (_uniformShadowValid && memcmp(data, shadow, size) == 0)
+        {
+            stats.savedBytes += static_cast<uint32_t>(size);
+            ++stats.savedCalls;
+            continue;
+        }
+
         int elementCount = uniformInfo.count;
-        setUniform(uniformInfo.count > 1, uniformInfo.location, elementCount, uniformInfo.type,
-                   (void*)(buffer + uniformInfo.bufferOffset));
+        setUniform(uniformInfo.count > 1, uniformInfo.location, elementCount, uniformInfo.type, (void*)data);
+        memcpy(shadow, data, size);
+        stats.uploadedBytes += static_cast<uint32_t>(size);
+        ++stats.uploadCalls;
     }
+    _uniformShadowValid = true;
 #endif
 
     CHECK_GL_ERROR_DEBUG();
 }
 
+bool ProgramGL::updateSamplerSlot(int location, int slot)
+{
+    for (auto& state : _samplerSlots)
+    {
+        if (state.location == location)
+        {
+            if (state.slot == slot)
+                return false;
+            state.slot = slot;
+            return true;
+        }
+    }
+    _samplerSlots.push_back(SamplerSlotState{location, slot});
+    return true;
+}
+
 void ProgramGL::clearUniformBuffers()
 {
     if (_uniformBuffers.empty())
@@ -32,6 +32,7 @@
 #include "../Program.h"
 #include "renderer/backend/Device.h"
 #include "renderer/backend/opengl/BufferGL.h"
+#include "renderer/backend/CommandBuffer.h"
 
 #include <string>
 #include <vector>
@@ -70,8 +71,22 @@ struct UniformBlockDescriptor
     BufferGL* _ubo;
     int _location;
     int _size;
+
+    // where the last uploaded block data lives: the program owned _ubo or a range of the UniformRingGL
+    GLuint _boundHandle       = 0;
+    GLintptr _boundOffset     = 0;
+    uint64_t _boundFrame      = 0;
+    uint32_t _boundGeneration = 0;
 };
 
+struct SamplerSlotState
+{
+    int location;
+    int slot;
+};
+
+class UniformRingGL;
+
 /**
  * An OpenGL program.
  */
@@ -84,6 +99,22 @@ public:
      */
     ProgramGL(std::string_view vertexShader, std::string_view fragmentShader);
 
+    /**
+     * Restore a program from a binary retrieved by glGetProgramBinary, the shaders are compiled
+     * from source only when the context is recreated.
+     * @param vertexShader Specifes the vertex shader source.
+     * @param fragmentShader Specifes the fragment shader source.
+     * @param binaryFormat Specifies the binary format.
+     * @param binary Specifies the program binary.
+     * @param binarySize Specifies the program binary size in bytes.
+     * @remark getHandler() returns 0 if the driver rejects the binary.
+     */
+    ProgramGL(std::string_view vertexShader,
+              std::string_view fragmentShader,
+              uint32_t binaryFormat,
+              const void* binary,
+              size_t binarySize);
+
     ~ProgramGL();
 
     /**
@@ -157,10 +188,35 @@ public:
      */
     virtual const hlookup::string_map<UniformInfo>& getAllActiveUniformInfo(ShaderStage stage) const override;
 
-    void bindUniformBuffers(const char* buffer, size_t bufferSize);
+    /**
+     * Retrieve the linked program binary.
+     * @return false if program binaries are not supported by the driver.
+     */
+    virtual bool getProgramBinary(uint32_t& binaryFormat, std::vector<uint8_t>& binary) const override;
+
+    /**
+     * Upload the uniform buffer of a ProgramState, uniforms unchanged since the last upload are skipped.
+     * @param buffer The uniform buffer.
+     * @param bufferSize The uniform buffer size in bytes.
+     * @param ring The per-frame ring used for changed uniform blocks, nullptr to update the program owned
+     * uniform buffers.
+     * @param stats Accumulates the uploaded and skipped uniform bytes and calls.
+     */
+    void bindUniformBuffers(const char* buffer,
+                            size_t bufferSize,
+                            UniformRingGL* ring,
+                            CommandBuffer::UniformStats& stats);
+
+    /**
+     * Record the texture slot of a sampler uniform.
+     * @return false if the sampler already uses the slot, the glUniform1i call can be skipped.
+     */
+    bool updateSamplerSlot(int location, int slot);
 
 private:
+    void setupProgram();
     void compileProgram();
+    void loadProgramBinary(uint32_t binaryFormat, const void* binary, size_t binarySize);
     void computeUniformInfos();
     void setBuiltinLocations();
 
@@ -195,6 +251,12 @@ private:
 
     std::size_t _totalBufferSize = 0;  // total uniform buffer size (all blocks)
 
+    std::vector<char> _uniformShadow;  // copy of the last uploaded uniform buffer, used to skip unchanged uniforms
+    std::vector<SamplerSlotState> _samplerSlots;
+#if AX_GLES_PROFILE == 200
+    bool _uniformShadowValid = false;
+#endif
+
     int _maxLocation = -1;
     UniformLocation _builtinUniformLocation[UNIFORM_MAX];
     int _builtinAttributeLocation[Attribute::ATTRIBUTE_MAX];
@@ -0,0 +1,277 @@
+/****************************************************************************
+ Copyright (c) 2022 Bytedance Inc.
+
+ https://axmolengine.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "StreamBufferGL.h"
+#include "BufferGL.h"
+#include "base/Director.h"
+#include "base/EventType.h"
+#include "base/EventDispatcher.h"
+#include "renderer/backend/opengl/MacrosGL.h"
+#include "OpenGLState.h"
+
+#include <algorithm>
+
+// immutable buffer storage: GL 4.4 or GL_ARB_buffer_storage, GL_EXT_buffer_storage on GLES 3.1
+#if AX_GLES_PROFILE == 0 && defined(glBufferStorage)
+#    define AX_GL_BUFFER_STORAGE glBufferStorage
+#    define AX_GL_PERSISTENT_MAP_FLAGS (GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT)
+#elif AX_GLES_PROFILE != 200 && defined(glBufferStorageEXT)
+#    define AX_GL_BUFFER_STORAGE glBufferStorageEXT
+#    define AX_GL_PERSISTENT_MAP_FLAGS (GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT_EXT | GL_MAP_COHERENT_BIT_EXT)
+#endif
+
+NS_AX_BACKEND_BEGIN
+
+namespace
+{
+constexpr uint32_t STREAM_MAX_GROW_FACTOR = 4;
+constexpr uint64_t STREAM_FENCE_TIMEOUT   = 1000000;  // 1ms in nanoseconds
+
+uint8_t* createPersistentStorage(GLenum target, std::size_t size, bool& immutable)
+{
+#if defined(AX_GL_BUFFER_STORAGE)
+    AX_GL_BUFFER_STORAGE(target, static_cast<GLsizeiptr>(size), nullptr, AX_GL_PERSISTENT_MAP_FLAGS);
+    immutable = true;
+    return static_cast<uint8_t*>(glMapBufferRange(target, 0, static_cast<GLsizeiptr>(size), AX_GL_PERSISTENT_MAP_FLAGS));
+#else
+    immutable = false;
+    return nullptr;
+#endif
+}
+}  // namespace
+
+bool StreamBufferGL::isPersistentMappingSupported()
+{
+#if defined(AX_GL_BUFFER_STORAGE)
+    return AX_GL_BUFFER_STORAGE != nullptr;
+#else
+    return false;
+#endif
+}
+
+StreamBufferGL::StreamBufferGL(std::size_t regionSize, BufferType type, Mode mode)
+    : StreamBuffer(regionSize, type), _mode(mode), _maxRegionSize(regionSize * STREAM_MAX_GROW_FACTOR)
+{
+#if AX_GLES_PROFILE == 200
+    _mode = Mode::ORPHAN;
+#endif
+    if (_mode == Mode::PERSISTENT && !isPersistentMappingSupported())
+        _mode = Mode::UNSYNCHRONIZED;
+
+    // an orphaned buffer gets fresh storage every frame, so it needn't rotate regions
+    _regionCount = _mode == Mode::ORPHAN ? 1 : REGION_COUNT;
+
+    createBuffer();
+
+#if AX_ENABLE_CACHE_TEXTURE_DATA
+    // BufferGL regenerates the handle itself, the storage is recreated at next frame
+    _backToForegroundListener = EventListenerCustom::create(EVENT_RENDERER_RECREATED, [this](EventCustom*) {
+#    if AX_GLES_PROFILE != 200
+        for (auto& fence : _fences)
+            fence = nullptr;
+#    endif
+        _mapped      = nullptr;
+        _storageLost = true;
+    });
+    Director::getInstance()->getEventDispatcher()->addEventListenerWithFixedPriority(_backToForegroundListener, -1);
+#endif
+}
+
+StreamBufferGL::~StreamBufferGL()
+{
+    deleteFences();
+    AX_SAFE_RELEASE(_buffer);
+#if AX_ENABLE_CACHE_TEXTURE_DATA
+    Director::getInstance()->getEventDispatcher()->removeEventListener(_backToForegroundListener);
+#endif
+}
+
+Buffer* StreamBufferGL::getBuffer() const
+{
+    return _buffer;
+}
+
+void StreamBufferGL::createBuffer()
+{
+    // draws of previous frames keep the old buffer alive until they are done
+    AX_SAFE_RELEASE(_buffer);
+    _buffer = new BufferGL(_regionSize * _regionCount, _type, BufferUsage::DYNAMIC);
+    _buffer->usingDefaultStoredData(false);
+
+    createStorage();
+}
+
+void StreamBufferGL::createStorage()
+{
+    deleteFences();
+
+    auto size    = _regionSize * _regionCount;
+    _mapped      = nullptr;
+    _regionIndex = 0;
+    _used        = 0;
+    _committed   = 0;
+
+    bool immutable = false;
+    if (_mode == Mode::PERSISTENT)
+    {
+        _mapped = createPersistentStorage(__gl->bindBuffer(_type, _buffer->getHandler()), size, immutable);
+        if (!_mapped)
+        {
+            AXLOG("axmol: persistent mapping of the stream buffer failed, fallback to unsynchronized uploads");
+            _mode = Mode::UNSYNCHRONIZED;
+        }
+    }
+
+    if (_mapped)
+    {
+        _staging.clear();
+        _staging.shrink_to_fit();
+    }
+    else
+    {
+        // the immutable storage can still be mapped per upload
+        if (!immutable)
+            _buffer->updateData(nullptr, size);
+        _staging.resize(_regionSize);
+    }
+    CHECK_GL_ERROR_DEBUG();
+}
+
+void StreamBufferGL::deleteFences()
+{
+#if AX_GLES_PROFILE != 200
+    for (auto& fence : _fences)
+    {
+        if (fence)
+        {
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+    }
+#endif
+}
+
+void* StreamBufferGL::allocate(std::size_t size, std::size_t alignment, std::size_t& offset)
+{
+    // align the absolute offset, so a vertex stride works as alignment whatever the region size is
+    auto base  = _regionIndex * _regionSize;
+    auto start = _used;
+    if (alignment > 1)
+        start = (base + _used + alignment - 1) / alignment * alignment - base;
+
+    if (size == 0 || start + size > _regionSize)
+    {
+        _overflowed = _overflowed || size != 0;
+        return nullptr;
+    }
+
+    offset = base + start;
+    _used  = start + size;
+    return _mapped ? _mapped + offset : _staging.data() + start;
+}
+
+void StreamBufferGL::commit()
+{
+    if (_mapped || _used == _committed)
+    {
+        // coherent persistent mapping, writes are visible to the next draw call
+        _committed = _used;
+        return;
+    }
+
+    auto target = __gl->bindBuffer(_type, _buffer->getHandler());
+    auto offset = static_cast<GLintptr>(_regionIndex * _regionSize + _committed);
+    auto size   = static_cast<GLsizeiptr>(_used - _committed);
+    auto data   = _staging.data() + _committed;
+
+#if AX_GLES_PROFILE != 200
+    if (_mode != Mode::ORPHAN)
+    {
+        // the region is fenced, no pending draw reads it
+        auto ptr = glMapBufferRange(target, offset, size,
+                                    GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+        if (ptr)
+        {
+            memcpy(ptr, data, size);
+            glUnmapBuffer(target);
+            _committed = _used;
+            return;
+        }
+    }
+#endif
+
+    glBufferSubData(target, offset, size, data);
+    CHECK_GL_ERROR_DEBUG();
+    _committed = _used;
+}
+
+void StreamBufferGL::beginFrame()
+{
+    if (_storageLost)
+    {
+        _storageLost = false;
+        createStorage();
+    }
+    else if (_overflowed && _regionSize < _maxRegionSize)
+    {
+        _regionSize = (std::min)(_regionSize * 2, _maxRegionSize);
+        createBuffer();
+    }
+    else
+        _regionIndex = (_regionIndex + 1) % _regionCount;
+
+    _overflowed = false;
+    _used       = 0;
+    _committed  = 0;
+
+#if AX_GLES_PROFILE != 200
+    auto& fence = _fences[_regionIndex];
+    if (fence)
+    {
+        // the GPU is REGION_COUNT - 1 frames behind at most, this rarely blocks
+        GLenum result;
+        do
+        {
+            result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, STREAM_FENCE_TIMEOUT);
+        } while (result == GL_TIMEOUT_EXPIRED);
+        glDeleteSync(fence);
+        fence = nullptr;
+    }
+#endif
+
+    if (_mode == Mode::ORPHAN)
+        _buffer->updateData(nullptr, _regionSize);
+}
+
+void StreamBufferGL::endFrame()
+{
+    commit();
+
+#if AX_GLES_PROFILE != 200
+    if (_mode != Mode::ORPHAN && _used)
+        _fences[_regionIndex] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+#endif
+}
+
+NS_AX_BACKEND_END
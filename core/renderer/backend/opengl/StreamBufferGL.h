@@ -0,0 +1,105 @@
+/****************************************************************************
+ Copyright (c) 2022 Bytedance Inc.
+
+ https://axmolengine.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "../StreamBuffer.h"
+#include "platform/GL.h"
+#include "base/EventListenerCustom.h"
+
+#include <vector>
+
+NS_AX_BACKEND_BEGIN
+
+class BufferGL;
+
+/**
+ * @addtogroup _opengl
+ * @{
+ */
+
+/**
+ * Stream dynamic geometry through a fenced ring of frame regions.
+ */
+class StreamBufferGL : public StreamBuffer
+{
+public:
+    static constexpr uint32_t REGION_COUNT = 3;
+
+    enum class Mode
+    {
+        PERSISTENT,      ///< glBufferStorage, mapped once with GL_MAP_PERSISTENT_BIT, written in place.
+        UNSYNCHRONIZED,  ///< staged in client memory, uploaded with glMapBufferRange(GL_MAP_UNSYNCHRONIZED_BIT).
+        ORPHAN,          ///< GLES2: a single region, orphaned with glBufferData every frame.
+    };
+
+    /**
+     * Whether the context can create immutable buffer storage mapped persistently.
+     */
+    static bool isPersistentMappingSupported();
+
+    /**
+     * @param regionSize Specifies the size in bytes available to each frame.
+     * @param type Specifies the target buffer object.
+     * @param mode Specifies the preferred upload mode, PERSISTENT falls back to UNSYNCHRONIZED if the storage
+     * can't be mapped.
+     */
+    StreamBufferGL(std::size_t regionSize, BufferType type, Mode mode);
+    ~StreamBufferGL();
+
+    virtual void* allocate(std::size_t size, std::size_t alignment, std::size_t& offset) override;
+    virtual void commit() override;
+    virtual void beginFrame() override;
+    virtual void endFrame() override;
+    virtual Buffer* getBuffer() const override;
+
+    Mode getMode() const { return _mode; }
+
+private:
+    void createBuffer();
+    void createStorage();
+    void deleteFences();
+
+    BufferGL* _buffer          = nullptr;
+    Mode _mode                 = Mode::ORPHAN;
+    uint32_t _regionCount      = 1;
+    uint32_t _regionIndex      = 0;
+    std::size_t _maxRegionSize = 0;
+    std::size_t _committed     = 0;  ///< bytes of current region uploaded to the buffer.
+    uint8_t* _mapped           = nullptr;
+    std::vector<uint8_t> _staging;  ///< client copy of current region when not mapped persistently.
+    bool _overflowed  = false;
+    bool _storageLost = false;
+
+#if AX_GLES_PROFILE != 200
+    GLsync _fences[REGION_COUNT] = {};
+#endif
+#if AX_ENABLE_CACHE_TEXTURE_DATA
+    EventListenerCustom* _backToForegroundListener = nullptr;
+#endif
+};
+
+// end of _opengl group
+/// @}
+NS_AX_BACKEND_END
@@ -0,0 +1,179 @@
+/****************************************************************************
+ Copyright (c) 2022 Bytedance Inc.
+
+ https://axmolengine.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "UniformRingGL.h"
+#include "base/Director.h"
+#include "base/EventType.h"
+#include "base/EventDispatcher.h"
+#include "renderer/backend/opengl/MacrosGL.h"
+#include "OpenGLState.h"
+
+#include <algorithm>
+
+#if AX_GLES_PROFILE != 200
+
+NS_AX_BACKEND_BEGIN
+
+namespace
+{
+constexpr std::size_t UNIFORM_RING_SEGMENT_SIZE     = 64 * 1024;
+constexpr std::size_t UNIFORM_RING_MAX_SEGMENT_SIZE = 4 * 1024 * 1024;
+constexpr uint64_t UNIFORM_RING_FENCE_TIMEOUT       = 1000000;  // 1ms in nanoseconds
+}  // namespace
+
+UniformRingGL::UniformRingGL() : _segmentSize(UNIFORM_RING_SEGMENT_SIZE)
+{
+    GLint alignment = 0;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    if (alignment > 0)
+        _alignment = static_cast<std::size_t>(alignment);
+
+    createBuffer();
+
+#if AX_ENABLE_CACHE_TEXTURE_DATA
+    _backToForegroundListener = EventListenerCustom::create(EVENT_RENDERER_RECREATED, [this](EventCustom*) {
+        // the objects of the lost context are gone already
+        for (auto& fence : _fences)
+            fence = nullptr;
+        _buffer = 0;
+        createBuffer();
+    });
+    Director::getInstance()->getEventDispatcher()->addEventListenerWithFixedPriority(_backToForegroundListener, -1);
+#endif
+}
+
+UniformRingGL::~UniformRingGL()
+{
+    deleteFences();
+    if (_buffer)
+        __gl->deleteBuffer(BufferType::UNIFORM_BUFFER, _buffer);
+#if AX_ENABLE_CACHE_TEXTURE_DATA
+    Director::getInstance()->getEventDispatcher()->removeEventListener(_backToForegroundListener);
+#endif
+}
+
+void UniformRingGL::createBuffer()
+{
+    // no pending draw reads the new buffer
+    deleteFences();
+
+    glGenBuffers(1, &_buffer);
+    glBufferData(__gl->bindBuffer(BufferType::UNIFORM_BUFFER, _buffer), _segmentSize * SEGMENT_COUNT, nullptr,
+                 GL_DYNAMIC_DRAW);
+    CHECK_GL_ERROR_DEBUG();
+
+    ++_generation;
+    _segmentIndex = 0;
+    _segmentUsed  = 0;
+    std::fill(std::begin(_referenced), std::end(_referenced), false);
+}
+
+void UniformRingGL::deleteFences()
+{
+    for (auto& fence : _fences)
+    {
+        if (fence)
+        {
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+    }
+}
+
+void UniformRingGL::beginFrame()
+{
+    ++_frame;
+    _segmentUsed = 0;
+
+    if (_overflowed && _segmentSize < UNIFORM_RING_MAX_SEGMENT_SIZE)
+    {
+        // blocks pushed by previous frames refer to the old buffer generation, so isResident rejects them
+        if (_buffer)
+            __gl->deleteBuffer(BufferType::UNIFORM_BUFFER, _buffer);
+        _segmentSize *= 2;
+        createBuffer();
+    }
+    else
+        _segmentIndex = (_segmentIndex + 1) % SEGMENT_COUNT;
+
+    _overflowed = false;
+
+    auto& fence = _fences[_segmentIndex];
+    if (fence)
+    {
+        // wait for the draws that read the segment SEGMENT_COUNT frames ago, this rarely blocks
+        GLenum result;
+        do
+        {
+            result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, UNIFORM_RING_FENCE_TIMEOUT);
+        } while (result == GL_TIMEOUT_EXPIRED);
+        glDeleteSync(fence);
+        fence = nullptr;
+    }
+}
+
+void UniformRingGL::endFrame()
+{
+    for (uint32_t i = 0; i < SEGMENT_COUNT; ++i)
+    {
+        if (!_referenced[i])
+            continue;
+
+        // a segment read again by a later frame keeps the latest fence only
+        if (_fences[i])
+            glDeleteSync(_fences[i]);
+        _fences[i]     = _buffer ? glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0) : nullptr;
+        _referenced[i] = false;
+    }
+}
+
+bool UniformRingGL::push(const void* data, std::size_t size, GLintptr& offset)
+{
+    auto alignedUsed = (_segmentUsed + _alignment - 1) / _alignment * _alignment;
+    if (!_buffer || alignedUsed + size > _segmentSize)
+    {
+        _overflowed = true;
+        return false;
+    }
+
+    offset = static_cast<GLintptr>(_segmentIndex * _segmentSize + alignedUsed);
+
+    // the segment was fenced when it was last used, so no pending draw reads it and the driver sync can be skipped
+    auto target = __gl->bindBuffer(BufferType::UNIFORM_BUFFER, _buffer);
+    auto ptr    = glMapBufferRange(target, offset, static_cast<GLsizeiptr>(size),
+                                   GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    if (!ptr)
+        return false;
+
+    memcpy(ptr, data, size);
+    glUnmapBuffer(target);
+
+    _segmentUsed               = alignedUsed + size;
+    _referenced[_segmentIndex] = true;
+    return true;
+}
+
+NS_AX_BACKEND_END
+
+#endif
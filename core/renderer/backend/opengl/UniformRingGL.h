@@ -0,0 +1,115 @@
+/****************************************************************************
+ Copyright (c) 2022 Bytedance Inc.
+
+ https://axmolengine.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+
+#include "../Macros.h"
+#include "platform/GL.h"
+#include "base/EventListenerCustom.h"
+
+#if AX_GLES_PROFILE != 200
+
+NS_AX_BACKEND_BEGIN
+/**
+ * @addtogroup _opengl
+ * @{
+ */
+
+/**
+ * A per-frame ring of std140 uniform blocks.
+ * Uniform blocks are appended to the segment of the current frame and bound with glBindBufferRange,
+ * so a draw never updates a uniform buffer the GPU may still read from a previous draw.
+ * The ring holds SEGMENT_COUNT frames. Every segment is fenced at the end of each frame that drew with it, and the
+ * fence is waited for before the segment is rewritten.
+ */
+class UniformRingGL
+{
+public:
+    static constexpr uint32_t SEGMENT_COUNT = 3;
+
+    UniformRingGL();
+    ~UniformRingGL();
+
+    /**
+     * Switch to the segment of the next frame, grows the ring when the previous frame ran out of space.
+     * Waits until the GPU is done with the draws that used the segment.
+     */
+    void beginFrame();
+
+    /**
+     * Fence the segments the draws of current frame read from.
+     */
+    void endFrame();
+
+    /**
+     * Copy a uniform block into the segment of current frame.
+     * @param data The block data.
+     * @param size The block size in bytes.
+     * @param offset Stores the offset of the block in the ring buffer.
+     * @return false if the segment is full, the caller should fallback to its own uniform buffer.
+     */
+    bool push(const void* data, std::size_t size, GLintptr& offset);
+
+    /**
+     * Whether a block pushed in the given frame and buffer generation is still untouched in the ring.
+     * The generation is checked because a recreated buffer may get the name of the deleted one.
+     */
+    bool isResident(GLuint handle, uint32_t generation, uint64_t frame) const
+    {
+        return handle == _buffer && generation == _generation && _frame - frame < SEGMENT_COUNT;
+    }
+
+    /**
+     * Mark the segment of a resident block as read by current frame, before rebinding the block.
+     */
+    void touch(GLintptr offset) { _referenced[static_cast<std::size_t>(offset) / _segmentSize] = true; }
+
+    GLuint getHandler() const { return _buffer; }
+    uint64_t getFrame() const { return _frame; }
+    uint32_t getGeneration() const { return _generation; }
+
+private:
+    void createBuffer();
+    void deleteFences();
+
+    GLuint _buffer                  = 0;
+    std::size_t _segmentSize        = 0;
+    std::size_t _alignment          = 256;
+    std::size_t _segmentUsed        = 0;
+    uint32_t _segmentIndex          = 0;
+    uint64_t _frame                 = 0;
+    uint32_t _generation            = 0;
+    bool _overflowed                = false;
+    GLsync _fences[SEGMENT_COUNT]   = {};
+    bool _referenced[SEGMENT_COUNT] = {};
+
+#if AX_ENABLE_CACHE_TEXTURE_DATA
+    EventListenerCustom* _backToForegroundListener = nullptr;
+#endif
+};
+
+// end of _opengl group
+/// @}
+NS_AX_BACKEND_END
+
+#endif
@@ -0,0 +1,37 @@
+#version 310 es
+precision highp float;
+precision highp int;
+
+layout(location = COLOR0) in vec4 v_color;
+layout(location = TEXCOORD0) in vec2 v_texCoord;
+layout(location = TEXCOORD1) in float v_texSlot;
+
+layout(binding = 0) uniform sampler2D u_tex0;
+layout(binding = 1) uniform sampler2D u_tex1;
+layout(binding = 2) uniform sampler2D u_tex2;
+layout(binding = 3) uniform sampler2D u_tex3;
+layout(binding = 4) uniform sampler2D u_tex4;
+layout(binding = 5) uniform sampler2D u_tex5;
+layout(binding = 6) uniform sampler2D u_tex6;
+layout(binding = 7) uniform sampler2D u_tex7;
+
+layout(location = SV_Target0) out vec4 FragColor;
+
+// samplers can't be indexed dynamically on GLES2/GLES3, so pick the slot with a branch tree
+vec4 sampleSlot(float slot, vec2 uv)
+{
+    if (slot < 3.5)
+    {
+        if (slot < 1.5)
+            return slot < 0.5 ? texture(u_tex0, uv) : texture(u_tex1, uv);
+        return slot < 2.5 ? texture(u_tex2, uv) : texture(u_tex3, uv);
+    }
+    if (slot < 5.5)
+        return slot < 4.5 ? texture(u_tex4, uv) : texture(u_tex5, uv);
+    return slot < 6.5 ? texture(u_tex6, uv) : texture(u_tex7, uv);
+}
+
+void main()
+{
+    FragColor = v_color * sampleSlot(v_texSlot, v_texCoord);
+}
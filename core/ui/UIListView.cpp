@@ -49,6 +49,13 @@ ListView::ListView()
     , _curSelectedIndex(-1)
     , _innerContainerDoLayoutDirty(true)
     , _eventCallback(nullptr)
+    , _virtual(false)
+    , _virtualItemsDirty(false)
+    , _virtualItemCount(0)
+    , _estimatedItemSize(0.0f)
+    , _itemTemplateCallback(nullptr)
+    , _itemCreateCallback(nullptr)
+    , _itemRenderCallback(nullptr)
 {
     this->setTouchEnabled(true);
 }
@@ -339,6 +346,8 @@ void ListView::removeAllChildrenWithCleanup(bool cleanup)
     ScrollView::removeAllChildrenWithCleanup(cleanup);
     _curSelectedIndex = -1;
     _items.clear();
+    _virtualItems.clear();
+    _virtualItemPools.clear();
     onItemListChanged();
 }
 
@@ -552,6 +561,15 @@ void ListView::setDirection(Direction dir)
         break;
     }
     ScrollView::setDirection(dir);
+
+    if (_virtual)
+    {
+        // Items are placed by updateVirtualItems, and their sizes are measured along the new direction
+        ScrollView::setLayoutType(Type::ABSOLUTE);
+        resetVirtualItemSizes();
+        recycleVirtualItems();
+        requestDoLayout();
+    }
 }
 
 void ListView::requestDoLayout()
@@ -561,6 +579,19 @@ void ListView::requestDoLayout()
 
 void ListView::doLayout()
 {
+    if (_virtual)
+    {
+        // Called on every visit, only the items entering the view are created or rebound
+        if (_innerContainerDoLayoutDirty)
+        {
+            updateVirtualInnerContainerSize();
+            _innerContainerDoLayoutDirty = false;
+            _virtualItemsDirty           = true;
+        }
+        updateVirtualItems(false);
+        return;
+    }
+
     if (!_innerContainerDoLayoutDirty)
     {
         return;
@@ -630,7 +661,7 @@ void ListView::interceptTouchEvent(TouchEventType event, Widget* sender, Touch*
         {
             if (parent && (parent->getParent() == _innerContainer))
             {
-                _curSelectedIndex = getIndex(parent);
+                _curSelectedIndex = _virtual ? getVirtualItemIndex(parent) : getIndex(parent);
                 break;
             }
             parent = dynamic_cast<Widget*>(parent->getParent());
@@ -841,16 +872,42 @@ Vec2 ListView::calculateItemDestination(const Vec2& positionRatioInView, Widget*
     return -(itemPosition - positionInView);
 }
 
+Vec2 ListView::calculateVirtualItemDestination(const Vec2& positionRatioInView,
+                                               ssize_t itemIndex,
+                                               const Vec2& itemAnchorPoint)
+{
+    const Vec2& contentSize = getContentSize();
+    Vec2 positionInView(contentSize.width * positionRatioInView.x, contentSize.height * positionRatioInView.y);
+
+    Rect itemRect = getVirtualItemRect(itemIndex);
+    Vec2 itemPosition(itemRect.origin.x + itemRect.size.width * itemAnchorPoint.x,
+                      itemRect.origin.y + itemRect.size.height * itemAnchorPoint.y);
+    return -(itemPosition - positionInView);
+}
+
 void ListView::jumpToItem(ssize_t itemIndex, const Vec2& positionRatioInView, const Vec2& itemAnchorPoint)
 {
-    Widget* item = getItem(itemIndex);
-    if (item == nullptr)
+    Vec2 destination;
+    if (_virtual)
     {
-        return;
+        if (itemIndex < 0 || itemIndex >= _virtualItemCount)
+        {
+            return;
+        }
+        doLayout();
+        destination = calculateVirtualItemDestination(positionRatioInView, itemIndex, itemAnchorPoint);
+    }
+    else
+    {
+        Widget* item = getItem(itemIndex);
+        if (item == nullptr)
+        {
+            return;
+        }
+        doLayout();
+        destination = calculateItemDestination(positionRatioInView, item, itemAnchorPoint);
     }
-    doLayout();
 
-    Vec2 destination = calculateItemDestination(positionRatioInView, item, itemAnchorPoint);
     if (!_bounceEnabled)
     {
         Vec2 delta         = destination - getInnerContainerPosition();
@@ -870,6 +927,17 @@ void ListView::scrollToItem(ssize_t itemIndex,
                             const Vec2& itemAnchorPoint,
                             float timeInSec)
 {
+    if (_virtual)
+    {
+        if (itemIndex >= 0 && itemIndex < _virtualItemCount)
+        {
+            doLayout();
+            Vec2 destination = calculateVirtualItemDestination(positionRatioInView, itemIndex, itemAnchorPoint);
+            startAutoScrollToDestination(destination, timeInSec, true);
+        }
+        return;
+    }
+
     Widget* item = getItem(itemIndex);
     if (item == nullptr)
     {
@@ -886,8 +954,8 @@ ssize_t ListView::getCurSelectedIndex() const
 
 void ListView::setCurSelectedIndex(int itemIndex)
 {
-    Widget* item = getItem(itemIndex);
-    if (item == nullptr)
+    bool isValidIndex = _virtual ? (itemIndex >= 0 && itemIndex < _virtualItemCount) : getItem(itemIndex) != nullptr;
+    if (!isValidIndex)
     {
         return;
     }
@@ -930,6 +998,13 @@ void ListView::copySpecialProperties(Widget* widget)
         setItemsMargin(listViewEx->_itemsMargin);
         setGravity(listViewEx->_gravity);
         _eventCallback = listViewEx->_eventCallback;
+
+        _itemTemplateCallback = listViewEx->_itemTemplateCallback;
+        _itemCreateCallback   = listViewEx->_itemCreateCallback;
+        _itemRenderCallback   = listViewEx->_itemRenderCallback;
+        setEstimatedItemSize(listViewEx->_estimatedItemSize);
+        setVirtual(listViewEx->_virtual);
+        setVirtualItemCount(listViewEx->_virtualItemCount);
     }
 }
 
@@ -1089,5 +1164,449 @@ void ListView::startMagneticScroll()
     scrollToItem(getIndex(pTargetItem), magneticAnchorPoint, magneticAnchorPoint);
 }
 
+void ListView::setVirtual(bool isVirtual)
+{
+    if (_virtual == isVirtual)
+    {
+        return;
+    }
+    removeAllItems();
+    _virtual = isVirtual;
+    if (_virtual)
+    {
+        ScrollView::setLayoutType(Type::ABSOLUTE);
+        resetVirtualItemSizes();
+    }
+    else
+    {
+        setDirection(_direction);
+        _virtualItemSizes.clear();
+        _virtualOffsetTree.clear();
+    }
+    requestDoLayout();
+}
+
+void ListView::setVirtualItemCount(ssize_t count)
+{
+    count = std::max<ssize_t>(count, 0);
+    if (_virtualItemCount == count)
+    {
+        return;
+    }
+    _virtualItemCount = count;
+    if (_curSelectedIndex >= _virtualItemCount)
+    {
+        _curSelectedIndex = -1;
+    }
+    if (_virtual)
+    {
+        // Keep the sizes measured so far, so appending items doesn't move the ones already shown
+        _virtualItemSizes.resize(_virtualItemCount, _estimatedItemSize);
+        resetVirtualOffsetTree();
+        recycleVirtualItems();
+        requestDoLayout();
+    }
+}
+
+void ListView::setEstimatedItemSize(float size)
+{
+    _estimatedItemSize = std::max(size, 0.0f);
+}
+
+void ListView::setItemTemplateCallback(const ccListViewItemTemplateCallback& callback)
+{
+    _itemTemplateCallback = callback;
+}
+
+void ListView::setItemCreateCallback(const ccListViewItemCreateCallback& callback)
+{
+    _itemCreateCallback = callback;
+}
+
+void ListView::setItemRenderCallback(const ccListViewItemRenderCallback& callback)
+{
+    _itemRenderCallback = callback;
+}
+
+void ListView::refreshVirtualItems()
+{
+    if (!_virtual)
+    {
+        return;
+    }
+    doLayout();
+    updateVirtualItems(true);
+}
+
+Widget* ListView::getVirtualItem(ssize_t index) const
+{
+    for (auto&& virtualItem : _virtualItems)
+    {
+        if (virtualItem.index == index)
+        {
+            return virtualItem.item;
+        }
+    }
+    return nullptr;
+}
+
+ssize_t ListView::getVirtualItemIndex(Widget* item) const
+{
+    for (auto&& virtualItem : _virtualItems)
+    {
+        if (virtualItem.item == item)
+        {
+            return virtualItem.index;
+        }
+    }
+    return -1;
+}
+
+void ListView::resetVirtualItemSizes()
+{
+    _virtualItemSizes.assign(_virtualItemCount, _estimatedItemSize);
+    resetVirtualOffsetTree();
+}
+
+void ListView::resetVirtualOffsetTree()
+{
+    // Build the binary indexed tree in O(n)
+    const size_t count = _virtualItemSizes.size();
+    _virtualOffsetTree.assign(count + 1, 0.0f);
+    for (size_t i = 1; i <= count; ++i)
+    {
+        _virtualOffsetTree[i] += _virtualItemSizes[i - 1];
+        size_t parent = i + (i & (~i + 1));
+        if (parent <= count)
+        {
+            _virtualOffsetTree[parent] += _virtualOffsetTree[i];
+        }
+    }
+}
+
+void ListView::setVirtualItemSize(ssize_t index, float size)
+{
+    float delta = size - _virtualItemSizes[index];
+    if (delta == 0.0f)
+    {
+        return;
+    }
+    _virtualItemSizes[index] = size;
+    for (size_t i = index + 1; i < _virtualOffsetTree.size(); i += (i & (~i + 1)))
+    {
+        _virtualOffsetTree[i] += delta;
+    }
+}
+
+float ListView::getVirtualItemOffset(ssize_t index) const
+{
+    float offset = index * _itemsMargin;
+    for (size_t i = index; i > 0; i -= (i & (~i + 1)))
+    {
+        offset += _virtualOffsetTree[i];
+    }
+    return offset;
+}
+
+ssize_t ListView::findVirtualItemByOffset(float offset) const
+{
+    // Binary lifting over the tree, finds the last item starting at or before the offset
+    const size_t count = _virtualItemSizes.size();
+    size_t step        = 1;
+    while ((step << 1) <= count)
+    {
+        step <<= 1;
+    }
+
+    size_t index = 0;
+    float sum    = 0.0f;
+    for (; step > 0; step >>= 1)
+    {
+        size_t next = index + step;
+        if (next <= count && sum + _virtualOffsetTree[next] + next * _itemsMargin <= offset)
+        {
+            index = next;
+            sum += _virtualOffsetTree[next];
+        }
+    }
+    return index;
+}
+
+Rect ListView::getVirtualItemRect(ssize_t index) const
+{
+    const Vec2& innerSize = _innerContainer->getContentSize();
+    float offset          = getVirtualItemOffset(index);
+    float size            = _virtualItemSizes[index];
+    if (_direction == Direction::HORIZONTAL)
+    {
+        return Rect(_leftPadding + offset, 0.0f, size, innerSize.height);
+    }
+    return Rect(0.0f, innerSize.height - _topPadding - offset - size, innerSize.width, size);
+}
+
+void ListView::updateVirtualInnerContainerSize()
+{
+    float totalSize = 0.0f;
+    if (_virtualItemCount > 0)
+    {
+        totalSize = getVirtualItemOffset(_virtualItemCount) - _itemsMargin;
+    }
+
+    switch (_direction)
+    {
+    case Direction::VERTICAL:
+    {
+        if (_virtualItemCount > 0)
+        {
+            totalSize += _topPadding + _bottomPadding;
+        }
+        // Items are laid out from the top, keep the distance scrolled from the top when the height changes
+        float oldHeight     = _innerContainer->getContentSize().height;
+        float scrolledInTop = oldHeight - _contentSize.height + _innerContainer->getPositionY();
+
+        setInnerContainerSize(Vec2(_contentSize.width, totalSize));
+
+        float newHeight = _innerContainer->getContentSize().height;
+        if (newHeight != oldHeight)
+        {
+            float minY = _contentSize.height - newHeight;
+            float posY = clampf(minY + scrolledInTop, minY, 0.0f);
+            setInnerContainerPosition(Vec2(_innerContainer->getPositionX(), posY));
+            updateScrollBar(getHowMuchOutOfBoundary());
+        }
+        break;
+    }
+    case Direction::HORIZONTAL:
+    {
+        if (_virtualItemCount > 0)
+        {
+            totalSize += _leftPadding + _rightPadding;
+        }
+        setInnerContainerSize(Vec2(totalSize, _contentSize.height));
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+void ListView::recycleVirtualItems()
+{
+    for (auto&& virtualItem : _virtualItems)
+    {
+        virtualItem.item->setVisible(false);
+        _virtualItemPools[virtualItem.templateId].pushBack(virtualItem.item);
+    }
+    _virtualItems.clear();
+    _virtualItemsDirty = true;
+}
+
+void ListView::layoutVirtualItem(Widget* item, ssize_t index)
+{
+    const Vec2& innerSize = _innerContainer->getContentSize();
+    const Vec2& anchor    = item->getAnchorPoint();
+    float width           = item->getContentSize().width * item->getScaleX();
+    float height          = item->getContentSize().height * item->getScaleY();
+    float offset          = getVirtualItemOffset(index);
+
+    Vec2 position;
+    if (_direction == Direction::HORIZONTAL)
+    {
+        position.x = _leftPadding + offset + width * anchor.x;
+        switch (_gravity)
+        {
+        case Gravity::BOTTOM:
+            position.y = _bottomPadding + height * anchor.y;
+            break;
+        case Gravity::CENTER_VERTICAL:
+            position.y = innerSize.height / 2 - height * (0.5f - anchor.y);
+            break;
+        default:
+            position.y = innerSize.height - _topPadding - height * (1.0f - anchor.y);
+            break;
+        }
+    }
+    else
+    {
+        position.y = innerSize.height - _topPadding - offset - height * (1.0f - anchor.y);
+        switch (_gravity)
+        {
+        case Gravity::RIGHT:
+            position.x = innerSize.width - _rightPadding - width * (1.0f - anchor.x);
+            break;
+        case Gravity::CENTER_HORIZONTAL:
+            position.x = innerSize.width / 2 - width * (0.5f - anchor.x);
+            break;
+        default:
+            position.x = _leftPadding + width * anchor.x;
+            break;
+        }
+    }
+    item->setPosition(position);
+}
+
+void ListView::updateVirtualItems(bool rerender)
+{
+    if (_virtualItemCount == 0)
+    {
+        if (!_virtualItems.empty())
+        {
+            recycleVirtualItems();
+        }
+        _virtualItemsDirty = false;
+        return;
+    }
+
+    const bool horizontal = (_direction == Direction::HORIZONTAL);
+    auto measure          = [horizontal](Widget* item) {
+        return horizontal ? item->getContentSize().width * item->getScaleX()
+                          : item->getContentSize().height * item->getScaleY();
+    };
+    auto getTemplate = [this](ssize_t index) { return _itemTemplateCallback ? _itemTemplateCallback(index) : 0; };
+
+    if (_estimatedItemSize <= 0.0f)
+    {
+        // Without an estimate the model, or else the first rendered item, stands for the items never shown
+        float estimate = 0.0f;
+        if (_model)
+        {
+            estimate = measure(_model);
+        }
+        else if (_itemCreateCallback)
+        {
+            int templateId = getTemplate(0);
+            Widget* probe  = _itemCreateCallback(templateId);
+            if (probe)
+            {
+                ScrollView::addChild(probe, probe->getLocalZOrder(), probe->getName());
+                if (_itemRenderCallback)
+                {
+                    _itemRenderCallback(probe, 0);
+                }
+                estimate = measure(probe);
+                probe->setVisible(false);
+                _virtualItemPools[templateId].pushBack(probe);
+            }
+        }
+        _estimatedItemSize = std::max(estimate, 1.0f);
+        resetVirtualItemSizes();
+        updateVirtualInnerContainerSize();
+        _virtualItemsDirty = true;
+    }
+
+    // Items are measured after rendering, which may move the view range, so a few passes may be needed
+    const int maxPasses = 8;
+    for (int pass = 0; pass < maxPasses; ++pass)
+    {
+        const Vec2& innerSize = _innerContainer->getContentSize();
+        const Vec2& innerPos  = _innerContainer->getPosition();
+        float viewStart, viewEnd;
+        if (horizontal)
+        {
+            viewStart = -innerPos.x - _leftPadding;
+            viewEnd   = viewStart + _contentSize.width;
+        }
+        else
+        {
+            viewStart = innerSize.height - _topPadding + innerPos.y - _contentSize.height;
+            viewEnd   = viewStart + _contentSize.height;
+        }
+
+        ssize_t first = std::min(findVirtualItemByOffset(std::max(viewStart, 0.0f)), _virtualItemCount - 1);
+        ssize_t last  = std::max(std::min(findVirtualItemByOffset(viewEnd), _virtualItemCount - 1), first);
+
+        bool inSameRange = !_virtualItems.empty() && _virtualItems.front().index == first &&
+                           _virtualItems.back().index == last;
+        if (inSameRange && !_virtualItemsDirty && !rerender)
+        {
+            return;
+        }
+
+        // Recycle the items out of the view range, and keep the others bound to their index
+        std::vector<VirtualItem> keptItems;
+        for (auto&& virtualItem : _virtualItems)
+        {
+            if (virtualItem.index < first || virtualItem.index > last)
+            {
+                virtualItem.item->setVisible(false);
+                _virtualItemPools[virtualItem.templateId].pushBack(virtualItem.item);
+            }
+            else
+            {
+                keptItems.push_back(virtualItem);
+            }
+        }
+
+        std::vector<VirtualItem> visibleItems;
+        visibleItems.reserve(last - first + 1);
+        auto kept    = keptItems.begin();
+        bool resized = false;
+        for (ssize_t index = first; index <= last; ++index)
+        {
+            VirtualItem virtualItem{index, 0, nullptr};
+            if (kept != keptItems.end() && kept->index == index)
+            {
+                virtualItem = *kept++;
+                if (rerender && _itemRenderCallback)
+                {
+                    _itemRenderCallback(virtualItem.item, index);
+                }
+            }
+            else
+            {
+                virtualItem.templateId = getTemplate(index);
+                auto& pool             = _virtualItemPools[virtualItem.templateId];
+                if (!pool.empty())
+                {
+                    // Pooled items are still children of the inner container, which keeps them alive
+                    virtualItem.item = pool.back();
+                    pool.popBack();
+                }
+                else
+                {
+                    virtualItem.item = _itemCreateCallback ? _itemCreateCallback(virtualItem.templateId)
+                                                           : (_model ? _model->clone() : nullptr);
+                    if (virtualItem.item == nullptr)
+                    {
+                        AXLOG("ListView: no item created for index %d", static_cast<int>(index));
+                        continue;
+                    }
+                    ScrollView::addChild(virtualItem.item, virtualItem.item->getLocalZOrder(),
+                                         virtualItem.item->getName());
+                }
+                virtualItem.item->setVisible(true);
+                if (_itemRenderCallback)
+                {
+                    _itemRenderCallback(virtualItem.item, index);
+                }
+            }
+
+            float size = measure(virtualItem.item);
+            if (size != _virtualItemSizes[index])
+            {
+                setVirtualItemSize(index, size);
+                resized = true;
+            }
+            visibleItems.push_back(virtualItem);
+        }
+        _virtualItems.swap(visibleItems);
+        _virtualItemsDirty = false;
+        rerender           = false;
+
+        if (!resized)
+        {
+            break;
+        }
+        updateVirtualInnerContainerSize();
+        _virtualItemsDirty = true;
+    }
+
+    for (auto&& virtualItem : _virtualItems)
+    {
+        layoutVirtualItem(virtualItem.item, virtualItem.index);
+    }
+    _virtualItemsDirty = false;
+}
+
 }  // namespace ui
 NS_AX_END
@@ -28,6 +28,7 @@ THE SOFTWARE.
 
 #include "ui/UIScrollView.h"
 #include "ui/GUIExport.h"
+#include <unordered_map>
 
 /**
  * @addtogroup ui
@@ -41,8 +42,8 @@ namespace ui
 /**
  *@brief ListView is a view group that displays a list of scrollable items.
  *The list items are inserted to the list by using `addChild` or  `insertDefaultItem`.
- * @warning The list item in ListView doesn't support cell reuse at the moment, if you have a large amount of data need
- *to be displayed, use  `TableView` instead. ListView is a subclass of  `ScrollView`, so it shares many features of
+ * @warning The list items in ListView aren't reused by default, if you have a large amount of data need to be displayed,
+ *use the virtual mode, see `setVirtual`. ListView is a subclass of  `ScrollView`, so it shares many features of
  *ScrollView.
  */
 class AX_GUI_DLL ListView : public ScrollView
@@ -94,6 +95,23 @@ public:
      */
     typedef std::function<void(Ref*, EventType)> ccListViewCallback;
 
+    /**
+     * Virtual ListView item template callback, returns the template of the item at index.
+     * Items are only reused by items of the same template.
+     */
+    typedef std::function<int(ssize_t)> ccListViewItemTemplateCallback;
+
+    /**
+     * Virtual ListView item creation callback, returns a new item of the template.
+     */
+    typedef std::function<Widget*(int)> ccListViewItemCreateCallback;
+
+    /**
+     * Virtual ListView item render callback, fills an item with the data at index.
+     * The item may be resized here, the list view measures it after rendering.
+     */
+    typedef std::function<void(Widget*, ssize_t)> ccListViewItemRenderCallback;
+
     /**
      * Default constructor
      * @js ctor
@@ -429,6 +447,90 @@ public:
 
     virtual bool init() override;
 
+    /**
+     * @brief Enable or disable the virtual mode.
+     * In virtual mode the list view holds `getVirtualItemCount` items but only creates the items in the current view.
+     * Items scrolled out of the view are recycled by template and bound to other indices through the render callback,
+     * so layout and visit cost doesn't depend on the item count.
+     * Items may have different sizes, the size of an item is known once it is rendered and `getEstimatedItemSize` is
+     * used for the items which have never been shown.
+     * The items added with `pushBackCustomItem` and the like are removed when the mode changes, and magnetic scroll
+     * isn't supported in virtual mode.
+     *
+     * @param isVirtual True to enable the virtual mode, false by default.
+     */
+    void setVirtual(bool isVirtual);
+
+    /**
+     * @brief Query whether the virtual mode is enabled.
+     * @return True if the list view is virtual.
+     */
+    bool isVirtual() const { return _virtual; }
+
+    /**
+     * @brief Set the number of items of a virtual list view.
+     * The sizes measured for the existing items are kept, new items are assumed to have the estimated item size.
+     * @param count The item count.
+     */
+    void setVirtualItemCount(ssize_t count);
+
+    /**
+     * @brief Get the number of items of a virtual list view.
+     * @return The item count.
+     */
+    ssize_t getVirtualItemCount() const { return _virtualItemCount; }
+
+    /**
+     * @brief Set the size along the scroll direction assumed for the items which have never been rendered.
+     * @param size The estimated size, the size of the item model or 0 by default.
+     */
+    void setEstimatedItemSize(float size);
+
+    /**
+     * @brief Get the estimated item size.
+     * @return The estimated size of an item along the scroll direction.
+     */
+    float getEstimatedItemSize() const { return _estimatedItemSize; }
+
+    /**
+     * @brief Set the callback returning the template of an item.
+     * All items share template 0 without a callback.
+     * @param callback A callback function with type of `ccListViewItemTemplateCallback`.
+     */
+    void setItemTemplateCallback(const ccListViewItemTemplateCallback& callback);
+
+    /**
+     * @brief Set the callback creating the items of a template.
+     * The item model is cloned without a callback.
+     * @param callback A callback function with type of `ccListViewItemCreateCallback`.
+     */
+    void setItemCreateCallback(const ccListViewItemCreateCallback& callback);
+
+    /**
+     * @brief Set the callback binding the data of an index to an item.
+     * @param callback A callback function with type of `ccListViewItemRenderCallback`.
+     */
+    void setItemRenderCallback(const ccListViewItemRenderCallback& callback);
+
+    /**
+     * @brief Render the items in the current view again, after their data changed.
+     */
+    void refreshVirtualItems();
+
+    /**
+     * @brief Query the item bound to an index of a virtual list view.
+     * @param index The item index.
+     * @return The item if it is in the current view, nullptr otherwise.
+     */
+    Widget* getVirtualItem(ssize_t index) const;
+
+    /**
+     * @brief Query the index an item of a virtual list view is bound to.
+     * @param item The item.
+     * @return The index of the item, -1 if the item isn't in the current view.
+     */
+    ssize_t getVirtualItemIndex(Widget* item) const;
+
 protected:
     virtual void handleReleaseLogic(Touch* touch) override;
 
@@ -452,6 +554,20 @@ protected:
 
     void startMagneticScroll();
     Vec2 calculateItemDestination(const Vec2& positionRatioInView, Widget* item, const Vec2& itemAnchorPoint);
+    Vec2 calculateVirtualItemDestination(const Vec2& positionRatioInView,
+                                         ssize_t itemIndex,
+                                         const Vec2& itemAnchorPoint);
+
+    void resetVirtualItemSizes();
+    void resetVirtualOffsetTree();
+    void setVirtualItemSize(ssize_t index, float size);
+    float getVirtualItemOffset(ssize_t index) const;
+    ssize_t findVirtualItemByOffset(float offset) const;
+    void updateVirtualInnerContainerSize();
+    void updateVirtualItems(bool rerender);
+    void layoutVirtualItem(Widget* item, ssize_t index);
+    void recycleVirtualItems();
+    Rect getVirtualItemRect(ssize_t index) const;
 
 protected:
     Widget* _model;
@@ -476,6 +592,25 @@ protected:
 
     bool _innerContainerDoLayoutDirty;
     ccListViewCallback _eventCallback;
+
+    struct VirtualItem
+    {
+        ssize_t index;
+        int templateId;
+        Widget* item;
+    };
+
+    bool _virtual;
+    bool _virtualItemsDirty;
+    ssize_t _virtualItemCount;
+    float _estimatedItemSize;
+    std::vector<float> _virtualItemSizes;    ///< measured size of each item along the scroll direction
+    std::vector<float> _virtualOffsetTree;   ///< binary indexed tree over _virtualItemSizes, for O(log n) offsets
+    std::vector<VirtualItem> _virtualItems;  ///< the items in the current view, sorted by index
+    std::unordered_map<int, Vector<Widget*>> _virtualItemPools;
+    ccListViewItemTemplateCallback _itemTemplateCallback;
+    ccListViewItemCreateCallback _itemCreateCallback;
+    ccListViewItemRenderCallback _itemRenderCallback;
 };
 
 }  // namespace ui
@@ -38,6 +38,10 @@
 #include "base/Director.h"
 #include "2d/Label.h"
 #include "2d/Sprite.h"
+#include "2d/SpriteBatchNode.h"
+#include "renderer/Renderer.h"
+#include "renderer/backend/ProgramManager.h"
+#include "renderer/backend/ProgramState.h"
 #include "base/UTF8.h"
 #include "ui/UIHelper.h"
 
@@ -1042,7 +1046,13 @@ const std::string RichText::KEY_ANCHOR_TEXT_SHADOW_OFFSET_HEIGHT("KEY_ANCHOR_TEX
 const std::string RichText::KEY_ANCHOR_TEXT_SHADOW_BLUR_RADIUS("KEY_ANCHOR_TEXT_SHADOW_BLUR_RADIUS");
 const std::string RichText::KEY_ANCHOR_TEXT_GLOW_COLOR("KEY_ANCHOR_TEXT_GLOW_COLOR");
 
-RichText::RichText() : _formatTextDirty(true), _leftSpaceWidth(0.0f)
+RichText::RichText()
+    : _formatTextDirty(true)
+    , _leftSpaceWidth(0.0f)
+    , _formattedElementCount(0)
+    , _formattedWidth(0.0f)
+    , _textBatchingEnabled(true)
+    , _textBatchesDirty(false)
 {
     _defaults[KEY_VERTICAL_SPACE]           = 0.0f;
     _defaults[KEY_WRAP_MODE]                = static_cast<int>(WrapMode::WRAP_PER_WORD);
@@ -1060,6 +1070,11 @@ RichText::RichText() : _formatTextDirty(true), _leftSpaceWidth(0.0f)
 RichText::~RichText()
 {
     _richElements.clear();
+    for (auto&& batch : _textBatches)
+    {
+        AX_SAFE_RELEASE(batch->programState);
+        delete batch;
+    }
 }
 
 RichText* RichText::create()
@@ -1131,6 +1146,34 @@ bool RichText::setString(std::string_view text)
     return true;
 }
 
+bool RichText::appendString(std::string_view text)
+{
+    if (text.empty())
+    {
+        return true;
+    }
+    _text.append(text);
+
+    // the elements are pushed back, so only they are laid out at the next format
+    std::string xmlText;
+    fmt::format_to(std::back_inserter(xmlText), FMT_COMPILE(R"(<font face="{}" size="{}" color="{}">{}</font>)"),
+                   this->getFontFace(), this->getFontSize(), this->getFontColor(), text);
+
+    MyXMLVisitor visitor(this);
+    SAXParser parser;
+    parser.setDelegator(&visitor);
+    return parser.parseIntrusive(&xmlText.front(), xmlText.length(), SAXParser::ParseOption::HTML);
+}
+
+void RichText::setTextBatchingEnabled(bool enabled)
+{
+    if (_textBatchingEnabled != enabled)
+    {
+        _textBatchingEnabled = enabled;
+        _formatTextDirty     = true;
+    }
+}
+
 void RichText::initRenderer() {}
 
 void RichText::insertElement(RichElement* element, int index)
@@ -1141,8 +1184,8 @@ void RichText::insertElement(RichElement* element, int index)
 
 void RichText::pushBackElement(RichElement* element)
 {
+    // formatText lays out the elements pushed back after the last format
     _richElements.pushBack(element);
-    _formatTextDirty = true;
 }
 
 void RichText::removeElement(int index)
@@ -1546,157 +1589,148 @@ void RichText::setOpenUrlHandler(const OpenUrlHandler& handleOpenUrl)
 void RichText::formatText(bool force)
 {
     _formatTextDirty |= force;
+    const ssize_t elementCount = _richElements.size();
     if (_formatTextDirty)
     {
         this->removeAllProtectedChildren();
         _elementRenders.clear();
         _lineHeights.clear();
+        _trimmedLabel = nullptr;
+
+        // the runs of the previous layout are reused for the same text, style and line space
+        _reusableTextRuns.swap(_textRuns);
+        _textRuns.clear();
+        _formattedElementCount = 0;
+        _formattedWidth        = _customSize.width;
+        addNewLine();
+    }
+    else if (_formattedElementCount < elementCount)
+    {
+        // only the elements pushed back are laid out, from the end of the last line
+        if (_trimmedLabel && !_elementRenders.back().empty() && _elementRenders.back().back() == _trimmedLabel)
+        {
+            static_cast<Label*>(_trimmedLabel.get())->setString(_trimmedText);
+        }
+        _trimmedLabel = nullptr;
+    }
+    else
+    {
+        return;
+    }
+
+    for (ssize_t i = _formattedElementCount; i < elementCount; ++i)
+    {
+        RichElement* element = _richElements.at(i);
         if (_ignoreSize)
         {
-            addNewLine();
-            for (ssize_t i = 0, size = _richElements.size(); i < size; ++i)
+            Node* elementRenderer = nullptr;
+            switch (element->_type)
             {
-                RichElement* element  = _richElements.at(i);
-                Node* elementRenderer = nullptr;
-                switch (element->_type)
-                {
-                case RichElement::Type::TEXT:
+            case RichElement::Type::TEXT:
+            {
+                RichElementText* elmtText = static_cast<RichElementText*>(element);
+                Label* label              = nullptr;
+                int length                = 0;
+                bool fits                 = false;
+                if (!reuseTextRun(elmtText, elmtText->_text, label, length, fits))
                 {
-                    RichElementText* elmtText = static_cast<RichElementText*>(element);
-                    Label* label;
-                    if (FileUtils::getInstance()->isFileExist(elmtText->_fontName))
-                    {
-                        label = Label::createWithTTF(elmtText->_text, elmtText->_fontName, elmtText->_fontSize);
-                    }
-                    else
-                    {
-                        label = Label::createWithSystemFont(elmtText->_text, elmtText->_fontName, elmtText->_fontSize);
-                    }
-                    if (elmtText->_flags & RichElementText::ITALICS_FLAG)
-                        label->enableItalics();
-                    if (elmtText->_flags & RichElementText::BOLD_FLAG)
-                        label->enableBold();
-                    if (elmtText->_flags & RichElementText::UNDERLINE_FLAG)
-                        label->enableUnderline();
-                    if (elmtText->_flags & RichElementText::STRIKETHROUGH_FLAG)
-                        label->enableStrikethrough();
-                    if (elmtText->_flags & RichElementText::URL_FLAG)
-                        label->addComponent(UrlTouchListenerComponent::create(
-                            label, elmtText->_url, [this](std::string_view url) { openUrl(url); }));
-                    if (elmtText->_flags & RichElementText::OUTLINE_FLAG)
-                    {
-                        label->enableOutline(Color4B(elmtText->_outlineColor), elmtText->_outlineSize);
-                    }
-                    if (elmtText->_flags & RichElementText::SHADOW_FLAG)
-                    {
-                        label->enableShadow(Color4B(elmtText->_shadowColor), elmtText->_shadowOffset,
-                                            elmtText->_shadowBlurRadius);
-                    }
-                    if (elmtText->_flags & RichElementText::GLOW_FLAG)
-                    {
-                        label->enableGlow(Color4B(elmtText->_glowColor));
-                    }
-                    label->setTextColor(Color4B(elmtText->_color));
-                    elementRenderer = label;
-                    break;
+                    label = createTextRenderer(elmtText, elmtText->_text);
+                    length = StringUtils::getCharacterCountInUTF8String(elmtText->_text);
+                    addTextRun(elmtText, elmtText->_text, label, length, true);
                 }
-                case RichElement::Type::IMAGE:
+                elementRenderer = label;
+                break;
+            }
+            case RichElement::Type::IMAGE:
+            {
+                RichElementImage* elmtImage = static_cast<RichElementImage*>(element);
+                if (elmtImage->_textureType == Widget::TextureResType::LOCAL)
+                    elementRenderer = Sprite::create(elmtImage->_filePath);
+                else
+                    elementRenderer = Sprite::createWithSpriteFrameName(elmtImage->_filePath);
+
+                if (elementRenderer && (elmtImage->_height != -1 || elmtImage->_width != -1))
                 {
-                    RichElementImage* elmtImage = static_cast<RichElementImage*>(element);
-                    if (elmtImage->_textureType == Widget::TextureResType::LOCAL)
-                        elementRenderer = Sprite::create(elmtImage->_filePath);
+                    auto currentSize = elementRenderer->getContentSize();
+                    if (elmtImage->_width != -1)
+                        elementRenderer->setScaleX((elmtImage->_width / currentSize.width) * elmtImage->_scaleX);
                     else
-                        elementRenderer = Sprite::createWithSpriteFrameName(elmtImage->_filePath);
+                        elementRenderer->setScaleX(elmtImage->_scaleX);
 
-                    if (elementRenderer && (elmtImage->_height != -1 || elmtImage->_width != -1))
-                    {
-                        auto currentSize = elementRenderer->getContentSize();
-                        if (elmtImage->_width != -1)
-                            elementRenderer->setScaleX((elmtImage->_width / currentSize.width) * elmtImage->_scaleX);
-                        else
-                            elementRenderer->setScaleX(elmtImage->_scaleX);
-
-                        if (elmtImage->_height != -1)
-                            elementRenderer->setScaleY((elmtImage->_height / currentSize.height) * elmtImage->_scaleY);
-                        else
-                            elementRenderer->setScaleY(elmtImage->_scaleY);
-
-                        elementRenderer->setContentSize(Vec2(currentSize.width * elementRenderer->getScaleX(),
-                                                             currentSize.height * elementRenderer->getScaleY()));
-                        elementRenderer->addComponent(
-                            UrlTouchListenerComponent::create(elementRenderer, elmtImage->_url,
-                                                      std::bind(&RichText::openUrl, this, std::placeholders::_1)));
-                        elementRenderer->setColor(element->_color);
-                    }
-                    break;
-                }
-                case RichElement::Type::CUSTOM:
-                {
-                    RichElementCustomNode* elmtCustom = static_cast<RichElementCustomNode*>(element);
-                    elementRenderer                   = elmtCustom->_customNode;
+                    if (elmtImage->_height != -1)
+                        elementRenderer->setScaleY((elmtImage->_height / currentSize.height) * elmtImage->_scaleY);
+                    else
+                        elementRenderer->setScaleY(elmtImage->_scaleY);
+
+                    elementRenderer->setContentSize(Vec2(currentSize.width * elementRenderer->getScaleX(),
+                                                         currentSize.height * elementRenderer->getScaleY()));
+                    elementRenderer->addComponent(
+                        UrlTouchListenerComponent::create(elementRenderer, elmtImage->_url,
+                                                  std::bind(&RichText::openUrl, this, std::placeholders::_1)));
                     elementRenderer->setColor(element->_color);
-                    break;
-                }
-                case RichElement::Type::NEWLINE:
-                {
-                    addNewLine();
-                    break;
-                }
-                default:
-                    break;
                 }
+                break;
+            }
+            case RichElement::Type::CUSTOM:
+            {
+                RichElementCustomNode* elmtCustom = static_cast<RichElementCustomNode*>(element);
+                elementRenderer                   = elmtCustom->_customNode;
+                elementRenderer->setColor(element->_color);
+                break;
+            }
+            case RichElement::Type::NEWLINE:
+            {
+                addNewLine();
+                break;
+            }
+            default:
+                break;
+            }
 
-                if (elementRenderer)
-                {
-                    elementRenderer->setOpacity(element->_opacity);
-                    pushToContainer(elementRenderer);
-                }
+            if (elementRenderer)
+            {
+                elementRenderer->setOpacity(element->_opacity);
+                pushToContainer(elementRenderer);
             }
         }
         else
         {
-            addNewLine();
-            for (ssize_t i = 0, size = _richElements.size(); i < size; ++i)
+            switch (element->_type)
             {
-                RichElement* element = static_cast<RichElement*>(_richElements.at(i));
-                switch (element->_type)
-                {
-                case RichElement::Type::TEXT:
-                {
-                    RichElementText* elmtText = static_cast<RichElementText*>(element);
-                    handleTextRenderer(elmtText->_text, elmtText->_fontName, elmtText->_fontSize, elmtText->_color,
-                                       elmtText->_opacity, elmtText->_flags, elmtText->_url, elmtText->_outlineColor,
-                                       elmtText->_outlineSize, elmtText->_shadowColor, elmtText->_shadowOffset,
-                                       elmtText->_shadowBlurRadius, elmtText->_glowColor);
-                    break;
-                }
-                case RichElement::Type::IMAGE:
-                {
-                    RichElementImage* elmtImage = static_cast<RichElementImage*>(element);
-                    handleImageRenderer(elmtImage->_filePath, elmtImage->_textureType, elmtImage->_color,
-                                        elmtImage->_opacity, elmtImage->_width, elmtImage->_height, elmtImage->_url,
-                                        elmtImage->_scaleX, elmtImage->_scaleY);
-                    break;
-                }
-                case RichElement::Type::CUSTOM:
-                {
-                    RichElementCustomNode* elmtCustom = static_cast<RichElementCustomNode*>(element);
-                    handleCustomRenderer(elmtCustom->_customNode);
-                    break;
-                }
-                case RichElement::Type::NEWLINE:
-                {
-                    addNewLine();
-                    break;
-                }
-                default:
-                    break;
-                }
+            case RichElement::Type::TEXT:
+            {
+                handleTextRenderer(static_cast<RichElementText*>(element));
+                break;
+            }
+            case RichElement::Type::IMAGE:
+            {
+                RichElementImage* elmtImage = static_cast<RichElementImage*>(element);
+                handleImageRenderer(elmtImage->_filePath, elmtImage->_textureType, elmtImage->_color,
+                                    elmtImage->_opacity, elmtImage->_width, elmtImage->_height, elmtImage->_url,
+                                    elmtImage->_scaleX, elmtImage->_scaleY);
+                break;
+            }
+            case RichElement::Type::CUSTOM:
+            {
+                RichElementCustomNode* elmtCustom = static_cast<RichElementCustomNode*>(element);
+                handleCustomRenderer(elmtCustom->_customNode);
+                break;
+            }
+            case RichElement::Type::NEWLINE:
+            {
+                addNewLine();
+                break;
+            }
+            default:
+                break;
             }
         }
-        formatRenderers();
-        _formatTextDirty = false;
     }
+    _formattedElementCount = elementCount;
+    _reusableTextRuns.clear();
+
+    formatRenderers();
+    _formatTextDirty = false;
 }
 
 namespace
@@ -1865,12 +1899,22 @@ void RichText::handleTextRenderer(std::string_view text,
                                   int shadowBlurRadius,
                                   const Color3B& glowColor)
 {
-    bool fileExist              = FileUtils::getInstance()->isFileExist(fontName);
+    auto element = RichElementText::create(0, color, opacity, text, fontName, fontSize, flags, url, outlineColor,
+                                           outlineSize, shadowColor, shadowOffset, shadowBlurRadius, glowColor);
+    if (element)
+    {
+        handleTextRenderer(element);
+    }
+}
+
+void RichText::handleTextRenderer(RichElementText* element)
+{
+    const float fontSize        = element->_fontSize;
     RichText::WrapMode wrapMode = static_cast<RichText::WrapMode>(_defaults.at(KEY_WRAP_MODE).asInt());
 
     // split text by \n
     std::stringstream ss;
-    ss << text;
+    ss << element->_text;
     std::string currentText;
     size_t realLines = 0;
     while (std::getline(ss, currentText, '\n'))
@@ -1893,63 +1937,59 @@ void RichText::handleTextRenderer(std::string_view text,
             }
             ++splitParts;
 
-            Label* textRenderer = fileExist ? Label::createWithTTF(currentText, fontName, fontSize)
-                                            : Label::createWithSystemFont(currentText, fontName, fontSize);
-
-            if (flags & RichElementText::ITALICS_FLAG)
-                textRenderer->enableItalics();
-            if (flags & RichElementText::BOLD_FLAG)
-                textRenderer->enableBold();
-            if (flags & RichElementText::UNDERLINE_FLAG)
-                textRenderer->enableUnderline();
-            if (flags & RichElementText::STRIKETHROUGH_FLAG)
-                textRenderer->enableStrikethrough();
-            if (flags & RichElementText::URL_FLAG)
-                textRenderer->addComponent(UrlTouchListenerComponent::create(
-                    textRenderer, url, [this](std::string_view url) { openUrl(url); }));
-            if (flags & RichElementText::OUTLINE_FLAG)
-                textRenderer->enableOutline(Color4B(outlineColor), outlineSize);
-            if (flags & RichElementText::SHADOW_FLAG)
-                textRenderer->enableShadow(Color4B(shadowColor), shadowOffset, shadowBlurRadius);
-            if (flags & RichElementText::GLOW_FLAG)
-                textRenderer->enableGlow(Color4B(glowColor));
-
-            textRenderer->setTextColor(Color4B(color));
-            textRenderer->setOpacity(opacity);
-
-            // textRendererWidth will get 0.0f, when we've got glError: 0x0501 in Label::getContentSize
-            // It happens when currentText is very very long so that can't generate a texture
-            const float textRendererWidth = textRenderer->getContentSize().width;
+            Label* textRenderer = nullptr;
+            int leftLength      = 0;
+            bool fits           = false;
+            if (!reuseTextRun(element, currentText, textRenderer, leftLength, fits))
+            {
+                textRenderer = createTextRenderer(element, currentText);
+
+                // textRendererWidth will get 0.0f, when we've got glError: 0x0501 in Label::getContentSize
+                // It happens when currentText is very very long so that can't generate a texture
+                const float textRendererWidth = textRenderer->getContentSize().width;
+
+                fits = (textRendererWidth > 0.0f && _leftSpaceWidth >= textRendererWidth);
+                if (fits)
+                {
+                    leftLength = static_cast<int>(utf8Text.length());
+                }
+                else
+                {
+                    // rough estimate
+                    // when textRendererWidth == 0.0f, use fontSize as the rough estimate of width for each char,
+                    //  (_leftSpaceWidth / fontSize) means how many chars can be aligned in leftSpaceWidth.
+                    int estimatedIdx = 0;
+                    if (textRendererWidth > 0.0f)
+                        estimatedIdx = static_cast<int>(_leftSpaceWidth / textRendererWidth * utf8Text.length());
+                    else
+                        estimatedIdx = static_cast<int>(_leftSpaceWidth / fontSize);
+
+                    if (wrapMode == WRAP_PER_WORD)
+                        leftLength = findSplitPositionForWord(textRenderer, utf8Text, estimatedIdx, _leftSpaceWidth,
+                                                              _customSize.width);
+                    else
+                        leftLength = findSplitPositionForChar(textRenderer, utf8Text, estimatedIdx, _leftSpaceWidth,
+                                                              _customSize.width);
+
+                    // split string
+                    if (leftLength > 0)
+                        textRenderer->setString(utf8Text.getAsCharSequence(0, leftLength));
+                    else
+                        textRenderer = nullptr;
+                }
+                addTextRun(element, currentText, textRenderer, leftLength, fits);
+            }
 
             // no splitting
-            if (textRendererWidth > 0.0f && _leftSpaceWidth >= textRendererWidth)
+            if (fits)
             {
-                _leftSpaceWidth -= textRendererWidth;
+                _leftSpaceWidth -= textRenderer->getContentSize().width;
                 pushToContainer(textRenderer);
                 break;
             }
 
-            // rough estimate
-            // when textRendererWidth == 0.0f, use fontSize as the rough estimate of width for each char,
-            //  (_leftSpaceWidth / fontSize) means how many chars can be aligned in leftSpaceWidth.
-            int estimatedIdx = 0;
-            if (textRendererWidth > 0.0f)
-                estimatedIdx = static_cast<int>(_leftSpaceWidth / textRendererWidth * utf8Text.length());
-            else
-                estimatedIdx = static_cast<int>(_leftSpaceWidth / fontSize);
-
-            int leftLength = 0;
-            if (wrapMode == WRAP_PER_WORD)
-                leftLength =
-                    findSplitPositionForWord(textRenderer, utf8Text, estimatedIdx, _leftSpaceWidth, _customSize.width);
-            else
-                leftLength =
-                    findSplitPositionForChar(textRenderer, utf8Text, estimatedIdx, _leftSpaceWidth, _customSize.width);
-
-            // split string
-            if (leftLength > 0)
+            if (textRenderer)
             {
-                textRenderer->setString(utf8Text.getAsCharSequence(0, leftLength));
                 pushToContainer(textRenderer);
             }
 
@@ -1967,16 +2007,115 @@ void RichText::handleTextRenderer(std::string_view text,
             currentText = utf8Text.getAsCharSequence();
         }
     }
-    
+
     // std::getline discards the delimiter, so if it exists at the end of the text, then
     // a new line entry should be added
-    if (!text.empty() && (text.back() == '\n'))
+    if (!element->_text.empty() && (element->_text.back() == '\n'))
     {
         addNewLine();
         _lineHeights.back() = fontSize;
     }
 }
 
+Label* RichText::createTextRenderer(RichElementText* element, std::string_view text)
+{
+    Label* textRenderer = FileUtils::getInstance()->isFileExist(element->_fontName)
+                              ? Label::createWithTTF(text, element->_fontName, element->_fontSize)
+                              : Label::createWithSystemFont(text, element->_fontName, element->_fontSize);
+
+    const uint32_t flags = element->_flags;
+    if (flags & RichElementText::ITALICS_FLAG)
+        textRenderer->enableItalics();
+    if (flags & RichElementText::BOLD_FLAG)
+        textRenderer->enableBold();
+    if (flags & RichElementText::UNDERLINE_FLAG)
+        textRenderer->enableUnderline();
+    if (flags & RichElementText::STRIKETHROUGH_FLAG)
+        textRenderer->enableStrikethrough();
+    if (flags & RichElementText::URL_FLAG)
+        textRenderer->addComponent(UrlTouchListenerComponent::create(
+            textRenderer, element->_url, [this](std::string_view url) { openUrl(url); }));
+    if (flags & RichElementText::OUTLINE_FLAG)
+        textRenderer->enableOutline(Color4B(element->_outlineColor), element->_outlineSize);
+    if (flags & RichElementText::SHADOW_FLAG)
+        textRenderer->enableShadow(Color4B(element->_shadowColor), element->_shadowOffset,
+                                   element->_shadowBlurRadius);
+    if (flags & RichElementText::GLOW_FLAG)
+        textRenderer->enableGlow(Color4B(element->_glowColor));
+
+    textRenderer->setTextColor(Color4B(element->_color));
+    textRenderer->setOpacity(element->_opacity);
+    return textRenderer;
+}
+
+bool RichText::reuseTextRun(RichElementText* element, std::string_view text, Label*& label, int& length, bool& fits)
+{
+    auto runsIt = _reusableTextRuns.find(text);
+    if (runsIt == _reusableTextRuns.end())
+    {
+        return false;
+    }
+
+    auto isSameStyle = [element](const RichElementText* other) {
+        return element->_fontName == other->_fontName && element->_fontSize == other->_fontSize &&
+               element->_flags == other->_flags && element->_color == other->_color &&
+               element->_opacity == other->_opacity && element->_url == other->_url &&
+               element->_outlineColor == other->_outlineColor && element->_outlineSize == other->_outlineSize &&
+               element->_shadowColor == other->_shadowColor && element->_shadowOffset == other->_shadowOffset &&
+               element->_shadowBlurRadius == other->_shadowBlurRadius && element->_glowColor == other->_glowColor;
+    };
+
+    auto& runs = runsIt.value();
+    for (auto run = runs.begin(); run != runs.end(); ++run)
+    {
+        if (!isSameStyle(run->element.get()))
+        {
+            continue;
+        }
+
+        Label* runLabel = static_cast<Label*>(run->renderer.get());
+        if (runLabel && runLabel->getString() != run->runText)
+        {
+            runLabel->setString(run->runText);
+        }
+
+        bool matched = false;
+        if (run->fits)
+        {
+            // a whole text fits in any line with enough space left
+            const float width = runLabel->getContentSize().width;
+            matched           = _ignoreSize || (width > 0.0f && _leftSpaceWidth >= width);
+        }
+        else if (!_ignoreSize)
+        {
+            // a cut is the same in the same line space
+            matched = (run->leftSpaceWidth == _leftSpaceWidth && run->lineWidth == _customSize.width);
+        }
+
+        if (matched)
+        {
+            label  = runLabel;
+            length = run->length;
+            fits   = run->fits;
+            addTextRun(element, text, label, length, fits);
+            runs.erase(run);
+            return true;
+        }
+    }
+    return false;
+}
+
+void RichText::addTextRun(RichElementText* element, std::string_view text, Label* label, int length, bool fits)
+{
+    auto runsIt = _textRuns.find(text);
+    if (runsIt == _textRuns.end())
+    {
+        runsIt = _textRuns.emplace(text, std::vector<TextRun>()).first;
+    }
+    runsIt.value().push_back(TextRun{element, label, label ? std::string{label->getString()} : std::string{},
+                                     length, _leftSpaceWidth, _customSize.width, fits});
+}
+
 void RichText::handleImageRenderer(std::string_view filePath,
                                    Widget::TextureResType textureType,
                                    const Color3B& /*color*/,
@@ -2055,7 +2194,8 @@ void RichText::formatRenderers()
             {
                 iter->setAnchorPoint(Vec2::ZERO);
                 iter->setPosition(nextPosX, nextPosY);
-                this->addProtectedChild(iter, 1);
+                if (iter->getParent() != this && !isBatchableTextRenderer(iter))
+                    this->addProtectedChild(iter, 1);
                 Vec2 iSize = iter->getContentSize();
                 newContentSizeWidth += iSize.width;
                 nextPosX += iSize.width;
@@ -2106,7 +2246,8 @@ void RichText::formatRenderers()
             {
                 iter->setAnchorPoint(Vec2::ZERO);
                 iter->setPosition(nextPosX, nextPosY);
-                this->addProtectedChild(iter, 1);
+                if (iter->getParent() != this && !isBatchableTextRenderer(iter))
+                    this->addProtectedChild(iter, 1);
                 nextPosX += iter->getContentSize().width;
             }
 
@@ -2114,8 +2255,8 @@ void RichText::formatRenderers()
         }
     }
 
-    _elementRenders.clear();
-    _lineHeights.clear();
+    // the lines are kept, so that elements pushed back are laid out after them
+    _textBatchesDirty = true;
 
     if (_ignoreSize)
     {
@@ -2185,6 +2326,8 @@ float RichText::stripTrailingWhitespace(const Vector<ax::Node*>& row)
             rtrim(trimmedString);
             if (label->getString() != trimmedString)
             {
+                _trimmedLabel = label;
+                _trimmedText  = label->getString();
                 label->setString(trimmedString);
                 return label->getContentSize().width - width;
             }
@@ -2198,6 +2341,169 @@ void RichText::adaptRenderers()
     this->formatText();
 }
 
+void RichText::onSizeChanged()
+{
+    Widget::onSizeChanged();
+
+    // a new width only wraps the elements again, the runs which still fit are reused
+    if (!_ignoreSize && _customSize.width != _formattedWidth)
+    {
+        _formatTextDirty = true;
+    }
+}
+
+bool RichText::isBatchableTextRenderer(Node* renderer) const
+{
+    if (!_textBatchingEnabled)
+    {
+        return false;
+    }
+    auto label = dynamic_cast<Label*>(renderer);
+    return label && label->getLabelType() == Label::LabelType::TTF &&
+           label->getLabelEffectType() == LabelEffect::NORMAL && !label->isShadowEnabled() &&
+           label->getRotationSkewX() == 0.0f && label->getChildrenCount() == 0 &&
+           label->getComponent(UrlTouchListenerComponent::COMPONENT_NAME) == nullptr;
+}
+
+void RichText::updateTextBatches()
+{
+    for (auto&& batch : _textBatches)
+    {
+        batch->vertices.clear();
+        batch->indices.clear();
+    }
+
+    Color4F parentColor(1.0f, 1.0f, 1.0f, 1.0f);
+    if (_cascadeColorEnabled)
+    {
+        parentColor.r = _displayedColor.r / 255.0f;
+        parentColor.g = _displayedColor.g / 255.0f;
+        parentColor.b = _displayedColor.b / 255.0f;
+    }
+    if (_cascadeOpacityEnabled)
+    {
+        parentColor.a = _displayedOpacity / 255.0f;
+    }
+
+    // quads are indexed with 16 bits, so a batch holds up to 16384 of them
+    const size_t maxBatchVertices = 65536;
+    for (auto&& row : _elementRenders)
+    {
+        for (auto&& renderer : row)
+        {
+            if (renderer->getParent() == this || !isBatchableTextRenderer(renderer))
+            {
+                continue;
+            }
+
+            // querying the content size lays out the glyph quads of a changed label
+            auto label = static_cast<Label*>(renderer);
+            label->getContentSize();
+            const Mat4& transform = label->getNodeToParentTransform();
+
+            // same color as the label shader, which multiplies the vertex color by the text color
+            const Color4B& textColor = label->getTextColor();
+            const Color3B& color     = label->getDisplayedColor();
+            const float opacity      = label->getDisplayedOpacity() / 255.0f * parentColor.a;
+            Color4B vertexColor(
+                static_cast<uint8_t>(color.r * parentColor.r * textColor.r / 255.0f),
+                static_cast<uint8_t>(color.g * parentColor.g * textColor.g / 255.0f),
+                static_cast<uint8_t>(color.b * parentColor.b * textColor.b / 255.0f),
+                static_cast<uint8_t>(255 * opacity * textColor.a / 255.0f));
+            if (label->isOpacityModifyRGB())
+            {
+                vertexColor.r = static_cast<uint8_t>(vertexColor.r * opacity);
+                vertexColor.g = static_cast<uint8_t>(vertexColor.g * opacity);
+                vertexColor.b = static_cast<uint8_t>(vertexColor.b * opacity);
+            }
+
+            for (auto&& batchNode : label->getBatchNodes())
+            {
+                auto textureAtlas = batchNode->getTextureAtlas();
+                auto quads        = textureAtlas->getQuads();
+                auto quadCount    = textureAtlas->getTotalQuads();
+                if (quadCount == 0)
+                {
+                    continue;
+                }
+
+                Texture2D* texture  = textureAtlas->getTexture();
+                TextBatch* batch    = nullptr;
+                for (auto&& candidate : _textBatches)
+                {
+                    if (candidate->texture == texture && candidate->blendFunc == label->getBlendFunc() &&
+                        candidate->vertices.size() + quadCount * 4 <= maxBatchVertices)
+                    {
+                        batch = candidate;
+                        break;
+                    }
+                }
+                if (batch == nullptr)
+                {
+                    batch               = new TextBatch();
+                    batch->texture      = texture;
+                    batch->blendFunc    = label->getBlendFunc();
+                    batch->programState = new backend::ProgramState(
+                        ProgramManager::getInstance()->getBuiltinProgram(backend::ProgramType::LABEL_NORMAL));
+                    batch->programState->validateSharedVertexLayout(backend::VertexLayoutType::Sprite);
+                    batch->programState->setTexture(texture->getBackendTexture());
+
+                    // the text color is in the vertices, so that runs of any color share the batch
+                    Vec4 white(1.0f, 1.0f, 1.0f, 1.0f);
+                    batch->programState->setUniform(
+                        batch->programState->getUniformLocation(backend::Uniform::TEXT_COLOR), &white, sizeof(white));
+                    batch->command.getPipelineDescriptor().programState = batch->programState;
+                    _textBatches.push_back(batch);
+                }
+
+                for (int i = 0; i < quadCount; ++i)
+                {
+                    auto base = static_cast<unsigned short>(batch->vertices.size());
+                    for (auto&& vertex : {quads[i].tl, quads[i].bl, quads[i].tr, quads[i].br})
+                    {
+                        V3F_C4B_T2F batchVertex = vertex;
+                        transform.transformPoint(&batchVertex.vertices);
+                        batchVertex.colors = vertexColor;
+                        batch->vertices.push_back(batchVertex);
+                    }
+                    for (auto index : {0, 1, 2, 3, 2, 1})
+                    {
+                        batch->indices.push_back(static_cast<unsigned short>(base + index));
+                    }
+                }
+            }
+        }
+    }
+
+    _textBatchesColor = Color4B(_displayedColor, _displayedOpacity);
+    _textBatchesDirty = false;
+}
+
+void RichText::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
+{
+    if (_textBatchesDirty || _textBatchesColor != Color4B(_displayedColor, _displayedOpacity))
+    {
+        updateTextBatches();
+    }
+
+    const auto& projectionMat = _director->getMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION);
+    for (auto&& batch : _textBatches)
+    {
+        if (batch->indices.empty())
+        {
+            continue;
+        }
+        batch->programState->setUniform(batch->programState->getUniformLocation(backend::Uniform::MVP_MATRIX),
+                                        projectionMat.m, sizeof(projectionMat.m));
+
+        TrianglesCommand::Triangles triangles(batch->vertices.data(), batch->indices.data(),
+                                              static_cast<unsigned int>(batch->vertices.size()),
+                                              static_cast<unsigned int>(batch->indices.size()));
+        batch->command.init(_globalZOrder, batch->texture, batch->blendFunc, triangles, transform, flags);
+        renderer->addCommand(&batch->command);
+    }
+}
+
 void RichText::pushToContainer(ax::Node* renderer)
 {
     if (_elementRenders.empty())
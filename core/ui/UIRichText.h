@@ -29,6 +29,10 @@
 #include "ui/UIWidget.h"
 #include "ui/GUIExport.h"
 #include "base/Value.h"
+#include "base/RefPtr.h"
+#include "base/hlookup.h"
+#include "renderer/TrianglesCommand.h"
+#include <unordered_set>
 
 NS_AX_BEGIN
 /**
@@ -596,8 +600,62 @@ public:
 
     bool setString(std::string_view text);
 
+    /**
+     * @brief Append an XML string to the RichText.
+     * The appended string is parsed on its own, so the tags opened in it must be closed in it. Unless the RichText has
+     * to be formatted again for another reason, only the appended elements are laid out.
+     *
+     * @param text An XML string.
+     * @return True if the string was parsed.
+     */
+    bool appendString(std::string_view text);
+
+    /**
+     * @brief Draw the plain text runs with batched quads instead of a Label node per run.
+     * The runs using a TTF font, without effect, url or line are drawn by the RichText itself, with one command for
+     * each font atlas texture.
+     *
+     * @param enabled True to batch the plain text runs, true by default.
+     */
+    void setTextBatchingEnabled(bool enabled);
+
+    /**
+     * @brief Query whether the plain text runs are batched.
+     * @return True if the plain text runs are batched.
+     */
+    bool isTextBatchingEnabled() const { return _textBatchingEnabled; }
+
+    virtual void draw(Renderer* renderer, const Mat4& transform, uint32_t flags) override;
+
 protected:
+    /**
+     * A line run cut from a text element, cached so that a layout with the same text, style and line space reuses
+     * its renderer instead of measuring the text again.
+     */
+    struct TextRun
+    {
+        RefPtr<RichElementText> element; ///< the element holding the style of the run
+        RefPtr<Node> renderer;           ///< the Label of the run, nullptr if nothing fit in the line
+        std::string runText;             ///< the text of the Label before any trailing whitespace was stripped
+        int length;                      ///< the number of characters in the run
+        float leftSpaceWidth;            ///< the space left in the line when the run was cut
+        float lineWidth;                 ///< the width of the lines when the run was cut
+        bool fits;                       ///< whether the whole text fit in the line
+    };
+
+    /** Glyph quads of the plain text runs sharing a font atlas texture. */
+    struct TextBatch
+    {
+        Texture2D* texture;
+        BlendFunc blendFunc;
+        backend::ProgramState* programState;
+        std::vector<V3F_C4B_T2F> vertices;
+        std::vector<unsigned short> indices;
+        TrianglesCommand command;
+    };
+
     virtual void adaptRenderers() override;
+    virtual void onSizeChanged() override;
 
     virtual void initRenderer() override;
     void pushToContainer(Node* renderer);
@@ -614,6 +672,12 @@ protected:
                             const Vec2& shadowOffset    = Vec2(2.0, -2.0),
                             int shadowBlurRadius        = 0,
                             const Color3B& glowColor    = Color3B::WHITE);
+    void handleTextRenderer(RichElementText* element);
+    Label* createTextRenderer(RichElementText* element, std::string_view text);
+    bool reuseTextRun(RichElementText* element, std::string_view text, Label*& label, int& length, bool& fits);
+    void addTextRun(RichElementText* element, std::string_view text, Label* label, int length, bool fits);
+    bool isBatchableTextRenderer(Node* renderer) const;
+    void updateTextBatches();
     void handleImageRenderer(std::string_view filePath,
                              Widget::TextureResType textureType,
                              const Color3B& color,
@@ -640,6 +704,18 @@ protected:
 
     std::string _text;
     std::string _xmlText;
+
+    hlookup::string_map<std::vector<TextRun>> _textRuns;          /*!< runs of the layout, by the text they were cut from */
+    hlookup::string_map<std::vector<TextRun>> _reusableTextRuns;  /*!< runs of the previous layout while formatting */
+    ssize_t _formattedElementCount;                               /*!< the number of elements laid out */
+    float _formattedWidth;                                        /*!< the line width of the layout */
+    RefPtr<Node> _trimmedLabel;                                   /*!< the last Label stripped of trailing whitespace */
+    std::string _trimmedText;                                     /*!< the text of _trimmedLabel before it was stripped */
+
+    bool _textBatchingEnabled;
+    bool _textBatchesDirty;
+    Color4B _textBatchesColor;
+    std::vector<TextBatch*> _textBatches;
 };
 
 }  // namespace ui
@@ -254,6 +254,8 @@ public:
 
     // override the widget's hitTest function to perform its own
     virtual bool hitTest(const Vec2& pt, const Camera* camera, Vec3* p) const override;
+    // the slider bar may be larger than the content size
+    virtual bool isHitTestBoundedByContent() const override { return false; }
     /**
      * Returns the "class name" of widget.
      */
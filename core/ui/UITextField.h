@@ -294,6 +294,7 @@ public:
     void setTouchAreaEnabled(bool enable);
 
     virtual bool hitTest(const Vec2& pt, const Camera* camera, Vec3* p) const override;
+    virtual bool isHitTestBoundedByContent() const override { return false; }
 
     /**
      * @brief Set placeholder of TextField.
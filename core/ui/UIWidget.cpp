@@ -557,6 +557,7 @@ void Widget::setTouchEnabled(bool enable)
         _touchListener = EventListenerTouchOneByOne::create();
         AX_SAFE_RETAIN(_touchListener);
         _touchListener->setSwallowTouches(true);
+        _touchListener->setBoundedByNode(isHitTestBoundedByContent());
         _touchListener->onTouchBegan     = AX_CALLBACK_2(Widget::onTouchBegan, this);
         _touchListener->onTouchMoved     = AX_CALLBACK_2(Widget::onTouchMoved, this);
         _touchListener->onTouchEnded     = AX_CALLBACK_2(Widget::onTouchEnded, this);
@@ -450,6 +450,15 @@ public:
      */
     virtual bool hitTest(const Vec2& pt, const Camera* camera, Vec3* p) const;
 
+    /**
+     * Whether hitTest never succeeds outside the content size of the widget.
+     * Bounded widgets are skipped by the touch spatial index of the event dispatcher when they aren't under the touch.
+     *
+     * @return true if the touch area is the content size of the widget, false otherwise.
+     * @see EventDispatcher::setTouchSpatialIndexEnabled
+     */
+    virtual bool isHitTestBoundedByContent() const { return true; }
+
     /**
      * A callback which will be called when touch began event is issued.
      *@param touch The touch info.
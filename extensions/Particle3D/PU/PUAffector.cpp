@@ -200,4 +200,43 @@ void PUAffector::process(PUParticle3D* particle, float delta, bool firstParticle
     updatePUAffector(particle, delta);
 }
 
+void PUAffector::updatePUAffectors(PUParticleSoA& particles, float delta)
+{
+    particles.flush();
+    auto span = particles.getParticles();
+    for (size_t i = 0, count = particles.size(); i < count; ++i)
+    {
+        updatePUAffector(span[i], delta);
+    }
+    particles.invalidate();
+}
+
+void PUAffector::processSpan(PUParticleSoA& particles, float delta, bool firstParticle)
+{
+    const auto count = particles.size();
+    if (count == 0)
+        return;
+
+    auto span = particles.getParticles();
+    if (!_excludedEmitters.empty())
+    {
+        // per particle, to skip the excluded ones
+        particles.flush();
+        for (size_t i = 0; i < count; ++i)
+        {
+            process(span[i], delta, firstParticle && i == 0);
+        }
+        particles.invalidate();
+        return;
+    }
+
+    if (firstParticle)
+    {
+        particles.flush();
+        firstParticleUpdate(span[0], delta);
+        particles.invalidate();
+    }
+    updatePUAffectors(particles, delta);
+}
+
 NS_AX_END
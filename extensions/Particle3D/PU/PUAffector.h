@@ -30,6 +30,7 @@
 #include "base/Ref.h"
 #include "math/Math.h"
 #include "extensions/Particle3D/Particle3DAffector.h"
+#include "extensions/Particle3D/PU/PUParticleSoA.h"
 #include <vector>
 #include <string>
 
@@ -68,6 +69,16 @@ public:
     virtual void initParticleForEmission(PUParticle3D* particle);
     void process(PUParticle3D* particle, float delta, bool firstParticle);
 
+    /** Whether the affector only reads and writes the particle it is given, so the particle system may run it over
+        all the particles at once with updatePUAffectors() instead of interleaving it with the other affectors.
+    */
+    virtual bool isSpanProcessingSupported() const { return false; }
+    /** Affects all the particles of the store, writes the store back and calls updatePUAffector() for each particle
+        by default, affectors with a kernel of the store override it.
+     */
+    virtual void updatePUAffectors(PUParticleSoA& particles, float delta);
+    void processSpan(PUParticleSoA& particles, float delta, bool firstParticle);
+
     void setLocalPosition(const Vec3& pos) { _position = pos; };
     const Vec3 getLocalPosition() const { return _position; };
     void setMass(float mass);
@@ -70,6 +70,20 @@ void PUGravityAffector::updatePUAffector(PUParticle3D* particle, float deltaTime
     }
 }
 
+void PUGravityAffector::updatePUAffectors(PUParticleSoA& particles, float deltaTime)
+{
+    if (_affectSpecialisation != AFSP_DEFAULT)
+    {
+        // the factor depends on the particle
+        PUAffector::updatePUAffectors(particles, deltaTime);
+        return;
+    }
+
+    // the gravity constants are the same for all the particles
+    float scaleVelocity = (static_cast<PUParticleSystem3D*>(_particleSystem))->getParticleSystemScaleVelocity();
+    particles.attract(_derivedPosition, scaleVelocity * _gravity * _mass * deltaTime);
+}
+
 void PUGravityAffector::preUpdateAffector(float /*deltaTime*/)
 {
     getDerivedPosition();
@@ -42,6 +42,7 @@ public:
     static PUJetAffector* create();
 
     virtual void updatePUAffector(PUParticle3D* particle, float deltaTime) override;
+    virtual bool isSpanProcessingSupported() const override { return true; }
 
     /**
      */
@@ -54,6 +54,24 @@ void PULinearForceAffector::updatePUAffector(PUParticle3D* particle, float /*del
     }
 }
 
+void PULinearForceAffector::updatePUAffectors(PUParticleSoA& particles, float deltaTime)
+{
+    if (_forceApplication == FA_ADD)
+    {
+        if (_affectSpecialisation != AFSP_DEFAULT)
+        {
+            // the factor depends on the particle
+            PUAffector::updatePUAffectors(particles, deltaTime);
+            return;
+        }
+        particles.addToDirection(_scaledVector);
+    }
+    else
+    {
+        particles.averageDirection(_forceVector);
+    }
+}
+
 PULinearForceAffector* PULinearForceAffector::create()
 {
     auto plfa = new PULinearForceAffector();
@@ -0,0 +1,452 @@
+/****************************************************************************
+ Copyright (c) 2022 Bytedance Inc.
+
+ https://axmolengine.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "extensions/Particle3D/PU/PUParticleSoA.h"
+#include "extensions/Particle3D/PU/PUParticleSystem3D.h"
+
+#if defined(__SSE__)
+#    include <xmmintrin.h>
+#    define AX_PU_SOA_SIMD
+#elif defined(__arm64__) || defined(__aarch64__)
+#    include <arm_neon.h>
+#    define AX_PU_SOA_SIMD
+#endif
+
+NS_AX_BEGIN
+
+#ifdef AX_PU_SOA_SIMD
+namespace
+{
+// four lanes, the kernels below are written once against these
+#    if defined(__SSE__)
+typedef __m128 float4;
+typedef __m128 mask4;
+
+inline float4 load4(const float* p)
+{
+    return _mm_loadu_ps(p);
+}
+inline void store4(float* p, float4 v)
+{
+    _mm_storeu_ps(p, v);
+}
+inline float4 splat4(float v)
+{
+    return _mm_set1_ps(v);
+}
+inline float4 add4(float4 a, float4 b)
+{
+    return _mm_add_ps(a, b);
+}
+inline float4 sub4(float4 a, float4 b)
+{
+    return _mm_sub_ps(a, b);
+}
+inline float4 mul4(float4 a, float4 b)
+{
+    return _mm_mul_ps(a, b);
+}
+inline float4 div4(float4 a, float4 b)
+{
+    return _mm_div_ps(a, b);
+}
+inline mask4 loadMask4(const uint32_t* p)
+{
+    return _mm_loadu_ps(reinterpret_cast<const float*>(p));
+}
+inline mask4 greater4(float4 a, float4 b)
+{
+    return _mm_cmpgt_ps(a, b);
+}
+// mask ? a : b
+inline float4 select4(mask4 mask, float4 a, float4 b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+#    else
+typedef float32x4_t float4;
+typedef uint32x4_t mask4;
+
+inline float4 load4(const float* p)
+{
+    return vld1q_f32(p);
+}
+inline void store4(float* p, float4 v)
+{
+    vst1q_f32(p, v);
+}
+inline float4 splat4(float v)
+{
+    return vdupq_n_f32(v);
+}
+inline float4 add4(float4 a, float4 b)
+{
+    return vaddq_f32(a, b);
+}
+inline float4 sub4(float4 a, float4 b)
+{
+    return vsubq_f32(a, b);
+}
+inline float4 mul4(float4 a, float4 b)
+{
+    return vmulq_f32(a, b);
+}
+inline float4 div4(float4 a, float4 b)
+{
+    return vdivq_f32(a, b);
+}
+inline mask4 loadMask4(const uint32_t* p)
+{
+    return vld1q_u32(p);
+}
+inline mask4 greater4(float4 a, float4 b)
+{
+    return vcgtq_f32(a, b);
+}
+// mask ? a : b
+inline float4 select4(mask4 mask, float4 a, float4 b)
+{
+    return vbslq_f32(mask, a, b);
+}
+#    endif
+}  // namespace
+#endif
+
+void PUParticleSoA::reset(PUParticle3D* const* particles, size_t count)
+{
+    _particles = particles;
+    _count     = count;
+    _fetched   = 0;
+    _modified  = 0;
+}
+
+void PUParticleSoA::fetch(unsigned int fields)
+{
+    fields &= ~_fetched;
+    if (!fields)
+        return;
+    _fetched |= fields;
+
+    if (fields & FIELD_POSITION)
+    {
+        _positionX.resize(_count);
+        _positionY.resize(_count);
+        _positionZ.resize(_count);
+        for (size_t i = 0; i < _count; ++i)
+        {
+            const Vec3& position = _particles[i]->position;
+            _positionX[i]        = position.x;
+            _positionY[i]        = position.y;
+            _positionZ[i]        = position.z;
+        }
+    }
+    if (fields & FIELD_DIRECTION)
+    {
+        _directionX.resize(_count);
+        _directionY.resize(_count);
+        _directionZ.resize(_count);
+        for (size_t i = 0; i < _count; ++i)
+        {
+            const Vec3& direction = _particles[i]->direction;
+            _directionX[i]        = direction.x;
+            _directionY[i]        = direction.y;
+            _directionZ[i]        = direction.z;
+        }
+    }
+    if (fields & FIELD_MASS)
+    {
+        _mass.resize(_count);
+        for (size_t i = 0; i < _count; ++i)
+            _mass[i] = _particles[i]->mass;
+    }
+    if (fields & FIELD_ORIENTATION)
+    {
+        _orientationW.resize(_count);
+        _orientationX.resize(_count);
+        _orientationY.resize(_count);
+        _orientationZ.resize(_count);
+        for (size_t i = 0; i < _count; ++i)
+        {
+            const Quaternion& orientation = _particles[i]->orientation;
+            _orientationW[i]              = orientation.w;
+            _orientationX[i]              = orientation.x;
+            _orientationY[i]              = orientation.y;
+            _orientationZ[i]              = orientation.z;
+        }
+    }
+    if (fields & FIELD_FREEZED)
+    {
+        _freezed.resize(_count);
+        for (size_t i = 0; i < _count; ++i)
+            _freezed[i] = _particles[i]->isFreezed() ? ~0u : 0u;
+    }
+}
+
+void PUParticleSoA::modify(unsigned int fields)
+{
+    fetch(fields);
+    _modified |= fields;
+}
+
+void PUParticleSoA::flush()
+{
+    if (_modified & FIELD_POSITION)
+    {
+        for (size_t i = 0; i < _count; ++i)
+            _particles[i]->position.set(_positionX[i], _positionY[i], _positionZ[i]);
+    }
+    if (_modified & FIELD_DIRECTION)
+    {
+        for (size_t i = 0; i < _count; ++i)
+            _particles[i]->direction.set(_directionX[i], _directionY[i], _directionZ[i]);
+    }
+    if (_modified & FIELD_MASS)
+    {
+        for (size_t i = 0; i < _count; ++i)
+            _particles[i]->mass = _mass[i];
+    }
+    if (_modified & FIELD_ORIENTATION)
+    {
+        for (size_t i = 0; i < _count; ++i)
+            _particles[i]->orientation.set(_orientationX[i], _orientationY[i], _orientationZ[i], _orientationW[i]);
+    }
+    _modified = 0;
+}
+
+void PUParticleSoA::invalidate()
+{
+    _fetched  = 0;
+    _modified = 0;
+}
+
+void PUParticleSoA::addToDirection(const Vec3& force)
+{
+    modify(FIELD_DIRECTION);
+    float* dx = _directionX.data();
+    float* dy = _directionY.data();
+    float* dz = _directionZ.data();
+
+    size_t i = 0;
+#ifdef AX_PU_SOA_SIMD
+    const float4 fx = splat4(force.x);
+    const float4 fy = splat4(force.y);
+    const float4 fz = splat4(force.z);
+    for (; i + 4 <= _count; i += 4)
+    {
+        store4(dx + i, add4(load4(dx + i), fx));
+        store4(dy + i, add4(load4(dy + i), fy));
+        store4(dz + i, add4(load4(dz + i), fz));
+    }
+#endif
+    for (; i < _count; ++i)
+    {
+        dx[i] += force.x;
+        dy[i] += force.y;
+        dz[i] += force.z;
+    }
+}
+
+void PUParticleSoA::averageDirection(const Vec3& force)
+{
+    modify(FIELD_DIRECTION);
+    float* dx = _directionX.data();
+    float* dy = _directionY.data();
+    float* dz = _directionZ.data();
+
+    size_t i = 0;
+#ifdef AX_PU_SOA_SIMD
+    const float4 fx   = splat4(force.x);
+    const float4 fy   = splat4(force.y);
+    const float4 fz   = splat4(force.z);
+    const float4 half = splat4(0.5f);
+    for (; i + 4 <= _count; i += 4)
+    {
+        store4(dx + i, mul4(add4(load4(dx + i), fx), half));
+        store4(dy + i, mul4(add4(load4(dy + i), fy), half));
+        store4(dz + i, mul4(add4(load4(dz + i), fz), half));
+    }
+#endif
+    for (; i < _count; ++i)
+    {
+        dx[i] = (dx[i] + force.x) * 0.5f;
+        dy[i] = (dy[i] + force.y) * 0.5f;
+        dz[i] = (dz[i] + force.z) * 0.5f;
+    }
+}
+
+void PUParticleSoA::attract(const Vec3& center, float strength)
+{
+    fetch(FIELD_POSITION | FIELD_MASS);
+    modify(FIELD_DIRECTION);
+    const float* px   = _positionX.data();
+    const float* py   = _positionY.data();
+    const float* pz   = _positionZ.data();
+    const float* mass = _mass.data();
+    float* dx         = _directionX.data();
+    float* dy         = _directionY.data();
+    float* dz         = _directionZ.data();
+
+    size_t i = 0;
+#ifdef AX_PU_SOA_SIMD
+    const float4 cx   = splat4(center.x);
+    const float4 cy   = splat4(center.y);
+    const float4 cz   = splat4(center.z);
+    const float4 s    = splat4(strength);
+    const float4 zero = splat4(0.0f);
+    const float4 one  = splat4(1.0f);
+    for (; i + 4 <= _count; i += 4)
+    {
+        float4 x  = sub4(cx, load4(px + i));
+        float4 y  = sub4(cy, load4(py + i));
+        float4 z  = sub4(cz, load4(pz + i));
+        float4 l2 = add4(add4(mul4(x, x), mul4(y, y)), mul4(z, z));
+        // the particles at the center are not affected, divide them by one and drop the result
+        mask4 affected = greater4(l2, zero);
+        float4 force   = div4(mul4(s, load4(mass + i)), select4(affected, l2, one));
+        force          = select4(affected, force, zero);
+        store4(dx + i, add4(load4(dx + i), mul4(force, x)));
+        store4(dy + i, add4(load4(dy + i), mul4(force, y)));
+        store4(dz + i, add4(load4(dz + i), mul4(force, z)));
+    }
+#endif
+    for (; i < _count; ++i)
+    {
+        float x  = center.x - px[i];
+        float y  = center.y - py[i];
+        float z  = center.z - pz[i];
+        float l2 = x * x + y * y + z * z;
+        if (l2 > 0)
+        {
+            float force = strength * mass[i] / l2;
+            dx[i] += force * x;
+            dy[i] += force * y;
+            dz[i] += force * z;
+        }
+    }
+}
+
+void PUParticleSoA::rotate(const Vec3& center, const Mat4& rotation, const Quaternion& orientationRotation)
+{
+    fetch(FIELD_FREEZED);
+    modify(FIELD_POSITION | FIELD_DIRECTION | FIELD_ORIENTATION);
+    const uint32_t* freezed = _freezed.data();
+    float* px               = _positionX.data();
+    float* py               = _positionY.data();
+    float* pz               = _positionZ.data();
+    float* dx               = _directionX.data();
+    float* dy               = _directionY.data();
+    float* dz               = _directionZ.data();
+    float* ow               = _orientationW.data();
+    float* ox               = _orientationX.data();
+    float* oy               = _orientationY.data();
+    float* oz               = _orientationZ.data();
+    // the rotation has no translation, only the upper 3x3 of the column major matrix is used
+    const float* m      = rotation.m;
+    const Quaternion& r = orientationRotation;
+
+    size_t i = 0;
+#ifdef AX_PU_SOA_SIMD
+    const float4 cx  = splat4(center.x);
+    const float4 cy  = splat4(center.y);
+    const float4 cz  = splat4(center.z);
+    const float4 m0  = splat4(m[0]);
+    const float4 m1  = splat4(m[1]);
+    const float4 m2  = splat4(m[2]);
+    const float4 m4  = splat4(m[4]);
+    const float4 m5  = splat4(m[5]);
+    const float4 m6  = splat4(m[6]);
+    const float4 m8  = splat4(m[8]);
+    const float4 m9  = splat4(m[9]);
+    const float4 m10 = splat4(m[10]);
+    const float4 rw  = splat4(r.w);
+    const float4 rx  = splat4(r.x);
+    const float4 ry  = splat4(r.y);
+    const float4 rz  = splat4(r.z);
+    for (; i + 4 <= _count; i += 4)
+    {
+        mask4 skip = loadMask4(freezed + i);
+
+        float4 x  = load4(px + i);
+        float4 y  = load4(py + i);
+        float4 z  = load4(pz + i);
+        float4 lx = sub4(x, cx);
+        float4 ly = sub4(y, cy);
+        float4 lz = sub4(z, cz);
+        store4(px + i, select4(skip, x, add4(cx, add4(add4(mul4(m0, lx), mul4(m4, ly)), mul4(m8, lz)))));
+        store4(py + i, select4(skip, y, add4(cy, add4(add4(mul4(m1, lx), mul4(m5, ly)), mul4(m9, lz)))));
+        store4(pz + i, select4(skip, z, add4(cz, add4(add4(mul4(m2, lx), mul4(m6, ly)), mul4(m10, lz)))));
+
+        x = load4(dx + i);
+        y = load4(dy + i);
+        z = load4(dz + i);
+        store4(dx + i, select4(skip, x, add4(add4(mul4(m0, x), mul4(m4, y)), mul4(m8, z))));
+        store4(dy + i, select4(skip, y, add4(add4(mul4(m1, x), mul4(m5, y)), mul4(m9, z))));
+        store4(dz + i, select4(skip, z, add4(add4(mul4(m2, x), mul4(m6, y)), mul4(m10, z))));
+
+        // orientation = r * orientation
+        float4 qw = load4(ow + i);
+        float4 qx = load4(ox + i);
+        float4 qy = load4(oy + i);
+        float4 qz = load4(oz + i);
+        float4 nx = sub4(add4(add4(mul4(rw, qx), mul4(rx, qw)), mul4(ry, qz)), mul4(rz, qy));
+        float4 ny = add4(add4(sub4(mul4(rw, qy), mul4(rx, qz)), mul4(ry, qw)), mul4(rz, qx));
+        float4 nz = add4(sub4(add4(mul4(rw, qz), mul4(rx, qy)), mul4(ry, qx)), mul4(rz, qw));
+        float4 nw = sub4(sub4(sub4(mul4(rw, qw), mul4(rx, qx)), mul4(ry, qy)), mul4(rz, qz));
+        store4(ow + i, select4(skip, qw, nw));
+        store4(ox + i, select4(skip, qx, nx));
+        store4(oy + i, select4(skip, qy, ny));
+        store4(oz + i, select4(skip, qz, nz));
+    }
+#endif
+    for (; i < _count; ++i)
+    {
+        if (freezed[i])
+            continue;
+
+        float lx = px[i] - center.x;
+        float ly = py[i] - center.y;
+        float lz = pz[i] - center.z;
+        px[i]    = center.x + (m[0] * lx + m[4] * ly + m[8] * lz);
+        py[i]    = center.y + (m[1] * lx + m[5] * ly + m[9] * lz);
+        pz[i]    = center.z + (m[2] * lx + m[6] * ly + m[10] * lz);
+
+        float x = dx[i];
+        float y = dy[i];
+        float z = dz[i];
+        dx[i]   = m[0] * x + m[4] * y + m[8] * z;
+        dy[i]   = m[1] * x + m[5] * y + m[9] * z;
+        dz[i]   = m[2] * x + m[6] * y + m[10] * z;
+
+        float qw = ow[i];
+        float qx = ox[i];
+        float qy = oy[i];
+        float qz = oz[i];
+        ox[i]    = r.w * qx + r.x * qw + r.y * qz - r.z * qy;
+        oy[i]    = r.w * qy - r.x * qz + r.y * qw + r.z * qx;
+        oz[i]    = r.w * qz + r.x * qy - r.y * qx + r.z * qw;
+        ow[i]    = r.w * qw - r.x * qx - r.y * qy - r.z * qz;
+    }
+}
+
+NS_AX_END
@@ -0,0 +1,98 @@
+/****************************************************************************
+ Copyright (c) 2022 Bytedance Inc.
+
+ https://axmolengine.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef __AX_PU_PARTICLE_3D_SOA_H__
+#define __AX_PU_PARTICLE_3D_SOA_H__
+
+#include "math/Math.h"
+#include "extensions/ExtensionExport.h"
+#include <vector>
+#include <stdint.h>
+
+NS_AX_BEGIN
+
+struct PUParticle3D;
+
+/**
+ * Structure of arrays store of the live particles of a system, one contiguous array per component.
+ *
+ * The particle system fills it with the live particles before the affectors run and writes it back once they are
+ * done, the span affectors read and write the arrays with the kernels below, which process four particles per
+ * instruction with SSE or NEON. A field is only gathered when a kernel first needs it and only written back when a
+ * kernel changed it, the particle objects stay the storage of record for everything else.
+ */
+class AX_EX_DLL PUParticleSoA
+{
+public:
+    enum Field
+    {
+        FIELD_POSITION    = 1 << 0,
+        FIELD_DIRECTION   = 1 << 1,
+        FIELD_MASS        = 1 << 2,
+        FIELD_ORIENTATION = 1 << 3,
+        FIELD_FREEZED     = 1 << 4,
+    };
+
+    /** Uses the count particles, nothing is gathered until a kernel needs it. */
+    void reset(PUParticle3D* const* particles, size_t count);
+
+    PUParticle3D* const* getParticles() const { return _particles; }
+    size_t size() const { return _count; }
+
+    /** Writes the modified fields back to the particles, they stay valid in the store. */
+    void flush();
+    /** Drops the gathered fields, after the particles were changed without the store. */
+    void invalidate();
+
+    /** direction += force */
+    void addToDirection(const Vec3& force);
+    /** direction = (direction + force) / 2 */
+    void averageDirection(const Vec3& force);
+    /** direction += strength * mass * distance / |distance|^2, distance = center - position, skipping the particles at
+        the center */
+    void attract(const Vec3& center, float strength);
+    /** Rotates position around center and direction by rotation, and orientation by orientationRotation, skipping the
+        freezed particles. */
+    void rotate(const Vec3& center, const Mat4& rotation, const Quaternion& orientationRotation);
+
+protected:
+    void fetch(unsigned int fields);
+    void modify(unsigned int fields);
+
+    PUParticle3D* const* _particles = nullptr;
+    size_t _count                   = 0;
+    unsigned int _fetched           = 0;
+    unsigned int _modified          = 0;
+
+    std::vector<float> _positionX, _positionY, _positionZ;
+    std::vector<float> _directionX, _directionY, _directionZ;
+    std::vector<float> _mass;
+    std::vector<float> _orientationW, _orientationX, _orientationY, _orientationZ;
+    // all bits set for the freezed particles, a lane mask for the kernels
+    std::vector<uint32_t> _freezed;
+};
+
+NS_AX_END
+
+#endif
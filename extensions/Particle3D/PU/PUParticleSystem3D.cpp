@@ -547,40 +547,45 @@ void PUParticleSystem3D::prepared()
                 if (emitter->getEmitsType() == PUParticle3D::PT_EMITTER)
                 {
                     PUEmitter* emitted = static_cast<PUEmitter*>(emitter->getEmitsEntityPtr());
+                    auto particles     = std::make_unique<PUParticle3D[]>(_emittedEmitterQuota);
                     for (unsigned int i = 0; i < _emittedEmitterQuota; ++i)
                     {
-                        auto p               = new PUParticle3D();
+                        auto p               = &particles[i];
                         p->particleType      = PUParticle3D::PT_EMITTER;
                         p->particleEntityPtr = emitted->clone();
                         p->particleEntityPtr->retain();
                         p->copyBehaviours(_behaviourTemplates);
-                        _emittedEmitterParticlePool[emitted->getName()].addData(p);
                     }
+                    _emittedEmitterParticlePool[emitted->getName()].addDatas(std::move(particles),
+                                                                             _emittedEmitterQuota);
                 }
                 else if (emitter->getEmitsType() == PUParticle3D::PT_TECHNIQUE)
                 {
                     PUParticleSystem3D* emitted = static_cast<PUParticleSystem3D*>(emitter->getEmitsEntityPtr());
+                    auto particles              = std::make_unique<PUParticle3D[]>(_emittedSystemQuota);
                     for (unsigned int i = 0; i < _emittedSystemQuota; ++i)
                     {
                         PUParticleSystem3D* clonePS = emitted->clone();
-                        auto p                      = new PUParticle3D();
+                        auto p                      = &particles[i];
                         p->particleType             = PUParticle3D::PT_TECHNIQUE;
                         p->particleEntityPtr        = clonePS;
                         p->particleEntityPtr->retain();
                         p->copyBehaviours(_behaviourTemplates);
-                        _emittedSystemParticlePool[emitted->getName()].addData(p);
                         clonePS->prepared();
                     }
+                    _emittedSystemParticlePool[emitted->getName()].addDatas(std::move(particles),
+                                                                            _emittedSystemQuota);
                     // emitted->stopParticle();
                 }
             }
 
+            // one contiguous block, the particles are walked in memory order every frame
+            auto particles = std::make_unique<PUParticle3D[]>(_particleQuota);
             for (unsigned int i = 0; i < _particleQuota; ++i)
             {
-                auto p = new PUParticle3D();
-                p->copyBehaviours(_behaviourTemplates);
-                _particlePool.addData(p);
+                particles[i].copyBehaviours(_behaviourTemplates);
             }
+            _particlePool.addDatas(std::move(particles), _particleQuota);
             _poolPrepared = true;
         }
 
@@ -1313,11 +1318,107 @@ void PUParticleSystem3D::draw(Renderer* renderer, const Mat4& transform, uint32_
     }
 }
 
+bool PUParticleSystem3D::canProcessInSpans() const
+{
+    // observers may enable or disable affectors between two particles
+    if (!_observers.empty())
+        return false;
+
+    for (auto&& it : _affectors)
+    {
+        if (it->isEnabled() && !static_cast<PUAffector*>(it)->isSpanProcessingSupported())
+            return false;
+    }
+    return true;
+}
+
+void PUParticleSystem3D::processParticleSpans(ParticlePool& pool,
+                                              bool& firstActiveParticle,
+                                              bool& firstParticle,
+                                              float elapsedTime)
+{
+    auto endParticleUpdate = [elapsedTime](PUParticle3D* particle) {
+        if (particle->hasEventFlags(PUParticle3D::PEF_EXPIRED))
+        {
+            particle->setEventFlags(0);
+            particle->addEventFlags(PUParticle3D::PEF_EXPIRED);
+        }
+        else
+        {
+            particle->setEventFlags(0);
+        }
+        particle->timeToLive -= elapsedTime;
+    };
+
+    // expire particles and run their behaviours and the emitters, collecting the live ones
+    _spanParticles.clear();
+    PUParticle3D* particle = static_cast<PUParticle3D*>(pool.getFirst());
+    while (particle)
+    {
+        if (!isExpired(particle, elapsedTime))
+        {
+            particle->process(elapsedTime);
+
+            for (auto&& it : _emitters)
+            {
+                if (it->isEnabled() && !it->isMarkedForEmission())
+                {
+                    (static_cast<PUEmitter*>(it))->updateEmitter(particle, elapsedTime);
+                }
+            }
+            _spanParticles.emplace_back(particle);
+        }
+        else
+        {
+            initParticleForExpiration(particle, elapsedTime);
+            pool.lockLatestData();
+            endParticleUpdate(particle);
+        }
+
+        firstParticle = false;
+        particle      = static_cast<PUParticle3D*>(pool.getNext());
+    }
+
+    // each affector over all the live particles, in the structure of arrays store until they are all done
+    auto particles   = _spanParticles.data();
+    const auto count = _spanParticles.size();
+    _spanStore.reset(particles, count);
+    for (auto&& it : _affectors)
+    {
+        if (it->isEnabled())
+        {
+            (static_cast<PUAffector*>(it))->processSpan(_spanStore, elapsedTime, firstActiveParticle);
+        }
+    }
+    _spanStore.flush();
+
+    Vec3 scale = getDerivedScale();
+    for (size_t i = 0; i < count; ++i)
+    {
+        particle = particles[i];
+        if (_render)
+            static_cast<PURender*>(_render)->updateRender(particle, elapsedTime, firstActiveParticle);
+
+        firstActiveParticle      = false;
+        particle->latestPosition = particle->position;
+        processMotion(particle, elapsedTime, scale, firstActiveParticle);
+        endParticleUpdate(particle);
+    }
+}
+
 void PUParticleSystem3D::processParticle(ParticlePool& pool,
                                          bool& firstActiveParticle,
                                          bool& firstParticle,
                                          float elapsedTime)
 {
+    // the own pool only holds visual particles, when every affector works on its own particles they run over
+    // all the particles at once, instead of interleaving the virtual calls per particle
+    if (&pool == &_particlePool && canProcessInSpans())
+    {
+        processParticleSpans(pool, firstActiveParticle, firstParticle, elapsedTime);
+        return;
+    }
+
     Vec3 scale             = getDerivedScale();
     PUParticle3D* particle = static_cast<PUParticle3D*>(pool.getFirst());
     // Mat4 ltow = getNodeToWorldTransform();
@@ -1540,13 +1641,12 @@ int PUParticleSystem3D::getAliveParticleCount() const
 
     for (auto&& iter : _emittedSystemParticlePool)
     {
-        auto pool = iter.second;
-        sz += pool.getActiveDataList().size();
-        PUParticle3D* particle = static_cast<PUParticle3D*>(pool.getFirst());
-        while (particle)
+        auto& activeList = iter.second.getActiveDataList();
+        sz += activeList.size();
+        for (auto&& particle : activeList)
         {
-            sz += static_cast<PUParticleSystem3D*>(particle->particleEntityPtr)->getAliveParticleCount();
-            particle = static_cast<PUParticle3D*>(pool.getNext());
+            sz += static_cast<PUParticleSystem3D*>(static_cast<PUParticle3D*>(particle)->particleEntityPtr)
+                      ->getAliveParticleCount();
         }
     }
     return sz;
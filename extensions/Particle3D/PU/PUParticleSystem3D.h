@@ -31,6 +31,7 @@
 #include "base/Protocols.h"
 #include "math/Math.h"
 #include "extensions/Particle3D/ParticleSystem3D.h"
+#include "extensions/Particle3D/PU/PUParticleSoA.h"
 #include <vector>
 #include <map>
 
@@ -364,6 +365,9 @@ protected:
     void executeEmitParticles(PUEmitter* emitter, unsigned requested, float elapsedTime);
     void emitParticles(ParticlePool& pool, PUEmitter* emitter, unsigned requested, float elapsedTime);
     void processParticle(ParticlePool& pool, bool& firstActiveParticle, bool& firstParticle, float elapsedTime);
+    // the live particles go through the affectors together, those with a kernel of PUParticleSoA work on its arrays
+    bool canProcessInSpans() const;
+    void processParticleSpans(ParticlePool& pool, bool& firstActiveParticle, bool& firstParticle, float elapsedTime);
     void processMotion(PUParticle3D* particle, float timeElapsed, const Vec3& scl, bool firstParticle);
     void notifyRescaled(const Vec3& scl);
     void initParticleForEmission(PUParticle3D* particle);
@@ -417,6 +421,10 @@ protected:
     Quaternion _latestOrientation;
 
     PUParticleSystem3D* _parentParticleSystem;
+
+    // live particles of the frame, when the affectors process whole spans
+    std::vector<PUParticle3D*> _spanParticles;
+    PUParticleSoA _spanStore;
 };
 
 NS_AX_END
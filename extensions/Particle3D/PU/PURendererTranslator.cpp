@@ -29,7 +29,7 @@
 #include "extensions/Particle3D/PU/PUMaterialManager.h"
 
 NS_AX_BEGIN
-PURendererTranslator::PURendererTranslator() {}
+PURendererTranslator::PURendererTranslator() : _renderer(nullptr), _detached(false) {}
 
 PURendererTranslator::~PURendererTranslator() {}
 
@@ -38,6 +38,13 @@ void PURendererTranslator::translate(PUScriptCompiler* compiler, PUAbstractNode*
     PUObjectAbstractNode* obj    = reinterpret_cast<PUObjectAbstractNode*>(node);
     PUObjectAbstractNode* parent = obj->parent ? reinterpret_cast<PUObjectAbstractNode*>(obj->parent) : 0;
 
+    _renderer = nullptr;
+    if (_detached)
+    {
+        obj->context = nullptr;
+        return;
+    }
+
     // The name of the obj is the type of the Renderer
     // Remark: This can be solved by using a listener, so that obj->values is filled with type + name. Something for
     // later
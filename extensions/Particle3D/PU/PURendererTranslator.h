@@ -39,11 +39,16 @@ class PURendererTranslator : public PUScriptTranslator
 {
 protected:
     Particle3DRender* _renderer;
+    bool _detached;
 
 public:
     PURendererTranslator();
     virtual ~PURendererTranslator();
     virtual void translate(PUScriptCompiler* compiler, PUAbstractNode* node);
+
+    /** Skips the renderers, which create textures, buffers and programs. */
+    void setDetached(bool detached) { _detached = detached; }
+    bool isDetached() const { return _detached; }
 };
 
 NS_AX_END
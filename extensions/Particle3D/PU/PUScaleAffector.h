@@ -45,6 +45,7 @@ public:
     static PUScaleAffector* create();
 
     virtual void updatePUAffector(PUParticle3D* particle, float deltaTime) override;
+    virtual bool isSpanProcessingSupported() const override { return true; }
 
     /**
      */
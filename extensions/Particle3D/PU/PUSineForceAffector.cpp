@@ -103,6 +103,18 @@ void PUSineForceAffector::updatePUAffector(PUParticle3D* particle, float /*delta
     }
 }
 
+void PUSineForceAffector::updatePUAffectors(PUParticleSoA& particles, float /*deltaTime*/)
+{
+    if (_forceApplication == FA_ADD)
+    {
+        particles.addToDirection(_scaledVector);
+    }
+    else
+    {
+        particles.averageDirection(_forceVector);
+    }
+}
+
 PUSineForceAffector* PUSineForceAffector::create()
 {
     auto psfa = new PUSineForceAffector();
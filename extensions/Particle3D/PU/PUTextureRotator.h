@@ -44,6 +44,7 @@ public:
     static PUTextureRotator* create();
 
     virtual void updatePUAffector(PUParticle3D* particle, float deltaTime) override;
+    virtual bool isSpanProcessingSupported() const override { return true; }
 
     /** Returns an indication whether the 2D rotation speed is the same for all particles in this
         particle technique, or whether the 2D rotation speed of the particle itself is used.
@@ -40,7 +40,7 @@
 
 NS_AX_BEGIN
 class PUMaterialCache;
-class PUTranslateManager
+class AX_EX_DLL PUTranslateManager
 {
 private:
     PUParticleSystem3DTranslator _systemTranslator;
@@ -73,6 +73,12 @@ public:
     void translateMaterialSystem(PUMaterialCache* ms, const PUAbstractNodeList* alist);
     virtual PUScriptTranslator* getTranslator(PUAbstractNode* node);
 
+    /** Whether the systems translated from now on are created without their renderer, so that the scripts load
+        without a graphics context, to run the simulation alone. False by default.
+     */
+    void setRenderersDetached(bool detached) { _rendererTranslator.setDetached(detached); }
+    bool isRenderersDetached() const { return _rendererTranslator.isDetached(); }
+
     PUTranslateManager();
     virtual ~PUTranslateManager();
 };
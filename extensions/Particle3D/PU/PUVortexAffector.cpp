@@ -98,6 +98,14 @@ void PUVortexAffector::updatePUAffector(PUParticle3D* particle, float /*deltaTim
     }
 }
 
+void PUVortexAffector::updatePUAffectors(PUParticleSoA& particles, float /*deltaTime*/)
+{
+    // the rotation is the same for all the particles
+    Mat4 rotMat;
+    Mat4::createRotation(_rotation, &rotMat);
+    particles.rotate(_derivedPosition, rotMat, _rotation);
+}
+
 void PUVortexAffector::preUpdateAffector(float deltaTime)
 {
     PUParticleSystem3D* sys = static_cast<PUParticleSystem3D*>(_particleSystem);
@@ -44,6 +44,8 @@ public:
 
     virtual void preUpdateAffector(float deltaTime) override;
     virtual void updatePUAffector(PUParticle3D* particle, float deltaTime) override;
+    virtual bool isSpanProcessingSupported() const override { return true; }
+    virtual void updatePUAffectors(PUParticleSoA& particles, float deltaTime) override;
     /**
      */
     const Vec3& getRotationVector() const;
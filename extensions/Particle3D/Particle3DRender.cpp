@@ -98,7 +98,7 @@ void Particle3DQuadRender::render(Renderer* renderer, const Mat4& transform, Par
             return;
         }
     }
-    ParticlePool::PoolList activeParticleList = particlePool.getActiveDataList();
+    const ParticlePool::PoolList& activeParticleList = particlePool.getActiveDataList();
     if (_posuvcolors.size() < activeParticleList.size() * 4)
     {
         _posuvcolors.resize(activeParticleList.size() * 4);
@@ -304,8 +304,8 @@ void Particle3DModelRender::render(Renderer* renderer, const Mat4& transform, Pa
         }
     }
 
-    const ParticlePool& particlePool          = particleSystem->getParticlePool();
-    ParticlePool::PoolList activeParticleList = particlePool.getActiveDataList();
+    const ParticlePool& particlePool                 = particleSystem->getParticlePool();
+    const ParticlePool::PoolList& activeParticleList = particlePool.getActiveDataList();
     Mat4 mat;
     Mat4 rotMat;
     Mat4 sclMat;
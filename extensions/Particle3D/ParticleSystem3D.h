@@ -31,6 +31,8 @@
 #include <vector>
 #include <map>
 #include <list>
+#include <memory>
+#include <algorithm>
 #include "ExtensionExport.h"
 
 NS_AX_BEGIN
@@ -60,12 +62,17 @@ struct AX_EX_DLL Particle3D
     std::unordered_map<std::string, void*> userDefs;
 };
 
+/**
+ * Pool of datas kept in two contiguous arrays, the active (released) datas and the inactive (locked) ones.
+ * The active datas keep their creation order, which is the draw order of the renders that don't sort. Datas locked
+ * while iterating with getFirst() and getNext() are removed in the same pass, by moving the following datas down.
+ */
 template <typename T>
 class AX_EX_DLL DataPool
 {
 public:
-    typedef typename std::list<T*> PoolList;
-    typedef typename std::list<T*>::iterator PoolIterator;
+    typedef typename std::vector<T*> PoolList;
+    typedef typename std::vector<T*>::iterator PoolIterator;
 
     DataPool(){};
     ~DataPool(){};
@@ -74,85 +81,127 @@ public:
     {
         if (_locked.empty())
             return nullptr;
-        T* p = _locked.front();
-        //_released.emplace_back(p);
-        //_locked.erase(_locked.begin());
-        _released.splice(_released.end(), _locked, _locked.begin());
+        T* p = _locked.back();
+        _locked.pop_back();
+        _released.emplace_back(p);
         return p;
     }
 
+    /** Locks the data returned by the last getFirst() or getNext() call. */
     void lockLatestData()
     {
-        _locked.emplace_back(*_releasedIter);
-        _releasedIter = _released.erase(_releasedIter);
-        if (_releasedIter != _released.begin() && _releasedIter != _released.end())
-        {
-            --_releasedIter;
-        }
+        if (_releasedIndex < 0 || _releasedIndex >= static_cast<ptrdiff_t>(_released.size()))
+            return;
+        _locked.emplace_back(_released[_releasedIndex]);
+        // the slot is filled by the following datas as getNext() moves them down
+        ++_lockedInIteration;
     }
 
+    /** Locks a data, the remaining active datas keep their order. */
     void lockData(T* data)
     {
-        PoolIterator tempIter = _releasedIter;
-        T* ptr                = getFirst();
-        while (ptr)
-        {
-            if (ptr == data)
-                break;
-            ptr = getNext();
-        }
-        if (ptr)
-            lockLatestData();
-        _releasedIter = tempIter;
+        compact();
+        auto iter = std::find(_released.begin(), _released.end(), data);
+        if (iter == _released.end())
+            return;
+        if (iter - _released.begin() <= _releasedIndex)
+            --_releasedIndex;
+        _locked.emplace_back(data);
+        _released.erase(iter);
     }
 
     void lockAllDatas()
     {
-        _locked.splice(_locked.end(), _released);
-        //_locked.insert(_locked.end(), _released.begin(), _released.end());
-        //_released.clear();
-        _releasedIter = _released.begin();
+        compact();
+        _locked.insert(_locked.end(), _released.begin(), _released.end());
+        _released.clear();
+        _releasedIndex = 0;
     }
 
     T* getFirst()
     {
-        _releasedIter = _released.begin();
-        if (_releasedIter == _released.end())
+        compact();
+        _releasedIndex = 0;
+        if (_released.empty())
             return nullptr;
-        return *_releasedIter;
+        return _released.front();
     }
 
     T* getNext()
     {
-        if (_releasedIter == _released.end())
+        if (_releasedIndex >= static_cast<ptrdiff_t>(_released.size()))
             return nullptr;
-        ++_releasedIter;
-        if (_releasedIter == _released.end())
+        ++_releasedIndex;
+        if (_releasedIndex >= static_cast<ptrdiff_t>(_released.size()))
+        {
+            compact();
             return nullptr;
-        return *_releasedIter;
+        }
+        if (_lockedInIteration)
+            _released[_releasedIndex - _lockedInIteration] = _released[_releasedIndex];
+        return _released[_releasedIndex];
     }
 
-    const PoolList& getActiveDataList() const { return _released; };
+    const PoolList& getActiveDataList() const
+    {
+        compact();
+        return _released;
+    };
     const PoolList& getUnActiveDataList() const { return _locked; };
 
-    void addData(T* data) { _locked.emplace_back(data); }
+    /** Adds a data, deleted by removeAllDatas(). */
+    void addData(T* data)
+    {
+        _locked.emplace_back(data);
+        _ownedDatas.emplace_back(data);
+    }
+
+    /** Adds count datas allocated in one contiguous block, which the pool keeps alive until removeAllDatas(). */
+    template <typename U>
+    void addDatas(std::unique_ptr<U[]> block, size_t count)
+    {
+        _locked.reserve(_locked.size() + count);
+        for (size_t i = 0; i < count; ++i)
+            _locked.emplace_back(&block[i]);
+        _blocks.emplace_back(std::shared_ptr<U[]>(std::move(block)));
+    }
 
-    bool empty() const { return _released.empty(); };
+    bool empty() const
+    {
+        compact();
+        return _released.empty();
+    };
 
     void removeAllDatas()
     {
         lockAllDatas();
-        for (auto&& iter : _locked)
+        for (auto&& iter : _ownedDatas)
         {
             delete iter;
         }
+        _ownedDatas.clear();
+        _blocks.clear();
         _locked.clear();
     }
 
 private:
-    PoolIterator _releasedIter;
-    PoolList _released;
+    /** Removes the slots of the datas locked in the current iteration, so far. */
+    void compact() const
+    {
+        if (!_lockedInIteration)
+            return;
+        auto end = std::min(_releasedIndex + 1, static_cast<ptrdiff_t>(_released.size()));
+        _released.erase(_released.begin() + (end - _lockedInIteration), _released.begin() + end);
+        _releasedIndex -= _lockedInIteration;
+        _lockedInIteration = 0;
+    }
+
+    mutable ptrdiff_t _releasedIndex     = 0;
+    mutable ptrdiff_t _lockedInIteration = 0;
+    mutable PoolList _released;
     PoolList _locked;
+    PoolList _ownedDatas;
+    std::vector<std::shared_ptr<void>> _blocks;
 };
 
 typedef DataPool<Particle3D> ParticlePool;
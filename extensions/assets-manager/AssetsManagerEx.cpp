@@ -28,6 +28,10 @@
 #include "base/Director.h"
 
 #include <stdio.h>
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <thread>
 
 #ifdef MINIZIP_FROM_SYSTEM
 #    include <minizip/unzip.h>
@@ -35,11 +39,12 @@
 #    include "unzip.h"
 #endif
 #include <ioapi.h>
-#include "base/AsyncTaskPool.h"
 
 NS_AX_EXT_BEGIN
 
 #define TEMP_FOLDERNAME "_temp"
+#define CHUNKS_FOLDERNAME "_chunks"
+#define CHUNK_ID_PREFIX "@chunk/"
 #define VERSION_FILENAME "version.manifest"
 #define TEMP_MANIFEST_FILENAME "project.manifest.temp"
 #define MANIFEST_FILENAME "project.manifest"
@@ -166,6 +171,81 @@ int AssetManagerEx_error_file_func(voidpf opaque, voidpf stream)
 }
 // End of Overrides
 
+class AssetsManagerEx::ProcessingPool
+{
+public:
+    explicit ProcessingPool(int numThreads)
+    {
+        for (int i = 0; i < numThreads; ++i)
+            _threads.emplace_back([this]() { run(); });
+    }
+
+    ~ProcessingPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _condition.notify_all();
+        for (auto& thread : _threads)
+            thread.join();
+    }
+
+    void enqueue(std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _tasks.push(std::move(task));
+        }
+        _condition.notify_one();
+    }
+
+private:
+    void run()
+    {
+        for (;;)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _condition.wait(lock, [this]() { return _stop || !_tasks.empty(); });
+                if (_stop)
+                    return;
+                task = std::move(_tasks.front());
+                _tasks.pop();
+            }
+            task();
+        }
+    }
+
+    std::vector<std::thread> _threads;
+    std::queue<std::function<void()>> _tasks;
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    bool _stop = false;
+};
+
+struct AssetsManagerEx::ChunkedUnit
+{
+    std::string customId;
+    std::string storagePath;
+    //! The installed version of the asset, empty if there is none
+    std::string basePath;
+    std::shared_ptr<ManifestChunks> chunks;
+    //! Offsets of the chunks found in the installed version
+    hlookup::string_map<size_t> baseOffsets;
+    //! Chunks which need to be downloaded
+    std::vector<std::string> missing;
+    double downloadSize = 0;
+    int pendingChunks   = 0;
+    bool failed         = false;
+};
+
+static bool isChunkId(std::string_view identifier)
+{
+    return cxx20::starts_with(identifier, std::string_view{CHUNK_ID_PREFIX});
+}
+
 // Implementation of AssetsManagerEx
 
 AssetsManagerEx::AssetsManagerEx(std::string_view manifestUrl, std::string_view storagePath) : _manifestUrl(manifestUrl)
@@ -176,6 +256,8 @@ AssetsManagerEx::AssetsManagerEx(std::string_view manifestUrl, std::string_view
     _eventName          = EventListenerAssetsManagerEx::LISTENER_ID + pointer;
     _fileUtils          = FileUtils::getInstance();
 
+    _maxProcessingThreads = std::clamp(static_cast<int>(std::thread::hardware_concurrency()), 1, 4);
+
     network::DownloaderHints hints = {static_cast<uint32_t>(_maxConcurrentTask), DEFAULT_CONNECTION_TIMEOUT, ".tmp"};
     _downloader                    = std::shared_ptr<network::Downloader>(new network::Downloader(hints));
     _downloader->onTaskError = std::bind(&AssetsManagerEx::onError, this, std::placeholders::_1, std::placeholders::_2,
@@ -200,6 +282,8 @@ AssetsManagerEx::~AssetsManagerEx()
     _downloader->onTaskError       = (nullptr);
     _downloader->onFileTaskSuccess = (nullptr);
     _downloader->onTaskProgress    = (nullptr);
+    // Every pending task retains this object, so the pool is idle here
+    _processingPool.reset();
     AX_SAFE_RELEASE(_localManifest);
     // _tempManifest could share a ptr with _remoteManifest or _localManifest
     if (_tempManifest != _localManifest && _tempManifest != _remoteManifest)
@@ -378,6 +462,10 @@ void AssetsManagerEx::setStoragePath(std::string_view storagePath)
     _tempStoragePath.append(TEMP_FOLDERNAME);
     adjustPath(_tempStoragePath);
     _fileUtils->createDirectory(_tempStoragePath);
+
+    _chunkStoragePath = _storagePath;
+    _chunkStoragePath.append(CHUNKS_FOLDERNAME);
+    adjustPath(_chunkStoragePath);
 }
 
 void AssetsManagerEx::adjustPath(std::string& path)
@@ -533,43 +621,44 @@ bool AssetsManagerEx::decompress(std::string_view zip)
 
 void AssetsManagerEx::decompressDownloadedZip(std::string_view customId, std::string_view storagePath)
 {
-    struct AsyncData
-    {
-        std::string customId;
-        std::string zipFile;
-        bool succeed;
-    };
-
-    AsyncData* asyncData = new AsyncData;
-    asyncData->customId  = customId;
-    asyncData->zipFile   = storagePath;
-    asyncData->succeed   = false;
+    auto succeed = std::make_shared<bool>(false);
+    runProcessingTask(
+        [this, zipFile = std::string{storagePath}, succeed]() {
+            // Decompress all compressed files
+            *succeed = decompress(zipFile);
+            _fileUtils->removeFile(zipFile);
+        },
+        [this, customId = std::string{customId}, zipFile = std::string{storagePath}, succeed]() {
+            if (*succeed)
+            {
+                fileSuccess(customId, zipFile);
+            }
+            else
+            {
+                std::string errorMsg = "Unable to decompress file " + zipFile;
+                // Ensure zip file deletion (if decompress failure cause task thread exit anormally)
+                _fileUtils->removeFile(zipFile);
+                dispatchUpdateEvent(EventAssetsManagerEx::EventCode::ERROR_DECOMPRESS, "", errorMsg);
+                fileError(customId, errorMsg);
+            }
+        });
+}
 
-    std::function<void(void*)> decompressFinished = [this](void* param) {
-        auto dataInner = reinterpret_cast<AsyncData*>(param);
-        if (dataInner->succeed)
-        {
-            fileSuccess(dataInner->customId, dataInner->zipFile);
-        }
-        else
-        {
-            std::string errorMsg = "Unable to decompress file " + dataInner->zipFile;
-            // Ensure zip file deletion (if decompress failure cause task thread exit anormally)
-            _fileUtils->removeFile(dataInner->zipFile);
-            dispatchUpdateEvent(EventAssetsManagerEx::EventCode::ERROR_DECOMPRESS, "", errorMsg);
-            fileError(dataInner->customId, errorMsg);
-        }
-        delete dataInner;
-    };
-    AsyncTaskPool::getInstance()->enqueue(AsyncTaskPool::TaskType::TASK_OTHER, std::move(decompressFinished),
-                                          (void*)asyncData, [this, asyncData]() {
-                                              // Decompress all compressed files
-                                              if (decompress(asyncData->zipFile))
-                                              {
-                                                  asyncData->succeed = true;
-                                              }
-                                              _fileUtils->removeFile(asyncData->zipFile);
-                                          });
+void AssetsManagerEx::runProcessingTask(std::function<void()> task, std::function<void()> finished)
+{
+    if (!_processingPool)
+        _processingPool = std::make_unique<ProcessingPool>(_maxProcessingThreads);
+
+    // Keep this object alive until the finished callback ran
+    retain();
+    auto scheduler = Director::getInstance()->getScheduler();
+    _processingPool->enqueue([this, scheduler, task = std::move(task), finished = std::move(finished)]() {
+        task();
+        scheduler->runOnAxmolThread([this, finished]() {
+            finished();
+            release();
+        });
+    });
 }
 
 void AssetsManagerEx::dispatchUpdateEvent(EventAssetsManagerEx::EventCode code,
@@ -860,6 +949,10 @@ void AssetsManagerEx::updateSucceed()
         // Remove temp storage path
         _fileUtils->removeDirectory(_tempStoragePath);
     }
+    if (_fileUtils->isDirectoryExist(_chunkStoragePath))
+    {
+        _fileUtils->removeDirectory(_chunkStoragePath);
+    }
     // 3. swap the localManifest
     AX_SAFE_RELEASE(_localManifest);
     _localManifest = _remoteManifest;
@@ -1105,6 +1198,10 @@ void AssetsManagerEx::onError(const network::DownloadTask& task,
                             errorCode, errorCodeInternal);
         _updateState = State::FAIL_TO_UPDATE;
     }
+    else if (isChunkId(task.identifier))
+    {
+        chunkFinished(task.identifier.substr(sizeof(CHUNK_ID_PREFIX) - 1), errorStr, errorCode, errorCodeInternal);
+    }
     else
     {
         fileError(task.identifier, errorStr, errorCode, errorCodeInternal);
@@ -1135,7 +1232,12 @@ void AssetsManagerEx::onProgress(double total, double downloaded, std::string_vi
             totalDownloaded += it->second;
         }
         // Collect information if not registed
-        if (!found)
+        if (!found && isChunkId(customId))
+        {
+            // Chunks are accounted in the size of the assets waiting for them
+            _downloadedSize.emplace(customId, downloaded);
+        }
+        else if (!found)
         {
             // Set download state to DOWNLOADING, this will run only once in the download process
             _tempManifest->setAssetDownloadState(customId, Manifest::DownloadState::DOWNLOADING);
@@ -1180,39 +1282,219 @@ void AssetsManagerEx::onSuccess(std::string_view /*srcUrl*/, std::string_view st
         _updateState = State::MANIFEST_LOADED;
         parseManifest();
     }
+    else if (isChunkId(customId))
+    {
+        // Verify the chunk on the processing threads while other data keeps arriving
+        auto hash     = std::string{customId.substr(sizeof(CHUNK_ID_PREFIX) - 1)};
+        auto verified = std::make_shared<bool>(false);
+        runProcessingTask(
+            [this, hash, path = std::string{storagePath}, verified]() {
+                Data data = _fileUtils->getDataFromFile(path);
+                *verified = !data.isNull() && ChunkIndex::hash(data.getBytes(), data.getSize()) == hash;
+                if (!*verified)
+                    _fileUtils->removeFile(path);
+            },
+            [this, hash, verified]() {
+                chunkFinished(hash, *verified ? "" : "Chunk verification failed after downloaded");
+            });
+    }
     else
     {
-        bool ok      = true;
-        auto& assets = _remoteManifest->getAssets();
-        auto assetIt = assets.find(customId);
-        if (assetIt != assets.end())
+        processDownloadedUnit(customId, storagePath);
+    }
+}
+
+void AssetsManagerEx::processDownloadedUnit(std::string_view customId, std::string_view storagePath)
+{
+    bool ok      = true;
+    auto& assets = _remoteManifest->getAssets();
+    auto assetIt = assets.find(customId);
+    if (assetIt != assets.end())
+    {
+        Manifest::Asset asset = assetIt->second;
+        if (_verifyCallback != nullptr)
         {
-            Manifest::Asset asset = assetIt->second;
-            if (_verifyCallback != nullptr)
-            {
-                ok = _verifyCallback(storagePath, asset);
-            }
+            ok = _verifyCallback(storagePath, asset);
         }
+    }
 
-        if (ok)
+    if (ok)
+    {
+        bool compressed = assetIt != assets.end() ? assetIt->second.compressed : false;
+        if (compressed)
+        {
+            decompressDownloadedZip(customId, storagePath);
+        }
+        else
         {
-            bool compressed = assetIt != assets.end() ? assetIt->second.compressed : false;
-            if (compressed)
+            fileSuccess(customId, storagePath);
+        }
+    }
+    else
+    {
+        fileError(customId, "Asset file verification failed after downloaded");
+    }
+}
+
+void AssetsManagerEx::downloadChunkedUnit(const DownloadUnit& unit, std::shared_ptr<ManifestChunks> chunks)
+{
+    auto chunked         = std::make_shared<ChunkedUnit>();
+    chunked->customId    = unit.customId;
+    chunked->storagePath = unit.storagePath;
+    chunked->chunks      = std::move(chunks);
+
+    // The installed version of the asset provides the chunks which didn't change
+    auto& localAssets = _localManifest->getAssets();
+    auto localIt      = localAssets.find(unit.customId);
+    if (localIt != localAssets.end() && !localIt->second.compressed)
+        chunked->basePath = _fileUtils->fullPathForFilename(localIt->second.path);
+    _fileUtils->createDirectory(_chunkStoragePath);
+
+    runProcessingTask(
+        [this, chunked]() {
+            if (!chunked->basePath.empty())
             {
-                decompressDownloadedZip(customId, storagePath);
+                Data base     = _fileUtils->getDataFromFile(chunked->basePath);
+                size_t offset = 0;
+                for (auto& chunk : ChunkIndex::split(base.getBytes(), base.getSize()))
+                {
+                    chunked->baseOffsets.emplace(chunk.hash, offset);
+                    offset += chunk.size;
+                }
             }
-            else
+
+            hlookup::string_set planned;
+            for (auto& chunk : *chunked->chunks)
+            {
+                if (chunked->baseOffsets.find(chunk.hash) != chunked->baseOffsets.end() ||
+                    !planned.emplace(chunk.hash).second)
+                    continue;
+                // Downloaded by an interrupted update, verified when the asset is assembled
+                if (_fileUtils->getFileSize(_chunkStoragePath + chunk.hash) == chunk.size)
+                    continue;
+                chunked->missing.emplace_back(chunk.hash);
+                chunked->downloadSize += chunk.size;
+            }
+        },
+        [this, chunked]() {
+            // Only the missing chunks count in the total size
+            auto unitIt = _downloadUnits.find(chunked->customId);
+            if (unitIt != _downloadUnits.end())
             {
-                fileSuccess(customId, storagePath);
+                if (unitIt->second.size > 0)
+                {
+                    _totalSize -= unitIt->second.size - chunked->downloadSize;
+                }
+                else
+                {
+                    _totalSize += chunked->downloadSize;
+                    _sizeCollected++;
+                    if (_sizeCollected == _totalToDownload)
+                    {
+                        _totalEnabled = true;
+                    }
+                }
+            }
+
+            chunked->pendingChunks = (int)chunked->missing.size();
+            if (chunked->pendingChunks == 0)
+            {
+                assembleChunkedUnit(chunked);
+                return;
+            }
+
+            std::string_view chunkUrl = _remoteManifest->getChunkUrl();
+            for (auto& hash : chunked->missing)
+            {
+                auto& waiters = _chunkWaiters[hash];
+                waiters.emplace_back(chunked);
+                // Chunks shared by several assets are only downloaded once
+                if (waiters.size() == 1)
+                {
+                    std::string srcUrl{chunkUrl};
+                    _downloader->createDownloadFileTask(srcUrl.append(hash), _chunkStoragePath + hash,
+                                                        CHUNK_ID_PREFIX + hash);
+                }
             }
+        });
+}
+
+void AssetsManagerEx::chunkFinished(std::string_view hash,
+                                    std::string_view errorStr,
+                                    int errorCode,
+                                    int errorCodeInternal)
+{
+    auto waitersIt = _chunkWaiters.find(hash);
+    if (waitersIt == _chunkWaiters.end())
+        return;
+
+    auto waiters = std::move(waitersIt->second);
+    _chunkWaiters.erase(waitersIt);
+    for (auto& chunked : waiters)
+    {
+        if (chunked->failed)
+            continue;
+
+        if (!errorStr.empty())
+        {
+            chunked->failed = true;
+            fileError(chunked->customId, errorStr, errorCode, errorCodeInternal);
         }
-        else
+        else if (--chunked->pendingChunks == 0)
         {
-            fileError(customId, "Asset file verification failed after downloaded");
+            assembleChunkedUnit(chunked);
         }
     }
 }
 
+void AssetsManagerEx::assembleChunkedUnit(std::shared_ptr<ChunkedUnit> chunked)
+{
+    auto succeed = std::make_shared<bool>(false);
+    runProcessingTask(
+        [this, chunked, succeed]() {
+            Data base;
+            if (!chunked->baseOffsets.empty())
+                base = _fileUtils->getDataFromFile(chunked->basePath);
+
+            auto stream = _fileUtils->openFileStream(chunked->storagePath, IFileStream::Mode::WRITE);
+            bool ok     = stream != nullptr;
+            for (auto it = chunked->chunks->begin(); ok && it != chunked->chunks->end(); ++it)
+            {
+                const auto& chunk    = *it;
+                const uint8_t* bytes = nullptr;
+                Data stored;
+                auto baseIt = chunked->baseOffsets.find(chunk.hash);
+                if (baseIt != chunked->baseOffsets.end() && baseIt->second + chunk.size <= base.getSize())
+                {
+                    bytes = base.getBytes() + baseIt->second;
+                }
+                else
+                {
+                    stored = _fileUtils->getDataFromFile(_chunkStoragePath + chunk.hash);
+                    if (stored.getSize() == chunk.size)
+                        bytes = stored.getBytes();
+                }
+                ok = bytes && ChunkIndex::hash(bytes, chunk.size) == chunk.hash &&
+                     stream->write(bytes, chunk.size) == (int)chunk.size;
+            }
+            if (stream)
+                stream->close();
+            if (!ok)
+                _fileUtils->removeFile(chunked->storagePath);
+            *succeed = ok;
+        },
+        [this, chunked, succeed]() {
+            if (*succeed)
+            {
+                processDownloadedUnit(chunked->customId, chunked->storagePath);
+            }
+            else
+            {
+                fileError(chunked->customId, "Unable to assemble asset file from chunks");
+            }
+        });
+}
+
 void AssetsManagerEx::destroyDownloadedVersion()
 {
     _fileUtils->removeDirectory(_storagePath);
@@ -1258,7 +1540,20 @@ void AssetsManagerEx::queueDowload()
         _currConcurrentTask++;
         DownloadUnit& unit = _downloadUnits[key];
         _fileUtils->createDirectory(basename(unit.storagePath));
-        _downloader->createDownloadFileTask(unit.srcUrl, unit.storagePath, unit.customId);
+
+        auto& assets = _remoteManifest->getAssets();
+        auto assetIt = assets.find(key);
+        if (assetIt != assets.end() && assetIt->second.chunks && !_remoteManifest->getChunkUrl().empty())
+        {
+            downloadChunkedUnit(unit, assetIt->second.chunks);
+        }
+        else
+        {
+            std::string_view checksum;
+            if (_downloadChecksumEnabled && assetIt != assets.end())
+                checksum = assetIt->second.md5;
+            _downloader->createDownloadFileTask(unit.srcUrl, unit.storagePath, unit.customId, checksum);
+        }
 
         _tempManifest->setAssetDownloadState(key, Manifest::DownloadState::DOWNLOADING);
     }
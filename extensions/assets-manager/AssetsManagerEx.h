@@ -26,6 +26,7 @@
 #ifndef __AssetsManagerEx__
 #define __AssetsManagerEx__
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -117,6 +118,25 @@ public:
      */
     void setMaxConcurrentTask(const int max) { _maxConcurrentTask = max; };
 
+    /** @brief Function for retrieving the max count of threads verifying, assembling and decompressing downloaded
+     * assets
+     */
+    int getMaxProcessingThreads() const { return _maxProcessingThreads; };
+
+    /** @brief Function for setting the max count of threads verifying, assembling and decompressing downloaded assets,
+     * must be called before the update starts
+     */
+    void setMaxProcessingThreads(int max) { _maxProcessingThreads = MAX(1, max); };
+
+    /** @brief Whether the md5 of the manifest assets is checked by the downloader while the data arrives
+     */
+    bool isDownloadChecksumEnabled() const { return _downloadChecksumEnabled; };
+
+    /** @brief Enable checking the md5 of the manifest assets while the data arrives, the assets must list their real
+     * md5 when enabled. Disabled by default.
+     */
+    void setDownloadChecksumEnabled(bool enabled) { _downloadChecksumEnabled = enabled; };
+
     /** @brief Set the handle function for comparing manifests versions
      * @param handle    The compare function
      */
@@ -168,6 +188,25 @@ protected:
     bool decompress(std::string_view filename);
     void decompressDownloadedZip(std::string_view customId, std::string_view storagePath);
 
+    /** @brief Verify and decompress a downloaded asset, then mark it as succeeded
+     */
+    void processDownloadedUnit(std::string_view customId, std::string_view storagePath);
+
+    /** @brief Rebuild an asset from the chunks of its installed version and the downloaded missing chunks
+     */
+    void downloadChunkedUnit(const DownloadUnit& unit, std::shared_ptr<ManifestChunks> chunks);
+
+    /** @brief Called when a downloaded chunk has been verified, or failed to download
+     */
+    void chunkFinished(std::string_view hash,
+                       std::string_view errorStr,
+                       int errorCode         = 0,
+                       int errorCodeInternal = 0);
+
+    /** @brief Run a task on the processing threads, the finished callback is called on the axmol thread
+     */
+    void runProcessingTask(std::function<void()> task, std::function<void()> finished);
+
     /** @brief Update a list of assets under the current AssetsManagerEx context
      */
     void updateAssets(const DownloadUnits& assets);
@@ -226,6 +265,11 @@ protected:
     virtual void onSuccess(std::string_view srcUrl, std::string_view storagePath, std::string_view customId);
 
 private:
+    class ProcessingPool;
+    struct ChunkedUnit;
+
+    void assembleChunkedUnit(std::shared_ptr<ChunkedUnit> chunked);
+
     void batchDownload();
 
     // Called when one DownloadUnits finished
@@ -255,6 +299,9 @@ private:
     //! The path to store downloading version.
     std::string _tempStoragePath;
 
+    //! The path to store downloaded chunks, kept until the update succeeds to resume interrupted updates.
+    std::string _chunkStoragePath;
+
     //! The local path of cached temporary version file
     std::string _tempVersionPath;
 
@@ -301,6 +348,18 @@ private:
     //! Current concurrent task count
     int _currConcurrentTask = 0;
 
+    //! Max count of threads processing downloaded assets
+    int _maxProcessingThreads;
+
+    //! Threads processing downloaded assets, created on first use
+    std::unique_ptr<ProcessingPool> _processingPool;
+
+    //! Chunked assets waiting for each downloading chunk
+    hlookup::string_map<std::vector<std::shared_ptr<ChunkedUnit>>> _chunkWaiters;
+
+    //! Whether the downloader checks the md5 of the assets
+    bool _downloadChecksumEnabled = false;
+
     //! Download percent
     float _percent = 0.f;
 
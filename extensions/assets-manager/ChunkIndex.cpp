@@ -0,0 +1,162 @@
+/****************************************************************************
+ Copyright (c) 2022 Bytedance Inc.
+
+ https://axmolengine.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "ChunkIndex.h"
+
+#include <stdio.h>
+
+#include "platform/FileUtils.h"
+#include "xxhash.h"
+
+NS_AX_EXT_BEGIN
+
+namespace
+{
+// Boundary when the low bits of the rolling hash are zero, which gives AVG_CHUNK_SIZE chunks on average
+const uint64_t CHUNK_MASK = ChunkIndex::AVG_CHUNK_SIZE - 1;
+
+struct GearTable
+{
+    uint64_t values[256];
+
+    GearTable()
+    {
+        // splitmix64 with a fixed seed, the table is part of the chunk format and must never change
+        uint64_t seed = 0x61786d6f6c636463ULL;
+        for (auto& value : values)
+        {
+            uint64_t z = (seed += 0x9e3779b97f4a7c15ULL);
+            z          = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z          = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            value      = z ^ (z >> 31);
+        }
+    }
+};
+
+const GearTable& gearTable()
+{
+    static GearTable table;
+    return table;
+}
+
+size_t nextBoundary(const uint8_t* data, size_t size)
+{
+    if (size <= ChunkIndex::MIN_CHUNK_SIZE)
+        return size;
+
+    const auto& gear = gearTable().values;
+    const auto limit = std::min(size, (size_t)ChunkIndex::MAX_CHUNK_SIZE);
+    uint64_t hash    = 0;
+    // The window of the gear hash is 64 bytes, start rolling just before the minimum size
+    for (size_t i = ChunkIndex::MIN_CHUNK_SIZE - 64; i < limit; ++i)
+    {
+        hash = (hash << 1) + gear[data[i]];
+        if (i >= ChunkIndex::MIN_CHUNK_SIZE && (hash & CHUNK_MASK) == 0)
+            return i + 1;
+    }
+    return limit;
+}
+}  // namespace
+
+ManifestChunks ChunkIndex::split(const void* data, size_t size)
+{
+    ManifestChunks chunks;
+    auto bytes    = static_cast<const uint8_t*>(data);
+    size_t offset = 0;
+    while (offset < size)
+    {
+        auto length = nextBoundary(bytes + offset, size - offset);
+        chunks.push_back({hash(bytes + offset, length), (uint32_t)length});
+        offset += length;
+    }
+    return chunks;
+}
+
+bool ChunkIndex::splitFile(std::string_view path, ManifestChunks* chunks)
+{
+    Data data = FileUtils::getInstance()->getDataFromFile(path);
+    if (data.isNull() && !FileUtils::getInstance()->isFileExist(path))
+        return false;
+    *chunks = split(data.getBytes(), data.getSize());
+    return true;
+}
+
+std::string ChunkIndex::hash(const void* data, size_t size)
+{
+    char buf[17];
+    snprintf(buf, sizeof(buf), "%016llx", (unsigned long long)XXH64(data, size, 0));
+    return std::string(buf, 16);
+}
+
+bool ChunkIndex::writeChunks(std::string_view path, std::string_view chunkDir, ManifestChunks* chunks)
+{
+    auto fileUtils = FileUtils::getInstance();
+    Data data      = fileUtils->getDataFromFile(path);
+    if (data.isNull() && !fileUtils->isFileExist(path))
+        return false;
+
+    std::string dir{chunkDir};
+    if (!dir.empty() && dir.back() != '/')
+        dir.push_back('/');
+    if (!fileUtils->isDirectoryExist(dir) && !fileUtils->createDirectory(dir))
+        return false;
+
+    auto list     = split(data.getBytes(), data.getSize());
+    size_t offset = 0;
+    for (const auto& chunk : list)
+    {
+        auto chunkPath = dir + chunk.hash;
+        if (!fileUtils->isFileExist(chunkPath))
+        {
+            Data chunkData;
+            chunkData.copy(data.getBytes() + offset, chunk.size);
+            if (!fileUtils->writeDataToFile(chunkData, chunkPath))
+                return false;
+        }
+        offset += chunk.size;
+    }
+
+    if (chunks)
+        *chunks = std::move(list);
+    return true;
+}
+
+bool ChunkIndex::fromJson(const rapidjson::Value& json, ManifestChunks* chunks)
+{
+    if (!json.IsArray())
+        return false;
+
+    chunks->clear();
+    chunks->reserve(json.Size());
+    for (rapidjson::SizeType i = 0; i < json.Size(); ++i)
+    {
+        const auto& entry = json[i];
+        if (!entry.IsArray() || entry.Size() != 2 || !entry[0].IsString() || !entry[1].IsUint())
+            return false;
+        chunks->push_back({entry[0].GetString(), entry[1].GetUint()});
+    }
+    return true;
+}
+
+NS_AX_EXT_END
@@ -0,0 +1,86 @@
+/****************************************************************************
+ Copyright (c) 2022 Bytedance Inc.
+
+ https://axmolengine.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef __ChunkIndex__
+#define __ChunkIndex__
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "extensions/ExtensionMacros.h"
+#include "extensions/ExtensionExport.h"
+
+#include "rapidjson/document-wrapper.h"
+
+NS_AX_EXT_BEGIN
+
+/** One content defined chunk of an asset, in file order. */
+struct ManifestChunk
+{
+    std::string hash;  // 16 hex digits of the XXH64 of the chunk content
+    uint32_t size;
+};
+
+typedef std::vector<ManifestChunk> ManifestChunks;
+
+/**
+ * @brief Content defined chunking for delta updates of large assets.
+ *
+ * Chunk boundaries are picked from the content with a gear rolling hash, so an edit only changes the chunks around
+ * it, and the rest of the file keeps the same chunks even when bytes are inserted or removed. The same parameters
+ * must be used by the tool that writes the manifest and by the client, which is why they are fixed here.
+ *
+ * A manifest asset lists its chunks as `"chunks" : [["<hash>", <size>], ...]`, and the chunk contents are served
+ * as `<chunkUrl><hash>`, where `chunkUrl` defaults to `<packageUrl>chunks/`.
+ */
+class AX_EX_DLL ChunkIndex
+{
+public:
+    static const uint32_t MIN_CHUNK_SIZE = 2 * 1024;
+    static const uint32_t AVG_CHUNK_SIZE = 16 * 1024;
+    static const uint32_t MAX_CHUNK_SIZE = 64 * 1024;
+
+    /** Splits a buffer into content defined chunks. */
+    static ManifestChunks split(const void* data, size_t size);
+
+    /** Splits a file into content defined chunks, returns false if the file can't be read. */
+    static bool splitFile(std::string_view path, ManifestChunks* chunks);
+
+    /** The chunk hash of a buffer. */
+    static std::string hash(const void* data, size_t size);
+
+    /**
+     * Splits a file and writes the chunks missing in chunkDir as chunkDir/<hash>, e.g. to publish a new version.
+     * @param chunks Receives the chunk list of the file, may be nullptr.
+     */
+    static bool writeChunks(std::string_view path, std::string_view chunkDir, ManifestChunks* chunks);
+
+    /** Reads a chunk list in the manifest format, returns false if the value is malformed. */
+    static bool fromJson(const rapidjson::Value& json, ManifestChunks* chunks);
+};
+
+NS_AX_EXT_END
+
+#endif /* defined(__ChunkIndex__) */
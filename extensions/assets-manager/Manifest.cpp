@@ -38,6 +38,7 @@
 #define KEY_ENGINE_VERSION "engineVersion"
 #define KEY_ASSETS "assets"
 #define KEY_COMPRESSED_FILES "compressedFiles"
+#define KEY_CHUNK_URL "chunkUrl"
 #define KEY_SEARCH_PATHS "searchPaths"
 
 #define KEY_PATH "path"
@@ -47,6 +48,7 @@
 #define KEY_SIZE "size"
 #define KEY_COMPRESSED_FILE "compressedFile"
 #define KEY_DOWNLOAD_STATE "downloadState"
+#define KEY_CHUNKS "chunks"
 
 NS_AX_EXT_BEGIN
 
@@ -322,6 +324,11 @@ std::string_view Manifest::getPackageUrl() const
     return _packageUrl;
 }
 
+std::string_view Manifest::getChunkUrl() const
+{
+    return _chunkUrl;
+}
+
 std::string_view Manifest::getManifestFileUrl() const
 {
     return _remoteManifestUrl;
@@ -409,6 +416,7 @@ void Manifest::clear()
     {
         _assets.clear();
         _searchPaths.clear();
+        _chunkUrl = "";
         _loaded = false;
     }
 }
@@ -451,6 +459,15 @@ Manifest::Asset Manifest::parseAsset(std::string_view path, const rapidjson::Val
     else
         asset.downloadState = DownloadState::UNMARKED;
 
+    if (json.HasMember(KEY_CHUNKS))
+    {
+        auto chunks = std::make_shared<ManifestChunks>();
+        if (ChunkIndex::fromJson(json[KEY_CHUNKS], chunks.get()))
+            asset.chunks = std::move(chunks);
+        else
+            AXLOG("AssetsManagerEx : Ignoring malformed chunk list of asset %s\n", asset.path.c_str());
+    }
+
     return asset;
 }
 
@@ -519,6 +536,20 @@ void Manifest::loadManifest(const rapidjson::Document& json)
         }
     }
 
+    // Retrieve chunk store url
+    if (json.HasMember(KEY_CHUNK_URL) && json[KEY_CHUNK_URL].IsString())
+    {
+        _chunkUrl = json[KEY_CHUNK_URL].GetString();
+        if (!_chunkUrl.empty() && _chunkUrl[_chunkUrl.size() - 1] != '/')
+        {
+            _chunkUrl.push_back('/');
+        }
+    }
+    else if (!_packageUrl.empty())
+    {
+        _chunkUrl = _packageUrl + "chunks/";
+    }
+
     // Retrieve all assets
     if (json.HasMember(KEY_ASSETS))
     {
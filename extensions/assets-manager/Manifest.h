@@ -33,6 +33,7 @@
 #include "extensions/ExtensionMacros.h"
 #include "extensions/ExtensionExport.h"
 #include "network/Downloader.h"
+#include "ChunkIndex.h"
 #include "platform/FileUtils.h"
 
 #include "rapidjson/document-wrapper.h"
@@ -54,6 +55,8 @@ struct ManifestAsset
     bool compressed;
     float size;
     int downloadState;
+    //! Content defined chunks of the asset, null if the asset can only be downloaded as a whole
+    std::shared_ptr<ManifestChunks> chunks;
 };
 
 typedef hlookup::string_map<DownloadUnit> DownloadUnits;
@@ -109,6 +112,10 @@ public:
      */
     std::string_view getVersionFileUrl() const;
 
+    /** @brief Gets remote chunk store url, the package url followed by `chunks/` if the manifest doesn't set it.
+     */
+    std::string_view getChunkUrl() const;
+
     /** @brief Gets manifest version.
      */
     std::string_view getVersion() const;
@@ -219,6 +226,9 @@ private:
     //! The remote package url
     std::string _packageUrl;
 
+    //! The remote url of the chunk store [Optional]
+    std::string _chunkUrl;
+
     //! The remote path of manifest file
     std::string _remoteManifestUrl;
 
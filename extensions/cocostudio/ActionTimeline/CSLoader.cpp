@@ -30,6 +30,7 @@
 #include "base/ObjectFactory.h"
 #include "base/Director.h"
 #include "base/UTF8.h"
+#include "base/FrameProfiler.h"
 #include "ui/CocosGUI.h"
 #include "2d/SpriteFrameCache.h"
 #include "2d/ParticleSystemQuad.h"
@@ -202,7 +203,13 @@ void CSLoader::destroyInstance()
 }
 
 CSLoader::CSLoader()
-    : _recordJsonPath(true), _jsonPath(""), _monoCocos2dxVersion(""), _rootNode(nullptr), _csBuildID("10.0.3000.0")
+    : _recordJsonPath(true)
+    , _jsonPath("")
+    , _monoCocos2dxVersion("")
+    , _rootNode(nullptr)
+    , _csBuildID("10.0.3000.0")
+    , _prototypeCacheEnabled(false)
+    , _prototypeCacheLimit(8 * 1024 * 1024)
 {
     CREATE_CLASS_NODE_READER_INFO(NodeReader);
     CREATE_CLASS_NODE_READER_INFO(SingleNodeReader);
@@ -282,6 +289,8 @@ void CSLoader::init()
 
 Node* CSLoader::createNode(std::string_view filename)
 {
+    AX_PROFILER_ZONE("CSLoader::createNode");
+
     auto path   = filename;
     size_t pos  = path.find_last_of('.');
     auto suffix = path.substr(pos + 1, path.length());
@@ -340,6 +349,104 @@ Node* CSLoader::createNodeWithVisibleSize(std::string_view filename, const ccNod
     return node;
 }
 
+bool CSLoader::createNodeAsync(std::string_view filename,
+                               ax::IncrementalLoader* loader,
+                               const ccNodeLoadCallback& callback)
+{
+    if (getExtentionName(filename) != "csb")
+        return false;
+
+    struct AsyncBuild
+    {
+        std::shared_ptr<Prototype> prototype;
+        // pending trees with the node they are added to, in creation order from the back
+        std::vector<std::pair<const flatbuffers::NodeTree*, RefPtr<Node>>> pending;
+        // the callback handlers of this file, kept apart from the other loads
+        Node* rootNode = nullptr;
+        ax::Vector<Node*> callbackHandlers;
+        ccNodeLoadCallback callback;
+    };
+
+    auto build      = std::make_shared<AsyncBuild>();
+    build->callback = callback;
+
+    auto buildStep = [build, loader]() {
+        if (build->pending.empty())
+            return;
+
+        auto [nodetree, parent] = std::move(build->pending.back());
+        build->pending.pop_back();
+
+        auto csLoader = CSLoader::getInstance();
+        std::swap(csLoader->_rootNode, build->rootNode);
+        std::swap(csLoader->_callbackHandlers, build->callbackHandlers);
+        Node* node = csLoader->createFlatBuffersNode(nodetree, build->callback);
+        if (node)
+        {
+            if (parent)
+                csLoader->addFlatBuffersChild(parent.get(), node, build->callback);
+            else
+                loader->setNode(node);
+
+            auto children = nodetree->children();
+            for (int i = static_cast<int>(children->size()) - 1; i >= 0; --i)
+                build->pending.emplace_back(children->Get(i), node);
+        }
+        std::swap(csLoader->_rootNode, build->rootNode);
+        std::swap(csLoader->_callbackHandlers, build->callbackHandlers);
+    };
+
+    std::string name{filename};
+    loader->addAsyncTask([name = std::move(name), build, loader, buildStep](const std::function<void()>& done) {
+        // one step per node, queued once the node tree is known
+        auto onLoaded = [build, loader, buildStep, done](std::shared_ptr<Prototype> prototype) {
+            if (prototype)
+            {
+                build->prototype = std::move(prototype);
+                auto nodetree    = GetCSParseBinary(build->prototype->data.getBytes())->nodeTree();
+                build->pending.emplace_back(nodetree, nullptr);
+
+                size_t count = 0;
+                std::vector<const flatbuffers::NodeTree*> trees{nodetree};
+                while (!trees.empty())
+                {
+                    auto tree = trees.back();
+                    trees.pop_back();
+                    ++count;
+                    auto children = tree->children();
+                    for (auto child : *children)
+                        trees.push_back(child);
+                }
+                for (size_t i = 0; i < count; ++i)
+                    loader->addStep(buildStep);
+            }
+            else
+                AXLOG("CSLoader::createNodeAsync - failed read file");
+            done();
+        };
+
+        auto csLoader        = CSLoader::getInstance();
+        std::string fullPath = FileUtils::getInstance()->fullPathForFilename(name);
+        if (csLoader->_prototypeCacheEnabled)
+        {
+            if (auto prototype = csLoader->findPrototype(fullPath))
+            {
+                onLoaded(std::move(prototype));
+                return;
+            }
+            ++csLoader->_prototypeStats.misses;
+        }
+
+        csLoader->loadPrototypeAsync(fullPath, [fullPath, onLoaded](std::shared_ptr<Prototype> prototype) {
+            auto csLoader = CSLoader::getInstance();
+            if (prototype && csLoader->_prototypeCacheEnabled)
+                csLoader->insertPrototype(fullPath, prototype);
+            onLoaded(std::move(prototype));
+        });
+    });
+    return true;
+}
+
 std::string_view CSLoader::getExtentionName(std::string_view name)
 {
     auto path   = name;
@@ -1002,6 +1109,18 @@ Node* CSLoader::nodeWithFlatBuffersFile(std::string_view fileName)
 
 Node* CSLoader::nodeWithFlatBuffersFile(std::string_view fileName, const ccNodeLoadCallback& callback)
 {
+    if (_prototypeCacheEnabled)
+    {
+        auto prototype = getPrototype(fileName);
+        if (!prototype)
+        {
+            AXLOG("CSLoader::nodeWithFlatBuffersFile - failed read file: %s", fileName.data());
+            AX_ASSERT(false);
+            return nullptr;
+        }
+        return nodeWithPrototype(*prototype, callback);
+    }
+
     std::string fullPath = FileUtils::getInstance()->fullPathForFilename(fileName);
 
     AX_ASSERT(FileUtils::getInstance()->isFileExist(fullPath));
@@ -1017,6 +1136,25 @@ Node* CSLoader::nodeWithFlatBuffersFile(std::string_view fileName, const ccNodeL
 
     auto csparsebinary = GetCSParseBinary(buf.getBytes());
 
+    if (!checkBuildId(csparsebinary))
+        return nullptr;
+
+    // decode plist
+    auto textures   = csparsebinary->textures();
+    int textureSize = textures->size();
+    for (int i = 0; i < textureSize; ++i)
+    {
+        std::string plist = textures->Get(i)->c_str();
+        SpriteFrameCache::getInstance()->addSpriteFramesWithFile(plist);
+    }
+
+    Node* node = nodeWithFlatBuffers(csparsebinary->nodeTree(), callback);
+
+    return node;
+}
+
+bool CSLoader::checkBuildId(const flatbuffers::CSParseBinary* csparsebinary)
+{
     auto csBuildId = csparsebinary->version();
     if (csBuildId)
     {
@@ -1065,22 +1203,230 @@ Node* CSLoader::nodeWithFlatBuffersFile(std::string_view fileName, const ccNodeL
                 StringUtils::format("error: The csloader version not match, require version is:%s, but %s provided!",
                                     csBuildId->c_str(), _csBuildID.c_str());
             throw std::logic_error(exceptionMsg.c_str());
-            return nullptr;
+            return false;
         }
     }
 
-    // decode plist
+    return true;
+}
+
+Node* CSLoader::nodeWithPrototype(const Prototype& prototype, const ccNodeLoadCallback& callback)
+{
+    // the frames may have been removed from the cache since the prototype was loaded
+    auto spriteFrameCache = SpriteFrameCache::getInstance();
+    for (auto&& plist : prototype.plists)
+    {
+        if (!spriteFrameCache->isSpriteFramesWithFileLoaded(plist))
+            spriteFrameCache->addSpriteFramesWithFile(plist);
+    }
+
+    return nodeWithFlatBuffers(GetCSParseBinary(prototype.data.getBytes())->nodeTree(), callback);
+}
+
+std::shared_ptr<CSLoader::Prototype> CSLoader::getPrototype(std::string_view filename)
+{
+    auto fileUtils       = FileUtils::getInstance();
+    std::string fullPath = fileUtils->fullPathForFilename(filename);
+    if (auto prototype = findPrototype(fullPath))
+        return prototype;
+
+    ++_prototypeStats.misses;
+    if (fullPath.empty())
+        return nullptr;
+    return addPrototype(fullPath, fileUtils->getDataFromFile(fullPath));
+}
+
+std::shared_ptr<CSLoader::Prototype> CSLoader::findPrototype(std::string_view fullPath)
+{
+    auto it = _prototypes.find(fullPath);
+    if (it == _prototypes.end())
+        return nullptr;
+
+    ++_prototypeStats.hits;
+    _prototypeList.splice(_prototypeList.begin(), _prototypeList, it->second);
+    return it->second->second;
+}
+
+std::shared_ptr<CSLoader::Prototype> CSLoader::addPrototype(std::string_view fullPath, Data data)
+{
+    auto prototype = createPrototype(std::move(data));
+    if (!prototype)
+        return nullptr;
+
+    auto spriteFrameCache = SpriteFrameCache::getInstance();
+    for (auto&& plist : prototype->plists)
+    {
+        if (!spriteFrameCache->isSpriteFramesWithFileLoaded(plist))
+            spriteFrameCache->addSpriteFramesWithFile(plist);
+    }
+    insertPrototype(fullPath, prototype);
+    return prototype;
+}
+
+std::shared_ptr<CSLoader::Prototype> CSLoader::createPrototype(Data data)
+{
+    if (data.isNull())
+        return nullptr;
+
+    auto csparsebinary = GetCSParseBinary(data.getBytes());
+    if (!checkBuildId(csparsebinary))
+        return nullptr;
+
+    auto prototype  = std::make_shared<Prototype>();
     auto textures   = csparsebinary->textures();
     int textureSize = textures->size();
     for (int i = 0; i < textureSize; ++i)
+        prototype->plists.emplace_back(textures->Get(i)->c_str());
+    prototype->data = std::move(data);
+    return prototype;
+}
+
+void CSLoader::insertPrototype(std::string_view fullPath, std::shared_ptr<Prototype> prototype)
+{
+    _prototypeStats.bytes += prototype->data.getSize();
+    auto it = _prototypes.find(fullPath);
+    if (it != _prototypes.end())
     {
-        std::string plist = textures->Get(i)->c_str();
-        SpriteFrameCache::getInstance()->addSpriteFramesWithFile(plist);
+        _prototypeStats.bytes -= it->second->second->data.getSize();
+        it->second->second = std::move(prototype);
+        _prototypeList.splice(_prototypeList.begin(), _prototypeList, it->second);
     }
+    else
+    {
+        _prototypeList.emplace_front(fullPath, std::move(prototype));
+        _prototypes.emplace(_prototypeList.front().first, _prototypeList.begin());
+        ++_prototypeStats.count;
+    }
+    trimPrototypes();
+}
 
-    Node* node = nodeWithFlatBuffers(csparsebinary->nodeTree(), callback);
+void CSLoader::trimPrototypes()
+{
+    while (_prototypeStats.bytes > _prototypeCacheLimit && _prototypeList.size() > 1)
+    {
+        auto& last = _prototypeList.back();
+        _prototypeStats.bytes -= last.second->data.getSize();
+        --_prototypeStats.count;
+        ++_prototypeStats.evictions;
+        _prototypes.erase(last.first);
+        _prototypeList.pop_back();
+    }
+}
 
-    return node;
+void CSLoader::setPrototypeCacheEnabled(bool enabled)
+{
+    _prototypeCacheEnabled = enabled;
+    if (!enabled)
+        removeAllPrototypes();
+}
+
+void CSLoader::setPrototypeCacheLimit(size_t bytes)
+{
+    _prototypeCacheLimit = bytes;
+    trimPrototypes();
+}
+
+bool CSLoader::preloadPrototype(std::string_view filename)
+{
+    auto fileUtils       = FileUtils::getInstance();
+    std::string fullPath = fileUtils->fullPathForFilename(filename);
+    return !fullPath.empty() && addPrototype(fullPath, fileUtils->getDataFromFile(fullPath)) != nullptr;
+}
+
+void CSLoader::preloadPrototypeAsync(std::string_view filename, std::function<void(bool)> callback)
+{
+    std::string fullPath = FileUtils::getInstance()->fullPathForFilename(filename);
+    loadPrototypeAsync(fullPath, [fullPath, callback = std::move(callback)](std::shared_ptr<Prototype> prototype) {
+        // the loader may have been destroyed meanwhile, so don't capture it
+        if (prototype)
+            CSLoader::getInstance()->insertPrototype(fullPath, prototype);
+        if (callback)
+            callback(prototype != nullptr);
+    });
+}
+
+void CSLoader::loadPrototypeAsync(std::string_view fullPath,
+                                  std::function<void(std::shared_ptr<Prototype>)> callback)
+{
+    AsyncTaskPool::getInstance()->enqueue(AsyncTaskPool::TaskType::TASK_IO, [fullPath = std::string{fullPath},
+                                                                             callback = std::move(callback)]() mutable {
+        // reading and verifying the buffer need no GL context, the sprite frames are loaded on the main thread
+        auto data = FileUtils::getInstance()->getDataFromFile(fullPath);
+        flatbuffers::Verifier::Options options;
+        options.max_depth = 1024;
+        flatbuffers::Verifier verifier(data.getBytes(), data.getSize(), options);
+        if (!data.isNull() && !VerifyCSParseBinaryBuffer(verifier))
+        {
+            AXLOG("CSLoader::loadPrototypeAsync - invalid file: %s", fullPath.c_str());
+            data.clear();
+        }
+
+        Director::getInstance()->getScheduler()->runOnAxmolThread(
+            [data = std::move(data), callback = std::move(callback)]() mutable {
+                auto prototype = CSLoader::getInstance()->createPrototype(std::move(data));
+                if (!prototype)
+                {
+                    callback(nullptr);
+                    return;
+                }
+
+                // the prototype is complete once its last sprite sheet is loaded
+                auto pending          = std::make_shared<int>(1);
+                auto finish           = [prototype, pending, callback = std::move(callback)](bool) {
+                    if (--*pending == 0)
+                        callback(prototype);
+                };
+                auto spriteFrameCache = SpriteFrameCache::getInstance();
+                for (auto&& plist : prototype->plists)
+                {
+                    if (spriteFrameCache->isSpriteFramesWithFileLoaded(plist))
+                        continue;
+                    ++*pending;
+                    spriteFrameCache->addSpriteFramesWithFileAsync(plist, finish);
+                }
+                finish(true);
+            });
+    });
+}
+
+void CSLoader::removePrototype(std::string_view filename)
+{
+    auto it = _prototypes.find(FileUtils::getInstance()->fullPathForFilename(filename));
+    if (it == _prototypes.end())
+        return;
+    auto entry = it->second;
+    _prototypeStats.bytes -= entry->second->data.getSize();
+    --_prototypeStats.count;
+    _prototypes.erase(it);
+    _prototypeList.erase(entry);
+}
+
+void CSLoader::removeAllPrototypes()
+{
+    _prototypes.clear();
+    _prototypeList.clear();
+    _prototypeStats.count = 0;
+    _prototypeStats.bytes = 0;
+}
+
+void CSLoader::resetPrototypeCacheStats()
+{
+    _prototypeStats.hits      = 0;
+    _prototypeStats.misses    = 0;
+    _prototypeStats.evictions = 0;
+}
+
+NodeReaderProtocol* CSLoader::getNodeReader(std::string_view readerName)
+{
+    auto it = _nodeReaders.find(readerName);
+    if (it != _nodeReaders.end())
+        return it->second;
+
+    // node readers are shared instances, so the lookup by name can be kept
+    auto reader = dynamic_cast<NodeReaderProtocol*>(ObjectFactory::getInstance()->createObject(readerName));
+    if (reader)
+        _nodeReaders.emplace(readerName, reader);
+    return reader;
 }
 
 Node* CSLoader::nodeWithFlatBuffers(const flatbuffers::NodeTree* nodetree)
@@ -1090,79 +1436,107 @@ Node* CSLoader::nodeWithFlatBuffers(const flatbuffers::NodeTree* nodetree)
 
 Node* CSLoader::nodeWithFlatBuffers(const flatbuffers::NodeTree* nodetree, const ccNodeLoadCallback& callback)
 {
-    if (nodetree == nullptr)
+    Node* node = createFlatBuffersNode(nodetree, callback);
+
+    // If node is invalid, there is no necessity to process children of node.
+    if (!node)
+    {
         return nullptr;
+    }
 
+    auto children = nodetree->children();
+    int size      = children->size();
+    for (int i = 0; i < size; ++i)
     {
-        Node* node = nullptr;
+        auto subNodeTree = children->Get(i);
+        Node* child      = nodeWithFlatBuffers(subNodeTree, callback);
+        addFlatBuffersChild(node, child, callback);
+    }
 
-        std::string classname = nodetree->classname()->c_str();
+    //    _loadingNodeParentHierarchy.pop_back();
 
-        auto options = nodetree->options();
+    return node;
+}
 
-        if (classname == "ProjectNode")
-        {
-            auto reader             = ProjectNodeReader::getInstance();
-            auto projectNodeOptions = (ProjectNodeOptions*)options->data();
-            std::string filePath    = projectNodeOptions->fileName()->c_str();
+Node* CSLoader::createFlatBuffersNode(const flatbuffers::NodeTree* nodetree, const ccNodeLoadCallback& callback)
+{
+    if (nodetree == nullptr)
+        return nullptr;
 
-            cocostudio::timeline::ActionTimeline* action = nullptr;
-            if (!filePath.empty() && FileUtils::getInstance()->isFileExist(filePath))
-            {
-                Data buf = FileUtils::getInstance()->getDataFromFile(filePath);
-                node     = createNode(buf, callback);
-                action   = createTimeline(buf, filePath);
-            }
-            else
-            {
-                node = Node::create();
-            }
-            reader->setPropsWithFlatBuffers(node, (const flatbuffers::Table*)options->data());
-            if (action)
-            {
-                action->setTimeSpeed(projectNodeOptions->innerActionSpeed());
-                node->runAction(action);
-                action->gotoFrameAndPause(0);
-            }
+    Node* node = nullptr;
+
+    std::string classname = nodetree->classname()->c_str();
+
+    auto options = nodetree->options();
+
+    if (classname == "ProjectNode")
+    {
+        auto reader             = ProjectNodeReader::getInstance();
+        auto projectNodeOptions = (ProjectNodeOptions*)options->data();
+        std::string filePath    = projectNodeOptions->fileName()->c_str();
+
+        cocostudio::timeline::ActionTimeline* action = nullptr;
+        std::shared_ptr<Prototype> prototype;
+        if (_prototypeCacheEnabled && !filePath.empty() && (prototype = getPrototype(filePath)))
+        {
+            node = nodeWithPrototype(*prototype, callback);
+            reconstructNestNode(node);
+            action = createTimeline(prototype->data, filePath);
         }
-        else if (classname == "SimpleAudio")
+        else if (!filePath.empty() && FileUtils::getInstance()->isFileExist(filePath))
         {
-            node                 = Node::create();
-            auto reader          = ComAudioReader::getInstance();
-            Component* component = reader->createComAudioWithFlatBuffers((const flatbuffers::Table*)options->data());
-            if (component)
-            {
-                component->setName(PlayableFrame::PLAYABLE_EXTENTION);
-                node->addComponent(component);
-                reader->setPropsWithFlatBuffers(node, (const flatbuffers::Table*)options->data());
-            }
+            Data buf = FileUtils::getInstance()->getDataFromFile(filePath);
+            node     = createNode(buf, callback);
+            action   = createTimeline(buf, filePath);
         }
         else
         {
-            std::string customClassName = nodetree->customClassName()->c_str();
-            if (customClassName != "")
-            {
-                classname = customClassName;
-            }
-            std::string readername{getGUIClassName(classname)};
-            readername.append("Reader");
-
-            NodeReaderProtocol* reader =
-                dynamic_cast<NodeReaderProtocol*>(ObjectFactory::getInstance()->createObject(readername));
-            if (reader == nullptr)
-                reader = dynamic_cast<NodeReaderProtocol*>(
-                    ObjectFactory::getInstance()->createObject("CustomRootNodeReader"));
-            if (reader != nullptr)
-            {
-                if (!customClassName.empty())
-                    reader->setCurrentCustomClassName(customClassName.c_str());
+            node = Node::create();
+        }
+        reader->setPropsWithFlatBuffers(node, (const flatbuffers::Table*)options->data());
+        if (action)
+        {
+            action->setTimeSpeed(projectNodeOptions->innerActionSpeed());
+            node->runAction(action);
+            action->gotoFrameAndPause(0);
+        }
+    }
+    else if (classname == "SimpleAudio")
+    {
+        node                 = Node::create();
+        auto reader          = ComAudioReader::getInstance();
+        Component* component = reader->createComAudioWithFlatBuffers((const flatbuffers::Table*)options->data());
+        if (component)
+        {
+            component->setName(PlayableFrame::PLAYABLE_EXTENTION);
+            node->addComponent(component);
+            reader->setPropsWithFlatBuffers(node, (const flatbuffers::Table*)options->data());
+        }
+    }
+    else
+    {
+        std::string customClassName = nodetree->customClassName()->c_str();
+        if (customClassName != "")
+        {
+            classname = customClassName;
+        }
+        std::string readername{getGUIClassName(classname)};
+        readername.append("Reader");
 
-                node = reader->createNodeWithFlatBuffers((const flatbuffers::Table*)options->data());
-            }
-            else
-            {
-                auto exceptionMsg = StringUtils::format(
-                    R"(error: Missing custom reader class name:%s, please config at your project fiile xxx.xsxproj like follow:
+        NodeReaderProtocol* reader = getNodeReader(readername);
+        if (reader == nullptr)
+            reader = getNodeReader("CustomRootNodeReader");
+        if (reader != nullptr)
+        {
+            if (!customClassName.empty())
+                reader->setCurrentCustomClassName(customClassName.c_str());
+
+            node = reader->createNodeWithFlatBuffers((const flatbuffers::Table*)options->data());
+        }
+        else
+        {
+            auto exceptionMsg = StringUtils::format(
+                R"(error: Missing custom reader class name:%s, please config at your project fiile xxx.xsxproj like follow:
     <Project>
       <publish-opts> 
          <custom-readers>
@@ -1171,80 +1545,67 @@ Node* CSLoader::nodeWithFlatBuffers(const flatbuffers::NodeTree* nodetree, const
       </publish-opts>
     </Project>
 )",
-                    readername.c_str(), readername.c_str());
-                throw std::logic_error(exceptionMsg.c_str());
-            }
-
-            Widget* widget = dynamic_cast<Widget*>(node);
-            if (widget)
-            {
-                auto callbackName = widget->getCallbackName();
-                auto callbackType = widget->getCallbackType();
+                readername.c_str(), readername.c_str());
+            throw std::logic_error(exceptionMsg.c_str());
+        }
 
-                bindCallback(callbackName, callbackType, widget, _rootNode);
-            }
+        Widget* widget = dynamic_cast<Widget*>(node);
+        if (widget)
+        {
+            auto callbackName = widget->getCallbackName();
+            auto callbackType = widget->getCallbackType();
 
-            /* To reconstruct nest node as WidgetCallBackHandlerProtocol. */
-            auto callbackHandler = dynamic_cast<WidgetCallBackHandlerProtocol*>(node);
-            if (callbackHandler)
-            {
-                _callbackHandlers.pushBack(node);
-                _rootNode = _callbackHandlers.back();
-            }
-            /**/
-            //        _loadingNodeParentHierarchy.emplace_back(node);
+            bindCallback(callbackName, callbackType, widget, _rootNode);
         }
 
-        // If node is invalid, there is no necessity to process children of node.
-        if (!node)
+        /* To reconstruct nest node as WidgetCallBackHandlerProtocol. */
+        auto callbackHandler = dynamic_cast<WidgetCallBackHandlerProtocol*>(node);
+        if (callbackHandler)
         {
-            return nullptr;
+            _callbackHandlers.pushBack(node);
+            _rootNode = _callbackHandlers.back();
         }
+        /**/
+        //        _loadingNodeParentHierarchy.emplace_back(node);
+    }
 
-        auto children = nodetree->children();
-        int size      = children->size();
-        for (int i = 0; i < size; ++i)
-        {
-            auto subNodeTree = children->Get(i);
-            Node* child      = nodeWithFlatBuffers(subNodeTree, callback);
-            if (child)
-            {
-                if (auto pageView = dynamic_cast<PageView*>(node))
-                {
-                    Layout* layout = dynamic_cast<Layout*>(child);
-                    if (layout)
-                    {
-                        pageView->addPage(layout);
-                    }
-                }
-                else if (auto listView = dynamic_cast<ListView*>(node))
-                {
-                    Widget* widget = dynamic_cast<Widget*>(child);
-                    if (widget)
-                    {
-                        listView->pushBackCustomItem(widget);
-                    }
-                }
-                else if (auto radioButtonGroup = dynamic_cast<RadioButtonGroup*>(node))
-                {
-                    radioButtonGroup->addRadioButton(dynamic_cast<RadioButton*>(child));
-                    radioButtonGroup->addChild(child);
-                }
-                else
-                {
-                    node->addChild(child);
-                }
+    return node;
+}
 
-                if (callback)
-                {
-                    callback(child);
-                }
-            }
-        }
+void CSLoader::addFlatBuffersChild(Node* node, Node* child, const ccNodeLoadCallback& callback)
+{
+    if (!child)
+        return;
 
-        //    _loadingNodeParentHierarchy.pop_back();
+    if (auto pageView = dynamic_cast<PageView*>(node))
+    {
+        Layout* layout = dynamic_cast<Layout*>(child);
+        if (layout)
+        {
+            pageView->addPage(layout);
+        }
+    }
+    else if (auto listView = dynamic_cast<ListView*>(node))
+    {
+        Widget* widget = dynamic_cast<Widget*>(child);
+        if (widget)
+        {
+            listView->pushBackCustomItem(widget);
+        }
+    }
+    else if (auto radioButtonGroup = dynamic_cast<RadioButtonGroup*>(node))
+    {
+        radioButtonGroup->addRadioButton(dynamic_cast<RadioButton*>(child));
+        radioButtonGroup->addChild(child);
+    }
+    else
+    {
+        node->addChild(child);
+    }
 
-        return node;
+    if (callback)
+    {
+        callback(child);
     }
 }
 
@@ -1423,6 +1784,7 @@ void CSLoader::registReaderObject(std::string_view className, ObjectFactory::Ins
     t._fun   = ins;
 
     ObjectFactory::getInstance()->registerType(t);
+    _nodeReaders.clear();
 }
 
 Node* CSLoader::createNodeWithFlatBuffersForSimulator(std::string_view filename)
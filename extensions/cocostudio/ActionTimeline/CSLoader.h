@@ -30,8 +30,14 @@
 
 #include "base/ObjectFactory.h"
 #include "base/Data.h"
+#include "base/hlookup.h"
+#include "2d/IncrementalLoader.h"
 #include "ui/UIWidget.h"
 
+#include <functional>
+#include <list>
+#include <memory>
+
 namespace flatbuffers
 {
 class FlatBufferBuilder;
@@ -47,11 +53,14 @@ struct ProjectNodeOptions;
 
 struct ComponentOptions;
 struct ComAudioOptions;
+
+struct CSParseBinary;
 }  // namespace flatbuffers
 
 namespace cocostudio
 {
 class ComAudio;
+class NodeReaderProtocol;
 }
 
 namespace cocostudio
@@ -86,6 +95,15 @@ public:
     static ax::Node* createNodeWithVisibleSize(std::string_view filename);
     static ax::Node* createNodeWithVisibleSize(std::string_view filename, const ccNodeLoadCallback& callback);
 
+    /** Queues the construction of a .csb node on an incremental loader, which must not be started yet.
+     * The file and its sprite sheets are loaded asynchronously, then one node is created per step, so a large scene
+     * is spread over several frames. The node is passed to the loader completion callback.
+     * @return false if the file is not a .csb.
+     */
+    static bool createNodeAsync(std::string_view filename,
+                                ax::IncrementalLoader* loader,
+                                const ccNodeLoadCallback& callback = nullptr);
+
     static cocostudio::timeline::ActionTimeline* createTimeline(std::string_view filename);
     static cocostudio::timeline::ActionTimeline* createTimeline(const Data& data, std::string_view filename);
 
@@ -119,10 +137,55 @@ public:
     ax::Node* createNodeWithFlatBuffersForSimulator(std::string_view filename);
     ax::Node* nodeWithFlatBuffersForSimulator(const flatbuffers::NodeTree* nodetree);
 
+    /** Hit counts of the .csb prototype cache. */
+    struct PrototypeCacheStats
+    {
+        unsigned int hits      = 0;
+        unsigned int misses    = 0;
+        unsigned int evictions = 0;  ///< files dropped to stay within the cache limit
+        size_t count           = 0;  ///< number of cached files
+        size_t bytes           = 0;  ///< size of the cached file data
+
+        float getHitRate() const { return hits + misses ? static_cast<float>(hits) / (hits + misses) : 0.0f; }
+    };
+
+    /** Sets whether .csb files are kept resident once read and verified, so that creating the same node again only
+     * walks the cached node tree. Files are keyed by their full path, so a search path change that resolves a name to
+     * another file is a miss. Disabled by default, disabling it purges the cache.
+     */
+    void setPrototypeCacheEnabled(bool enabled);
+    bool isPrototypeCacheEnabled() const { return _prototypeCacheEnabled; }
+
+    /** Sets the size of the cached file data above which the least recently used files are dropped. 8MB by default.
+     * The most recently used file is always kept.
+     */
+    void setPrototypeCacheLimit(size_t bytes);
+    size_t getPrototypeCacheLimit() const { return _prototypeCacheLimit; }
+
+    /** Reads a .csb into the prototype cache and loads its sprite frames.
+     * @return false if the file can't be read or isn't a valid .csb.
+     */
+    bool preloadPrototype(std::string_view filename);
+
+    /** Reads and verifies a .csb on a worker thread, then loads its sprite frames and caches it on the main thread.
+     * @param callback Called on the main thread with whether the file was cached.
+     */
+    void preloadPrototypeAsync(std::string_view filename, std::function<void(bool)> callback);
+
+    void removePrototype(std::string_view filename);
+    /** Purges the prototype cache. */
+    void removeAllPrototypes();
+
+    const PrototypeCacheStats& getPrototypeCacheStats() const { return _prototypeStats; }
+    void resetPrototypeCacheStats();
+
 protected:
     ax::Node* createNodeWithFlatBuffersFile(std::string_view filename, const ccNodeLoadCallback& callback);
     ax::Node* nodeWithFlatBuffersFile(std::string_view fileName, const ccNodeLoadCallback& callback);
     ax::Node* nodeWithFlatBuffers(const flatbuffers::NodeTree* nodetree, const ccNodeLoadCallback& callback);
+    // creates the node of a tree without its children
+    ax::Node* createFlatBuffersNode(const flatbuffers::NodeTree* nodetree, const ccNodeLoadCallback& callback);
+    void addFlatBuffersChild(ax::Node* parent, ax::Node* child, const ccNodeLoadCallback& callback);
 
     ax::Node* loadNode(const rapidjson::Value& json);
 
@@ -173,6 +236,38 @@ protected:
     ax::Vector<ax::Node*> _callbackHandlers;
 
     std::string _csBuildID;
+
+    // a .csb kept resident by the prototype cache
+    struct Prototype
+    {
+        Data data;
+        std::vector<std::string> plists;
+    };
+
+    std::shared_ptr<Prototype> getPrototype(std::string_view filename);
+    // returns the prototype cached for a full path and marks it as the most recently used one
+    std::shared_ptr<Prototype> findPrototype(std::string_view fullPath);
+    std::shared_ptr<Prototype> addPrototype(std::string_view fullPath, Data data);
+    std::shared_ptr<Prototype> createPrototype(Data data);
+    void insertPrototype(std::string_view fullPath, std::shared_ptr<Prototype> prototype);
+    void trimPrototypes();
+    // reads and verifies a .csb on a worker thread and loads its sprite sheets asynchronously
+    void loadPrototypeAsync(std::string_view fullPath, std::function<void(std::shared_ptr<Prototype>)> callback);
+    bool checkBuildId(const flatbuffers::CSParseBinary* csparsebinary);
+    ax::Node* nodeWithPrototype(const Prototype& prototype, const ccNodeLoadCallback& callback);
+    cocostudio::NodeReaderProtocol* getNodeReader(std::string_view readerName);
+
+    using PrototypeList = std::list<std::pair<std::string, std::shared_ptr<Prototype>>>;
+
+    bool _prototypeCacheEnabled;
+    size_t _prototypeCacheLimit;
+    // most recently used first, indexed by full path
+    PrototypeList _prototypeList;
+    hlookup::string_map<PrototypeList::iterator> _prototypes;
+    PrototypeCacheStats _prototypeStats;
+
+    // readers resolved by name, reset when a reader is registered
+    hlookup::string_map<cocostudio::NodeReaderProtocol*> _nodeReaders;
 };
 
 NS_AX_END
@@ -49,11 +49,21 @@ namespace spine {
 	} _TrackEntryListeners;
 
 	void animationCallback(AnimationState *state, EventType type, TrackEntry *entry, Event *event) {
-		((SkeletonAnimation *) state->getRendererObject())->onAnimationStateEvent(entry, type, event);
+		SkeletonAnimation *node = (SkeletonAnimation *) state->getRendererObject();
+		if (node->_deferEvents) {
+			node->_deferredEvents.push_back({entry, type, event, false});
+			return;
+		}
+		node->onAnimationStateEvent(entry, type, event);
 	}
 
 	void trackEntryCallback(AnimationState *state, EventType type, TrackEntry *entry, Event *event) {
-		((SkeletonAnimation *) state->getRendererObject())->onTrackEntryEvent(entry, type, event);
+		SkeletonAnimation *node = (SkeletonAnimation *) state->getRendererObject();
+		if (node->_deferEvents) {
+			node->_deferredEvents.push_back({entry, type, event, true});
+			return;
+		}
+		node->onTrackEntryEvent(entry, type, event);
 		if (type == EventType_Dispose) {
 			if (entry->getRendererObject()) {
 				delete (spine::_TrackEntryListeners *) entry->getRendererObject();
@@ -118,6 +128,12 @@ namespace spine {
 		_state->setListener(animationCallback);
 
 		_firstDraw = true;
+
+		_pendingDeltaTime = 0;
+		_hasPendingUpdate = false;
+		_deferEvents = false;
+		_parallelUpdateApplied = false;
+		_manualTrackEntryDisposal = false;
 	}
 
 	SkeletonAnimation::SkeletonAnimation()
@@ -136,9 +152,74 @@ namespace spine {
 
 		deltaTime *= _timeScale;
 		if (_preUpdateListener) _preUpdateListener(this);
+		if (isParallelUpdateScheduled()) {
+			// Applied by SkeletonUpdateScheduler before the next draw.
+			_pendingDeltaTime += deltaTime;
+			_hasPendingUpdate = true;
+			return;
+		}
+		applyAnimationState(deltaTime);
+		if (_postUpdateListener) _postUpdateListener(this);
+	}
+
+	void SkeletonAnimation::applyAnimationState(float deltaTime) {
 		_state->update(deltaTime);
 		_state->apply(*_skeleton);
 		_skeleton->updateWorldTransform();
+	}
+
+	void SkeletonAnimation::applyPendingUpdate() {
+		_hasPendingUpdate = false;
+		applyAnimationState(_pendingDeltaTime);
+		_pendingDeltaTime = 0;
+		_worldCoordsValid = false;
+		if (_postUpdateListener) _postUpdateListener(this);
+	}
+
+	void SkeletonAnimation::updateParallel() {
+		if (_hasPendingUpdate) {
+			_hasPendingUpdate = false;
+
+			// Listeners may touch the scene graph, so events are recorded and track entries are kept alive until
+			// finishParallelUpdate replays them on the main thread.
+			_manualTrackEntryDisposal = _state->getManualTrackEntryDisposal();
+			_state->setManualTrackEntryDisposal(true);
+			_deferEvents = true;
+			applyAnimationState(_pendingDeltaTime);
+			_deferEvents = false;
+			_state->setManualTrackEntryDisposal(_manualTrackEntryDisposal);
+
+			_pendingDeltaTime = 0;
+			_parallelUpdateApplied = true;
+		}
+
+		// The post update listener may still move bones, world vertices are computed on draw then.
+		if (_postUpdateListener) {
+			_worldCoordsValid = false;
+			return;
+		}
+		super::updateParallel();
+	}
+
+	void SkeletonAnimation::finishParallelUpdate() {
+		super::finishParallelUpdate();
+		if (!_parallelUpdateApplied) return;
+		_parallelUpdateApplied = false;
+
+		AnimationState *state = _state;
+		for (size_t i = 0; i < _deferredEvents.size() && state == _state; ++i) {
+			const DeferredEvent deferred = _deferredEvents[i];
+			if (deferred.trackEntryEvent) {
+				trackEntryCallback(state, deferred.type, deferred.entry, deferred.event);
+			} else {
+				animationCallback(state, deferred.type, deferred.entry, deferred.event);
+				if (deferred.type == EventType_Dispose && !_manualTrackEntryDisposal) {
+					state->disposeTrackEntry(deferred.entry);
+				}
+			}
+		}
+		_deferredEvents.clear();
+
 		if (_postUpdateListener) _postUpdateListener(this);
 	}
 
@@ -147,6 +228,10 @@ namespace spine {
 			_firstDraw = false;
 			update(0);
 		}
+		// Drawn before SkeletonUpdateScheduler ran, e.g. into a render texture.
+		if (_hasPendingUpdate) {
+			applyPendingUpdate();
+		}
 		super::draw(renderer, transform, transformFlags);
 	}
 
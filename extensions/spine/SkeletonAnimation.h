@@ -109,6 +109,22 @@ namespace spine {
 		virtual void initialize() override;
 
 	protected:
+		friend void animationCallback(AnimationState *state, EventType type, TrackEntry *entry, Event *event);
+		friend void trackEntryCallback(AnimationState *state, EventType type, TrackEntry *entry, Event *event);
+
+		void updateParallel() override;
+		void finishParallelUpdate() override;
+		void applyAnimationState(float deltaTime);
+		void applyPendingUpdate();
+
+		/* An animation state event recorded during a parallel update, replayed on the main thread. */
+		struct DeferredEvent {
+			TrackEntry *entry;
+			EventType type;
+			Event *event;
+			bool trackEntryEvent;
+		};
+
 		AnimationState *_state;
 
 		bool _ownsAnimationStateData;
@@ -124,6 +140,13 @@ namespace spine {
 		UpdateWorldTransformsListener _preUpdateListener;
 		UpdateWorldTransformsListener _postUpdateListener;
 
+		float _pendingDeltaTime;
+		bool _hasPendingUpdate;
+		bool _deferEvents;
+		bool _parallelUpdateApplied;
+		bool _manualTrackEntryDisposal;
+		std::vector<DeferredEvent> _deferredEvents;
+
 	private:
 		typedef SkeletonRenderer super;
 	};
@@ -47,6 +47,7 @@ namespace spine {
 		Color4B ColorToColor4B(const Color &color);
 		bool slotIsOutRange(Slot &slot, int startSlotIndex, int endSlotIndex);
 		bool nothingToDraw(Slot &slot, int startSlotIndex, int endSlotIndex);
+		bool hasSequenceAttachment(Skeleton &skeleton, int startSlotIndex, int endSlotIndex);
 	}// namespace
 
 // C Variable length array
@@ -227,33 +228,57 @@ namespace spine {
 
 	void SkeletonRenderer::update(float deltaTime) {
 		Node::update(deltaTime);
+		_worldCoordsValid = false;
 	}
 
-	void SkeletonRenderer::draw(Renderer *renderer, const Mat4 &transform, uint32_t transformFlags) {
-		// Early exit if the skeleton is invisible.
-		if (getDisplayedOpacity() == 0 || _skeleton->getColor().a == 0) {
+	void SkeletonRenderer::updateParallel() {
+		_worldCoordsValid = false;
+		if (!isVisible() || getDisplayedOpacity() == 0 || _skeleton->getColor().a == 0) {
 			return;
 		}
+		// Sequence attachments swap the region of the shared attachment while computing world vertices.
+		if (hasSequenceAttachment(*_skeleton, _startSlotIndex, _endSlotIndex)) {
+			return;
+		}
+		computeWorldCoords();
+		_worldCoordsValid = true;
+	}
 
+	void SkeletonRenderer::finishParallelUpdate() {
+	}
+
+	void SkeletonRenderer::computeWorldCoords() {
 		const int coordCount = computeTotalCoordCount(*_skeleton, _startSlotIndex, _endSlotIndex);
+		assert(coordCount % 2 == 0);
+		_worldCoords.resize(coordCount);
 		if (coordCount == 0) {
 			return;
 		}
-		assert(coordCount % 2 == 0);
+		transformWorldVertices(_worldCoords.data(), coordCount, *_skeleton, _startSlotIndex, _endSlotIndex);
+		_worldCoordsBounds = computeBoundingRect(_worldCoords.data(), coordCount / 2);
+	}
 
-		VLA(float, worldCoords, coordCount);
-		transformWorldVertices(worldCoords, coordCount, *_skeleton, _startSlotIndex, _endSlotIndex);
+	void SkeletonRenderer::draw(Renderer *renderer, const Mat4 &transform, uint32_t transformFlags) {
+		// Early exit if the skeleton is invisible.
+		if (getDisplayedOpacity() == 0 || _skeleton->getColor().a == 0) {
+			return;
+		}
 
-#if CC_USE_CULLING
-		const cocos2d::Rect bb = computeBoundingRect(worldCoords, coordCount / 2);
+		// Already computed by SkeletonUpdateScheduler when the skeleton is updated in parallel.
+		if (!_worldCoordsValid) {
+			computeWorldCoords();
+		}
+		if (_worldCoords.empty()) {
+			return;
+		}
 
-		if (cullRectangle(renderer, transform, bb)) {
-			VLA_FREE(worldCoords);
+#if CC_USE_CULLING
+		if (cullRectangle(renderer, transform, _worldCoordsBounds)) {
 			return;
 		}
 #endif
 
-		const float *worldCoordPtr = worldCoords;
+		const float *worldCoordPtr = _worldCoords.data();
 		SkeletonBatch *batch = SkeletonBatch::getInstance();
 		SkeletonTwoColorBatch *twoColorBatch = SkeletonTwoColorBatch::getInstance();
 		const bool hasSingleTint = (isTwoColorTint() == false);
@@ -534,8 +559,6 @@ namespace spine {
 		if (_debugBoundingRect || _debugSlots || _debugBones || _debugMeshes) {
 			drawDebug(renderer, transform, transformFlags);
 		}
-
-		VLA_FREE(worldCoords);
 	}
 
 
@@ -660,6 +683,9 @@ namespace spine {
 	}
 
 	cocos2d::Rect SkeletonRenderer::getBoundingBox() const {
+		if (_worldCoordsValid) {
+			return _worldCoords.empty() ? cocos2d::Rect(0, 0, 0, 0) : _worldCoordsBounds;
+		}
 		const int coordCount = computeTotalCoordCount(*_skeleton, _startSlotIndex, _endSlotIndex);
 		if (coordCount == 0) return {0, 0, 0, 0};
 		VLA(float, worldCoords, coordCount);
@@ -673,16 +699,20 @@ namespace spine {
 
 	void SkeletonRenderer::updateWorldTransform() {
 		_skeleton->updateWorldTransform();
+		_worldCoordsValid = false;
 	}
 
 	void SkeletonRenderer::setToSetupPose() {
 		_skeleton->setToSetupPose();
+		_worldCoordsValid = false;
 	}
 	void SkeletonRenderer::setBonesToSetupPose() {
 		_skeleton->setBonesToSetupPose();
+		_worldCoordsValid = false;
 	}
 	void SkeletonRenderer::setSlotsToSetupPose() {
 		_skeleton->setSlotsToSetupPose();
+		_worldCoordsValid = false;
 	}
 
 	Bone *SkeletonRenderer::findBone(const std::string &boneName) const {
@@ -695,9 +725,11 @@ namespace spine {
 
 	void SkeletonRenderer::setSkin(const std::string &skinName) {
 		_skeleton->setSkin(skinName.empty() ? 0 : skinName.c_str());
+		_worldCoordsValid = false;
 	}
 	void SkeletonRenderer::setSkin(const char *skinName) {
 		_skeleton->setSkin(skinName);
+		_worldCoordsValid = false;
 	}
 
 	Attachment *SkeletonRenderer::getAttachment(const std::string &slotName, const std::string &attachmentName) const {
@@ -706,11 +738,13 @@ namespace spine {
 	bool SkeletonRenderer::setAttachment(const std::string &slotName, const std::string &attachmentName) {
 		bool result = _skeleton->getAttachment(slotName.c_str(), attachmentName.empty() ? 0 : attachmentName.c_str()) ? true : false;
 		_skeleton->setAttachment(slotName.c_str(), attachmentName.empty() ? 0 : attachmentName.c_str());
+		_worldCoordsValid = false;
 		return result;
 	}
 	bool SkeletonRenderer::setAttachment(const std::string &slotName, const char *attachmentName) {
 		bool result = _skeleton->getAttachment(slotName.c_str(), attachmentName) ? true : false;
 		_skeleton->setAttachment(slotName.c_str(), attachmentName);
+		_worldCoordsValid = false;
 		return result;
 	}
 
@@ -732,6 +766,23 @@ namespace spine {
 	void SkeletonRenderer::setSlotsRange(int startSlotIndex, int endSlotIndex) {
 		_startSlotIndex = startSlotIndex == -1 ? 0 : startSlotIndex;
 		_endSlotIndex = endSlotIndex == -1 ? std::numeric_limits<int>::max() : endSlotIndex;
+		_worldCoordsValid = false;
+	}
+
+	void SkeletonRenderer::setParallelUpdateEnabled(bool enabled) {
+		if (_parallelUpdate == enabled) return;
+		_parallelUpdate = enabled;
+		if (!_running) return;
+		if (enabled) {
+			SkeletonUpdateScheduler::getInstance()->addSkeleton(this);
+		} else {
+			SkeletonUpdateScheduler::getInstance()->removeSkeleton(this);
+			_worldCoordsValid = false;
+		}
+	}
+
+	bool SkeletonRenderer::isParallelUpdateEnabled() const {
+		return _parallelUpdate;
 	}
 
 	Skeleton *SkeletonRenderer::getSkeleton() const {
@@ -780,6 +831,7 @@ namespace spine {
 #endif
 		Node::onEnter();
 		scheduleUpdate();
+		if (_parallelUpdate) SkeletonUpdateScheduler::getInstance()->addSkeleton(this);
 	}
 
 	void SkeletonRenderer::onExit() {
@@ -788,6 +840,8 @@ namespace spine {
 #endif
 		Node::onExit();
 		unscheduleUpdate();
+		if (_parallelUpdate) SkeletonUpdateScheduler::getInstance()->removeSkeleton(this);
+		_worldCoordsValid = false;
 	}
 
 	// --- CCBlendProtocol
@@ -856,6 +910,22 @@ namespace spine {
 			return false;
 		}
 
+		bool hasSequenceAttachment(Skeleton &skeleton, int startSlotIndex, int endSlotIndex) {
+			for (size_t i = 0; i < skeleton.getSlots().size(); ++i) {
+				Slot &slot = *skeleton.getSlots()[i];
+				if (nothingToDraw(slot, startSlotIndex, endSlotIndex)) {
+					continue;
+				}
+				Attachment *const attachment = slot.getAttachment();
+				if (attachment->getRTTI().isExactly(RegionAttachment::rtti)) {
+					if (static_cast<RegionAttachment *>(attachment)->getSequence()) return true;
+				} else if (attachment->getRTTI().isExactly(MeshAttachment::rtti)) {
+					if (static_cast<MeshAttachment *>(attachment)->getSequence()) return true;
+				}
+			}
+			return false;
+		}
+
 		int computeTotalCoordCount(Skeleton &skeleton, int startSlotIndex, int endSlotIndex) {
 			int coordCount = 0;
 			for (size_t i = 0; i < skeleton.getSlots().size(); ++i) {
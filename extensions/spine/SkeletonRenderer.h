@@ -32,6 +32,7 @@
 
 #include "cocos2d.h"
 #include <spine/spine.h>
+#include <vector>
 
 namespace spine {
 
@@ -103,6 +104,11 @@ namespace spine {
 		/* Sets the range of slots that should be rendered. Use -1, -1 to clear the range */
 		void setSlotsRange(int startSlotIndex, int endSlotIndex);
 
+		/* Enables/disables updating this skeleton on worker threads together with the other opted-in skeletons, see
+		 * SkeletonUpdateScheduler. Listeners are still called on the main thread, but after the whole batch was updated. */
+		void setParallelUpdateEnabled(bool enabled);
+		bool isParallelUpdateEnabled() const;
+
 		// --- BlendProtocol
 		void setBlendFunc(const cocos2d::BlendFunc &blendFunc) override;
 		const cocos2d::BlendFunc &getBlendFunc() const override;
@@ -127,10 +133,20 @@ namespace spine {
 		virtual void initialize();
 
 	protected:
+		friend class SkeletonUpdateScheduler;
+
 		void setSkeletonData(SkeletonData *skeletonData, bool ownsSkeletonData);
 		void setupGLProgramState(bool twoColorTintEnabled);
 		virtual void drawDebug(cocos2d::Renderer *renderer, const cocos2d::Mat4 &transform, uint32_t transformFlags);
 
+		bool isParallelUpdateScheduled() const { return _parallelUpdate && _running; }
+		/* Called by SkeletonUpdateScheduler on a worker thread, must only touch this skeleton. */
+		virtual void updateParallel();
+		/* Called by SkeletonUpdateScheduler on the main thread once all skeletons ran updateParallel. */
+		virtual void finishParallelUpdate();
+		/* Computes the world vertices of all drawn attachments in draw order, and their bounds. */
+		void computeWorldCoords();
+
 		bool _ownsSkeletonData;
 		bool _ownsSkeleton;
 		bool _ownsAtlas = false;
@@ -151,6 +167,12 @@ namespace spine {
 		int _startSlotIndex;
 		int _endSlotIndex;
 		bool _twoColorTint;
+
+		bool _parallelUpdate = false;
+		// world vertices kept between the parallel update and draw
+		std::vector<float> _worldCoords;
+		cocos2d::Rect _worldCoordsBounds;
+		bool _worldCoordsValid = false;
 	};
 
 }// namespace spine
@@ -0,0 +1,101 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated September 24, 2021. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2021, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <spine/spine-cocos2dx.h>
+#include <spine/SkeletonUpdateScheduler.h>
+
+#include "base/JobSystem.h"
+
+USING_NS_CC;
+
+namespace spine {
+
+	static SkeletonUpdateScheduler *instance = nullptr;
+
+	SkeletonUpdateScheduler *SkeletonUpdateScheduler::getInstance() {
+		if (!instance) instance = new SkeletonUpdateScheduler();
+		return instance;
+	}
+
+	void SkeletonUpdateScheduler::destroyInstance() {
+		if (instance) {
+			delete instance;
+			instance = nullptr;
+		}
+	}
+
+	SkeletonUpdateScheduler::SkeletonUpdateScheduler() : _grainSize(4) {
+		_beforeDrawListener = Director::getInstance()->getEventDispatcher()->addCustomEventListener(Director::EVENT_BEFORE_DRAW, [this](EventCustom *) {
+			this->update();
+		});
+	}
+
+	SkeletonUpdateScheduler::~SkeletonUpdateScheduler() {
+		Director::getInstance()->getEventDispatcher()->removeEventListener(_beforeDrawListener);
+	}
+
+	void SkeletonUpdateScheduler::addSkeleton(SkeletonRenderer *skeleton) {
+		if (std::find(_skeletons.begin(), _skeletons.end(), skeleton) == _skeletons.end()) {
+			_skeletons.push_back(skeleton);
+		}
+	}
+
+	void SkeletonUpdateScheduler::removeSkeleton(SkeletonRenderer *skeleton) {
+		auto it = std::find(_skeletons.begin(), _skeletons.end(), skeleton);
+		if (it != _skeletons.end()) {
+			_skeletons.erase(it);
+		}
+	}
+
+	void SkeletonUpdateScheduler::setGrainSize(int grainSize) {
+		_grainSize = std::max(grainSize, 1);
+	}
+
+	void SkeletonUpdateScheduler::update() {
+		if (_skeletons.empty() || !_updating.empty()) return;
+
+		for (auto skeleton : _skeletons) {
+			_updating.pushBack(skeleton);
+		}
+
+		JobSystem::getInstance()->parallelFor((int) _updating.size(), _grainSize, [this](int begin, int end) {
+			for (int i = begin; i < end; ++i) {
+				_updating.at(i)->updateParallel();
+			}
+		});
+
+		// Events and listeners may touch the scene graph, so they run here, one skeleton after the other.
+		for (auto skeleton : _updating) {
+			skeleton->finishParallelUpdate();
+		}
+		_updating.clear();
+	}
+
+}// namespace spine
@@ -0,0 +1,75 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated September 24, 2021. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2021, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef SPINE_SKELETONUPDATESCHEDULER_H_
+#define SPINE_SKELETONUPDATESCHEDULER_H_
+
+#include "cocos2d.h"
+#include <spine/spine.h>
+#include <vector>
+
+namespace spine {
+	class SkeletonRenderer;
+
+	/* Updates all skeletons that opted in with SkeletonRenderer::setParallelUpdateEnabled on the JobSystem, once per
+	 * frame before the scene is visited. Animation state, world transforms and world vertices are computed on the
+	 * workers, animation events and listeners are dispatched on the main thread afterwards in registration order, and
+	 * render commands are still emitted in visit order, so the result does not depend on the number of workers. */
+	class SP_API SkeletonUpdateScheduler {
+	public:
+		static SkeletonUpdateScheduler *getInstance();
+
+		static void destroyInstance();
+
+		void addSkeleton(SkeletonRenderer *skeleton);
+		void removeSkeleton(SkeletonRenderer *skeleton);
+		size_t getSkeletonCount() const { return _skeletons.size(); }
+
+		/* Number of skeletons handed to a worker at a time. Defaults to 4. */
+		void setGrainSize(int grainSize);
+		int getGrainSize() const { return _grainSize; }
+
+		/* Runs the parallel pass. Called automatically before each draw, calling it again in the same frame only
+		 * recomputes the world vertices. */
+		void update();
+
+	protected:
+		SkeletonUpdateScheduler();
+		virtual ~SkeletonUpdateScheduler();
+
+		std::vector<SkeletonRenderer *> _skeletons;
+		// skeletons of the running pass, retained so that listeners may remove them
+		cocos2d::Vector<SkeletonRenderer *> _updating;
+		int _grainSize;
+		cocos2d::EventListenerCustom *_beforeDrawListener;
+	};
+
+}// namespace spine
+
+#endif// SPINE_SKELETONUPDATESCHEDULER_H_
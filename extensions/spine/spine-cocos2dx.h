@@ -38,6 +38,7 @@
 #include <spine/SkeletonTwoColorBatch.h>
 
 #include <spine/SkeletonAnimation.h>
+#include <spine/SkeletonUpdateScheduler.h>
 
 namespace spine {
 	class SP_API Cocos2dAtlasAttachmentLoader : public AtlasAttachmentLoader {
@@ -36,6 +36,8 @@ DrawPrimitivesTests::DrawPrimitivesTests()
     ADD_TEST_CASE(Issue11942Test);
     ADD_TEST_CASE(BetterCircleRendering);
     ADD_TEST_CASE(Issue829Test);
+    ADD_TEST_CASE(DrawNodeDynamicTest);
+    ADD_TEST_CASE(DrawNodeRetainedTest);
 }
 
 string DrawPrimitivesBaseTest::title() const
@@ -460,3 +462,109 @@ string Issue829Test::subtitle() const
 {
     return "Red polygon has wrong order!";
 }
+
+// DrawNodeDynamicTest
+DrawNodeDynamicTest::DrawNodeDynamicTest()
+{
+    _drawNode = DrawNode::create();
+    _drawNode->setDynamic(true);
+    addChild(_drawNode, 10);
+
+    scheduleUpdate();
+}
+
+void DrawNodeDynamicTest::update(float dt)
+{
+    _elapsed += dt;
+
+    // rebuilt every frame, the vertices are streamed into the renderer ring instead of the node's own buffers
+    _drawNode->clear();
+
+    auto center = VisibleRect::center();
+    for (int i = 0; i < 200; ++i)
+    {
+        float angle  = _elapsed + i * 0.1f;
+        float radius = 20.0f + i;
+        auto pos     = center + Vec2(cosf(angle) * radius, sinf(angle * 1.3f) * radius * 0.6f);
+        auto color   = Color4F(0.5f + 0.5f * sinf(angle), 0.5f + 0.5f * cosf(angle), 1.0f - i / 200.0f, 1.0f);
+
+        _drawNode->drawDot(pos, 4, color);
+        _drawNode->drawLine(center, pos, Color4F(color.r, color.g, color.b, 0.3f));
+        _drawNode->drawPoint(pos + Vec2(8, 8), 3, color);
+    }
+}
+
+string DrawNodeDynamicTest::title() const
+{
+    return "DrawNode dynamic";
+}
+
+string DrawNodeDynamicTest::subtitle() const
+{
+    return "Redrawn every frame through the renderer vertex stream";
+}
+
+// DrawNodeRetainedTest
+DrawNodeRetainedTest::DrawNodeRetainedTest()
+{
+    _drawNode = DrawNode::create();
+    addChild(_drawNode, 10);
+
+    // a static grid, drawn once and never uploaded again
+    auto s = Director::getInstance()->getWinSize();
+    for (int i = 0; i < 5000; ++i)
+    {
+        auto pos = Vec2((i % 100) * s.width / 100, (i / 100) * s.height / 50);
+        _drawNode->drawPoint(pos, 2, Color4F(0.3f, 0.3f, 0.3f, 1.0f));
+    }
+
+    // markers moved every frame, each one only re-uploads its own vertices
+    auto center = VisibleRect::center();
+    for (int i = 0; i < 20; ++i)
+    {
+        _drawNode->beginShape();
+        _drawNode->drawSolidCircle(center, 10, 0, 24, Color4F::GREEN);
+        _markers.push_back(_drawNode->endShape());
+    }
+
+    scheduleUpdate();
+}
+
+void DrawNodeRetainedTest::update(float dt)
+{
+    _elapsed += dt;
+
+    auto center = VisibleRect::center();
+    for (size_t i = 0; i < _markers.size(); ++i)
+    {
+        float angle = _elapsed + i * 0.3f;
+        auto pos    = center + Vec2(cosf(angle), sinf(angle)) * (60.0f + i * 8);
+        _drawNode->updateShape(_markers[i], [pos](DrawNode* node) {
+            node->drawSolidCircle(pos, 10, 0, 24, Color4F::GREEN);
+        });
+    }
+
+    // a shape removed and added back, the geometry behind it moves down
+    if (_drawNode->hasShape(_blinker))
+    {
+        if (fmodf(_elapsed, 1.0f) > 0.5f)
+            _drawNode->removeShape(_blinker);
+    }
+    else if (fmodf(_elapsed, 1.0f) <= 0.5f)
+    {
+        _drawNode->beginShape();
+        _drawNode->drawCubicBezier(VisibleRect::left(), center + Vec2(-100, 200), center + Vec2(100, -200),
+                                   VisibleRect::right(), 64, Color4F::YELLOW);
+        _blinker = _drawNode->endShape();
+    }
+}
+
+string DrawNodeRetainedTest::title() const
+{
+    return "DrawNode retained shapes";
+}
+
+string DrawNodeRetainedTest::subtitle() const
+{
+    return "Markers updated by id over a static 5000 point grid";
+}
@@ -93,3 +93,37 @@ public:
     virtual std::string title() const override;
     virtual std::string subtitle() const override;
 };
+
+class DrawNodeDynamicTest : public DrawPrimitivesBaseTest
+{
+public:
+    CREATE_FUNC(DrawNodeDynamicTest);
+
+    DrawNodeDynamicTest();
+
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+    void update(float dt) override;
+
+private:
+    ax::DrawNode* _drawNode = nullptr;
+    float _elapsed          = 0;
+};
+
+class DrawNodeRetainedTest : public DrawPrimitivesBaseTest
+{
+public:
+    CREATE_FUNC(DrawNodeRetainedTest);
+
+    DrawNodeRetainedTest();
+
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+    void update(float dt) override;
+
+private:
+    ax::DrawNode* _drawNode = nullptr;
+    std::vector<unsigned int> _markers;
+    unsigned int _blinker = 0;
+    float _elapsed        = 0;
+};
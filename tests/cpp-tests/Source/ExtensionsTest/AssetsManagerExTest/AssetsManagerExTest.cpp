@@ -25,6 +25,7 @@
 #include "AssetsManagerExTest.h"
 #include "../../testResource.h"
 #include "axmol.h"
+#include "base/format.h"
 
 USING_NS_AX;
 USING_NS_AX_EXT;
@@ -41,6 +42,7 @@ AssetsManagerExTests::AssetsManagerExTests()
     addTestCase("AssetsManager Test1", []() { return AssetsManagerExLoaderScene::create(0); });
     addTestCase("AssetsManager Test2", []() { return AssetsManagerExLoaderScene::create(1); });
     addTestCase("AssetsManager Test3", []() { return AssetsManagerExLoaderScene::create(2); });
+    ADD_TEST_CASE(AssetsManagerExDeltaTest);
 }
 
 AssetsManagerExLoaderScene* AssetsManagerExLoaderScene::create(int testIndex)
@@ -221,3 +223,169 @@ std::string AssetsManagerExLoaderScene::title() const
 {
     return "AssetsManagerExTest";
 }
+
+//------------------------------------------------------------------
+//
+// AssetsManagerExDeltaTest
+//
+//------------------------------------------------------------------
+
+static std::string fileUrl(std::string_view path)
+{
+    return path.front() == '/' ? fmt::format("file://{}", path) : fmt::format("file:///{}", path);
+}
+
+static std::string manifestJson(std::string_view version,
+                                std::string_view root,
+                                std::string_view md5,
+                                size_t size,
+                                const ManifestChunks* chunks)
+{
+    std::string chunkList;
+    if (chunks)
+    {
+        for (auto& chunk : *chunks)
+            chunkList += fmt::format("{}[\"{}\", {}]", chunkList.empty() ? "" : ", ", chunk.hash, chunk.size);
+        chunkList = fmt::format(", \"chunks\" : [{}]", chunkList);
+    }
+    return fmt::format(R"({{
+    "packageUrl" : "{0}",
+    "remoteManifestUrl" : "{0}project.manifest",
+    "version" : "{1}",
+    "engineVersion" : "axmol",
+    "assets" : {{
+        "data.bin" : {{ "md5" : "{2}", "size" : {3}{4} }}
+    }},
+    "searchPaths" : []
+}})",
+                       fileUrl(root), version, md5, size, chunkList);
+}
+
+bool AssetsManagerExDeltaTest::prepareVersions()
+{
+    auto fileUtils = FileUtils::getInstance();
+    fileUtils->removeDirectory(_root);
+    fileUtils->createDirectory(_root + "local/");
+    fileUtils->createDirectory(_root + "server/");
+
+    // Version 1 is 1MB of noise, version 2 patches a few bytes and inserts a block in the middle
+    std::vector<uint8_t> bytes(1024 * 1024);
+    uint32_t seed = 12345;
+    for (auto& byte : bytes)
+    {
+        seed = seed * 1664525 + 1013904223;
+        byte = (uint8_t)(seed >> 24);
+    }
+    Data oldVersion;
+    oldVersion.copy(bytes.data(), bytes.size());
+    std::fill_n(bytes.begin() + 300000, 100, (uint8_t)0xAB);
+    bytes.insert(bytes.begin() + 700000, 5000, (uint8_t)0xCD);
+    _newVersion.copy(bytes.data(), bytes.size());
+
+    // The local directory stands for the installed package, the server one for the http server
+    std::string oldPath = _root + "local/data.bin", newPath = _root + "server/data.bin";
+    ManifestChunks newChunks;
+    if (!fileUtils->writeDataToFile(oldVersion, oldPath) || !fileUtils->writeDataToFile(_newVersion, newPath) ||
+        !ChunkIndex::writeChunks(newPath, _root + "server/chunks/", &newChunks))
+        return false;
+
+    hlookup::string_set oldHashes;
+    for (auto& chunk : ChunkIndex::split(oldVersion.getBytes(), oldVersion.getSize()))
+        oldHashes.emplace(chunk.hash);
+    _deltaSize = 0;
+    for (auto& chunk : newChunks)
+    {
+        if (oldHashes.emplace(chunk.hash).second)
+            _deltaSize += chunk.size;
+    }
+
+    return fileUtils->writeStringToFile(manifestJson("1.0.0", _root + "server/", utils::getFileMD5Hash(oldPath),
+                                                     oldVersion.getSize(), nullptr),
+                                        _root + "local/project.manifest") &&
+           fileUtils->writeStringToFile(manifestJson("1.0.1", _root + "server/", utils::getFileMD5Hash(newPath),
+                                                     _newVersion.getSize(), &newChunks),
+                                        _root + "server/project.manifest");
+}
+
+void AssetsManagerExDeltaTest::onEnter()
+{
+    TestCase::onEnter();
+
+    _status = Label::createWithTTF("Preparing versions...", "fonts/arial.ttf", 16);
+    _status->setPosition(VisibleRect::center());
+    addChild(_status);
+
+    _root = FileUtils::getInstance()->getWritablePath() + "CppTests/AssetsManagerExTest/delta/";
+    if (!prepareVersions())
+    {
+        onUpdateEnd(false, "Unable to write the test versions");
+        return;
+    }
+
+    _am = AssetsManagerEx::create(_root + "local/project.manifest", _root + "storage/");
+    _am->retain();
+    _am->setVerifyCallback([](std::string_view path, Manifest::Asset asset) {
+        return utils::getFileMD5Hash(path) == asset.md5;
+    });
+
+    _amListener = EventListenerAssetsManagerEx::create(_am, [this](EventAssetsManagerEx* event) {
+        switch (event->getEventCode())
+        {
+        case EventAssetsManagerEx::EventCode::UPDATE_PROGRESSION:
+            _status->setString(StringUtils::format("%.2f%%", event->getPercent()));
+            break;
+        case EventAssetsManagerEx::EventCode::UPDATE_FINISHED:
+        {
+            auto path = std::string{_am->getStoragePath()} + "data.bin";
+            auto data = FileUtils::getInstance()->getDataFromFile(path);
+            if (data.getSize() == _newVersion.getSize() &&
+                memcmp(data.getBytes(), _newVersion.getBytes(), data.getSize()) == 0)
+                onUpdateEnd(true, StringUtils::format("Updated, downloaded %zu of %zu bytes", _deltaSize,
+                                                      (size_t)_newVersion.getSize()));
+            else
+                onUpdateEnd(false, "Updated file doesn't match the new version");
+        }
+        break;
+        case EventAssetsManagerEx::EventCode::ALREADY_UP_TO_DATE:
+        case EventAssetsManagerEx::EventCode::UPDATE_FAILED:
+        case EventAssetsManagerEx::EventCode::ERROR_NO_LOCAL_MANIFEST:
+        case EventAssetsManagerEx::EventCode::ERROR_DOWNLOAD_MANIFEST:
+        case EventAssetsManagerEx::EventCode::ERROR_PARSE_MANIFEST:
+            onUpdateEnd(false, event->getMessage());
+            break;
+        case EventAssetsManagerEx::EventCode::ERROR_UPDATING:
+            AXLOG("Asset %s : %s", event->getAssetId().c_str(), event->getMessage().c_str());
+            break;
+        default:
+            break;
+        }
+    });
+    _eventDispatcher->addEventListenerWithFixedPriority(_amListener, 1);
+
+    _am->update();
+}
+
+void AssetsManagerExDeltaTest::onUpdateEnd(bool succeed, std::string_view message)
+{
+    AXLOG("AssetsManagerExDeltaTest: %s", message.data());
+    _status->setString(std::string{succeed ? "" : "Failed: "}.append(message));
+    _status->setColor(succeed ? Color3B::GREEN : Color3B::RED);
+}
+
+void AssetsManagerExDeltaTest::onExit()
+{
+    if (_amListener)
+        _eventDispatcher->removeEventListener(_amListener);
+    AX_SAFE_RELEASE_NULL(_am);
+    TestCase::onExit();
+}
+
+std::string AssetsManagerExDeltaTest::title() const
+{
+    return "AssetsManagerEx delta update";
+}
+
+std::string AssetsManagerExDeltaTest::subtitle() const
+{
+    return "Rebuilds a 1MB file from the installed version and the changed chunks";
+}
@@ -56,4 +56,28 @@ private:
     void onLoadEnd();
 };
 
+class AssetsManagerExDeltaTest : public TestCase
+{
+public:
+    CREATE_FUNC(AssetsManagerExDeltaTest);
+
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+    virtual void onEnter() override;
+    virtual void onExit() override;
+
+private:
+    bool prepareVersions();
+    void onUpdateEnd(bool succeed, std::string_view message);
+
+    std::string _root;
+    ax::Data _newVersion;
+    size_t _deltaSize = 0;
+
+    ax::extension::AssetsManagerEx* _am                      = nullptr;
+    ax::extension::EventListenerAssetsManagerEx* _amListener = nullptr;
+    ax::Label* _status                                       = nullptr;
+};
+
 #endif /* defined(__AssetsManagerEx_Test_H__) */
@@ -27,6 +27,8 @@
 #include "renderer/Renderer.h"
 #include "2d/FontAtlasCache.h"
 
+#include <chrono>
+
 USING_NS_AX;
 using namespace ui;
 using namespace extension;
@@ -169,6 +171,7 @@ NewLabelTests::NewLabelTests()
     ADD_TEST_CASE(LabelIssueLineGap);
     ADD_TEST_CASE(LabelIssue17902);
     ADD_TEST_CASE(LabelLetterColorsTest);
+    ADD_TEST_CASE(LabelSetStringBenchmark);
 };
 
 LabelFNTColorAndOpacity::LabelFNTColorAndOpacity()
@@ -3683,3 +3686,90 @@ void LabelLetterColorsTest::setLetterColors(ax::Label* label, const ax::Color3B&
             letter->setColor(color);
     }
 }
+
+LabelSetStringBenchmark::LabelSetStringBenchmark()
+{
+    auto origin = VisibleRect::leftBottom();
+    auto size   = VisibleRect::getVisibleRect().size;
+
+    // 300 score counters, a typical HUD and damage numbers load
+    const int columns = 15, rows = 20;
+    for (int i = 0; i < columns * rows; ++i)
+    {
+        auto label = Label::createWithTTF("0", "fonts/arial.ttf", 12);
+        label->setPosition(origin.x + size.width * (i % columns + 0.5f) / columns,
+                           origin.y + size.height * 0.1f + size.height * 0.7f * (i / columns + 0.5f) / rows);
+        addChild(label);
+        _labels.emplace_back(label);
+    }
+
+    // Puts the digits in the atlas
+    _labels.front()->setString("0123456789");
+    _labels.front()->getContentSize();
+
+    _result = Label::createWithTTF("", "fonts/arial.ttf", 16);
+    _result->setPosition(origin.x + size.width / 2, origin.y + size.height * 0.05f);
+    addChild(_result);
+
+    MenuItemFont::setFontSize(16);
+    auto toggle =
+        MenuItemFont::create("Toggle fast update", AX_CALLBACK_1(LabelSetStringBenchmark::toggleFastUpdate, this));
+    auto menu = Menu::create(toggle, nullptr);
+    menu->setPosition(origin.x + size.width / 2, origin.y + size.height * 0.85f);
+    addChild(menu);
+
+    scheduleUpdate();
+}
+
+void LabelSetStringBenchmark::update(float dt)
+{
+    char text[16];
+    // The content size forces the layout, which is otherwise deferred to the next visit
+    auto start = std::chrono::steady_clock::now();
+    {
+        AllocationCounter::Scope allocations;
+        for (auto label : _labels)
+        {
+            int length = snprintf(text, sizeof(text), "%u", ++_counter);
+            label->setString(std::string_view{text, static_cast<size_t>(length)});
+            label->getContentSize();
+        }
+        _allocations += allocations.getCount();
+    }
+    _elapsed += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+    if (++_frames == 60)
+    {
+        double calls = static_cast<double>(_frames) * _labels.size();
+        // Allocations are only counted when the engine is built with AX_ENABLE_ALLOCATION_COUNTER
+        if (AllocationCounter::isAvailable())
+            _result->setString(StringUtils::format("Fast update %s: %.3f us and %.2f allocations per setString",
+                                                   _fastUpdate ? "ON" : "OFF", _elapsed / calls, _allocations / calls));
+        else
+            _result->setString(StringUtils::format("Fast update %s: %.3f us per setString",
+                                                   _fastUpdate ? "ON" : "OFF", _elapsed / calls));
+        _frames      = 0;
+        _elapsed     = 0.0;
+        _allocations = 0;
+    }
+}
+
+void LabelSetStringBenchmark::toggleFastUpdate(Ref* sender)
+{
+    _fastUpdate = !_fastUpdate;
+    for (auto label : _labels)
+        label->setFastUpdateEnabled(_fastUpdate);
+    _frames      = 0;
+    _elapsed     = 0.0;
+    _allocations = 0;
+}
+
+std::string LabelSetStringBenchmark::title() const
+{
+    return "Label setString benchmark";
+}
+
+std::string LabelSetStringBenchmark::subtitle() const
+{
+    return "300 TTF counters updated every frame";
+}
@@ -1030,4 +1030,28 @@ private:
     static void setLetterColors(ax::Label* label, const ax::Color3B& color);
 };
 
+class LabelSetStringBenchmark : public AtlasDemoNew
+{
+public:
+    CREATE_FUNC(LabelSetStringBenchmark);
+
+    LabelSetStringBenchmark();
+
+    virtual void update(float dt) override;
+
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+private:
+    void toggleFastUpdate(ax::Ref* sender);
+
+    std::vector<ax::Label*> _labels;
+    ax::Label* _result    = nullptr;
+    bool _fastUpdate      = true;
+    unsigned int _counter = 0;
+    int _frames           = 0;
+    double _elapsed       = 0.0;
+    int64_t _allocations  = 0;
+};
+
 #endif
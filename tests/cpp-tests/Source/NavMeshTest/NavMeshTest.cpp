@@ -29,6 +29,7 @@
 #include "physics3d/Physics3D.h"
 #include "3d/Bundle3D.h"
 #include "2d/Light.h"
+#include "base/format.h"
 
 USING_NS_AX_EXT;
 USING_NS_AX;
@@ -45,6 +46,7 @@ NavMeshTests::NavMeshTests()
 #else
     ADD_TEST_CASE(NavMeshBasicTestDemo);
     ADD_TEST_CASE(NavMeshAdvanceTestDemo);
+    ADD_TEST_CASE(NavMeshAsyncTestDemo);
 #endif
 };
 
@@ -435,4 +437,125 @@ void NavMeshAdvanceTestDemo::touchesEnded(const std::vector<ax::Touch*>& touches
     }
 }
 
+NavMeshAsyncTestDemo::NavMeshAsyncTestDemo() : _asyncLabel(nullptr), _queryLabel(nullptr), _pathsFound(0), _raysHit(0) {}
+
+NavMeshAsyncTestDemo::~NavMeshAsyncTestDemo()
+{
+    AX_SAFE_RELEASE(_asyncLabel);
+    AX_SAFE_RELEASE(_queryLabel);
+}
+
+bool NavMeshAsyncTestDemo::init()
+{
+    if (!NavMeshBaseTestDemo::init())
+        return false;
+
+    // room for a crowd bigger than the default one
+    auto navMesh = NavMesh::create("NavMesh/all_tiles_tilecache.bin", "NavMesh/geomset.txt", 300);
+    navMesh->setAsyncUpdateEnabled(true);
+    navMesh->setMaxTileRebuildsPerUpdate(4);
+    setNavMesh(navMesh);
+    setNavMeshDebugCamera(_camera);
+
+    TTFConfig ttfConfig("fonts/arial.ttf", 15);
+    _asyncLabel = Label::createWithTTF(ttfConfig, "Async Update ON");
+    _asyncLabel->retain();
+    _queryLabel = Label::createWithTTF(ttfConfig, "Paths: 0 Rays: 0");
+    _queryLabel->retain();
+    _queryLabel->setAnchorPoint(Vec2::ANCHOR_TOP_LEFT);
+    _queryLabel->setPosition(Vec2(VisibleRect::left().x, VisibleRect::top().y - 150));
+    addChild(_queryLabel);
+
+    auto menuItem0 = MenuItemLabel::create(_asyncLabel, [=](Ref*) {
+        bool enabled = !getNavMesh()->isAsyncUpdateEnabled();
+        getNavMesh()->setAsyncUpdateEnabled(enabled);
+        _asyncLabel->setString(enabled ? "Async Update ON" : "Async Update OFF");
+    });
+    menuItem0->setAnchorPoint(Vec2::ANCHOR_TOP_LEFT);
+    menuItem0->setPosition(Vec2(VisibleRect::left().x, VisibleRect::top().y - 50));
+
+    auto menuItem1 = MenuItemFont::create("Create Obstacle", [=](Ref*) {
+        float x = ax::random(-50.0f, 50.0f);
+        float z = ax::random(-50.0f, 50.0f);
+        Physics3DWorld::HitResult result;
+        getPhysics3DWorld()->rayCast(Vec3(x, 50.0f, z), Vec3(x, -50.0f, z), &result);
+        createObstacle(result.hitPosition);
+    });
+    menuItem1->setFontSizeObj(15);
+    menuItem1->setAnchorPoint(Vec2::ANCHOR_TOP_LEFT);
+    menuItem1->setPosition(Vec2(VisibleRect::left().x, VisibleRect::top().y - 100));
+
+    auto menu = Menu::create(menuItem0, menuItem1, nullptr);
+    menu->setPosition(Vec2::ZERO);
+    addChild(menu);
+
+    schedule(AX_SCHEDULE_SELECTOR(NavMeshAsyncTestDemo::sendQueries), 0.5f);
+
+    return true;
+}
+
+void NavMeshAsyncTestDemo::onEnter()
+{
+    NavMeshBaseTestDemo::onEnter();
+    getNavMesh()->setDebugDrawEnable(false);
+
+    for (int i = 0; i < 300; ++i)
+    {
+        float x = ax::random(-50.0f, 50.0f);
+        float z = ax::random(-50.0f, 50.0f);
+        Physics3DWorld::HitResult result;
+        if (getPhysics3DWorld()->rayCast(Vec3(x, 50.0f, z), Vec3(x, -50.0f, z), &result))
+            createAgent(result.hitPosition);
+    }
+}
+
+void NavMeshAsyncTestDemo::sendQueries(float dt)
+{
+    // the results arrive on a later frame, batched with the crowd update
+    for (int i = 0; i < 64; ++i)
+    {
+        Vec3 start(ax::random(-50.0f, 50.0f), 0.0f, ax::random(-50.0f, 50.0f));
+        Vec3 end(ax::random(-50.0f, 50.0f), 0.0f, ax::random(-50.0f, 50.0f));
+        getNavMesh()->findPathAsync(start, end, [this](const std::vector<Vec3>& points) {
+            if (!points.empty())
+                ++_pathsFound;
+        });
+        getNavMesh()->raycastAsync(start, end, [this](const NavMesh::RaycastResult& result) {
+            if (result.hit)
+                ++_raysHit;
+        });
+    }
+    _queryLabel->setString(fmt::format("Paths: {} Rays: {}", _pathsFound, _raysHit));
+}
+
+std::string NavMeshAsyncTestDemo::title() const
+{
+    return "Navigation Mesh Test";
+}
+
+std::string NavMeshAsyncTestDemo::subtitle() const
+{
+    return "Async Update: 300 agents, tap to move them";
+}
+
+void NavMeshAsyncTestDemo::touchesEnded(const std::vector<ax::Touch*>& touches, ax::Event* event)
+{
+    if (!_needMoveAgents)
+        return;
+    if (!touches.empty())
+    {
+        auto touch = touches[0];
+        auto location = touch->getLocationInView();
+        Vec3 nearP(location.x, location.y, 0.0f), farP(location.x, location.y, 1.0f);
+
+        auto size = Director::getInstance()->getWinSize();
+        _camera->unproject(size, &nearP, &nearP);
+        _camera->unproject(size, &farP, &farP);
+
+        Physics3DWorld::HitResult result;
+        getPhysics3DWorld()->rayCast(nearP, farP, &result);
+        moveAgents(result.hitPosition);
+    }
+}
+
 #endif
@@ -120,6 +120,33 @@ protected:
     ax::Label* _debugLabel;
 };
 
+class NavMeshAsyncTestDemo : public NavMeshBaseTestDemo
+{
+public:
+    CREATE_FUNC(NavMeshAsyncTestDemo);
+    NavMeshAsyncTestDemo();
+    virtual ~NavMeshAsyncTestDemo();
+
+    // Overrides
+    virtual bool init() override;
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+    virtual void onEnter() override;
+
+protected:
+    virtual void touchesBegan(const std::vector<ax::Touch*>& touches, ax::Event* event) override{};
+    virtual void touchesMoved(const std::vector<ax::Touch*>& touches, ax::Event* event) override{};
+    virtual void touchesEnded(const std::vector<ax::Touch*>& touches, ax::Event* event) override;
+
+    void sendQueries(float dt);
+
+    ax::Label* _asyncLabel;
+    ax::Label* _queryLabel;
+    int _pathsFound;
+    int _raysHit;
+};
+
 #endif
 
 #endif
@@ -143,7 +143,9 @@ EventDispatcherTests::EventDispatcherTests()
     ADD_TEST_CASE(RegisterAndUnregisterWhileEventHanldingTest);
     ADD_TEST_CASE(WindowEventsTest);
     ADD_TEST_CASE(Issue8194);
-    ADD_TEST_CASE(Issue9898)
+    ADD_TEST_CASE(Issue9898);
+    ADD_TEST_CASE(TouchSpatialIndexTest);
+    ADD_TEST_CASE(TouchSpatialIndexMovedNodeTest);
 }
 
 std::string EventDispatcherTestDemo::title() const
@@ -1801,3 +1803,191 @@ std::string Issue9898::subtitle() const
 {
     return "Should not crash if dispatch event after remove\n event listener in callback";
 }
+
+TouchSpatialIndexTest::TouchSpatialIndexTest()
+    : _movingRow(nullptr), _statusLabel(nullptr), _touchBeganCount(0), _elapsed(0)
+{
+    auto origin = Director::getInstance()->getVisibleOrigin();
+    auto size   = Director::getInstance()->getVisibleSize();
+
+    const int columns = 40;
+    const int rows    = 25;
+    const float cellW = size.width / columns;
+    const float cellH = (size.height - 120) / rows;
+
+    auto grid = Node::create();
+    grid->setPosition(origin + Vec2(0, 60));
+    addChild(grid);
+
+    _movingRow = Node::create();
+    grid->addChild(_movingRow, 1);
+
+    for (int row = 0; row < rows; ++row)
+    {
+        // The first row moves every frame to keep the indexed bounds changing
+        auto parent = row == 0 ? _movingRow : grid;
+        for (int col = 0; col < columns; ++col)
+        {
+            auto sprite = Sprite::create("Images/CyanSquare.png");
+            sprite->setScale(std::min(cellW, cellH) * 0.8f / sprite->getContentSize().width);
+            sprite->setPosition(cellW * (col + 0.5f), cellH * (row + 0.5f));
+            parent->addChild(sprite);
+
+            auto listener = EventListenerTouchOneByOne::create();
+            listener->setSwallowTouches(true);
+            listener->setBoundedByNode(true);
+            listener->onTouchBegan = [this](Touch* touch, Event* event) {
+                ++_touchBeganCount;
+                auto target = event->getCurrentTarget();
+                auto point  = target->convertToNodeSpace(touch->getLocation());
+                Rect rect(Vec2::ZERO, target->getContentSize());
+                if (!rect.containsPoint(point))
+                    return false;
+
+                target->setColor(Color3B::MAGENTA);
+                // Bring the sprite to front, the dispatcher only moves this listener
+                target->setLocalZOrder(target->getLocalZOrder() + 1);
+                return true;
+            };
+            listener->onTouchEnded = [](Touch* touch, Event* event) {
+                event->getCurrentTarget()->setColor(Color3B::WHITE);
+            };
+            listener->onTouchCancelled = listener->onTouchEnded;
+            _eventDispatcher->addEventListenerWithSceneGraphPriority(listener, sprite);
+        }
+    }
+
+    _eventDispatcher->setTouchSpatialIndexEnabled(true);
+
+    auto toggleItem = MenuItemFont::create("Toggle spatial index", [this](Ref*) {
+        _eventDispatcher->setTouchSpatialIndexEnabled(!_eventDispatcher->isTouchSpatialIndexEnabled());
+        updateStatus();
+    });
+    toggleItem->setPosition(origin + Vec2(size.width / 2, 40));
+    auto menu = Menu::create(toggleItem, nullptr);
+    menu->setPosition(Vec2::ZERO);
+    addChild(menu, 1);
+
+    _statusLabel = Label::createWithSystemFont("", "", 16);
+    _statusLabel->setPosition(origin + Vec2(size.width / 2, 15));
+    addChild(_statusLabel, 1);
+    updateStatus();
+
+    scheduleUpdate();
+}
+
+void TouchSpatialIndexTest::onExit()
+{
+    _eventDispatcher->setTouchSpatialIndexEnabled(false);
+    EventDispatcherTestDemo::onExit();
+}
+
+void TouchSpatialIndexTest::update(float dt)
+{
+    _elapsed += dt;
+    _movingRow->setPositionX(std::sin(_elapsed) * 40);
+
+    if (_touchBeganCount > 0)
+    {
+        updateStatus();
+        _touchBeganCount = 0;
+    }
+}
+
+void TouchSpatialIndexTest::updateStatus()
+{
+    _statusLabel->setString(StringUtils::format("Spatial index: %s, listeners called by the last touch: %d",
+                                                _eventDispatcher->isTouchSpatialIndexEnabled() ? "on" : "off",
+                                                _touchBeganCount));
+}
+
+std::string TouchSpatialIndexTest::title() const
+{
+    return "Touch spatial index";
+}
+
+std::string TouchSpatialIndexTest::subtitle() const
+{
+    return "1000 touchable sprites, only the one under\nthe touch should be asked with the index on";
+}
+
+TouchSpatialIndexMovedNodeTest::TouchSpatialIndexMovedNodeTest()
+    : _sprite(nullptr), _statusLabel(nullptr), _touchBeganCount(0)
+{
+    auto origin = Director::getInstance()->getVisibleOrigin();
+    auto size   = Director::getInstance()->getVisibleSize();
+
+    auto container = Node::create();
+    addChild(container);
+
+    _sprite = Sprite::create("Images/CyanSquare.png");
+    _sprite->setPosition(origin + Vec2(size.width / 4, size.height / 2));
+    container->addChild(_sprite);
+
+    auto listener = EventListenerTouchOneByOne::create();
+    listener->setBoundedByNode(true);
+    listener->onTouchBegan = [this](Touch* touch, Event* event) {
+        ++_touchBeganCount;
+        return true;
+    };
+    _eventDispatcher->addEventListenerWithSceneGraphPriority(listener, _sprite);
+    _eventDispatcher->setTouchSpatialIndexEnabled(true);
+
+    _statusLabel = Label::createWithSystemFont("", "", 16);
+    _statusLabel->setPosition(origin + Vec2(size.width / 2, 40));
+    addChild(_statusLabel, 1);
+}
+
+void TouchSpatialIndexMovedNodeTest::onEnter()
+{
+    EventDispatcherTestDemo::onEnter();
+
+    // Wait for the bounds to be indexed by a visit, then move the sprite and its parent and touch before the next one
+    scheduleOnce(
+        [this](float) {
+            auto size = Director::getInstance()->getVisibleSize();
+            _sprite->setPositionX(_sprite->getPositionX() + size.width / 4);
+            _sprite->getParent()->setPositionY(-size.height / 4);
+
+            _touchBeganCount = 0;
+            touchAt(_sprite->getParent()->convertToWorldSpace(_sprite->getPosition()));
+            int movedCount = _touchBeganCount;
+
+            _touchBeganCount = 0;
+            touchAt(Director::getInstance()->getVisibleOrigin() + Vec2(size.width / 4, size.height / 2));
+            int oldCount = _touchBeganCount;
+
+            _statusLabel->setString(StringUtils::format("Touch on the moved sprite: %s, touch on its old place: %s",
+                                                        movedCount == 1 ? "PASS" : "FAIL",
+                                                        oldCount == 0 ? "PASS" : "FAIL"));
+        },
+        0.2f, "touch");
+}
+
+void TouchSpatialIndexMovedNodeTest::onExit()
+{
+    _eventDispatcher->setTouchSpatialIndexEnabled(false);
+    EventDispatcherTestDemo::onExit();
+}
+
+void TouchSpatialIndexMovedNodeTest::touchAt(const Vec2& location)
+{
+    auto director = Director::getInstance();
+    auto glView   = director->getOpenGLView();
+    auto point    = director->convertToUI(location);
+    float x       = point.x * glView->getScaleX() + glView->getViewPortRect().origin.x;
+    float y       = point.y * glView->getScaleY() + glView->getViewPortRect().origin.y;
+    intptr_t id   = 0;
+    glView->handleTouchesBegin(1, &id, &x, &y);
+    glView->handleTouchesEnd(1, &id, &x, &y);
+}
+
+std::string TouchSpatialIndexMovedNodeTest::title() const
+{
+    return "Touch spatial index, moved node";
+}
+
+std::string TouchSpatialIndexMovedNodeTest::subtitle() const
+{
+    return "Nodes moved since the last visit are\nlooked up at their new place";
+}
@@ -311,4 +311,45 @@ private:
     ax::EventListenerCustom* _listener;
 };
 
+class TouchSpatialIndexTest : public EventDispatcherTestDemo
+{
+public:
+    CREATE_FUNC(TouchSpatialIndexTest);
+    TouchSpatialIndexTest();
+
+    virtual void onExit() override;
+    virtual void update(float dt) override;
+
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+private:
+    void updateStatus();
+
+    ax::Node* _movingRow;
+    ax::Label* _statusLabel;
+    int _touchBeganCount;
+    float _elapsed;
+};
+
+class TouchSpatialIndexMovedNodeTest : public EventDispatcherTestDemo
+{
+public:
+    CREATE_FUNC(TouchSpatialIndexMovedNodeTest);
+    TouchSpatialIndexMovedNodeTest();
+
+    virtual void onEnter() override;
+    virtual void onExit() override;
+
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+private:
+    void touchAt(const ax::Vec2& location);
+
+    ax::Sprite* _sprite;
+    ax::Label* _statusLabel;
+    int _touchBeganCount;
+};
+
 #endif /* defined(__samples__NewEventDispatcherTest__) */
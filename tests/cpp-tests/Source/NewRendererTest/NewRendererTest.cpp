@@ -91,6 +91,8 @@ NewRendererTests::NewRendererTests()
     ADD_TEST_CASE(RendererBatchQuadTri);
     ADD_TEST_CASE(RendererUniformBatch);
     ADD_TEST_CASE(RendererUniformBatch2);
+    ADD_TEST_CASE(RendererMultiTextureBatch);
+    ADD_TEST_CASE(RendererStatsTest);
     ADD_TEST_CASE(SpriteCreation);
     ADD_TEST_CASE(NonBatchSprites);
 };
@@ -814,6 +816,127 @@ std::string RendererBatchQuadTri::subtitle() const
     return "QuadCommand and TriangleCommands are batched together";
 }
 
+//
+//
+// RendererMultiTextureBatch
+//
+
+RendererMultiTextureBatch::RendererMultiTextureBatch()
+{
+    Size s = Director::getInstance()->getWinSize();
+
+    // interleave the images, so no two neighbours share a texture
+    const char* images[] = {"Images/grossini.png", "Images/grossinis_sister1.png", "Images/grossinis_sister2.png",
+                            "Images/r1.png", "Images/b1.png"};
+
+    auto x_inc = s.width / 20;
+    auto y_inc = s.height / 8;
+
+    for (int y = 0; y < 8; ++y)
+    {
+        for (int x = 0; x < 20; ++x)
+        {
+            auto sprite = Sprite::create(images[(x + y) % AX_ARRAYSIZE(images)]);
+            sprite->setPosition(Vec2((x + 0.5f) * x_inc, (y + 0.5f) * y_inc));
+            sprite->setScale(0.4f);
+            addChild(sprite);
+        }
+    }
+
+    MenuItemFont::setFontName("fonts/arial.ttf");
+    MenuItemFont::setFontSize(24);
+    _toggleItem = MenuItemFont::create("", AX_CALLBACK_1(RendererMultiTextureBatch::toggleCallback, this));
+    _toggleItem->setColor(Color3B(0, 200, 20));
+
+    auto menu = Menu::create(_toggleItem, nullptr);
+    menu->setPosition(Vec2(s.width / 2, s.height - 110));
+    addChild(menu, 1);
+}
+
+void RendererMultiTextureBatch::onEnter()
+{
+    MultiSceneTest::onEnter();
+
+    auto renderer            = Director::getInstance()->getRenderer();
+    _wasMultiTextureBatching = renderer->isMultiTextureBatching();
+    renderer->setMultiTextureBatching(true);
+    updateToggleLabel();
+}
+
+void RendererMultiTextureBatch::onExit()
+{
+    Director::getInstance()->getRenderer()->setMultiTextureBatching(_wasMultiTextureBatching);
+
+    MultiSceneTest::onExit();
+}
+
+void RendererMultiTextureBatch::toggleCallback(Ref* /*sender*/)
+{
+    auto renderer = Director::getInstance()->getRenderer();
+    renderer->setMultiTextureBatching(!renderer->isMultiTextureBatching());
+    updateToggleLabel();
+}
+
+void RendererMultiTextureBatch::updateToggleLabel()
+{
+    auto enabled = Director::getInstance()->getRenderer()->isMultiTextureBatching();
+    _toggleItem->setString(enabled ? "Multi-texture batching: ON" : "Multi-texture batching: OFF");
+}
+
+std::string RendererMultiTextureBatch::title() const
+{
+    return "RendererMultiTextureBatch";
+}
+
+std::string RendererMultiTextureBatch::subtitle() const
+{
+    return "Sprites of 5 textures share draw calls, compare the stats";
+}
+
+//
+// RendererStatsTest
+//
+
+RendererStatsTest::RendererStatsTest()
+{
+    Size s = Director::getInstance()->getWinSize();
+
+    // the textures change every few sprites to break the batches, a third of the sprites are off screen
+    const char* images[] = {"Images/grossini.png", "Images/grossinis_sister1.png", "Images/grossinis_sister2.png"};
+    for (int i = 0; i < 300; ++i)
+    {
+        auto sprite = Sprite::create(images[(i / 10) % AX_ARRAYSIZE(images)]);
+        sprite->setPosition(Vec2(AXRANDOM_0_1() * s.width * 1.5f, AXRANDOM_0_1() * s.height));
+        sprite->setScale(0.3f);
+        sprite->runAction(RepeatForever::create(RotateBy::create(2.0f, 360.0f)));
+        addChild(sprite);
+    }
+
+    _statsLabel = Label::createWithTTF("", "fonts/Courier New.ttf", 9);
+    _statsLabel->setAnchorPoint(Vec2(0.0f, 1.0f));
+    _statsLabel->setPosition(Vec2(10.0f, s.height - 80.0f));
+    _statsLabel->setTextColor(Color4B::YELLOW);
+    _statsLabel->enableOutline(Color4B::BLACK, 1);
+    addChild(_statsLabel, 1);
+
+    schedule(AX_SCHEDULE_SELECTOR(RendererStatsTest::updateStats), 0.5f);
+}
+
+void RendererStatsTest::updateStats(float /*dt*/)
+{
+    _statsLabel->setString(Director::getInstance()->getRenderer()->getStatsReport());
+}
+
+std::string RendererStatsTest::title() const
+{
+    return "RendererStatsTest";
+}
+
+std::string RendererStatsTest::subtitle() const
+{
+    return "Render statistics of the last frames, also printed by the console command 'renderer'";
+}
+
 //
 //
 // RendererUniformBatch
@@ -242,6 +242,41 @@ protected:
     ax::backend::ProgramState* createSepiaProgramState();
 };
 
+class RendererMultiTextureBatch : public MultiSceneTest
+{
+public:
+    CREATE_FUNC(RendererMultiTextureBatch);
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+    virtual void onEnter() override;
+    virtual void onExit() override;
+
+protected:
+    RendererMultiTextureBatch();
+
+    void toggleCallback(ax::Ref* sender);
+    void updateToggleLabel();
+
+    ax::MenuItemFont* _toggleItem = nullptr;
+    bool _wasMultiTextureBatching = false;
+};
+
+class RendererStatsTest : public MultiSceneTest
+{
+public:
+    CREATE_FUNC(RendererStatsTest);
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+protected:
+    RendererStatsTest();
+
+    void updateStats(float dt);
+
+    ax::Label* _statsLabel = nullptr;
+};
+
 class NonBatchSprites : public MultiSceneTest
 {
 public:
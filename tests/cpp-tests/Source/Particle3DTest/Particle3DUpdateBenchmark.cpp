@@ -0,0 +1,310 @@
+/****************************************************************************
+ Copyright (c) 2022 Bytedance Inc.
+
+ https://axmolengine.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+/*
+ * Headless update benchmark for the PU particle system.
+ *
+ * Loads the scripts of the cpp-tests Particle3D samples with the renderers detached, so no GL view is created and
+ * only the simulation is timed, then runs a few systems built in code that keep a full pool of particles, to time the
+ * affector kernels. The systems are never added to a scene, the benchmark updates them and their techniques itself.
+ * Each system is warmed up first, then every update is timed on its own.
+ *
+ * usage: particle3d_benchmark [updates] [-r content] [-v]
+ *   updates     number of timed updates per system, 600 by default
+ *   -r content  the cpp-tests Content folder, the one of the source tree by default
+ *   -v          also print the time of every update
+ */
+
+#include "platform/FileUtils.h"
+#include "Particle3D/PU/PUParticleSystem3D.h"
+#include "Particle3D/PU/PUTranslateManager.h"
+#include "Particle3D/PU/PUBoxEmitter.h"
+#include "Particle3D/PU/PUColorAffector.h"
+#include "Particle3D/PU/PUDynamicAttribute.h"
+#include "Particle3D/PU/PUGravityAffector.h"
+#include "Particle3D/PU/PULinearForceAffector.h"
+#include "Particle3D/PU/PURandomiser.h"
+#include "Particle3D/PU/PUScaleAffector.h"
+#include "Particle3D/PU/PUSineForceAffector.h"
+#include "Particle3D/PU/PUVortexAffector.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifndef AX_PARTICLE3D_BENCHMARK_CONTENT
+#    define AX_PARTICLE3D_BENCHMARK_CONTENT "Content"
+#endif
+
+USING_NS_AX;
+
+static const unsigned int PARTICLE_QUOTA = 4000;
+static const int WARMUP_UPDATES          = 180;
+static const float UPDATE_DELTA          = 1.0f / 60.0f;
+
+enum BenchmarkAffector
+{
+    LINEAR_FORCE = 1 << 0,
+    GRAVITY      = 1 << 1,
+    SINE_FORCE   = 1 << 2,
+    VORTEX       = 1 << 3,
+    SCALE        = 1 << 4,
+    COLOR        = 1 << 5,
+    RANDOMISER   = 1 << 6,  // has no span support, the whole system falls back to per particle updates
+};
+
+struct BenchmarkScenario
+{
+    const char* name;
+    int affectors;
+};
+
+// the scripts of the cpp-tests Particle3D samples, with the material file they load
+struct BenchmarkSample
+{
+    const char* script;
+    const char* material;
+    float scale;
+};
+
+static PUDynamicAttribute* createFixedAttribute(float value)
+{
+    auto attribute = new PUDynamicAttributeFixed();
+    attribute->setValue(value);
+    return attribute;
+}
+
+static PUParticleSystem3D* createParticleSystem(int affectors)
+{
+    auto system = PUParticleSystem3D::create();
+    system->setParticleQuota(PARTICLE_QUOTA);
+
+    // emits more than the quota allows, so the pool stays full once warmed up
+    auto emitter = CCPUBoxEmitter::create();
+    emitter->setWidth(100.0f);
+    emitter->setHeight(100.0f);
+    emitter->setDepth(100.0f);
+    emitter->setDynEmissionRate(createFixedAttribute(PARTICLE_QUOTA));
+    emitter->setDynTotalTimeToLive(createFixedAttribute(2.0f));
+    emitter->setDynVelocity(createFixedAttribute(50.0f));
+    emitter->setDynAngle(createFixedAttribute(30.0f));
+    system->addEmitter(emitter);
+
+    if (affectors & LINEAR_FORCE)
+    {
+        auto affector = PULinearForceAffector::create();
+        affector->setForceVector(Vec3(10.0f, 0.0f, 0.0f));
+        system->addAffector(affector);
+    }
+    if (affectors & GRAVITY)
+    {
+        auto affector = PUGravityAffector::create();
+        affector->setGravity(500.0f);
+        system->addAffector(affector);
+    }
+    if (affectors & SINE_FORCE)
+    {
+        auto affector = PUSineForceAffector::create();
+        affector->setForceVector(Vec3(0.0f, 20.0f, 0.0f));
+        affector->setFrequencyMin(1.0f);
+        affector->setFrequencyMax(4.0f);
+        system->addAffector(affector);
+    }
+    if (affectors & VORTEX)
+    {
+        auto affector = PUVortexAffector::create();
+        affector->setRotationVector(Vec3(0.0f, 1.0f, 0.0f));
+        affector->setRotationSpeed(createFixedAttribute(2.0f));
+        system->addAffector(affector);
+    }
+    if (affectors & SCALE)
+    {
+        auto affector = PUScaleAffector::create();
+        affector->setDynScaleXYZ(createFixedAttribute(5.0f));
+        system->addAffector(affector);
+    }
+    if (affectors & COLOR)
+    {
+        auto affector = PUColorAffector::create();
+        affector->addColor(0.0f, Vec4(1.0f, 1.0f, 1.0f, 1.0f));
+        affector->addColor(0.5f, Vec4(1.0f, 0.5f, 0.0f, 1.0f));
+        affector->addColor(1.0f, Vec4(1.0f, 0.0f, 0.0f, 0.0f));
+        system->addAffector(affector);
+    }
+    if (affectors & RANDOMISER)
+    {
+        auto affector = PURandomiser::create();
+        affector->setMaxDeviationX(5.0f);
+        affector->setMaxDeviationY(5.0f);
+        affector->setMaxDeviationZ(5.0f);
+        system->addAffector(affector);
+    }
+
+    return system;
+}
+
+static double percentile(const std::vector<double>& sorted, double fraction)
+{
+    auto index = static_cast<size_t>(fraction * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+// the samples are a root system holding one system per technique, each updated on its own by the scheduler
+static void updateSystem(Node* node, float delta)
+{
+    if (auto system = dynamic_cast<PUParticleSystem3D*>(node))
+        system->update(delta);
+    for (auto&& child : node->getChildren())
+        updateSystem(child, delta);
+}
+
+static int getAliveParticleCount(Node* node)
+{
+    int count = 0;
+    if (auto system = dynamic_cast<PUParticleSystem3D*>(node))
+        count += system->getAliveParticleCount();
+    for (auto&& child : node->getChildren())
+        count += getAliveParticleCount(child);
+    return count;
+}
+
+static void runSystem(const char* name, PUParticleSystem3D* system, int updates, bool verbose)
+{
+    system->retain();
+    system->startParticleSystem();
+
+    for (int i = 0; i < WARMUP_UPDATES; ++i)
+        updateSystem(system, UPDATE_DELTA);
+
+    std::vector<double> timings;
+    timings.reserve(updates);
+    int minAlive = getAliveParticleCount(system);
+    int maxAlive = minAlive;
+    for (int i = 0; i < updates; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        updateSystem(system, UPDATE_DELTA);
+        auto us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        timings.emplace_back(us);
+
+        int alive = getAliveParticleCount(system);
+        minAlive  = std::min(minAlive, alive);
+        maxAlive  = std::max(maxAlive, alive);
+        if (verbose)
+            printf("  %-32s update %4d: %9.2f us, %d particles\n", name, i, us, alive);
+    }
+
+    system->stopParticleSystem();
+    system->release();
+
+    double total = 0.0;
+    for (auto&& us : timings)
+        total += us;
+    std::sort(timings.begin(), timings.end());
+
+    printf("%-32s %5d-%-5d %9.2f %9.2f %9.2f %9.2f %9.2f %9.3f\n", name, minAlive, maxAlive, total / timings.size(),
+           timings.front(), percentile(timings, 0.5), percentile(timings, 0.95), timings.back(),
+           maxAlive > 0 ? total / timings.size() * 1000.0 / maxAlive : 0.0);
+}
+
+static void printHeader(const char* title, int updates)
+{
+    printf("\n%s: %d updates of %.4f s per system, %d warm-up updates\n", title, updates, UPDATE_DELTA,
+           WARMUP_UPDATES);
+    printf("%-32s %11s %9s %9s %9s %9s %9s %9s\n", "system", "particles", "mean us", "min us", "p50 us", "p95 us",
+           "max us", "ns/part");
+}
+
+int main(int argc, char** argv)
+{
+    int updates         = 600;
+    bool verbose        = false;
+    std::string content = AX_PARTICLE3D_BENCHMARK_CONTENT;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "-v") == 0)
+            verbose = true;
+        else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc)
+            content = argv[++i];
+        else
+            updates = std::max(1, atoi(argv[i]));
+    }
+
+    // the search paths of Particle3DTest, the scripts load without a GL context once the renderers are detached
+    auto fileUtils = FileUtils::getInstance();
+    fileUtils->addSearchPath(content);
+    fileUtils->addSearchPath(content + "/Particle3D/materials");
+    fileUtils->addSearchPath(content + "/Particle3D/scripts");
+    PUTranslateManager::Instance()->setRenderersDetached(true);
+
+    static const BenchmarkSample samples[] = {
+        {"advancedLodSystem.pu", nullptr, 1.0f},
+        {"blackHole.pu", "pu_mediapack_01.material", 1.0f},
+        {"hypno.pu", "pu_mediapack_01.material", 1.0f},
+        {"timeShift.pu", "pu_mediapack_01.material", 2.0f},
+        {"UVAnimation.pu", "pu_mediapack_01.material", 1.0f},
+        {"mp_torch.pu", "pu_mediapack_01.material", 5.0f},
+        {"lineStreak.pu", "pu_mediapack_01.material", 5.0f},
+        {"electricBeamSystem.pu", nullptr, 1.0f},
+        {"flareShield.pu", nullptr, 1.0f},
+        {"lightningBolt.pu", nullptr, 1.0f},
+        {"explosionSystem.pu", nullptr, 1.0f},
+        {"canOfWorms.pu", nullptr, 1.0f},
+        {"ribbonTrailTest.pu", nullptr, 1.0f},
+        {"weaponTrail.pu", nullptr, 1.0f},
+    };
+
+    printHeader("Particle3D samples", updates);
+    for (auto&& sample : samples)
+    {
+        auto system = sample.material ? PUParticleSystem3D::create(sample.script, sample.material)
+                                      : PUParticleSystem3D::create(sample.script);
+        if (!system)
+        {
+            printf("%-32s failed to load from %s\n", sample.script, content.c_str());
+            continue;
+        }
+        system->setScale(sample.scale);
+        runSystem(sample.script, system, updates, verbose);
+    }
+
+    static const BenchmarkScenario scenarios[] = {
+        {"emitter only", 0},
+        {"linear force + gravity", LINEAR_FORCE | GRAVITY},
+        {"sine force + vortex", SINE_FORCE | VORTEX},
+        {"scale + color", SCALE | COLOR},
+        {"all span affectors", LINEAR_FORCE | GRAVITY | SINE_FORCE | VORTEX | SCALE | COLOR},
+        {"all + randomiser (per particle)", LINEAR_FORCE | GRAVITY | SINE_FORCE | VORTEX | SCALE | COLOR | RANDOMISER},
+    };
+
+    printHeader("full pools", updates);
+    for (auto&& scenario : scenarios)
+        runSystem(scenario.name, createParticleSystem(scenario.affectors), updates, verbose);
+
+    return 0;
+}
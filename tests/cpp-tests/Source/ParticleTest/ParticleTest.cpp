@@ -839,6 +839,52 @@ std::string DemoSimulation::subtitle() const
     return "Particle simulation, particle system should advance 3 seconds in at the start";
 }
 
+//------------------------------------------------------------------
+//
+// DemoSeek
+//
+//------------------------------------------------------------------
+void DemoSeek::onEnter()
+{
+    ParticleDemo::onEnter();
+
+    _color->setColor(Color3B::BLACK);
+    removeChild(_background, true);
+    _background = nullptr;
+
+    auto s = Director::getInstance()->getWinSize();
+
+    // two systems with the same seed, seeked to the same time in 10 large steps, draw the same particles
+    _emitter = ParticleFireworks::create();
+    _emitter->retain();
+    _emitter->setTexture(Director::getInstance()->getTextureCache()->addImage(s_stars1));
+    _emitter->setPositionType(ParticleSystem::PositionType::GROUPED);
+    _emitter->setPosition(Vec2(s.width / 3, s.height / 2));
+    _emitter->setSeed(1234);
+    addChild(_emitter, 10);
+
+    _twin = ParticleFireworks::create();
+    _twin->setTexture(_emitter->getTexture());
+    _twin->setPositionType(ParticleSystem::PositionType::GROUPED);
+    _twin->setPosition(Vec2(s.width * 2 / 3, s.height / 2));
+    _twin->setSeed(1234);
+    addChild(_twin, 10);
+
+    replay(0);
+    schedule(AX_SCHEDULE_SELECTOR(DemoSeek::replay), 2.0F);
+}
+
+void DemoSeek::replay(float /*dt*/)
+{
+    _emitter->seek(3.0F, 10.0F);
+    _twin->seek(3.0F, 10.0F);
+}
+
+std::string DemoSeek::subtitle() const
+{
+    return "Both systems should be identical, and replay the same 3s state every 2s";
+}
+
 //------------------------------------------------------------------
 //
 // DemoSpawnRotation
@@ -2172,6 +2218,7 @@ ParticleTests::ParticleTests()
     ADD_TEST_CASE(DemoFixedFPS);
     ADD_TEST_CASE(DemoTimeScale);
     ADD_TEST_CASE(DemoSimulation);
+    ADD_TEST_CASE(DemoSeek);
     ADD_TEST_CASE(DemoSpawnFadeIn);
     ADD_TEST_CASE(DemoScaleFadeIn);
     ADD_TEST_CASE(DemoSpawnRotation);
@@ -2216,6 +2263,7 @@ ParticleTests::ParticleTests()
 
     ADD_TEST_CASE(ParticleIssue12310);
     ADD_TEST_CASE(ParticleSpriteFrame);
+    ADD_TEST_CASE(ParticleParallelUpdate);
 }
 
 ParticleDemo::~ParticleDemo()
@@ -3246,3 +3294,116 @@ std::string ParticleSpriteFrame::subtitle() const
 {
     return "Should not use entire texture atlas";
 }
+
+//
+// ParticleParallelUpdate
+//
+#define NUM_PARALLEL_EMITTERS 120
+
+void ParticleParallelUpdate::onEnter()
+{
+    ParticleDemo::onEnter();
+
+    _color->setColor(Color3B::BLACK);
+    removeChild(_background, true);
+    _background = nullptr;
+
+    Size s = Director::getInstance()->getWinSize();
+
+    // 120 emitters of 250 particles, half of them in a batch node, so both ways of drawing are covered
+    auto batchNode = ParticleBatchNode::createWithTexture(nullptr, NUM_PARALLEL_EMITTERS / 2 * 250);
+    addChild(batchNode, 1, 2);
+
+    for (int i = 0; i < NUM_PARALLEL_EMITTERS; i++)
+    {
+        auto particleSystem = ParticleSystemQuad::create("Particles/SpinningPeas.plist");
+        particleSystem->setTotalParticles(250);
+        particleSystem->setPosition(Vec2((i % 12 + 0.5f) * s.width / 12, (i / 12 + 0.5f) * s.height / 10));
+        particleSystem->setParallelUpdateEnabled(_parallelUpdate);
+        if (i % 2)
+        {
+            particleSystem->setPositionType(ParticleSystem::PositionType::GROUPED);
+            batchNode->setTexture(particleSystem->getTexture());
+            batchNode->addChild(particleSystem);
+        }
+        else
+        {
+            addChild(particleSystem, 1);
+        }
+    }
+
+    _emitter = nullptr;
+
+    MenuItemFont::setFontSize(18);
+    _toggleItem =
+        MenuItemFont::create("Parallel update: on", AX_CALLBACK_1(ParticleParallelUpdate::toggleParallelUpdate, this));
+    auto menu = Menu::create(_toggleItem, nullptr);
+    menu->setPosition(Vec2(s.width / 2, s.height - 90));
+    addChild(menu, 10);
+
+    _statsLabel = Label::createWithTTF("", "fonts/arial.ttf", 14);
+    _statsLabel->setPosition(Vec2(s.width / 2, s.height - 115));
+    addChild(_statsLabel, 10);
+
+    // Measures update, the parallel pass and visit, which is where the particles spend their CPU time.
+    _beforeUpdateListener = _eventDispatcher->addCustomEventListener(
+        Director::EVENT_BEFORE_UPDATE, [this](EventCustom*) { _frameStart = std::chrono::steady_clock::now(); });
+    _afterVisitListener = _eventDispatcher->addCustomEventListener(Director::EVENT_AFTER_VISIT, [this](EventCustom*) {
+        _frameTime += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - _frameStart).count();
+        if (++_frameCount == 60)
+        {
+            _statsLabel->setString(StringUtils::format("update + visit: %.2f ms/frame", _frameTime / _frameCount));
+            _frameTime  = 0;
+            _frameCount = 0;
+        }
+    });
+}
+
+void ParticleParallelUpdate::onExit()
+{
+    _eventDispatcher->removeEventListener(_beforeUpdateListener);
+    _eventDispatcher->removeEventListener(_afterVisitListener);
+    ParticleDemo::onExit();
+}
+
+void ParticleParallelUpdate::update(float dt)
+{
+    auto atlas = (LabelAtlas*)getChildByTag(kTagParticleCount);
+
+    int count = 0;
+    for (const auto& child : _children)
+    {
+        if (auto item = dynamic_cast<ParticleSystem*>(child))
+            count += item->getParticleCount();
+    }
+    for (const auto& child : getChildByTag(2)->getChildren())
+    {
+        if (auto item = dynamic_cast<ParticleSystem*>(child))
+            count += item->getParticleCount();
+    }
+
+    char str[50] = {0};
+    sprintf(str, "%4d", count);
+    atlas->setString(str);
+}
+
+void ParticleParallelUpdate::toggleParallelUpdate(Ref* sender)
+{
+    _parallelUpdate = !_parallelUpdate;
+    for (auto&& system : ParticleSystem::getAllParticleSystems())
+        system->setParallelUpdateEnabled(_parallelUpdate);
+    _toggleItem->setString(_parallelUpdate ? "Parallel update: on" : "Parallel update: off");
+    _frameTime  = 0;
+    _frameCount = 0;
+}
+
+std::string ParticleParallelUpdate::title() const
+{
+    return "Parallel update";
+}
+
+std::string ParticleParallelUpdate::subtitle() const
+{
+    return StringUtils::format("%d emitters, %d workers", NUM_PARALLEL_EMITTERS,
+                               JobSystem::getInstance()->getWorkerCount());
+}
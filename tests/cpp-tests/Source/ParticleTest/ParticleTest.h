@@ -27,6 +27,8 @@
 
 #include "../BaseTest.h"
 
+#include <chrono>
+
 DEFINE_TEST_SUITE(ParticleTests);
 
 class ParticleDemo : public TestCase
@@ -225,6 +227,18 @@ public:
     virtual std::string subtitle() const override;
 };
 
+class DemoSeek : public ParticleDemo
+{
+public:
+    CREATE_FUNC(DemoSeek);
+    virtual void onEnter() override;
+    virtual std::string subtitle() const override;
+    void replay(float dt);
+
+private:
+    ax::ParticleSystemQuad* _twin = nullptr;
+};
+
 class DemoSpawnRotation : public ParticleDemo
 {
 public:
@@ -643,4 +657,27 @@ public:
     virtual std::string subtitle() const override;
 };
 
+class ParticleParallelUpdate : public ParticleDemo
+{
+public:
+    CREATE_FUNC(ParticleParallelUpdate);
+    virtual void onEnter() override;
+    virtual void onExit() override;
+    virtual void update(float dt) override;
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+    void toggleParallelUpdate(ax::Ref* sender);
+
+private:
+    bool _parallelUpdate                           = true;
+    ax::MenuItemFont* _toggleItem                  = nullptr;
+    ax::Label* _statsLabel                         = nullptr;
+    ax::EventListenerCustom* _beforeUpdateListener = nullptr;
+    ax::EventListenerCustom* _afterVisitListener   = nullptr;
+    std::chrono::steady_clock::time_point _frameStart;
+    double _frameTime = 0;
+    int _frameCount   = 0;
+};
+
 #endif
@@ -31,6 +31,7 @@
 #include "3d/Bundle3D.h"
 #include "physics3d/Physics3D.h"
 #include "extensions/Particle3D/PU/PUParticleSystem3D.h"
+#include "base/format.h"
 USING_NS_AX_EXT;
 USING_NS_AX;
 
@@ -65,6 +66,7 @@ Physics3DTests::Physics3DTests()
     ADD_TEST_CASE(Physics3DCollisionCallbackDemo);
     ADD_TEST_CASE(Physics3DColliderDemo);
     ADD_TEST_CASE(Physics3DTerrainDemo);
+    ADD_TEST_CASE(Physics3DBenchmarkDemo);
 #endif
 };
 
@@ -882,4 +884,84 @@ bool Physics3DColliderDemo::init()
     return true;
 }
 
+static bool s_benchmarkMultiThreaded = true;
+
+std::string Physics3DBenchmarkDemo::subtitle() const
+{
+    return "Physics3D Benchmark";
+}
+
+bool Physics3DBenchmarkDemo::init()
+{
+    if (!Physics3DTestDemo::init())
+        return false;
+
+    Physics3DWorldDes info;
+    info.isMultiThreadingEnabled = s_benchmarkMultiThreaded;
+    setPhysics3DWorld(Physics3DWorld::create(&info));
+
+    // create floor
+    Physics3DRigidBodyDes rbDes;
+    rbDes.mass  = 0.0f;
+    rbDes.shape = Physics3DShape::createBox(Vec3(60.0f, 1.0f, 60.0f));
+
+    auto floor = PhysicsMeshRenderer::create("MeshRendererTest/box.c3t", &rbDes);
+    floor->setTexture("MeshRendererTest/plane.png");
+    floor->setScaleX(60);
+    floor->setScaleZ(60);
+    this->addChild(floor);
+    floor->setCameraMask((unsigned short)CameraFlag::USER1);
+    floor->syncNodeToPhysics();
+    floor->setSyncFlag(Physics3DComponent::PhysicsSyncFlag::NONE);
+
+    // a few thousand boxes dropped in slightly shifted layers so the stacks collapse
+    const int sizeX = 16, sizeY = 8, sizeZ = 16;
+    rbDes.mass  = 1.f;
+    rbDes.shape = Physics3DShape::createBox(Vec3(0.8f, 0.8f, 0.8f));
+    for (int k = 0; k < sizeY; k++)
+    {
+        for (int i = 0; i < sizeX; i++)
+        {
+            for (int j = 0; j < sizeZ; j++)
+            {
+                float x = 1.5f * (i - sizeX / 2) + 0.3f * (k % 2);
+                float y = 2.0f + 1.5f * k;
+                float z = 1.5f * (j - sizeZ / 2) + 0.3f * (k % 2);
+
+                auto mesh = PhysicsMeshRenderer::create("MeshRendererTest/box.c3t", &rbDes);
+                mesh->setTexture((i + j + k) % 2 ? "Images/CyanSquare.png" : "Images/Icon.png");
+                mesh->setPosition3D(Vec3(x, y, z));
+                mesh->syncNodeToPhysics();
+                mesh->setSyncFlag(Physics3DComponent::PhysicsSyncFlag::PHYSICS_TO_NODE);
+                mesh->setCameraMask((unsigned short)CameraFlag::USER1);
+                mesh->setScale(0.8f);
+                this->addChild(mesh);
+            }
+        }
+    }
+
+    // the world falls back to stepping on the main thread when bullet is built without AX_WITH_BULLET_THREADSAFE
+    const char* mode = "single threaded";
+    if (getPhysics3DWorld()->isMultiThreadingEnabled())
+        mode = "multithreaded";
+    else if (s_benchmarkMultiThreaded)
+        mode = "single threaded, bullet is not thread safe";
+
+    TTFConfig ttfConfig("fonts/arial.ttf", 10);
+    auto label    = Label::createWithTTF(ttfConfig, fmt::format("{} bodies, {}", sizeX * sizeY * sizeZ, mode));
+    auto menuItem = MenuItemLabel::create(label, [this](Ref* /*ref*/) {
+        s_benchmarkMultiThreaded = !s_benchmarkMultiThreaded;
+        getTestSuite()->restartCurrTest();
+    });
+    auto menu = Menu::create(menuItem, nullptr);
+    menu->setPosition(Vec2::ZERO);
+    menuItem->setAnchorPoint(Vec2::ANCHOR_TOP_LEFT);
+    menuItem->setPosition(Vec2(VisibleRect::left().x, VisibleRect::top().y - 70));
+    this->addChild(menu);
+
+    physicsScene->setPhysics3DDebugCamera(_camera);
+
+    return true;
+}
+
 #endif
@@ -158,6 +158,18 @@ public:
 private:
 };
 
+class Physics3DBenchmarkDemo : public Physics3DTestDemo
+{
+public:
+    CREATE_FUNC(Physics3DBenchmarkDemo);
+    Physics3DBenchmarkDemo(){};
+    virtual ~Physics3DBenchmarkDemo(){};
+
+    virtual std::string subtitle() const override;
+
+    virtual bool init() override;
+};
+
 #endif
 
 #endif
@@ -52,6 +52,7 @@ PhysicsTests::PhysicsTests()
     ADD_TEST_CASE(PhysicsTransformTest);
     ADD_TEST_CASE(PhysicsIssue9959);
     ADD_TEST_CASE(PhysicsIssue15932);
+    ADD_TEST_CASE(PhysicsDeepTreeTest);
 }
 
 namespace
@@ -1958,4 +1959,47 @@ std::string PhysicsIssue15932::subtitle() const
     return "addComponent()/removeComponent() should not crash";
 }
 
+//
+void PhysicsDeepTreeTest::onEnter()
+{
+    PhysicsDemo::onEnter();
+
+    // a deep chain of containers, only the leaves carry bodies
+    Node* parent = this;
+    for (int depth = 0; depth < 24; ++depth)
+    {
+        auto container = Node::create();
+        parent->addChild(container);
+        parent = container;
+
+        // decorations without bodies, the sync never visits them
+        for (int i = 0; i < 40; ++i)
+            container->addChild(Node::create());
+    }
+
+    auto wall = Node::create();
+    wall->addComponent(
+        PhysicsBody::createEdgeBox(VisibleRect::getVisibleRect().size, PhysicsMaterial(0.1f, 0.5f, 0.5f)));
+    wall->setPosition(VisibleRect::center());
+    parent->addChild(wall);
+
+    const auto& rect = VisibleRect::getVisibleRect();
+    for (int i = 0; i < 5000; ++i)
+    {
+        Vec2 point(rect.origin.x + 10 + AXRANDOM_0_1() * (rect.size.width - 20),
+                   rect.origin.y + 10 + AXRANDOM_0_1() * (rect.size.height - 20));
+        parent->addChild(makeBall(point, 2));
+    }
+}
+
+std::string PhysicsDeepTreeTest::title() const
+{
+    return "Deep Tree";
+}
+
+std::string PhysicsDeepTreeTest::subtitle() const
+{
+    return "5000 bodies 24 levels down, only their nodes are synced";
+}
+
 #endif
@@ -308,4 +308,14 @@ public:
     virtual std::string subtitle() const override;
 };
 
+class PhysicsDeepTreeTest : public PhysicsDemo
+{
+public:
+    CREATE_FUNC(PhysicsDeepTreeTest);
+
+    void onEnter() override;
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+};
+
 #endif  // #if AX_USE_PHYSICS
\ No newline at end of file
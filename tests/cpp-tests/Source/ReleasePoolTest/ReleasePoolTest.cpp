@@ -29,6 +29,7 @@ USING_NS_AX;
 ReleasePoolTests::ReleasePoolTests()
 {
     ADD_TEST_CASE(ReleasePoolTest);
+    ADD_TEST_CASE(RefAllocatorTest);
 }
 
 class TestObject : public Ref
@@ -113,3 +114,64 @@ bool ReleasePoolTest::init()
 
     return true;
 }
+
+//
+// RefAllocatorTest
+//
+
+bool RefAllocatorTest::init()
+{
+    if (!TestCase::init())
+    {
+        return false;
+    }
+
+    _report = Label::createWithTTF("", "fonts/arial.ttf", 12);
+    _report->setAnchorPoint(Vec2(0.0f, 1.0f));
+    _report->setPosition(Vec2(VisibleRect::left().x + 20, VisibleRect::top().y - 80));
+    addChild(_report);
+
+    return true;
+}
+
+void RefAllocatorTest::onEnter()
+{
+    TestCase::onEnter();
+
+    _wasTracking = RefAllocator::isTrackingEnabled();
+    if (RefAllocator::isAvailable())
+        RefAllocator::setTrackingEnabled(true);
+    scheduleUpdate();
+}
+
+void RefAllocatorTest::onExit()
+{
+    if (RefAllocator::isAvailable())
+        RefAllocator::setTrackingEnabled(_wasTracking);
+    TestCase::onExit();
+}
+
+void RefAllocatorTest::update(float dt)
+{
+    // churn short lived objects, the kind of load the size class pools are meant for
+    auto size = VisibleRect::getVisibleRect().size;
+    for (int i = 0; i < 100; ++i)
+    {
+        auto sprite = Sprite::create("Images/grossini.png");
+        sprite->setPosition(Vec2(AXRANDOM_0_1() * size.width, AXRANDOM_0_1() * size.height));
+        sprite->runAction(Sequence::create(FadeOut::create(0.1f), RemoveSelf::create(), nullptr));
+        addChild(sprite, -1);
+    }
+
+    _report->setString(RefAllocator::getDiagnostics(8));
+}
+
+std::string RefAllocatorTest::title() const
+{
+    return "Ref allocator";
+}
+
+std::string RefAllocatorTest::subtitle() const
+{
+    return "Creates 100 sprites per frame, needs AX_ENABLE_REF_POOL";
+}
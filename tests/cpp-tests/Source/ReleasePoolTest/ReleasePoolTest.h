@@ -41,4 +41,22 @@ public:
 private:
 };
 
+class RefAllocatorTest : public TestCase
+{
+public:
+    CREATE_FUNC(RefAllocatorTest);
+
+    virtual bool init() override;
+    virtual void onEnter() override;
+    virtual void onExit() override;
+    virtual void update(float dt) override;
+
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+private:
+    ax::Label* _report = nullptr;
+    bool _wasTracking  = false;
+};
+
 #endif  // __RELEASE_POOL_TEST_H__
@@ -24,12 +24,18 @@
 
 #include "SceneTest.h"
 #include "../testResource.h"
+#include "cocostudio/ActionTimeline/CSLoader.h"
+#include "base/format.h"
+
+#include <chrono>
 
 USING_NS_AX;
 
 SceneTests::SceneTests()
 {
     ADD_TEST_CASE(SceneTestScene);
+    ADD_TEST_CASE(SceneIncrementalLoadTest);
+    ADD_TEST_CASE(SceneCsbPrototypeCacheTest);
 }
 
 //------------------------------------------------------------------
@@ -266,3 +272,181 @@ SceneTestScene* SceneTestScene::create(int testIndex /* = 1 */)
 
     return scene;
 }
+
+//------------------------------------------------------------------
+//
+// SceneIncrementalLoadTest
+//
+//------------------------------------------------------------------
+static double currentSeconds()
+{
+    using namespace std::chrono;
+    return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
+
+void SceneIncrementalLoadTest::onEnter()
+{
+    TestCase::onEnter();
+
+    _progress = Label::createWithTTF("", "fonts/arial.ttf", 14);
+    _progress->setPosition(VisibleRect::center() + Vec2(0, 80));
+    addChild(_progress, 1);
+
+    auto item = MenuItemFont::create("Load again", AX_CALLBACK_1(SceneIncrementalLoadTest::startLoading, this));
+    item->setFontSizeObj(18);
+    auto menu = Menu::create(item, nullptr);
+    menu->setPosition(VisibleRect::bottom() + Vec2(0, 60));
+    addChild(menu, 1);
+
+    startLoading(nullptr);
+}
+
+void SceneIncrementalLoadTest::onExit()
+{
+    cancelLoading();
+    TestCase::onExit();
+}
+
+void SceneIncrementalLoadTest::cancelLoading()
+{
+    if (_spritesLoader)
+        _spritesLoader->cancel();
+    if (_csbLoader)
+        _csbLoader->cancel();
+    _spritesLoader = nullptr;
+    _csbLoader     = nullptr;
+}
+
+void SceneIncrementalLoadTest::startLoading(Ref* sender)
+{
+    cancelLoading();
+    if (_content)
+        _content->removeFromParent();
+
+    _content = Node::create();
+    addChild(_content);
+    _startTime = currentSeconds();
+
+    // a few thousand sprites, built without blocking the frame and shown only once complete
+    _spritesLoader = IncrementalLoader::create();
+    _spritesLoader->addTexture(s_pathGrossini);
+    _spritesLoader->addSpriteFrames("animations/grossini.plist");
+    _spritesLoader->addStep([this]() { _spritesLoader->setNode(Node::create()); });
+    for (int i = 0; i < 3000; ++i)
+    {
+        _spritesLoader->addStep([this, i]() {
+            auto frameName = fmt::format("grossini_dance_{:02d}.png", i % 14 + 1);
+            auto sprite    = (i % 2) ? Sprite::create(s_pathGrossini) : Sprite::createWithSpriteFrameName(frameName);
+            sprite->setPosition(VisibleRect::left() + Vec2(AXRANDOM_0_1() * VisibleRect::getVisibleRect().size.width,
+                                                          AXRANDOM_MINUS1_1() * 100));
+            sprite->setScale(0.3f);
+            _spritesLoader->getNode()->addChild(sprite);
+        });
+    }
+    _spritesLoader->setParent(_content);
+
+    _csbLoader = IncrementalLoader::create();
+    CSLoader::createNodeAsync("ActionTimeline/DemoPlayer.csb", _csbLoader);
+    _csbLoader->setCompletionCallback([](Node* node) {
+        if (node)
+            node->setPosition(VisibleRect::center() + Vec2(0, -100));
+    });
+    _csbLoader->setParent(_content);
+
+    _spritesLoader->setProgressCallback([this](float progress) {
+        _progress->setString(fmt::format("Loading {:.0f}%, {} frames", progress * 100,
+                                         _spritesLoader->getFrameCount()));
+    });
+    _spritesLoader->setCompletionCallback([this](Node*) {
+        _progress->setString(fmt::format("Loaded in {:.0f} ms over {} frames", (currentSeconds() - _startTime) * 1000,
+                                         _spritesLoader->getFrameCount()));
+    });
+
+    _spritesLoader->start();
+    _csbLoader->start();
+}
+
+std::string SceneIncrementalLoadTest::title() const
+{
+    return "Incremental scene loading";
+}
+
+std::string SceneIncrementalLoadTest::subtitle() const
+{
+    return "The scene is built within 4 ms per frame and shown when done";
+}
+
+//------------------------------------------------------------------
+//
+// SceneCsbPrototypeCacheTest
+//
+//------------------------------------------------------------------
+void SceneCsbPrototypeCacheTest::onEnter()
+{
+    TestCase::onEnter();
+
+    auto csLoader = CSLoader::getInstance();
+    _cacheEnabled = csLoader->isPrototypeCacheEnabled();
+    _cacheLimit   = csLoader->getPrototypeCacheLimit();
+    csLoader->setPrototypeCacheEnabled(false);
+    csLoader->setPrototypeCacheEnabled(true);
+    csLoader->resetPrototypeCacheStats();
+
+    std::string report;
+    auto check = [&report](const char* name, bool passed) {
+        report += fmt::format("{}: {}\n", name, passed ? "PASS" : "FAIL");
+    };
+    auto& stats = csLoader->getPrototypeCacheStats();
+
+    // hd/ has its own ActionTimeline/Animation.csb, so putting it first resolves the same name to another file
+    const char* filename = "ActionTimeline/Animation.csb";
+    auto fileUtils       = FileUtils::getInstance();
+    auto searchPaths     = fileUtils->getOriginalSearchPaths();
+
+    CSLoader::createNode(filename);
+    check("First load is a miss", stats.misses == 1 && stats.hits == 0 && stats.count == 1);
+    CSLoader::createNode(filename);
+    check("Second load is a hit", stats.misses == 1 && stats.hits == 1);
+
+    auto hdSearchPaths = searchPaths;
+    hdSearchPaths.insert(hdSearchPaths.begin(), "hd");
+    fileUtils->setSearchPaths(hdSearchPaths);
+    CSLoader::createNode(filename);
+    check("Miss after a search path change", stats.misses == 2 && stats.count == 2);
+    fileUtils->setSearchPaths(searchPaths);
+    CSLoader::createNode(filename);
+    check("Hit once the search paths are restored", stats.hits == 2 && stats.count == 2);
+
+    csLoader->setPrototypeCacheLimit(1);
+    check("Least recently used file evicted", stats.count == 1 && stats.evictions == 1);
+    csLoader->setPrototypeCacheLimit(_cacheLimit);
+
+    csLoader->removeAllPrototypes();
+    check("Purge empties the cache", stats.count == 0 && stats.bytes == 0);
+    CSLoader::createNode(filename);
+    check("Miss after a purge", stats.misses == 3 && stats.count == 1);
+
+    auto label = Label::createWithTTF(report, "fonts/arial.ttf", 16);
+    label->setPosition(VisibleRect::center());
+    addChild(label);
+}
+
+void SceneCsbPrototypeCacheTest::onExit()
+{
+    auto csLoader = CSLoader::getInstance();
+    csLoader->setPrototypeCacheEnabled(false);
+    csLoader->setPrototypeCacheEnabled(_cacheEnabled);
+    csLoader->setPrototypeCacheLimit(_cacheLimit);
+    csLoader->resetPrototypeCacheStats();
+    TestCase::onExit();
+}
+
+std::string SceneCsbPrototypeCacheTest::title() const
+{
+    return ".csb prototype cache";
+}
+
+std::string SceneCsbPrototypeCacheTest::subtitle() const
+{
+    return "Hits, misses after a search path change and purge";
+}
@@ -83,4 +83,40 @@ public:
     static SceneTestScene* create(int testIndex = 1);
 };
 
+class SceneIncrementalLoadTest : public TestCase
+{
+public:
+    CREATE_FUNC(SceneIncrementalLoadTest);
+
+    virtual void onEnter() override;
+    virtual void onExit() override;
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+private:
+    void startLoading(ax::Ref* sender);
+    void cancelLoading();
+
+    ax::RefPtr<ax::IncrementalLoader> _spritesLoader;
+    ax::RefPtr<ax::IncrementalLoader> _csbLoader;
+    ax::Node* _content   = nullptr;
+    ax::Label* _progress = nullptr;
+    double _startTime    = 0;
+};
+
+class SceneCsbPrototypeCacheTest : public TestCase
+{
+public:
+    CREATE_FUNC(SceneCsbPrototypeCacheTest);
+
+    virtual void onEnter() override;
+    virtual void onExit() override;
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+private:
+    bool _cacheEnabled = false;
+    size_t _cacheLimit = 0;
+};
+
 #endif
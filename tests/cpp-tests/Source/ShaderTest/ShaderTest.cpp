@@ -60,6 +60,7 @@ ShaderTests::ShaderTests()
     ADD_TEST_CASE(ShaderMonjori);
     ADD_TEST_CASE(ShaderGlow);
     ADD_TEST_CASE(ShaderMultiTexture);
+    ADD_TEST_CASE(ShaderProgramWarmUp);
 }
 
 ///---------------------------------------
@@ -781,3 +782,52 @@ void ShaderMultiTexture::changeTexture(Ref*)
     auto programState = _sprite->getProgramState();
     SET_TEXTURE(programState, "u_tex1", 1, right->getTexture()->getBackendTexture());
 }
+
+///---------------------------------------
+//
+// ShaderProgramWarmUp
+//
+///---------------------------------------
+
+std::string ShaderProgramWarmUp::title() const
+{
+    return "Program warm up";
+}
+
+std::string ShaderProgramWarmUp::subtitle() const
+{
+    return "Loads 2 registered programs per frame,\nbinaries are restored from the disk cache on next launch";
+}
+
+bool ShaderProgramWarmUp::init()
+{
+    if (ShaderTestDemo::init())
+    {
+        auto s = Director::getInstance()->getWinSize();
+
+        _statsLabel = Label::createWithTTF("", "fonts/arial.ttf", 14);
+        _statsLabel->setAlignment(TextHAlignment::CENTER);
+        _statsLabel->setPosition(s.width / 2, s.height / 2);
+        addChild(_statsLabel);
+
+        ProgramManager::getInstance()->resetLoadStats();
+        _pending = ProgramManager::getInstance()->warmUpPrograms(0);
+        scheduleUpdate();
+        return true;
+    }
+
+    return false;
+}
+
+void ShaderProgramWarmUp::update(float dt)
+{
+    auto programManager = ProgramManager::getInstance();
+    if (_pending > 0)
+        _pending = programManager->warmUpPrograms(2);
+
+    auto& stats = programManager->getLoadStats();
+    _statsLabel->setString(StringUtils::format(
+        "pending: %u\nbinary cache: %s, hits: %u, misses: %u\ncompiled: %u in %.2fms\nrestored in %.2fms",
+        static_cast<unsigned int>(_pending), programManager->isBinaryCacheEnabled() ? "on" : "off", stats.binaryHits,
+        stats.binaryMisses, stats.compiled, stats.compileTime, stats.binaryLoadTime));
+}
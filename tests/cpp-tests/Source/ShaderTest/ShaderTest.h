@@ -220,3 +220,18 @@ public:
     virtual std::string subtitle() const override;
     virtual bool init() override;
 };
+
+class ShaderProgramWarmUp : public ShaderTestDemo
+{
+public:
+    CREATE_FUNC(ShaderProgramWarmUp);
+
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+    virtual bool init() override;
+    virtual void update(float dt) override;
+
+private:
+    ax::Label* _statsLabel = nullptr;
+    size_t _pending        = 0;
+};
@@ -26,6 +26,7 @@
 #include "SpineTest.h"
 #include <iostream>
 #include <fstream>
+#include <random>
 #include <string.h>
 #include "spine/spine.h"
 
@@ -79,6 +80,7 @@ SpineTests::SpineTests()
     ADD_TEST_CASE(RaptorExample);
     ADD_TEST_CASE(SkeletonRendererSeparatorExample);
     ADD_TEST_CASE(SpineboyExample);
+    ADD_TEST_CASE(ParallelUpdateStressExample);
     ADD_TEST_CASE(TankExample);
 
 #ifdef _AX_DEBUG
@@ -91,6 +93,7 @@ SpineTests::~SpineTests()
     FileUtils::getInstance()->setSearchPaths(_searchPaths);
     SkeletonBatch::destroyInstance();
     SkeletonTwoColorBatch::destroyInstance();
+    SkeletonUpdateScheduler::destroyInstance();
 #ifdef _AX_DEBUG
     debugExtension->reportLeaks();
     delete debugExtension;
@@ -548,6 +551,116 @@ void SpineboyExample::update(float deltaTime)
     // Director::getInstance()->replaceScene(SpineboyExample::scene());
 }
 
+// ParallelUpdateStressExample
+#define NUM_STRESS_SKELETONS 400
+
+bool ParallelUpdateStressExample::init()
+{
+    if (!SpineTestLayer::init())
+        return false;
+
+    _title = "Parallel update stress";
+
+    _atlas            = new (__FILE__, __LINE__) Atlas("spineboy.atlas", &textureLoader, true);
+    _attachmentLoader = new (__FILE__, __LINE__) Cocos2dAtlasAttachmentLoader(_atlas);
+
+    SkeletonJson* json = new (__FILE__, __LINE__) SkeletonJson(_attachmentLoader);
+    json->setScale(0.3f);
+    _skeletonData = json->readSkeletonDataFile("spineboy-pro.json");
+    AXASSERT(_skeletonData,
+             (json->getError().isEmpty() ? json->getError().buffer() : "Error reading skeleton data file."));
+    delete json;
+
+    _stateData = new (__FILE__, __LINE__) AnimationStateData(_skeletonData);
+    _stateData->setDefaultMix(0.2f);
+
+    // A fixed seed, so both modes animate the same crowd.
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    const char* animations[] = {"walk", "run", "jump", "shoot"};
+
+    for (int i = 0; i < NUM_STRESS_SKELETONS; i++)
+    {
+        SkeletonAnimation* node = SkeletonAnimation::createWithData(_skeletonData, false);
+        node->setAnimationStateData(_stateData);
+        node->setAnimation(0, animations[i % 4], true);
+        node->addAnimation(0, animations[(i + 1) % 4], true, 1.0f + unit(rng) * 3.0f);
+        node->getState()->update(unit(rng));
+        node->setParallelUpdateEnabled(_parallelUpdate);
+        node->setPosition(Vec2(_contentSize.width * (0.05f + unit(rng) * 0.9f), _contentSize.height * unit(rng) * 0.7f));
+        addChild(node);
+    }
+
+    MenuItemFont::setFontSize(18);
+    _toggleItem = MenuItemFont::create("Parallel update: on",
+                                       AX_CALLBACK_1(ParallelUpdateStressExample::toggleParallelUpdate, this));
+    auto menu   = Menu::create(_toggleItem, nullptr);
+    menu->setPosition(Vec2(_contentSize.width / 2, _contentSize.height - 90));
+    addChild(menu, 1);
+
+    _statsLabel = Label::createWithTTF("", "fonts/arial.ttf", 14);
+    _statsLabel->setPosition(Vec2(_contentSize.width / 2, _contentSize.height - 115));
+    addChild(_statsLabel, 1);
+
+    return true;
+}
+
+ParallelUpdateStressExample::~ParallelUpdateStressExample()
+{
+    // The nodes are released with the scene, see BatchingExample.
+    delete _skeletonData;
+    delete _stateData;
+    delete _attachmentLoader;
+    delete _atlas;
+}
+
+void ParallelUpdateStressExample::onEnter()
+{
+    SpineTestLayer::onEnter();
+
+    // Measures update, the parallel pass and visit, which is where the skeletons spend their CPU time.
+    _beforeUpdateListener = _eventDispatcher->addCustomEventListener(
+        Director::EVENT_BEFORE_UPDATE, [this](EventCustom*) { _frameStart = std::chrono::steady_clock::now(); });
+    _afterVisitListener = _eventDispatcher->addCustomEventListener(Director::EVENT_AFTER_VISIT, [this](EventCustom*) {
+        _frameTime += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - _frameStart).count();
+        if (++_frameCount == 60)
+            updateStats();
+    });
+}
+
+void ParallelUpdateStressExample::onExit()
+{
+    _eventDispatcher->removeEventListener(_beforeUpdateListener);
+    _eventDispatcher->removeEventListener(_afterVisitListener);
+    SpineTestLayer::onExit();
+}
+
+std::string ParallelUpdateStressExample::subtitle() const
+{
+    return StringUtils::format("%d skeletons, %d workers", NUM_STRESS_SKELETONS,
+                               JobSystem::getInstance()->getWorkerCount());
+}
+
+void ParallelUpdateStressExample::toggleParallelUpdate(Ref* sender)
+{
+    _parallelUpdate = !_parallelUpdate;
+    for (auto child : _children)
+    {
+        if (auto node = dynamic_cast<SkeletonRenderer*>(child))
+            node->setParallelUpdateEnabled(_parallelUpdate);
+    }
+    _toggleItem->setString(_parallelUpdate ? "Parallel update: on" : "Parallel update: off");
+    _frameTime  = 0;
+    _frameCount = 0;
+}
+
+void ParallelUpdateStressExample::updateStats()
+{
+    _statsLabel->setString(StringUtils::format("update + visit: %.2f ms/frame", _frameTime / _frameCount));
+    _frameTime  = 0;
+    _frameCount = 0;
+}
+
 bool TankExample::init()
 {
     if (!SpineTestLayer::init())
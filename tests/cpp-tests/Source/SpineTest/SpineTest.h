@@ -29,6 +29,7 @@
 #include "axmol.h"
 #include "../BaseTest.h"
 #include <spine/spine-cocos2dx.h>
+#include <chrono>
 
 #ifdef _AX_DEBUG
 #    include <spine/Debug.h>
@@ -147,6 +148,36 @@ private:
     ax::DrawNode* betweenNode;
 };
 
+class ParallelUpdateStressExample : public SpineTestLayer
+{
+public:
+    CREATE_FUNC(ParallelUpdateStressExample);
+    ~ParallelUpdateStressExample();
+
+    virtual bool init() override;
+    virtual void onEnter() override;
+    virtual void onExit() override;
+    virtual std::string subtitle() const override;
+
+protected:
+    void toggleParallelUpdate(ax::Ref* sender);
+    void updateStats();
+
+    spine::Atlas* _atlas                       = nullptr;
+    spine::AttachmentLoader* _attachmentLoader = nullptr;
+    spine::SkeletonData* _skeletonData         = nullptr;
+    spine::AnimationStateData* _stateData      = nullptr;
+
+    bool _parallelUpdate                           = true;
+    ax::Label* _statsLabel                         = nullptr;
+    ax::MenuItemFont* _toggleItem                  = nullptr;
+    ax::EventListenerCustom* _beforeUpdateListener = nullptr;
+    ax::EventListenerCustom* _afterVisitListener   = nullptr;
+    std::chrono::steady_clock::time_point _frameStart;
+    double _frameTime = 0;
+    int _frameCount   = 0;
+};
+
 class SpineboyExample : public SpineTestLayer
 {
 public:
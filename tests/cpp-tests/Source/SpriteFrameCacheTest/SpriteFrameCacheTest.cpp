@@ -29,8 +29,11 @@
 #include "SpriteFrameCacheTest.h"
 
 #include <cassert>
+#include <chrono>
 
 #include "NinePatchImageParser.h"
+#include "base/format.h"
+#include "2d/BinarySpriteSheetLoader.h"
 
 USING_NS_AX;
 
@@ -40,6 +43,8 @@ SpriteFrameCacheTests::SpriteFrameCacheTests()
     ADD_TEST_CASE(SpriteFrameCacheLoadMultipleTimes);
     ADD_TEST_CASE(SpriteFrameCacheFullCheck);
     ADD_TEST_CASE(SpriteFrameCacheJsonAtlasTest);
+    ADD_TEST_CASE(SpriteFrameCacheLargePlistTest);
+    ADD_TEST_CASE(SpriteFrameCacheBinaryTest);
 }
 
 SpriteFrameCachePixelFormatTest::SpriteFrameCachePixelFormatTest()
@@ -510,3 +515,129 @@ void SpriteFrameCacheJsonAtlasTest::loadSpriteFrames(std::string_view file,
     SpriteFrameCache::getInstance()->removeSpriteFramesFromFile(file);
     Director::getInstance()->getTextureCache()->removeTexture(texture);
 }
+
+// writes a format 2 sprite sheet with many small frames on top of an existing texture
+static std::string writeLargeSpriteSheet(std::string_view plistPath, int frameCount)
+{
+    auto fileUtils    = FileUtils::getInstance();
+    std::string plist = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<plist version=\"1.0\">\n<dict>\n"
+                        "<key>frames</key>\n<dict>\n";
+    for (int i = 0; i < frameCount; ++i)
+    {
+        int x = (i % 8) * 8, y = (i / 8 % 8) * 8;
+        plist += fmt::format(
+            "<key>large_{}.png</key>\n<dict>\n<key>frame</key>\n<string>{{{{{},{}}},{{8,8}}}}</string>\n"
+            "<key>offset</key>\n<string>{{0,0}}</string>\n<key>rotated</key>\n<false/>\n"
+            "<key>sourceSize</key>\n<string>{{8,8}}</string>\n</dict>\n",
+            i, x, y);
+    }
+    plist += fmt::format(
+        "</dict>\n<key>metadata</key>\n<dict>\n<key>format</key>\n<integer>2</integer>\n"
+        "<key>textureFileName</key>\n<string>{}</string>\n</dict>\n</dict>\n</plist>\n",
+        fileUtils->fullPathForFilename("Images/grossini.png"));
+    fileUtils->writeStringToFile(plist, plistPath);
+    return plist;
+}
+
+SpriteFrameCacheLargePlistTest::SpriteFrameCacheLargePlistTest()
+{
+    using Clock = std::chrono::steady_clock;
+    auto elapsedMs = [](Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    };
+
+    const int frameCount = 20000;
+    auto fileUtils       = FileUtils::getInstance();
+    auto plistPath       = fileUtils->getWritablePath() + "large_sprite_sheet.plist";
+    auto plist           = writeLargeSpriteSheet(plistPath, frameCount);
+
+    auto start         = Clock::now();
+    auto dict          = fileUtils->getValueMapFromFile(plistPath);
+    double valueMapMs  = elapsedMs(start);
+    size_t mapFrames   = dict["frames"].asValueMap().size();
+
+    start = Clock::now();
+    ValueDocument doc;
+    doc.initWithPlistFile(plistPath);
+    double documentMs = elapsedMs(start);
+    size_t docFrames  = doc.getRoot()["frames"].size();
+    AX_ASSERT(mapFrames == docFrames);
+
+    auto cache = SpriteFrameCache::getInstance();
+    start      = Clock::now();
+    cache->addSpriteFramesWithFile(plistPath);
+    double addMs = elapsedMs(start);
+    AX_ASSERT(cache->getSpriteFrameByName("large_19999.png") != nullptr);
+    cache->removeSpriteFramesFromFile(plistPath);
+    fileUtils->removeFile(plistPath);
+
+    auto info = fmt::format(
+        "{} frames, {} KB plist\n\nValueMap parse: {:.2f} ms\nValueDocument parse: {:.2f} ms, {} KB\n"
+        "addSpriteFramesWithFile: {:.2f} ms",
+        docFrames, plist.size() / 1024, valueMapMs, documentMs, doc.getMemoryUsage() / 1024, addMs);
+    auto label = Label::createWithTTF(info, "fonts/arial.ttf", 14);
+    label->setPosition(VisibleRect::center());
+    addChild(label);
+}
+
+SpriteFrameCacheBinaryTest::SpriteFrameCacheBinaryTest()
+{
+    using Clock = std::chrono::steady_clock;
+    auto elapsedMs = [](Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    };
+
+    auto fileUtils = FileUtils::getInstance();
+    auto cache     = SpriteFrameCache::getInstance();
+
+    // polygon frames survive the conversion
+    auto polygonPath = fileUtils->getWritablePath() + "test_polygon.axss";
+    BinarySpriteSheetLoader::convertFromPlist("Images/test_polygon.plist", polygonPath);
+    cache->addSpriteFramesWithFile(polygonPath, "Images/test_polygon.png", SpriteSheetFormat::BINARY);
+    auto sister = Sprite::createWithSpriteFrameName("grossinis_sister1.png");
+    sister->setPosition(VisibleRect::left() + Vec2(100, 0));
+    addChild(sister);
+    auto sister2 = Sprite::createWithSpriteFrameName("grossinis_sister2.png");
+    sister2->setPosition(VisibleRect::right() - Vec2(100, 0));
+    addChild(sister2);
+    AX_ASSERT(cache->getSpriteFrameByName("grossinis_sister1.png")->hasPolygonInfo());
+    cache->removeSpriteFramesFromFile(polygonPath);
+    fileUtils->removeFile(polygonPath);
+
+    const int frameCount = 20000;
+    auto plistPath       = fileUtils->getWritablePath() + "binary_sprite_sheet.plist";
+    auto binaryPath      = fileUtils->getWritablePath() + "binary_sprite_sheet.axss";
+    writeLargeSpriteSheet(plistPath, frameCount);
+    BinarySpriteSheetLoader::convertFromPlist(plistPath, binaryPath);
+
+    auto start = Clock::now();
+    cache->addSpriteFramesWithFile(plistPath);
+    double plistMs = elapsedMs(start);
+    cache->removeSpriteFramesFromFile(plistPath);
+    fileUtils->removeFile(plistPath);
+
+    start = Clock::now();
+    cache->addSpriteFramesWithFile(binaryPath, SpriteSheetFormat::BINARY);
+    double binaryMs = elapsedMs(start);
+    AX_ASSERT(cache->getSpriteFrameByName("large_19999.png") != nullptr);
+    cache->removeSpriteFramesFromFile(binaryPath);
+
+    auto info = fmt::format("{} frames\n\nplist: {:.2f} ms\nbinary: {:.2f} ms\nbinary async: loading", frameCount,
+                            plistMs, binaryMs);
+    auto label = Label::createWithTTF(info, "fonts/arial.ttf", 14);
+    label->setPosition(VisibleRect::center());
+    addChild(label);
+
+    // the main thread only pays for the final batch insert
+    start = Clock::now();
+    cache->addSpriteFramesWithFileAsync(
+        binaryPath,
+        [=](bool loaded) {
+            auto asyncMs = elapsedMs(start);
+            label->setString(fmt::format("{} frames\n\nplist: {:.2f} ms\nbinary: {:.2f} ms\nbinary async: {:.2f} ms{}",
+                                         frameCount, plistMs, binaryMs, asyncMs, loaded ? "" : " (failed)"));
+            SpriteFrameCache::getInstance()->removeSpriteFramesFromFile(binaryPath);
+            FileUtils::getInstance()->removeFile(binaryPath);
+        },
+        SpriteSheetFormat::BINARY);
+}
@@ -91,3 +91,25 @@ private:
 
     ax::Label* infoLabel;
 };
+
+class SpriteFrameCacheLargePlistTest : public TestCase
+{
+public:
+    CREATE_FUNC(SpriteFrameCacheLargePlistTest);
+
+    virtual std::string title() const override { return "Large plist load time"; }
+    virtual std::string subtitle() const override { return "ValueMap vs ValueDocument, 20000 frames"; }
+
+    SpriteFrameCacheLargePlistTest();
+};
+
+class SpriteFrameCacheBinaryTest : public TestCase
+{
+public:
+    CREATE_FUNC(SpriteFrameCacheBinaryTest);
+
+    virtual std::string title() const override { return "Binary sprite sheet"; }
+    virtual std::string subtitle() const override { return "plist vs binary vs async binary load time"; }
+
+    SpriteFrameCacheBinaryTest();
+};
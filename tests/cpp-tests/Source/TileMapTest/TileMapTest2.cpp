@@ -68,6 +68,7 @@ FastTileMapTests::FastTileMapTests()
     ADD_TEST_CASE(TMXGIDObjectsTestNew);
     ADD_TEST_CASE(TileAnimTestNew);
     ADD_TEST_CASE(TileAnimTestNew2);
+    ADD_TEST_CASE(TMXInfiniteChunkStreamingTestNew);
 }
 
 TileDemoNew::TileDemoNew()
@@ -1431,3 +1432,46 @@ void TileAnimTestNew2::onTouchBegan(const std::vector<ax::Touch*>& touches, ax::
     _animStarted = !_animStarted;
     map->setTileAnimEnabled(_animStarted);
 }
+
+//------------------------------------------------------------------
+//
+// TMXInfiniteChunkStreamingTestNew
+//
+//------------------------------------------------------------------
+TMXInfiniteChunkStreamingTestNew::TMXInfiniteChunkStreamingTestNew()
+{
+    auto map = FastTMXTiledMap::createWithChunkStreaming("TileMaps/orthogonal-infinite.tmx");
+    addChild(map, 0, kTagTileMap);
+
+    auto layer = map->getLayer("Layer 0");
+    layer->setChunkStreamingMargins(0, 1);
+
+    Size AX_UNUSED s = layer->getContentSize();
+    AXLOG("ContentSize: %f, %f", s.width, s.height);
+
+    map->runAction(RepeatForever::create(
+        Sequence::create(MoveBy::create(6, Vec2(-1500, -800)), MoveBy::create(6, Vec2(1500, 800)), nullptr)));
+
+    _chunkCountLabel = Label::createWithTTF("", "fonts/arial.ttf", 16);
+    _chunkCountLabel->setPosition(VisibleRect::center() + Vec2(0, -100));
+    addChild(_chunkCountLabel, 1);
+
+    schedule(AX_SCHEDULE_SELECTOR(TMXInfiniteChunkStreamingTestNew::updateChunkCount), 0.2f);
+}
+
+void TMXInfiniteChunkStreamingTestNew::updateChunkCount(float dt)
+{
+    auto map   = static_cast<FastTMXTiledMap*>(getChildByTag(kTagTileMap));
+    auto layer = map->getLayer("Layer 0");
+    _chunkCountLabel->setString(StringUtils::format("loaded chunks: %d", layer->getLoadedChunkCount()));
+}
+
+std::string TMXInfiniteChunkStreamingTestNew::title() const
+{
+    return "TMX infinite map chunk streaming";
+}
+
+std::string TMXInfiniteChunkStreamingTestNew::subtitle() const
+{
+    return "chunks are decoded when they come near the screen";
+}
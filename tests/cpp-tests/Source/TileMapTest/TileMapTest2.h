@@ -363,4 +363,18 @@ public:
     void onTouchBegan(const std::vector<ax::Touch*>& touches, ax::Event* event);
 };
 
+class TMXInfiniteChunkStreamingTestNew : public TileDemoNew
+{
+public:
+    CREATE_FUNC(TMXInfiniteChunkStreamingTestNew);
+    TMXInfiniteChunkStreamingTestNew();
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+    void updateChunkCount(float dt);
+
+protected:
+    ax::Label* _chunkCountLabel = nullptr;
+};
+
 #endif
@@ -41,6 +41,7 @@ UIListViewTests::UIListViewTests()
     ADD_TEST_CASE(UIListViewTest_PaddingHorizontal);
     ADD_TEST_CASE(Issue12692);
     ADD_TEST_CASE(Issue8316);
+    ADD_TEST_CASE(UIListViewTest_Virtual);
 }
 
 // UIListViewTest_Vertical
@@ -1058,3 +1059,87 @@ void UIListViewTest_Padding::sliderEvent(Ref* pSender, Slider::EventType type)
         }
     }
 }
+
+// UIListViewTest_Virtual
+bool UIListViewTest_Virtual::init()
+{
+    if (!UIScene::init())
+    {
+        return false;
+    }
+
+    Size layerSize = _uiLayer->getContentSize();
+
+    static const int NUMBER_OF_ITEMS = 10000;
+    auto titleLabel                  = Text::create("Virtual ListView", "fonts/Marker Felt.ttf", 32);
+    titleLabel->setAnchorPoint(Vec2::ANCHOR_MIDDLE);
+    titleLabel->setPosition(Vec2(layerSize / 2) + Vec2(0.0f, titleLabel->getContentSize().height * 3.15f));
+    _uiLayer->addChild(titleLabel, 3);
+
+    _statusLabel = Text::create("", "fonts/Marker Felt.ttf", 16);
+    _statusLabel->setAnchorPoint(Vec2::ANCHOR_MIDDLE_LEFT);
+    _statusLabel->setPosition(Vec2(layerSize / 2) + Vec2(120.0f, 0.0f));
+    _uiLayer->addChild(_statusLabel, 3);
+
+    // Only the items in the view are created, whatever the item count
+    _listView = ListView::create();
+    _listView->setDirection(ScrollView::Direction::VERTICAL);
+    _listView->setBounceEnabled(true);
+    _listView->setBackGroundImage("cocosui/green_edit.png");
+    _listView->setBackGroundImageScale9Enabled(true);
+    _listView->setContentSize(Size(200.0f, layerSize.height / 2));
+    _listView->setScrollBarPositionFromCorner(Vec2(7, 7));
+    _listView->setItemsMargin(2.0f);
+    _listView->setGravity(ListView::Gravity::CENTER_HORIZONTAL);
+    _listView->setAnchorPoint(Vec2::ANCHOR_MIDDLE);
+    _listView->setPosition(layerSize / 2);
+    _listView->setVirtual(true);
+    _listView->setEstimatedItemSize(40.0f);
+
+    // Template 0 is a button, template 1 a section header
+    _listView->setItemTemplateCallback([](ssize_t index) { return index % 10 == 0 ? 1 : 0; });
+    _listView->setItemCreateCallback([](int templateId) -> Widget* {
+        if (templateId == 1)
+        {
+            auto header = Text::create("", "fonts/Marker Felt.ttf", 24);
+            header->setColor(Color3B(159, 168, 176));
+            return header;
+        }
+        auto button = Button::create("cocosui/button.png", "cocosui/buttonHighlighted.png");
+        button->setScale9Enabled(true);
+        return button;
+    });
+    _listView->setItemRenderCallback([](Widget* item, ssize_t index) {
+        if (index % 10 == 0)
+        {
+            static_cast<Text*>(item)->setString(StringUtils::format("Section %d", static_cast<int>(index / 10)));
+            return;
+        }
+        auto button = static_cast<Button*>(item);
+        button->setContentSize(Size(150.0f, 30.0f + (index % 3) * 15.0f));
+        button->setTitleText(StringUtils::format("Button-%d", static_cast<int>(index)));
+    });
+    _listView->setVirtualItemCount(NUMBER_OF_ITEMS);
+    _listView->addEventListener((ui::ListView::ccListViewCallback)[this](Ref*, ListView::EventType type) {
+        if (type == ListView::EventType::ON_SELECTED_ITEM_END)
+        {
+            _statusLabel->setString(
+                StringUtils::format("Selected %d", static_cast<int>(_listView->getCurSelectedIndex())));
+        }
+    });
+    _uiLayer->addChild(_listView);
+
+    auto pButton = Button::create("cocosui/backtotoppressed.png", "cocosui/backtotopnormal.png");
+    pButton->setAnchorPoint(Vec2::ANCHOR_MIDDLE_LEFT);
+    pButton->setScale(0.8f);
+    pButton->setPosition(Vec2(layerSize / 2) + Vec2(120.0f, -60.0f));
+    pButton->setTitleText("Go to random");
+    pButton->addClickEventListener([this](Ref*) {
+        int index = RandomHelper::random_int(0, NUMBER_OF_ITEMS - 1);
+        _listView->jumpToItem(index, Vec2::ANCHOR_MIDDLE, Vec2::ANCHOR_MIDDLE);
+        _statusLabel->setString(StringUtils::format("Jumped to %d", index));
+    });
+    _uiLayer->addChild(pButton);
+
+    return true;
+}
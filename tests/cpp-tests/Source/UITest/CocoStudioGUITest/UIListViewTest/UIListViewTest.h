@@ -219,4 +219,17 @@ public:
     }
 };
 
+// Test for virtual list view with variable item sizes
+class UIListViewTest_Virtual : public UIScene
+{
+public:
+    CREATE_FUNC(UIListViewTest_Virtual);
+
+    virtual bool init() override;
+
+protected:
+    ax::ui::ListView* _listView = nullptr;
+    ax::ui::Text* _statusLabel  = nullptr;
+};
+
 #endif /* defined(__TestCpp__UIListViewTest__) */
@@ -50,6 +50,7 @@ UIRichTextTests::UIRichTextTests()
     ADD_TEST_CASE(UIRichTextXMLExtend);
     ADD_TEST_CASE(UIRichTextXMLSpace);
     ADD_TEST_CASE(UIRichTextNewline);
+    ADD_TEST_CASE(UIRichTextXMLAppend);
 }
 
 //
@@ -2091,3 +2092,75 @@ void UIRichTextNewline::switchAlignment(Ref* sender, Widget::TouchEventType type
         _richText->setHorizontalAlignment(alignment);
     }
 }
+
+//
+// UIRichTextXMLAppend
+//
+bool UIRichTextXMLAppend::init()
+{
+    if (UIScene::init())
+    {
+        Size widgetSize = _widget->getContentSize();
+
+        // Add the alert
+        Text* alert = Text::create("RichText append", "fonts/Marker Felt.ttf", 30);
+        alert->setColor(Color3B(159, 168, 176));
+        alert->setPosition(
+            Vec2(widgetSize.width / 2.0f, widgetSize.height / 2.0f - alert->getContentSize().height * 3.125));
+        _widget->addChild(alert);
+
+        Button* button = Button::create("cocosui/animationbuttonnormal.png", "cocosui/animationbuttonpressed.png");
+        button->setTouchEnabled(true);
+        button->setTitleText("append");
+        button->setPosition(
+            Vec2(widgetSize.width * 1 / 3, widgetSize.height / 2.0f + button->getContentSize().height * 2.5));
+        button->addTouchEventListener(AX_CALLBACK_2(UIRichTextXMLAppend::appendLine, this));
+        button->setLocalZOrder(10);
+        _widget->addChild(button);
+
+        Button* button2 = Button::create("cocosui/animationbuttonnormal.png", "cocosui/animationbuttonpressed.png");
+        button2->setTouchEnabled(true);
+        button2->setTitleText("width");
+        button2->setPosition(
+            Vec2(widgetSize.width * 2 / 3, widgetSize.height / 2.0f + button2->getContentSize().height * 2.5));
+        button2->addTouchEventListener(AX_CALLBACK_2(UIRichTextXMLAppend::switchWidth, this));
+        button2->setLocalZOrder(10);
+        _widget->addChild(button2);
+
+        // RichText, the appended lines are laid out after the existing ones, plain text runs are batched
+        _richText = RichText::createWithXML(
+            "<font face='fonts/Marker Felt.ttf' size=\"16\">Chat log, appended lines don't format the text "
+            "again</font><br/>");
+        _richText->ignoreContentAdaptWithSize(false);
+        _richText->setContentSize(Size(200, 100));
+        _richText->setAnchorPoint(Vec2::ANCHOR_MIDDLE_TOP);
+        _richText->setPosition(Vec2(widgetSize.width / 2, widgetSize.height / 2 + 40));
+        _richText->setLocalZOrder(10);
+
+        _widget->addChild(_richText);
+        return true;
+    }
+    return false;
+}
+
+void UIRichTextXMLAppend::appendLine(Ref* /*sender*/, Widget::TouchEventType type)
+{
+    if (type == Widget::TouchEventType::ENDED)
+    {
+        ++_lineCount;
+        _richText->appendString(StringUtils::format(
+            "<font face='fonts/Marker Felt.ttf' size=\"16\"><font color='#ffff00'>player%d:</font> message %d, "
+            "<a href='https://axmolengine.github.io/'>link</a></font><br/>",
+            _lineCount % 3, _lineCount));
+    }
+}
+
+void UIRichTextXMLAppend::switchWidth(Ref* /*sender*/, Widget::TouchEventType type)
+{
+    if (type == Widget::TouchEventType::ENDED)
+    {
+        // only the lines are wrapped again, the runs which still fit are reused
+        float width = _richText->getContentSize().width == 200 ? 300.0f : 200.0f;
+        _richText->setContentSize(Size(width, 100));
+    }
+}
@@ -292,4 +292,18 @@ protected:
     ax::ui::RichText* _richText;
 };
 
+class UIRichTextXMLAppend : public UIScene
+{
+public:
+    CREATE_FUNC(UIRichTextXMLAppend);
+
+    bool init() override;
+    void appendLine(ax::Ref* sender, ax::ui::Widget::TouchEventType type);
+    void switchWidth(ax::Ref* sender, ax::ui::Widget::TouchEventType type);
+
+protected:
+    ax::ui::RichText* _richText;
+    int _lineCount = 0;
+};
+
 #endif /* defined(__TestCpp__UIRichTextTest__) */